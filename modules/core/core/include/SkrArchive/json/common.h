@@ -30,6 +30,30 @@ enum class JsonErrorCode : uint32_t
 };
 using JsonResult = skr::Expected<JsonErrorCode>;
 
+// result of dispatching one object member to a record field in streaming mode
+enum class JsonFieldDispatch : uint32_t
+{
+    NotFound,
+    Success,
+    Failed
+};
+
+// perfect hash used by generated field dispatch, keep in sync with meta/serialize/serialize.py
+inline constexpr uint32_t json_field_hash(const char8_t* str, size_t size, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ seed;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint8_t>(str[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+inline uint32_t json_field_hash(skr::StringView key, uint32_t seed)
+{
+    return json_field_hash(key.raw().data(), key.raw().size(), seed);
+}
+
 template <typename T>
 inline static constexpr bool IsJsonPrimitiveReadableType =
 std::is_same_v<T, bool> || std::is_integral_v<T> || std::is_floating_point_v<T> ||
@@ -16,9 +16,15 @@ struct SKR_STATIC_API _JsonReader {
     using DocumentType = SJsonDocument;
     using ValueType    = SJsonValue;
 
-    _JsonReader(skr::StringView json);
+    _JsonReader(skr::StringView json, bool stream_fields = false);
     ~_JsonReader();
 
+    // streaming mode: generated serde walks object members once in document order
+    // and dispatches them to fields with NextField, instead of looking up each field by key
+    inline bool IsStreamFields() const { return _stream_fields; }
+    // advance to the next member of the current object, the following read without key consumes its value
+    bool NextField(skr::StringView& key);
+
     JsonReadResult StartObject(skr::StringView key);
     JsonReadResult EndObject();
 
@@ -148,6 +154,10 @@ struct SKR_STATIC_API _JsonReader {
             kArray
         } _type         = kObject;
         uint32_t _index = 0;
+        // next element/member key to visit, avoids linear lookup by index
+        ValueType* _cursor = nullptr;
+        // value of the member returned by NextField, not consumed yet
+        ValueType* _field = nullptr;
 
         Level(ValueType* _value, EType _type) SKR_NOEXCEPT
             : _value(_value),
@@ -159,11 +169,12 @@ struct SKR_STATIC_API _JsonReader {
 protected:
     friend struct _ReaderHelper;
     skr::Vector<Level> _stack;
-    DocumentType*      _document = nullptr;
+    DocumentType*      _document      = nullptr;
+    bool               _stream_fields = false;
 };
 
 struct SKR_STATIC_API JsonReader : public _JsonReader {
-    JsonReader(skr::StringView json);
+    JsonReader(skr::StringView json, bool stream_fields = false);
 
     // TODO: REMOVE?
     JsonReadResult Key(skr::StringView key);
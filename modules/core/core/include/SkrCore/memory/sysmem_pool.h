@@ -1,18 +1,57 @@
 #pragma once
 #include "SkrCore/memory/memory.h"
 
+typedef enum ESysMemoryPageKind
+{
+    SKR_SYSMEM_PAGE_DEFAULT = 0, // os default pages
+    SKR_SYSMEM_PAGE_LARGE = 1,   // 2MiB large pages
+    SKR_SYSMEM_PAGE_HUGE = 2,    // 1GiB huge pages
+} ESysMemoryPageKind;
+
 typedef struct SSysMemoryPoolDesc {
     size_t size;
     const char* pool_name;
+    // try 2MiB large pages, falls back to default pages. SSysMemoryPoolInfo::page_kind tells what was mapped
     bool use_large_page;
+    // try 1GiB huge pages, falls back to large pages then default pages
+    bool use_huge_page;
+    // place the pool on numa_node, otherwise the os decides
+    bool bind_numa_node;
+    uint32_t numa_node;
+    // guard malloc/free with a mutex so the pool can be shared between threads
+    bool thread_safe;
 } SSysMemoryPoolDesc;
 
+typedef struct SSysMemoryPoolInfo {
+    void* start;
+    size_t size;
+    ESysMemoryPageKind page_kind;
+    int32_t numa_node; // -1 if not bound
+} SSysMemoryPoolInfo;
+
 typedef struct SSysMemoryPool SSysMemoryPool;
 typedef struct SSysMemoryPool* SSysMemoryPoolId;
 SKR_EXTERN_C SKR_CORE_API SSysMemoryPoolId sakura_sysmem_pool_create(const SSysMemoryPoolDesc* pdesc);
+// frees the blocks still allocated from the pool & gives its pages back to the os, call it on the creating thread
 SKR_EXTERN_C SKR_CORE_API void sakura_sysmem_pool_destroy(SSysMemoryPoolId pool);
 SKR_EXTERN_C SKR_CORE_API void* _sakura_sysmem_pool_malloc(SSysMemoryPoolId pool, size_t size);
 SKR_EXTERN_C SKR_CORE_API void* _sakura_sysmem_pool_free(SSysMemoryPoolId pool, void* ptr);
+SKR_EXTERN_C SKR_CORE_API void sakura_sysmem_pool_get_info(SSysMemoryPoolId pool, SSysMemoryPoolInfo* pinfo);
+SKR_EXTERN_C SKR_CORE_API bool sakura_sysmem_pool_contains(SSysMemoryPoolId pool, const void* ptr);
+
+// numa
+SKR_EXTERN_C SKR_CORE_API uint32_t sakura_sysmem_numa_node_count(void);
+SKR_EXTERN_C SKR_CORE_API uint32_t sakura_sysmem_current_numa_node(void);
+
+// one pool per numa node, pdesc->size is the size of each node pool
+typedef struct SSysMemoryNumaPools SSysMemoryNumaPools;
+typedef struct SSysMemoryNumaPools* SSysMemoryNumaPoolsId;
+SKR_EXTERN_C SKR_CORE_API SSysMemoryNumaPoolsId sakura_sysmem_numa_pools_create(const SSysMemoryPoolDesc* pdesc);
+SKR_EXTERN_C SKR_CORE_API void sakura_sysmem_numa_pools_destroy(SSysMemoryNumaPoolsId pools);
+SKR_EXTERN_C SKR_CORE_API uint32_t sakura_sysmem_numa_pools_count(SSysMemoryNumaPoolsId pools);
+SKR_EXTERN_C SKR_CORE_API SSysMemoryPoolId sakura_sysmem_numa_pools_get(SSysMemoryNumaPoolsId pools, uint32_t numa_node);
+// pool of the numa node the calling thread is running on
+SKR_EXTERN_C SKR_CORE_API SSysMemoryPoolId sakura_sysmem_numa_pools_local(SSysMemoryNumaPoolsId pools);
 
 #if defined(SKR_PROFILE_ENABLE) && defined(TRACY_TRACE_ALLOCATION)
 
@@ -36,13 +75,13 @@ SKR_FORCEINLINE void* SkrSysMemPoolFreeWithCZone(SSysMemoryPoolId pool, void* pt
     return ptr;
 }
 
-// thread unsafe
+// thread unsafe unless created with thread_safe
 #define sakura_sysmem_pool_malloc(pool, size) SkrSysMemPoolMallocWithCZone((pool), (size), SKR_ALLOC_CAT(SKR_ALLOC_STRINGFY(__FILE__),SKR_ALLOC_STRINGFY(__LINE__)) )
 #define sakura_sysmem_pool_free(pool, p) SkrSysMemPoolFreeWithCZone((pool), (p), SKR_ALLOC_CAT(SKR_ALLOC_STRINGFY(__FILE__),SKR_ALLOC_STRINGFY(__LINE__)) )
 
 #else
 
-// thread unsafe
+// thread unsafe unless created with thread_safe
 #define sakura_sysmem_pool_malloc(pool, size) _sakura_sysmem_pool_malloc((pool), (size))
 #define sakura_sysmem_pool_free(pool, p) _sakura_sysmem_pool_free((pool), (p))
 
@@ -18,5 +18,10 @@ const char8_t* skr_get_current_process_name();
 SKR_EXTERN_C SKR_CORE_API
 SProcessId skr_get_process_id(SProcessHandle);
 
+// blocks until the process exits, returns its exit code & releases the handle
 SKR_EXTERN_C SKR_CORE_API
-int skr_wait_process(SProcessHandle process);
\ No newline at end of file
+int skr_wait_process(SProcessHandle process);
+
+// returns true with the exit code once the process has exited, never blocks. the handle stays valid
+SKR_EXTERN_C SKR_CORE_API
+bool skr_try_wait_process(SProcessHandle process, int* exit_code);
\ No newline at end of file
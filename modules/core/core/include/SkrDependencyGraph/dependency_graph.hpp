@@ -1,7 +1,8 @@
 #pragma once
 #include "SkrBase/config.h"
 #include "SkrContainersDef/stl_function.hpp"
-#include "SkrBase/config.h"
+#include "SkrContainersDef/stl_vector.hpp"
+#include <utility>
 
 namespace skr
 {
@@ -9,7 +10,7 @@ typedef uint64_t dag_id_t;
 class DependencyGraphEdge;
 class DependencyGraphNode
 {
-    friend class DependencyGraphImpl;
+    friend class DependencyGraph;
 
 public:
     DependencyGraphNode()                       = default;
@@ -22,10 +23,14 @@ public:
     const dag_id_t get_id() const SKR_NOEXCEPT { return id; }
     uint32_t       outgoing_edges() SKR_NOEXCEPT;
     uint32_t       incoming_edges() SKR_NOEXCEPT;
-    uint32_t       foreach_neighbors(skr::stl_function<void(DependencyGraphNode* neig)>) SKR_NOEXCEPT;
-    uint32_t       foreach_neighbors(skr::stl_function<void(const DependencyGraphNode* neig)>) const SKR_NOEXCEPT;
-    uint32_t       foreach_inv_neighbors(skr::stl_function<void(DependencyGraphNode* inv_neig)>) SKR_NOEXCEPT;
-    uint32_t       foreach_inv_neighbors(skr::stl_function<void(const DependencyGraphNode* inv_neig)>) const SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_neighbors(F&& f) SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_neighbors(F&& f) const SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_inv_neighbors(F&& f) SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_inv_neighbors(F&& f) const SKR_NOEXCEPT;
 
 private:
     class DependencyGraph* graph;
@@ -34,7 +39,7 @@ private:
 
 class DependencyGraphEdge
 {
-    friend class DependencyGraphImpl;
+    friend class DependencyGraph;
 
 public:
     DependencyGraphEdge()                       = default;
@@ -53,6 +58,11 @@ protected:
     dag_id_t               to_node;
 };
 
+// Nodes and links are appended to flat arrays while the graph is built, the first query after a topology
+// change packs them into compressed sparse rows (contiguous in/out adjacency per node).
+// Storage is kept across clear() so graphs rebuilt every frame stop hitting the allocator once warmed up.
+// Queries are read-only and re-entrant, except the first one after a change (call build() up front to
+// share a graph between threads) and the reachability helpers, which use shared scratch memory.
 class DependencyGraph
 {
 public:
@@ -60,42 +70,223 @@ public:
     using Edge = DependencyGraphEdge;
     static DependencyGraph* Create() SKR_NOEXCEPT;
     static void             Destroy(DependencyGraph* graph) SKR_NOEXCEPT;
-    virtual ~DependencyGraph() SKR_NOEXCEPT                                        = default;
-    virtual dag_id_t insert(Node* node) SKR_NOEXCEPT                               = 0;
-    virtual Node*    access_node(dag_id_t handle) SKR_NOEXCEPT                     = 0;
-    virtual bool     remove(dag_id_t node) SKR_NOEXCEPT                            = 0;
-    virtual bool     remove(Node* node) SKR_NOEXCEPT                               = 0;
-    virtual bool     clear() SKR_NOEXCEPT                                          = 0;
-    virtual bool     link(Node* from, Node* to, Edge* edge = nullptr) SKR_NOEXCEPT = 0;
-    // virtual Edge* linkage(Node* from, Node* to) SKR_NOEXCEPT = 0;
-    // virtual Edge* linkage(dag_id_t from, dag_id_t to) SKR_NOEXCEPT = 0;
-    // virtual bool unlink(Node* from, Node* to) SKR_NOEXCEPT = 0;
-    // virtual bool unlink(dag_id_t from, dag_id_t to) SKR_NOEXCEPT = 0;
-    virtual Node*    from_node(Edge* edge) SKR_NOEXCEPT                                                                           = 0;
-    virtual Node*    to_node(Edge* edge) SKR_NOEXCEPT                                                                             = 0;
-    virtual uint32_t foreach_neighbors(Node* node, skr::stl_function<void(Node* neig)>) SKR_NOEXCEPT                              = 0;
-    virtual uint32_t foreach_neighbors(dag_id_t node, skr::stl_function<void(Node* neig)>) SKR_NOEXCEPT                           = 0;
-    virtual uint32_t foreach_neighbors(const Node* node, skr::stl_function<void(const Node* neig)>) const SKR_NOEXCEPT            = 0;
-    virtual uint32_t foreach_neighbors(const dag_id_t node, skr::stl_function<void(const Node* neig)>) const SKR_NOEXCEPT         = 0;
-    virtual uint32_t foreach_inv_neighbors(Node* node, skr::stl_function<void(Node* inv_neig)>) SKR_NOEXCEPT                      = 0;
-    virtual uint32_t foreach_inv_neighbors(dag_id_t node, skr::stl_function<void(Node* inv_neig)>) SKR_NOEXCEPT                   = 0;
-    virtual uint32_t foreach_inv_neighbors(const Node* node, skr::stl_function<void(const Node* inv_neig)>) const SKR_NOEXCEPT    = 0;
-    virtual uint32_t foreach_inv_neighbors(const dag_id_t node, skr::stl_function<void(const Node* inv_neig)>) const SKR_NOEXCEPT = 0;
-    virtual uint32_t outgoing_edges(const Node* node) SKR_NOEXCEPT                                                                = 0;
-    virtual uint32_t outgoing_edges(dag_id_t id) SKR_NOEXCEPT                                                                     = 0;
-    virtual uint32_t foreach_outgoing_edges(dag_id_t node,
-                                            skr::stl_function<void(Node* from, Node* to, Edge* edge)>) SKR_NOEXCEPT               = 0;
-    virtual uint32_t foreach_outgoing_edges(Node* node,
-                                            skr::stl_function<void(Node* from, Node* to, Edge* edge)>) SKR_NOEXCEPT               = 0;
-    virtual uint32_t incoming_edges(const Node* node) SKR_NOEXCEPT                                                                = 0;
-    virtual uint32_t incoming_edges(dag_id_t id) SKR_NOEXCEPT                                                                     = 0;
-    virtual uint32_t foreach_incoming_edges(Node* node,
-                                            skr::stl_function<void(Node* from, Node* to, Edge* edge)>) SKR_NOEXCEPT               = 0;
-    virtual uint32_t foreach_incoming_edges(dag_id_t node,
-                                            skr::stl_function<void(Node* from, Node* to, Edge* edge)>) SKR_NOEXCEPT               = 0;
-    virtual uint32_t foreach_edges(skr::stl_function<void(Node* from, Node* to, Edge* edge)>) SKR_NOEXCEPT                        = 0;
+
+    dag_id_t insert(Node* node) SKR_NOEXCEPT;
+    Node*    access_node(dag_id_t handle) SKR_NOEXCEPT { return nodes[handle]; }
+    bool     remove(dag_id_t node) SKR_NOEXCEPT;
+    bool     remove(Node* node) SKR_NOEXCEPT { return remove(node->id); }
+    bool     clear() SKR_NOEXCEPT;
+    bool     link(Node* from, Node* to, Edge* edge = nullptr) SKR_NOEXCEPT;
+    Node*    from_node(Edge* edge) SKR_NOEXCEPT { return access_node(edge->from_node); }
+    Node*    to_node(Edge* edge) SKR_NOEXCEPT { return access_node(edge->to_node); }
+    // pack adjacency now, queries do it lazily otherwise
+    void     build() SKR_NOEXCEPT;
+    uint32_t node_count() const SKR_NOEXCEPT { return (uint32_t)nodes.size(); }
+
+    // neighbors: sources of links pointing to node
+    template <typename F>
+    uint32_t foreach_neighbors(dag_id_t node, F&& f) SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_neighbors(const dag_id_t node, F&& f) const SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_neighbors(Node* node, F&& f) SKR_NOEXCEPT { return foreach_neighbors(node->get_id(), std::forward<F>(f)); }
+    template <typename F>
+    uint32_t foreach_neighbors(const Node* node, F&& f) const SKR_NOEXCEPT { return foreach_neighbors(node->get_id(), std::forward<F>(f)); }
+    // inv neighbors: targets of links starting from node
+    template <typename F>
+    uint32_t foreach_inv_neighbors(dag_id_t node, F&& f) SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_inv_neighbors(const dag_id_t node, F&& f) const SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_inv_neighbors(Node* node, F&& f) SKR_NOEXCEPT { return foreach_inv_neighbors(node->get_id(), std::forward<F>(f)); }
+    template <typename F>
+    uint32_t foreach_inv_neighbors(const Node* node, F&& f) const SKR_NOEXCEPT { return foreach_inv_neighbors(node->get_id(), std::forward<F>(f)); }
+
+    uint32_t outgoing_edges(const Node* node) SKR_NOEXCEPT { return outgoing_edges(node->id); }
+    uint32_t outgoing_edges(dag_id_t id) SKR_NOEXCEPT;
+    uint32_t incoming_edges(const Node* node) SKR_NOEXCEPT { return incoming_edges(node->id); }
+    uint32_t incoming_edges(dag_id_t id) SKR_NOEXCEPT;
+    // f(Node* from, Node* to, Edge* edge), same sides as foreach_neighbors
+    template <typename F>
+    uint32_t foreach_outgoing_edges(dag_id_t node, F&& f) SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_outgoing_edges(Node* node, F&& f) SKR_NOEXCEPT { return foreach_outgoing_edges(node->id, std::forward<F>(f)); }
+    // f(Node* from, Node* to, Edge* edge), same sides as foreach_inv_neighbors
+    template <typename F>
+    uint32_t foreach_incoming_edges(dag_id_t node, F&& f) SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_incoming_edges(Node* node, F&& f) SKR_NOEXCEPT { return foreach_incoming_edges(node->id, std::forward<F>(f)); }
+    template <typename F>
+    uint32_t foreach_edges(F&& f) SKR_NOEXCEPT;
+
+    // orders live nodes so that every link goes from an earlier node to a later one,
+    // ties are broken by id. returns false (and a partial order) if the graph has a cycle
+    bool topological_sort(skr::stl_vector<dag_id_t>& order) SKR_NOEXCEPT;
+    // true if to can be reached from from by following links
+    bool reachable(dag_id_t from, dag_id_t to) SKR_NOEXCEPT;
+    // visits every node reachable from start by following links (inv: against links), start excluded
+    template <typename F>
+    uint32_t foreach_reachable(dag_id_t start, F&& f) SKR_NOEXCEPT { return foreach_reachable_(start, false, std::forward<F>(f)); }
+    template <typename F>
+    uint32_t foreach_inv_reachable(dag_id_t start, F&& f) SKR_NOEXCEPT { return foreach_reachable_(start, true, std::forward<F>(f)); }
+
+private:
+    struct Arc {
+        uint32_t from;
+        uint32_t to;
+        Edge*    edge;
+    };
+    // [begin, end) in in_arcs/out_arcs for one node
+    struct Range {
+        const uint32_t* begin;
+        const uint32_t* end;
+    };
+
+    DependencyGraph() SKR_NOEXCEPT = default;
+    ~DependencyGraph() SKR_NOEXCEPT = default;
+
+    void  build_adjacency() const SKR_NOEXCEPT;
+    Range in_range(dag_id_t id) const SKR_NOEXCEPT
+    {
+        if (dirty) build_adjacency();
+        return { in_arcs.data() + in_offsets[id], in_arcs.data() + in_offsets[id + 1] };
+    }
+    Range out_range(dag_id_t id) const SKR_NOEXCEPT
+    {
+        if (dirty) build_adjacency();
+        return { out_arcs.data() + out_offsets[id], out_arcs.data() + out_offsets[id + 1] };
+    }
+    uint32_t begin_visit() SKR_NOEXCEPT;
+    template <typename F>
+    uint32_t foreach_reachable_(dag_id_t start, bool inv, F&& f) SKR_NOEXCEPT;
+
+    skr::stl_vector<Node*> nodes; // indexed by id, nullptr once removed
+    skr::stl_vector<Arc>   arcs;  // in link order
+
+    // compressed sparse rows over arcs, rebuilt lazily
+    mutable bool                      dirty = true;
+    mutable skr::stl_vector<uint32_t> in_offsets;
+    mutable skr::stl_vector<uint32_t> in_arcs;
+    mutable skr::stl_vector<uint32_t> out_offsets;
+    mutable skr::stl_vector<uint32_t> out_arcs;
+
+    // traversal scratch, marks are compared against an epoch so they never need clearing
+    skr::stl_vector<uint32_t> visit_marks;
+    skr::stl_vector<uint32_t> visit_stack;
+    uint32_t                  visit_epoch = 0;
 };
 
+template <typename F>
+inline uint32_t DependencyGraph::foreach_neighbors(dag_id_t id, F&& f) SKR_NOEXCEPT
+{
+    const auto range = in_range(id);
+    for (auto it = range.begin; it != range.end; ++it)
+        f(nodes[arcs[*it].from]);
+    return (uint32_t)(range.end - range.begin);
+}
+
+template <typename F>
+inline uint32_t DependencyGraph::foreach_neighbors(const dag_id_t id, F&& f) const SKR_NOEXCEPT
+{
+    const auto range = in_range(id);
+    for (auto it = range.begin; it != range.end; ++it)
+        f(static_cast<const Node*>(nodes[arcs[*it].from]));
+    return (uint32_t)(range.end - range.begin);
+}
+
+template <typename F>
+inline uint32_t DependencyGraph::foreach_inv_neighbors(dag_id_t id, F&& f) SKR_NOEXCEPT
+{
+    const auto range = out_range(id);
+    for (auto it = range.begin; it != range.end; ++it)
+        f(nodes[arcs[*it].to]);
+    return (uint32_t)(range.end - range.begin);
+}
+
+template <typename F>
+inline uint32_t DependencyGraph::foreach_inv_neighbors(const dag_id_t id, F&& f) const SKR_NOEXCEPT
+{
+    const auto range = out_range(id);
+    for (auto it = range.begin; it != range.end; ++it)
+        f(static_cast<const Node*>(nodes[arcs[*it].to]));
+    return (uint32_t)(range.end - range.begin);
+}
+
+inline uint32_t DependencyGraph::outgoing_edges(dag_id_t id) SKR_NOEXCEPT
+{
+    const auto range = in_range(id);
+    return (uint32_t)(range.end - range.begin);
+}
+
+inline uint32_t DependencyGraph::incoming_edges(dag_id_t id) SKR_NOEXCEPT
+{
+    const auto range = out_range(id);
+    return (uint32_t)(range.end - range.begin);
+}
+
+template <typename F>
+inline uint32_t DependencyGraph::foreach_outgoing_edges(dag_id_t id, F&& f) SKR_NOEXCEPT
+{
+    const auto range = in_range(id);
+    for (auto it = range.begin; it != range.end; ++it)
+    {
+        const auto& arc = arcs[*it];
+        f(nodes[arc.from], nodes[arc.to], arc.edge);
+    }
+    return (uint32_t)(range.end - range.begin);
+}
+
+template <typename F>
+inline uint32_t DependencyGraph::foreach_incoming_edges(dag_id_t id, F&& f) SKR_NOEXCEPT
+{
+    const auto range = out_range(id);
+    for (auto it = range.begin; it != range.end; ++it)
+    {
+        const auto& arc = arcs[*it];
+        f(nodes[arc.from], nodes[arc.to], arc.edge);
+    }
+    return (uint32_t)(range.end - range.begin);
+}
+
+template <typename F>
+inline uint32_t DependencyGraph::foreach_edges(F&& f) SKR_NOEXCEPT
+{
+    uint32_t count = 0;
+    for (const auto& arc : arcs)
+    {
+        if (!nodes[arc.from] || !nodes[arc.to]) continue;
+        f(nodes[arc.from], nodes[arc.to], arc.edge);
+        count++;
+    }
+    return count;
+}
+
+template <typename F>
+inline uint32_t DependencyGraph::foreach_reachable_(dag_id_t start, bool inv, F&& f) SKR_NOEXCEPT
+{
+    const uint32_t epoch = begin_visit();
+    uint32_t       count = 0;
+    visit_stack.clear();
+    visit_stack.push_back((uint32_t)start);
+    visit_marks[start] = epoch;
+    while (!visit_stack.empty())
+    {
+        const uint32_t current = visit_stack.back();
+        visit_stack.pop_back();
+        const auto range = inv ? in_range(current) : out_range(current);
+        for (auto it = range.begin; it != range.end; ++it)
+        {
+            const uint32_t next = inv ? arcs[*it].from : arcs[*it].to;
+            if (visit_marks[next] == epoch) continue;
+            visit_marks[next] = epoch;
+            visit_stack.push_back(next);
+            f(nodes[next]);
+            count++;
+        }
+    }
+    return count;
+}
+
 inline DependencyGraphNode* DependencyGraphEdge::from() SKR_NOEXCEPT
 {
     return graph->access_node(from_node);
@@ -105,4 +296,38 @@ inline DependencyGraphNode* DependencyGraphEdge::to() SKR_NOEXCEPT
     return graph->access_node(to_node);
 }
 
-} // namespace skr
\ No newline at end of file
+inline uint32_t DependencyGraphNode::outgoing_edges() SKR_NOEXCEPT
+{
+    return graph->outgoing_edges(this);
+}
+
+inline uint32_t DependencyGraphNode::incoming_edges() SKR_NOEXCEPT
+{
+    return graph->incoming_edges(this);
+}
+
+template <typename F>
+inline uint32_t DependencyGraphNode::foreach_neighbors(F&& f) SKR_NOEXCEPT
+{
+    return graph->foreach_neighbors(this, std::forward<F>(f));
+}
+
+template <typename F>
+inline uint32_t DependencyGraphNode::foreach_neighbors(F&& f) const SKR_NOEXCEPT
+{
+    return static_cast<const DependencyGraph*>(graph)->foreach_neighbors(this, std::forward<F>(f));
+}
+
+template <typename F>
+inline uint32_t DependencyGraphNode::foreach_inv_neighbors(F&& f) SKR_NOEXCEPT
+{
+    return graph->foreach_inv_neighbors(this, std::forward<F>(f));
+}
+
+template <typename F>
+inline uint32_t DependencyGraphNode::foreach_inv_neighbors(F&& f) const SKR_NOEXCEPT
+{
+    return static_cast<const DependencyGraph*>(graph)->foreach_inv_neighbors(this, std::forward<F>(f));
+}
+
+} // namespace skr
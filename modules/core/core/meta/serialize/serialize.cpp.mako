@@ -76,6 +76,52 @@ bool JsonSerde<${record.name}>::read_fields(skr::archive::JsonReader* r, ${recor
 %endfor
     return true;
 } 
+skr::archive::JsonFieldDispatch JsonSerde<${record.name}>::read_field(skr::archive::JsonReader* r, ${record.name}& v, skr::StringView key)
+{
+    using skr::archive::JsonFieldDispatch;
+%if record_serde_data.json_fields:
+<% dispatch = record_serde_data.json_dispatch %>\
+    switch (skr::archive::json_field_hash(key, ${dispatch.seed}u) & ${dispatch.mask}u)
+    {
+%for slot, field in dispatch.slots:
+<% field_type = f"{field.type}[{field.array_size}]" if field.array_size else field.type %>\
+    case ${slot}:
+        if (key == u8"${field.name}")
+        {
+            if(!json_read<${field_type}>(r, v.${field.name}))
+            {
+                SKR_LOG_ERROR(JsonFieldArchiveFailedFormat, "${record.name}", "${field.name}", "UNKNOWN ERROR");  // TODO: ERROR MESSAGE
+                return JsonFieldDispatch::Failed;
+            }
+            return JsonFieldDispatch::Success;
+        }
+        break;
+%endfor
+    default:
+        break;
+    }
+%endif
+
+    // dispatch to bases
+%for base in record.bases:
+    if (auto result = JsonSerde<${base}>::read_field(r, v, key); result != JsonFieldDispatch::NotFound)
+        return result;
+%endfor
+    return JsonFieldDispatch::NotFound;
+}
+bool JsonSerde<${record.name}>::read_fields_streaming(skr::archive::JsonReader* r, ${record.name}& v)
+{
+    SkrZoneScopedN("JsonSerde<${record.name}>::read_fields_streaming");
+
+    // visit each member once in document order, unknown members are skipped
+    skr::StringView key;
+    while (r->NextField(key))
+    {
+        if (read_field(r, v, key) == skr::archive::JsonFieldDispatch::Failed)
+            return false;
+    }
+    return true;
+}
 bool JsonSerde<${record.name}>::write_fields(skr::archive::JsonWriter* w, const ${record.name}& v)
 {
     // write bases
@@ -96,7 +142,11 @@ bool JsonSerde<${record.name}>::read(skr::archive::JsonReader* r, ${record.name}
 {
     SkrZoneScopedN("JsonSerde<${record.name}>::write");
     SKR_EXPECTED_CHECK(r->StartObject(), false);
-    if (!read_fields(r, v)) return false;
+    if (r->IsStreamFields())
+    {
+        if (!read_fields_streaming(r, v)) return false;
+    }
+    else if (!read_fields(r, v)) return false;
     SKR_EXPECTED_CHECK(r->EndObject(), false);
     return true;
 }
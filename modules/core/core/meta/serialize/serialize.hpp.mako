@@ -18,6 +18,8 @@ template <>
 struct ${api} JsonSerde<${record.name}>
 {
     static bool read_fields(skr::archive::JsonReader* r, ${record.name}& v);
+    static bool read_fields_streaming(skr::archive::JsonReader* r, ${record.name}& v);
+    static skr::archive::JsonFieldDispatch read_field(skr::archive::JsonReader* r, ${record.name}& v, skr::StringView key);
     static bool write_fields(skr::archive::JsonWriter* w, const ${record.name}& v);
 
     static bool read(skr::archive::JsonReader* r, ${record.name}& v);
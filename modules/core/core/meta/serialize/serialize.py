@@ -10,12 +10,47 @@ from dataclasses import dataclass, field
 # TODO. serde::policy，利用 attribute 来控制具体序列化的细节行为
 
 
+@dataclass
+class JsonFieldDispatchData:
+    seed: int
+    mask: int
+    slots: t.List[t.Tuple[int, cpp.Field]]
+
+
 @dataclass
 class RecordSerdeData:
     enable_json: bool
     enable_bin: bool
     json_fields: t.List[cpp.Field]
     bin_fields: t.List[cpp.Field]
+    json_dispatch: JsonFieldDispatchData = None
+
+
+# keep in sync with skr::archive::json_field_hash
+def json_field_hash(name: str, seed: int) -> int:
+    hash = (2166136261 ^ seed) & 0xFFFFFFFF
+    for byte in name.encode("utf-8"):
+        hash ^= byte
+        hash = (hash * 16777619) & 0xFFFFFFFF
+    return hash
+
+
+# find a seed that maps every field name to a distinct slot of a power of two table
+def build_json_field_dispatch(fields: t.List[cpp.Field]) -> JsonFieldDispatchData:
+    table_size = 1
+    while table_size < len(fields):
+        table_size *= 2
+    while True:
+        mask = table_size - 1
+        for seed in range(0, 4096):
+            slots = [json_field_hash(field.name, seed) & mask for field in fields]
+            if len(set(slots)) == len(slots):
+                return JsonFieldDispatchData(
+                    seed=seed,
+                    mask=mask,
+                    slots=sorted(zip(slots, fields), key=lambda pair: pair[0])
+                )
+        table_size *= 2
 
 
 @dataclass
@@ -125,6 +160,10 @@ class SerdeGenerator(gen.GeneratorBase):
                 # save generator data
                 field.generator_data["serde"] = field_serde_data
 
+            # precompute field dispatch for streaming json read
+            if record_serde_data.enable_json:
+                record_serde_data.json_dispatch = build_json_field_dispatch(record_serde_data.json_fields)
+
             # save generator data
             record.generator_data["serde"] = record_serde_data
 
@@ -1,6 +1,6 @@
 #include "SkrBase/misc/defer.hpp"
 #include "SkrArchive/json/reader.h"
-#include "cstr_builder.hpp"
+#include "yyjson/yyjson.h"
 #include "SkrCore/log.h"
 
 #define SKR_RET_JSON_READ_ERROR_IF(cond, what) { if (!(cond)) { return what; } }
@@ -10,31 +10,52 @@ namespace skr::archive {
 struct _ReaderHelper
 {
     using CharType = _JsonReader::CharType;
+    using Level = _JsonReader::Level;
+
+    // walk arrays with a cursor, yyjson_arr_get is a linear scan for non-flat arrays
+    static yyjson_val* NextElement(Level& level)
+    {
+        auto arr = (yyjson_val*)level._value;
+        if (level._index >= yyjson_arr_size(arr))
+            return nullptr;
+        auto elem = level._cursor ? (yyjson_val*)level._cursor : unsafe_yyjson_get_first(arr);
+        level._cursor = (_JsonReader::ValueType*)unsafe_yyjson_get_next(elem);
+        level._index++;
+        return elem;
+    }
+
+    // empty key consumes the member visited by NextField, otherwise look it up without building a c string
+    static yyjson_val* FindMember(Level& level, skr::StringView key)
+    {
+        if (key.is_empty())
+        {
+            auto field = (yyjson_val*)level._field;
+            level._field = nullptr;
+            return field;
+        }
+        return yyjson_obj_getn((yyjson_val*)level._value, (const char*)key.raw().data(), key.raw().size());
+    }
 
 #define IS_TYPE(T) if constexpr (std::is_same_v<Type, T>)
 
     template <JsonPrimitiveReadableType T>
     static JsonReadResult ReadValue(_JsonReader* r, skr::StringView key, T& value) 
     {
-        using Level = _JsonReader::Level;
         using Type = std::decay_t<T>;
         SKR_RET_JSON_READ_ERROR_IF(!r->_stack.empty(), JsonReadError::NoOpenScope);
 
-        auto type = r->_stack.back()._type;
-        auto parent = (yyjson_val*)r->_stack.back()._value;
-        CStringBuilder keyBuilder((yyjson_doc*)r->_document, key);
-        const char* ckey = keyBuilder.c_str();
+        auto& level = r->_stack.back();
         yyjson_val* found = nullptr;
-        if (type == Level::kObject)
+        if (level._type == Level::kObject)
         {
-            SKR_RET_JSON_READ_ERROR_IF(!key.is_empty(), JsonReadError::EmptyObjectFieldKey);
-            found = yyjson_obj_get((yyjson_val*)parent, ckey);
+            SKR_RET_JSON_READ_ERROR_IF(!key.is_empty() || level._field, JsonReadError::EmptyObjectFieldKey);
+            found = FindMember(level, key);
             SKR_RET_JSON_READ_ERROR_IF(found, JsonReadError::KeyNotFound);
         }
-        else if (type == Level::kArray)
+        else if (level._type == Level::kArray)
         {
             SKR_RET_JSON_READ_ERROR_IF(key.is_empty(), JsonReadError::ArrayElementWithKey);
-            found = yyjson_arr_get((yyjson_val*)parent, r->_stack.back()._index++);
+            found = NextElement(level);
             SKR_RET_JSON_READ_ERROR_IF(found, JsonReadError::KeyNotFound);
         }
 
@@ -55,7 +76,7 @@ struct _ReaderHelper
         else IS_TYPE(double)
             value = yyjson_get_real(found);
         else IS_TYPE(skr::String)
-            value = skr::String((const char8_t*)yyjson_get_str(found));
+            value = skr::String(skr::StringView((const char8_t*)yyjson_get_str(found), yyjson_get_len(found)));
         else
             return JsonReadError::UnknownTypeToRead;
 
@@ -65,7 +86,8 @@ struct _ReaderHelper
 #undef IS_TYPE
 };
 
-_JsonReader::_JsonReader(skr::StringView json)
+_JsonReader::_JsonReader(skr::StringView json, bool stream_fields)
+    : _stream_fields(stream_fields)
 {
     yyjson_read_err err = {};
     _document = (DocumentType*)yyjson_read_opts(
@@ -99,15 +121,15 @@ JsonReadResult _JsonReader::StartObject(skr::StringView key)
         if (parent_type == YYJSON_TYPE_ARR)
         {
             SKR_RET_JSON_READ_ERROR_IF(key.is_empty(), JsonReadError::ArrayElementWithKey);
-            auto obj = yyjson_arr_get(parent, _stack.back()._index++);
+            auto obj = _ReaderHelper::NextElement(_stack.back());
             SKR_RET_JSON_READ_ERROR_IF(obj, JsonReadError::KeyNotFound);
             SKR_RET_JSON_READ_ERROR_IF(yyjson_get_type(obj) == YYJSON_TYPE_OBJ, JsonReadError::ScopeTypeMismatch);
             _stack.emplace((ValueType*)obj, Level::kObject);
         }
         else if (parent_type == YYJSON_TYPE_OBJ)
         {
-            SKR_RET_JSON_READ_ERROR_IF(!key.is_empty(), JsonReadError::EmptyObjectFieldKey);
-            auto obj = yyjson_obj_get(parent, (const char*)key.raw().data());
+            SKR_RET_JSON_READ_ERROR_IF(!key.is_empty() || _stack.back()._field, JsonReadError::EmptyObjectFieldKey);
+            auto obj = _ReaderHelper::FindMember(_stack.back(), key);
             SKR_RET_JSON_READ_ERROR_IF(obj, JsonReadError::KeyNotFound);
             SKR_RET_JSON_READ_ERROR_IF(yyjson_get_type(obj) == YYJSON_TYPE_OBJ, JsonReadError::ScopeTypeMismatch);
             _stack.emplace((ValueType*)obj, Level::kObject);
@@ -134,7 +156,7 @@ JsonReadResult _JsonReader::StartArray(skr::StringView key, SizeType& count)
     if (parent_type == YYJSON_TYPE_ARR)
     {
         SKR_RET_JSON_READ_ERROR_IF(key.is_empty(), JsonReadError::ArrayElementWithKey);
-        auto arr = yyjson_arr_get(parent, _stack.back()._index++);
+        auto arr = _ReaderHelper::NextElement(_stack.back());
         SKR_RET_JSON_READ_ERROR_IF(arr, JsonReadError::KeyNotFound);
         SKR_RET_JSON_READ_ERROR_IF(yyjson_get_type(arr) == YYJSON_TYPE_ARR, JsonReadError::ScopeTypeMismatch);
         count = yyjson_arr_size(arr);
@@ -142,8 +164,8 @@ JsonReadResult _JsonReader::StartArray(skr::StringView key, SizeType& count)
     }
     else if (parent_type == YYJSON_TYPE_OBJ)
     {
-        SKR_RET_JSON_READ_ERROR_IF(!key.is_empty(), JsonReadError::EmptyObjectFieldKey);
-        auto arr = yyjson_obj_get(parent, (const char*)key.raw().data());
+        SKR_RET_JSON_READ_ERROR_IF(!key.is_empty() || _stack.back()._field, JsonReadError::EmptyObjectFieldKey);
+        auto arr = _ReaderHelper::FindMember(_stack.back(), key);
         SKR_RET_JSON_READ_ERROR_IF(arr, JsonReadError::KeyNotFound);
         SKR_RET_JSON_READ_ERROR_IF(yyjson_get_type(arr) == YYJSON_TYPE_ARR, JsonReadError::ScopeTypeMismatch);
         count = yyjson_arr_size(arr);
@@ -166,15 +188,31 @@ bool _JsonReader::HasKey(skr::StringView key)
 {
     auto type = _stack.back()._type;
     auto parent = (yyjson_val*)_stack.back()._value;
-    CStringBuilder keyBuilder((yyjson_doc*)_document, key);
-    const char* ckey = keyBuilder.c_str();
     if (type == Level::kObject)
     {
-        return yyjson_obj_get((yyjson_val*)parent, ckey);
+        return yyjson_obj_getn(parent, (const char*)key.raw().data(), key.raw().size());
     }
     return false;
 }
 
+bool _JsonReader::NextField(skr::StringView& key)
+{
+    if (_stack.empty() || _stack.back()._type != Level::kObject)
+        return false;
+    auto& level = _stack.back();
+    auto obj = (yyjson_val*)level._value;
+    level._field = nullptr; // skip the previous member if it was not consumed
+    if (level._index >= yyjson_obj_size(obj))
+        return false;
+    auto k = level._cursor ? (yyjson_val*)level._cursor : unsafe_yyjson_get_first(obj);
+    auto v = k + 1;
+    level._cursor = (ValueType*)unsafe_yyjson_get_next(v);
+    level._field = (ValueType*)v;
+    level._index++;
+    key = skr::StringView((const char8_t*)yyjson_get_str(k), yyjson_get_len(k));
+    return true;
+}
+
 JsonReadResult _JsonReader::ReadBool(skr::StringView key, bool& value)
 {
     return _ReaderHelper::ReadValue(this, key, value);
@@ -215,8 +253,8 @@ JsonReadResult _JsonReader::ReadString(skr::StringView key, skr::String& value)
     return _ReaderHelper::ReadValue(this, key, value);
 }
 
-JsonReader::JsonReader(skr::StringView json)
-    : _JsonReader(json)
+JsonReader::JsonReader(skr::StringView json, bool stream_fields)
+    : _JsonReader(json, stream_fields)
 {
 
 }
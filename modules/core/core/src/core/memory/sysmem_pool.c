@@ -1,7 +1,30 @@
 #include "SkrCore/memory/sysmem_pool.h"
+#include "SkrOS/thread.h"
 // NOW MI-MALLOC IS A MUST
 #include "mimalloc.h"
 
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+    #if defined(_MSC_VER)
+        #pragma comment(lib, "advapi32.lib")
+    #endif
+#else
+    #include <sys/mman.h>
+    #include <stdio.h>
+    #include <unistd.h>
+    #if defined(__linux__)
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+#define SKR_SYSMEM_LARGE_PAGE_SIZE (2ull * 1024ull * 1024ull)
+#define SKR_SYSMEM_HUGE_PAGE_SIZE (1024ull * 1024ull * 1024ull)
+// mimalloc arenas are made of 32MiB segments (MI_SEGMENT_SIZE), aligned to their size
+#define SKR_SYSMEM_ARENA_ALIGN (32ull * 1024ull * 1024ull)
+
 typedef struct SSysMemoryPool
 {
     mi_arena_id_t arena;
@@ -9,33 +32,335 @@ typedef struct SSysMemoryPool
     mi_heap_t* heap;
     void* start;
     char* name; // keep under cacheline, do not use char[N]
+    ESysMemoryPageKind page_kind;
+    int32_t numa_node;
+    bool thread_safe;
+    SMutex mutex;
 } SSysMemoryPool;
 
-SSysMemoryPoolId sakura_sysmem_pool_create(const SSysMemoryPoolDesc* pdesc)
+static size_t sakura_sysmem_align_up(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// pools own their os memory and hand it to mimalloc as an exclusive pinned arena. mimalloc (2.1) can not
+// unregister arenas and has a fixed number of slots, so destroy gives the physical pages back to the os but keeps
+// the address range & the arena, a later pool of the same page kind & numa node maps fresh pages into it
+#if defined(_WIN32)
+
+typedef PVOID(WINAPI* PFN_sakura_VirtualAlloc2)(HANDLE, PVOID, SIZE_T, ULONG, ULONG, MEM_EXTENDED_PARAMETER*, ULONG);
+
+static PFN_sakura_VirtualAlloc2 sakura_sysmem_virtual_alloc2(void)
+{
+    static PFN_sakura_VirtualAlloc2 pfn = NULL;
+    static bool loaded = false;
+    if (!loaded)
+    {
+        HMODULE kernelbase = GetModuleHandleW(L"kernelbase.dll");
+        pfn = kernelbase ? (PFN_sakura_VirtualAlloc2)GetProcAddress(kernelbase, "VirtualAlloc2") : NULL;
+        loaded = true;
+    }
+    return pfn;
+}
+
+static bool sakura_sysmem_enable_lock_memory(void)
+{
+    // large pages need SeLockMemoryPrivilege, which is granted to the account but disabled in the token
+    static int enabled = -1;
+    if (enabled < 0)
+    {
+        enabled = 0;
+        HANDLE token = NULL;
+        if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+        {
+            TOKEN_PRIVILEGES tp = { 0 };
+            if (LookupPrivilegeValueW(NULL, L"SeLockMemoryPrivilege", &tp.Privileges[0].Luid))
+            {
+                tp.PrivilegeCount = 1;
+                tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+                AdjustTokenPrivileges(token, FALSE, &tp, 0, NULL, NULL);
+                enabled = (GetLastError() == ERROR_SUCCESS) ? 1 : 0;
+            }
+            CloseHandle(token);
+        }
+    }
+    return enabled == 1;
+}
+
+// maps committed pages of kind, at fixed (a range left by sakura_sysmem_os_unmap) or anywhere arena aligned
+static void* sakura_sysmem_os_map(void* fixed, size_t size, ESysMemoryPageKind kind, int32_t numa_node)
+{
+    const DWORD node = numa_node >= 0 ? (DWORD)numa_node : NUMA_NO_PREFERRED_NODE;
+    if (kind == SKR_SYSMEM_PAGE_DEFAULT && fixed)
+        return VirtualAllocExNuma(GetCurrentProcess(), fixed, size, MEM_COMMIT, PAGE_READWRITE, node);
+
+    PFN_sakura_VirtualAlloc2 virtual_alloc2 = sakura_sysmem_virtual_alloc2();
+    if (kind != SKR_SYSMEM_PAGE_DEFAULT && (!virtual_alloc2 || !sakura_sysmem_enable_lock_memory()))
+        return NULL;
+    if (virtual_alloc2)
+    {
+        MEM_ADDRESS_REQUIREMENTS requirements = { 0 };
+        requirements.Alignment = SKR_SYSMEM_ARENA_ALIGN;
+        MEM_EXTENDED_PARAMETER params[3] = { 0 };
+        ULONG param_count = 0;
+        if (!fixed)
+        {
+            params[param_count].Type = MemExtendedParameterAddressRequirements;
+            params[param_count].Pointer = &requirements;
+            param_count++;
+        }
+        if (numa_node >= 0)
+        {
+            params[param_count].Type = MemExtendedParameterNumaNode;
+            params[param_count].ULong = (DWORD)numa_node;
+            param_count++;
+        }
+        if (kind == SKR_SYSMEM_PAGE_HUGE)
+        {
+            params[param_count].Type = MemExtendedParameterAttributeFlags;
+            params[param_count].ULong64 = MEM_EXTENDED_PARAMETER_NONPAGED_HUGE;
+            param_count++;
+        }
+        const ULONG flags = MEM_RESERVE | MEM_COMMIT | (kind != SKR_SYSMEM_PAGE_DEFAULT ? MEM_LARGE_PAGES : 0);
+        if (fixed)
+        {
+            // large pages can not be committed into a reserved range, swap the placeholder for them
+            VirtualFree(fixed, 0, MEM_RELEASE);
+            void* ptr = virtual_alloc2(GetCurrentProcess(), fixed, size, flags, PAGE_READWRITE, params, param_count);
+            if (!ptr) VirtualAlloc(fixed, size, MEM_RESERVE, PAGE_NOACCESS);
+            return ptr;
+        }
+        return virtual_alloc2(GetCurrentProcess(), NULL, size, flags, PAGE_READWRITE, params, param_count);
+    }
+    // no VirtualAlloc2 (before windows 10 1803): find an aligned hole, then map it, another thread may take it first
+    for (int tries = 0; tries < 8; tries++)
+    {
+        void* hole = VirtualAlloc(NULL, size + SKR_SYSMEM_ARENA_ALIGN, MEM_RESERVE, PAGE_NOACCESS);
+        if (!hole) return NULL;
+        VirtualFree(hole, 0, MEM_RELEASE);
+        void* aligned = (void*)sakura_sysmem_align_up((size_t)hole, SKR_SYSMEM_ARENA_ALIGN);
+        void* ptr = VirtualAllocExNuma(GetCurrentProcess(), aligned, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+        if (ptr) return ptr;
+    }
+    return NULL;
+}
+
+// frees the pages, keep_range leaves the addresses reserved for a later sakura_sysmem_os_map
+static bool sakura_sysmem_os_unmap(void* start, size_t size, ESysMemoryPageKind kind, bool keep_range)
+{
+    if (keep_range && kind == SKR_SYSMEM_PAGE_DEFAULT)
+        return VirtualFree(start, size, MEM_DECOMMIT);
+    VirtualFree(start, 0, MEM_RELEASE);
+    // large pages can not be decommitted, reserve the range again
+    return keep_range && VirtualAlloc(start, size, MEM_RESERVE, PAGE_NOACCESS) == start;
+}
+
+#else
+
+    #if defined(__linux__)
+        #ifndef MAP_HUGE_SHIFT
+            #define MAP_HUGE_SHIFT 26
+        #endif
+        #ifndef MAP_HUGETLB
+            #define MAP_HUGETLB 0x40000
+        #endif
+    #endif
+    #ifndef MAP_NORESERVE
+        #define MAP_NORESERVE 0
+    #endif
+
+static void sakura_sysmem_bind_numa(void* start, size_t size, int32_t numa_node)
+{
+    // pages are placed on first touch, so a preferred policy on the fresh range is enough
+    #if defined(__linux__) && defined(SYS_mbind)
+    const unsigned long kMPolPreferred = 1;
+    const unsigned long kMaskBits = sizeof(unsigned long) * 8;
+    if (numa_node < 0 || (unsigned long)numa_node >= kMaskBits) return;
+    unsigned long mask = 1ul << numa_node;
+    syscall(SYS_mbind, start, size, kMPolPreferred, &mask, kMaskBits + 1, 0);
+    #else
+    (void)start;
+    (void)size;
+    (void)numa_node;
+    #endif
+}
+
+// maps committed pages of kind, at fixed (a range left by sakura_sysmem_os_unmap) or anywhere arena aligned
+static void* sakura_sysmem_os_map(void* fixed, size_t size, ESysMemoryPageKind kind, int32_t numa_node)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    #if defined(__linux__)
+    if (kind == SKR_SYSMEM_PAGE_HUGE)
+    {
+        flags |= MAP_HUGETLB | (30 << MAP_HUGE_SHIFT);
+        page_size = SKR_SYSMEM_HUGE_PAGE_SIZE;
+    }
+    else if (kind == SKR_SYSMEM_PAGE_LARGE)
+    {
+        flags |= MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+        page_size = SKR_SYSMEM_LARGE_PAGE_SIZE;
+    }
+    #else
+    if (kind != SKR_SYSMEM_PAGE_DEFAULT) return NULL;
+    #endif
+    char* aligned = NULL;
+    if (fixed)
+    {
+        // replaces the placeholder atomically, a failed hugetlb mapping leaves it in place
+        aligned = (char*)mmap(fixed, size, PROT_READ | PROT_WRITE, flags | MAP_FIXED, -1, 0);
+        if (aligned == (char*)MAP_FAILED) return NULL;
+    }
+    else
+    {
+        // over-map and trim to get the arena alignment, 1GiB pages are aligned already
+        const size_t slack = page_size >= SKR_SYSMEM_ARENA_ALIGN ? 0 : SKR_SYSMEM_ARENA_ALIGN;
+        char* ptr = (char*)mmap(NULL, size + slack, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (ptr == (char*)MAP_FAILED) return NULL;
+        aligned = (char*)sakura_sysmem_align_up((size_t)ptr, SKR_SYSMEM_ARENA_ALIGN);
+        if (aligned != ptr) munmap(ptr, (size_t)(aligned - ptr));
+        if (aligned + size != ptr + size + slack) munmap(aligned + size, (size_t)(ptr + slack - aligned));
+    }
+    sakura_sysmem_bind_numa(aligned, size, numa_node);
+    return aligned;
+}
+
+// frees the pages, keep_range leaves the addresses reserved for a later sakura_sysmem_os_map
+static bool sakura_sysmem_os_unmap(void* start, size_t size, ESysMemoryPageKind kind, bool keep_range)
+{
+    (void)kind;
+    if (keep_range)
+        return mmap(start, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0) == start;
+    munmap(start, size);
+    return false;
+}
+
+#endif
+
+// ranges of destroyed pools, still registered as mimalloc arenas
+typedef struct SSysMemoryRetiredArena
+{
+    mi_arena_id_t arena;
+    void* start;
+    size_t size;
+    ESysMemoryPageKind page_kind;
+    int32_t numa_node;
+} SSysMemoryRetiredArena;
+
+#define SKR_SYSMEM_MAX_RETIRED_ARENAS 112 // MI_MAX_ARENAS
+
+static SCallOnceGuard sakura_sysmem_retired_guard;
+static SMutex sakura_sysmem_retired_mutex;
+static SSysMemoryRetiredArena sakura_sysmem_retired[SKR_SYSMEM_MAX_RETIRED_ARENAS];
+static uint32_t sakura_sysmem_retired_count = 0;
+
+static void sakura_sysmem_init_retired(void)
+{
+    skr_init_mutex(&sakura_sysmem_retired_mutex);
+}
+
+static bool sakura_sysmem_reuse_arena(size_t size, ESysMemoryPageKind kind, int32_t numa_node, SSysMemoryRetiredArena* out)
+{
+    skr_call_once(&sakura_sysmem_retired_guard, sakura_sysmem_init_retired);
+    skr_mutex_acquire(&sakura_sysmem_retired_mutex);
+    // smallest retired range that fits
+    int32_t best = -1;
+    for (uint32_t i = 0; i < sakura_sysmem_retired_count; i++)
+    {
+        const SSysMemoryRetiredArena* r = &sakura_sysmem_retired[i];
+        if (r->page_kind != kind || r->numa_node != numa_node || r->size < size) continue;
+        if (best < 0 || r->size < sakura_sysmem_retired[best].size) best = (int32_t)i;
+    }
+    bool reused = false;
+    if (best >= 0)
+    {
+        SSysMemoryRetiredArena* r = &sakura_sysmem_retired[best];
+        if (sakura_sysmem_os_map(r->start, r->size, r->page_kind, r->numa_node))
+        {
+            *out = *r;
+            *r = sakura_sysmem_retired[--sakura_sysmem_retired_count];
+            reused = true;
+        }
+    }
+    skr_mutex_release(&sakura_sysmem_retired_mutex);
+    return reused;
+}
+
+static void sakura_sysmem_retire_arena(const SSysMemoryRetiredArena* arena)
 {
+    skr_call_once(&sakura_sysmem_retired_guard, sakura_sysmem_init_retired);
+    skr_mutex_acquire(&sakura_sysmem_retired_mutex);
+    const bool keep = sakura_sysmem_retired_count < SKR_SYSMEM_MAX_RETIRED_ARENAS;
+    if (sakura_sysmem_os_unmap(arena->start, arena->size, arena->page_kind, keep))
+        sakura_sysmem_retired[sakura_sysmem_retired_count++] = *arena;
+    skr_mutex_release(&sakura_sysmem_retired_mutex);
+}
+
+static bool sakura_sysmem_create_arena(size_t size, ESysMemoryPageKind kind, int32_t numa_node, SSysMemoryRetiredArena* out)
+{
+    if (sakura_sysmem_reuse_arena(size, kind, numa_node, out))
+        return true;
+    void* start = sakura_sysmem_os_map(NULL, size, kind, numa_node);
+    if (!start) return false;
+    // handed over committed & pinned, so mimalloc never decommits the range behind our back
     mi_arena_id_t arena_id;
-    // TODO: USE OS LARGE PAGE
-    const bool use_large_page = false;
-    const bool need_commit = pdesc->use_large_page;
+    if (!mi_manage_os_memory_ex(start, size, true /*committed*/, true /*pinned*/, true /*zero*/, numa_node, true /*exclusive*/, &arena_id))
+    {
+        sakura_sysmem_os_unmap(start, size, kind, false);
+        return false;
+    }
+    out->arena = arena_id;
+    out->start = start;
+    out->size = size;
+    out->page_kind = kind;
+    out->numa_node = numa_node;
+    return true;
+}
 
-    int err = mi_reserve_os_memory_ex(pdesc->size, 
-        need_commit /* commit */, 
-        use_large_page /* allow large */,
-        true /*exclusive*/, &arena_id);
-    assert(err == 0 && "mi_reserve_os_memory_ex failed");
+SSysMemoryPoolId sakura_sysmem_pool_create(const SSysMemoryPoolDesc* pdesc)
+{
+    const int32_t numa_node = pdesc->bind_numa_node ? (int32_t)pdesc->numa_node : -1;
+    const size_t size = sakura_sysmem_align_up(pdesc->size, SKR_SYSMEM_ARENA_ALIGN);
+    // page kinds are requested per reservation, the one actually mapped is recorded
+    SSysMemoryRetiredArena arena;
+    bool created = false;
+    if (!created && pdesc->use_huge_page)
+        created = sakura_sysmem_create_arena(sakura_sysmem_align_up(size, SKR_SYSMEM_HUGE_PAGE_SIZE), SKR_SYSMEM_PAGE_HUGE, numa_node, &arena);
+    if (!created && (pdesc->use_large_page || pdesc->use_huge_page))
+        created = sakura_sysmem_create_arena(size, SKR_SYSMEM_PAGE_LARGE, numa_node, &arena);
+    if (!created)
+        created = sakura_sysmem_create_arena(size, SKR_SYSMEM_PAGE_DEFAULT, numa_node, &arena);
+    assert(created && "sakura_sysmem_pool_create failed");
+    if (!created) return NULL;
 
     SSysMemoryPool* pool = mi_calloc(1, sizeof(SSysMemoryPool));
-    pool->arena = arena_id;
-    pool->start = mi_arena_area(pool->arena, &pool->arena_size);
+    pool->arena = arena.arena;
+    pool->start = arena.start;
+    pool->arena_size = arena.size;
     pool->heap = mi_heap_new_in_arena(pool->arena);
     pool->name = mi_strdup(pdesc->pool_name ? pdesc->pool_name : "sysmem_pool");
+    pool->page_kind = arena.page_kind;
+    pool->numa_node = numa_node;
+    pool->thread_safe = pdesc->thread_safe;
+    if (pool->thread_safe)
+        skr_init_mutex(&pool->mutex);
     return (SSysMemoryPoolId)pool;
 }
 
 void sakura_sysmem_pool_destroy(SSysMemoryPoolId pool)
 {
     SSysMemoryPool* p = (SSysMemoryPool*)pool;
-    mi_heap_delete(p->heap);
+    // releases every block still allocated from the pool, then the pages of the arena
+    mi_heap_destroy(p->heap);
+    SSysMemoryRetiredArena arena;
+    arena.arena = p->arena;
+    arena.start = p->start;
+    arena.size = p->arena_size;
+    arena.page_kind = p->page_kind;
+    arena.numa_node = p->numa_node;
+    sakura_sysmem_retire_arena(&arena);
+    if (p->thread_safe)
+        skr_destroy_mutex(&p->mutex);
     mi_free(p->name);
     mi_free(p);
 }
@@ -43,15 +368,153 @@ void sakura_sysmem_pool_destroy(SSysMemoryPoolId pool)
 void* _sakura_sysmem_pool_malloc(SSysMemoryPoolId pool, size_t size)
 {
     SSysMemoryPool* p = (SSysMemoryPool*)pool;
-    void* ptr = mi_heap_malloc(p->heap, size);
+    void* ptr = NULL;
+    if (p->thread_safe)
+    {
+        skr_mutex_acquire(&p->mutex);
+        ptr = mi_heap_malloc(p->heap, size);
+        skr_mutex_release(&p->mutex);
+    }
+    else
+    {
+        ptr = mi_heap_malloc(p->heap, size);
+    }
     SkrCAllocN(ptr, size, p->name);
     return ptr;
 }
 
 void* _sakura_sysmem_pool_free(SSysMemoryPoolId pool, void* ptr)
 {
-    mi_free(ptr);
     SSysMemoryPool* p = (SSysMemoryPool*)pool;
+    if (p->thread_safe)
+    {
+        // owner-thread frees touch the page free lists unsynchronized, so they must not race with malloc
+        skr_mutex_acquire(&p->mutex);
+        mi_free(ptr);
+        skr_mutex_release(&p->mutex);
+    }
+    else
+    {
+        mi_free(ptr);
+    }
     SkrCFreeN(ptr, p->name);
     return NULL;
 }
+
+void sakura_sysmem_pool_get_info(SSysMemoryPoolId pool, SSysMemoryPoolInfo* pinfo)
+{
+    SSysMemoryPool* p = (SSysMemoryPool*)pool;
+    pinfo->start = p->start;
+    pinfo->size = p->arena_size;
+    pinfo->page_kind = p->page_kind;
+    pinfo->numa_node = p->numa_node;
+}
+
+bool sakura_sysmem_pool_contains(SSysMemoryPoolId pool, const void* ptr)
+{
+    SSysMemoryPool* p = (SSysMemoryPool*)pool;
+    const char* start = (const char*)p->start;
+    return ((const char*)ptr >= start) && ((const char*)ptr < start + p->arena_size);
+}
+
+uint32_t sakura_sysmem_numa_node_count(void)
+{
+    static uint32_t count = 0;
+    if (count == 0)
+    {
+        uint32_t nodes = 1;
+#if defined(_WIN32)
+        ULONG highest = 0;
+        if (GetNumaHighestNodeNumber(&highest))
+            nodes = (uint32_t)highest + 1;
+#elif defined(__linux__)
+        // "0-3" or "0,2-3": the highest id bounds the node count, like numa_num_configured_nodes
+        FILE* file = fopen("/sys/devices/system/node/possible", "r");
+        if (file)
+        {
+            unsigned int id = 0;
+            int c = 0;
+            while ((c = fgetc(file)) != EOF)
+            {
+                if (c >= '0' && c <= '9')
+                {
+                    id = id * 10 + (unsigned int)(c - '0');
+                    if (id + 1 > nodes) nodes = id + 1;
+                }
+                else
+                    id = 0;
+            }
+            fclose(file);
+        }
+#endif
+        count = nodes;
+    }
+    return count;
+}
+
+uint32_t sakura_sysmem_current_numa_node(void)
+{
+#if defined(_WIN32)
+    PROCESSOR_NUMBER processor;
+    USHORT node = 0;
+    GetCurrentProcessorNumberEx(&processor);
+    if (!GetNumaProcessorNodeEx(&processor, &node) || node == (USHORT)-1)
+        return 0;
+    return (uint32_t)node;
+#elif defined(__linux__) && defined(SYS_getcpu)
+    unsigned int cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+        return 0;
+    return (uint32_t)node;
+#else
+    return 0;
+#endif
+}
+
+typedef struct SSysMemoryNumaPools
+{
+    uint32_t count;
+    SSysMemoryPoolId* pools;
+} SSysMemoryNumaPools;
+
+SSysMemoryNumaPoolsId sakura_sysmem_numa_pools_create(const SSysMemoryPoolDesc* pdesc)
+{
+    SSysMemoryNumaPools* pools = mi_calloc(1, sizeof(SSysMemoryNumaPools));
+    pools->count = sakura_sysmem_numa_node_count();
+    pools->pools = mi_calloc(pools->count, sizeof(SSysMemoryPoolId));
+    for (uint32_t i = 0; i < pools->count; i++)
+    {
+        SSysMemoryPoolDesc desc = *pdesc;
+        desc.bind_numa_node = true;
+        desc.numa_node = i;
+        pools->pools[i] = sakura_sysmem_pool_create(&desc);
+    }
+    return (SSysMemoryNumaPoolsId)pools;
+}
+
+void sakura_sysmem_numa_pools_destroy(SSysMemoryNumaPoolsId pools)
+{
+    SSysMemoryNumaPools* p = (SSysMemoryNumaPools*)pools;
+    for (uint32_t i = 0; i < p->count; i++)
+    {
+        if (p->pools[i])
+            sakura_sysmem_pool_destroy(p->pools[i]);
+    }
+    mi_free(p->pools);
+    mi_free(p);
+}
+
+uint32_t sakura_sysmem_numa_pools_count(SSysMemoryNumaPoolsId pools)
+{
+    return pools->count;
+}
+
+SSysMemoryPoolId sakura_sysmem_numa_pools_get(SSysMemoryNumaPoolsId pools, uint32_t numa_node)
+{
+    return pools->pools[numa_node % pools->count];
+}
+
+SSysMemoryPoolId sakura_sysmem_numa_pools_local(SSysMemoryNumaPoolsId pools)
+{
+    return sakura_sysmem_numa_pools_get(pools, sakura_sysmem_current_numa_node());
+}
@@ -7,6 +7,8 @@
 #include <sys/ioctl.h>
 #include <sys/file.h>
 #include <signal.h>
+#include <fcntl.h>
+#include <errno.h>
 
 #include "SkrBase/misc/debug.h"
 #include "SkrCore/memory/memory.h"
@@ -18,6 +20,8 @@
 
 typedef struct SProcess {
     pid_t pid;
+    bool  exited;
+    int   exit_code;
 } SProcess;
 
 SProcessHandle skr_run_process(const char8_t* command, const char8_t** arguments, uint32_t arg_count, const char8_t* stdout_file)
@@ -27,11 +31,13 @@ SProcessHandle skr_run_process(const char8_t* command, const char8_t** arguments
     {
         Args.add(arguments[i]);
     }
+    // argv[0] is the program itself, as on windows the arguments follow it
     char*      Argv[256] = { NULL };
-    const auto Argc      = Args.size();
+    const auto Argc      = Args.size() < 254 ? Args.size() : 254;
+    Argv[0]              = (char*)command;
     for (size_t i = 0; i < Argc; ++i)
     {
-        Argv[i] = (char*)Args[i].c_str();
+        Argv[i + 1] = (char*)Args[i].c_str();
     }
 
     // int errcode = system(cmd.c_str()); (void)errcode;
@@ -75,7 +81,18 @@ SProcessHandle skr_run_process(const char8_t* command, const char8_t** arguments
     // Makes spawned processes have its own unique group id so we can kill the entire group with out killing the parent
     SpawnFlags |= POSIX_SPAWN_SETPGROUP;
 
+    posix_spawn_file_actions_t  FileActions;
+    posix_spawn_file_actions_t* pFileActions = nullptr;
+    if (stdout_file)
+    {
+        posix_spawn_file_actions_init(&FileActions);
+        posix_spawn_file_actions_addopen(&FileActions, STDOUT_FILENO, (const char*)stdout_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        posix_spawn_file_actions_adddup2(&FileActions, STDOUT_FILENO, STDERR_FILENO);
+        pFileActions = &FileActions;
+    }
+
     int PosixSpawnErrNo = -1;
+    if (!pFileActions)
     {
 #ifdef POSIX_SPAWN_USEVFORK
         // if we don't have any actions to do, use a faster route that will use vfork() instead.
@@ -87,10 +104,11 @@ SProcessHandle skr_run_process(const char8_t* command, const char8_t** arguments
         //		https://sourceware.org/bugzilla/show_bug.cgi?id=14749
         SpawnFlags |= POSIX_SPAWN_USEVFORK;
 #endif
-
-        posix_spawnattr_setflags(&SpawnAttr, SpawnFlags);
-        PosixSpawnErrNo = posix_spawn(&ChildPid, (const char*)command, nullptr, &SpawnAttr, Argv, environ);
     }
+    posix_spawnattr_setflags(&SpawnAttr, SpawnFlags);
+    PosixSpawnErrNo = posix_spawn(&ChildPid, (const char*)command, pFileActions, &SpawnAttr, Argv, environ);
+    if (pFileActions)
+        posix_spawn_file_actions_destroy(pFileActions);
     posix_spawnattr_destroy(&SpawnAttr);
 
     if (PosixSpawnErrNo != 0)
@@ -101,6 +119,8 @@ SProcessHandle skr_run_process(const char8_t* command, const char8_t** arguments
 
     SProcessHandle result = SkrNew<SProcess>();
     result->pid           = ChildPid;
+    result->exited        = false;
+    result->exit_code     = 0;
     return result;
 }
 
@@ -122,21 +142,48 @@ SProcessId skr_get_current_process_id()
     return getpid();
 }
 
+static int skr_process_exit_code(int status)
+{
+    if (WIFEXITED(status))
+        return WEXITSTATUS(status);
+    return -1;
+}
+
 int skr_wait_process(SProcessHandle process)
 {
-    const auto pid = process->pid;
-    int        status;
-    if (waitpid(pid, &status, WNOHANG) == -1)
+    if (!process->exited)
     {
-        perror("wait() error");
+        int status = 0;
+        while (waitpid(process->pid, &status, 0) == -1)
+        {
+            if (errno != EINTR)
+            {
+                perror("wait() error");
+                status = -1;
+                break;
+            }
+        }
+        process->exit_code = status == -1 ? -1 : skr_process_exit_code(status);
     }
-    else
+    const int exit_code = process->exit_code;
+    SkrDelete(process);
+    return exit_code;
+}
+
+bool skr_try_wait_process(SProcessHandle process, int* exit_code)
+{
+    if (!process->exited)
     {
-        if (WIFEXITED(status))
-            return 0;
-        return -1;
+        int         status = 0;
+        const pid_t pid    = waitpid(process->pid, &status, WNOHANG);
+        if (pid == 0)
+            return false;
+        process->exited    = true;
+        process->exit_code = pid == -1 ? -1 : skr_process_exit_code(status);
     }
-    return -1;
+    if (exit_code)
+        *exit_code = process->exit_code;
+    return true;
 }
 
 SProcessId skr_get_process_id(SProcessHandle process)
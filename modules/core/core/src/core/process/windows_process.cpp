@@ -152,3 +152,14 @@ int skr_wait_process(SProcessHandle process)
     SkrDelete(process);
     return exitCode;
 }
+
+bool skr_try_wait_process(SProcessHandle process, int* exit_code)
+{
+    if (WaitForSingleObject(process->processInfo.hProcess, 0) != WAIT_OBJECT_0)
+        return false;
+    DWORD exitCode;
+    GetExitCodeProcess(process->processInfo.hProcess, &exitCode);
+    if (exit_code)
+        *exit_code = (int)exitCode;
+    return true;
+}
\ No newline at end of file
@@ -1,306 +1,178 @@
 #include "SkrDependencyGraph/dependency_graph.hpp"
-#include "lemon/list_graph.h"
+#include <algorithm>
+#include <functional>
 
 namespace skr
 {
-using namespace lemon;
-class DependencyGraphImpl : public DependencyGraph
+dag_id_t DependencyGraph::insert(Node* node) SKR_NOEXCEPT
 {
-public:
-    using DAGVertex = ListDigraph::Node;
-    using DAGEdge = ListDigraph::Arc;
-    using DAGVertMap = ListDigraph::NodeMap<Node*>;
-    using DAGEdgeMap = ListDigraph::ArcMap<Edge*>;
-    using DAG = ListDigraph;
-    DependencyGraphImpl() SKR_NOEXCEPT
-        : vert_map(graph), edge_map(graph)
-    {
-
-    }
-    DAG graph;
-    DAGVertMap vert_map;
-    DAGEdgeMap edge_map;
-
-    virtual dag_id_t insert(Node* node) SKR_NOEXCEPT final
-    {
-        const auto dag_node = graph.addNode();
-        node->id = graph.id(dag_node);
-        node->graph = this;
-        vert_map.set(dag_node, node);
-        node->on_insert();
-        return node->id;
-    }
-
-    virtual Node* access_node(dag_id_t id) SKR_NOEXCEPT final
-    {
-        const auto dag_node = graph.nodeFromId((int)id);
-        return vert_map[dag_node];
-    }
-
-    virtual bool remove(dag_id_t id) SKR_NOEXCEPT final
-    {
-        auto dag_node = graph.nodeFromId((int)id);
-        vert_map[dag_node]->on_remove();
-        graph.erase(dag_node);
-        return true;
-    }
-
-    virtual bool remove(Node* node) SKR_NOEXCEPT final
-    {
-        return remove(node->id);
-    }
-
-    virtual bool clear() SKR_NOEXCEPT final
-    {
-        graph.clear();
-        return true;
-    }
-
-    virtual bool link(Node* from, Node* to, Edge* edge) SKR_NOEXCEPT final
-    {
-        const auto from_node = graph.nodeFromId((int)from->get_id());
-        const auto to_node = graph.nodeFromId((int)to->get_id());
-        SKR_UNUSED const auto dag_arc = graph.addArc(from_node, to_node);
-        if (edge)
-        {
-            edge->graph = this;
-            edge->from_node = from->get_id();
-            edge->to_node = to->get_id();
-            edge_map.set(dag_arc, edge);
-            edge->on_link();
-            return edge;
-        }
-        return false;
-    }
+    node->id = nodes.size();
+    node->graph = this;
+    nodes.push_back(node);
+    dirty = true;
+    node->on_insert();
+    return node->id;
+}
 
-/*
-    virtual Edge* linkage(Node* from, Node* to) SKR_NOEXCEPT final
-    {
-        return linkage(from->id, to->id);
-    }
+bool DependencyGraph::remove(dag_id_t id) SKR_NOEXCEPT
+{
+    auto node = nodes[id];
+    if (!node) return false;
+    node->on_remove();
+    // links of removed nodes are dropped when adjacency is packed
+    nodes[id] = nullptr;
+    dirty = true;
+    return true;
+}
 
-    virtual Edge* linkage(dag_id_t from, dag_id_t to) SKR_NOEXCEPT final
-    {
-        graph.addArc(Node s, Node t)
-        auto find_edge = boost::edge((vertex_descriptor)from, (vertex_descriptor)to, *this);
-        if (find_edge.second)
-        {
-            return (*this)[find_edge.first];
-        }
-        return nullptr;
-    }
+bool DependencyGraph::clear() SKR_NOEXCEPT
+{
+    nodes.clear();
+    arcs.clear();
+    dirty = true;
+    return true;
+}
 
-    virtual bool unlink(Node* from, Node* to) SKR_NOEXCEPT final
-    {
-        return unlink(from->id, to->id);
-    }
-    
-    virtual bool unlink(dag_id_t from, dag_id_t to) SKR_NOEXCEPT final
-    {
-        auto find_edge = boost::edge((vertex_descriptor)from, (vertex_descriptor)to, *this);
-        if (!find_edge.second) return false;
-        (*this)[find_edge.first]->on_unlink();
-        boost::remove_edge(find_edge.first, *this);
+bool DependencyGraph::link(Node* from, Node* to, Edge* edge) SKR_NOEXCEPT
+{
+    arcs.push_back({ (uint32_t)from->get_id(), (uint32_t)to->get_id(), edge });
+    dirty = true;
+    if (edge)
+    {
+        edge->graph = this;
+        edge->from_node = from->get_id();
+        edge->to_node = to->get_id();
+        edge->on_link();
         return true;
     }
-*/
-    
-    virtual Node* from_node(Edge* edge) SKR_NOEXCEPT final
-    {
-        return access_node(edge->from_node);
-    }
-
-    virtual Node* to_node(Edge* edge) SKR_NOEXCEPT final
-    {
-        return access_node(edge->to_node);
-    }
-
-    virtual uint32_t foreach_neighbors(dag_id_t id, skr::stl_function<void(DependencyGraphNode*)> f) SKR_NOEXCEPT final
-    {
-        const auto node = graph.nodeFromId((int)id);
-        uint32_t count = 0;
-        for (ListDigraph::InArcIt arcIt(graph, node); arcIt != INVALID; ++arcIt) 
-        {
-            auto nid = graph.source(arcIt);
-            auto node = vert_map[nid];
-            f(node);
-            count++;
-        }
-        return count;
-    }
-
-    virtual uint32_t foreach_neighbors(const dag_id_t id, skr::stl_function<void(const DependencyGraphNode*)> f) const SKR_NOEXCEPT final
-    {
-        const auto node = graph.nodeFromId((int)id);
-        uint32_t count = 0;
-        for (ListDigraph::InArcIt arcIt(graph, node); arcIt != INVALID; ++arcIt) 
-        {
-            auto nid = graph.source(arcIt);
-            auto node = vert_map[nid];
-            f(node);
-            count++;
-        }
-        return count;
-    }
-    
-    virtual uint32_t foreach_neighbors(Node* node, skr::stl_function<void(DependencyGraphNode*)> f) SKR_NOEXCEPT final
-    {
-        return foreach_neighbors(node->get_id(), f);
-    }
-
-    virtual uint32_t foreach_neighbors(const Node* node, skr::stl_function<void(const DependencyGraphNode*)> f) const SKR_NOEXCEPT final
-    {
-        return foreach_neighbors(node->get_id(), f);
-    }
-
-    virtual uint32_t foreach_inv_neighbors(dag_id_t id, skr::stl_function<void(DependencyGraphNode*)> f) SKR_NOEXCEPT final
-    {
-        const auto node = graph.nodeFromId((int)id);
-        uint32_t count = 0;
-        for (ListDigraph::OutArcIt arcIt(graph, node); arcIt != INVALID; ++arcIt) 
-        {
-            auto nid = graph.target(arcIt);
-            auto node = vert_map[nid];
-            f(node);
-            count++;
-        }
-        return count;
-    }
-
-    virtual uint32_t foreach_inv_neighbors(const dag_id_t id, skr::stl_function<void(const DependencyGraphNode*)> f) const SKR_NOEXCEPT final
-    {
-        const auto node = graph.nodeFromId((int)id);
-        uint32_t count = 0;
-        for (ListDigraph::OutArcIt arcIt(graph, node); arcIt != INVALID; ++arcIt) 
-        {
-            auto nid = graph.target(arcIt);
-            auto node = vert_map[nid];
-            f(node);
-            count++;
-        }
-        return count;
-    }
-
-    virtual uint32_t foreach_inv_neighbors(Node* node, skr::stl_function<void(DependencyGraphNode*)> f) SKR_NOEXCEPT final
-    {
-        return foreach_inv_neighbors(node->get_id(), f);
-    }
+    return false;
+}
 
-    virtual uint32_t foreach_inv_neighbors(const Node* node, skr::stl_function<void(const DependencyGraphNode*)> f) const SKR_NOEXCEPT final
-    {
-        return foreach_inv_neighbors(node->get_id(), f);
-    }
+void DependencyGraph::build() SKR_NOEXCEPT
+{
+    if (dirty) build_adjacency();
+}
 
-    virtual uint32_t foreach_outgoing_edges(dag_id_t id, skr::stl_function<void(Node* from, Node* to, Edge* edge)> f) SKR_NOEXCEPT final
+void DependencyGraph::build_adjacency() const SKR_NOEXCEPT
+{
+    // counting sort of arc indices by target (in) and source (out), stable so link order is kept
+    const uint32_t node_count = (uint32_t)nodes.size();
+    in_offsets.assign(node_count + 1, 0);
+    out_offsets.assign(node_count + 1, 0);
+    uint32_t live_arcs = 0;
+    for (const auto& arc : arcs)
     {
-        const auto node = graph.nodeFromId((int)id);
-        uint32_t count = 0;
-        for (ListDigraph::InArcIt arcIt(graph, node); arcIt != INVALID; ++arcIt) 
-        {
-            auto edge = edge_map[arcIt];
-            f(edge->from(), edge->to(), edge);
-            count++;
-        }
-        return count;
+        if (!nodes[arc.from] || !nodes[arc.to]) continue;
+        in_offsets[arc.to + 1]++;
+        out_offsets[arc.from + 1]++;
+        live_arcs++;
     }
-
-    virtual uint32_t foreach_outgoing_edges(Node* node, skr::stl_function<void(Node* from, Node* to, Edge* edge)> func) SKR_NOEXCEPT final
+    for (uint32_t i = 0; i < node_count; i++)
     {
-        return foreach_outgoing_edges(node->id, func);
+        in_offsets[i + 1] += in_offsets[i];
+        out_offsets[i + 1] += out_offsets[i];
     }
-
-    virtual uint32_t foreach_incoming_edges(dag_id_t id, skr::stl_function<void(Node* from, Node* to, Edge* edge)> f) SKR_NOEXCEPT final
+    in_arcs.resize(live_arcs);
+    out_arcs.resize(live_arcs);
+    // offsets[i] is the write cursor of node i and ends up at its end, shifted back below
+    for (uint32_t i = 0; i < (uint32_t)arcs.size(); i++)
     {
-        const auto node = graph.nodeFromId((int)id);
-        uint32_t count = 0;
-        for (ListDigraph::OutArcIt arcIt(graph, node); arcIt != INVALID; ++arcIt) 
-        {
-            auto edge = edge_map[arcIt];
-            f(edge->from(), edge->to(), edge);
-            count++;
-        }
-        return count;
+        const auto& arc = arcs[i];
+        if (!nodes[arc.from] || !nodes[arc.to]) continue;
+        in_arcs[in_offsets[arc.to]++] = i;
+        out_arcs[out_offsets[arc.from]++] = i;
     }
-
-    virtual uint32_t foreach_incoming_edges(Node* node,
-        skr::stl_function<void(Node* from, Node* to, Edge* edge)> func) SKR_NOEXCEPT final
+    for (uint32_t i = node_count; i > 0; i--)
     {
-        return foreach_incoming_edges(node->id, func);
+        in_offsets[i] = in_offsets[i - 1];
+        out_offsets[i] = out_offsets[i - 1];
     }
+    in_offsets[0] = 0;
+    out_offsets[0] = 0;
+    dirty = false;
+}
 
-    virtual uint32_t foreach_edges(skr::stl_function<void(Node* from, Node* to, Edge* edge)> f) SKR_NOEXCEPT final
+uint32_t DependencyGraph::begin_visit() SKR_NOEXCEPT
+{
+    if (visit_marks.size() < nodes.size())
+        visit_marks.resize(nodes.size(), 0);
+    if (++visit_epoch == 0)
     {
-        uint32_t count = 0;
-        for (ListDigraph::ArcIt arcIt(graph); arcIt != INVALID; ++arcIt) 
-        {
-            auto edge = edge_map[arcIt];
-            f(edge->from(), edge->to(), edge);
-            count++;
-        }
-        return count;
+        // wrapped around, old marks may collide with new epochs
+        std::fill(visit_marks.begin(), visit_marks.end(), 0);
+        visit_epoch = 1;
     }
+    return visit_epoch;
+}
 
-    virtual uint32_t outgoing_edges(dag_id_t id) SKR_NOEXCEPT final
-    {
-        const auto node = graph.nodeFromId((int)id);
-        uint32_t count = 0;
-        for (ListDigraph::InArcIt arcIt(graph, node); arcIt != INVALID; ++arcIt) 
+bool DependencyGraph::topological_sort(skr::stl_vector<dag_id_t>& order) SKR_NOEXCEPT
+{
+    build();
+    // kahn's algorithm, pending link counts live in the visit marks
+    const uint32_t node_count = (uint32_t)nodes.size();
+    uint32_t live_nodes = 0;
+    begin_visit();
+    visit_stack.clear();
+    for (uint32_t i = 0; i < node_count; i++)
+    {
+        if (!nodes[i]) continue;
+        live_nodes++;
+        visit_marks[i] = in_offsets[i + 1] - in_offsets[i];
+        if (!visit_marks[i])
+            visit_stack.push_back(i);
+    }
+    order.clear();
+    order.reserve(live_nodes);
+    // visit_stack is kept as a min-heap so the ready node with the lowest id always goes first
+    const auto later = std::greater<uint32_t>();
+    while (!visit_stack.empty())
+    {
+        std::pop_heap(visit_stack.begin(), visit_stack.end(), later);
+        const uint32_t current = visit_stack.back();
+        visit_stack.pop_back();
+        order.push_back(current);
+        for (uint32_t i = out_offsets[current]; i < out_offsets[current + 1]; i++)
         {
-            count++;
+            const uint32_t next = arcs[out_arcs[i]].to;
+            if (--visit_marks[next] == 0)
+            {
+                visit_stack.push_back(next);
+                std::push_heap(visit_stack.begin(), visit_stack.end(), later);
+            }
         }
-        return count;
-    }
-
-    virtual uint32_t outgoing_edges(const Node* node) SKR_NOEXCEPT final
-    {
-        return outgoing_edges(node->id);
-    }
-
-    virtual uint32_t incoming_edges(const Node* node) SKR_NOEXCEPT final
-    {
-        return incoming_edges(node->id);
     }
+    // counts are not epochs, force a full reset on the next traversal
+    visit_epoch = UINT32_MAX;
+    return order.size() == live_nodes;
+}
 
-    virtual uint32_t incoming_edges(dag_id_t id) SKR_NOEXCEPT final
-    {
-        const auto node = graph.nodeFromId((int)id);
-        uint32_t count = 0;
-        for (ListDigraph::OutArcIt arcIt(graph, node); arcIt != INVALID; ++arcIt) 
+bool DependencyGraph::reachable(dag_id_t from, dag_id_t to) SKR_NOEXCEPT
+{
+    if (from == to) return true;
+    bool found = false;
+    const uint32_t epoch = begin_visit();
+    visit_stack.clear();
+    visit_stack.push_back((uint32_t)from);
+    visit_marks[from] = epoch;
+    while (!found && !visit_stack.empty())
+    {
+        const uint32_t current = visit_stack.back();
+        visit_stack.pop_back();
+        const auto range = out_range(current);
+        for (auto it = range.begin; it != range.end; ++it)
         {
-            count++;
+            const uint32_t next = arcs[*it].to;
+            if (next == to)
+            {
+                found = true;
+                break;
+            }
+            if (visit_marks[next] == epoch) continue;
+            visit_marks[next] = epoch;
+            visit_stack.push_back(next);
         }
-        return count;
     }
-};
-
-uint32_t DependencyGraphNode::outgoing_edges() SKR_NOEXCEPT
-{
-    return graph->outgoing_edges(this);
-}
-
-uint32_t DependencyGraphNode::incoming_edges() SKR_NOEXCEPT
-{
-    return graph->incoming_edges(this);
-}
-
-uint32_t DependencyGraphNode::foreach_neighbors(skr::stl_function<void(DependencyGraphNode* neig)> f) SKR_NOEXCEPT
-{
-    return graph->foreach_neighbors(this, f);
-}
-
-uint32_t DependencyGraphNode::foreach_neighbors(skr::stl_function<void(const DependencyGraphNode* neig)> f) const SKR_NOEXCEPT
-{
-    return graph->foreach_neighbors(this, f);
-}
-
-uint32_t DependencyGraphNode::foreach_inv_neighbors(skr::stl_function<void(DependencyGraphNode* inv_neig)> f) SKR_NOEXCEPT
-{
-    return graph->foreach_inv_neighbors(this, f);
-}
-
-uint32_t DependencyGraphNode::foreach_inv_neighbors(skr::stl_function<void(const DependencyGraphNode* inv_neig)> f) const SKR_NOEXCEPT
-{
-    return graph->foreach_inv_neighbors(this, f);
+    return found;
 }
 } // namespace skr
 
@@ -313,7 +185,7 @@ void DependencyGraph::Destroy(DependencyGraph* graph) SKR_NOEXCEPT
 
 DependencyGraph* DependencyGraph::Create() SKR_NOEXCEPT
 {
-    return new DependencyGraphImpl();
+    return new DependencyGraph();
 }
 
-} // namespace skr
\ No newline at end of file
+} // namespace skr
@@ -1,11 +1,9 @@
-add_requires("lemon v1.3.1")
 add_requires("parallel-hashmap >=1.3.11-skr")
 add_requires("yyjson v0.9.0")
 
 static_component("SkrDependencyGraph", "SkrCore")
     set_optimize("fastest")
     add_deps("SkrBase")
-    add_packages("lemon", {public = false, inherit = false})
     add_files("src/graph/build.*.cpp")
 
 static_component("SkrString", "SkrCore")
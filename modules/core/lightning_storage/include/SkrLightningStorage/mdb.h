@@ -14,6 +14,7 @@ typedef enum ELightningStorageOpenFlag
     LIGHTNING_STORAGE_OPEN_READ_WRITE = 0x00000000,
     LIGHTNING_STORAGE_OPEN_READ_ONLY = 0x00000001,
     LIGHTNING_STORAGE_OPEN_CREATE = 0x00000002,
+    // drops the existing entries, storages opened without it keep their data
     LIGHTNING_STORAGE_OPEN_TRUNCATE = 0x00000004,
 
     // LIGHTNING_STORAGE_OPEN_TRY_ONCE = 0x00000008,
@@ -38,6 +39,10 @@ SLightningEnvironmentId skr_lightning_environment_create(const char8_t* name);
 SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
 void skr_lightning_environment_free(SLightningEnvironmentId environment);
 
+// grows the memory map (16MB by default), no transaction may be active in this process
+SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
+bool skr_lightning_environment_set_map_size(SLightningEnvironmentId environment, uint64_t size);
+
 SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
 SLightningStorageId skr_lightning_storage_open(SLightningEnvironmentId environment, const struct SLightningStorageOpenDescriptor* desc);
 
@@ -56,6 +61,11 @@ bool skr_lightning_storage_write(SLightningTXNId txn, SLightningStorageId storag
 SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
 bool skr_lightning_storage_del(SLightningTXNId txn, SLightningStorageId storage, const struct SLightningStorageValue* key);
 
+// visits the entries whose key starts with prefix in key order, the callback returns false to stop
+typedef bool (*SLightningStorageScanCallback)(void* userdata, const struct SLightningStorageValue* key, const struct SLightningStorageValue* value);
+SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
+bool skr_lightning_storage_scan(SLightningTXNId txn, SLightningStorageId storage, const struct SLightningStorageValue* prefix, SLightningStorageScanCallback callback, void* userdata);
+
 SKR_LIGHTNING_STORAGE_EXTERN_C SKR_LIGHTNING_STORAGE_API
 void skr_lightning_transaction_abort(SLightningTXNId txn);
 
@@ -92,6 +102,7 @@ typedef struct SLightningStorage
     inline SLightningStorageValue read(SLightningTXNId txn, SLightningStorageValue key) SKR_NOEXCEPT { SLightningStorageValue value; skr_lightning_storage_read(txn, this, &key, &value); return value; }
     inline bool write(SLightningTXNId txn, SLightningStorageValue key, SLightningStorageValue value) SKR_NOEXCEPT { return skr_lightning_storage_write(txn, this, &key, &value); }
     inline bool del(SLightningTXNId txn, SLightningStorageValue key) SKR_NOEXCEPT { return skr_lightning_storage_del(txn, this, &key); }
+    inline bool scan(SLightningTXNId txn, SLightningStorageValue prefix, SLightningStorageScanCallback callback, void* userdata) SKR_NOEXCEPT { return skr_lightning_storage_scan(txn, this, &prefix, callback, userdata); }
 #endif
 } SLightningStorage;
 
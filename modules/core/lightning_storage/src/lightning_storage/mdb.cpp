@@ -4,6 +4,7 @@
 #include "SkrContainers/string.hpp"
 #include "SkrLightningStorage/mdb.h"
 #include "lmdb/lmdb.h"
+#include <string.h>
 
 SLightningEnvironmentId skr_lightning_environment_create(const char8_t* name)
 {
@@ -32,6 +33,17 @@ void skr_lightning_environment_free(SLightningEnvironmentId environment)
     sakura_free(environment);
 }
 
+bool skr_lightning_environment_set_map_size(SLightningEnvironmentId environment, uint64_t size)
+{
+    if (const int rc = mdb_env_set_mapsize(environment->env, (size_t)size))
+    {
+        skr::String err = (const char8_t*)mdb_strerror(rc);
+        SKR_LOG_ERROR(u8"mdb_env_set_mapsize failed: %d, %s", rc, err.c_str());
+        return false;
+    }
+    return true;
+}
+
 SLightningStorageId skr_lightning_storage_open(SLightningEnvironmentId environment, const struct SLightningStorageOpenDescriptor* desc)
 {
     const bool readonly = desc->flags & LIGHTNING_STORAGE_OPEN_READ_ONLY;
@@ -54,7 +66,7 @@ SLightningStorageId skr_lightning_storage_open(SLightningEnvironmentId environme
         skr::String err = (const char8_t*)mdb_strerror(rc);
         SKR_LOG_ERROR(u8"mdb_dbi_open failed: %d, %s", rc, err.c_str());
     }
-    else if (!readonly)
+    else if (!readonly && (desc->flags & LIGHTNING_STORAGE_OPEN_TRUNCATE))
     {
         if (const int rc = mdb_drop(txn, dbi, 0) )
         {
@@ -133,6 +145,40 @@ bool skr_lightning_storage_del(SLightningTXNId txn, SLightningStorageId storage,
     return true;
 }
 
+bool skr_lightning_storage_scan(SLightningTXNId txn, SLightningStorageId storage, const struct SLightningStorageValue* prefix, SLightningStorageScanCallback callback, void* userdata)
+{
+    MDB_cursor* cursor = nullptr;
+    auto dbi = (MDB_dbi)storage->mdbi;
+    if (auto rc = mdb_cursor_open((MDB_txn*)txn, dbi, &cursor))
+    {
+        skr::String err = (const char8_t*)mdb_strerror(rc);
+        SKR_LOG_ERROR(u8"mdb_cursor_open failed: %d, %s", rc, err.c_str());
+        return false;
+    }
+    MDB_val _key = { prefix->size, (void*)prefix->data };
+    MDB_val _value;
+    // lmdb refuses empty keys, an empty prefix starts from the first entry
+    int rc = mdb_cursor_get(cursor, &_key, &_value, prefix->size ? MDB_SET_RANGE : MDB_FIRST);
+    while (rc == 0)
+    {
+        if (_key.mv_size < prefix->size || memcmp(_key.mv_data, prefix->data, prefix->size) != 0)
+            break;
+        const SLightningStorageValue key = { _key.mv_size, _key.mv_data };
+        const SLightningStorageValue value = { _value.mv_size, _value.mv_data };
+        if (!callback(userdata, &key, &value))
+            break;
+        rc = mdb_cursor_get(cursor, &_key, &_value, MDB_NEXT);
+    }
+    mdb_cursor_close(cursor);
+    if (rc != 0 && rc != MDB_NOTFOUND)
+    {
+        skr::String err = (const char8_t*)mdb_strerror(rc);
+        SKR_LOG_ERROR(u8"mdb_cursor_get failed: %d, %s", rc, err.c_str());
+        return false;
+    }
+    return true;
+}
+
 bool skr_lightning_transaction_commit(SLightningTXNId txn)
 {
     if (auto rc = mdb_txn_commit((MDB_txn*)txn))
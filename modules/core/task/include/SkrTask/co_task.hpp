@@ -27,6 +27,10 @@
 
 namespace skr
 {
+namespace task
+{
+    struct scheduler_t;
+}
 namespace task2
 {
     template<class T>
@@ -38,7 +42,11 @@ namespace task2
         scheudler_config_t();
         bool setAffinity = true;
         uint32_t numThreads = 0;
+        // when set, tasks and coroutines run on this skr::task worker pool and no thread is created,
+        // co_wait can not pin a coroutine to a worker there
+        skr::task::scheduler_t* fiberScheduler = nullptr;
     };
+    struct scheduler_t;
 #ifdef SKR_PROFILE_ENABLE
     struct task_name_t
     {
@@ -89,9 +97,16 @@ namespace task2
 
     struct condvar_t
     {
+        struct waiter_t
+        {
+            std::coroutine_handle<skr_task_t::promise_type> coroutine;
+            scheduler_t* scheduler = nullptr;
+            int workerIndex = -1;
+        };
         SConditionVariable cv;
-        skr::Vector<std::coroutine_handle<skr_task_t::promise_type>> waiters;
-        skr::Vector<int> workerIndices;
+        skr::Vector<waiter_t> waiters;
+        // fibers parked on the primitive, woken by calling them
+        skr::Vector<skr::stl_function<void()>> wakers;
         std::atomic<int> numWaiting = {0};
         std::atomic<int> numWaitingOnCondition = {0};
         condvar_t()
@@ -103,24 +118,32 @@ namespace task2
             skr_destroy_condition_var(&cv);
         }
         void notify();
-        void add_waiter(std::coroutine_handle<skr_task_t::promise_type> waiter, int workerIndex);
+        void add_waiter(std::coroutine_handle<skr_task_t::promise_type> waiter, scheduler_t* scheduler, int workerIndex);
+        void add_waker(skr::stl_function<void()>&& waker);
         void wait(SMutex& mutex);
     };
+    // common part of event_t and counter_t states, everything waits on it the same way
+    struct waitable_state_t
+    {
+        SMutex mutex;
+        condvar_t cv;
+        waitable_state_t()
+        {
+            skr_init_mutex(&mutex);
+        }
+        virtual ~waitable_state_t()
+        {
+            skr_destroy_mutex(&mutex);
+        }
+        // called with mutex held
+        virtual bool ready() const = 0;
+    };
     struct event_t
     {
-        struct State
+        struct State : public waitable_state_t
         {
-            condvar_t cv;
-            SMutex mutex;
             bool signalled = false;
-            State()
-            {
-                skr_init_mutex(&mutex);
-            }
-            ~State()
-            {
-                skr_destroy_mutex(&mutex);
-            }
+            bool ready() const override { return signalled; }
         };
 
         event_t()
@@ -167,20 +190,11 @@ namespace task2
     };
     struct counter_t
     {
-        struct State
+        struct State : public waitable_state_t
         {
-            SMutex mutex;
             std::atomic<uint32_t> count = 0;
             bool inverse = false;
-            condvar_t cv;
-            State()
-            {
-                skr_init_mutex(&mutex);
-            }
-            ~State()
-            {
-                skr_destroy_mutex(&mutex);
-            }
+            bool ready() const override { return (count == 0) == (!inverse); }
         };
 
         counter_t()
@@ -240,28 +254,24 @@ namespace task2
         static scheduler_t* instance();
         void schedule(skr_task_t&& task);
         void schedule(skr::stl_function<void()>&& function);
-        struct SKR_TASK_API EventAwaitable
-        {
-            EventAwaitable(scheduler_t& s, event_t event, int workerIdx = -1);
-            bool await_ready() const;
-            bool await_suspend(std::coroutine_handle<skr_task_t::promise_type>);
-            void await_resume() const {}
-            scheduler_t& scheduler;
-            event_t event;
-            int workerIdx = -1;
-        };
-        struct SKR_TASK_API CounterAwaitable
+        struct SKR_TASK_API Awaitable
         {
-            CounterAwaitable(scheduler_t& s, counter_t counter, int workerIdx = -1);
+            Awaitable(scheduler_t& s, state_ptr_t<waitable_state_t> state, int workerIdx = -1);
             bool await_ready() const;
             bool await_suspend(std::coroutine_handle<skr_task_t::promise_type>);
             void await_resume() const {}
             scheduler_t& scheduler;
-            counter_t counter;
+            state_ptr_t<waitable_state_t> state;
             int workerIdx = -1;
         };
+        using EventAwaitable = Awaitable;
+        using CounterAwaitable = Awaitable;
         void sync(event_t event);
         void sync(counter_t counter);
+        // number of times a coroutine was parked on an event or counter
+        std::atomic<uint64_t> suspendCount = {0};
+        // tasks queued on the shared pool and not finished yet
+        std::atomic<uint32_t> sharedTasks = {0};
         skr::Array<std::atomic<int>, 8> spinningWorkers;
         std::atomic<unsigned int> nextSpinningWorkerIdx = {0x8000000};
         std::atomic<unsigned int> nextEnqueueIndex = {0};
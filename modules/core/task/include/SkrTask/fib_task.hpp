@@ -273,6 +273,23 @@ namespace skr::task
         void initialize(const scheudler_config_t&);
         void bind() { internal->bind(); }
         void unbind() { internal->unbind(); }
+        // unlike the free function this is callable from threads not bound to the scheduler
+        template<class F>
+        void schedule(F&& lambda, event_t* event, const char* name = nullptr)
+        {
+            if(event && *event)
+            {
+                internal->enqueue(marl::Task([event = *event, lambda = std::forward<F>(lambda)]() mutable
+                {
+                    SKR_DEFER({ event.signal(); });
+                    lambda();
+                }));
+            }
+            else
+            {
+                internal->enqueue(marl::Task(std::forward<F>(lambda)));
+            }
+        }
         ~scheduler_t();
     private:
         internal_t internal = nullptr;
@@ -8,6 +8,7 @@
 #include "SkrContainersDef/atomic_queue/atomic_queue.h"
 #include "SkrContainers/concurrent_queue.hpp"
 #include "SkrTask/co_task.hpp"
+#include "SkrTask/fib_task.hpp"
 
 #if defined(_WIN32)
 #include <intrin.h>
@@ -153,7 +154,7 @@ namespace task2
 #endif
     };
 
-    void enqueue(Task&& task, int workerIdx);
+    void enqueue(scheduler_t* scheduler, Task&& task, int workerIdx);
     thread_local struct Worker* currentWorker = nullptr;
     struct Worker
     {
@@ -413,11 +414,35 @@ namespace task2
     };
     
 
-    void enqueue(Task&& task, int workerIdx)
+    void enqueueShared(scheduler_t* scheduler, Task&& task)
+    {
+        // marl tasks must be copyable, so the payload is split apart and rebuilt on the worker
+        auto fiberScheduler = scheduler->config.fiberScheduler;
+        scheduler->sharedTasks.fetch_add(1, std::memory_order_relaxed);
+        fiberScheduler->schedule([scheduler, func = std::move(task.func), coro = task.coro]() mutable
+        {
+            // coroutines schedule and co_wait through the thread local instance
+            scheduler_t* previous = scheduler_t::instance();
+            set_instance(scheduler);
+            Task task = func ? Task(std::move(func)) : Task(std::move(coro));
+            task();
+            set_instance(previous);
+            // last touch of the scheduler, shutdown may free it right after
+            scheduler->sharedTasks.fetch_sub(1, std::memory_order_release);
+        }, nullptr);
+        task.coro = nullptr;
+    }
+
+    void enqueue(scheduler_t* scheduler, Task&& task, int workerIdx)
     {
         //SkrZoneScopedN("EnqueueTask");
-        scheduler_t* scheduler = scheduler_t::instance();
         SKR_ASSERT(scheduler != nullptr);
+        if(scheduler->config.fiberScheduler)
+        {
+            // no pinning on the shared pool, workers are not ours
+            enqueueShared(scheduler, std::move(task));
+            return;
+        }
         size_t workerCount = scheduler->config.numThreads;
         while(true)
         {
@@ -450,103 +475,109 @@ namespace task2
 
     void scheduler_t::schedule(skr::stl_function<void ()>&& function)
     {
-        enqueue(Task(std::move(function)), -1);
+        enqueue(this, Task(std::move(function)), -1);
     }
 
     void scheduler_t::schedule(skr_task_t&& task)
     {
         std::coroutine_handle<skr_task_t::promise_type> coroutine = task.coroutine;
         task.coroutine = nullptr;
-        enqueue(Task(std::move(coroutine)), -1);
+        enqueue(this, Task(std::move(coroutine)), -1);
     }
 
-    scheduler_t::EventAwaitable::EventAwaitable(scheduler_t& scheduler, event_t event, int workerIdx)
-        : scheduler(scheduler), event(std::move(event)), workerIdx(workerIdx)
+    scheduler_t::Awaitable::Awaitable(scheduler_t& scheduler, state_ptr_t<waitable_state_t> state, int workerIdx)
+        : scheduler(scheduler), state(std::move(state)), workerIdx(workerIdx)
     {
     }
 
-    bool scheduler_t::EventAwaitable::await_ready() const
+    bool scheduler_t::Awaitable::await_ready() const
     {
-        return event.done();
+        if(!state)
+            return true;
+        SMutexLock guard(state->mutex);
+        return state->ready();
     }
 
-    bool scheduler_t::EventAwaitable::await_suspend(std::coroutine_handle<skr_task_t::promise_type> handle)
+    bool scheduler_t::Awaitable::await_suspend(std::coroutine_handle<skr_task_t::promise_type> handle)
     {   
-        SMutexLock guard(event.state->mutex);
-        if(event.state->signalled)
+        SMutexLock guard(state->mutex);
+        if(state->ready())
             return false;
 #ifdef SKR_PROFILE_ENABLE
         if(handle.promise().name != nullptr)
             SkrFiberLeave;
 #endif
-        event.state->cv.add_waiter(handle, workerIdx);
+        state->cv.add_waiter(handle, &scheduler, workerIdx);
+        scheduler.suspendCount.fetch_add(1, std::memory_order_relaxed);
         return true;
     }
 
-    scheduler_t::EventAwaitable co_wait(event_t event, bool pinned)
+    static scheduler_t::Awaitable make_awaitable(state_ptr_t<waitable_state_t> state, bool pinned)
     {
         auto scheduler = scheduler_t::instance();
         SKR_ASSERT(scheduler != nullptr);
+        SKR_ASSERT(!(pinned && scheduler->config.fiberScheduler) && "pinned waits are not supported on the shared pool");
         auto worker = currentWorker;
         //SKR_ASSERT(worker != nullptr);
-        return {*scheduler, event, pinned && worker ? (int)worker->id : -1};
+        return {*scheduler, std::move(state), pinned && worker ? (int)worker->id : -1};
     }
 
-    void wait(event_t event)
+    scheduler_t::EventAwaitable co_wait(event_t event, bool pinned)
     {
-        auto scheduler = scheduler_t::instance();
-        SKR_ASSERT(scheduler == nullptr); //must use outside of scheduler
-        while(!event.done())
-        {
-            event.state->cv.wait(event.state->mutex);
-        }
+        return make_awaitable(std::move(event.state), pinned);
     }
 
-    scheduler_t::CounterAwaitable::CounterAwaitable(scheduler_t& scheduler, counter_t counter, int workerIdx)
-        : scheduler(scheduler), counter(std::move(counter)), workerIdx(workerIdx)
+    scheduler_t::CounterAwaitable co_wait(counter_t counter, bool pinned)
     {
+        return make_awaitable(std::move(counter.state), pinned);
     }
 
-    bool scheduler_t::CounterAwaitable::await_ready() const
+    static void block_on(waitable_state_t* state)
     {
-        return counter.done();
-    }
-
-    bool scheduler_t::CounterAwaitable::await_suspend(std::coroutine_handle<skr_task_t::promise_type> handle)
-    {   
-        SMutexLock guard(counter.state->mutex);
-        if(counter.state->count == 0)
-            return false;
-#ifdef SKR_PROFILE_ENABLE
-        if(handle.promise().name != nullptr)
-            SkrFiberLeave;
-#endif
-        counter.state->cv.add_waiter(handle, workerIdx);
-        return true;
+        if(!state)
+            return;
+        if(skr::task::current_fiber())
+        {
+            // park the fiber instead of the worker thread so the shared pool keeps running
+            marl::Event parked(marl::Event::Mode::Manual);
+            {
+                SMutexLock guard(state->mutex);
+                if(state->ready())
+                    return;
+                state->cv.add_waker([parked]() mutable { parked.signal(); });
+            }
+            parked.wait();
+            return;
+        }
+        SMutexLock guard(state->mutex);
+        while(!state->ready())
+        {
+            state->cv.wait(state->mutex);
+        }
     }
 
-    scheduler_t::CounterAwaitable co_wait(counter_t counter, bool pinned)
+    void wait(event_t event)
     {
         auto scheduler = scheduler_t::instance();
-        SKR_ASSERT(scheduler != nullptr);
-        auto worker = currentWorker;
-        //SKR_ASSERT(worker != nullptr);
-        return {*scheduler, counter, pinned && worker ? (int)worker->id : -1};
+        SKR_ASSERT(scheduler == nullptr); //must use outside of scheduler
+        block_on(event.state.get());
     }
 
     void wait(counter_t counter)
     {
         auto scheduler = scheduler_t::instance();
         SKR_ASSERT(scheduler == nullptr); //must use outside of scheduler
-        while(!counter.done())
-        {
-            counter.state->cv.wait(counter.state->mutex);
-        }
+        block_on(counter.state.get());
     }
 
     void scheduler_t::sync(event_t event)
     {
         SkrZoneScopedN("SyncEvent");
+        if(config.fiberScheduler)
+        {
+            block_on(event.state.get());
+            return;
+        }
         auto worker = currentWorker;
         SKR_ASSERT(worker == nullptr);
         worker = (Worker*)mainWorker;
@@ -564,6 +595,11 @@ namespace task2
     void scheduler_t::sync(counter_t counter)
     {
         SkrZoneScopedN("SyncEvent");
+        if(config.fiberScheduler)
+        {
+            block_on(counter.state.get());
+            return;
+        }
         auto worker = currentWorker;
         SKR_ASSERT(worker == nullptr);
         worker = (Worker*)mainWorker;
@@ -578,11 +614,16 @@ namespace task2
         }
     }
 
-    void condvar_t::add_waiter(std::coroutine_handle<skr_task_t::promise_type> handle, int workerIdx)
+    void condvar_t::add_waiter(std::coroutine_handle<skr_task_t::promise_type> handle, scheduler_t* scheduler, int workerIdx)
+    {
+        ++numWaiting;
+        waiters.add({ handle, scheduler, workerIdx });
+    }
+
+    void condvar_t::add_waker(skr::stl_function<void()>&& waker)
     {
         ++numWaiting;
-        waiters.add(handle);
-        workerIndices.add(workerIdx);
+        wakers.add(std::move(waker));
     }
 
     void condvar_t::wait(SMutex& mutex)
@@ -595,12 +636,18 @@ namespace task2
     void condvar_t::notify()
     {
         skr_wake_all_condition_vars(&cv);
+        // waiters carry their scheduler, so notifying from a foreign thread (e.g. io) is fine
         for(uint32_t i=0; i<waiters.size(); ++i)
         {
-            enqueue(Task{std::move(waiters[i])}, workerIndices[i]);
+            auto& waiter = waiters[i];
+            enqueue(waiter.scheduler, Task{std::move(waiter.coroutine)}, waiter.workerIndex);
+        }
+        for(uint32_t i=0; i<wakers.size(); ++i)
+        {
+            wakers[i]();
         }
         waiters.clear();
-        workerIndices.clear();
+        wakers.clear();
         numWaiting = 0;
     }
 
@@ -652,6 +699,12 @@ namespace task2
     {
         SkrZoneScopedN("Scheduler::Initialize");
         config = cfg;
+        if(config.fiberScheduler)
+        {
+            config.numThreads = 0;
+            initialized = true;
+            return;
+        }
         for(size_t i = 0; i < spinningWorkers.size(); ++i)
             spinningWorkers[i] = -1;
         for(size_t i = 0; i < cfg.numThreads; ++i)
@@ -673,6 +726,22 @@ namespace task2
     {
         SkrZoneScopedN("Scheduler::Shutdown");
         SKR_ASSERT(initialized);
+        if(config.fiberScheduler)
+        {
+            // queued shared pool tasks hold this scheduler, let them finish before it goes away
+            while(sharedTasks.load(std::memory_order_acquire) != 0)
+            {
+                if(skr::task::current_fiber())
+                {
+                    // park the fiber so the pool can run the rest, even a single threaded one
+                    marl::Event tick(marl::Event::Mode::Manual);
+                    tick.wait_for(std::chrono::milliseconds(1));
+                }
+                else
+                    std::this_thread::yield();
+            }
+            return;
+        }
         for(size_t i = 0; i < config.numThreads; ++i)
             ((Worker*)workers[i])->signalStop();
         for(size_t i = 0; i < config.numThreads; ++i)
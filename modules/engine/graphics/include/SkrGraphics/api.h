@@ -109,6 +109,7 @@ typedef enum ECGPUBackend
     CGPU_BACKEND_XBOX_D3D12 = 2,
     CGPU_BACKEND_AGC = 3,
     CGPU_BACKEND_METAL = 4,
+    CGPU_BACKEND_NULL = 5,
     CGPU_BACKEND_COUNT,
     CGPU_BACKEND_MAX_ENUM_BIT = 0x7FFFFFFF
 } ECGPUBackend;
@@ -118,7 +119,8 @@ static const char8_t* gCGPUBackendNames[CGPU_BACKEND_COUNT] = {
     SKR_UTF8("d3d12"),
     SKR_UTF8("d3d12(xbox)"),
     SKR_UTF8("agc"),
-    SKR_UTF8("metal")
+    SKR_UTF8("metal"),
+    SKR_UTF8("null")
 };
 
 typedef enum ECGPUQueueType
@@ -183,6 +185,9 @@ CGPU_API void cgpu_query_video_memory_info(const CGPUDeviceId device, uint64_t*
 typedef void (*CGPUProcQueryVideoMemoryInfo)(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
 CGPU_API void cgpu_query_shared_memory_info(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
 typedef void (*CGPUProcQuerySharedMemoryInfo)(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
+// Two calls: query the size with data == NULL, then fetch. Writes 0 when the backend keeps no pipeline cache
+CGPU_API void cgpu_query_pipeline_cache_data(const CGPUDeviceId device, uint64_t* size, void* data);
+typedef void (*CGPUProcQueryPipelineCacheData)(const CGPUDeviceId device, uint64_t* size, void* data);
 CGPU_API void cgpu_free_device(CGPUDeviceId device);
 typedef void (*CGPUProcFreeDevice)(CGPUDeviceId device);
 
@@ -546,6 +551,7 @@ typedef struct CGPUProcTable {
     const CGPUProcQueryAdapterDetail query_adapter_detail;
     const CGPUProcQueryVideoMemoryInfo query_video_memory_info;
     const CGPUProcQuerySharedMemoryInfo query_shared_memory_info;
+    const CGPUProcQueryPipelineCacheData query_pipeline_cache_data;
     const CGPUProcQueryQueueCount query_queue_count;
 
     // Device APIs
@@ -1198,6 +1204,10 @@ typedef struct CGPUResourceBarrierDescriptor {
 
 typedef struct CGPUDeviceDescriptor {
     bool disable_pipeline_cache;
+    /// Blob returned by cgpu_query_pipeline_cache_data in a previous run, copied by the device.
+    /// Blobs written by another adapter or driver version are dropped
+    const void* pipeline_cache_data;
+    uint64_t pipeline_cache_size;
     CGPUQueueGroupDescriptor* queue_groups;
     uint32_t queue_group_count;
 } CGPUDeviceDescriptor;
@@ -1613,6 +1623,8 @@ typedef struct CGPUTextureViewDescriptor {
 typedef struct CGPUTextureAliasingBindDescriptor {
     CGPUTextureId aliased;
     CGPUTextureId aliasing;
+    /// Placement offset inside the memory of the aliased texture
+    uint64_t offset;
 } CGPUTextureAliasingBindDescriptor;
 
 typedef struct CGPUTextureInfo {
@@ -39,6 +39,7 @@ CGPU_API uint32_t cgpu_query_queue_count_d3d12(const CGPUAdapterId adapter, cons
 CGPU_API CGPUDeviceId cgpu_create_device_d3d12(CGPUAdapterId adapter, const CGPUDeviceDescriptor* desc);
 CGPU_API void cgpu_query_video_memory_info_d3d12(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
 CGPU_API void cgpu_query_shared_memory_info_d3d12(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
+CGPU_API void cgpu_query_pipeline_cache_data_d3d12(const CGPUDeviceId device, uint64_t* size, void* data);
 CGPU_API void cgpu_free_device_d3d12(CGPUDeviceId device);
 
 // API Object APIs
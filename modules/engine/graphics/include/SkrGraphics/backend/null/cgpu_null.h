@@ -0,0 +1,422 @@
+#pragma once
+#include "SkrGraphics/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+CGPU_API const CGPUProcTable* CGPU_NullProcTable();
+CGPU_API const CGPUSurfacesProcTable* CGPU_NullSurfacesProcTable();
+
+// Instance APIs
+CGPU_API CGPUInstanceId cgpu_create_instance_null(CGPUInstanceDescriptor const* descriptor);
+CGPU_API void cgpu_query_instance_features_null(CGPUInstanceId instance, struct CGPUInstanceFeatures* features);
+CGPU_API void cgpu_free_instance_null(CGPUInstanceId instance);
+
+// Adapter APIs
+CGPU_API void cgpu_enum_adapters_null(CGPUInstanceId instance, CGPUAdapterId* const adapters, uint32_t* adapters_num);
+CGPU_API const struct CGPUAdapterDetail* cgpu_query_adapter_detail_null(const CGPUAdapterId adapter);
+CGPU_API uint32_t cgpu_query_queue_count_null(const CGPUAdapterId adapter, const ECGPUQueueType type);
+
+// Device APIs
+CGPU_API CGPUDeviceId cgpu_create_device_null(CGPUAdapterId adapter, const CGPUDeviceDescriptor* desc);
+CGPU_API void cgpu_query_video_memory_info_null(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
+CGPU_API void cgpu_query_shared_memory_info_null(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes);
+CGPU_API void cgpu_query_pipeline_cache_data_null(const CGPUDeviceId device, uint64_t* size, void* data);
+CGPU_API void cgpu_free_device_null(CGPUDeviceId device);
+
+// API Object APIs
+CGPU_API CGPUFenceId cgpu_create_fence_null(CGPUDeviceId device);
+CGPU_API void cgpu_wait_fences_null(const CGPUFenceId* fences, uint32_t fence_count);
+CGPU_API ECGPUFenceStatus cgpu_query_fence_status_null(CGPUFenceId fence);
+CGPU_API void cgpu_free_fence_null(CGPUFenceId fence);
+CGPU_API CGPUSemaphoreId cgpu_create_semaphore_null(CGPUDeviceId device);
+CGPU_API void cgpu_free_semaphore_null(CGPUSemaphoreId semaphore);
+CGPU_API CGPURootSignaturePoolId cgpu_create_root_signature_pool_null(CGPUDeviceId device, const struct CGPURootSignaturePoolDescriptor* desc);
+CGPU_API void cgpu_free_root_signature_pool_null(CGPURootSignaturePoolId pool);
+CGPU_API CGPURootSignatureId cgpu_create_root_signature_null(CGPUDeviceId device, const struct CGPURootSignatureDescriptor* desc);
+CGPU_API void cgpu_free_root_signature_null(CGPURootSignatureId signature);
+CGPU_API CGPUDescriptorSetId cgpu_create_descriptor_set_null(CGPUDeviceId device, const struct CGPUDescriptorSetDescriptor* desc);
+CGPU_API void cgpu_update_descriptor_set_null(CGPUDescriptorSetId set, const struct CGPUDescriptorData* datas, uint32_t count);
+CGPU_API void cgpu_free_descriptor_set_null(CGPUDescriptorSetId set);
+CGPU_API CGPUComputePipelineId cgpu_create_compute_pipeline_null(CGPUDeviceId device, const struct CGPUComputePipelineDescriptor* desc);
+CGPU_API void cgpu_free_compute_pipeline_null(CGPUComputePipelineId pipeline);
+CGPU_API CGPURenderPipelineId cgpu_create_render_pipeline_null(CGPUDeviceId device, const struct CGPURenderPipelineDescriptor* desc);
+CGPU_API void cgpu_free_render_pipeline_null(CGPURenderPipelineId pipeline);
+CGPU_API CGPUMemoryPoolId cgpu_create_memory_pool_null(CGPUDeviceId device, const struct CGPUMemoryPoolDescriptor* desc);
+CGPU_API void cgpu_free_memory_pool_null(CGPUMemoryPoolId pool);
+CGPU_API CGPUQueryPoolId cgpu_create_query_pool_null(CGPUDeviceId device, const struct CGPUQueryPoolDescriptor* desc);
+CGPU_API void cgpu_free_query_pool_null(CGPUQueryPoolId pool);
+
+// Queue APIs
+CGPU_API CGPUQueueId cgpu_get_queue_null(CGPUDeviceId device, ECGPUQueueType type, uint32_t index);
+CGPU_API void cgpu_submit_queue_null(CGPUQueueId queue, const struct CGPUQueueSubmitDescriptor* desc);
+CGPU_API void cgpu_wait_queue_idle_null(CGPUQueueId queue);
+CGPU_API void cgpu_queue_present_null(CGPUQueueId queue, const struct CGPUQueuePresentDescriptor* desc);
+CGPU_API float cgpu_queue_get_timestamp_period_ns_null(CGPUQueueId queue);
+CGPU_API void cgpu_queue_map_tiled_texture_null(CGPUQueueId queue, const struct CGPUTiledTextureRegions* desc);
+CGPU_API void cgpu_queue_unmap_tiled_texture_null(CGPUQueueId queue, const struct CGPUTiledTextureRegions* desc);
+CGPU_API void cgpu_queue_map_packed_mips_null(CGPUQueueId queue, const struct CGPUTiledTexturePackedMips* regions);
+CGPU_API void cgpu_queue_unmap_packed_mips_null(CGPUQueueId queue, const struct CGPUTiledTexturePackedMips* regions);
+CGPU_API void cgpu_free_queue_null(CGPUQueueId queue);
+
+// Command APIs
+CGPU_API CGPUCommandPoolId cgpu_create_command_pool_null(CGPUQueueId queue, const CGPUCommandPoolDescriptor* desc);
+CGPU_API CGPUCommandBufferId cgpu_create_command_buffer_null(CGPUCommandPoolId pool, const struct CGPUCommandBufferDescriptor* desc);
+CGPU_API void cgpu_reset_command_pool_null(CGPUCommandPoolId pool);
+CGPU_API void cgpu_free_command_buffer_null(CGPUCommandBufferId cmd);
+CGPU_API void cgpu_free_command_pool_null(CGPUCommandPoolId pool);
+
+// Event & Markers
+CGPU_API void cgpu_cmd_begin_event_null(CGPUCommandBufferId cmd, const CGPUEventInfo* event);
+CGPU_API void cgpu_cmd_set_marker_null(CGPUCommandBufferId cmd, const CGPUMarkerInfo* marker);
+CGPU_API void cgpu_cmd_end_event_null(CGPUCommandBufferId cmd);
+
+// Shader APIs
+CGPU_API CGPUShaderLibraryId cgpu_create_shader_library_null(CGPUDeviceId device, const struct CGPUShaderLibraryDescriptor* desc);
+CGPU_API void cgpu_free_shader_library_null(CGPUShaderLibraryId shader_module);
+
+// Buffer APIs
+CGPU_API CGPUBufferId cgpu_create_buffer_null(CGPUDeviceId device, const struct CGPUBufferDescriptor* desc);
+CGPU_API void cgpu_map_buffer_null(CGPUBufferId buffer, const struct CGPUBufferRange* range);
+CGPU_API void cgpu_unmap_buffer_null(CGPUBufferId buffer);
+CGPU_API void cgpu_free_buffer_null(CGPUBufferId buffer);
+
+// Sampler APIs
+CGPU_API CGPUSamplerId cgpu_create_sampler_null(CGPUDeviceId device, const struct CGPUSamplerDescriptor* desc);
+CGPU_API void cgpu_free_sampler_null(CGPUSamplerId sampler);
+
+// Texture/TextureView APIs
+CGPU_API CGPUTextureId cgpu_create_texture_null(CGPUDeviceId device, const struct CGPUTextureDescriptor* desc);
+CGPU_API void cgpu_free_texture_null(CGPUTextureId texture);
+CGPU_API CGPUTextureViewId cgpu_create_texture_view_null(CGPUDeviceId device, const struct CGPUTextureViewDescriptor* desc);
+CGPU_API void cgpu_free_texture_view_null(CGPUTextureViewId render_target);
+CGPU_API bool cgpu_try_bind_aliasing_texture_null(CGPUDeviceId device, const struct CGPUTextureAliasingBindDescriptor* desc);
+
+// Shared Resource APIs
+CGPU_API uint64_t cgpu_export_shared_texture_handle_null(CGPUDeviceId device, const struct CGPUExportTextureDescriptor* desc);
+CGPU_API CGPUTextureId cgpu_import_shared_texture_handle_null(CGPUDeviceId device, const struct CGPUImportTextureDescriptor* desc);
+
+// Swapchain APIs
+CGPU_API CGPUSwapChainId cgpu_create_swapchain_null(CGPUDeviceId device, const CGPUSwapChainDescriptor* desc);
+CGPU_API uint32_t cgpu_acquire_next_image_null(CGPUSwapChainId swapchain, const struct CGPUAcquireNextDescriptor* desc);
+CGPU_API void cgpu_free_swapchain_null(CGPUSwapChainId swapchain);
+
+// Surfaces, the native handle is kept as an opaque id
+CGPU_API void cgpu_free_surface_null(CGPUDeviceId device, CGPUSurfaceId surface);
+#if defined(_WIN32) || defined(_WIN64)
+CGPU_API CGPUSurfaceId cgpu_surface_from_hwnd_null(CGPUDeviceId device, HWND window);
+#endif
+#ifdef __APPLE__
+CGPU_API CGPUSurfaceId cgpu_surface_from_ns_view_null(CGPUDeviceId device, CGPUNSView* window);
+#endif
+
+// CMDs
+CGPU_API void cgpu_cmd_begin_null(CGPUCommandBufferId cmd);
+CGPU_API void cgpu_cmd_transfer_buffer_to_buffer_null(CGPUCommandBufferId cmd, const struct CGPUBufferToBufferTransfer* desc);
+CGPU_API void cgpu_cmd_transfer_texture_to_texture_null(CGPUCommandBufferId cmd, const struct CGPUTextureToTextureTransfer* desc);
+CGPU_API void cgpu_cmd_transfer_buffer_to_texture_null(CGPUCommandBufferId cmd, const struct CGPUBufferToTextureTransfer* desc);
+CGPU_API void cgpu_cmd_transfer_buffer_to_tiles_null(CGPUCommandBufferId cmd, const struct CGPUBufferToTilesTransfer* desc);
+CGPU_API void cgpu_cmd_resource_barrier_null(CGPUCommandBufferId cmd, const struct CGPUResourceBarrierDescriptor* desc);
+CGPU_API void cgpu_cmd_begin_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, const struct CGPUQueryDescriptor* desc);
+CGPU_API void cgpu_cmd_end_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, const struct CGPUQueryDescriptor* desc);
+CGPU_API void cgpu_cmd_reset_query_pool_null(CGPUCommandBufferId cmd, CGPUQueryPoolId, uint32_t start_query, uint32_t query_count);
+CGPU_API void cgpu_cmd_resolve_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, CGPUBufferId readback, uint32_t start_query, uint32_t query_count);
+CGPU_API void cgpu_cmd_end_null(CGPUCommandBufferId cmd);
+
+// Compute CMDs
+CGPU_API CGPUComputePassEncoderId cgpu_cmd_begin_compute_pass_null(CGPUCommandBufferId cmd, const struct CGPUComputePassDescriptor* desc);
+CGPU_API void cgpu_compute_encoder_bind_descriptor_set_null(CGPUComputePassEncoderId encoder, CGPUDescriptorSetId set);
+CGPU_API void cgpu_compute_encoder_push_constants_null(CGPUComputePassEncoderId encoder, CGPURootSignatureId rs, const char8_t* name, const void* data);
+CGPU_API void cgpu_compute_encoder_bind_pipeline_null(CGPUComputePassEncoderId encoder, CGPUComputePipelineId pipeline);
+CGPU_API void cgpu_compute_encoder_dispatch_null(CGPUComputePassEncoderId encoder, uint32_t X, uint32_t Y, uint32_t Z);
+CGPU_API void cgpu_cmd_end_compute_pass_null(CGPUCommandBufferId cmd, CGPUComputePassEncoderId encoder);
+
+// Render CMDs
+CGPU_API CGPURenderPassEncoderId cgpu_cmd_begin_render_pass_null(CGPUCommandBufferId cmd, const struct CGPURenderPassDescriptor* desc);
+CGPU_API void cgpu_render_encoder_set_shading_rate_null(CGPURenderPassEncoderId encoder, ECGPUShadingRate shading_rate, ECGPUShadingRateCombiner post_rasterizer_rate, ECGPUShadingRateCombiner final_rate);
+CGPU_API void cgpu_render_encoder_bind_descriptor_set_null(CGPURenderPassEncoderId encoder, CGPUDescriptorSetId set);
+CGPU_API void cgpu_render_encoder_set_viewport_null(CGPURenderPassEncoderId encoder, float x, float y, float width, float height, float min_depth, float max_depth);
+CGPU_API void cgpu_render_encoder_set_scissor_null(CGPURenderPassEncoderId encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+CGPU_API void cgpu_render_encoder_bind_pipeline_null(CGPURenderPassEncoderId encoder, CGPURenderPipelineId pipeline);
+CGPU_API void cgpu_render_encoder_bind_vertex_buffers_null(CGPURenderPassEncoderId encoder, uint32_t buffer_count,
+    const CGPUBufferId* buffers, const uint32_t* strides, const uint32_t* offsets);
+CGPU_API void cgpu_render_encoder_bind_index_buffer_null(CGPURenderPassEncoderId encoder, CGPUBufferId buffer, uint32_t index_stride, uint64_t offset);
+CGPU_API void cgpu_render_encoder_push_constants_null(CGPURenderPassEncoderId encoder, CGPURootSignatureId rs, const char8_t* name, const void* data);
+CGPU_API void cgpu_render_encoder_draw_null(CGPURenderPassEncoderId encoder, uint32_t vertex_count, uint32_t first_vertex);
+CGPU_API void cgpu_render_encoder_draw_instanced_null(CGPURenderPassEncoderId encoder, uint32_t vertex_count, uint32_t first_vertex, uint32_t instance_count, uint32_t first_instance);
+CGPU_API void cgpu_render_encoder_draw_indexed_null(CGPURenderPassEncoderId encoder, uint32_t index_count, uint32_t first_index, uint32_t first_vertex);
+CGPU_API void cgpu_render_encoder_draw_indexed_instanced_null(CGPURenderPassEncoderId encoder, uint32_t index_count, uint32_t first_index, uint32_t instance_count, uint32_t first_instance, uint32_t first_vertex);
+CGPU_API void cgpu_cmd_end_render_pass_null(CGPUCommandBufferId cmd, CGPURenderPassEncoderId encoder);
+
+// dstorage, never available on the null backend
+CGPU_API ECGPUDStorageAvailability cgpu_query_dstorage_availability_null(CGPUDeviceId device);
+CGPU_API CGPUDStorageQueueId cgpu_create_dstorage_queue_null(CGPUDeviceId device, const CGPUDStorageQueueDescriptor* desc);
+CGPU_API CGPUDStorageFileHandle cgpu_dstorage_open_file_null(CGPUDStorageQueueId queue, const char8_t* abs_path);
+CGPU_API void cgpu_dstorage_query_file_info_null(CGPUDStorageQueueId queue, CGPUDStorageFileHandle file, CGPUDStorageFileInfo* info);
+CGPU_API void cgpu_dstorage_enqueue_buffer_request_null(CGPUDStorageQueueId queue, const CGPUDStorageBufferIODescriptor* desc);
+CGPU_API void cgpu_dstorage_enqueue_texture_request_null(CGPUDStorageQueueId queue, const CGPUDStorageTextureIODescriptor* desc);
+CGPU_API void cgpu_dstorage_queue_submit_null(CGPUDStorageQueueId queue, CGPUFenceId fence);
+CGPU_API void cgpu_dstorage_close_file_null(CGPUDStorageQueueId queue, CGPUDStorageFileHandle file);
+CGPU_API void cgpu_free_dstorage_queue_null(CGPUDStorageQueueId queue);
+
+// EXPERIMENTAL Compiled/Linked ISA APIs
+CGPU_API CGPULinkedShaderId cgpu_compile_and_link_shaders_null(CGPURootSignatureId signature, const struct CGPUCompiledShaderDescriptor* descs, uint32_t count);
+CGPU_API void cgpu_compile_shaders_null(CGPURootSignatureId signature, const struct CGPUCompiledShaderDescriptor* descs, uint32_t count, CGPUCompiledShaderId* out_isas);
+CGPU_API void cgpu_free_compiled_shader_null(CGPUCompiledShaderId shader);
+CGPU_API void cgpu_free_linked_shader_null(CGPULinkedShaderId shader);
+
+// EXPERIMENTAL StateBuffer APIs
+CGPU_API CGPUStateBufferId cgpu_create_state_buffer_null(CGPUCommandBufferId cmd, const struct CGPUStateBufferDescriptor* desc);
+CGPU_API void cgpu_render_encoder_bind_state_buffer_null(CGPURenderPassEncoderId encoder, CGPUStateBufferId stream);
+CGPU_API void cgpu_compute_encoder_bind_state_buffer_null(CGPUComputePassEncoderId encoder, CGPUStateBufferId stream);
+CGPU_API void cgpu_free_state_buffer_null(CGPUStateBufferId stream);
+
+// EXPERIMENTAL raster state encoder APIs
+CGPU_API CGPURasterStateEncoderId cgpu_open_raster_state_encoder_null(CGPUStateBufferId stream, CGPURenderPassEncoderId encoder);
+CGPU_API void cgpu_raster_state_encoder_set_viewport_null(CGPURasterStateEncoderId encoder, float x, float y, float width, float height, float min_depth, float max_depth);
+CGPU_API void cgpu_raster_state_encoder_set_scissor_null(CGPURasterStateEncoderId encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+CGPU_API void cgpu_raster_state_encoder_set_cull_mode_null(CGPURasterStateEncoderId encoder, ECGPUCullMode cull_mode);
+CGPU_API void cgpu_raster_state_encoder_set_front_face_null(CGPURasterStateEncoderId encoder, ECGPUFrontFace front_face);
+CGPU_API void cgpu_raster_state_encoder_set_primitive_topology_null(CGPURasterStateEncoderId encoder, ECGPUPrimitiveTopology topology);
+CGPU_API void cgpu_raster_state_encoder_set_depth_test_enabled_null(CGPURasterStateEncoderId encoder, bool enabled);
+CGPU_API void cgpu_raster_state_encoder_set_depth_write_enabled_null(CGPURasterStateEncoderId encoder, bool enabled);
+CGPU_API void cgpu_raster_state_encoder_set_depth_compare_op_null(CGPURasterStateEncoderId encoder, ECGPUCompareMode compare_op);
+CGPU_API void cgpu_raster_state_encoder_set_stencil_test_enabled_null(CGPURasterStateEncoderId encoder, bool enabled);
+CGPU_API void cgpu_raster_state_encoder_set_stencil_compare_op_null(CGPURasterStateEncoderId encoder, CGPUStencilFaces faces, ECGPUStencilOp failOp, ECGPUStencilOp passOp, ECGPUStencilOp depthFailOp, ECGPUCompareMode compareOp);
+CGPU_API void cgpu_raster_state_encoder_set_fill_mode_null(CGPURasterStateEncoderId encoder, ECGPUFillMode fill_mode);
+CGPU_API void cgpu_raster_state_encoder_set_sample_count_null(CGPURasterStateEncoderId encoder, ECGPUSampleCount sample_count);
+CGPU_API void cgpu_close_raster_state_encoder_null(CGPURasterStateEncoderId encoder);
+
+// EXPERIMENTAL shader state encoder APIs
+CGPU_API CGPUShaderStateEncoderId cgpu_open_shader_state_encoder_r_null(CGPUStateBufferId stream, CGPURenderPassEncoderId encoder);
+CGPU_API CGPUShaderStateEncoderId cgpu_open_shader_state_encoder_c_null(CGPUStateBufferId stream, CGPUComputePassEncoderId encoder);
+CGPU_API void cgpu_shader_state_encoder_bind_shaders_null(CGPUShaderStateEncoderId encoder, uint32_t stage_count, const ECGPUShaderStage* stages, const CGPUCompiledShaderId* shaders);
+CGPU_API void cgpu_shader_state_encoder_bind_linked_shader_null(CGPUShaderStateEncoderId encoder, CGPULinkedShaderId linked);
+CGPU_API void cgpu_close_shader_state_encoder_null(CGPUShaderStateEncoderId encoder);
+
+// EXPERIMENTAL user state encoder APIs
+CGPU_API CGPUUserStateEncoderId cgpu_open_user_state_encoder_null(CGPUStateBufferId stream, CGPURenderPassEncoderId encoder);
+CGPU_API void cgpu_close_user_state_encoder_null(CGPUUserStateEncoderId encoder);
+
+// EXPERIMENTAL binder APIs
+CGPU_API CGPUBinderId cgpu_create_binder_null(CGPUCommandBufferId cmd);
+CGPU_API void cgpu_binder_bind_vertex_layout_null(CGPUBinderId binder, const struct CGPUVertexLayout* layout);
+CGPU_API void cgpu_binder_bind_vertex_buffer_null(CGPUBinderId binder, uint32_t first_binding, uint32_t binding_count, const CGPUBufferId* buffers, const uint64_t* offsets, const uint64_t* sizes, const uint64_t* strides);
+CGPU_API void cgpu_free_binder_null(CGPUBinderId binder);
+
+// Null backend only: statistics & recorded command stream
+typedef struct CGPUNullDeviceStatistics {
+    /// Live resources and their aligned footprint
+    uint32_t buffer_count;
+    uint32_t texture_count;
+    uint64_t buffer_bytes;
+    uint64_t texture_bytes;
+    /// Host memory actually backing buffers (allocated on map or transfer)
+    uint64_t host_backed_bytes;
+    /// Commands recorded into any command buffer of this device
+    uint64_t recorded_commands;
+    uint64_t recorded_bytes;
+    uint64_t submitted_command_buffers;
+    /// Errors found by validation (enable_debug_layer), also reported with cgpu_error
+    uint64_t validation_errors;
+} CGPUNullDeviceStatistics;
+
+CGPU_API void cgpu_null_query_device_statistics(CGPUDeviceId device, CGPUNullDeviceStatistics* stats);
+CGPU_API const uint8_t* cgpu_null_query_command_stream(CGPUCommandBufferId cmd, uint64_t* size);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+typedef enum ECGPUNullCommand
+{
+    CGPU_NULL_CMD_TRANSFER_BUFFER_TO_BUFFER = 0,
+    CGPU_NULL_CMD_TRANSFER_TEXTURE_TO_TEXTURE,
+    CGPU_NULL_CMD_TRANSFER_BUFFER_TO_TEXTURE,
+    CGPU_NULL_CMD_TRANSFER_BUFFER_TO_TILES,
+    CGPU_NULL_CMD_RESOURCE_BARRIER,
+    CGPU_NULL_CMD_BEGIN_QUERY,
+    CGPU_NULL_CMD_END_QUERY,
+    CGPU_NULL_CMD_RESET_QUERY_POOL,
+    CGPU_NULL_CMD_RESOLVE_QUERY,
+    CGPU_NULL_CMD_BEGIN_COMPUTE_PASS,
+    CGPU_NULL_CMD_COMPUTE_BIND_DESCRIPTOR_SET,
+    CGPU_NULL_CMD_COMPUTE_PUSH_CONSTANTS,
+    CGPU_NULL_CMD_COMPUTE_BIND_PIPELINE,
+    CGPU_NULL_CMD_DISPATCH,
+    CGPU_NULL_CMD_END_COMPUTE_PASS,
+    CGPU_NULL_CMD_BEGIN_RENDER_PASS,
+    CGPU_NULL_CMD_SET_SHADING_RATE,
+    CGPU_NULL_CMD_RENDER_BIND_DESCRIPTOR_SET,
+    CGPU_NULL_CMD_SET_VIEWPORT,
+    CGPU_NULL_CMD_SET_SCISSOR,
+    CGPU_NULL_CMD_RENDER_BIND_PIPELINE,
+    CGPU_NULL_CMD_BIND_VERTEX_BUFFERS,
+    CGPU_NULL_CMD_BIND_INDEX_BUFFER,
+    CGPU_NULL_CMD_RENDER_PUSH_CONSTANTS,
+    CGPU_NULL_CMD_DRAW,
+    CGPU_NULL_CMD_DRAW_INSTANCED,
+    CGPU_NULL_CMD_DRAW_INDEXED,
+    CGPU_NULL_CMD_DRAW_INDEXED_INSTANCED,
+    CGPU_NULL_CMD_END_RENDER_PASS,
+    CGPU_NULL_CMD_BEGIN_EVENT,
+    CGPU_NULL_CMD_SET_MARKER,
+    CGPU_NULL_CMD_END_EVENT,
+    CGPU_NULL_CMD_COUNT,
+    CGPU_NULL_CMD_MAX_ENUM_BIT = 0xFFFF
+} ECGPUNullCommand;
+
+// every command in the stream starts with a header, size includes the header and is 8-byte aligned
+typedef struct CGPUNullCommandHeader {
+    uint16_t op;
+    uint16_t count; // barrier/vertex buffer count, payload elements of variable sized commands
+    uint32_t size;
+} CGPUNullCommandHeader;
+
+typedef struct CGPUInstance_Null {
+    CGPUInstance super;
+    struct CGPUAdapter_Null* pAdapter;
+    bool mValidation;
+} CGPUInstance_Null;
+
+typedef struct CGPUAdapter_Null {
+    CGPUAdapter super;
+    CGPUAdapterDetail adapter_detail;
+} CGPUAdapter_Null;
+
+typedef struct CGPUDevice_Null {
+    CGPUDevice super;
+    struct CGPUQueue_Null* pQueues[CGPU_QUEUE_TYPE_COUNT];
+    uint32_t mQueueCounts[CGPU_QUEUE_TYPE_COUNT];
+    bool mValidation;
+    _SAtomic(uint32_t) mBufferCount;
+    _SAtomic(uint32_t) mTextureCount;
+    _SAtomic(uint64_t) mBufferBytes;
+    _SAtomic(uint64_t) mTextureBytes;
+    _SAtomic(uint64_t) mHostBackedBytes;
+    _SAtomic(uint64_t) mRecordedCommands;
+    _SAtomic(uint64_t) mRecordedBytes;
+    _SAtomic(uint64_t) mSubmittedCommandBuffers;
+    _SAtomic(uint64_t) mValidationErrors;
+    uint8_t* pPipelineCacheData;
+    uint64_t mPipelineCacheSize;
+} CGPUDevice_Null;
+
+typedef struct CGPUQueue_Null {
+    CGPUQueue super;
+} CGPUQueue_Null;
+
+typedef struct CGPUFence_Null {
+    CGPUFence super;
+    bool mSubmitted;
+} CGPUFence_Null;
+
+typedef struct CGPUSemaphore_Null {
+    CGPUSemaphore super;
+    bool mSignaled;
+} CGPUSemaphore_Null;
+
+typedef struct CGPUCommandPool_Null {
+    CGPUCommandPool super;
+} CGPUCommandPool_Null;
+
+typedef struct CGPUCommandBuffer_Null {
+    CGPUCommandBuffer super;
+    uint8_t* pStream;
+    uint64_t mStreamSize;
+    uint64_t mStreamCapacity;
+    uint64_t mCommandCount;
+    bool mRecording;
+} CGPUCommandBuffer_Null;
+
+typedef struct CGPUQueryPool_Null {
+    CGPUQueryPool super;
+    ECGPUQueryType mType;
+} CGPUQueryPool_Null;
+
+typedef struct CGPUShaderLibrary_Null {
+    CGPUShaderLibrary super;
+    // spirv reflection module when the code is spirv and the vulkan backend is built
+    struct SpvReflectShaderModule* pReflect;
+} CGPUShaderLibrary_Null;
+
+typedef struct CGPURootSignature_Null {
+    CGPURootSignature super;
+} CGPURootSignature_Null;
+
+typedef struct CGPUDescriptorSet_Null {
+    CGPUDescriptorSet super;
+    uint32_t mUpdateCount;
+} CGPUDescriptorSet_Null;
+
+typedef struct CGPUComputePipeline_Null {
+    CGPUComputePipeline super;
+} CGPUComputePipeline_Null;
+
+typedef struct CGPURenderPipeline_Null {
+    CGPURenderPipeline super;
+    uint32_t mRenderTargetCount;
+    ECGPUFormat mDepthStencilFormat;
+} CGPURenderPipeline_Null;
+
+typedef struct CGPUMemoryPool_Null {
+    CGPUMemoryPool super;
+    CGPUMemoryPoolDescriptor mDesc;
+} CGPUMemoryPool_Null;
+
+typedef struct CGPUBuffer_Null {
+    CGPUBuffer super;
+    CGPUBufferInfo mInfo;
+    uint64_t mAlignedSize;
+    uint64_t mAlignment;
+    /// Host memory of the buffer, allocated on first map or transfer
+    uint8_t* pHostMemory;
+    ECGPUResourceState mState;
+    bool mPersistentMap;
+} CGPUBuffer_Null;
+
+typedef struct CGPUTexture_Null {
+    CGPUTexture super;
+    CGPUTextureInfo mInfo;
+    uint64_t mAlignment;
+    ECGPUResourceState mState;
+    /// set by subresource barriers, whole resource state is unknown until the next full barrier
+    bool mStateDiverged;
+} CGPUTexture_Null;
+
+typedef struct CGPUTextureView_Null {
+    CGPUTextureView super;
+} CGPUTextureView_Null;
+
+typedef struct CGPUSampler_Null {
+    CGPUSampler super;
+    CGPUSamplerDescriptor mDesc;
+} CGPUSampler_Null;
+
+typedef struct CGPUCompiledShader_Null {
+    CGPUCompiledShader super;
+    ECGPUShaderStage mStage;
+} CGPUCompiledShader_Null;
+
+typedef struct CGPULinkedShader_Null {
+    CGPULinkedShader super;
+    uint32_t mStageCount;
+} CGPULinkedShader_Null;
+
+// state encoders are the state buffer itself, like on vulkan
+typedef struct CGPUStateBuffer_Null {
+    CGPUStateBuffer super;
+    CGPURenderPassEncoderId pREncoder;
+    CGPUComputePassEncoderId pCEncoder;
+} CGPUStateBuffer_Null;
+
+typedef struct CGPUBinder_Null {
+    CGPUBinder super;
+    bool mVertexLayoutBound;
+} CGPUBinder_Null;
+
+typedef struct CGPUSwapChain_Null {
+    CGPUSwapChain super;
+    uint32_t mCurrentImage;
+} CGPUSwapChain_Null;
@@ -6,6 +6,8 @@
 #endif
 
 #define CGPU_USE_VULKAN
+// headless backend, available on every platform
+#define CGPU_USE_NULL
 
 #ifdef _WIN32
     #define CGPU_USE_D3D12
@@ -17,4 +17,9 @@
     #include "d3d12/proc_table.c"
 #endif
 
+#ifdef CGPU_USE_NULL
+    #include "null/cgpu_null.c"
+    #include "null/proc_table.c"
+#endif
+
 #include "common/cgpu.c"
\ No newline at end of file
@@ -8,6 +8,9 @@
 #ifdef CGPU_USE_D3D12
     #include "SkrGraphics/backend/d3d12/cgpu_d3d12.h"
 #endif
+#ifdef CGPU_USE_NULL
+    #include "SkrGraphics/backend/null/cgpu_null.h"
+#endif
 #ifdef CGPU_USE_METAL
     #include "SkrGraphics/backend/metal/cgpu_metal.h"
 #endif
@@ -34,7 +37,7 @@ CGPU_API CGPUInstanceId cgpu_create_instance(const CGPUInstanceDescriptor* desc)
 {
     SkrCZoneN(zz, "CGPUCreateInstance", 1);
     
-    cgpu_assert((desc->backend == CGPU_BACKEND_VULKAN || desc->backend == CGPU_BACKEND_D3D12 || desc->backend == CGPU_BACKEND_METAL) && "CGPU support only vulkan & d3d12 & metal currently!");
+    cgpu_assert((desc->backend == CGPU_BACKEND_VULKAN || desc->backend == CGPU_BACKEND_D3D12 || desc->backend == CGPU_BACKEND_METAL || desc->backend == CGPU_BACKEND_NULL) && "CGPU support only vulkan & d3d12 & metal & null currently!");
     const CGPUProcTable* tbl = CGPU_NULLPTR;
     const CGPUSurfacesProcTable* s_tbl = CGPU_NULLPTR;
 
@@ -61,6 +64,13 @@ CGPU_API CGPUInstanceId cgpu_create_instance(const CGPUInstanceDescriptor* desc)
         tbl = CGPU_D3D12ProcTable();
         s_tbl = CGPU_D3D12SurfacesProcTable();
     }
+#endif
+#ifdef CGPU_USE_NULL
+    else if (desc->backend == CGPU_BACKEND_NULL)
+    {
+        tbl = CGPU_NullProcTable();
+        s_tbl = CGPU_NullSurfacesProcTable();
+    }
 #endif
     CGPUInstance* instance = (CGPUInstance*)tbl->create_instance(desc);
     *(bool*)&instance->enable_set_name = desc->enable_set_name;
@@ -180,6 +190,20 @@ void cgpu_query_shared_memory_info(const CGPUDeviceId device, uint64_t* total, u
     device->proc_table_cache->query_shared_memory_info(device, total, used_bytes);
 }
 
+void cgpu_query_pipeline_cache_data(const CGPUDeviceId device, uint64_t* size, void* data)
+{
+    cgpu_assert(device != CGPU_NULLPTR && "fatal: call on NULL device!");
+    cgpu_assert(size != CGPU_NULLPTR && "fatal: query pipeline cache data without size!");
+
+    // optional, backends without a pipeline cache have nothing to persist
+    if (!device->proc_table_cache->query_pipeline_cache_data)
+    {
+        *size = 0;
+        return;
+    }
+    device->proc_table_cache->query_pipeline_cache_data(device, size, data);
+}
+
 CGPUFenceId cgpu_create_fence(CGPUDeviceId device)
 {
     cgpu_assert(device != CGPU_NULLPTR && "fatal: call on NULL device!");
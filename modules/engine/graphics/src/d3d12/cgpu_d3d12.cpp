@@ -312,17 +312,32 @@ CGPUDeviceId cgpu_create_device_d3d12(CGPUAdapterId adapter, const CGPUDeviceDes
     D3D12_FEATURE_DATA_SHADER_CACHE feature = {};
     HRESULT                         result  = D->pDxDevice->CheckFeatureSupport(
     D3D12_FEATURE_SHADER_CACHE, &feature, sizeof(feature));
-    if (SUCCEEDED(result))
+    if (SUCCEEDED(result) && !desc->disable_pipeline_cache)
     {
         result = E_NOTIMPL;
         if (feature.SupportFlags & D3D12_SHADER_CACHE_SUPPORT_LIBRARY)
         {
             ID3D12Device1* device1 = NULL;
             result                 = D->pDxDevice->QueryInterface(IID_ARGS(&device1));
-            if (SUCCEEDED(result))
+            if (SUCCEEDED(result) && desc->pipeline_cache_data && desc->pipeline_cache_size)
             {
+                // the library reads from the blob for its whole lifetime, keep a copy on the device
+                D->pPSOCacheData = cgpu_malloc(desc->pipeline_cache_size);
+                memcpy(D->pPSOCacheData, desc->pipeline_cache_data, desc->pipeline_cache_size);
                 result = device1->CreatePipelineLibrary(
-                D->pPSOCacheData, 0, IID_ARGS(&D->pPipelineLibrary));
+                D->pPSOCacheData, desc->pipeline_cache_size, IID_ARGS(&D->pPipelineLibrary));
+                if (!SUCCEEDED(result))
+                {
+                    // written by another adapter or driver version
+                    cgpu_warn(u8"D3D12: pipeline library blob rejected (0x%08x), starting empty.", result);
+                    cgpu_free(D->pPSOCacheData);
+                    D->pPSOCacheData = CGPU_NULLPTR;
+                }
+            }
+            if (device1 && !D->pPipelineLibrary)
+            {
+                result = device1->CreatePipelineLibrary(
+                CGPU_NULLPTR, 0, IID_ARGS(&D->pPipelineLibrary));
             }
             SAFE_RELEASE(device1);
         }
@@ -330,6 +345,26 @@ CGPUDeviceId cgpu_create_device_d3d12(CGPUAdapterId adapter, const CGPUDeviceDes
     return &D->super;
 }
 
+void cgpu_query_pipeline_cache_data_d3d12(const CGPUDeviceId device, uint64_t* size, void* data)
+{
+    const CGPUDevice_D3D12* D = (CGPUDevice_D3D12*)device;
+    if (!D->pPipelineLibrary)
+    {
+        *size = 0;
+        return;
+    }
+    const uint64_t serialized_size = D->pPipelineLibrary->GetSerializedSize();
+    if (data)
+    {
+        if (*size < serialized_size || !SUCCEEDED(D->pPipelineLibrary->Serialize(data, serialized_size)))
+        {
+            *size = 0;
+            return;
+        }
+    }
+    *size = serialized_size;
+}
+
 void cgpu_query_video_memory_info_d3d12(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes)
 {
     const CGPUAdapter_D3D12*     A    = (CGPUAdapter_D3D12*)device->adapter;
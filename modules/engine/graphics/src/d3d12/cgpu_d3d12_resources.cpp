@@ -1170,19 +1170,22 @@ bool cgpu_try_bind_aliasing_texture_d3d12(CGPUDeviceId device, const struct CGPU
         auto                       AliasingInfo = const_cast<CGPUTextureInfo*>(Aliasing->super.info);
         const auto                 AliasedInfo  = Aliased->super.info;
         cgpu_assert(AliasingInfo->is_aliasing && "aliasing texture need to be created as aliasing!");
+        const auto AllocInfo        = D->pDxDevice->GetResourceAllocationInfo(CGPU_SINGLE_GPU_NODE_MASK, 1, &Aliasing->mDxDesc);
+        AliasingInfo->size_in_bytes = AllocInfo.SizeInBytes;
         if (Aliased->pDxResource != nullptr && Aliased->pDxAllocation != nullptr &&
-            !AliasedInfo->is_restrict_dedicated && AliasingInfo->is_aliasing)
+            !AliasedInfo->is_restrict_dedicated && AliasingInfo->is_aliasing &&
+            desc->offset % AllocInfo.Alignment == 0 &&
+            desc->offset + AllocInfo.SizeInBytes <= AliasedInfo->size_in_bytes)
         {
             result = D->pResourceAllocator->CreateAliasingResource(
             Aliased->pDxAllocation,
-            0, &Aliasing->mDxDesc,
+            desc->offset, &Aliasing->mDxDesc,
             D3D12_RESOURCE_STATE_COMMON,
             nullptr,
             IID_PPV_ARGS(&Aliasing->pDxResource));
             if (result == S_OK)
             {
-                Aliasing->pDxAllocation     = Aliased->pDxAllocation;
-                AliasingInfo->size_in_bytes = AliasedInfo->size_in_bytes;
+                Aliasing->pDxAllocation = Aliased->pDxAllocation;
                 // Set debug name
                 if (device->adapter->instance->enable_set_name)
                 {
@@ -0,0 +1,1760 @@
+#include "SkrGraphics/backend/null/cgpu_null.h"
+#include "SkrGraphics/flags.h"
+#include "../common/common_utils.h"
+#ifdef CGPU_USE_VULKAN
+    #include "../vulkan/vulkan_utils.h"
+#endif
+#include <string.h>
+
+// Headless backend: resources are CPU-side handles with size & alignment bookkeeping,
+// command buffers record into a flat stream which is replayed (and validated) on submit.
+// Buffer transfers are executed on the host so readback paths keep working, everything
+// else only goes through validation. Queues finish their work inside submit.
+
+#define CGPU_NULL_VRAM_BUDGET (8ull * 1024 * 1024 * 1024)
+#define CGPU_NULL_SHARED_MEMORY_BUDGET (16ull * 1024 * 1024 * 1024)
+#define CGPU_NULL_TEXTURE_ALIGNMENT (64ull * 1024)
+#define CGPU_NULL_MSAA_TEXTURE_ALIGNMENT (4ull * 1024 * 1024)
+#define CGPU_NULL_BUFFER_ALIGNMENT 16
+#define CGPU_NULL_STREAM_INITIAL_CAPACITY 4096
+
+#define NULL_VALIDATION_ERROR(D, ...)                                     \
+    do {                                                                  \
+        skr_atomic_fetch_add_relaxed(&(D)->mValidationErrors, 1);        \
+        cgpu_error(__VA_ARGS__);                                          \
+    } while (0)
+
+static void NullUtil_AddStat(_SAtomic(uint64_t)* stat, uint64_t value)
+{
+    skr_atomic_fetch_add_relaxed(stat, value);
+}
+
+static void NullUtil_SubStat(_SAtomic(uint64_t)* stat, uint64_t value)
+{
+    skr_atomic_fetch_sub_explicit(stat, value, skr_memory_order_relaxed);
+}
+
+#pragma region Payloads
+
+typedef struct NullCmd_ResourceBarrier {
+    uint32_t buffer_barriers_count;
+    uint32_t texture_barriers_count;
+    // CGPUBufferBarrier[buffer_barriers_count]
+    // CGPUTextureBarrier[texture_barriers_count]
+} NullCmd_ResourceBarrier;
+
+typedef struct NullCmd_Query {
+    CGPUQueryPoolId pool;
+    uint32_t start_query;
+    uint32_t query_count;
+    CGPUBufferId readback;
+} NullCmd_Query;
+
+typedef struct NullCmd_RenderPass {
+    uint32_t render_target_count;
+    ECGPUSampleCount sample_count;
+    bool has_depth_stencil;
+    // CGPUColorAttachment[render_target_count]
+    // CGPUDepthStencilAttachment if has_depth_stencil
+} NullCmd_RenderPass;
+
+typedef struct NullCmd_PushConstants {
+    CGPURootSignatureId root_signature;
+    uint64_t name_hash;
+    uint32_t size;
+    // data[size]
+} NullCmd_PushConstants;
+
+typedef struct NullCmd_VertexBuffer {
+    CGPUBufferId buffer;
+    uint32_t stride;
+    uint32_t offset;
+} NullCmd_VertexBuffer;
+
+typedef struct NullCmd_IndexBuffer {
+    CGPUBufferId buffer;
+    uint32_t index_stride;
+    uint64_t offset;
+} NullCmd_IndexBuffer;
+
+typedef struct NullCmd_Draw {
+    uint32_t count;
+    uint32_t first;
+    uint32_t instance_count;
+    uint32_t first_instance;
+    uint32_t first_vertex;
+} NullCmd_Draw;
+
+typedef struct NullCmd_Event {
+    float color[4];
+    uint32_t name_length;
+    // name[name_length + 1]
+} NullCmd_Event;
+
+#pragma endregion Payloads
+
+#pragma region Stream
+
+static void* NullUtil_Record(CGPUCommandBuffer_Null* Cmd, ECGPUNullCommand op, uint16_t count, uint64_t payload_size)
+{
+    const uint64_t size = cgpu_round_up(sizeof(CGPUNullCommandHeader) + payload_size, 8);
+    if (!Cmd->mRecording)
+    {
+        CGPUDevice_Null* D = (CGPUDevice_Null*)Cmd->super.device;
+        NULL_VALIDATION_ERROR(D, "cgpu null: command %d recorded outside cmd_begin/cmd_end!", (int)op);
+    }
+    if (Cmd->mStreamSize + size > Cmd->mStreamCapacity)
+    {
+        uint64_t capacity = Cmd->mStreamCapacity ? Cmd->mStreamCapacity * 2 : CGPU_NULL_STREAM_INITIAL_CAPACITY;
+        while (capacity < Cmd->mStreamSize + size) capacity *= 2;
+        uint8_t* stream = (uint8_t*)cgpu_malloc(capacity);
+        if (Cmd->pStream)
+        {
+            memcpy(stream, Cmd->pStream, Cmd->mStreamSize);
+            cgpu_free(Cmd->pStream);
+        }
+        Cmd->pStream = stream;
+        Cmd->mStreamCapacity = capacity;
+    }
+    CGPUNullCommandHeader* header = (CGPUNullCommandHeader*)(Cmd->pStream + Cmd->mStreamSize);
+    header->op = (uint16_t)op;
+    header->count = count;
+    header->size = (uint32_t)size;
+    Cmd->mStreamSize += size;
+    Cmd->mCommandCount++;
+    return header + 1;
+}
+
+static void NullUtil_EnsureHostMemory(CGPUDevice_Null* D, CGPUBuffer_Null* B)
+{
+    if (B->pHostMemory) return;
+    const uint64_t size = B->mInfo.size ? B->mInfo.size : 1;
+    B->pHostMemory = (uint8_t*)cgpu_calloc(1, size);
+    NullUtil_AddStat(&D->mHostBackedBytes, size);
+}
+
+static bool NullUtil_BufferRangeValid(const CGPUBuffer_Null* B, uint64_t offset, uint64_t size)
+{
+    return B && offset <= B->mInfo.size && size <= B->mInfo.size - offset;
+}
+
+#pragma endregion Stream
+
+#pragma region Replay
+
+typedef struct NullUtil_ReplayState {
+    CGPUDevice_Null* D;
+    ECGPUPipelineType pass;
+    uint32_t pass_render_target_count;
+    bool pass_has_depth_stencil;
+    CGPURenderPipelineId render_pipeline;
+    CGPUComputePipelineId compute_pipeline;
+    bool index_buffer_bound;
+    uint32_t event_depth;
+    bool validate;
+} NullUtil_ReplayState;
+
+// COMMON & UNDEFINED match any source state: the first barrier of a resource decides its layout
+static bool NullUtil_StateMatches(ECGPUResourceState tracked, ECGPUResourceState src)
+{
+    if (src == CGPU_RESOURCE_STATE_UNDEFINED) return true;
+    if (tracked == CGPU_RESOURCE_STATE_UNDEFINED || tracked == CGPU_RESOURCE_STATE_COMMON) return true;
+    return tracked == src;
+}
+
+static void NullUtil_ReplayBarriers(NullUtil_ReplayState* S, const NullCmd_ResourceBarrier* cmd)
+{
+    const CGPUBufferBarrier* buffer_barriers = (const CGPUBufferBarrier*)(cmd + 1);
+    const CGPUTextureBarrier* texture_barriers = (const CGPUTextureBarrier*)(buffer_barriers + cmd->buffer_barriers_count);
+    if (S->validate && S->pass != CGPU_PIPELINE_TYPE_NONE)
+        NULL_VALIDATION_ERROR(S->D, "cgpu null: resource barrier issued inside a pass!");
+    for (uint32_t i = 0; i < cmd->buffer_barriers_count; i++)
+    {
+        const CGPUBufferBarrier* barrier = buffer_barriers + i;
+        CGPUBuffer_Null* B = (CGPUBuffer_Null*)barrier->buffer;
+        // the release half of a queue ownership transfer already made the transition
+        if (barrier->queue_acquire) continue;
+        if (S->validate && !NullUtil_StateMatches(B->mState, barrier->src_state))
+        {
+            NULL_VALIDATION_ERROR(S->D, "cgpu null: buffer barrier src state %#x mismatch with tracked state %#x!",
+                (uint32_t)barrier->src_state, (uint32_t)B->mState);
+        }
+        B->mState = barrier->dst_state;
+    }
+    for (uint32_t i = 0; i < cmd->texture_barriers_count; i++)
+    {
+        const CGPUTextureBarrier* barrier = texture_barriers + i;
+        CGPUTexture_Null* T = (CGPUTexture_Null*)barrier->texture;
+        if (barrier->queue_acquire) continue;
+        if (barrier->subresource_barrier)
+        {
+            if (S->validate && (barrier->mip_level >= T->mInfo.mip_levels || barrier->array_layer > T->mInfo.array_size_minus_one))
+                NULL_VALIDATION_ERROR(S->D, "cgpu null: texture barrier subresource (mip %d, layer %d) out of range!",
+                    (int)barrier->mip_level, (int)barrier->array_layer);
+            T->mStateDiverged = true;
+            continue;
+        }
+        if (S->validate && !T->mStateDiverged && !NullUtil_StateMatches(T->mState, barrier->src_state))
+        {
+            NULL_VALIDATION_ERROR(S->D, "cgpu null: texture barrier src state %#x mismatch with tracked state %#x!",
+                (uint32_t)barrier->src_state, (uint32_t)T->mState);
+        }
+        T->mState = barrier->dst_state;
+        T->mStateDiverged = false;
+    }
+}
+
+static void NullUtil_ReplayDraw(NullUtil_ReplayState* S, bool indexed)
+{
+    if (!S->validate) return;
+    if (S->pass != CGPU_PIPELINE_TYPE_GRAPHICS)
+    {
+        NULL_VALIDATION_ERROR(S->D, "cgpu null: draw recorded outside a render pass!");
+        return;
+    }
+    if (!S->render_pipeline)
+    {
+        NULL_VALIDATION_ERROR(S->D, "cgpu null: draw without a bound render pipeline!");
+        return;
+    }
+    const CGPURenderPipeline_Null* PPL = (const CGPURenderPipeline_Null*)S->render_pipeline;
+    if (PPL->mRenderTargetCount != S->pass_render_target_count)
+        NULL_VALIDATION_ERROR(S->D, "cgpu null: pipeline writes %d render targets but the pass has %d!",
+            (int)PPL->mRenderTargetCount, (int)S->pass_render_target_count);
+    if ((PPL->mDepthStencilFormat != CGPU_FORMAT_UNDEFINED) && !S->pass_has_depth_stencil)
+        NULL_VALIDATION_ERROR(S->D, "cgpu null: pipeline uses depth stencil but the pass has no depth stencil attachment!");
+    if (indexed && !S->index_buffer_bound)
+        NULL_VALIDATION_ERROR(S->D, "cgpu null: indexed draw without a bound index buffer!");
+}
+
+static void NullUtil_ReplayCommandBuffer(CGPUDevice_Null* D, const CGPUCommandBuffer_Null* Cmd)
+{
+    NullUtil_ReplayState S = { 0 };
+    S.D = D;
+    S.validate = D->mValidation;
+    const uint8_t* cursor = Cmd->pStream;
+    const uint8_t* end = Cmd->pStream + Cmd->mStreamSize;
+    while (cursor < end)
+    {
+        const CGPUNullCommandHeader* header = (const CGPUNullCommandHeader*)cursor;
+        const void* payload = header + 1;
+        cursor += header->size;
+        switch ((ECGPUNullCommand)header->op)
+        {
+            case CGPU_NULL_CMD_TRANSFER_BUFFER_TO_BUFFER: {
+                const CGPUBufferToBufferTransfer* desc = (const CGPUBufferToBufferTransfer*)payload;
+                CGPUBuffer_Null* Src = (CGPUBuffer_Null*)desc->src;
+                CGPUBuffer_Null* Dst = (CGPUBuffer_Null*)desc->dst;
+                if (!NullUtil_BufferRangeValid(Src, desc->src_offset, desc->size) || !NullUtil_BufferRangeValid(Dst, desc->dst_offset, desc->size))
+                {
+                    NULL_VALIDATION_ERROR(D, "cgpu null: buffer copy of %llu bytes out of range!", (unsigned long long)desc->size);
+                    break;
+                }
+                if (S.validate && S.pass != CGPU_PIPELINE_TYPE_NONE)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: buffer copy recorded inside a pass!");
+                NullUtil_EnsureHostMemory(D, Src);
+                NullUtil_EnsureHostMemory(D, Dst);
+                memmove(Dst->pHostMemory + desc->dst_offset, Src->pHostMemory + desc->src_offset, desc->size);
+            }
+            break;
+            case CGPU_NULL_CMD_TRANSFER_TEXTURE_TO_TEXTURE: {
+                const CGPUTextureToTextureTransfer* desc = (const CGPUTextureToTextureTransfer*)payload;
+                if (S.validate && (desc->src_subresource.mip_level >= desc->src->info->mip_levels || desc->dst_subresource.mip_level >= desc->dst->info->mip_levels))
+                    NULL_VALIDATION_ERROR(D, "cgpu null: texture copy mip level out of range!");
+            }
+            break;
+            case CGPU_NULL_CMD_TRANSFER_BUFFER_TO_TEXTURE: {
+                const CGPUBufferToTextureTransfer* desc = (const CGPUBufferToTextureTransfer*)payload;
+                if (S.validate && desc->src_offset >= desc->src->info->size)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: buffer to texture copy source offset out of range!");
+                if (S.validate && desc->dst_subresource.mip_level >= desc->dst->info->mip_levels)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: buffer to texture copy mip level out of range!");
+            }
+            break;
+            case CGPU_NULL_CMD_TRANSFER_BUFFER_TO_TILES:
+                break;
+            case CGPU_NULL_CMD_RESOURCE_BARRIER:
+                NullUtil_ReplayBarriers(&S, (const NullCmd_ResourceBarrier*)payload);
+                break;
+            case CGPU_NULL_CMD_BEGIN_QUERY:
+            case CGPU_NULL_CMD_END_QUERY:
+            case CGPU_NULL_CMD_RESET_QUERY_POOL: {
+                const NullCmd_Query* query = (const NullCmd_Query*)payload;
+                if (S.validate && query->start_query + query->query_count > query->pool->count)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: query index %d out of range!", (int)(query->start_query + query->query_count - 1));
+            }
+            break;
+            case CGPU_NULL_CMD_RESOLVE_QUERY: {
+                const NullCmd_Query* query = (const NullCmd_Query*)payload;
+                CGPUBuffer_Null* Readback = (CGPUBuffer_Null*)query->readback;
+                const uint64_t size = (uint64_t)query->query_count * sizeof(uint64_t);
+                if (query->start_query + query->query_count > query->pool->count || !NullUtil_BufferRangeValid(Readback, 0, size))
+                {
+                    NULL_VALIDATION_ERROR(D, "cgpu null: query resolve out of range!");
+                    break;
+                }
+                // no gpu timeline, every query resolves to zero
+                NullUtil_EnsureHostMemory(D, Readback);
+                memset(Readback->pHostMemory, 0, size);
+            }
+            break;
+            case CGPU_NULL_CMD_BEGIN_COMPUTE_PASS:
+                if (S.validate && S.pass != CGPU_PIPELINE_TYPE_NONE)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: compute pass begun inside another pass!");
+                S.pass = CGPU_PIPELINE_TYPE_COMPUTE;
+                S.compute_pipeline = CGPU_NULLPTR;
+                break;
+            case CGPU_NULL_CMD_COMPUTE_BIND_DESCRIPTOR_SET:
+            case CGPU_NULL_CMD_COMPUTE_PUSH_CONSTANTS:
+                if (S.validate && S.pass != CGPU_PIPELINE_TYPE_COMPUTE)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: compute binding recorded outside a compute pass!");
+                break;
+            case CGPU_NULL_CMD_COMPUTE_BIND_PIPELINE:
+                S.compute_pipeline = *(const CGPUComputePipelineId*)payload;
+                break;
+            case CGPU_NULL_CMD_DISPATCH:
+                if (S.validate && S.pass != CGPU_PIPELINE_TYPE_COMPUTE)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: dispatch recorded outside a compute pass!");
+                else if (S.validate && !S.compute_pipeline)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: dispatch without a bound compute pipeline!");
+                break;
+            case CGPU_NULL_CMD_END_COMPUTE_PASS:
+                if (S.validate && S.pass != CGPU_PIPELINE_TYPE_COMPUTE)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: end compute pass without a begun compute pass!");
+                S.pass = CGPU_PIPELINE_TYPE_NONE;
+                break;
+            case CGPU_NULL_CMD_BEGIN_RENDER_PASS: {
+                const NullCmd_RenderPass* pass = (const NullCmd_RenderPass*)payload;
+                if (S.validate && S.pass != CGPU_PIPELINE_TYPE_NONE)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: render pass begun inside another pass!");
+                S.pass = CGPU_PIPELINE_TYPE_GRAPHICS;
+                S.pass_render_target_count = pass->render_target_count;
+                S.pass_has_depth_stencil = pass->has_depth_stencil;
+                S.render_pipeline = CGPU_NULLPTR;
+                S.index_buffer_bound = false;
+                if (S.validate)
+                {
+                    const CGPUColorAttachment* colors = (const CGPUColorAttachment*)(pass + 1);
+                    for (uint32_t i = 0; i < pass->render_target_count; i++)
+                    {
+                        const CGPUTexture_Null* T = (const CGPUTexture_Null*)colors[i].view->info.texture;
+                        if (!T->mStateDiverged && T->mState != CGPU_RESOURCE_STATE_RENDER_TARGET && T->mState != CGPU_RESOURCE_STATE_UNDEFINED && T->mState != CGPU_RESOURCE_STATE_COMMON)
+                            NULL_VALIDATION_ERROR(D, "cgpu null: color attachment %d is in state %#x instead of render target!", (int)i, (uint32_t)T->mState);
+                    }
+                }
+            }
+            break;
+            case CGPU_NULL_CMD_SET_SHADING_RATE:
+            case CGPU_NULL_CMD_RENDER_BIND_DESCRIPTOR_SET:
+            case CGPU_NULL_CMD_SET_VIEWPORT:
+            case CGPU_NULL_CMD_SET_SCISSOR:
+            case CGPU_NULL_CMD_RENDER_PUSH_CONSTANTS:
+                if (S.validate && S.pass != CGPU_PIPELINE_TYPE_GRAPHICS)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: render state recorded outside a render pass!");
+                break;
+            case CGPU_NULL_CMD_RENDER_BIND_PIPELINE:
+                S.render_pipeline = *(const CGPURenderPipelineId*)payload;
+                break;
+            case CGPU_NULL_CMD_BIND_VERTEX_BUFFERS: {
+                const CGPUAdapterDetail* detail = cgpu_query_adapter_detail(D->super.adapter);
+                if (S.validate && header->count > detail->max_vertex_input_bindings)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: %d vertex buffers exceed max vertex input bindings %d!",
+                        (int)header->count, (int)detail->max_vertex_input_bindings);
+            }
+            break;
+            case CGPU_NULL_CMD_BIND_INDEX_BUFFER: {
+                const NullCmd_IndexBuffer* index = (const NullCmd_IndexBuffer*)payload;
+                if (S.validate && index->index_stride != sizeof(uint16_t) && index->index_stride != sizeof(uint32_t))
+                    NULL_VALIDATION_ERROR(D, "cgpu null: invalid index stride %d!", (int)index->index_stride);
+                S.index_buffer_bound = true;
+            }
+            break;
+            case CGPU_NULL_CMD_DRAW:
+            case CGPU_NULL_CMD_DRAW_INSTANCED:
+                NullUtil_ReplayDraw(&S, false);
+                break;
+            case CGPU_NULL_CMD_DRAW_INDEXED:
+            case CGPU_NULL_CMD_DRAW_INDEXED_INSTANCED:
+                NullUtil_ReplayDraw(&S, true);
+                break;
+            case CGPU_NULL_CMD_END_RENDER_PASS:
+                if (S.validate && S.pass != CGPU_PIPELINE_TYPE_GRAPHICS)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: end render pass without a begun render pass!");
+                S.pass = CGPU_PIPELINE_TYPE_NONE;
+                break;
+            case CGPU_NULL_CMD_BEGIN_EVENT:
+                S.event_depth++;
+                break;
+            case CGPU_NULL_CMD_SET_MARKER:
+                break;
+            case CGPU_NULL_CMD_END_EVENT:
+                if (S.validate && S.event_depth == 0)
+                    NULL_VALIDATION_ERROR(D, "cgpu null: end event without a begun event!");
+                S.event_depth = S.event_depth ? S.event_depth - 1 : 0;
+                break;
+            default:
+                cgpu_assert(0 && "cgpu null: corrupted command stream!");
+                return;
+        }
+    }
+    if (S.validate && S.pass != CGPU_PIPELINE_TYPE_NONE)
+        NULL_VALIDATION_ERROR(D, "cgpu null: command buffer submitted with an unfinished pass!");
+}
+
+#pragma endregion Replay
+
+#pragma region Instance & Device
+
+CGPUInstanceId cgpu_create_instance_null(CGPUInstanceDescriptor const* descriptor)
+{
+    CGPUInstance_Null* I = (CGPUInstance_Null*)cgpu_calloc(1, sizeof(CGPUInstance_Null));
+    I->mValidation = descriptor->enable_debug_layer || descriptor->enable_gpu_based_validation;
+    I->pAdapter = (CGPUAdapter_Null*)cgpu_calloc(1, sizeof(CGPUAdapter_Null));
+    CGPUAdapterDetail* detail = &I->pAdapter->adapter_detail;
+    detail->uniform_buffer_alignment = 256;
+    detail->upload_buffer_texture_alignment = 512;
+    detail->upload_buffer_texture_row_alignment = 256;
+    detail->max_vertex_input_bindings = 32;
+    detail->wave_lane_count = 32;
+    detail->host_visible_vram_budget = 0;
+    detail->dynamic_state_features = 0;
+    detail->multidraw_indirect = true;
+    detail->support_geom_shader = true;
+    detail->support_tessellation = true;
+    detail->is_uma = true;
+    detail->is_virtual = true;
+    detail->is_cpu = true;
+    for (uint32_t i = 0; i < CGPU_FORMAT_COUNT; i++)
+    {
+        const ECGPUFormat format = (ECGPUFormat)i;
+        const bool compressed = FormatUtil_WidthOfBlock(format) > 1 || FormatUtil_HeightOfBlock(format) > 1;
+        detail->format_supports[i].shader_read = 1;
+        detail->format_supports[i].shader_write = !compressed && !FormatUtil_IsDepthStencilFormat(format);
+        detail->format_supports[i].render_target_write = !compressed;
+    }
+    strcpy(detail->vendor_preset.gpu_name, "CGPU Null Device");
+    return &I->super;
+}
+
+void cgpu_query_instance_features_null(CGPUInstanceId instance, struct CGPUInstanceFeatures* features)
+{
+    features->specialization_constant = true;
+}
+
+void cgpu_free_instance_null(CGPUInstanceId instance)
+{
+    CGPUInstance_Null* I = (CGPUInstance_Null*)instance;
+    cgpu_free(I->pAdapter);
+    cgpu_free(I);
+}
+
+void cgpu_enum_adapters_null(CGPUInstanceId instance, CGPUAdapterId* const adapters, uint32_t* adapters_num)
+{
+    CGPUInstance_Null* I = (CGPUInstance_Null*)instance;
+    *adapters_num = 1;
+    if (adapters != CGPU_NULLPTR)
+    {
+        adapters[0] = &I->pAdapter->super;
+    }
+}
+
+const CGPUAdapterDetail* cgpu_query_adapter_detail_null(const CGPUAdapterId adapter)
+{
+    const CGPUAdapter_Null* A = (const CGPUAdapter_Null*)adapter;
+    return &A->adapter_detail;
+}
+
+uint32_t cgpu_query_queue_count_null(const CGPUAdapterId adapter, const ECGPUQueueType type)
+{
+    switch (type)
+    {
+        case CGPU_QUEUE_TYPE_GRAPHICS:
+            return 1;
+        case CGPU_QUEUE_TYPE_COMPUTE:
+        case CGPU_QUEUE_TYPE_TRANSFER:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+CGPUDeviceId cgpu_create_device_null(CGPUAdapterId adapter, const CGPUDeviceDescriptor* desc)
+{
+    const CGPUInstance_Null* I = (const CGPUInstance_Null*)adapter->instance;
+    CGPUDevice_Null* D = (CGPUDevice_Null*)cgpu_calloc(1, sizeof(CGPUDevice_Null));
+    *(CGPUAdapterId*)&D->super.adapter = adapter;
+    D->mValidation = I->mValidation;
+    for (uint32_t i = 0; i < desc->queue_group_count; i++)
+    {
+        const CGPUQueueGroupDescriptor* group = desc->queue_groups + i;
+        const uint32_t available = cgpu_query_queue_count_null(adapter, group->queue_type);
+        D->mQueueCounts[group->queue_type] = cgpu_min(group->queue_count, available);
+    }
+    // nothing is compiled here, the blob is handed back as is so persistence round trips can be tested
+    if (!desc->disable_pipeline_cache && desc->pipeline_cache_data && desc->pipeline_cache_size)
+    {
+        D->pPipelineCacheData = (uint8_t*)cgpu_malloc(desc->pipeline_cache_size);
+        memcpy(D->pPipelineCacheData, desc->pipeline_cache_data, desc->pipeline_cache_size);
+        D->mPipelineCacheSize = desc->pipeline_cache_size;
+    }
+    return &D->super;
+}
+
+void cgpu_query_video_memory_info_null(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    *total = CGPU_NULL_VRAM_BUDGET;
+    *used_bytes = skr_atomic_load_relaxed(&D->mBufferBytes) + skr_atomic_load_relaxed(&D->mTextureBytes);
+}
+
+void cgpu_query_shared_memory_info_null(const CGPUDeviceId device, uint64_t* total, uint64_t* used_bytes)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    *total = CGPU_NULL_SHARED_MEMORY_BUDGET;
+    *used_bytes = skr_atomic_load_relaxed(&D->mHostBackedBytes);
+}
+
+void cgpu_query_pipeline_cache_data_null(const CGPUDeviceId device, uint64_t* size, void* data)
+{
+    const CGPUDevice_Null* D = (const CGPUDevice_Null*)device;
+    if (data)
+    {
+        if (*size < D->mPipelineCacheSize)
+        {
+            *size = 0;
+            return;
+        }
+        memcpy(data, D->pPipelineCacheData, D->mPipelineCacheSize);
+    }
+    *size = D->mPipelineCacheSize;
+}
+
+void cgpu_free_device_null(CGPUDeviceId device)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    if (skr_atomic_load_relaxed(&D->mBufferCount) || skr_atomic_load_relaxed(&D->mTextureCount))
+    {
+        cgpu_warn("cgpu null: device freed with %d buffers & %d textures alive!",
+            (int)skr_atomic_load_relaxed(&D->mBufferCount), (int)skr_atomic_load_relaxed(&D->mTextureCount));
+    }
+    if (D->pPipelineCacheData) cgpu_free(D->pPipelineCacheData);
+    cgpu_free(D);
+}
+
+void cgpu_null_query_device_statistics(CGPUDeviceId device, CGPUNullDeviceStatistics* stats)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    stats->buffer_count = skr_atomic_load_relaxed(&D->mBufferCount);
+    stats->texture_count = skr_atomic_load_relaxed(&D->mTextureCount);
+    stats->buffer_bytes = skr_atomic_load_relaxed(&D->mBufferBytes);
+    stats->texture_bytes = skr_atomic_load_relaxed(&D->mTextureBytes);
+    stats->host_backed_bytes = skr_atomic_load_relaxed(&D->mHostBackedBytes);
+    stats->recorded_commands = skr_atomic_load_relaxed(&D->mRecordedCommands);
+    stats->recorded_bytes = skr_atomic_load_relaxed(&D->mRecordedBytes);
+    stats->submitted_command_buffers = skr_atomic_load_relaxed(&D->mSubmittedCommandBuffers);
+    stats->validation_errors = skr_atomic_load_relaxed(&D->mValidationErrors);
+}
+
+const uint8_t* cgpu_null_query_command_stream(CGPUCommandBufferId cmd, uint64_t* size)
+{
+    const CGPUCommandBuffer_Null* Cmd = (const CGPUCommandBuffer_Null*)cmd;
+    *size = Cmd->mStreamSize;
+    return Cmd->pStream;
+}
+
+#pragma endregion Instance & Device
+
+#pragma region API Objects
+
+CGPUFenceId cgpu_create_fence_null(CGPUDeviceId device)
+{
+    CGPUFence_Null* F = (CGPUFence_Null*)cgpu_calloc(1, sizeof(CGPUFence_Null));
+    return &F->super;
+}
+
+void cgpu_wait_fences_null(const CGPUFenceId* fences, uint32_t fence_count)
+{
+    // work is done inside submit, nothing to wait for but the fences are reset like on the other backends
+    for (uint32_t i = 0; i < fence_count; ++i)
+    {
+        CGPUFence_Null* F = (CGPUFence_Null*)fences[i];
+        F->mSubmitted = false;
+    }
+}
+
+ECGPUFenceStatus cgpu_query_fence_status_null(CGPUFenceId fence)
+{
+    const CGPUFence_Null* F = (const CGPUFence_Null*)fence;
+    return F->mSubmitted ? CGPU_FENCE_STATUS_COMPLETE : CGPU_FENCE_STATUS_NOTSUBMITTED;
+}
+
+void cgpu_free_fence_null(CGPUFenceId fence)
+{
+    cgpu_free((CGPUFence_Null*)fence);
+}
+
+CGPUSemaphoreId cgpu_create_semaphore_null(CGPUDeviceId device)
+{
+    CGPUSemaphore_Null* S = (CGPUSemaphore_Null*)cgpu_calloc(1, sizeof(CGPUSemaphore_Null));
+    return &S->super;
+}
+
+void cgpu_free_semaphore_null(CGPUSemaphoreId semaphore)
+{
+    cgpu_free((CGPUSemaphore_Null*)semaphore);
+}
+
+CGPURootSignaturePoolId cgpu_create_root_signature_pool_null(CGPUDeviceId device, const struct CGPURootSignaturePoolDescriptor* desc)
+{
+    return CGPUUtil_CreateRootSignaturePool(desc);
+}
+
+void cgpu_free_root_signature_pool_null(CGPURootSignaturePoolId pool)
+{
+    CGPUUtil_FreeRootSignaturePool(pool);
+}
+
+CGPURootSignatureId cgpu_create_root_signature_null(CGPUDeviceId device, const struct CGPURootSignatureDescriptor* desc)
+{
+    CGPURootSignature_Null* RS = (CGPURootSignature_Null*)cgpu_calloc(1, sizeof(CGPURootSignature_Null));
+    CGPUUtil_InitRSParamTables((CGPURootSignature*)RS, desc);
+    // [RS POOL] ALLOCATION
+    if (desc->pool)
+    {
+        CGPURootSignatureId poolSig = CGPUUtil_TryAllocateSignature(desc->pool, &RS->super, desc);
+        if (poolSig != CGPU_NULLPTR)
+        {
+            RS->super.pool = desc->pool;
+            RS->super.pool_sig = poolSig;
+            return &RS->super;
+        }
+        CGPURootSignatureId result = CGPUUtil_AddSignature(desc->pool, &RS->super, desc);
+        cgpu_assert(result && "Root signature pool insertion failed!");
+        return result;
+    }
+    // [RS POOL] END ALLOCATION
+    return &RS->super;
+}
+
+void cgpu_free_root_signature_null(CGPURootSignatureId signature)
+{
+    // [RS POOL] FREE
+    if (signature->pool)
+    {
+        // aliases returned by the pool own their tables, the pooled signature is freed by the pool
+        const bool is_alias = signature->pool_sig != CGPU_NULLPTR;
+        CGPUUtil_PoolFreeSignature(signature->pool, signature);
+        if (!is_alias) return;
+    }
+    // [RS POOL] END FREE
+    CGPUUtil_FreeRSParamTables((CGPURootSignature*)signature);
+    cgpu_free((CGPURootSignature_Null*)signature);
+}
+
+CGPUDescriptorSetId cgpu_create_descriptor_set_null(CGPUDeviceId device, const struct CGPUDescriptorSetDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    const CGPURootSignature* RS = desc->root_signature->pool_sig ? desc->root_signature->pool_sig : desc->root_signature;
+    bool found = false;
+    for (uint32_t i = 0; i < RS->table_count; i++)
+    {
+        found |= (RS->tables[i].set_index == desc->set_index);
+    }
+    if (D->mValidation && !found)
+        NULL_VALIDATION_ERROR(D, "cgpu null: descriptor set %d does not exist in the root signature!", (int)desc->set_index);
+    CGPUDescriptorSet_Null* Set = (CGPUDescriptorSet_Null*)cgpu_calloc(1, sizeof(CGPUDescriptorSet_Null));
+    return &Set->super;
+}
+
+void cgpu_update_descriptor_set_null(CGPUDescriptorSetId set, const struct CGPUDescriptorData* datas, uint32_t count)
+{
+    CGPUDescriptorSet_Null* Set = (CGPUDescriptorSet_Null*)set;
+    CGPUDevice_Null* D = (CGPUDevice_Null*)set->root_signature->device;
+    Set->mUpdateCount++;
+    if (!D->mValidation) return;
+    const CGPURootSignature* RS = set->root_signature->pool_sig ? set->root_signature->pool_sig : set->root_signature;
+    const CGPUParameterTable* table = CGPU_NULLPTR;
+    for (uint32_t i = 0; i < RS->table_count; i++)
+    {
+        if (RS->tables[i].set_index == set->index) table = RS->tables + i;
+    }
+    if (!table) return;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const CGPUDescriptorData* data = datas + i;
+        const uint64_t name_hash = data->name ? cgpu_name_hash(data->name, strlen((const char*)data->name)) : 0;
+        bool found = false;
+        for (uint32_t j = 0; j < table->resources_count && !found; j++)
+        {
+            const CGPUShaderResource* res = table->resources + j;
+            found = data->name ? (res->name_hash == name_hash) : (res->binding == data->binding);
+        }
+        if (!found)
+            NULL_VALIDATION_ERROR(D, "cgpu null: descriptor %s (binding %d) not found in set %d!",
+                data->name ? (const char*)data->name : "", (int)data->binding, (int)set->index);
+        if (data->count && !data->ptrs)
+            NULL_VALIDATION_ERROR(D, "cgpu null: descriptor %s (binding %d) updated with null resources!",
+                data->name ? (const char*)data->name : "", (int)data->binding);
+    }
+}
+
+void cgpu_free_descriptor_set_null(CGPUDescriptorSetId set)
+{
+    cgpu_free((CGPUDescriptorSet_Null*)set);
+}
+
+CGPUComputePipelineId cgpu_create_compute_pipeline_null(CGPUDeviceId device, const struct CGPUComputePipelineDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    if (D->mValidation && (!desc->root_signature || !desc->compute_shader || !desc->compute_shader->library))
+        NULL_VALIDATION_ERROR(D, "cgpu null: compute pipeline created without root signature or shader!");
+    CGPUComputePipeline_Null* PPL = (CGPUComputePipeline_Null*)cgpu_calloc(1, sizeof(CGPUComputePipeline_Null));
+    return &PPL->super;
+}
+
+void cgpu_free_compute_pipeline_null(CGPUComputePipelineId pipeline)
+{
+    cgpu_free((CGPUComputePipeline_Null*)pipeline);
+}
+
+CGPURenderPipelineId cgpu_create_render_pipeline_null(CGPUDeviceId device, const struct CGPURenderPipelineDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    if (D->mValidation && (!desc->root_signature || !desc->vertex_shader || !desc->vertex_shader->library))
+        NULL_VALIDATION_ERROR(D, "cgpu null: render pipeline created without root signature or vertex shader!");
+    if (D->mValidation && desc->render_target_count > CGPU_MAX_MRT_COUNT)
+        NULL_VALIDATION_ERROR(D, "cgpu null: render pipeline with %d render targets!", (int)desc->render_target_count);
+    CGPURenderPipeline_Null* PPL = (CGPURenderPipeline_Null*)cgpu_calloc(1, sizeof(CGPURenderPipeline_Null));
+    PPL->mRenderTargetCount = desc->render_target_count;
+    PPL->mDepthStencilFormat = desc->depth_stencil_format;
+    return &PPL->super;
+}
+
+void cgpu_free_render_pipeline_null(CGPURenderPipelineId pipeline)
+{
+    cgpu_free((CGPURenderPipeline_Null*)pipeline);
+}
+
+CGPUMemoryPoolId cgpu_create_memory_pool_null(CGPUDeviceId device, const struct CGPUMemoryPoolDescriptor* desc)
+{
+    CGPUMemoryPool_Null* P = (CGPUMemoryPool_Null*)cgpu_calloc(1, sizeof(CGPUMemoryPool_Null));
+    P->super.device = device;
+    P->super.type = desc->type;
+    P->mDesc = *desc;
+    return &P->super;
+}
+
+void cgpu_free_memory_pool_null(CGPUMemoryPoolId pool)
+{
+    cgpu_free((CGPUMemoryPool_Null*)pool);
+}
+
+CGPUQueryPoolId cgpu_create_query_pool_null(CGPUDeviceId device, const struct CGPUQueryPoolDescriptor* desc)
+{
+    CGPUQueryPool_Null* P = (CGPUQueryPool_Null*)cgpu_calloc(1, sizeof(CGPUQueryPool_Null));
+    P->super.count = desc->query_count;
+    P->mType = desc->type;
+    return &P->super;
+}
+
+void cgpu_free_query_pool_null(CGPUQueryPoolId pool)
+{
+    cgpu_free((CGPUQueryPool_Null*)pool);
+}
+
+#pragma endregion API Objects
+
+#pragma region Queue
+
+CGPUQueueId cgpu_get_queue_null(CGPUDeviceId device, ECGPUQueueType type, uint32_t index)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    if (D->mValidation && index >= D->mQueueCounts[type])
+        NULL_VALIDATION_ERROR(D, "cgpu null: queue (type %d, index %d) was not requested at device creation!", (int)type, (int)index);
+    CGPUQueue_Null* Q = (CGPUQueue_Null*)cgpu_calloc(1, sizeof(CGPUQueue_Null));
+    return &Q->super;
+}
+
+void cgpu_submit_queue_null(CGPUQueueId queue, const struct CGPUQueueSubmitDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)queue->device;
+    for (uint32_t i = 0; i < desc->wait_semaphore_count; i++)
+    {
+        CGPUSemaphore_Null* S = (CGPUSemaphore_Null*)desc->wait_semaphores[i];
+        if (D->mValidation && !S->mSignaled)
+            NULL_VALIDATION_ERROR(D, "cgpu null: submit waits on a semaphore that is never signaled!");
+        S->mSignaled = false;
+    }
+    for (uint32_t i = 0; i < desc->cmds_count; i++)
+    {
+        const CGPUCommandBuffer_Null* Cmd = (const CGPUCommandBuffer_Null*)desc->cmds[i];
+        if (D->mValidation && Cmd->mRecording)
+            NULL_VALIDATION_ERROR(D, "cgpu null: command buffer submitted before cmd_end!");
+        NullUtil_ReplayCommandBuffer(D, Cmd);
+    }
+    NullUtil_AddStat(&D->mSubmittedCommandBuffers, desc->cmds_count);
+    for (uint32_t i = 0; i < desc->signal_semaphore_count; i++)
+    {
+        ((CGPUSemaphore_Null*)desc->signal_semaphores[i])->mSignaled = true;
+    }
+    if (desc->signal_fence)
+    {
+        ((CGPUFence_Null*)desc->signal_fence)->mSubmitted = true;
+    }
+}
+
+void cgpu_wait_queue_idle_null(CGPUQueueId queue)
+{
+}
+
+void cgpu_queue_present_null(CGPUQueueId queue, const struct CGPUQueuePresentDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)queue->device;
+    for (uint32_t i = 0; i < desc->wait_semaphore_count; i++)
+    {
+        CGPUSemaphore_Null* S = (CGPUSemaphore_Null*)desc->wait_semaphores[i];
+        if (D->mValidation && !S->mSignaled)
+            NULL_VALIDATION_ERROR(D, "cgpu null: present waits on a semaphore that is never signaled!");
+        S->mSignaled = false;
+    }
+    if (D->mValidation && desc->swapchain && desc->index < desc->swapchain->buffer_count)
+    {
+        const CGPUTexture_Null* T = (const CGPUTexture_Null*)desc->swapchain->back_buffers[desc->index];
+        if (!T->mStateDiverged && T->mState != CGPU_RESOURCE_STATE_PRESENT)
+            NULL_VALIDATION_ERROR(D, "cgpu null: back buffer %d presented in state %#x!", (int)desc->index, (uint32_t)T->mState);
+    }
+}
+
+float cgpu_queue_get_timestamp_period_ns_null(CGPUQueueId queue)
+{
+    return 1.f;
+}
+
+void cgpu_queue_map_tiled_texture_null(CGPUQueueId queue, const struct CGPUTiledTextureRegions* desc)
+{
+}
+
+void cgpu_queue_unmap_tiled_texture_null(CGPUQueueId queue, const struct CGPUTiledTextureRegions* desc)
+{
+}
+
+void cgpu_queue_map_packed_mips_null(CGPUQueueId queue, const struct CGPUTiledTexturePackedMips* regions)
+{
+}
+
+void cgpu_queue_unmap_packed_mips_null(CGPUQueueId queue, const struct CGPUTiledTexturePackedMips* regions)
+{
+}
+
+void cgpu_free_queue_null(CGPUQueueId queue)
+{
+    cgpu_free((CGPUQueue_Null*)queue);
+}
+
+#pragma endregion Queue
+
+#pragma region Command Objects
+
+CGPUCommandPoolId cgpu_create_command_pool_null(CGPUQueueId queue, const CGPUCommandPoolDescriptor* desc)
+{
+    CGPUCommandPool_Null* P = (CGPUCommandPool_Null*)cgpu_calloc(1, sizeof(CGPUCommandPool_Null));
+    return &P->super;
+}
+
+CGPUCommandBufferId cgpu_create_command_buffer_null(CGPUCommandPoolId pool, const struct CGPUCommandBufferDescriptor* desc)
+{
+    CGPUCommandBuffer_Null* Cmd = (CGPUCommandBuffer_Null*)cgpu_calloc(1, sizeof(CGPUCommandBuffer_Null));
+    return &Cmd->super;
+}
+
+void cgpu_reset_command_pool_null(CGPUCommandPoolId pool)
+{
+    // streams are rewound on cmd_begin
+}
+
+void cgpu_free_command_buffer_null(CGPUCommandBufferId cmd)
+{
+    CGPUCommandBuffer_Null* Cmd = (CGPUCommandBuffer_Null*)cmd;
+    if (Cmd->pStream) cgpu_free(Cmd->pStream);
+    cgpu_free(Cmd);
+}
+
+void cgpu_free_command_pool_null(CGPUCommandPoolId pool)
+{
+    cgpu_free((CGPUCommandPool_Null*)pool);
+}
+
+#pragma endregion Command Objects
+
+#pragma region Shader
+
+CGPUShaderLibraryId cgpu_create_shader_library_null(CGPUDeviceId device, const struct CGPUShaderLibraryDescriptor* desc)
+{
+    CGPUShaderLibrary_Null* S = (CGPUShaderLibrary_Null*)cgpu_calloc(1, sizeof(CGPUShaderLibrary_Null));
+#ifdef CGPU_USE_VULKAN
+    // spirv gets the real reflection so root signatures & bind tables match the other backends
+    if (desc->code && desc->code_size >= sizeof(uint32_t) && desc->code[0] == 0x07230203)
+    {
+        CGPUShaderLibrary_Vulkan reflected = { 0 };
+        VkUtil_InitializeShaderReflection(device, &reflected, desc);
+        S->super.entry_reflections = reflected.super.entry_reflections;
+        S->super.entrys_count = reflected.super.entrys_count;
+        S->pReflect = reflected.pReflect;
+        return &S->super;
+    }
+#endif
+    S->super.entrys_count = 1;
+    S->super.entry_reflections = (CGPUShaderReflection*)cgpu_calloc(1, sizeof(CGPUShaderReflection));
+    S->super.entry_reflections[0].entry_name = u8"main";
+    S->super.entry_reflections[0].stage = desc->stage;
+    return &S->super;
+}
+
+void cgpu_free_shader_library_null(CGPUShaderLibraryId shader_module)
+{
+    CGPUShaderLibrary_Null* S = (CGPUShaderLibrary_Null*)shader_module;
+#ifdef CGPU_USE_VULKAN
+    if (S->pReflect)
+    {
+        CGPUShaderLibrary_Vulkan reflected = { 0 };
+        reflected.super = S->super;
+        reflected.pReflect = S->pReflect;
+        VkUtil_FreeShaderReflection(&reflected);
+        cgpu_free(S);
+        return;
+    }
+#endif
+    cgpu_free(S->super.entry_reflections);
+    cgpu_free(S);
+}
+
+// compiled shaders only keep their stage, validation happens when they are bound
+CGPULinkedShaderId cgpu_compile_and_link_shaders_null(CGPURootSignatureId signature, const struct CGPUCompiledShaderDescriptor* descs, uint32_t count)
+{
+    CGPULinkedShader_Null* linked = (CGPULinkedShader_Null*)cgpu_calloc(1, sizeof(CGPULinkedShader_Null));
+    linked->super.device = signature->device;
+    linked->super.root_signature = signature;
+    linked->mStageCount = count;
+    return &linked->super;
+}
+
+void cgpu_compile_shaders_null(CGPURootSignatureId signature, const struct CGPUCompiledShaderDescriptor* descs, uint32_t count, CGPUCompiledShaderId* out_isas)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        CGPUCompiledShader_Null* shader = (CGPUCompiledShader_Null*)cgpu_calloc(1, sizeof(CGPUCompiledShader_Null));
+        shader->super.device = signature->device;
+        shader->super.root_signature = signature;
+        shader->mStage = descs[i].entry.stage;
+        out_isas[i] = &shader->super;
+    }
+}
+
+void cgpu_free_compiled_shader_null(CGPUCompiledShaderId shader)
+{
+    cgpu_free((CGPUCompiledShader_Null*)shader);
+}
+
+void cgpu_free_linked_shader_null(CGPULinkedShaderId shader)
+{
+    cgpu_free((CGPULinkedShader_Null*)shader);
+}
+
+#pragma endregion Shader
+
+#pragma region Resources
+
+CGPUBufferId cgpu_create_buffer_null(CGPUDeviceId device, const struct CGPUBufferDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    const CGPUAdapterDetail* detail = cgpu_query_adapter_detail(device->adapter);
+    CGPUBuffer_Null* B = (CGPUBuffer_Null*)cgpu_calloc(1, sizeof(CGPUBuffer_Null));
+    B->mAlignment = (desc->descriptors & CGPU_RESOURCE_TYPE_UNIFORM_BUFFER) ? detail->uniform_buffer_alignment : CGPU_NULL_BUFFER_ALIGNMENT;
+    B->mAlignedSize = cgpu_round_up(desc->size ? desc->size : 1, B->mAlignment);
+    B->mInfo.size = desc->size;
+    B->mInfo.descriptors = desc->descriptors;
+    B->mInfo.memory_usage = desc->memory_usage;
+    B->mState = desc->start_state;
+    const bool host_visible = (desc->memory_usage != CGPU_MEM_USAGE_GPU_ONLY) || (desc->flags & CGPU_BCF_HOST_VISIBLE);
+    if ((desc->flags & CGPU_BCF_PERSISTENT_MAP_BIT) && host_visible)
+    {
+        NullUtil_EnsureHostMemory(D, B);
+        B->mInfo.cpu_mapped_address = B->pHostMemory;
+        B->mPersistentMap = true;
+    }
+    else if (D->mValidation && (desc->flags & CGPU_BCF_PERSISTENT_MAP_BIT))
+    {
+        NULL_VALIDATION_ERROR(D, "cgpu null: buffer %s is persistent mapped but not host visible!", desc->name ? (const char*)desc->name : "");
+    }
+    skr_atomic_fetch_add_relaxed(&D->mBufferCount, 1);
+    NullUtil_AddStat(&D->mBufferBytes, B->mAlignedSize);
+    B->super.info = &B->mInfo;
+    return &B->super;
+}
+
+void cgpu_map_buffer_null(CGPUBufferId buffer, const struct CGPUBufferRange* range)
+{
+    CGPUBuffer_Null* B = (CGPUBuffer_Null*)buffer;
+    CGPUDevice_Null* D = (CGPUDevice_Null*)buffer->device;
+    if (D->mValidation && B->mInfo.memory_usage == CGPU_MEM_USAGE_GPU_ONLY)
+        NULL_VALIDATION_ERROR(D, "cgpu null: map of a gpu only buffer!");
+    const uint64_t offset = range ? range->offset : 0;
+    if (range && !NullUtil_BufferRangeValid(B, range->offset, range->size))
+    {
+        NULL_VALIDATION_ERROR(D, "cgpu null: map range out of buffer!");
+        return;
+    }
+    NullUtil_EnsureHostMemory(D, B);
+    B->mInfo.cpu_mapped_address = B->pHostMemory + offset;
+}
+
+void cgpu_unmap_buffer_null(CGPUBufferId buffer)
+{
+    CGPUBuffer_Null* B = (CGPUBuffer_Null*)buffer;
+    if (!B->mPersistentMap)
+    {
+        B->mInfo.cpu_mapped_address = CGPU_NULLPTR;
+    }
+}
+
+void cgpu_free_buffer_null(CGPUBufferId buffer)
+{
+    CGPUBuffer_Null* B = (CGPUBuffer_Null*)buffer;
+    CGPUDevice_Null* D = (CGPUDevice_Null*)buffer->device;
+    if (B->pHostMemory)
+    {
+        NullUtil_SubStat(&D->mHostBackedBytes, B->mInfo.size ? B->mInfo.size : 1);
+        cgpu_free(B->pHostMemory);
+    }
+    skr_atomic_fetch_sub_explicit(&D->mBufferCount, 1, skr_memory_order_relaxed);
+    NullUtil_SubStat(&D->mBufferBytes, B->mAlignedSize);
+    cgpu_free(B);
+}
+
+CGPUSamplerId cgpu_create_sampler_null(CGPUDeviceId device, const struct CGPUSamplerDescriptor* desc)
+{
+    CGPUSampler_Null* S = (CGPUSampler_Null*)cgpu_calloc(1, sizeof(CGPUSampler_Null));
+    S->mDesc = *desc;
+    return &S->super;
+}
+
+void cgpu_free_sampler_null(CGPUSamplerId sampler)
+{
+    cgpu_free((CGPUSampler_Null*)sampler);
+}
+
+// size of all subresources, rounded up to the placement alignment of a d3d12 heap
+static uint64_t NullUtil_TextureFootprint(const CGPUTextureDescriptor* desc, uint64_t alignment)
+{
+    const uint32_t block_bits = FormatUtil_BitSizeOfBlock(desc->format);
+    const uint32_t block_width = FormatUtil_WidthOfBlock(desc->format);
+    const uint32_t block_height = FormatUtil_HeightOfBlock(desc->format);
+    const uint64_t array_size = desc->array_size ? desc->array_size : 1;
+    const uint64_t sample_count = desc->sample_count ? desc->sample_count : 1;
+    const uint32_t mip_levels = desc->mip_levels ? desc->mip_levels : 1;
+    uint64_t size = 0;
+    for (uint32_t mip = 0; mip < mip_levels; mip++)
+    {
+        const uint64_t width = cgpu_max(desc->width >> mip, 1);
+        const uint64_t height = cgpu_max(desc->height >> mip, 1);
+        const uint64_t depth = cgpu_max(desc->depth >> mip, 1);
+        const uint64_t blocks_x = (width + block_width - 1) / block_width;
+        const uint64_t blocks_y = (height + block_height - 1) / block_height;
+        size += blocks_x * blocks_y * depth * block_bits / 8;
+    }
+    size *= array_size * sample_count;
+    return cgpu_round_up(cgpu_max(size, 1), alignment);
+}
+
+static CGPUTexture_Null* NullUtil_CreateTexture(CGPUDevice_Null* D, const CGPUTextureDescriptor* desc)
+{
+    CGPUTexture_Null* T = (CGPUTexture_Null*)cgpu_calloc(1, sizeof(CGPUTexture_Null));
+    const bool is_depth = FormatUtil_IsDepthStencilFormat(desc->format);
+    const bool is_aliasing = desc->flags & CGPU_TCF_ALIASING_RESOURCE;
+    T->mAlignment = (desc->sample_count > CGPU_SAMPLE_COUNT_1) ? CGPU_NULL_MSAA_TEXTURE_ALIGNMENT : CGPU_NULL_TEXTURE_ALIGNMENT;
+    T->mInfo.width = desc->width;
+    T->mInfo.height = desc->height;
+    T->mInfo.depth = desc->depth ? desc->depth : 1;
+    T->mInfo.mip_levels = desc->mip_levels ? desc->mip_levels : 1;
+    T->mInfo.array_size_minus_one = (desc->array_size ? desc->array_size : 1) - 1;
+    T->mInfo.size_in_bytes = NullUtil_TextureFootprint(desc, T->mAlignment);
+    T->mInfo.format = desc->format;
+    T->mInfo.sample_count = desc->sample_count;
+    T->mInfo.aspect_mask = is_depth ? (FormatUtil_IsDepthOnlyFormat(desc->format) ? CGPU_TVA_DEPTH : (CGPU_TVA_DEPTH | CGPU_TVA_STENCIL)) : CGPU_TVA_COLOR;
+    T->mInfo.is_cube = (desc->descriptors & CGPU_RESOURCE_TYPE_TEXTURE_CUBE) == CGPU_RESOURCE_TYPE_TEXTURE_CUBE;
+    T->mInfo.owns_image = !is_aliasing;
+    T->mInfo.is_aliasing = is_aliasing;
+    T->mInfo.is_restrict_dedicated = desc->is_restrict_dedicated;
+    T->mInfo.is_allocation_dedicated = desc->is_restrict_dedicated || (desc->flags & CGPU_TCF_DEDICATED_BIT);
+    T->mInfo.can_alias = !T->mInfo.is_allocation_dedicated;
+    T->mInfo.can_export = (desc->flags & CGPU_TCF_EXPORT_BIT) ? 1 : 0;
+    T->mState = desc->start_state;
+    T->super.info = &T->mInfo;
+    skr_atomic_fetch_add_relaxed(&D->mTextureCount, 1);
+    // aliasing textures are placed on memory of other textures
+    if (!is_aliasing) NullUtil_AddStat(&D->mTextureBytes, T->mInfo.size_in_bytes);
+    return T;
+}
+
+static void NullUtil_FreeTexture(CGPUDevice_Null* D, CGPUTexture_Null* T)
+{
+    skr_atomic_fetch_sub_explicit(&D->mTextureCount, 1, skr_memory_order_relaxed);
+    if (!T->mInfo.is_aliasing) NullUtil_SubStat(&D->mTextureBytes, T->mInfo.size_in_bytes);
+    cgpu_free(T);
+}
+
+CGPUTextureId cgpu_create_texture_null(CGPUDeviceId device, const struct CGPUTextureDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    if (D->mValidation && (desc->width == 0 || desc->height == 0 || desc->format == CGPU_FORMAT_UNDEFINED))
+        NULL_VALIDATION_ERROR(D, "cgpu null: texture %s created with zero extent or undefined format!", desc->name ? (const char*)desc->name : "");
+    if (D->mValidation && (desc->flags & CGPU_TCF_TILED_RESOURCE))
+        NULL_VALIDATION_ERROR(D, "cgpu null: tiled textures are not supported!");
+    return &NullUtil_CreateTexture(D, desc)->super;
+}
+
+void cgpu_free_texture_null(CGPUTextureId texture)
+{
+    NullUtil_FreeTexture((CGPUDevice_Null*)texture->device, (CGPUTexture_Null*)texture);
+}
+
+CGPUTextureViewId cgpu_create_texture_view_null(CGPUDeviceId device, const struct CGPUTextureViewDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    const CGPUTextureInfo* info = desc->texture->info;
+    if (D->mValidation && (desc->base_mip_level + desc->mip_level_count > info->mip_levels ||
+                              desc->base_array_layer + desc->array_layer_count > info->array_size_minus_one + 1))
+    {
+        NULL_VALIDATION_ERROR(D, "cgpu null: texture view %s subresource range out of texture!", desc->name ? (const char*)desc->name : "");
+    }
+    CGPUTextureView_Null* V = (CGPUTextureView_Null*)cgpu_calloc(1, sizeof(CGPUTextureView_Null));
+    return &V->super;
+}
+
+void cgpu_free_texture_view_null(CGPUTextureViewId render_target)
+{
+    cgpu_free((CGPUTextureView_Null*)render_target);
+}
+
+bool cgpu_try_bind_aliasing_texture_null(CGPUDeviceId device, const struct CGPUTextureAliasingBindDescriptor* desc)
+{
+    const CGPUTextureInfo* aliased = desc->aliased->info;
+    const CGPUTextureInfo* aliasing = desc->aliasing->info;
+    if (!aliasing->is_aliasing || !aliased->can_alias) return false;
+    return aliased->size_in_bytes >= desc->offset + aliasing->size_in_bytes;
+}
+
+// there is no native resource to share, exports hand out no handle and imports fail
+uint64_t cgpu_export_shared_texture_handle_null(CGPUDeviceId device, const struct CGPUExportTextureDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    if (D->mValidation)
+        NULL_VALIDATION_ERROR(D, "cgpu null: shared textures are not supported!");
+    return 0;
+}
+
+CGPUTextureId cgpu_import_shared_texture_handle_null(CGPUDeviceId device, const struct CGPUImportTextureDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    if (D->mValidation)
+        NULL_VALIDATION_ERROR(D, "cgpu null: shared textures are not supported!");
+    return CGPU_NULLPTR;
+}
+
+#pragma endregion Resources
+
+#pragma region Swapchain
+
+CGPUSwapChainId cgpu_create_swapchain_null(CGPUDeviceId device, const CGPUSwapChainDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    const uint32_t buffer_count = desc->image_count ? desc->image_count : 2;
+    CGPUSwapChain_Null* S = (CGPUSwapChain_Null*)cgpu_calloc(1, sizeof(CGPUSwapChain_Null) + buffer_count * sizeof(CGPUTextureId));
+    CGPUTextureId* back_buffers = (CGPUTextureId*)(S + 1);
+    SKR_DECLARE_ZERO(CGPUTextureDescriptor, tex_desc)
+    tex_desc.name = u8"NullBackBuffer";
+    tex_desc.width = desc->width;
+    tex_desc.height = desc->height;
+    tex_desc.depth = 1;
+    tex_desc.array_size = 1;
+    tex_desc.mip_levels = 1;
+    tex_desc.format = desc->format;
+    tex_desc.sample_count = CGPU_SAMPLE_COUNT_1;
+    tex_desc.descriptors = CGPU_RESOURCE_TYPE_TEXTURE | CGPU_RESOURCE_TYPE_RENDER_TARGET;
+    tex_desc.start_state = CGPU_RESOURCE_STATE_PRESENT;
+    for (uint32_t i = 0; i < buffer_count; i++)
+    {
+        CGPUTexture_Null* T = NullUtil_CreateTexture(D, &tex_desc);
+        T->super.device = device;
+        // backends disagree on the initial layout of back buffers, accept any first barrier
+        T->mStateDiverged = true;
+        back_buffers[i] = &T->super;
+    }
+    S->super.back_buffers = back_buffers;
+    S->super.buffer_count = buffer_count;
+    return &S->super;
+}
+
+uint32_t cgpu_acquire_next_image_null(CGPUSwapChainId swapchain, const struct CGPUAcquireNextDescriptor* desc)
+{
+    CGPUSwapChain_Null* S = (CGPUSwapChain_Null*)swapchain;
+    const uint32_t index = S->mCurrentImage;
+    S->mCurrentImage = (S->mCurrentImage + 1) % swapchain->buffer_count;
+    if (desc->signal_semaphore)
+        ((CGPUSemaphore_Null*)desc->signal_semaphore)->mSignaled = true;
+    if (desc->fence)
+        ((CGPUFence_Null*)desc->fence)->mSubmitted = true;
+    return index;
+}
+
+void cgpu_free_swapchain_null(CGPUSwapChainId swapchain)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)swapchain->device;
+    for (uint32_t i = 0; i < swapchain->buffer_count; i++)
+    {
+        NullUtil_FreeTexture(D, (CGPUTexture_Null*)swapchain->back_buffers[i]);
+    }
+    cgpu_free((CGPUSwapChain_Null*)swapchain);
+}
+
+void cgpu_free_surface_null(CGPUDeviceId device, CGPUSurfaceId surface)
+{
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+CGPUSurfaceId cgpu_surface_from_hwnd_null(CGPUDeviceId device, HWND window)
+{
+    return (CGPUSurfaceId)window;
+}
+#endif
+
+#ifdef __APPLE__
+CGPUSurfaceId cgpu_surface_from_ns_view_null(CGPUDeviceId device, CGPUNSView* window)
+{
+    return (CGPUSurfaceId)window;
+}
+#endif
+
+#pragma endregion Swapchain
+
+#pragma region CMDs
+
+void cgpu_cmd_begin_null(CGPUCommandBufferId cmd)
+{
+    CGPUCommandBuffer_Null* Cmd = (CGPUCommandBuffer_Null*)cmd;
+    CGPUDevice_Null* D = (CGPUDevice_Null*)cmd->device;
+    if (D->mValidation && Cmd->mRecording)
+        NULL_VALIDATION_ERROR(D, "cgpu null: cmd_begin on a command buffer already recording!");
+    Cmd->mStreamSize = 0;
+    Cmd->mCommandCount = 0;
+    Cmd->mRecording = true;
+}
+
+void cgpu_cmd_transfer_buffer_to_buffer_null(CGPUCommandBufferId cmd, const struct CGPUBufferToBufferTransfer* desc)
+{
+    CGPUBufferToBufferTransfer* payload = NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_TRANSFER_BUFFER_TO_BUFFER, 0, sizeof(CGPUBufferToBufferTransfer));
+    *payload = *desc;
+}
+
+void cgpu_cmd_transfer_texture_to_texture_null(CGPUCommandBufferId cmd, const struct CGPUTextureToTextureTransfer* desc)
+{
+    CGPUTextureToTextureTransfer* payload = NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_TRANSFER_TEXTURE_TO_TEXTURE, 0, sizeof(CGPUTextureToTextureTransfer));
+    *payload = *desc;
+}
+
+void cgpu_cmd_transfer_buffer_to_texture_null(CGPUCommandBufferId cmd, const struct CGPUBufferToTextureTransfer* desc)
+{
+    CGPUBufferToTextureTransfer* payload = NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_TRANSFER_BUFFER_TO_TEXTURE, 0, sizeof(CGPUBufferToTextureTransfer));
+    *payload = *desc;
+}
+
+void cgpu_cmd_transfer_buffer_to_tiles_null(CGPUCommandBufferId cmd, const struct CGPUBufferToTilesTransfer* desc)
+{
+    CGPUBufferToTilesTransfer* payload = NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_TRANSFER_BUFFER_TO_TILES, 0, sizeof(CGPUBufferToTilesTransfer));
+    *payload = *desc;
+}
+
+void cgpu_cmd_resource_barrier_null(CGPUCommandBufferId cmd, const struct CGPUResourceBarrierDescriptor* desc)
+{
+    const uint64_t buffers_size = desc->buffer_barriers_count * sizeof(CGPUBufferBarrier);
+    const uint64_t textures_size = desc->texture_barriers_count * sizeof(CGPUTextureBarrier);
+    NullCmd_ResourceBarrier* payload = NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_RESOURCE_BARRIER,
+        (uint16_t)cgpu_min(desc->buffer_barriers_count + desc->texture_barriers_count, UINT16_MAX),
+        sizeof(NullCmd_ResourceBarrier) + buffers_size + textures_size);
+    payload->buffer_barriers_count = desc->buffer_barriers_count;
+    payload->texture_barriers_count = desc->texture_barriers_count;
+    uint8_t* barriers = (uint8_t*)(payload + 1);
+    if (buffers_size) memcpy(barriers, desc->buffer_barriers, buffers_size);
+    if (textures_size) memcpy(barriers + buffers_size, desc->texture_barriers, textures_size);
+}
+
+static void NullUtil_RecordQuery(CGPUCommandBufferId cmd, ECGPUNullCommand op, CGPUQueryPoolId pool, CGPUBufferId readback, uint32_t start_query, uint32_t query_count)
+{
+    NullCmd_Query* payload = NullUtil_Record((CGPUCommandBuffer_Null*)cmd, op, 0, sizeof(NullCmd_Query));
+    payload->pool = pool;
+    payload->readback = readback;
+    payload->start_query = start_query;
+    payload->query_count = query_count;
+}
+
+void cgpu_cmd_begin_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, const struct CGPUQueryDescriptor* desc)
+{
+    NullUtil_RecordQuery(cmd, CGPU_NULL_CMD_BEGIN_QUERY, pool, CGPU_NULLPTR, desc->index, 1);
+}
+
+void cgpu_cmd_end_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, const struct CGPUQueryDescriptor* desc)
+{
+    NullUtil_RecordQuery(cmd, CGPU_NULL_CMD_END_QUERY, pool, CGPU_NULLPTR, desc->index, 1);
+}
+
+void cgpu_cmd_reset_query_pool_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, uint32_t start_query, uint32_t query_count)
+{
+    NullUtil_RecordQuery(cmd, CGPU_NULL_CMD_RESET_QUERY_POOL, pool, CGPU_NULLPTR, start_query, query_count);
+}
+
+void cgpu_cmd_resolve_query_null(CGPUCommandBufferId cmd, CGPUQueryPoolId pool, CGPUBufferId readback, uint32_t start_query, uint32_t query_count)
+{
+    NullUtil_RecordQuery(cmd, CGPU_NULL_CMD_RESOLVE_QUERY, pool, readback, start_query, query_count);
+}
+
+void cgpu_cmd_end_null(CGPUCommandBufferId cmd)
+{
+    CGPUCommandBuffer_Null* Cmd = (CGPUCommandBuffer_Null*)cmd;
+    CGPUDevice_Null* D = (CGPUDevice_Null*)cmd->device;
+    if (D->mValidation && !Cmd->mRecording)
+        NULL_VALIDATION_ERROR(D, "cgpu null: cmd_end on a command buffer not recording!");
+    Cmd->mRecording = false;
+    NullUtil_AddStat(&D->mRecordedCommands, Cmd->mCommandCount);
+    NullUtil_AddStat(&D->mRecordedBytes, Cmd->mStreamSize);
+}
+
+// Compute CMDs
+CGPUComputePassEncoderId cgpu_cmd_begin_compute_pass_null(CGPUCommandBufferId cmd, const struct CGPUComputePassDescriptor* desc)
+{
+    NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_BEGIN_COMPUTE_PASS, 0, 0);
+    // the command buffer handle is the encoder handle, same as vulkan & d3d12
+    return (CGPUComputePassEncoderId)cmd;
+}
+
+void cgpu_compute_encoder_bind_descriptor_set_null(CGPUComputePassEncoderId encoder, CGPUDescriptorSetId set)
+{
+    CGPUDescriptorSetId* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_COMPUTE_BIND_DESCRIPTOR_SET, 0, sizeof(CGPUDescriptorSetId));
+    *payload = set;
+}
+
+static void NullUtil_RecordPushConstants(CGPUCommandBuffer_Null* Cmd, ECGPUNullCommand op, CGPURootSignatureId rs, const char8_t* name, const void* data)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)Cmd->super.device;
+    const uint64_t name_hash = cgpu_name_hash(name, strlen((const char*)name));
+    const CGPUShaderResource* constant = CGPU_NULLPTR;
+    for (uint32_t i = 0; i < rs->push_constant_count && !constant; i++)
+    {
+        if (rs->push_constants[i].name_hash == name_hash) constant = rs->push_constants + i;
+    }
+    // reflected names differ between compilers, a single block is unambiguous
+    if (!constant && rs->push_constant_count == 1) constant = rs->push_constants;
+    if (!constant)
+        NULL_VALIDATION_ERROR(D, "cgpu null: push constant %s not found in root signature!", (const char*)name);
+    const uint32_t size = constant ? constant->size : 0;
+    NullCmd_PushConstants* payload = NullUtil_Record(Cmd, op, 0, sizeof(NullCmd_PushConstants) + size);
+    payload->root_signature = rs;
+    payload->name_hash = name_hash;
+    payload->size = size;
+    if (size) memcpy(payload + 1, data, size);
+}
+
+void cgpu_compute_encoder_push_constants_null(CGPUComputePassEncoderId encoder, CGPURootSignatureId rs, const char8_t* name, const void* data)
+{
+    NullUtil_RecordPushConstants((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_COMPUTE_PUSH_CONSTANTS, rs, name, data);
+}
+
+void cgpu_compute_encoder_bind_pipeline_null(CGPUComputePassEncoderId encoder, CGPUComputePipelineId pipeline)
+{
+    CGPUComputePipelineId* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_COMPUTE_BIND_PIPELINE, 0, sizeof(CGPUComputePipelineId));
+    *payload = pipeline;
+}
+
+void cgpu_compute_encoder_dispatch_null(CGPUComputePassEncoderId encoder, uint32_t X, uint32_t Y, uint32_t Z)
+{
+    uint32_t* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_DISPATCH, 0, 3 * sizeof(uint32_t));
+    payload[0] = X;
+    payload[1] = Y;
+    payload[2] = Z;
+}
+
+void cgpu_cmd_end_compute_pass_null(CGPUCommandBufferId cmd, CGPUComputePassEncoderId encoder)
+{
+    NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_END_COMPUTE_PASS, 0, 0);
+}
+
+// Render CMDs
+CGPURenderPassEncoderId cgpu_cmd_begin_render_pass_null(CGPUCommandBufferId cmd, const struct CGPURenderPassDescriptor* desc)
+{
+    const uint64_t colors_size = desc->render_target_count * sizeof(CGPUColorAttachment);
+    const uint64_t depth_size = desc->depth_stencil ? sizeof(CGPUDepthStencilAttachment) : 0;
+    NullCmd_RenderPass* payload = NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_BEGIN_RENDER_PASS,
+        (uint16_t)desc->render_target_count, sizeof(NullCmd_RenderPass) + colors_size + depth_size);
+    payload->render_target_count = desc->render_target_count;
+    payload->sample_count = desc->sample_count;
+    payload->has_depth_stencil = desc->depth_stencil != CGPU_NULLPTR;
+    uint8_t* attachments = (uint8_t*)(payload + 1);
+    if (colors_size) memcpy(attachments, desc->color_attachments, colors_size);
+    if (depth_size) memcpy(attachments + colors_size, desc->depth_stencil, depth_size);
+    return (CGPURenderPassEncoderId)cmd;
+}
+
+void cgpu_render_encoder_set_shading_rate_null(CGPURenderPassEncoderId encoder, ECGPUShadingRate shading_rate, ECGPUShadingRateCombiner post_rasterizer_rate, ECGPUShadingRateCombiner final_rate)
+{
+    uint32_t* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_SET_SHADING_RATE, 0, 3 * sizeof(uint32_t));
+    payload[0] = (uint32_t)shading_rate;
+    payload[1] = (uint32_t)post_rasterizer_rate;
+    payload[2] = (uint32_t)final_rate;
+}
+
+void cgpu_render_encoder_bind_descriptor_set_null(CGPURenderPassEncoderId encoder, CGPUDescriptorSetId set)
+{
+    CGPUDescriptorSetId* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_RENDER_BIND_DESCRIPTOR_SET, 0, sizeof(CGPUDescriptorSetId));
+    *payload = set;
+}
+
+void cgpu_render_encoder_set_viewport_null(CGPURenderPassEncoderId encoder, float x, float y, float width, float height, float min_depth, float max_depth)
+{
+    float* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_SET_VIEWPORT, 0, 6 * sizeof(float));
+    payload[0] = x;
+    payload[1] = y;
+    payload[2] = width;
+    payload[3] = height;
+    payload[4] = min_depth;
+    payload[5] = max_depth;
+}
+
+void cgpu_render_encoder_set_scissor_null(CGPURenderPassEncoderId encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    uint32_t* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_SET_SCISSOR, 0, 4 * sizeof(uint32_t));
+    payload[0] = x;
+    payload[1] = y;
+    payload[2] = width;
+    payload[3] = height;
+}
+
+void cgpu_render_encoder_bind_pipeline_null(CGPURenderPassEncoderId encoder, CGPURenderPipelineId pipeline)
+{
+    CGPURenderPipelineId* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_RENDER_BIND_PIPELINE, 0, sizeof(CGPURenderPipelineId));
+    *payload = pipeline;
+}
+
+void cgpu_render_encoder_bind_vertex_buffers_null(CGPURenderPassEncoderId encoder, uint32_t buffer_count,
+    const CGPUBufferId* buffers, const uint32_t* strides, const uint32_t* offsets)
+{
+    NullCmd_VertexBuffer* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_BIND_VERTEX_BUFFERS,
+        (uint16_t)buffer_count, buffer_count * sizeof(NullCmd_VertexBuffer));
+    for (uint32_t i = 0; i < buffer_count; i++)
+    {
+        payload[i].buffer = buffers[i];
+        payload[i].stride = strides ? strides[i] : 0;
+        payload[i].offset = offsets ? offsets[i] : 0;
+    }
+}
+
+void cgpu_render_encoder_bind_index_buffer_null(CGPURenderPassEncoderId encoder, CGPUBufferId buffer, uint32_t index_stride, uint64_t offset)
+{
+    NullCmd_IndexBuffer* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_BIND_INDEX_BUFFER, 0, sizeof(NullCmd_IndexBuffer));
+    payload->buffer = buffer;
+    payload->index_stride = index_stride;
+    payload->offset = offset;
+}
+
+void cgpu_render_encoder_push_constants_null(CGPURenderPassEncoderId encoder, CGPURootSignatureId rs, const char8_t* name, const void* data)
+{
+    NullUtil_RecordPushConstants((CGPUCommandBuffer_Null*)encoder, CGPU_NULL_CMD_RENDER_PUSH_CONSTANTS, rs, name, data);
+}
+
+static void NullUtil_RecordDraw(CGPURenderPassEncoderId encoder, ECGPUNullCommand op, uint32_t count, uint32_t first, uint32_t instance_count, uint32_t first_instance, uint32_t first_vertex)
+{
+    NullCmd_Draw* payload = NullUtil_Record((CGPUCommandBuffer_Null*)encoder, op, 0, sizeof(NullCmd_Draw));
+    payload->count = count;
+    payload->first = first;
+    payload->instance_count = instance_count;
+    payload->first_instance = first_instance;
+    payload->first_vertex = first_vertex;
+}
+
+void cgpu_render_encoder_draw_null(CGPURenderPassEncoderId encoder, uint32_t vertex_count, uint32_t first_vertex)
+{
+    NullUtil_RecordDraw(encoder, CGPU_NULL_CMD_DRAW, vertex_count, first_vertex, 1, 0, first_vertex);
+}
+
+void cgpu_render_encoder_draw_instanced_null(CGPURenderPassEncoderId encoder, uint32_t vertex_count, uint32_t first_vertex, uint32_t instance_count, uint32_t first_instance)
+{
+    NullUtil_RecordDraw(encoder, CGPU_NULL_CMD_DRAW_INSTANCED, vertex_count, first_vertex, instance_count, first_instance, first_vertex);
+}
+
+void cgpu_render_encoder_draw_indexed_null(CGPURenderPassEncoderId encoder, uint32_t index_count, uint32_t first_index, uint32_t first_vertex)
+{
+    NullUtil_RecordDraw(encoder, CGPU_NULL_CMD_DRAW_INDEXED, index_count, first_index, 1, 0, first_vertex);
+}
+
+void cgpu_render_encoder_draw_indexed_instanced_null(CGPURenderPassEncoderId encoder, uint32_t index_count, uint32_t first_index, uint32_t instance_count, uint32_t first_instance, uint32_t first_vertex)
+{
+    NullUtil_RecordDraw(encoder, CGPU_NULL_CMD_DRAW_INDEXED_INSTANCED, index_count, first_index, instance_count, first_instance, first_vertex);
+}
+
+void cgpu_cmd_end_render_pass_null(CGPUCommandBufferId cmd, CGPURenderPassEncoderId encoder)
+{
+    NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_END_RENDER_PASS, 0, 0);
+}
+
+// Events & Markers
+static void NullUtil_RecordEvent(CGPUCommandBufferId cmd, ECGPUNullCommand op, const char8_t* name, const float* color)
+{
+    const uint32_t name_length = name ? (uint32_t)strlen((const char*)name) : 0;
+    NullCmd_Event* payload = NullUtil_Record((CGPUCommandBuffer_Null*)cmd, op, 0, sizeof(NullCmd_Event) + name_length + 1);
+    memcpy(payload->color, color, sizeof(payload->color));
+    payload->name_length = name_length;
+    char* chars = (char*)(payload + 1);
+    if (name_length) memcpy(chars, name, name_length);
+    chars[name_length] = '\0';
+}
+
+void cgpu_cmd_begin_event_null(CGPUCommandBufferId cmd, const CGPUEventInfo* event)
+{
+    NullUtil_RecordEvent(cmd, CGPU_NULL_CMD_BEGIN_EVENT, event->name, event->color);
+}
+
+void cgpu_cmd_set_marker_null(CGPUCommandBufferId cmd, const CGPUMarkerInfo* marker)
+{
+    NullUtil_RecordEvent(cmd, CGPU_NULL_CMD_SET_MARKER, marker->name, marker->color);
+}
+
+void cgpu_cmd_end_event_null(CGPUCommandBufferId cmd)
+{
+    NullUtil_Record((CGPUCommandBuffer_Null*)cmd, CGPU_NULL_CMD_END_EVENT, 0, 0);
+}
+
+#pragma endregion CMDs
+
+#pragma region DStorage
+
+// availability is NONE so callers never get a queue, the rest only guards against misuse
+ECGPUDStorageAvailability cgpu_query_dstorage_availability_null(CGPUDeviceId device)
+{
+    return SKR_DSTORAGE_AVAILABILITY_NONE;
+}
+
+CGPUDStorageQueueId cgpu_create_dstorage_queue_null(CGPUDeviceId device, const CGPUDStorageQueueDescriptor* desc)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)device;
+    NULL_VALIDATION_ERROR(D, "cgpu null: dstorage is not available!");
+    return CGPU_NULLPTR;
+}
+
+CGPUDStorageFileHandle cgpu_dstorage_open_file_null(CGPUDStorageQueueId queue, const char8_t* abs_path)
+{
+    return CGPU_NULLPTR;
+}
+
+void cgpu_dstorage_query_file_info_null(CGPUDStorageQueueId queue, CGPUDStorageFileHandle file, CGPUDStorageFileInfo* info)
+{
+    memset(info, 0, sizeof(CGPUDStorageFileInfo));
+}
+
+void cgpu_dstorage_enqueue_buffer_request_null(CGPUDStorageQueueId queue, const CGPUDStorageBufferIODescriptor* desc)
+{
+}
+
+void cgpu_dstorage_enqueue_texture_request_null(CGPUDStorageQueueId queue, const CGPUDStorageTextureIODescriptor* desc)
+{
+}
+
+void cgpu_dstorage_queue_submit_null(CGPUDStorageQueueId queue, CGPUFenceId fence)
+{
+}
+
+void cgpu_dstorage_close_file_null(CGPUDStorageQueueId queue, CGPUDStorageFileHandle file)
+{
+}
+
+void cgpu_free_dstorage_queue_null(CGPUDStorageQueueId queue)
+{
+}
+
+#pragma endregion DStorage
+
+#pragma region StateBuffer
+
+CGPUStateBufferId cgpu_create_state_buffer_null(CGPUCommandBufferId cmd, const struct CGPUStateBufferDescriptor* desc)
+{
+    CGPUStateBuffer_Null* S = (CGPUStateBuffer_Null*)cgpu_calloc(1, sizeof(CGPUStateBuffer_Null));
+    S->super.device = cmd->device;
+    S->super.cmd = cmd;
+    return &S->super;
+}
+
+void cgpu_render_encoder_bind_state_buffer_null(CGPURenderPassEncoderId encoder, CGPUStateBufferId stream)
+{
+    CGPUStateBuffer_Null* S = (CGPUStateBuffer_Null*)stream;
+    S->pREncoder = encoder;
+}
+
+void cgpu_compute_encoder_bind_state_buffer_null(CGPUComputePassEncoderId encoder, CGPUStateBufferId stream)
+{
+    CGPUStateBuffer_Null* S = (CGPUStateBuffer_Null*)stream;
+    S->pCEncoder = encoder;
+}
+
+void cgpu_free_state_buffer_null(CGPUStateBufferId stream)
+{
+    cgpu_free((CGPUStateBuffer_Null*)stream);
+}
+
+CGPURasterStateEncoderId cgpu_open_raster_state_encoder_null(CGPUStateBufferId stream, CGPURenderPassEncoderId encoder)
+{
+    CGPUStateBuffer_Null* S = (CGPUStateBuffer_Null*)stream;
+    S->pREncoder = encoder;
+    return (CGPURasterStateEncoderId)stream;
+}
+
+// viewport & scissor go to the render pass stream so they are validated on replay, the rest is dynamic state without effect here
+void cgpu_raster_state_encoder_set_viewport_null(CGPURasterStateEncoderId encoder, float x, float y, float width, float height, float min_depth, float max_depth)
+{
+    const CGPUStateBuffer_Null* S = (const CGPUStateBuffer_Null*)encoder;
+    cgpu_render_encoder_set_viewport_null(S->pREncoder, x, y, width, height, min_depth, max_depth);
+}
+
+void cgpu_raster_state_encoder_set_scissor_null(CGPURasterStateEncoderId encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    const CGPUStateBuffer_Null* S = (const CGPUStateBuffer_Null*)encoder;
+    cgpu_render_encoder_set_scissor_null(S->pREncoder, x, y, width, height);
+}
+
+void cgpu_raster_state_encoder_set_cull_mode_null(CGPURasterStateEncoderId encoder, ECGPUCullMode cull_mode)
+{
+}
+
+void cgpu_raster_state_encoder_set_front_face_null(CGPURasterStateEncoderId encoder, ECGPUFrontFace front_face)
+{
+}
+
+void cgpu_raster_state_encoder_set_primitive_topology_null(CGPURasterStateEncoderId encoder, ECGPUPrimitiveTopology topology)
+{
+}
+
+void cgpu_raster_state_encoder_set_depth_test_enabled_null(CGPURasterStateEncoderId encoder, bool enabled)
+{
+}
+
+void cgpu_raster_state_encoder_set_depth_write_enabled_null(CGPURasterStateEncoderId encoder, bool enabled)
+{
+}
+
+void cgpu_raster_state_encoder_set_depth_compare_op_null(CGPURasterStateEncoderId encoder, ECGPUCompareMode compare_op)
+{
+}
+
+void cgpu_raster_state_encoder_set_stencil_test_enabled_null(CGPURasterStateEncoderId encoder, bool enabled)
+{
+}
+
+void cgpu_raster_state_encoder_set_stencil_compare_op_null(CGPURasterStateEncoderId encoder, CGPUStencilFaces faces, ECGPUStencilOp failOp, ECGPUStencilOp passOp, ECGPUStencilOp depthFailOp, ECGPUCompareMode compareOp)
+{
+}
+
+void cgpu_raster_state_encoder_set_fill_mode_null(CGPURasterStateEncoderId encoder, ECGPUFillMode fill_mode)
+{
+}
+
+void cgpu_raster_state_encoder_set_sample_count_null(CGPURasterStateEncoderId encoder, ECGPUSampleCount sample_count)
+{
+}
+
+void cgpu_close_raster_state_encoder_null(CGPURasterStateEncoderId encoder)
+{
+}
+
+CGPUShaderStateEncoderId cgpu_open_shader_state_encoder_r_null(CGPUStateBufferId stream, CGPURenderPassEncoderId encoder)
+{
+    CGPUStateBuffer_Null* S = (CGPUStateBuffer_Null*)stream;
+    S->pREncoder = encoder;
+    return (CGPUShaderStateEncoderId)stream;
+}
+
+CGPUShaderStateEncoderId cgpu_open_shader_state_encoder_c_null(CGPUStateBufferId stream, CGPUComputePassEncoderId encoder)
+{
+    CGPUStateBuffer_Null* S = (CGPUStateBuffer_Null*)stream;
+    S->pCEncoder = encoder;
+    return (CGPUShaderStateEncoderId)stream;
+}
+
+void cgpu_shader_state_encoder_bind_shaders_null(CGPUShaderStateEncoderId encoder, uint32_t stage_count, const ECGPUShaderStage* stages, const CGPUCompiledShaderId* shaders)
+{
+    CGPUDevice_Null* D = (CGPUDevice_Null*)encoder->device;
+    if (!D->mValidation) return;
+    for (uint32_t i = 0; i < stage_count; i++)
+    {
+        const CGPUCompiledShader_Null* shader = (const CGPUCompiledShader_Null*)shaders[i];
+        if (shader && shader->mStage != stages[i])
+            NULL_VALIDATION_ERROR(D, "cgpu null: shader compiled for stage %#x bound to stage %#x!",
+                (uint32_t)shader->mStage, (uint32_t)stages[i]);
+    }
+}
+
+void cgpu_shader_state_encoder_bind_linked_shader_null(CGPUShaderStateEncoderId encoder, CGPULinkedShaderId linked)
+{
+}
+
+void cgpu_close_shader_state_encoder_null(CGPUShaderStateEncoderId encoder)
+{
+}
+
+CGPUUserStateEncoderId cgpu_open_user_state_encoder_null(CGPUStateBufferId stream, CGPURenderPassEncoderId encoder)
+{
+    return (CGPUUserStateEncoderId)stream;
+}
+
+void cgpu_close_user_state_encoder_null(CGPUUserStateEncoderId encoder)
+{
+}
+
+#pragma endregion StateBuffer
+
+#pragma region Binder
+
+CGPUBinderId cgpu_create_binder_null(CGPUCommandBufferId cmd)
+{
+    CGPUBinder_Null* B = (CGPUBinder_Null*)cgpu_calloc(1, sizeof(CGPUBinder_Null));
+    B->super.device = cmd->device;
+    B->super.cmd = cmd;
+    return &B->super;
+}
+
+void cgpu_binder_bind_vertex_layout_null(CGPUBinderId binder, const struct CGPUVertexLayout* layout)
+{
+    CGPUBinder_Null* B = (CGPUBinder_Null*)binder;
+    B->mVertexLayoutBound = true;
+}
+
+void cgpu_binder_bind_vertex_buffer_null(CGPUBinderId binder, uint32_t first_binding, uint32_t binding_count, const CGPUBufferId* buffers, const uint64_t* offsets, const uint64_t* sizes, const uint64_t* strides)
+{
+    const CGPUBinder_Null* B = (const CGPUBinder_Null*)binder;
+    CGPUDevice_Null* D = (CGPUDevice_Null*)binder->device;
+    if (!D->mValidation) return;
+    if (!B->mVertexLayoutBound)
+        NULL_VALIDATION_ERROR(D, "cgpu null: vertex buffers bound before a vertex layout!");
+    const CGPUAdapterDetail* detail = cgpu_query_adapter_detail(binder->device->adapter);
+    if (first_binding + binding_count > detail->max_vertex_input_bindings)
+        NULL_VALIDATION_ERROR(D, "cgpu null: binding %d vertex buffers from %d exceeds the limit %d!",
+            (int)binding_count, (int)first_binding, (int)detail->max_vertex_input_bindings);
+    for (uint32_t i = 0; i < binding_count; i++)
+    {
+        const CGPUBuffer_Null* buffer = (const CGPUBuffer_Null*)buffers[i];
+        if (buffer && offsets && offsets[i] > buffer->mInfo.size)
+            NULL_VALIDATION_ERROR(D, "cgpu null: vertex buffer offset %llu out of range!", (unsigned long long)offsets[i]);
+    }
+}
+
+void cgpu_free_binder_null(CGPUBinderId binder)
+{
+    cgpu_free((CGPUBinder_Null*)binder);
+}
+
+#pragma endregion Binder
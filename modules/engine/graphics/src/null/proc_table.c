@@ -0,0 +1,212 @@
+#include "SkrGraphics/backend/null/cgpu_null.h"
+
+const CGPUProcTable tbl_null = {
+    // Instance APIs
+    .create_instance = &cgpu_create_instance_null,
+    .query_instance_features = &cgpu_query_instance_features_null,
+    .free_instance = &cgpu_free_instance_null,
+
+    // Adapter APIs
+    .enum_adapters = &cgpu_enum_adapters_null,
+    .query_adapter_detail = &cgpu_query_adapter_detail_null,
+    .query_queue_count = &cgpu_query_queue_count_null,
+
+    // Device APIs
+    .create_device = &cgpu_create_device_null,
+    .query_video_memory_info = &cgpu_query_video_memory_info_null,
+    .query_shared_memory_info = &cgpu_query_shared_memory_info_null,
+    .query_pipeline_cache_data = &cgpu_query_pipeline_cache_data_null,
+    .free_device = &cgpu_free_device_null,
+
+    // API Object APIs
+    .create_fence = &cgpu_create_fence_null,
+    .wait_fences = &cgpu_wait_fences_null,
+    .query_fence_status = &cgpu_query_fence_status_null,
+    .free_fence = &cgpu_free_fence_null,
+    .create_semaphore = &cgpu_create_semaphore_null,
+    .free_semaphore = &cgpu_free_semaphore_null,
+    .create_root_signature_pool = &cgpu_create_root_signature_pool_null,
+    .free_root_signature_pool = &cgpu_free_root_signature_pool_null,
+    .create_root_signature = &cgpu_create_root_signature_null,
+    .free_root_signature = &cgpu_free_root_signature_null,
+    .create_descriptor_set = &cgpu_create_descriptor_set_null,
+    .update_descriptor_set = &cgpu_update_descriptor_set_null,
+    .free_descriptor_set = &cgpu_free_descriptor_set_null,
+    .create_compute_pipeline = &cgpu_create_compute_pipeline_null,
+    .free_compute_pipeline = &cgpu_free_compute_pipeline_null,
+    .create_render_pipeline = &cgpu_create_render_pipeline_null,
+    .free_render_pipeline = &cgpu_free_render_pipeline_null,
+    .create_query_pool = &cgpu_create_query_pool_null,
+    .free_query_pool = &cgpu_free_query_pool_null,
+    .create_memory_pool = &cgpu_create_memory_pool_null,
+    .free_memory_pool = &cgpu_free_memory_pool_null,
+
+    // Queue APIs
+    .get_queue = &cgpu_get_queue_null,
+    .submit_queue = &cgpu_submit_queue_null,
+    .wait_queue_idle = &cgpu_wait_queue_idle_null,
+    .queue_present = &cgpu_queue_present_null,
+    .queue_get_timestamp_period = &cgpu_queue_get_timestamp_period_ns_null,
+    .queue_map_tiled_texture = &cgpu_queue_map_tiled_texture_null,
+    .queue_unmap_tiled_texture = &cgpu_queue_unmap_tiled_texture_null,
+    .queue_map_packed_mips = &cgpu_queue_map_packed_mips_null,
+    .queue_unmap_packed_mips = &cgpu_queue_unmap_packed_mips_null,
+    .free_queue = &cgpu_free_queue_null,
+
+    // Command APIs
+    .create_command_pool = &cgpu_create_command_pool_null,
+    .create_command_buffer = &cgpu_create_command_buffer_null,
+    .reset_command_pool = &cgpu_reset_command_pool_null,
+    .free_command_buffer = &cgpu_free_command_buffer_null,
+    .free_command_pool = &cgpu_free_command_pool_null,
+
+    // Events & Markers
+    .cmd_begin_event = &cgpu_cmd_begin_event_null,
+    .cmd_set_marker = &cgpu_cmd_set_marker_null,
+    .cmd_end_event = &cgpu_cmd_end_event_null,
+
+    // Shader APIs
+    .create_shader_library = &cgpu_create_shader_library_null,
+    .free_shader_library = &cgpu_free_shader_library_null,
+
+    // Texture/TextureView APIs
+    .create_texture = &cgpu_create_texture_null,
+    .free_texture = &cgpu_free_texture_null,
+    .create_texture_view = &cgpu_create_texture_view_null,
+    .free_texture_view = &cgpu_free_texture_view_null,
+    .try_bind_aliasing_texture = &cgpu_try_bind_aliasing_texture_null,
+
+    // Shared Resource APIs
+    .export_shared_texture_handle = &cgpu_export_shared_texture_handle_null,
+    .import_shared_texture_handle = &cgpu_import_shared_texture_handle_null,
+
+    // Buffer APIs
+    .create_buffer = &cgpu_create_buffer_null,
+    .map_buffer = &cgpu_map_buffer_null,
+    .unmap_buffer = &cgpu_unmap_buffer_null,
+    .free_buffer = &cgpu_free_buffer_null,
+
+    // Sampler APIs
+    .create_sampler = &cgpu_create_sampler_null,
+    .free_sampler = &cgpu_free_sampler_null,
+
+    // Swapchain APIs
+    .create_swapchain = &cgpu_create_swapchain_null,
+    .acquire_next_image = &cgpu_acquire_next_image_null,
+    .free_swapchain = &cgpu_free_swapchain_null,
+
+    // CMDs
+    .cmd_begin = &cgpu_cmd_begin_null,
+    .cmd_transfer_buffer_to_buffer = &cgpu_cmd_transfer_buffer_to_buffer_null,
+    .cmd_transfer_texture_to_texture = &cgpu_cmd_transfer_texture_to_texture_null,
+    .cmd_transfer_buffer_to_texture = &cgpu_cmd_transfer_buffer_to_texture_null,
+    .cmd_transfer_buffer_to_tiles = &cgpu_cmd_transfer_buffer_to_tiles_null,
+    .cmd_resource_barrier = &cgpu_cmd_resource_barrier_null,
+    .cmd_begin_query = &cgpu_cmd_begin_query_null,
+    .cmd_end_query = &cgpu_cmd_end_query_null,
+    .cmd_reset_query_pool = &cgpu_cmd_reset_query_pool_null,
+    .cmd_resolve_query = &cgpu_cmd_resolve_query_null,
+    .cmd_end = &cgpu_cmd_end_null,
+
+    // Compute Pass
+    .cmd_begin_compute_pass = &cgpu_cmd_begin_compute_pass_null,
+    .compute_encoder_bind_descriptor_set = &cgpu_compute_encoder_bind_descriptor_set_null,
+    .compute_encoder_push_constants = &cgpu_compute_encoder_push_constants_null,
+    .compute_encoder_bind_pipeline = &cgpu_compute_encoder_bind_pipeline_null,
+    .compute_encoder_dispatch = &cgpu_compute_encoder_dispatch_null,
+    .cmd_end_compute_pass = &cgpu_cmd_end_compute_pass_null,
+
+    // Render Pass
+    .cmd_begin_render_pass = &cgpu_cmd_begin_render_pass_null,
+    .render_encoder_set_shading_rate = &cgpu_render_encoder_set_shading_rate_null,
+    .render_encoder_bind_descriptor_set = &cgpu_render_encoder_bind_descriptor_set_null,
+    .render_encoder_set_viewport = &cgpu_render_encoder_set_viewport_null,
+    .render_encoder_set_scissor = &cgpu_render_encoder_set_scissor_null,
+    .render_encoder_bind_pipeline = &cgpu_render_encoder_bind_pipeline_null,
+    .render_encoder_bind_vertex_buffers = &cgpu_render_encoder_bind_vertex_buffers_null,
+    .render_encoder_bind_index_buffer = &cgpu_render_encoder_bind_index_buffer_null,
+    .render_encoder_push_constants = &cgpu_render_encoder_push_constants_null,
+    .render_encoder_draw = &cgpu_render_encoder_draw_null,
+    .render_encoder_draw_instanced = &cgpu_render_encoder_draw_instanced_null,
+    .render_encoder_draw_indexed = &cgpu_render_encoder_draw_indexed_null,
+    .render_encoder_draw_indexed_instanced = &cgpu_render_encoder_draw_indexed_instanced_null,
+    .cmd_end_render_pass = &cgpu_cmd_end_render_pass_null,
+
+    // DStorage
+    .query_dstorage_availability = &cgpu_query_dstorage_availability_null,
+    .create_dstorage_queue = &cgpu_create_dstorage_queue_null,
+    .dstorage_open_file = &cgpu_dstorage_open_file_null,
+    .dstorage_query_file_info = &cgpu_dstorage_query_file_info_null,
+    .dstorage_enqueue_buffer_request = &cgpu_dstorage_enqueue_buffer_request_null,
+    .dstorage_enqueue_texture_request = &cgpu_dstorage_enqueue_texture_request_null,
+    .dstorage_queue_submit = &cgpu_dstorage_queue_submit_null,
+    .dstorage_close_file = &cgpu_dstorage_close_file_null,
+    .free_dstorage_queue = &cgpu_free_dstorage_queue_null,
+
+    // Compiled/Linked ISA APIs
+    .compile_and_link_shaders = &cgpu_compile_and_link_shaders_null,
+    .compile_shaders = &cgpu_compile_shaders_null,
+    .free_compiled_shader = &cgpu_free_compiled_shader_null,
+    .free_linked_shader = &cgpu_free_linked_shader_null,
+
+    // StateBuffer APIs
+    .create_state_buffer = &cgpu_create_state_buffer_null,
+    .render_encoder_bind_state_buffer = &cgpu_render_encoder_bind_state_buffer_null,
+    .compute_encoder_bind_state_buffer = &cgpu_compute_encoder_bind_state_buffer_null,
+    .free_state_buffer = &cgpu_free_state_buffer_null,
+
+    // raster state encoder APIs
+    .open_raster_state_encoder = &cgpu_open_raster_state_encoder_null,
+    .raster_state_encoder_set_viewport = &cgpu_raster_state_encoder_set_viewport_null,
+    .raster_state_encoder_set_scissor = &cgpu_raster_state_encoder_set_scissor_null,
+    .raster_state_encoder_set_cull_mode = &cgpu_raster_state_encoder_set_cull_mode_null,
+    .raster_state_encoder_set_front_face = &cgpu_raster_state_encoder_set_front_face_null,
+    .raster_state_encoder_set_primitive_topology = &cgpu_raster_state_encoder_set_primitive_topology_null,
+    .raster_state_encoder_set_depth_test_enabled = &cgpu_raster_state_encoder_set_depth_test_enabled_null,
+    .raster_state_encoder_set_depth_write_enabled = &cgpu_raster_state_encoder_set_depth_write_enabled_null,
+    .raster_state_encoder_set_depth_compare_op = &cgpu_raster_state_encoder_set_depth_compare_op_null,
+    .raster_state_encoder_set_stencil_test_enabled = &cgpu_raster_state_encoder_set_stencil_test_enabled_null,
+    .raster_state_encoder_set_stencil_compare_op = &cgpu_raster_state_encoder_set_stencil_compare_op_null,
+    .raster_state_encoder_set_fill_mode = &cgpu_raster_state_encoder_set_fill_mode_null,
+    .raster_state_encoder_set_sample_count = &cgpu_raster_state_encoder_set_sample_count_null,
+    .close_raster_state_encoder = &cgpu_close_raster_state_encoder_null,
+
+    // shader state encoder APIs
+    .open_shader_state_encoder_r = &cgpu_open_shader_state_encoder_r_null,
+    .open_shader_state_encoder_c = &cgpu_open_shader_state_encoder_c_null,
+    .shader_state_encoder_bind_shaders = &cgpu_shader_state_encoder_bind_shaders_null,
+    .shader_state_encoder_bind_linked_shader = &cgpu_shader_state_encoder_bind_linked_shader_null,
+    .close_shader_state_encoder = &cgpu_close_shader_state_encoder_null,
+
+    // user state encoder APIs
+    .open_user_state_encoder = &cgpu_open_user_state_encoder_null,
+    .close_user_state_encoder = &cgpu_close_user_state_encoder_null,
+
+    // binder APIs
+    .create_binder = &cgpu_create_binder_null,
+    .binder_bind_vertex_layout = &cgpu_binder_bind_vertex_layout_null,
+    .binder_bind_vertex_buffer = &cgpu_binder_bind_vertex_buffer_null,
+    .free_binder = &cgpu_free_binder_null
+};
+
+const CGPUProcTable* CGPU_NullProcTable()
+{
+    return &tbl_null;
+}
+
+const CGPUSurfacesProcTable s_tbl_null = {
+    //
+    .free_surface = cgpu_free_surface_null,
+#if defined(_WIN32) || defined(_WIN64)
+    .from_hwnd = cgpu_surface_from_hwnd_null
+#endif
+#ifdef __APPLE__
+    .from_ns_view = cgpu_surface_from_ns_view_null
+#endif
+    //
+};
+
+const CGPUSurfacesProcTable* CGPU_NullSurfacesProcTable()
+{
+    return &s_tbl_null;
+}
@@ -476,7 +476,7 @@ CGPUDeviceId cgpu_create_device_vulkan(CGPUAdapterId adapter, const CGPUDeviceDe
     D->pPipelineCache = CGPU_NULLPTR;
     if (!desc->disable_pipeline_cache)
     {
-        VkUtil_CreatePipelineCache(D);
+        VkUtil_CreatePipelineCache(D, desc->pipeline_cache_data, desc->pipeline_cache_size);
     }
 
     // Create VMA Allocator
@@ -96,6 +96,21 @@ void cgpu_query_shared_memory_info_vulkan(const CGPUDeviceId device, uint64_t* t
     }
 }
 
+void cgpu_query_pipeline_cache_data_vulkan(const CGPUDeviceId device, uint64_t* size, void* data)
+{
+    CGPUDevice_Vulkan* D = (CGPUDevice_Vulkan*)device;
+    if (D->pPipelineCache == VK_NULL_HANDLE)
+    {
+        *size = 0;
+        return;
+    }
+    size_t data_size = (size_t)*size;
+    if (!data) data_size = 0;
+    VkResult result = D->mVkDeviceTable.vkGetPipelineCacheData(D->pVkDevice, D->pPipelineCache, &data_size, data);
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE) data_size = 0;
+    *size = data_size;
+}
+
 // Buffer APIs
 cgpu_static_assert(sizeof(CGPUBuffer_Vulkan) <= 8 * sizeof(uint64_t), "Acquire Single CacheLine"); // Cache Line
 CGPUBufferId cgpu_create_buffer_vulkan(CGPUDeviceId device, const struct CGPUBufferDescriptor* desc)
@@ -926,6 +941,12 @@ CGPUTextureId cgpu_create_texture_vulkan(CGPUDeviceId device, const struct CGPUT
     info->is_imported = is_imported;
     info->is_tiled = (desc->flags & CGPU_TCF_TILED_RESOURCE) ? 1 : 0;
     info->unique_id = (unique_id == UINT64_MAX) ? D->super.next_texture_id++ : unique_id;
+    if (T->pVkImage != VK_NULL_HANDLE && !is_imported)
+    {
+        VkMemoryRequirements memReq;
+        D->mVkDeviceTable.vkGetImageMemoryRequirements(D->pVkDevice, T->pVkImage, &memReq);
+        info->size_in_bytes = memReq.size;
+    }
     // Set Texture Name
     VkUtil_OptionalSetObjectName(D, (uint64_t)T->pVkImage, VK_OBJECT_TYPE_IMAGE, desc->name);
     // Start state
@@ -1467,15 +1488,16 @@ bool cgpu_try_bind_aliasing_texture_vulkan(CGPUDeviceId device, const struct CGP
             Aliasing->pVkImage, &aliasingMemReq);
             D->mVkDeviceTable.vkGetImageMemoryRequirements(D->pVkDevice,
             Aliased->pVkImage, &aliasedMemReq);
-            if (aliasedMemReq.size >= aliasingMemReq.size &&
+            if (aliasedMemReq.size >= desc->offset + aliasingMemReq.size &&
                 aliasedMemReq.alignment >= aliasingMemReq.alignment &&
+                desc->offset % aliasingMemReq.alignment == 0 &&
                 aliasedMemReq.memoryTypeBits & aliasingMemReq.memoryTypeBits)
             {
                 const bool isSinglePlane = true;
                 if (isSinglePlane)
                 {
-                    VkResult res = vmaBindImageMemory(D->pVmaAllocator,
-                    Aliased->pVkAllocation, Aliasing->pVkImage);
+                    VkResult res = vmaBindImageMemory2(D->pVmaAllocator,
+                    Aliased->pVkAllocation, desc->offset, Aliasing->pVkImage, CGPU_NULLPTR);
                     if (res == VK_SUCCESS)
                     {
                         Aliasing->pVkAllocation = Aliased->pVkAllocation;
@@ -278,19 +278,45 @@ const char* const* device_extensions, uint32_t device_extension_count)
 }
 
 // Device APIs
-void VkUtil_CreatePipelineCache(CGPUDevice_Vulkan* D)
+// drivers are not required to survive a blob of another device, check the header before handing it over
+static bool VkUtil_PipelineCacheCompatible(const CGPUAdapter_Vulkan* A, const void* data, uint64_t size)
+{
+    VkPipelineCacheHeaderVersionOne header;
+    if (!data || size < sizeof(header)) return false;
+    memcpy(&header, data, sizeof(header));
+    const VkPhysicalDeviceProperties* props = &A->mPhysicalDeviceProps.properties;
+    return header.headerSize >= sizeof(header) &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == props->vendorID &&
+           header.deviceID == props->deviceID &&
+           memcmp(header.pipelineCacheUUID, props->pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+void VkUtil_CreatePipelineCache(CGPUDevice_Vulkan* D, const void* initial_data, uint64_t initial_size)
 {
     cgpu_assert((D->pPipelineCache == VK_NULL_HANDLE) && "VkUtil_CreatePipelineCache should be called only once!");
 
-    // TODO: serde
+    const CGPUAdapter_Vulkan* A = (const CGPUAdapter_Vulkan*)D->super.adapter;
+    const bool compatible = VkUtil_PipelineCacheCompatible(A, initial_data, initial_size);
+    if (initial_data && !compatible)
+    {
+        cgpu_warn(u8"Vulkan: pipeline cache blob was written by another device or driver, starting empty.");
+    }
     VkPipelineCacheCreateInfo info = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
         .pNext = NULL,
-        .initialDataSize = 0,
-        .pInitialData = NULL
+        .initialDataSize = compatible ? (size_t)initial_size : 0,
+        .pInitialData = compatible ? initial_data : NULL
     };
-    D->mVkDeviceTable.vkCreatePipelineCache(D->pVkDevice,
+    VkResult result = D->mVkDeviceTable.vkCreatePipelineCache(D->pVkDevice,
     &info, GLOBAL_VkAllocationCallbacks, &D->pPipelineCache);
+    if (result != VK_SUCCESS && compatible)
+    {
+        info.initialDataSize = 0;
+        info.pInitialData = NULL;
+        D->mVkDeviceTable.vkCreatePipelineCache(D->pVkDevice,
+        &info, GLOBAL_VkAllocationCallbacks, &D->pPipelineCache);
+    }
 }
 
 // Shader Reflection
@@ -45,7 +45,7 @@ void VkUtil_QueryAllAdapters(CGPUInstance_Vulkan* I,
     const char* const* device_extensions, uint32_t device_extension_count);
 
 // Device Helpers
-void VkUtil_CreatePipelineCache(CGPUDevice_Vulkan* D);
+void VkUtil_CreatePipelineCache(CGPUDevice_Vulkan* D, const void* initial_data, uint64_t initial_size);
 void VkUtil_CreateVMAAllocator(CGPUInstance_Vulkan* I, CGPUAdapter_Vulkan* A, CGPUDevice_Vulkan* D);
 void VkUtil_FreeVMAAllocator(CGPUInstance_Vulkan* I, CGPUAdapter_Vulkan* A, CGPUDevice_Vulkan* D);
 void VkUtil_FreePipelineCache(CGPUInstance_Vulkan* I, CGPUAdapter_Vulkan* A, CGPUDevice_Vulkan* D);
@@ -1,5 +1,6 @@
 #pragma once
 #include "sugoi_types.h"
+#include "SkrCore/memory/sysmem_pool.h"
 #if defined(__cplusplus)
     #include "SkrCore/log.h"
     #include "SkrTask/fib_task.hpp"
@@ -207,6 +208,14 @@ SKR_RUNTIME_API sugoi_context_t* sugoi_get_context();
  *
  */
 SKR_RUNTIME_API void sugoi_shutdown();
+/**
+ * @brief back chunk pools with a system memory pool (large/huge pages, numa local), pass NULL to go back to the default allocator
+ * cached free chunks are released. fails while chunks of the current pool are alive (storages not released), they must go back to it
+ * chunks of the default allocator may outlive the change. memory the type registry takes from the pool stays alive until shutdown
+ * @param pool must be created with thread_safe, chunks are allocated from any thread
+ * @return false if chunks of the current pool are still alive, the pool is not changed
+ */
+SKR_RUNTIME_API bool sugoi_set_chunk_memory_pool(SSysMemoryPoolId pool);
 
 SKR_RUNTIME_API void sugoi_make_guid(skr_guid_t* guid);
 
@@ -70,6 +70,27 @@ typedef struct skr_io_compressed_block_t {
 
 typedef void (*skr_io_callback_t)(skr_io_future_t* future, skr_io_request_t* request, void* data);
 
+// request tracing, disabled by default
+typedef struct skr_io_trace_desc_t {
+    bool enable                 SKR_IF_CPP(= false);
+    // log all histograms every N ms from the service thread, 0 to disable
+    uint32_t dump_interval_ms   SKR_IF_CPP(= 0);
+} skr_io_trace_desc_t;
+
+// latencies are in microseconds, percentiles are within ~6% of the exact value
+typedef struct skr_io_latency_stats_t {
+    uint64_t count   SKR_IF_CPP(= 0);
+    uint64_t min_us  SKR_IF_CPP(= 0);
+    uint64_t max_us  SKR_IF_CPP(= 0);
+    uint64_t mean_us SKR_IF_CPP(= 0);
+    uint64_t p50_us  SKR_IF_CPP(= 0);
+    uint64_t p90_us  SKR_IF_CPP(= 0);
+    uint64_t p99_us  SKR_IF_CPP(= 0);
+    uint64_t p999_us SKR_IF_CPP(= 0);
+    // records lost because a thread's trace ring was full
+    uint64_t dropped SKR_IF_CPP(= 0);
+} skr_io_latency_stats_t;
+
 #ifdef __cplusplus
 
 namespace skr
@@ -105,6 +126,7 @@ struct SKR_RUNTIME_API IIORequest : public skr::SInterface {
 
     virtual void add_callback(ESkrIOStage stage, IOCallback callback, void* data) SKR_NOEXCEPT              = 0;
     virtual void add_finish_callback(ESkrIOFinishPoint point, IOCallback callback, void* data) SKR_NOEXCEPT = 0;
+    virtual IOCallback get_callback(ESkrIOStage stage, void** data) const SKR_NOEXCEPT                     = 0;
     #pragma endregion
 };
 using IORequestId = SObjectPtr<IIORequest>;
@@ -203,6 +225,15 @@ struct SKR_RUNTIME_API IIOService {
     // get service status (sleeping or running)
     virtual SkrAsyncServiceStatus get_service_status() const SKR_NOEXCEPT = 0;
 
+    // query latency histograms gathered by the request tracer (see skr_io_trace_desc_t)
+    // stage: time spent in the stage before moving on, SKR_IO_STAGE_COUNT for enqueue -> completed/cancelled
+    // priority: SKR_ASYNC_SERVICE_PRIORITY_COUNT merges all priorities
+    // returns false if tracing is disabled
+    virtual bool query_latency(ESkrIOStage stage, SkrAsyncServicePriority priority, skr_io_latency_stats_t* stats) SKR_NOEXCEPT = 0;
+
+    // log all latency histograms
+    virtual void dump_latency() SKR_NOEXCEPT = 0;
+
     virtual ~IIOService() SKR_NOEXCEPT = default;
     IIOService() SKR_NOEXCEPT          = default;
 };
@@ -0,0 +1,42 @@
+#pragma once
+#include "SkrRT/io/io.h"
+#include "SkrTask/co_task.hpp"
+
+#if __cpp_impl_coroutine
+namespace skr
+{
+namespace io
+{
+
+// signalled from the io thread once the request is completed or cancelled,
+// so a coroutine can co_await it and no worker is parked polling the future.
+// callbacks already added for the completed & cancelled stages still run, call before the request is added to a batch
+inline skr::task2::event_t finish_event(IIORequest* request) SKR_NOEXCEPT
+{
+    struct FinishEvent {
+        skr::task2::event_t event;
+        IOCallback          callbacks[2];
+        void*               datas[2];
+    };
+    auto holder = SkrNew<FinishEvent>();
+    holder->callbacks[0] = request->get_callback(SKR_IO_STAGE_COMPLETED, &holder->datas[0]);
+    holder->callbacks[1] = request->get_callback(SKR_IO_STAGE_CANCELLED, &holder->datas[1]);
+    // exactly one of the two stages is reached, it restores the chained callbacks & frees the holder
+    auto callback = +[](skr_io_future_t* future, skr_io_request_t* request, void* data) {
+        auto holder = (FinishEvent*)data;
+        request->add_callback(SKR_IO_STAGE_COMPLETED, holder->callbacks[0], holder->datas[0]);
+        request->add_callback(SKR_IO_STAGE_CANCELLED, holder->callbacks[1], holder->datas[1]);
+        const auto i = (future->get_status() == SKR_IO_STAGE_COMPLETED) ? 0 : 1;
+        if (holder->callbacks[i])
+            holder->callbacks[i](future, request, holder->datas[i]);
+        holder->event.notify();
+        SkrDelete(holder);
+    };
+    request->add_callback(SKR_IO_STAGE_COMPLETED, callback, holder);
+    request->add_callback(SKR_IO_STAGE_CANCELLED, callback, holder);
+    return holder->event;
+}
+
+} // namespace io
+} // namespace skr
+#endif
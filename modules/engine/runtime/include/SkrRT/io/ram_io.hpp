@@ -1,6 +1,7 @@
 #pragma once
 #include "SkrRT/io/io.h"
 #include "SkrCore/blob.hpp"
+#include "SkrCore/memory/sysmem_pool.h"
 
 SKR_DECLARE_TYPE_ID_FWD(skr::io, IRAMService, skr_io_ram_service)
 
@@ -11,6 +12,9 @@ typedef struct skr_ram_io_service_desc_t {
     skr_job_queue_id callback_job_queue SKR_IF_CPP(= nullptr);
     bool awake_at_request               SKR_IF_CPP(= true);
     bool use_dstorage                   SKR_IF_CPP(= true);
+    // optional, back io buffers with a thread safe system memory pool (large pages, numa local)
+    SSysMemoryPoolId buffer_memory_pool SKR_IF_CPP(= nullptr);
+    skr_io_trace_desc_t trace;
 } skr_ram_io_service_desc_t;
 
 namespace skr
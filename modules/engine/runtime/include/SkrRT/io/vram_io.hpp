@@ -13,6 +13,7 @@ typedef struct skr_vram_io_service_desc_t {
     CGPUDeviceId gpu_device SKR_IF_CPP(= nullptr);
     bool awake_at_request SKR_IF_CPP(= true);
     bool use_dstorage SKR_IF_CPP(= true);
+    skr_io_trace_desc_t trace;
 } skr_vram_io_service_desc_t;
 
 #ifdef __cplusplus
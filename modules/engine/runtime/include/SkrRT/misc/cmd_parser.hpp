@@ -162,7 +162,7 @@ struct parser {
         {
             T result;
             auto ret = std::from_chars(value.c_str(), value.c_str() + value.size(), result);
-            if (ret.ec != 0)
+            if (ret.ec != std::errc())
             {
                 auto name = typeid(T).name();
                 SKR_LOG_ERROR(u8"failed to parse '%s' as '%s'", value.c_str(), name);
@@ -175,7 +175,7 @@ struct parser {
         {
             T result;
             auto ret = fast_float::from_chars(value.c_str(), value.c_str() + value.size(), result);
-            if (ret.ec != 0)
+            if (ret.ec != std::errc())
             {
                 auto name = typeid(T).name();
                 SKR_LOG_ERROR(u8"failed to parse '%s' as '%s'", value.c_str(), name);
@@ -61,4 +61,21 @@ void sugoi_shutdown()
     if (auto ctx = g_sugoi_ctx)
         delete ctx;
 }
+
+bool sugoi_set_chunk_memory_pool(SSysMemoryPoolId pool)
+{
+    auto ctx = sugoi_get_context();
+    ctx->smallPool.trim();
+    ctx->normalPool.trim();
+    ctx->largePool.trim();
+    if (ctx->smallPool.sysmemBlocks != 0 || ctx->normalPool.sysmemBlocks != 0 || ctx->largePool.sysmemBlocks != 0)
+    {
+        SKR_LOG_ERROR(u8"sugoi_set_chunk_memory_pool: chunks of the current pool are still alive, release their storages first.");
+        return false;
+    }
+    ctx->smallPool.set_memory_pool(pool);
+    ctx->normalPool.set_memory_pool(pool);
+    ctx->largePool.set_memory_pool(pool);
+    return true;
+}
 }
\ No newline at end of file
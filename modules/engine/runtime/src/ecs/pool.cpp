@@ -4,6 +4,7 @@
 
 #include "./pool.hpp"
 #include <numeric>
+#include <cstring>
 
 const char* kDualMemoryName = "sugoi";
 namespace sugoi
@@ -18,7 +19,7 @@ pool_t::~pool_t()
 {
     void* block;
     while (blocks.try_dequeue(block))
-        sugoi_free(block);
+        release_block(block);
 }
 
 void* pool_t::allocate()
@@ -28,7 +29,7 @@ void* pool_t::allocate()
         return block;
     {
         SkrZoneScopedN("DualPoolAllocation");
-        return sugoi_calloc(1, blockSize);
+        return allocate_block();
     }
 }
 
@@ -36,7 +37,50 @@ void pool_t::free(void* block)
 {
     if (blocks.try_enqueue(block))
         return;
-    sugoi_free(block);
+    release_block(block);
+}
+
+void pool_t::trim()
+{
+    void* block;
+    while (blocks.try_dequeue(block))
+        release_block(block);
+}
+
+bool pool_t::set_memory_pool(SSysMemoryPoolId pool)
+{
+    trim();
+    if (sysmemBlocks.load(std::memory_order_relaxed) != 0)
+        return false;
+    sysmem = pool;
+    return true;
+}
+
+void* pool_t::allocate_block()
+{
+    if (sysmem)
+    {
+        if (void* block = sakura_sysmem_pool_malloc(sysmem, blockSize))
+        {
+            sysmemBlocks.fetch_add(1, std::memory_order_relaxed);
+            memset(block, 0, blockSize);
+            return block;
+        }
+        // pool exhausted, fallback to the default allocator
+    }
+    return sugoi_calloc(1, blockSize);
+}
+
+void pool_t::release_block(void* block)
+{
+    // sysmem can't change while it owns blocks, the others come from the default allocator
+    if (sysmem && sakura_sysmem_pool_contains(sysmem, block))
+    {
+        sakura_sysmem_pool_free(sysmem, block);
+        sysmemBlocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+    else
+        sugoi_free(block);
 }
 
 fixed_pool_t::fixed_pool_t(size_t blockSize, size_t blockCount)
@@ -1,5 +1,7 @@
 #pragma once
 #include "SkrContainers/concurrent_queue.hpp"
+#include "SkrCore/memory/sysmem_pool.h"
+#include <atomic>
 
 namespace sugoi
 {
@@ -14,10 +16,22 @@ struct ECSPoolConcurrentQueueTraits : public skr::ConcurrentQueueDefaultTraits
 struct pool_t {
     size_t blockSize;
     skr::ConcurrentQueue<void*, ECSPoolConcurrentQueueTraits> blocks;
+    SSysMemoryPoolId sysmem = nullptr;
+    // blocks taken from sysmem & not given back yet, sysmem can't change while any of them is alive
+    std::atomic<int64_t> sysmemBlocks = 0;
     pool_t(size_t blockSize, size_t blockCount);
     ~pool_t();
     void* allocate();
     void free(void* block);
+    // releases the cached free blocks
+    void trim();
+    // not thread safe, call when no other thread is allocating from this pool.
+    // fails while blocks of the current sysmem pool are alive, blocks of the default allocator can outlive a change
+    bool set_memory_pool(SSysMemoryPoolId pool);
+
+private:
+    void* allocate_block();
+    void release_block(void* block);
 };
 
 pool_t& get_default_pool();
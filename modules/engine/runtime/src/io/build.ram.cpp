@@ -1,6 +1,7 @@
 
 #include "io.cpp"
 #include "common/io_runner.cpp"
+#include "common/io_trace.cpp"
 #include "common/io_resolver.cpp"
 
 #include "components/components.cpp"
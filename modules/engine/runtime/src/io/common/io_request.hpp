@@ -141,6 +141,11 @@ public:
         safe_comp<IOStatusComponent>()->add_finish_callback(point, callback, data);
     }
 
+    IOCallback get_callback(ESkrIOStage stage, void** data) const SKR_NOEXCEPT
+    {
+        return safe_comp<IOStatusComponent>()->get_callback(stage, data);
+    }
+
     skr::span<skr_io_block_t> get_blocks() SKR_NOEXCEPT 
     { 
         return safe_comp<BlocksComponent>()->get_blocks(); 
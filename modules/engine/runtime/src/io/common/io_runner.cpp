@@ -17,7 +17,14 @@ RunnerBase::RunnerBase(const ServiceThreadDesc& desc, skr::JobQueue* job_queue)
 
 RunnerBase::~RunnerBase() SKR_NOEXCEPT
 {
+    if (tracer)
+        SkrDelete(tracer);
+}
 
+void RunnerBase::enable_trace(const skr_io_trace_desc_t& desc, const char8_t* name) SKR_NOEXCEPT
+{
+    SKR_ASSERT(!tracer && "trace already enabled!");
+    tracer = SkrNew<IORequestTracer>(desc, name);
 }
 
 void RunnerBase::poll_finish_callbacks() SKR_NOEXCEPT
@@ -253,6 +260,9 @@ void RunnerBase::dispatch_complete_(SkrAsyncServicePriority priority, IORequestI
 
 skr::AsyncResult RunnerBase::serve() SKR_NOEXCEPT
 {
+    if (tracer)
+        tracer->tick();
+
     if (!predicate())
     {
         setServiceStatus(SKR_ASYNC_SERVICE_STATUS_SLEEPING);
@@ -364,8 +374,12 @@ bool RunnerBase::complete_(IIORequest* rq, SkrAsyncServicePriority priority) SKR
 {
     if (auto pStatus = io_component<IOStatusComponent>(rq))
     {
-        SKR_ASSERT(pStatus->getStatus() == SKR_IO_STAGE_LOADED);
-        pStatus->setStatus(SKR_IO_STAGE_COMPLETED);
+        // readers cancel the requests they failed to load, those finish as cancelled
+        if (pStatus->getStatus() != SKR_IO_STAGE_CANCELLED)
+        {
+            SKR_ASSERT(pStatus->getStatus() == SKR_IO_STAGE_LOADED);
+            pStatus->setStatus(SKR_IO_STAGE_COMPLETED);
+        }
         if (pStatus->needPollFinish())
         {
             finish_queues[priority].enqueue(rq);
@@ -2,6 +2,7 @@
 #include "SkrContainers/stl_vector.hpp"
 #include "SkrCore/async/async_service.h"
 #include "io_request.hpp"
+#include "io_trace.hpp"
 #include <utility>
 
 namespace skr { template <typename Artifact> struct IFuture; struct JobQueue; }
@@ -19,6 +20,9 @@ struct RunnerBase : public AsyncService
     uint64_t processing_count(SkrAsyncServicePriority priority = SKR_ASYNC_SERVICE_PRIORITY_COUNT) const SKR_NOEXCEPT;
     void poll_finish_callbacks() SKR_NOEXCEPT;
 
+    void enable_trace(const skr_io_trace_desc_t& desc, const char8_t* name) SKR_NOEXCEPT;
+    IORequestTracer* get_tracer() const SKR_NOEXCEPT { return tracer; }
+
     virtual void drain(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
     virtual void drain() SKR_NOEXCEPT;
     virtual void destroy() SKR_NOEXCEPT;
@@ -32,6 +36,7 @@ protected:
     skr::stl_vector<IOBatchProcessorId> batch_processors; 
     skr::stl_vector<IORequestProcessorId> request_processors; 
     SAtomic64 processing_request_counts[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    IORequestTracer* tracer = nullptr;
 
 private:
     void phaseRecycle() SKR_NOEXCEPT;
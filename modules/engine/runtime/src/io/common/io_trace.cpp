@@ -0,0 +1,330 @@
+#include "SkrBase/misc/bit.hpp"
+#include "SkrCore/log.h"
+#include "SkrCore/time.h"
+#include "SkrCore/memory/memory.h"
+#include "SkrProfile/profile.h"
+#include "io_trace.hpp"
+
+namespace skr {
+namespace io {
+
+static constexpr const char* kTraceStageNames[] = {
+    "none",
+    "enqueued",
+    "resolving",
+    "loading",
+    "loaded",
+    "decompressing",
+    "decompressed",
+    "completed",
+    "cancelled",
+    "total"
+};
+static_assert(sizeof(kTraceStageNames) / sizeof(kTraceStageNames[0]) == SKR_IO_STAGE_COUNT + 1, "kTraceStageNames size mismatch");
+
+static constexpr const char* kTracePriorityNames[] = { "urgent", "normal", "low", "all" };
+static_assert(sizeof(kTracePriorityNames) / sizeof(kTracePriorityNames[0]) == SKR_ASYNC_SERVICE_PRIORITY_COUNT + 1, "kTracePriorityNames size mismatch");
+
+#pragma region IOLatencyHistogram
+
+uint32_t IOLatencyHistogram::bucket_index(uint64_t us) SKR_NOEXCEPT
+{
+    constexpr uint64_t kMaxValue = (1ull << (kMaxMagnitude + 1)) - 1;
+    if (us > kMaxValue)
+        us = kMaxValue;
+    if (us < kSubBucketCount)
+        return (uint32_t)us;
+    const uint32_t shift = (uint32_t)skr::bit_floor_log2(us) - kSubBucketBits;
+    return (shift + 1) * kSubBucketCount + (uint32_t)((us >> shift) - kSubBucketCount);
+}
+
+uint64_t IOLatencyHistogram::bucket_upper(uint32_t index) SKR_NOEXCEPT
+{
+    const uint32_t magnitude = index / kSubBucketCount;
+    if (magnitude == 0)
+        return index;
+    const uint64_t sub = index % kSubBucketCount;
+    return ((kSubBucketCount + sub + 1) << (magnitude - 1)) - 1;
+}
+
+void IOLatencyHistogram::record(uint64_t us) SKR_NOEXCEPT
+{
+    buckets[bucket_index(us)] += 1;
+    count += 1;
+    sum += us;
+    min = (us < min) ? us : min;
+    max = (us > max) ? us : max;
+}
+
+void IOLatencyHistogram::merge(const IOLatencyHistogram& other) SKR_NOEXCEPT
+{
+    for (uint32_t i = 0; i < kBucketCount; i++)
+        buckets[i] += other.buckets[i];
+    count += other.count;
+    sum += other.sum;
+    min = (other.min < min) ? other.min : min;
+    max = (other.max > max) ? other.max : max;
+}
+
+uint64_t IOLatencyHistogram::percentile(double p) const SKR_NOEXCEPT
+{
+    if (!count) return 0;
+    uint64_t target = (uint64_t)(p * (double)count + 0.5);
+    target = (target < 1) ? 1 : ((target > count) ? count : target);
+    uint64_t accumulated = 0;
+    for (uint32_t i = 0; i < kBucketCount; i++)
+    {
+        accumulated += buckets[i];
+        if (accumulated >= target)
+        {
+            const uint64_t upper = bucket_upper(i);
+            return (upper > max) ? max : upper;
+        }
+    }
+    return max;
+}
+
+void IOLatencyHistogram::get_stats(skr_io_latency_stats_t* stats) const SKR_NOEXCEPT
+{
+    stats->count = count;
+    stats->min_us = count ? min : 0;
+    stats->max_us = max;
+    stats->mean_us = count ? (sum / count) : 0;
+    stats->p50_us = percentile(0.5);
+    stats->p90_us = percentile(0.9);
+    stats->p99_us = percentile(0.99);
+    stats->p999_us = percentile(0.999);
+}
+
+#pragma endregion
+
+#pragma region IORequestTracer
+
+static SAtomicU64 tracer_serial = 1;
+
+IORequestTracer::IORequestTracer(const skr_io_trace_desc_t& desc, const char8_t* name) SKR_NOEXCEPT
+    : name(name),
+      dump_interval_ms(desc.dump_interval_ms),
+      serial(skr_atomic_fetch_add_relaxed(&tracer_serial, 1))
+{
+    skr_init_mutex(&rings_mutex);
+    skr_init_mutex(&collect_mutex);
+    last_dump_us = skr_sys_get_usec(false);
+}
+
+IORequestTracer::~IORequestTracer() SKR_NOEXCEPT
+{
+    for (auto ring : rings)
+        SkrDelete(ring);
+    skr_destroy_mutex(&collect_mutex);
+    skr_destroy_mutex(&rings_mutex);
+}
+
+IOTraceRing* IORequestTracer::acquire_ring() SKR_NOEXCEPT
+{
+    // services come and go, cache by serial so a recycled tracer address never hits a stale ring
+    struct RingCache
+    {
+        uint64_t serial = 0;
+        IOTraceRing* ring = nullptr;
+    };
+    static constexpr uint32_t kCacheSize = 4;
+    thread_local RingCache caches[kCacheSize];
+
+    auto& cache = caches[serial % kCacheSize];
+    if (cache.serial == serial)
+        return cache.ring;
+
+    const auto tid = skr_current_thread_id();
+    IOTraceRing* ring = nullptr;
+    {
+        SMutexLock _(rings_mutex);
+        for (auto r : rings)
+        {
+            if (r->thread == tid)
+            {
+                ring = r;
+                break;
+            }
+        }
+        if (!ring)
+        {
+            ring = SkrNew<IOTraceRing>();
+            ring->thread = tid;
+            rings.push_back(ring);
+        }
+    }
+    cache.serial = serial;
+    cache.ring = ring;
+    return ring;
+}
+
+void IORequestTracer::record(uint32_t request, ESkrIOStage stage, SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    IOTraceRecord record;
+    record.timestamp = (uint64_t)skr_sys_get_usec(true);
+    record.request = request;
+    record.stage = (uint8_t)stage;
+    record.priority = (uint8_t)priority;
+    record.padding = 0;
+    if (!acquire_ring()->push(record))
+        skr_atomic_fetch_add_relaxed(&dropped, 1);
+}
+
+void IORequestTracer::finalize(const InFlight& req) SKR_NOEXCEPT
+{
+    const auto priority = req.priority;
+    // time in stage = enter of the next recorded stage - enter of this stage
+    uint32_t prev = SKR_IO_STAGE_COUNT;
+    for (uint32_t s = SKR_IO_STAGE_ENQUEUED; s < SKR_IO_STAGE_COUNT; s++)
+    {
+        if (!req.timestamps[s]) continue;
+        if (prev != SKR_IO_STAGE_COUNT && req.timestamps[s] >= req.timestamps[prev])
+            histograms[prev][priority].record(req.timestamps[s] - req.timestamps[prev]);
+        prev = s;
+    }
+    const uint64_t enqueued = req.timestamps[SKR_IO_STAGE_ENQUEUED];
+    const uint64_t finished = req.timestamps[SKR_IO_STAGE_COMPLETED] ?
+        req.timestamps[SKR_IO_STAGE_COMPLETED] : req.timestamps[SKR_IO_STAGE_CANCELLED];
+    if (enqueued && finished >= enqueued)
+        histograms[SKR_IO_STAGE_COUNT][priority].record(finished - enqueued);
+}
+
+void IORequestTracer::collect() SKR_NOEXCEPT
+{
+    SkrZoneScopedN("IORequestTracer::Collect");
+
+    // records of one request may sit in several rings, a finished request is kept one more
+    // collect so transitions pushed by other threads right before completion still get in
+    collect_tick += 1;
+    {
+        SMutexLock _(rings_mutex);
+        for (auto ring : rings)
+        {
+            ring->consume([this](const IOTraceRecord& record) {
+                pending.push_back(record);
+            });
+        }
+    }
+    // only the enqueue record opens a request, so late records of finalized requests
+    // (or of requests whose enqueue record was dropped) cannot bring them back
+    for (const auto& record : pending)
+    {
+        if (record.stage == SKR_IO_STAGE_ENQUEUED)
+            in_flight[record.request];
+    }
+    for (const auto& record : pending)
+    {
+        auto found = in_flight.find(record.request);
+        if (found == in_flight.end())
+            continue;
+        auto& req = found->second;
+        req.timestamps[record.stage] = record.timestamp;
+        req.priority = record.priority;
+        if (record.stage == SKR_IO_STAGE_COMPLETED || record.stage == SKR_IO_STAGE_CANCELLED)
+        {
+            if (req.finish_tick == UINT32_MAX)
+                finished.push_back(record.request);
+            req.finish_tick = collect_tick;
+        }
+    }
+    pending.clear();
+    auto it = std::remove_if(finished.begin(), finished.end(), [this](uint32_t id) {
+        auto found = in_flight.find(id);
+        if (found == in_flight.end())
+            return true;
+        if (found->second.finish_tick >= collect_tick)
+            return false;
+        finalize(found->second);
+        in_flight.erase(found);
+        return true;
+    });
+    finished.erase(it, finished.end());
+}
+
+void IORequestTracer::tick() SKR_NOEXCEPT
+{
+    bool need_dump = false;
+    {
+        SMutexLock _(collect_mutex);
+        collect();
+        if (dump_interval_ms)
+        {
+            const auto now = skr_sys_get_usec(false);
+            if (now - last_dump_us >= (int64_t)dump_interval_ms * 1000)
+            {
+                last_dump_us = now;
+                need_dump = true;
+            }
+        }
+    }
+    if (need_dump)
+        dump();
+}
+
+void IORequestTracer::get_stats(uint32_t stage, uint32_t priority, skr_io_latency_stats_t* stats) const SKR_NOEXCEPT
+{
+    if (priority == SKR_ASYNC_SERVICE_PRIORITY_COUNT)
+    {
+        IOLatencyHistogram merged;
+        for (uint32_t i = 0; i < SKR_ASYNC_SERVICE_PRIORITY_COUNT; i++)
+            merged.merge(histograms[stage][i]);
+        merged.get_stats(stats);
+    }
+    else
+    {
+        histograms[stage][priority].get_stats(stats);
+    }
+    stats->dropped = skr_atomic_load_relaxed(&dropped);
+}
+
+bool IORequestTracer::query(ESkrIOStage stage, SkrAsyncServicePriority priority, skr_io_latency_stats_t* stats) SKR_NOEXCEPT
+{
+    if (stage > SKR_IO_STAGE_COUNT || priority > SKR_ASYNC_SERVICE_PRIORITY_COUNT)
+        return false;
+
+    SMutexLock _(collect_mutex);
+    // second pass finalizes requests finished in the first one
+    collect();
+    collect();
+    get_stats(stage, priority, stats);
+    return true;
+}
+
+void IORequestTracer::dump() SKR_NOEXCEPT
+{
+    // every row from the same drain, logged once the collector is released
+    skr_io_latency_stats_t table[SKR_IO_STAGE_COUNT + 1][SKR_ASYNC_SERVICE_PRIORITY_COUNT + 1] = {};
+    {
+        SMutexLock _(collect_mutex);
+        collect();
+        collect();
+        for (uint32_t s = SKR_IO_STAGE_ENQUEUED; s <= SKR_IO_STAGE_COUNT; s++)
+        {
+            for (uint32_t p = 0; p <= SKR_ASYNC_SERVICE_PRIORITY_COUNT; p++)
+                get_stats(s, p, &table[s][p]);
+        }
+    }
+
+    SKR_LOG_INFO(u8"%s: io latency (us), %llu trace records dropped",
+        (const char*)name.u8_str(), (unsigned long long)table[SKR_IO_STAGE_COUNT][SKR_ASYNC_SERVICE_PRIORITY_COUNT].dropped);
+    for (uint32_t s = SKR_IO_STAGE_ENQUEUED; s <= SKR_IO_STAGE_COUNT; s++)
+    {
+        for (uint32_t p = 0; p <= SKR_ASYNC_SERVICE_PRIORITY_COUNT; p++)
+        {
+            const auto& stats = table[s][p];
+            if (!stats.count) continue;
+            SKR_LOG_INFO(u8"  %-13s %-6s count %8llu | min %8llu | mean %8llu | p50 %8llu | p90 %8llu | p99 %8llu | p999 %8llu | max %8llu",
+                kTraceStageNames[s], kTracePriorityNames[p],
+                (unsigned long long)stats.count, (unsigned long long)stats.min_us,
+                (unsigned long long)stats.mean_us, (unsigned long long)stats.p50_us,
+                (unsigned long long)stats.p90_us, (unsigned long long)stats.p99_us,
+                (unsigned long long)stats.p999_us, (unsigned long long)stats.max_us);
+        }
+    }
+}
+
+#pragma endregion
+
+} // namespace io
+} // namespace skr
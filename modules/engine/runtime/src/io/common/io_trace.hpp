@@ -0,0 +1,134 @@
+#pragma once
+#include "SkrRT/io/io.h"
+#include "SkrOS/thread.h"
+#include "SkrContainers/stl_vector.hpp"
+#include "SkrContainers/hashmap.hpp"
+#include "SkrContainers/string.hpp"
+
+namespace skr {
+namespace io {
+
+// one stage transition of one request, 16 bytes
+struct IOTraceRecord
+{
+    uint64_t timestamp; // usec
+    uint32_t request;   // trace id, assigned at enqueue
+    uint8_t stage;
+    uint8_t priority;
+    uint16_t padding;
+};
+static_assert(sizeof(IOTraceRecord) == 16, "IOTraceRecord should stay compact");
+
+// single producer (owner thread) / single consumer (collector) ring
+struct IOTraceRing
+{
+    static constexpr uint32_t kCapacity = 4096;
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "capacity must be power of 2");
+
+    bool push(const IOTraceRecord& record) SKR_NOEXCEPT
+    {
+        const uint32_t h = skr_atomic_load_relaxed(&head);
+        const uint32_t t = skr_atomic_load_acquire(&tail);
+        if (h - t >= kCapacity)
+            return false;
+        records[h & (kCapacity - 1)] = record;
+        skr_atomic_store_release(&head, h + 1);
+        return true;
+    }
+
+    template <typename F>
+    void consume(F&& f) SKR_NOEXCEPT
+    {
+        const uint32_t t = skr_atomic_load_relaxed(&tail);
+        const uint32_t h = skr_atomic_load_acquire(&head);
+        for (uint32_t i = t; i != h; ++i)
+            f(records[i & (kCapacity - 1)]);
+        skr_atomic_store_release(&tail, h);
+    }
+
+    SThreadID thread = 0;
+    SAtomicU32 head = 0;
+    SAtomicU32 tail = 0;
+    IOTraceRecord records[kCapacity];
+};
+
+// HDR-style log-linear histogram:
+// values below 2^kSubBucketBits are exact, above that each power of 2 is split into 2^kSubBucketBits linear buckets
+struct IOLatencyHistogram
+{
+    static constexpr uint32_t kSubBucketBits = 4;
+    static constexpr uint32_t kSubBucketCount = 1u << kSubBucketBits;
+    static constexpr uint32_t kMaxMagnitude = 40; // 2^40 us, ~12 days
+    static constexpr uint32_t kBucketCount = (kMaxMagnitude - kSubBucketBits + 2) * kSubBucketCount;
+
+    void record(uint64_t us) SKR_NOEXCEPT;
+    void merge(const IOLatencyHistogram& other) SKR_NOEXCEPT;
+    uint64_t percentile(double p) const SKR_NOEXCEPT;
+    void get_stats(skr_io_latency_stats_t* stats) const SKR_NOEXCEPT;
+
+    static uint32_t bucket_index(uint64_t us) SKR_NOEXCEPT;
+    static uint64_t bucket_upper(uint32_t index) SKR_NOEXCEPT;
+
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    uint32_t buckets[kBucketCount] = { 0 };
+};
+
+struct IORequestTracer
+{
+    IORequestTracer(const skr_io_trace_desc_t& desc, const char8_t* name) SKR_NOEXCEPT;
+    ~IORequestTracer() SKR_NOEXCEPT;
+
+    uint32_t new_request() SKR_NOEXCEPT
+    {
+        return (uint32_t)skr_atomic_fetch_add_relaxed(&request_sequence, 1);
+    }
+
+    // called from any thread on every stage transition
+    void record(uint32_t request, ESkrIOStage stage, SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+
+    // drain rings into histograms and dump periodically, called from the service thread
+    void tick() SKR_NOEXCEPT;
+
+    bool query(ESkrIOStage stage, SkrAsyncServicePriority priority, skr_io_latency_stats_t* stats) SKR_NOEXCEPT;
+    void dump() SKR_NOEXCEPT;
+
+private:
+    struct InFlight
+    {
+        uint64_t timestamps[SKR_IO_STAGE_COUNT] = { 0 };
+        uint32_t finish_tick = UINT32_MAX;
+        uint8_t priority = 0;
+    };
+
+    IOTraceRing* acquire_ring() SKR_NOEXCEPT;
+    void collect() SKR_NOEXCEPT;
+    void finalize(const InFlight& req) SKR_NOEXCEPT;
+    // stats of the collected histograms, collect_mutex held
+    void get_stats(uint32_t stage, uint32_t priority, skr_io_latency_stats_t* stats) const SKR_NOEXCEPT;
+
+    const skr::String name;
+    const uint32_t dump_interval_ms = 0;
+    const uint64_t serial = 0;
+    SAtomicU32 request_sequence = 0;
+    SAtomicU64 dropped = 0;
+
+    // guards rings registration
+    SMutex rings_mutex;
+    skr::stl_vector<IOTraceRing*> rings;
+
+    // guards everything below, held by the collector
+    SMutex collect_mutex;
+    uint32_t collect_tick = 0;
+    int64_t last_dump_us = 0;
+    skr::FlatHashMap<uint32_t, InFlight> in_flight;
+    skr::stl_vector<uint32_t> finished;
+    skr::stl_vector<IOTraceRecord> pending; // records drained by the current collect
+    // [stage][priority], stage SKR_IO_STAGE_COUNT holds end to end latencies
+    IOLatencyHistogram histograms[SKR_IO_STAGE_COUNT + 1][SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+};
+
+} // namespace io
+} // namespace skr
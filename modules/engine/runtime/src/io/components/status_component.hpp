@@ -1,6 +1,7 @@
 #pragma once
 #include "SkrRT/io/io.h"
 #include "../components/component.hpp"
+#include "../common/io_trace.hpp"
 
 #include "SkrProfile/profile.h"
 
@@ -52,6 +53,12 @@ public:
         finish_callback_datas[point] = data;
     }
 
+    skr_io_callback_t get_callback(ESkrIOStage stage, void** data) const SKR_NOEXCEPT
+    {
+        *data = callbacks[stage] ? callback_datas[stage] : nullptr;
+        return callbacks[stage];
+    }
+
     virtual ESkrIOStage getStatus() const SKR_NOEXCEPT
     {
         return static_cast<ESkrIOStage>(skr_atomic_load_relaxed(&future->status));
@@ -94,9 +101,18 @@ public:
         return false;
     }
 
+    void setTracer(IORequestTracer* tracer, SkrAsyncServicePriority priority) SKR_NOEXCEPT
+    {
+        this->tracer = tracer;
+        trace_id = tracer->new_request();
+        trace_priority = priority;
+    }
+
     virtual void setStatus(ESkrIOStage status) SKR_NOEXCEPT
     {
         skr_atomic_store_release(&future->status, status);
+        if (tracer)
+            tracer->record(trace_id, status, trace_priority);
         if (const auto callback = callbacks[status])
         {
             SkrZoneScoped;
@@ -118,6 +134,10 @@ protected:
     bool async_cancel = false;
     IIOBatch* owner_batch = nullptr; // avoid circular reference
 
+    IORequestTracer* tracer = nullptr; // only set when the service traces requests
+    uint32_t trace_id = 0;
+    SkrAsyncServicePriority trace_priority = SKR_ASYNC_SERVICE_PRIORITY_NORMAL;
+
     skr_io_future_t* future = nullptr;
     SAtomic32 finish_step = 0;
     skr_io_callback_t callbacks[SKR_IO_STAGE_COUNT] = { nullptr };
@@ -13,7 +13,7 @@ struct SKR_RUNTIME_API RAMIOBuffer : public IRAMIOBuffer
     uint8_t* get_data() const SKR_NOEXCEPT { return bytes; }
     uint64_t get_size() const SKR_NOEXCEPT { return size; }
 
-    void allocate_buffer(uint64_t n) SKR_NOEXCEPT;
+    void allocate_buffer(uint64_t n, SSysMemoryPoolId memory_pool = nullptr) SKR_NOEXCEPT;
     void free_buffer() SKR_NOEXCEPT;
 
 public:
@@ -31,6 +31,7 @@ public:
 protected:
     uint8_t* bytes = nullptr;
     uint64_t size = 0;
+    SSysMemoryPoolId memory_pool = nullptr;
     RAMIOBuffer(ISmartPoolPtr<IRAMIOBuffer> pool) 
         : pool(pool)
     {
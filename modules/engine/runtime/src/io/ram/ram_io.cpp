@@ -18,11 +18,19 @@ RAMIOBuffer::~RAMIOBuffer() SKR_NOEXCEPT
     free_buffer();
 }
 
-void RAMIOBuffer::allocate_buffer(uint64_t n) SKR_NOEXCEPT
+void RAMIOBuffer::allocate_buffer(uint64_t n, SSysMemoryPoolId pool) SKR_NOEXCEPT
 {
     if (n)
     {
-        bytes = (uint8_t*)sakura_mallocN(n, kIOBufferMemoryName);
+        if (pool)
+        {
+            bytes = (uint8_t*)sakura_sysmem_pool_malloc(pool, n);
+            memory_pool = bytes ? pool : nullptr;
+        }
+        if (!bytes)
+        {
+            bytes = (uint8_t*)sakura_mallocN(n, kIOBufferMemoryName);
+        }
     }
     size = n;
 }
@@ -31,8 +39,12 @@ void RAMIOBuffer::free_buffer() SKR_NOEXCEPT
 {
     if (bytes)
     {
-        sakura_freeN(bytes, kIOBufferMemoryName);
+        if (memory_pool)
+            sakura_sysmem_pool_free(memory_pool, bytes);
+        else
+            sakura_freeN(bytes, kIOBufferMemoryName);
         bytes = nullptr;
+        memory_pool = nullptr;
     }
     size = 0;
 }
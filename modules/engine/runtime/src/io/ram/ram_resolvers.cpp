@@ -5,6 +5,12 @@
 namespace skr {
 namespace io {
 
+AllocateIOBufferResolver::AllocateIOBufferResolver(SSysMemoryPoolId memory_pool) SKR_NOEXCEPT
+    : memory_pool(memory_pool)
+{
+
+}
+
 void AllocateIOBufferResolver::resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT
 {
     SkrZoneScopedNC("IOBuffer::Allocate", tracy::Color::BlueViolet);
@@ -33,7 +39,7 @@ void AllocateIOBufferResolver::resolve(SkrAsyncServicePriority priority, IOBatch
         {
             SKR_ASSERT(0 && "invalid destination size");
         }
-        buf->allocate_buffer(buf->size);
+        buf->allocate_buffer(buf->size, memory_pool);
     }
 }
 
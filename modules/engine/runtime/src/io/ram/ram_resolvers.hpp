@@ -6,7 +6,10 @@ namespace io {
 
 struct AllocateIOBufferResolver final : public IORequestResolverBase
 {
+    AllocateIOBufferResolver(SSysMemoryPoolId memory_pool = nullptr) SKR_NOEXCEPT;
     void resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT;
+
+    const SSysMemoryPoolId memory_pool = nullptr;
 };
 
 struct ChunkingVFSReadResolver : public IORequestResolverBase
@@ -34,6 +34,7 @@ uint32_t RAMService::global_idx = 0;
 RAMService::RAMService(const skr_ram_io_service_desc_t* desc) SKR_NOEXCEPT
     : name(desc->name ? skr::String(desc->name) : skr::format(u8"RAMService-{}", global_idx++)), 
       awake_at_request(desc->awake_at_request),
+      buffer_memory_pool(desc->buffer_memory_pool),
       runner(this, desc->callback_job_queue)
 {
     request_pool = SmartPoolPtr<RAMRequestMixin, IBlocksRAMRequest>::Create(kIOPoolObjectsMemoryName);
@@ -45,6 +46,8 @@ RAMService::RAMService(const skr_ram_io_service_desc_t* desc) SKR_NOEXCEPT
     runner.vfs_reader = RAMUtils::CreateReader(this, desc);
 
     runner.set_resolvers();
+    if (desc->trace.enable)
+        runner.enable_trace(desc->trace, name.u8_str());
 
     if (!desc->awake_at_request)
     {
@@ -148,6 +151,19 @@ void RAMService::poll_finish_callbacks() SKR_NOEXCEPT
     runner.poll_finish_callbacks();
 }
 
+bool RAMService::query_latency(ESkrIOStage stage, SkrAsyncServicePriority priority, skr_io_latency_stats_t* stats) SKR_NOEXCEPT
+{
+    if (auto tracer = runner.get_tracer())
+        return tracer->query(stage, priority, stats);
+    return false;
+}
+
+void RAMService::dump_latency() SKR_NOEXCEPT
+{
+    if (auto tracer = runner.get_tracer())
+        tracer->dump();
+}
+
 RAMService::Runner::Runner(RAMService* service, skr::JobQueue* job_queue) SKR_NOEXCEPT
     : RunnerBase({ service->name.u8_str(), SKR_THREAD_ABOVE_NORMAL }, job_queue),
     service(service)
@@ -164,6 +180,8 @@ void RAMService::Runner::enqueueBatch(const IOBatchId& batch) SKR_NOEXCEPT
         {
             auto status = pStatus->getStatus();
             SKR_ASSERT(status == SKR_IO_STAGE_NONE);
+            if (tracer)
+                pStatus->setTracer(tracer, priority);
             pStatus->setStatus(SKR_IO_STAGE_ENQUEUED);
         }
     }
@@ -173,7 +191,7 @@ void RAMService::Runner::enqueueBatch(const IOBatchId& batch) SKR_NOEXCEPT
 
 void RAMService::Runner::set_resolvers() SKR_NOEXCEPT
 {
-    auto alloc_buffer = SObjectPtr<AllocateIOBufferResolver>::Create();
+    auto alloc_buffer = SObjectPtr<AllocateIOBufferResolver>::Create(service->buffer_memory_pool);
     auto chain = skr::static_pointer_cast<IORequestResolverChain>(IIORequestResolverChain::Create());
     chain->runner = this;
 
@@ -27,6 +27,8 @@ struct RAMService final : public IRAMService
     void set_sleep_time(uint32_t time) SKR_NOEXCEPT;
     SkrAsyncServiceStatus get_service_status() const SKR_NOEXCEPT;
     void poll_finish_callbacks() SKR_NOEXCEPT;
+    bool query_latency(ESkrIOStage stage, SkrAsyncServicePriority priority, skr_io_latency_stats_t* stats) SKR_NOEXCEPT;
+    void dump_latency() SKR_NOEXCEPT;
 
     struct Runner final : public RunnerBase
     {
@@ -42,6 +44,7 @@ struct RAMService final : public IRAMService
     };
     const skr::String name;
     const bool awake_at_request = false;
+    const SSysMemoryPoolId buffer_memory_pool = nullptr;
     Runner runner;
     
     SmartPoolPtr<RAMRequestMixin, IBlocksRAMRequest> request_pool = nullptr;
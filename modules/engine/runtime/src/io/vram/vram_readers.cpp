@@ -1,6 +1,7 @@
 #include "SkrBase/misc/debug.h" 
 #include "SkrBase/misc/make_zeroed.hpp"
 #include "SkrBase/misc/defer.hpp"
+#include "SkrCore/log.h"
 #include "vram_readers.hpp"
 #include <tuple>
 
@@ -10,6 +11,33 @@
 namespace skr {
 namespace io {
 
+// rows of a mip in block units, texture files store their mips tightly packed one after another, mip 0 first
+struct VRAMTextureMipFootprint
+{
+    uint64_t row_bytes = 0;
+    uint64_t row_pitch = 0;
+    uint64_t rows = 0;
+};
+
+static VRAMTextureMipFootprint VRAMTextureMipRows(const CGPUTextureInfo* info, uint32_t mip, uint64_t row_align) SKR_NOEXCEPT
+{
+    const auto width = (info->width >> mip) ? (info->width >> mip) : 1;
+    const auto height = (info->height >> mip) ? (info->height >> mip) : 1;
+    const auto blockW = FormatUtil_WidthOfBlock(info->format);
+    const auto blockH = FormatUtil_HeightOfBlock(info->format);
+    VRAMTextureMipFootprint footprint = {};
+    footprint.row_bytes = ((width + blockW - 1) / blockW) * (FormatUtil_BitSizeOfBlock(info->format) / 8);
+    footprint.row_pitch = (footprint.row_bytes + row_align - 1) / row_align * row_align;
+    footprint.rows = (height + blockH - 1) / blockH;
+    return footprint;
+}
+
+static uint64_t VRAMTextureMipSize(const CGPUTextureInfo* info, uint32_t mip) SKR_NOEXCEPT
+{
+    const auto footprint = VRAMTextureMipRows(info, mip, 1);
+    return footprint.row_bytes * footprint.rows;
+}
+
 SwapableCmdPool::RC::RC() SKR_NOEXCEPT
 {
 
@@ -378,7 +406,29 @@ void CommonVRAMReader::addUploadRequests(SkrAsyncServicePriority priority) SKR_N
             }
             else if (auto pTexture = io_component<VRAMTextureComponent>(vram_request.get()))
             {
+                const auto pInfo = pTexture->texture->info;
+                const auto device = cmdqueue->device;
+                const auto pDetail = cgpu_query_adapter_detail(device->adapter);
+                // d3d12 copies read rows at an aligned pitch from aligned offsets, vulkan copies read tightly packed rows
+                const bool pitched = (device->adapter->instance->backend == CGPU_BACKEND_D3D12);
+                const uint64_t row_align = (pitched && pDetail->upload_buffer_texture_row_alignment) ? pDetail->upload_buffer_texture_row_alignment : 1;
+                const uint64_t mip_align = pDetail->upload_buffer_texture_alignment ? pDetail->upload_buffer_texture_alignment : 1;
+                uint64_t src_size = 0, upload_size = 0;
+                for (uint32_t mip = 0; mip < pInfo->mip_levels; mip++)
+                {
+                    const auto footprint = VRAMTextureMipRows(pInfo, mip, row_align);
+                    upload_size = (upload_size + mip_align - 1) / mip_align * mip_align;
+                    upload_size += footprint.row_pitch * footprint.rows;
+                    src_size += footprint.row_bytes * footprint.rows;
+                }
                 CGPUBufferId upload_buffer = nullptr;
+                if (src_size > pUpload->src_size)
+                {
+                    SKR_LOG_ERROR(u8"VRAMReader: texture data is truncated, %llu bytes for %u mips but only %llu bytes are loaded",
+                        src_size, pInfo->mip_levels, pUpload->src_size);
+                    io_component<IOStatusComponent>(vram_request.get())->setStatus(SKR_IO_STAGE_CANCELLED);
+                }
+                else
                 {
                     // prepare upload buffer
                     SkrZoneScopedN("PrepareUploadBuffer");
@@ -389,23 +439,43 @@ void CommonVRAMReader::addUploadRequests(SkrAsyncServicePriority priority) SKR_N
 #endif
                     skr::String name = /*pBuffer->name ? buffer_io.vbuffer.buffer_name :*/ u8"";
                     name += u8"-upload";
-                    upload_buffer = cgpux_create_mapped_upload_buffer(cmdqueue->device, pUpload->src_size, name.u8_str());
+                    upload_buffer = cgpux_create_mapped_upload_buffer(device, upload_size, name.u8_str());
                     cmd.upload_buffers.emplace(upload_buffer);
-
-                    memcpy(upload_buffer->info->cpu_mapped_address, pUpload->src_data, pUpload->src_size);
                 }
                 if (upload_buffer)
                 {
-                    CGPUBufferToTextureTransfer tex_cpy = {};
-                    tex_cpy.dst = pTexture->texture;
-                    tex_cpy.dst_subresource.aspects = CGPU_TVA_COLOR;
-                    // TODO: texture array & mips
-                    tex_cpy.dst_subresource.base_array_layer = 0;
-                    tex_cpy.dst_subresource.layer_count = 1;
-                    tex_cpy.dst_subresource.mip_level = 0;
-                    tex_cpy.src = upload_buffer;
-                    tex_cpy.src_offset = 0;
-                    cgpu_cmd_transfer_buffer_to_texture(cmdbuf, &tex_cpy);
+                    auto dst_data = (uint8_t*)upload_buffer->info->cpu_mapped_address;
+                    auto src_data = (const uint8_t*)pUpload->src_data;
+                    uint64_t src_offset = 0, dst_offset = 0;
+                    for (uint32_t mip = 0; mip < pInfo->mip_levels; mip++)
+                    {
+                        const auto footprint = VRAMTextureMipRows(pInfo, mip, row_align);
+                        dst_offset = (dst_offset + mip_align - 1) / mip_align * mip_align;
+                        if (footprint.row_pitch == footprint.row_bytes)
+                        {
+                            memcpy(dst_data + dst_offset, src_data + src_offset, footprint.row_bytes * footprint.rows);
+                        }
+                        else
+                        {
+                            for (uint64_t row = 0; row < footprint.rows; row++)
+                            {
+                                memcpy(dst_data + dst_offset + row * footprint.row_pitch,
+                                    src_data + src_offset + row * footprint.row_bytes, footprint.row_bytes);
+                            }
+                        }
+                        CGPUBufferToTextureTransfer tex_cpy = {};
+                        tex_cpy.dst = pTexture->texture;
+                        tex_cpy.dst_subresource.aspects = CGPU_TVA_COLOR;
+                        // TODO: texture array
+                        tex_cpy.dst_subresource.base_array_layer = 0;
+                        tex_cpy.dst_subresource.layer_count = 1;
+                        tex_cpy.dst_subresource.mip_level = mip;
+                        tex_cpy.src = upload_buffer;
+                        tex_cpy.src_offset = dst_offset;
+                        cgpu_cmd_transfer_buffer_to_texture(cmdbuf, &tex_cpy);
+                        src_offset += footprint.row_bytes * footprint.rows;
+                        dst_offset += footprint.row_pitch * footprint.rows;
+                    }
                 }
                 auto&& Artifact = skr::static_pointer_cast<VRAMTexture>(pTexture->artifact);
                 Artifact->texture = pTexture->texture;
@@ -474,7 +544,8 @@ void CommonVRAMReader::ensureUploadRequests(SkrAsyncServicePriority priority) SK
                 if (auto upload =  shouldUseUpload(request.get()))
                 {
                     auto pStatus = io_component<IOStatusComponent>(request.get());
-                    pStatus->setStatus(SKR_IO_STAGE_LOADED);
+                    if (pStatus->getStatus() != SKR_IO_STAGE_CANCELLED) // failed uploads are already cancelled
+                        pStatus->setStatus(SKR_IO_STAGE_LOADED);
                 }
             }
             finishBatch(priority, batch);
@@ -673,6 +744,16 @@ void DStorageVRAMReader::enqueueAndSubmit(SkrAsyncServicePriority priority) SKR_
                 pDS->get_dstorage_compression(io.compression, io.uncompressed_size);
                 io.texture = pTexture->texture;
                 const auto pInfo = io.texture->info;
+                // dstorage textures are created with mip 0 only, it is at the head of the file
+                if (io.compression == SKR_DSTORAGE_COMPRESSION_NONE)
+                {
+                    const auto mip0_size = VRAMTextureMipSize(pInfo, 0);
+                    if (io.source_type == SKR_DSTORAGE_SOURCE_MEMORY)
+                        io.source_memory.bytes_size = mip0_size;
+                    else
+                        io.source_file.size = mip0_size;
+                    io.uncompressed_size = mip0_size;
+                }
                 io.width = (uint32_t)pInfo->width;
                 io.height = (uint32_t)pInfo->height;
                 io.depth = (uint32_t)pInfo->depth;
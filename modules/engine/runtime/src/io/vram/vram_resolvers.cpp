@@ -44,6 +44,10 @@ void AllocateVRAMResourceResolver::resolve(SkrAsyncServicePriority priority, IOB
     auto texture = io_component<VRAMTextureComponent>(request.get());
     if (texture && (texture->type == VRAMTextureComponent::Type::ServiceCreated))
     {
+        // dstorage streams a single texture region, only mip 0 would be initialized
+        auto pDS = io_component<VRAMDStorageComponent>(request.get());
+        if (pDS && pDS->should_use_dstorage())
+            texture->desc.mip_levels = 1;
         texture->texture = cgpu_create_texture(texture->device, &texture->desc);
         return;
     }
@@ -54,6 +54,8 @@ VRAMService::VRAMService(const VRAMServiceDescriptor* desc) SKR_NOEXCEPT
     }
     runner.common_reader = VRAMUtils::CreateCommonReader(this, desc);
     runner.set_resolvers();
+    if (desc->trace.enable)
+        runner.enable_trace(desc->trace, name.u8_str());
 
     if ((!desc->awake_at_request) && (desc->sleep_time > 2000))
     {
@@ -170,6 +172,19 @@ void VRAMService::poll_finish_callbacks() SKR_NOEXCEPT
     runner.poll_finish_callbacks();
 }
 
+bool VRAMService::query_latency(ESkrIOStage stage, SkrAsyncServicePriority priority, skr_io_latency_stats_t* stats) SKR_NOEXCEPT
+{
+    if (auto tracer = runner.get_tracer())
+        return tracer->query(stage, priority, stats);
+    return false;
+}
+
+void VRAMService::dump_latency() SKR_NOEXCEPT
+{
+    if (auto tracer = runner.get_tracer())
+        tracer->dump();
+}
+
 VRAMService::Runner::Runner(VRAMService* service, skr::JobQueue* job_queue) SKR_NOEXCEPT
     : RunnerBase({ service->name.u8_str(), SKR_THREAD_ABOVE_NORMAL }, job_queue),
     service(service)
@@ -186,6 +201,8 @@ void VRAMService::Runner::enqueueBatch(const IOBatchId& batch) SKR_NOEXCEPT
         {
             auto status = pStatus->getStatus();
             SKR_ASSERT(status == SKR_IO_STAGE_NONE);
+            if (tracer)
+                pStatus->setTracer(tracer, priority);
             pStatus->setStatus(SKR_IO_STAGE_ENQUEUED);
         }
     }
@@ -35,6 +35,8 @@ struct VRAMService final : public IVRAMService
     void set_sleep_time(uint32_t time) SKR_NOEXCEPT;
     SkrAsyncServiceStatus get_service_status() const SKR_NOEXCEPT;
     void poll_finish_callbacks() SKR_NOEXCEPT;
+    bool query_latency(ESkrIOStage stage, SkrAsyncServicePriority priority, skr_io_latency_stats_t* stats) SKR_NOEXCEPT;
+    void dump_latency() SKR_NOEXCEPT;
 
     struct Runner final : public RunnerBase
     {
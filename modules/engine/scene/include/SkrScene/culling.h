@@ -0,0 +1,93 @@
+#pragma once
+#include "SkrBase/config.h"
+#include "SkrRT/ecs/sugoi_types.h"
+#ifdef __cplusplus
+    #include "SkrContainers/vector.hpp"
+#endif
+#ifndef __meta__
+    #include "SkrScene/culling.generated.h" // IWYU pragma: export
+#endif
+
+namespace skr
+{
+// bounds are in local space, the entity's TransformComponent places them in the world
+
+sreflect_struct(
+    "guid" : "5B0E3A6C-2D43-4C8E-9C31-7E4A1F2B8D90",
+    "serde" : ["bin", "json"],
+    "ecs::comp" : true
+)
+BoundingSphereComponent {
+    float3 center;
+    float  radius;
+};
+
+sreflect_struct(
+    "guid" : "0F6C9E27-8B1D-4A53-A4E2-3C7D5B9F1E68",
+    "serde" : ["bin", "json"],
+    "ecs::comp" : true
+)
+BoundingBoxComponent {
+    float3 center;
+    float3 extents;
+};
+
+#ifdef __cplusplus
+// farthest depth pyramid for software occlusion, level 0 is the depth buffer it was built from.
+// depth goes from 0 at the near plane to 1 at the far plane
+struct SKR_SCENE_API DepthPyramid {
+    struct Level {
+        uint32_t width;
+        uint32_t height;
+        uint32_t offset;
+    };
+
+    void build(const float* depth, uint32_t width, uint32_t height) SKR_NOEXCEPT;
+    // rect in uv space with v going down, occluded if the nearest depth is behind every texel it covers
+    bool is_occluded(float min_u, float min_v, float max_u, float max_v, float nearest_depth) const SKR_NOEXCEPT;
+
+    skr::Vector<Level> levels;
+    skr::Vector<float> texels;
+};
+
+struct CullingView {
+    skr_float4x4_t      view_projection;
+    // optional, bounds passing the frustum are also tested against it
+    const DepthPyramid* occlusion = nullptr;
+};
+
+// visible instances compacted in query order, chunks index into the flat arrays
+struct CullingResult {
+    struct Chunk {
+        sugoi_chunk_view_t view;
+        uint32_t           first;
+        uint32_t           count;
+    };
+    skr::Vector<Chunk>          chunks;
+    // slot of the instance in its chunk
+    skr::Vector<EIndex>         indices;
+    skr::Vector<sugoi_entity_t> entities;
+
+    uint32_t tested_count     = 0;
+    uint32_t frustum_culled   = 0;
+    uint32_t occlusion_culled = 0;
+};
+
+// culls every entity with a TransformComponent & a BoundingSphereComponent, a BoundingBoxComponent
+// refines the test when present. runs as a parallel ecs job, the storage must be bound to the scheduler
+struct SKR_SCENE_API CullingSystem {
+public:
+    static CullingSystem* Create(sugoi_storage_t* world) SKR_NOEXCEPT;
+    static void Destroy(CullingSystem* system) SKR_NOEXCEPT;
+
+    void cull(const CullingView& view, CullingResult& result) SKR_NOEXCEPT;
+    void set_batch_size(uint32_t batch_size) SKR_NOEXCEPT;
+
+private:
+    CullingSystem() SKR_NOEXCEPT = default;
+    ~CullingSystem() SKR_NOEXCEPT = default;
+    struct Impl;
+    Impl* impl;
+};
+#endif
+} // namespace skr
@@ -0,0 +1,367 @@
+#include "SkrBase/math/vector.h"
+#include "SkrBase/math/quat.h"
+#include "SkrBase/math/rtm/qvvf.h"
+#include "SkrBase/math/rtm/matrix3x4f.h"
+#include "SkrBase/math/rtm/matrix4x4f.h"
+#include "SkrOS/thread.h"
+#include "SkrRT/ecs/sugoi.h"
+#include "SkrRT/ecs/storage.hpp"
+#include "SkrTask/fib_task.hpp"
+#include "SkrScene/scene.h"
+#include "SkrScene/culling.h"
+#include <algorithm>
+#include <atomic>
+
+#include "SkrProfile/profile.h"
+
+namespace skr
+{
+// the 6 planes as 2 groups of 4 in SoA form, one group is tested per instruction. the second group repeats near & far
+struct FrustumPlanes
+{
+    rtm::vector4f x[2], y[2], z[2], w[2];
+    rtm::vector4f abs_x[2], abs_y[2], abs_z[2];
+};
+
+// state shared by the views of one cull() call
+struct CullingJob
+{
+    struct Run
+    {
+        EIndex             start;
+        EIndex             count;
+        sugoi_chunk_view_t view;
+    };
+    FrustumPlanes       planes;
+    rtm::matrix4x4f     view_projection;
+    const DepthPyramid* occlusion = nullptr;
+
+    // a view writes its visible instances from its first slot in the job, compacted after the job
+    skr::Vector<EIndex>         indices;
+    skr::Vector<sugoi_entity_t> entities;
+    skr::Vector<Run>            runs;
+    SMutexObject                runs_mutex;
+    uint32_t                    tested_count     = 0;
+    std::atomic<uint32_t>       frustum_culled   = 0;
+    std::atomic<uint32_t>       occlusion_culled = 0;
+};
+
+struct skr::CullingSystem::Impl
+{
+    sugoi_query_t* query      = nullptr;
+    uint32_t       batch_size = 1024;
+    CullingJob     job;
+};
+
+static FrustumPlanes make_frustum_planes(const skr_float4x4_t& m)
+{
+    // clip = v * m, each plane is a sum of matrix columns. depth is in [0, 1]
+    float planes[6][4];
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        const float x = m.M[i][0], y = m.M[i][1], z = m.M[i][2], w = m.M[i][3];
+        planes[0][i] = w + x; // left
+        planes[1][i] = w - x; // right
+        planes[2][i] = w + y; // bottom
+        planes[3][i] = w - y; // top
+        planes[4][i] = z;     // near
+        planes[5][i] = w - z; // far
+    }
+    for (auto& plane : planes)
+    {
+        const float length = rtm::scalar_sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        const float inv    = length > 0.f ? 1.f / length : 0.f;
+        for (auto& value : plane)
+            value *= inv;
+    }
+    static constexpr uint32_t kGroups[2][4] = { { 0, 1, 2, 3 }, { 4, 5, 4, 5 } };
+    FrustumPlanes result;
+    for (uint32_t g = 0; g < 2; g++)
+    {
+        const auto& p   = kGroups[g];
+        result.x[g]     = rtm::vector_set(planes[p[0]][0], planes[p[1]][0], planes[p[2]][0], planes[p[3]][0]);
+        result.y[g]     = rtm::vector_set(planes[p[0]][1], planes[p[1]][1], planes[p[2]][1], planes[p[3]][1]);
+        result.z[g]     = rtm::vector_set(planes[p[0]][2], planes[p[1]][2], planes[p[2]][2], planes[p[3]][2]);
+        result.w[g]     = rtm::vector_set(planes[p[0]][3], planes[p[1]][3], planes[p[2]][3], planes[p[3]][3]);
+        result.abs_x[g] = rtm::vector_abs(result.x[g]);
+        result.abs_y[g] = rtm::vector_abs(result.y[g]);
+        result.abs_z[g] = rtm::vector_abs(result.z[g]);
+    }
+    return result;
+}
+
+// a box is outside when its center is farther behind one plane than its extents reach along the plane normal,
+// a sphere is the box with its radius as the reach
+RTM_FORCE_INLINE static bool outside_frustum(const FrustumPlanes& planes, rtm::vector4f_arg0 center, rtm::vector4f_arg1 extents)
+{
+    const auto cx = rtm::vector_dup_x(center);
+    const auto cy = rtm::vector_dup_y(center);
+    const auto cz = rtm::vector_dup_z(center);
+    const auto ex = rtm::vector_dup_x(extents);
+    const auto ey = rtm::vector_dup_y(extents);
+    const auto ez = rtm::vector_dup_z(extents);
+    for (uint32_t g = 0; g < 2; g++)
+    {
+        auto distance = rtm::vector_mul_add(planes.x[g], cx, planes.w[g]);
+        distance      = rtm::vector_mul_add(planes.y[g], cy, distance);
+        distance      = rtm::vector_mul_add(planes.z[g], cz, distance);
+        auto reach    = rtm::vector_mul(planes.abs_x[g], ex);
+        reach         = rtm::vector_mul_add(planes.abs_y[g], ey, reach);
+        reach         = rtm::vector_mul_add(planes.abs_z[g], ez, reach);
+        if (rtm::vector_any_less_than(distance, rtm::vector_neg(reach)))
+            return true;
+    }
+    return false;
+}
+
+RTM_FORCE_INLINE static bool outside_frustum(const FrustumPlanes& planes, rtm::vector4f_arg0 center, float radius)
+{
+    const auto cx        = rtm::vector_dup_x(center);
+    const auto cy        = rtm::vector_dup_y(center);
+    const auto cz        = rtm::vector_dup_z(center);
+    const auto neg_reach = rtm::vector_set(-radius);
+    for (uint32_t g = 0; g < 2; g++)
+    {
+        auto distance = rtm::vector_mul_add(planes.x[g], cx, planes.w[g]);
+        distance      = rtm::vector_mul_add(planes.y[g], cy, distance);
+        distance      = rtm::vector_mul_add(planes.z[g], cz, distance);
+        if (rtm::vector_any_less_than(distance, neg_reach))
+            return true;
+    }
+    return false;
+}
+
+static bool occluded(const DepthPyramid& pyramid, const rtm::matrix4x4f& view_projection, rtm::vector4f_arg0 center, rtm::vector4f_arg1 extents)
+{
+    float min_x = 1.f, min_y = 1.f, max_x = -1.f, max_y = -1.f, nearest = 1.f;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        const auto sign   = rtm::vector_set((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, (i & 4) ? 1.f : -1.f, 0.f);
+        const auto corner = rtm::vector_set_w(rtm::vector_mul_add(extents, sign, center), 1.f);
+        const auto clip   = rtm::matrix_mul_vector(corner, view_projection);
+        const float w     = rtm::vector_get_w(clip);
+        // a corner behind the eye leaves the projected rect unbounded
+        if (w <= 1e-5f) return false;
+        const float inv_w = 1.f / w;
+        const float x     = rtm::vector_get_x(clip) * inv_w;
+        const float y     = rtm::vector_get_y(clip) * inv_w;
+        const float z     = rtm::vector_get_z(clip) * inv_w;
+        min_x   = rtm::scalar_min(min_x, x);
+        max_x   = rtm::scalar_max(max_x, x);
+        min_y   = rtm::scalar_min(min_y, y);
+        max_y   = rtm::scalar_max(max_y, y);
+        nearest = rtm::scalar_min(nearest, z);
+    }
+    return pyramid.is_occluded(min_x * 0.5f + 0.5f, 0.5f - max_y * 0.5f, max_x * 0.5f + 0.5f, 0.5f - min_y * 0.5f, nearest);
+}
+
+static void cull_initialize(void* u, EIndex entity_count)
+{
+    auto job = (CullingJob*)u;
+    job->indices.resize_unsafe(entity_count);
+    job->entities.resize_unsafe(entity_count);
+    job->tested_count = entity_count;
+}
+
+static void cull_view(void* u, sugoi_query_t* query, sugoi_chunk_view_t* view, sugoi_type_index_t* localTypes, EIndex entityIndex)
+{
+    SkrZoneScopedN("CullView");
+    auto       job        = (CullingJob*)u;
+    const auto transforms = sugoi::get_owned_local<const skr_transform_t>(view, localTypes[0]);
+    const auto spheres    = sugoi::get_owned_local<const skr::BoundingSphereComponent>(view, localTypes[1]);
+    const auto boxes      = sugoi::get_owned_local<const skr::BoundingBoxComponent>(view, localTypes[2]);
+    const auto entities   = sugoiV_get_entities(view);
+    const auto& planes    = job->planes;
+
+    EIndex   visible          = 0;
+    uint32_t frustum_culled   = 0;
+    uint32_t occlusion_culled = 0;
+    for (EIndex i = 0; i < view->count; ++i)
+    {
+        const auto transform = rtm::qvv_set(
+            skr::math::load(transforms[i].rotation),
+            skr::math::load(transforms[i].translation),
+            skr::math::load(transforms[i].scale)
+        );
+        const auto  scale     = rtm::vector_abs(transform.scale);
+        const float max_scale = rtm::scalar_max(rtm::scalar_max((float)rtm::vector_get_x(scale), (float)rtm::vector_get_y(scale)), (float)rtm::vector_get_z(scale));
+        const auto  center    = rtm::qvv_mul_point3(skr::math::load(spheres[i].center), transform);
+        const float radius    = spheres[i].radius * max_scale;
+        if (outside_frustum(planes, center, radius))
+        {
+            frustum_culled++;
+            continue;
+        }
+        // the world box encloses the rotated local box, a sphere stands in for a missing one
+        auto box_center  = center;
+        auto box_extents = rtm::vector_set(radius);
+        if (boxes)
+        {
+            const auto matrix  = rtm::matrix_from_qvv(transform);
+            const auto extents = skr::math::load(boxes[i].extents);
+            box_center         = rtm::qvv_mul_point3(skr::math::load(boxes[i].center), transform);
+            box_extents        = rtm::vector_mul(rtm::vector_abs(matrix.x_axis), rtm::vector_dup_x(extents));
+            box_extents        = rtm::vector_mul_add(rtm::vector_abs(matrix.y_axis), rtm::vector_dup_y(extents), box_extents);
+            box_extents        = rtm::vector_mul_add(rtm::vector_abs(matrix.z_axis), rtm::vector_dup_z(extents), box_extents);
+            if (outside_frustum(planes, box_center, box_extents))
+            {
+                frustum_culled++;
+                continue;
+            }
+        }
+        if (job->occlusion && occluded(*job->occlusion, job->view_projection, box_center, box_extents))
+        {
+            occlusion_culled++;
+            continue;
+        }
+        job->indices[entityIndex + visible]  = view->start + i;
+        job->entities[entityIndex + visible] = entities[i];
+        visible++;
+    }
+    if (frustum_culled)
+        job->frustum_culled.fetch_add(frustum_culled, std::memory_order_relaxed);
+    if (occlusion_culled)
+        job->occlusion_culled.fetch_add(occlusion_culled, std::memory_order_relaxed);
+    if (visible)
+    {
+        SMutexLock lock(job->runs_mutex.mMutex);
+        job->runs.add({ entityIndex, visible, *view });
+    }
+}
+
+CullingSystem* CullingSystem::Create(sugoi_storage_t* world) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("CreateCullingSystem");
+    auto memory  = (uint8_t*)sakura_calloc(1, sizeof(CullingSystem) + sizeof(CullingSystem::Impl));
+    auto system  = new (memory) CullingSystem();
+    system->impl = new (memory + sizeof(CullingSystem)) CullingSystem::Impl();
+    system->impl->query = world->new_query()
+        .ReadAll<skr::TransformComponent>()
+        .ReadAll<skr::BoundingSphereComponent>()
+        .ReadAny<skr::BoundingBoxComponent>()
+        .commit().value();
+    return system;
+}
+
+void CullingSystem::Destroy(CullingSystem* system) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("FinalizeCullingSystem");
+    sugoiQ_release(system->impl->query);
+    system->impl->~Impl();
+    system->~CullingSystem();
+    sakura_free(system);
+}
+
+void CullingSystem::set_batch_size(uint32_t batch_size) SKR_NOEXCEPT
+{
+    impl->batch_size = batch_size;
+}
+
+void CullingSystem::cull(const CullingView& view, CullingResult& result) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("CullInstances");
+    auto&       job = impl->job;
+    const auto& m   = view.view_projection.M;
+    job.planes          = make_frustum_planes(view.view_projection);
+    job.view_projection = rtm::matrix_set(
+        rtm::vector_set(m[0][0], m[0][1], m[0][2], m[0][3]),
+        rtm::vector_set(m[1][0], m[1][1], m[1][2], m[1][3]),
+        rtm::vector_set(m[2][0], m[2][1], m[2][2], m[2][3]),
+        rtm::vector_set(m[3][0], m[3][1], m[3][2], m[3][3])
+    );
+    job.occlusion = (view.occlusion && !view.occlusion->levels.empty()) ? view.occlusion : nullptr;
+    job.runs.clear();
+    job.tested_count = 0;
+    job.frustum_culled.store(0, std::memory_order_relaxed);
+    job.occlusion_culled.store(0, std::memory_order_relaxed);
+    result.chunks.clear();
+    result.indices.clear();
+    result.entities.clear();
+
+    skr::task::event_t counter(nullptr);
+    if (sugoiJ_schedule_ecs(impl->query, impl->batch_size, &cull_view, &job, &cull_initialize, nullptr, nullptr, &counter))
+        counter.wait(false);
+
+    // views finish in any order, query order keeps the result stable between frames
+    {
+        SkrZoneScopedN("CompactVisibleInstances");
+        job.runs.sort([](const CullingJob::Run& a, const CullingJob::Run& b) { return a.start < b.start; });
+        for (const auto& run : job.runs)
+        {
+            result.chunks.add({ run.view, (uint32_t)result.indices.size(), run.count });
+            result.indices.append(job.indices.data() + run.start, run.count);
+            result.entities.append(job.entities.data() + run.start, run.count);
+        }
+    }
+    result.tested_count     = job.tested_count;
+    result.frustum_culled   = job.frustum_culled.load(std::memory_order_relaxed);
+    result.occlusion_culled = job.occlusion_culled.load(std::memory_order_relaxed);
+}
+
+void DepthPyramid::build(const float* depth, uint32_t width, uint32_t height) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("BuildDepthPyramid");
+    levels.clear();
+    texels.clear();
+    if (!width || !height) return;
+
+    // a texel covers 2x2 texels of the level above, the last row & column of odd sizes stand alone
+    uint32_t texel_count = 0;
+    for (uint32_t w = width, h = height;; w = (w + 1) / 2, h = (h + 1) / 2)
+    {
+        levels.add({ w, h, texel_count });
+        texel_count += w * h;
+        if (w == 1 && h == 1) break;
+    }
+    texels.resize_unsafe(texel_count);
+    memcpy(texels.data(), depth, sizeof(float) * width * height);
+    for (uint32_t l = 1; l < levels.size(); l++)
+    {
+        const auto   src     = levels[l - 1];
+        const auto   dst     = levels[l];
+        const float* src_row = texels.data() + src.offset;
+        float*       dst_row = texels.data() + dst.offset;
+        for (uint32_t y = 0; y < dst.height; y++)
+        {
+            const float* row0 = src_row + (2 * y) * src.width;
+            const float* row1 = src_row + std::min(2 * y + 1, src.height - 1) * src.width;
+            for (uint32_t x = 0; x < dst.width; x++)
+            {
+                const uint32_t x0 = 2 * x;
+                const uint32_t x1 = std::min(2 * x + 1, src.width - 1);
+                dst_row[y * dst.width + x] = rtm::scalar_max(
+                    rtm::scalar_max(row0[x0], row0[x1]),
+                    rtm::scalar_max(row1[x0], row1[x1])
+                );
+            }
+        }
+    }
+}
+
+bool DepthPyramid::is_occluded(float min_u, float min_v, float max_u, float max_v, float nearest_depth) const SKR_NOEXCEPT
+{
+    if (levels.empty()) return false;
+    const auto to_texel = [](float uv, uint32_t size) {
+        const float texel = rtm::scalar_clamp(uv, 0.f, 1.f) * (float)size;
+        return std::min((uint32_t)texel, size - 1);
+    };
+    const auto&    base = levels[0];
+    const uint32_t x0   = to_texel(min_u, base.width);
+    const uint32_t x1   = to_texel(max_u, base.width);
+    const uint32_t y0   = to_texel(min_v, base.height);
+    const uint32_t y1   = to_texel(max_v, base.height);
+
+    // the first level where the rect spans at most 2x2 texels
+    uint32_t level = 0;
+    while (level + 1 < levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+        level++;
+    const auto& mip      = levels[level];
+    float       farthest = 0.f;
+    for (uint32_t y = y0 >> level; y <= (y1 >> level); y++)
+    {
+        for (uint32_t x = x0 >> level; x <= (x1 >> level); x++)
+            farthest = rtm::scalar_max(farthest, texels[mip.offset + y * mip.width + x]);
+    }
+    return nearest_depth > farthest;
+}
+} // namespace skr
@@ -37,6 +37,8 @@ public:
         uint64_t                first_element  = 0;
         uint64_t                elemet_count   = 0;
         uint64_t                element_stride = 0;
+        // size class, buffers are created at the upper bound of their class
+        uint64_t                size           = 0;
         uint64_t                padding        = 0;
         uint64_t                padding1       = 0;
         operator size_t() const;
@@ -48,15 +50,40 @@ public:
 
         Key(CGPUDeviceId device, const CGPUBufferDescriptor& desc);
     };
+    struct Statistics {
+        // requests since begin_frame
+        uint32_t hits = 0;
+        // hits served by a buffer of a larger size class
+        uint32_t larger_hits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;
+        // buffers owned by the pool, handed out or idle
+        uint64_t bytes = 0;
+        uint64_t idle_bytes = 0;
+    };
+    // a request may take a pooled buffer up to this many size classes larger, 4 classes make an octave
+    static constexpr uint32_t kLargerClassReach = 4;
+
     friend class RenderGraphBackend;
     void                                          initialize(CGPUDeviceId device);
     void                                          finalize();
+    // buffers last used before safe_frame are done on the gpu, the least recently used of them are freed
+    // while the pool holds more than budget bytes. 0 is no budget
+    void                                          begin_frame(uint64_t safe_frame, uint64_t budget);
     std::pair<CGPUBufferId, ECGPUResourceState> allocate(const CGPUBufferDescriptor& desc, AllocationMark mark, uint64_t min_frame_index);
     void                                          deallocate(const CGPUBufferDescriptor& desc, CGPUBufferId buffer, ECGPUResourceState final_state, AllocationMark mark);
+    uint32_t                                      collect_garbage(uint64_t critical_frame, uint32_t with_tags, uint32_t without_tags);
+    inline const Statistics&                      get_statistics() const { return statistics; }
 
 protected:
+    void     free_pooled(PooledBuffer& pooled);
+    uint32_t evict();
+
     CGPUDeviceId                                                     device;
     skr::FlatHashMap<Key, skr::stl_deque<PooledBuffer>, Key::hasher> buffers;
+    uint64_t                                                         safe_frame = 0;
+    uint64_t                                                         budget     = 0;
+    Statistics                                                       statistics;
 };
 } // namespace render_graph
 } // namespace skr
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "SkrRenderGraph/backend/buffer_pool.hpp"
 #include "SkrRenderGraph/backend/texture_view_pool.hpp"
 #include "SkrRenderGraph/backend/bind_table_pool.hpp"
+#include "SkrRenderGraph/backend/transient_memory_planner.hpp"
 
 namespace skr
 {
@@ -18,23 +19,51 @@ public:
     friend class RenderGraphBackend;
 
     RenderGraphFrameExecutor() = default;
-    void initialize(CGPUQueueId gfx_queue, CGPUDeviceId device);
+    void initialize(CGPUQueueId queue, CGPUDeviceId device, bool with_fence = true);
     void finalize();
 
     const struct CGPUXMergedBindTable* merge_tables(const struct CGPUXBindTable** tables, uint32_t count);
 
-    void commit(CGPUQueueId gfx_queue, uint64_t frame_index);
-    void reset_begin(TextureViewPool& texture_view_pool);
+    // submits this executor & the active segments in order, split at queue changes & semaphores
+    void commit(uint64_t frame_index);
+    // index-th semaphore of this frame slot, created on first use
+    CGPUSemaphoreId acquire_semaphore(CGPUDeviceId device, uint32_t index);
+    void reset_begin(TextureViewPool& texture_view_pool, uint64_t transient_plan);
+    void release_transient_memory(TextureViewPool* texture_view_pool);
 
     void write_marker(const char8_t* message);
     void print_error_trace(uint64_t frame_index);
 
+    // the queue gfx_cmd_pool is created on, async segments are not on graphics
+    CGPUQueueId                                           queue        = nullptr;
     CGPUCommandPoolId                                     gfx_cmd_pool = nullptr;
     CGPUCommandBufferId                                   gfx_cmd_buf  = nullptr;
     CGPUFenceId                                           exec_fence   = nullptr;
     uint64_t                                              exec_frame   = 0;
-    skr::Vector<CGPUTextureId>                            aliasing_textures;
+    // heaps & placed textures of the transient plan this executor last ran, freed when the plan changes
+    struct PlacedTextureKey {
+        uint32_t heap;
+        uint64_t offset;
+        size_t   texture_key;
+        inline bool operator==(const PlacedTextureKey& other) const
+        {
+            return heap == other.heap && offset == other.offset && texture_key == other.texture_key;
+        }
+        struct hasher { size_t operator()(const PlacedTextureKey& val) const; };
+    };
+    uint64_t                                                                     transient_plan = 0;
+    skr::Vector<CGPUTextureId>                                                   transient_heaps;
+    // nullptr marks a placement the device rejected
+    skr::FlatHashMap<PlacedTextureKey, CGPUTextureId, PlacedTextureKey::hasher> placed_textures;
     skr::FlatHashMap<CGPURootSignatureId, BindTablePool*> bind_table_pools;
+    // executors of the pass segments recorded on workers or on async queues, each with its own command pool
+    // & bind table pools. their command buffers are submitted after gfx_cmd_buf in segment order
+    skr::Vector<RenderGraphFrameExecutor*> segment_executors;
+    uint32_t                               active_segments = 0;
+    // cross-queue dependencies of this executor's submit, reset every frame
+    skr::Vector<CGPUSemaphoreId> wait_semaphores;
+    skr::Vector<CGPUSemaphoreId> signal_semaphores;
+    skr::Vector<CGPUSemaphoreId> semaphores;
 
     CGPUMarkerBufferId                   marker_buffer    = nullptr;
     uint32_t                             marker_idx       = 0;
@@ -61,6 +90,7 @@ public:
     virtual uint64_t           execute(RenderGraphProfiler* profiler = nullptr) SKR_NOEXCEPT final;
     virtual CGPUDeviceId       get_backend_device() SKR_NOEXCEPT final;
     inline virtual CGPUQueueId get_gfx_queue() SKR_NOEXCEPT final { return gfx_queue; }
+    virtual const QueueSchedule* get_queue_schedule() const SKR_NOEXCEPT final { return &queue_schedule; }
     virtual uint32_t           collect_garbage(uint64_t critical_frame,
                                                uint32_t tex_with_tags = kRenderGraphDefaultResourceTag | kRenderGraphDynamicResourceTag, uint32_t tex_without_tags = 0,
                                                uint32_t buf_with_tags = kRenderGraphDefaultResourceTag | kRenderGraphDynamicResourceTag, uint32_t buf_without_tags = 0) SKR_NOEXCEPT final;
@@ -68,6 +98,8 @@ public:
                                                        uint32_t with_tags = kRenderGraphDefaultResourceTag | kRenderGraphDynamicResourceTag, uint32_t without_tags = 0) SKR_NOEXCEPT final;
     virtual uint32_t           collect_buffer_garbage(uint64_t critical_frame,
                                                       uint32_t with_tags = kRenderGraphDefaultResourceTag | kRenderGraphDynamicResourceTag, uint32_t without_tags = 0) SKR_NOEXCEPT final;
+    virtual const TransientMemoryStatistics* get_transient_memory_statistics() const SKR_NOEXCEPT final;
+    virtual const ResourcePoolStatistics*    get_resource_pool_statistics() const SKR_NOEXCEPT final;
 
     friend class RenderGraph;
 
@@ -80,6 +112,12 @@ protected:
 
     CGPUTextureId resolve(RenderGraphFrameExecutor& executor, const TextureNode& node) SKR_NOEXCEPT;
     CGPUTextureId try_aliasing_allocate(RenderGraphFrameExecutor& executor, const TextureNode& node) SKR_NOEXCEPT;
+    void          plan_transient_memory() SKR_NOEXCEPT;
+    void          schedule_queues() SKR_NOEXCEPT;
+    CGPUQueueId   get_queue(ECGPUQueueType type) const SKR_NOEXCEPT;
+    void          apply_compiled_placements() SKR_NOEXCEPT;
+    template <typename Node>
+    ECGPUResourceState latest_state(const Node* node, PassNode* pass, uint32_t access) SKR_NOEXCEPT;
     CGPUBufferId  resolve(RenderGraphFrameExecutor& executor, const BufferNode& node) SKR_NOEXCEPT;
 
     void             calculate_barriers(RenderGraphFrameExecutor& executor, PassNode* pass,
@@ -87,11 +125,24 @@ protected:
                                         stack_vector<CGPUBufferBarrier>& buf_barriers, stack_vector<std::pair<BufferHandle, CGPUBufferId>>& resolved_buffers) SKR_NOEXCEPT;
     CGPUXBindTableId alloc_update_pass_bind_table(RenderGraphFrameExecutor& executor, PassNode* pass, CGPURootSignatureId root_sig) SKR_NOEXCEPT;
     void             deallocate_resources(PassNode* pass) SKR_NOEXCEPT;
-
-    void execute_compute_pass(RenderGraphFrameExecutor& executor, ComputePassNode* pass) SKR_NOEXCEPT;
-    void execute_render_pass(RenderGraphFrameExecutor& executor, RenderPassNode* pass) SKR_NOEXCEPT;
-    void execute_copy_pass(RenderGraphFrameExecutor& executor, CopyPassNode* pass) SKR_NOEXCEPT;
-    void execute_present_pass(RenderGraphFrameExecutor& executor, PresentPassNode* pass) SKR_NOEXCEPT;
+    template <typename Barrier>
+    bool             transfer_ownership(const ResourceNode* resource, Barrier& barrier) SKR_NOEXCEPT;
+    void             return_ownership() SKR_NOEXCEPT;
+
+    // resources resolved & barriers computed in pass order, before the pass is recorded
+    struct PreparedPass {
+        stack_vector<CGPUTextureBarrier>                      tex_barriers;
+        stack_vector<std::pair<TextureHandle, CGPUTextureId>> resolved_textures;
+        stack_vector<CGPUBufferBarrier>                       buffer_barriers;
+        stack_vector<std::pair<BufferHandle, CGPUBufferId>>   resolved_buffers;
+    };
+    void prepare_pass(RenderGraphFrameExecutor& executor, PassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT;
+    void record_passes(RenderGraphFrameExecutor& executor, uint32_t first, uint32_t last, RenderGraphProfiler* profiler) SKR_NOEXCEPT;
+
+    void execute_compute_pass(RenderGraphFrameExecutor& executor, ComputePassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT;
+    void execute_render_pass(RenderGraphFrameExecutor& executor, RenderPassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT;
+    void execute_copy_pass(RenderGraphFrameExecutor& executor, CopyPassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT;
+    void execute_present_pass(RenderGraphFrameExecutor& executor, PresentPassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT;
 
     uint64_t get_latest_finished_frame() SKR_NOEXCEPT;
 
@@ -100,10 +151,73 @@ protected:
     ECGPUBackend             backend;
     CGPUDeviceId             device;
     CGPUQueueId              gfx_queue;
+    CGPUQueueId              cmpt_queue;
+    CGPUQueueId              cpy_queue;
     RenderGraphFrameExecutor executors[RG_MAX_FRAME_IN_FLIGHT];
     TexturePool              texture_pool;
     BufferPool               buffer_pool;
     TextureViewPool          texture_view_pool;
+    ResourcePoolStatistics   pool_statistics;
+    skr::Vector<PreparedPass> prepared_passes;
+
+    TransientMemoryPlanner             texture_planner;
+    TransientMemoryPlanner             buffer_planner;
+    uint64_t                           transient_plan = 0;
+    skr::Vector<CGPUTextureDescriptor> transient_heap_descs;
+    // device sizes of textures whose placement failed, replaces the estimate in the next plan
+    skr::FlatHashMap<size_t, uint64_t> measured_texture_sizes;
+    TransientMemoryStatistics          transient_statistics;
+
+    // what compile & execute derive from the topology alone, recorded by the first frame
+    // of a topology and replayed while the topology hash stays the same
+    struct CompiledGraph {
+        struct Access {
+            // barrier source, the resource's init state of this frame if from_init
+            ECGPUResourceState src_state = CGPU_RESOURCE_STATE_UNDEFINED;
+            bool               from_init = true;
+            bool               last_user = false;
+        };
+        struct Placement {
+            uint32_t heap   = TransientMemoryPlanner::kInvalidHeap;
+            uint64_t offset = 0;
+        };
+        uint64_t topology = 0;
+        bool     recorded = false;
+        // first access of each pass, accesses follow the foreach_textures & foreach_buffers order
+        skr::Vector<uint32_t>  pass_accesses;
+        skr::Vector<Access>    accesses;
+        skr::Vector<Placement> placements;
+    };
+    CompiledGraph compiled_graph;
+    uint32_t      executing_accesses = 0;
+
+    // async queues:
+    // - compile() splits the passes into queue segments, resources are owned by graphics between frames
+    // - an access on another queue than the previous one waits for its segment & transfers the ownership,
+    //   the owning segment releases after its last pass and the access acquires
+    // - resources touched off graphics are resolved before the first pass & released after the last one,
+    //   so neither aliasing nor mid-frame pool reuse can hand their memory to a concurrent queue
+    struct QueueOwner {
+        uint32_t           segment;
+        ECGPUResourceState state;
+    };
+    struct SegmentTransfers {
+        stack_vector<CGPUTextureBarrier> head_tex_barriers;
+        stack_vector<CGPUBufferBarrier>  head_buffer_barriers;
+        stack_vector<CGPUTextureBarrier> tail_tex_barriers;
+        stack_vector<CGPUBufferBarrier>  tail_buffer_barriers;
+    };
+    QueueSchedule                                     queue_schedule;
+    skr::Vector<uint32_t>                             pass_segments;
+    // latest graphics segment up to each segment, where resources enter async segments from
+    skr::Vector<uint32_t>                             home_segments;
+    skr::Vector<SegmentTransfers>                     segment_transfers;
+    skr::FlatHashMap<const ResourceNode*, QueueOwner> queue_owners;
+    skr::Vector<std::pair<ResourceNode*, ECGPUResourceState>> async_releases;
+    uint32_t                                          executing_segment = 0;
+
+    // head transfers, passes [first, last), tail transfers
+    void record_segment(RenderGraphFrameExecutor& executor, uint32_t first, uint32_t last, const SegmentTransfers* transfers, RenderGraphProfiler* profiler) SKR_NOEXCEPT;
 };
 } // namespace render_graph
 } // namespace skr
\ No newline at end of file
@@ -46,15 +46,41 @@ public:
 
         Key(CGPUDeviceId device, const CGPUTextureDescriptor& desc);
     };
+    struct Statistics {
+        // requests since begin_frame
+        uint32_t hits = 0;
+        // hits served by a larger texture of the resolution bucket
+        uint32_t oversized_hits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;
+        // textures owned by the pool, handed out or idle
+        uint64_t bytes = 0;
+        uint64_t idle_bytes = 0;
+    };
     friend class RenderGraphBackend;
-    void initialize(CGPUDeviceId device);
+    void initialize(CGPUDeviceId device, class TextureViewPool* texture_views);
     void finalize();
-    std::pair<CGPUTextureId, ECGPUResourceState> allocate(const CGPUTextureDescriptor& desc, AllocationMark mark);
+    // textures last used before safe_frame are done on the gpu, the least recently used of them are freed
+    // while the pool holds more than budget bytes. 0 is no budget
+    void begin_frame(uint64_t safe_frame, uint64_t budget);
+    // textures are pooled by resolution bucket, a request takes one of its exact extent. oversized requests
+    // may get any texture of the bucket, they are created at the extent of the bucket & only a part is used
+    std::pair<CGPUTextureId, ECGPUResourceState> allocate(const CGPUTextureDescriptor& desc, AllocationMark mark, bool oversized = false);
     void deallocate(const CGPUTextureDescriptor& desc, CGPUTextureId texture, ECGPUResourceState final_state, AllocationMark mark);
+    uint32_t collect_garbage(uint64_t critical_frame, uint32_t with_tags, uint32_t without_tags);
+    inline const Statistics& get_statistics() const { return statistics; }
 
 protected:
+    Key bucket_key(const CGPUTextureDescriptor& desc) const;
+    void free_pooled(PooledTexture& pooled);
+    uint32_t evict();
+
     CGPUDeviceId device;
+    class TextureViewPool* texture_views = nullptr;
     skr::FlatHashMap<Key, skr::stl_deque<PooledTexture>, Key::hasher> textures;
+    uint64_t safe_frame = 0;
+    uint64_t budget = 0;
+    Statistics statistics;
 };
 } // namespace render_graph
 } // namespace skr
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "SkrGraphics/api.h"
 #include "SkrContainers/map.hpp"
+#include "SkrOS/thread.h"
 
 namespace skr
 {
@@ -49,11 +50,13 @@ public:
     void              initialize(CGPUDeviceId device);
     void              finalize();
     uint32_t          erase(CGPUTextureId texture);
+    // thread safe, passes recorded in parallel allocate their views concurrently
     CGPUTextureViewId allocate(const CGPUTextureViewDescriptor& desc, uint64_t frame_index);
 
 protected:
     CGPUDeviceId                      device;
     skr::Map<Key, PooledTextureView> views;
+    SMutexObject                      mutex;
 };
 } // namespace render_graph
 } // namespace skr
\ No newline at end of file
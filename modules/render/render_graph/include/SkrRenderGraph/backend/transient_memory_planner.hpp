@@ -0,0 +1,74 @@
+#pragma once
+#include "SkrRenderGraph/rg_config.h"
+#include "SkrContainers/vector.hpp"
+
+namespace skr
+{
+namespace render_graph
+{
+// packs transient resources into a few heaps by lifetime, size and alignment.
+// requests are placed largest first, each one goes to the best fitting gap left by
+// the already placed resources whose lifetimes overlap with it (offset allocation),
+// a new heap is opened only when no heap of the same class can take it.
+// pure cpu side, the backend maps heaps & offsets to gpu memory.
+class SKR_RENDER_GRAPH_API TransientMemoryPlanner
+{
+public:
+    static constexpr uint32_t kInvalidHeap = UINT32_MAX;
+
+    struct Request {
+        uint64_t size;
+        uint64_t alignment;
+        // inclusive pass order range
+        uint32_t first_pass;
+        uint32_t last_pass;
+        // only requests with the same class may share a heap
+        uint32_t heap_class;
+    };
+    struct Placement {
+        uint32_t heap   = kInvalidHeap;
+        uint64_t offset = 0;
+    };
+    struct Heap {
+        uint32_t heap_class;
+        uint64_t size;
+        uint64_t alignment;
+        // index of the largest request placed in this heap
+        uint32_t largest_request;
+    };
+    struct Statistics {
+        uint64_t requested_bytes = 0;
+        uint64_t heap_bytes      = 0;
+        uint32_t request_count   = 0;
+        uint32_t heap_count      = 0;
+        inline uint64_t saved_bytes() const { return requested_bytes > heap_bytes ? requested_bytes - heap_bytes : 0; }
+    };
+
+    // drops the requests, the last plan stays readable until plan() runs again
+    void     reset() SKR_NOEXCEPT;
+    uint32_t add(const Request& request) SKR_NOEXCEPT;
+    // requests larger than max_heap_size get a dedicated heap
+    void     plan(uint64_t max_heap_size) SKR_NOEXCEPT;
+    // identifies the request list, an unchanged shape yields an unchanged plan
+    uint64_t shape_hash() const SKR_NOEXCEPT;
+
+    inline const skr::Vector<Request>&   get_requests() const SKR_NOEXCEPT { return requests; }
+    inline const skr::Vector<Placement>& get_placements() const SKR_NOEXCEPT { return placements; }
+    inline const skr::Vector<Heap>&      get_heaps() const SKR_NOEXCEPT { return heaps; }
+    inline const Statistics&             get_statistics() const SKR_NOEXCEPT { return statistics; }
+
+protected:
+    static constexpr uint32_t kPassesPerBucket = 16;
+
+    skr::Vector<Request>   requests;
+    skr::Vector<Placement> placements;
+    skr::Vector<Heap>      heaps;
+    // placed requests indexed by the pass buckets their lifetimes touch,
+    // so a request only visits the resources it may overlap with
+    skr::Vector<skr::Vector<uint32_t>> buckets;
+    skr::Vector<uint32_t>              order;
+    skr::Vector<uint32_t>              overlapped;
+    Statistics                         statistics;
+};
+} // namespace render_graph
+} // namespace skr
@@ -49,11 +49,13 @@ public:
         return (uint32_t)(in_buffer_edges.size() + out_buffer_edges.size() + ppl_buffer_edges.size());
     }
     const bool get_can_be_lone() const { return can_be_lone; }
+    const ECGPUQueueType get_queue_affinity() const { return queue_affinity; }
 
     const EPassType pass_type = EPassType::None;
     const uint32_t order;
 protected:
     bool can_be_lone = false;
+    ECGPUQueueType queue_affinity = CGPU_QUEUE_TYPE_GRAPHICS;
     PassNode(EPassType pass_type, uint32_t order);
     graph_edges_vector<TextureReadEdge*> in_texture_edges;
     graph_edges_vector<TextureRenderEdge*> out_texture_edges;
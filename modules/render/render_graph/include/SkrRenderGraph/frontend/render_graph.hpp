@@ -12,6 +12,33 @@ namespace skr
 {
 namespace render_graph
 {
+// texture & buffer pools behind the resources that are not placed by memory aliasing
+struct ResourcePoolStatistics {
+    // requests of the last executed frame
+    uint32_t texture_hits           = 0;
+    // served by a larger texture of the same resolution bucket (TextureBuilder::allow_oversized)
+    uint32_t texture_oversized_hits = 0;
+    uint32_t texture_misses         = 0;
+    uint32_t buffer_hits            = 0;
+    // served by a buffer of a larger size class
+    uint32_t buffer_larger_hits     = 0;
+    uint32_t buffer_misses          = 0;
+    // freed to stay under the budget during the last executed frame
+    uint32_t evicted_textures       = 0;
+    uint32_t evicted_buffers        = 0;
+    // bytes owned by the pools, in use or idle
+    uint64_t texture_bytes          = 0;
+    uint64_t texture_idle_bytes     = 0;
+    uint64_t buffer_bytes           = 0;
+    uint64_t buffer_idle_bytes      = 0;
+    inline float hit_rate() const
+    {
+        const uint32_t hits     = texture_hits + buffer_hits;
+        const uint32_t requests = hits + texture_misses + buffer_misses;
+        return requests ? (float)hits / (float)requests : 1.f;
+    }
+};
+
 class SKR_RENDER_GRAPH_API RenderGraphProfiler
 {
 public:
@@ -23,6 +50,43 @@ public:
     virtual void on_pass_end(class RenderGraph&, class RenderGraphFrameExecutor&, class PassNode& pass) {}
     virtual void before_commit(class RenderGraph&, class RenderGraphFrameExecutor&) {}
     virtual void after_commit(class RenderGraph&, class RenderGraphFrameExecutor&) {}
+    // once per executed frame, after the commit
+    virtual void on_resource_pools(class RenderGraph&, const ResourcePoolStatistics&) {}
+};
+
+struct TransientMemoryStatistics {
+    // bytes if every transient resource had its own allocation
+    uint64_t texture_requested_bytes = 0;
+    // bytes of the heaps the transient resources are placed in
+    uint64_t texture_heap_bytes      = 0;
+    uint64_t buffer_requested_bytes  = 0;
+    uint64_t buffer_heap_bytes       = 0;
+    uint32_t heap_count              = 0;
+    uint32_t placed_textures         = 0;
+    // placements rejected by the device, served by the texture pool instead
+    uint32_t fallback_textures       = 0;
+    uint32_t replan_count            = 0;
+    inline uint64_t saved_bytes() const
+    {
+        const uint64_t requested = texture_requested_bytes + buffer_requested_bytes;
+        const uint64_t heaps     = texture_heap_bytes + buffer_heap_bytes;
+        return requested > heaps ? requested - heaps : 0;
+    }
+};
+
+// how the backend spreads the compiled passes over its queues, valid between compile() and execute().
+// segments are submitted in order, a segment waits for the earlier segments of other queues it reads from
+struct QueueSchedule {
+    struct Segment {
+        ECGPUQueueType queue = CGPU_QUEUE_TYPE_GRAPHICS;
+        // [first_pass, last_pass) of the compiled passes
+        uint32_t first_pass = 0;
+        uint32_t last_pass = 0;
+        // earlier segments this one waits for with a semaphore
+        skr::Vector<uint32_t> waits;
+    };
+    skr::Vector<Segment> segments;
+    inline bool is_multi_queue() const { return segments.size() > 1; }
 };
 
 struct SKR_RENDER_GRAPH_API IRenderGraphPhase
@@ -52,14 +116,26 @@ public:
         RenderGraphBuilder& backend_api(ECGPUBackend backend) SKR_NOEXCEPT;
         RenderGraphBuilder& with_device(CGPUDeviceId device) SKR_NOEXCEPT;
         RenderGraphBuilder& with_gfx_queue(CGPUQueueId queue) SKR_NOEXCEPT;
+        // queues for passes with a compute / transfer queue affinity, those passes run on graphics without them
+        RenderGraphBuilder& with_cmpt_queue(CGPUQueueId queue) SKR_NOEXCEPT;
+        RenderGraphBuilder& with_cpy_queue(CGPUQueueId queue) SKR_NOEXCEPT;
         RenderGraphBuilder& enable_memory_aliasing() SKR_NOEXCEPT;
+        // record passes on up to count skr::task workers, needs a bound task scheduler when count > 1
+        RenderGraphBuilder& with_recording_workers(uint32_t count) SKR_NOEXCEPT;
+        // idle pooled resources are freed least recently used first above these sizes, 0 keeps them until collect_garbage
+        RenderGraphBuilder& with_resource_pool_budget(uint64_t texture_bytes, uint64_t buffer_bytes) SKR_NOEXCEPT;
 
     protected:
         bool memory_aliasing = false;
+        uint32_t recording_workers = 1;
+        uint64_t texture_pool_budget = 0;
+        uint64_t buffer_pool_budget = 0;
         bool no_backend;
         ECGPUBackend api;
         CGPUDeviceId device;
         CGPUQueueId gfx_queue;
+        CGPUQueueId cmpt_queue = nullptr;
+        CGPUQueueId cpy_queue = nullptr;
     };
     using RenderGraphSetupFunction = skr::stl_function<void(class RenderGraph::RenderGraphBuilder&)>;
     static RenderGraph* create(const RenderGraphSetupFunction& setup) SKR_NOEXCEPT;
@@ -117,6 +193,8 @@ public:
         ComputePassBuilder& readwrite(const char8_t* name, BufferHandle handle) SKR_NOEXCEPT;
         ComputePassBuilder& set_pipeline(CGPUComputePipelineId pipeline) SKR_NOEXCEPT;
         ComputePassBuilder& set_root_signature(CGPURootSignatureId signature) SKR_NOEXCEPT;
+        // hint, CGPU_QUEUE_TYPE_COMPUTE runs the pass on the async compute queue if the graph has one
+        ComputePassBuilder& set_queue_affinity(ECGPUQueueType queue) SKR_NOEXCEPT;
 
     protected:
         ComputePassBuilder(RenderGraph& graph, ComputePassNode& pass) SKR_NOEXCEPT;
@@ -136,6 +214,8 @@ public:
         CopyPassBuilder& buffer_to_buffer(BufferRangeHandle src, BufferRangeHandle dst, ECGPUResourceState out_state = CGPU_RESOURCE_STATE_COPY_DEST) SKR_NOEXCEPT;
         CopyPassBuilder& buffer_to_texture(BufferRangeHandle src, TextureSubresourceHandle dst, ECGPUResourceState out_state = CGPU_RESOURCE_STATE_COPY_DEST) SKR_NOEXCEPT;
         CopyPassBuilder& from_buffer(BufferRangeHandle src) SKR_NOEXCEPT;
+        // hint, CGPU_QUEUE_TYPE_TRANSFER or CGPU_QUEUE_TYPE_COMPUTE run the copies on that queue if the graph has one
+        CopyPassBuilder& set_queue_affinity(ECGPUQueueType queue) SKR_NOEXCEPT;
 
     protected:
         CopyPassBuilder(RenderGraph& graph, CopyPassNode& pass) noexcept;
@@ -191,7 +271,8 @@ public:
     using BufferSetupFunction = skr::stl_function<void(RenderGraph&, class RenderGraph::BufferBuilder&)>;
     BufferHandle create_buffer(const BufferSetupFunction& setup) SKR_NOEXCEPT;
     inline BufferHandle get_buffer(const char8_t* name) SKR_NOEXCEPT;
-    const ECGPUResourceState get_lastest_state(const BufferNode* buffer, const PassNode* pending_pass) const SKR_NOEXCEPT;
+    // from_init: set if no earlier pass accesses the resource, the result is its init state then
+    const ECGPUResourceState get_lastest_state(const BufferNode* buffer, const PassNode* pending_pass, bool* from_init = nullptr) const SKR_NOEXCEPT;
 
     class SKR_RENDER_GRAPH_API TextureBuilder
     {
@@ -210,6 +291,9 @@ public:
         TextureBuilder& allow_readwrite() SKR_NOEXCEPT;
         TextureBuilder& allocate_dedicated() SKR_NOEXCEPT;
         TextureBuilder& allow_lone() SKR_NOEXCEPT;
+        // the passes only touch the requested extent (viewport & scissor), the pool may hand out a larger
+        // texture of the same resolution bucket. for dynamic resolution targets
+        TextureBuilder& allow_oversized() SKR_NOEXCEPT;
 
     protected:
         TextureBuilder(RenderGraph& graph, TextureNode& node) SKR_NOEXCEPT;
@@ -220,7 +304,8 @@ public:
     using TextureSetupFunction = skr::stl_function<void(RenderGraph&, class RenderGraph::TextureBuilder&)>;
     TextureHandle create_texture(const TextureSetupFunction& setup) SKR_NOEXCEPT;
     TextureHandle get_texture(const char8_t* name) SKR_NOEXCEPT;
-    const ECGPUResourceState get_lastest_state(const TextureNode* texture, const PassNode* pending_pass) const SKR_NOEXCEPT;
+    // from_init: set if no earlier pass accesses the resource, the result is its init state then
+    const ECGPUResourceState get_lastest_state(const TextureNode* texture, const PassNode* pending_pass, bool* from_init = nullptr) const SKR_NOEXCEPT;
 
     BufferNode* resolve(BufferHandle hdl) SKR_NOEXCEPT; 
     TextureNode* resolve(TextureHandle hdl) SKR_NOEXCEPT;
@@ -234,6 +319,8 @@ public:
     }
     virtual CGPUDeviceId get_backend_device() SKR_NOEXCEPT { return nullptr; }
     virtual CGPUQueueId get_gfx_queue() SKR_NOEXCEPT { return nullptr; }
+    // nullptr if the graph has no backend
+    virtual const QueueSchedule* get_queue_schedule() const SKR_NOEXCEPT { return nullptr; }
     inline uint64_t get_frame_index() const SKR_NOEXCEPT { return frame_index; }
     inline struct NodeAndEdgeFactory* get_node_factory() SKR_NOEXCEPT { return node_factory; }
     virtual uint32_t collect_garbage(uint64_t critical_frame,
@@ -249,6 +336,32 @@ public:
         aliasing_enabled = enabled;
         return aliasing_enabled;
     }
+    // nullptr if the graph has no backend or memory aliasing is disabled
+    virtual const TransientMemoryStatistics* get_transient_memory_statistics() const SKR_NOEXCEPT { return nullptr; }
+    // nullptr if the graph has no backend
+    virtual const ResourcePoolStatistics* get_resource_pool_statistics() const SKR_NOEXCEPT { return nullptr; }
+    // applied from the next execute(), 0 is no budget
+    inline void set_resource_pool_budget(uint64_t texture_bytes, uint64_t buffer_bytes) SKR_NOEXCEPT
+    {
+        texture_pool_budget = texture_bytes;
+        buffer_pool_budget = buffer_bytes;
+    }
+    // passes are recorded in contiguous segments on up to count workers, 1 records on the calling thread
+    inline uint32_t set_recording_workers(uint32_t count) SKR_NOEXCEPT
+    {
+        recording_workers = count ? count : 1;
+        return recording_workers;
+    }
+    // compile() replays the culling, aliasing & barriers of an earlier frame with the same topology
+    inline bool enable_compile_cache(bool enabled) SKR_NOEXCEPT
+    {
+        compile_cache_enabled = enabled;
+        return compile_cache_enabled;
+    }
+    // hash of the resources, passes & access edges declared this frame, valid after compile()
+    inline uint64_t get_topology_hash() const SKR_NOEXCEPT { return topology_hash; }
+    // true if the last compile() was served by the compile cache
+    inline bool is_compile_cached() const SKR_NOEXCEPT { return compile_cached; }
     RenderGraph(const RenderGraphBuilder& builder) SKR_NOEXCEPT;
     virtual ~RenderGraph() SKR_NOEXCEPT = default;
 
@@ -275,8 +388,15 @@ protected:
         skr::stl_function<void(PassNode* writer, BufferNode* buf, RenderGraphEdge* edge)>) const SKR_NOEXCEPT;
     uint32_t foreach_reader_passes(BufferHandle buffer,
         skr::stl_function<void(PassNode* reader, BufferNode* buf, RenderGraphEdge* edge)>) const SKR_NOEXCEPT;
+    uint64_t calculate_topology_hash() const SKR_NOEXCEPT;
 
     bool aliasing_enabled;
+    uint32_t recording_workers;
+    uint64_t texture_pool_budget;
+    uint64_t buffer_pool_budget;
+    bool compile_cache_enabled = true;
+    bool compile_cached = false;
+    uint64_t topology_hash = 0;
     uint64_t frame_index = 0;
 
     struct NodeAndEdgeFactory* node_factory = nullptr;
@@ -303,6 +423,8 @@ using BufferBuilder = RenderGraph::BufferBuilder;
 class SKR_RENDER_GRAPH_API RenderGraphViz
 {
 public:
+    // passes grouped by the queue segments they are submitted in, semaphore waits as dashed edges.
+    // call between compile() and execute(), execute() drops the passes
     static void write_graphviz(RenderGraph& graph, const char* outf) SKR_NOEXCEPT;
 };
 } // namespace render_graph
@@ -9,6 +9,7 @@ class ResourceNode : public RenderGraphNode
 {
 public:
     friend class RenderGraph;
+    friend class RenderGraphBackend;
     ResourceNode(EObjectType type) SKR_NOEXCEPT;
     virtual ~ResourceNode() SKR_NOEXCEPT = default;
     struct LifeSpan {
@@ -23,6 +24,8 @@ protected:
     bool canbe_lone = false;
     uint32_t tags = kRenderGraphInvalidResourceTag;
     mutable LifeSpan frame_lifespan = { UINT32_MAX, UINT32_MAX };
+    // accessed by a pass off the graphics queue this frame, kept out of aliasing & mid-frame reuse
+    mutable bool frame_async = false;
 };
 
 class TextureNode : public ResourceNode
@@ -50,12 +53,15 @@ public:
         return asize * mips * width * height * depth * FormatUtil_BitSizeOfBlock(descriptor.format);
     }
     inline const ECGPUSampleCount get_sample_count() const SKR_NOEXCEPT { return descriptor.sample_count; }
-    inline const TextureNode* get_aliasing_parent() const SKR_NOEXCEPT { return frame_aliasing_source; }
+    inline const bool is_aliasing() const SKR_NOEXCEPT { return frame_aliasing; }
+    inline const bool allow_oversized() const SKR_NOEXCEPT { return oversized; }
 
 protected:
     CGPUTextureDescriptor descriptor = {};
+    bool oversized = false;
     // temporal handle with a lifespan of only one frame
-    TextureNode* frame_aliasing_source = nullptr;
+    uint32_t frame_heap = UINT32_MAX;
+    uint64_t frame_heap_offset = 0;
     mutable CGPUTextureId frame_texture = nullptr;
     mutable ECGPUResourceState init_state = CGPU_RESOURCE_STATE_UNDEFINED;
     mutable bool frame_aliasing = false;
@@ -11,6 +11,10 @@ struct SKR_RENDER_GRAPH_API CullPhase : public IRenderGraphPhase
 
     skr::Vector<PassNode*> culled_passes;
     skr::Vector<ResourceNode*> culled_resources;
+    // positions of the culled nodes in the declaration order of topology_hash
+    uint64_t topology_hash = 0;
+    skr::Vector<uint32_t> culled_pass_indices;
+    skr::Vector<uint32_t> culled_resource_indices;
 };
 
 } // namespace render_graph
@@ -2,16 +2,18 @@
 #include "SkrRenderGraph/frontend/pass_node.hpp"
 #include "SkrRenderGraph/frontend/node_and_edge_factory.hpp"
 #include "SkrBase/misc/debug.h" 
+#include "SkrBase/misc/hash.h"
+#include "SkrBase/misc/make_zeroed.hpp"
 #include "SkrCore/memory/memory.h"
 #include "SkrOS/thread.h"
 #include "SkrCore/log.h"
 #include "SkrContainers/string.hpp"
-#include "SkrContainers/btree.hpp"
 #include "SkrGraphics/cgpux.hpp"
 
 #include "SkrRenderGraph/phases/cull_phase.hpp"
 
 #include "SkrProfile/profile.h"
+#include "SkrTask/parallel_for.hpp"
 
 namespace skr
 {
@@ -19,33 +21,71 @@ namespace render_graph
 {
 // Render Graph Executor
 
-void RenderGraphFrameExecutor::initialize(CGPUQueueId gfx_queue, CGPUDeviceId device)
+void RenderGraphFrameExecutor::initialize(CGPUQueueId queue, CGPUDeviceId device, bool with_fence)
 {
     CGPUCommandPoolDescriptor pool_desc = {
         u8"RenderGraphCmdPool"
     };
-    gfx_cmd_pool                         = cgpu_create_command_pool(gfx_queue, &pool_desc);
+    this->queue                          = queue;
+    gfx_cmd_pool                         = cgpu_create_command_pool(queue, &pool_desc);
     CGPUCommandBufferDescriptor cmd_desc = {};
     cmd_desc.is_secondary                = false;
     gfx_cmd_buf                          = cgpu_create_command_buffer(gfx_cmd_pool, &cmd_desc);
-    exec_fence                           = cgpu_create_fence(device);
+    exec_fence                           = with_fence ? cgpu_create_fence(device) : nullptr;
 
     CGPUMarkerBufferDescriptor marker_desc = {};
     marker_desc.marker_count               = 1000;
     marker_buffer                          = cgpu_create_marker_buffer(device, &marker_desc);
 }
 
-void RenderGraphFrameExecutor::commit(CGPUQueueId gfx_queue, uint64_t frame_index)
+void RenderGraphFrameExecutor::commit(uint64_t frame_index)
 {
-    CGPUQueueSubmitDescriptor submit_desc = {};
-    submit_desc.cmds                      = &gfx_cmd_buf;
-    submit_desc.cmds_count                = 1;
-    submit_desc.signal_fence              = exec_fence;
-    cgpu_submit_queue(gfx_queue, &submit_desc);
-    exec_frame = frame_index;
+    skr::InlineVector<CGPUCommandBufferId, 8> cmds;
+    skr::InlineVector<CGPUSemaphoreId, 8>     waits;
+    skr::InlineVector<CGPUSemaphoreId, 8>     signals;
+    CGPUQueueId                               submit_queue = queue;
+    const auto                                submit       = [&](CGPUFenceId fence) {
+        CGPUQueueSubmitDescriptor submit_desc = {};
+        submit_desc.cmds                      = cmds.data();
+        submit_desc.cmds_count                = (uint32_t)cmds.size();
+        submit_desc.wait_semaphores           = waits.data();
+        submit_desc.wait_semaphore_count      = (uint32_t)waits.size();
+        submit_desc.signal_semaphores         = signals.data();
+        submit_desc.signal_semaphore_count    = (uint32_t)signals.size();
+        submit_desc.signal_fence              = fence;
+        cgpu_submit_queue(submit_queue, &submit_desc);
+        cmds.clear();
+        waits.clear();
+        signals.clear();
+    };
+    // the last segment always runs on this executor's queue, its submit covers every queue of the frame
+    for (uint32_t i = 0; i <= active_segments; i++)
+    {
+        auto segment = i ? segment_executors[i - 1] : this;
+        if (!cmds.empty() && (segment->queue != submit_queue || !segment->wait_semaphores.empty()))
+            submit(nullptr);
+        submit_queue = segment->queue;
+        cmds.add(segment->gfx_cmd_buf);
+        for (auto semaphore : segment->wait_semaphores)
+            waits.add(semaphore);
+        for (auto semaphore : segment->signal_semaphores)
+            signals.add(semaphore);
+        segment->exec_frame = frame_index;
+        if (i == active_segments)
+            submit(exec_fence);
+        else if (!signals.empty())
+            submit(nullptr);
+    }
 }
 
-void RenderGraphFrameExecutor::reset_begin(TextureViewPool& texture_view_pool)
+CGPUSemaphoreId RenderGraphFrameExecutor::acquire_semaphore(CGPUDeviceId device, uint32_t index)
+{
+    while (semaphores.size() <= index)
+        semaphores.add(cgpu_create_semaphore(device));
+    return semaphores[index];
+}
+
+void RenderGraphFrameExecutor::reset_begin(TextureViewPool& texture_view_pool, uint64_t plan)
 {
     {
         SkrZoneScopedN("ResetBindTables");
@@ -64,13 +104,12 @@ void RenderGraphFrameExecutor::reset_begin(TextureViewPool& texture_view_pool)
     }
 
     {
-        SkrZoneScopedN("ResetAliasingBinds");
-        for (auto aliasing_texture : aliasing_textures)
+        SkrZoneScopedN("ResetTransientMemory");
+        if (plan != transient_plan)
         {
-            texture_view_pool.erase(aliasing_texture);
-            cgpu_free_texture(aliasing_texture);
+            release_transient_memory(&texture_view_pool);
+            transient_plan = plan;
         }
-        aliasing_textures.clear();
     }
 
     {
@@ -89,6 +128,28 @@ void RenderGraphFrameExecutor::reset_begin(TextureViewPool& texture_view_pool)
     write_marker(u8"Frame Begin");
 }
 
+void RenderGraphFrameExecutor::release_transient_memory(TextureViewPool* texture_view_pool)
+{
+    for (auto&& [key, placed] : placed_textures)
+    {
+        if (!placed) continue;
+        if (texture_view_pool) texture_view_pool->erase(placed);
+        cgpu_free_texture(placed);
+    }
+    placed_textures.clear();
+    for (auto heap : transient_heaps)
+    {
+        if (heap) cgpu_free_texture(heap);
+    }
+    transient_heaps.clear();
+}
+
+size_t RenderGraphFrameExecutor::PlacedTextureKey::hasher::operator()(const PlacedTextureKey& val) const
+{
+    const uint64_t packed[3] = { val.heap, val.offset, val.texture_key };
+    return skr_hash(packed, sizeof(packed), CGPU_NAME_HASH_SEED);
+}
+
 void RenderGraphFrameExecutor::write_marker(const char8_t* message)
 {
     cgpu_marker_buffer_write(gfx_cmd_buf, marker_buffer, marker_idx++, valid_marker_val);
@@ -111,6 +172,10 @@ void RenderGraphFrameExecutor::print_error_trace(uint64_t frame_index)
             SKR_LOG_INFO(u8"\tCommand %d: %s (marker %d)", i, marker_messages[i].c_str(), fill_data[i]);
         }
     }
+    for (uint32_t i = 0; i < active_segments; i++)
+    {
+        segment_executors[i]->print_error_trace(frame_index);
+    }
     skr_thread_sleep(2000);
 }
 
@@ -142,11 +207,24 @@ void RenderGraphFrameExecutor::finalize()
         pool->destroy();
         SkrDelete(pool);
     }
-    for (auto aliasing_tex : aliasing_textures)
+    bind_table_pools.clear();
+    merged_table_pools.clear();
+    release_transient_memory(nullptr);
+    if (marker_buffer) cgpu_free_marker_buffer(marker_buffer);
+    marker_buffer = nullptr;
+    marker_messages.clear();
+    for (auto semaphore : semaphores)
+        cgpu_free_semaphore(semaphore);
+    semaphores.clear();
+    wait_semaphores.clear();
+    signal_semaphores.clear();
+    for (auto segment : segment_executors)
     {
-        cgpu_free_texture(aliasing_tex);
+        segment->finalize();
+        SkrDelete(segment);
     }
-    if (marker_buffer) cgpu_free_marker_buffer(marker_buffer);
+    segment_executors.clear();
+    active_segments = 0;
 }
 
 // Render Graph Backend
@@ -155,6 +233,8 @@ RenderGraphBackend::RenderGraphBackend(const RenderGraphBuilder& builder)
     : RenderGraph(builder)
     , device(builder.device)
     , gfx_queue(builder.gfx_queue)
+    , cmpt_queue(builder.cmpt_queue)
+    , cpy_queue(builder.cpy_queue)
 {
     phases.add(skr::SPtr<CullPhase>::Create());
 }
@@ -190,7 +270,7 @@ void RenderGraphBackend::initialize() SKR_NOEXCEPT
         executors[i].initialize(gfx_queue, device);
     }
     buffer_pool.initialize(device);
-    texture_pool.initialize(device);
+    texture_pool.initialize(device, &texture_view_pool);
     texture_view_pool.initialize(device);
 
     for (auto& phase : phases)
@@ -213,32 +293,56 @@ void RenderGraphBackend::finalize() SKR_NOEXCEPT
 }
 
 // memory aliasing:
-// - lifespan不重叠的资源对象都可以考虑做aliasing处理
-// - aliasing的memory-type有要求，需要检查两个对象之间的内存堆兼容性
-// - 可以撮合两个对象，将它们提升为可alias的，把他们的size和alignment取最大处理即可。
-//  - 首先寻找可以直接alias处理的, cgpu_try_create_aliasing_resource(ResourceId, ResourceDesc)
-//  - 其次再考虑提升合并的行为（此行为在前端无法模拟）
+// - compile() packs the transient textures into heaps by lifespan (TransientMemoryPlanner)
+// - every executor owns its own heaps, textures placed at (heap, offset) are cached until the plan changes
+// - a placement rejected by the device falls back to the texture pool, its device size feeds the next plan
 CGPUTextureId RenderGraphBackend::try_aliasing_allocate(RenderGraphFrameExecutor& executor, const TextureNode& node) SKR_NOEXCEPT
 {
-    if (node.frame_aliasing_source)
+    if (node.frame_heap == TransientMemoryPlanner::kInvalidHeap) return nullptr;
+
+    const auto texture_key = (size_t)make_zeroed<TexturePool::Key>(device, node.descriptor);
+    const auto key         = RenderGraphFrameExecutor::PlacedTextureKey{ node.frame_heap, node.frame_heap_offset, texture_key };
+    CGPUTextureId placed   = nullptr;
+    if (auto found = executor.placed_textures.find(key); found != executor.placed_textures.end())
+    {
+        placed = found->second;
+    }
+    else
     {
         SkrZoneScopedN("AllocateAliasingResource");
+        if (executor.transient_heaps.size() < transient_heap_descs.size())
+            executor.transient_heaps.resize(transient_heap_descs.size(), nullptr);
+        auto& heap = executor.transient_heaps[node.frame_heap];
+        if (!heap) heap = cgpu_create_texture(device, &transient_heap_descs[node.frame_heap]);
+
         // allocate & try bind
-        auto                              aliasing_texture = cgpu_create_texture(device, &node.descriptor);
-        CGPUTextureAliasingBindDescriptor aliasing_desc    = {};
-        aliasing_desc.aliased                              = resolve(executor, *node.frame_aliasing_source);
-        aliasing_desc.aliasing                             = aliasing_texture;
-        node.frame_aliasing                                = cgpu_try_bind_aliasing_texture(device, &aliasing_desc);
-        if (!node.frame_aliasing)
+        placed                                          = cgpu_create_texture(device, &node.descriptor);
+        CGPUTextureAliasingBindDescriptor aliasing_desc = {};
+        aliasing_desc.aliased                           = heap;
+        aliasing_desc.aliasing                          = placed;
+        aliasing_desc.offset                            = node.frame_heap_offset;
+        if (!heap || !cgpu_try_bind_aliasing_texture(device, &aliasing_desc))
         {
-            cgpu_free_texture(aliasing_texture);
-            ((TextureNode&)node).descriptor.flags &= ~CGPU_TCF_ALIASING_RESOURCE;
-            return nullptr;
+            if (placed->info->size_in_bytes)
+            {
+                measured_texture_sizes[texture_key] = placed->info->size_in_bytes;
+                // the measured size changes the requests, the compiled placements are stale
+                compiled_graph.topology = 0;
+            }
+            cgpu_free_texture(placed);
+            placed = nullptr;
         }
-        executor.aliasing_textures.add(aliasing_texture);
-        return aliasing_texture;
+        executor.placed_textures.emplace(key, placed);
     }
-    return nullptr;
+    node.frame_aliasing = placed;
+    if (!placed)
+    {
+        ((TextureNode&)node).descriptor.flags &= ~CGPU_TCF_ALIASING_RESOURCE;
+        transient_statistics.fallback_textures++;
+        return nullptr;
+    }
+    transient_statistics.placed_textures++;
+    return placed;
 }
 
 uint64_t RenderGraphBackend::get_latest_finished_frame() SKR_NOEXCEPT
@@ -269,7 +373,7 @@ CGPUTextureId RenderGraphBackend::resolve(RenderGraphFrameExecutor& executor, co
         }
         else
         {
-            auto allocated     = texture_pool.allocate(node.descriptor, { frame_index, node.tags });
+            auto allocated     = texture_pool.allocate(node.descriptor, { frame_index, node.tags }, node.oversized);
             node.frame_texture = node.imported ? node.frame_texture : allocated.first;
             node.init_state    = allocated.second;
         }
@@ -290,51 +394,83 @@ CGPUBufferId RenderGraphBackend::resolve(RenderGraphFrameExecutor& executor, con
     return node.frame_buffer;
 }
 
+// barrier source of an access of the executing pass, only the first frame of a topology walks the graph for it
+template <typename Node>
+ECGPUResourceState RenderGraphBackend::latest_state(const Node* node, PassNode* pass, uint32_t access) SKR_NOEXCEPT
+{
+    auto& cached = compiled_graph.accesses[executing_accesses + access];
+    if (!compile_cached)
+        cached.src_state = get_lastest_state(node, pass, &cached.from_init);
+    return cached.from_init ? node->init_state : cached.src_state;
+}
+
+// tracks the queue segment owning the resource, an access from another queue turns the barrier into the acquire
+// and leaves the matching release to the owning segment, recorded after its last pass
+template <typename Barrier>
+bool RenderGraphBackend::transfer_ownership(const ResourceNode* resource, Barrier& barrier) SKR_NOEXCEPT
+{
+    const auto& segments = queue_schedule.segments;
+    uint32_t    owner    = home_segments[executing_segment];
+    if (auto found = queue_owners.find(resource); found != queue_owners.end())
+        owner = found->second.segment;
+    queue_owners[resource] = { executing_segment, barrier.dst_state };
+    if (segments[owner].queue == segments[executing_segment].queue) return false;
+
+    Barrier release       = barrier;
+    release.queue_release = 1;
+    release.queue_type    = segments[executing_segment].queue;
+    barrier.queue_acquire = 1;
+    barrier.queue_type    = segments[owner].queue;
+    if constexpr (std::is_same_v<Barrier, CGPUTextureBarrier>)
+        segment_transfers[owner].tail_tex_barriers.add(release);
+    else
+        segment_transfers[owner].tail_buffer_barriers.add(release);
+    return true;
+}
+
 void RenderGraphBackend::calculate_barriers(RenderGraphFrameExecutor& executor, PassNode* pass,
                                             stack_vector<CGPUTextureBarrier>& tex_barriers, stack_vector<std::pair<TextureHandle, CGPUTextureId>>& resolved_textures,
                                             stack_vector<CGPUBufferBarrier>& buf_barriers, stack_vector<std::pair<BufferHandle, CGPUBufferId>>& resolved_buffers) SKR_NOEXCEPT
 {
     stack_set<TextureHandle> tex_resolve_set;
     stack_set<BufferHandle>  buf_resolve_set;
+    uint32_t                 access = 0;
 
     SkrZoneScopedN("CalculateBarriers");
     pass->foreach_textures(
     [&](TextureNode* texture, TextureEdge* edge) {
-        auto tex_resolved = resolve(executor, *texture);
+        const uint32_t index        = access++;
+        auto           tex_resolved = resolve(executor, *texture);
         if (!tex_resolve_set.contains(texture->get_handle()) )
         {
             resolved_textures.emplace(texture->get_handle(), tex_resolved);
             tex_resolve_set.add(texture->get_handle());
 
-            const auto current_state = get_lastest_state(texture, pass);
-            const auto dst_state     = edge->requested_state;
-            if (current_state == dst_state) return;
-
             CGPUTextureBarrier barrier = {};
-            barrier.src_state          = current_state;
-            barrier.dst_state          = dst_state;
+            barrier.src_state          = latest_state(texture, pass, index);
+            barrier.dst_state          = edge->requested_state;
             barrier.texture            = tex_resolved;
-
-            tex_barriers.emplace(barrier);
+            const bool transfer        = queue_schedule.is_multi_queue() && transfer_ownership(texture, barrier);
+            if (transfer || barrier.src_state != barrier.dst_state)
+                tex_barriers.emplace(barrier);
         }
     });
     pass->foreach_buffers(
     [&](BufferNode* buffer, BufferEdge* edge) {
-        auto buf_resolved = resolve(executor, *buffer);
+        const uint32_t index        = access++;
+        auto           buf_resolved = resolve(executor, *buffer);
         if (!buf_resolve_set.find(buffer->get_handle()) )
         {
             resolved_buffers.emplace(buffer->get_handle(), buf_resolved);
             buf_resolve_set.add(buffer->get_handle());
 
-            const auto current_state = get_lastest_state(buffer, pass);
-            const auto dst_state     = edge->requested_state;
-            if (current_state == dst_state) return;
-
             CGPUBufferBarrier barrier = {};
-            barrier.src_state         = current_state;
-            barrier.dst_state         = dst_state;
+            barrier.src_state         = latest_state(buffer, pass, index);
+            barrier.dst_state         = edge->requested_state;
             barrier.buffer            = buf_resolved;
-            buf_barriers.emplace(barrier);
+            const bool transfer       = queue_schedule.is_multi_queue() && transfer_ownership(buffer, barrier);
+            if (transfer || barrier.src_state != barrier.dst_state)
+                buf_barriers.emplace(barrier);
         }
     });
 }
@@ -486,18 +622,28 @@ CGPUXBindTableId RenderGraphBackend::alloc_update_pass_bind_table(RenderGraphFra
 void RenderGraphBackend::deallocate_resources(PassNode* pass) SKR_NOEXCEPT
 {
     SkrZoneScopedN("VirtualDeallocate");
-    pass->foreach_textures([this, pass](TextureNode* texture, TextureEdge* edge) {
+    uint32_t access = 0;
+    pass->foreach_textures([this, pass, &access](TextureNode* texture, TextureEdge* edge) {
+        auto& cached = compiled_graph.accesses[executing_accesses + access++];
         if (texture->imported) return;
-        bool is_last_user = true;
-        texture->foreach_neighbors([&](DependencyGraphNode* neig) {
-            RenderGraphNode* rg_node = (RenderGraphNode*)neig;
-            if (rg_node->type == EObjectType::Pass)
-            {
-                PassNode* other_pass = (PassNode*)rg_node;
-                is_last_user         = is_last_user && (pass->order >= other_pass->order);
-            }
-        });
-        if (is_last_user)
+        if (!compile_cached)
+        {
+            bool is_last_user = true;
+            texture->foreach_neighbors([&](DependencyGraphNode* neig) {
+                RenderGraphNode* rg_node = (RenderGraphNode*)neig;
+                if (rg_node->type == EObjectType::Pass)
+                {
+                    PassNode* other_pass = (PassNode*)rg_node;
+                    is_last_user         = is_last_user && (pass->order >= other_pass->order);
+                }
+            });
+            cached.last_user = is_last_user;
+        }
+        if (cached.last_user && texture->frame_async)
+        {
+            async_releases.add({ texture, edge->requested_state });
+        }
+        else if (cached.last_user)
         {
             if (!texture->frame_aliasing)
             {
@@ -508,18 +654,27 @@ void RenderGraphBackend::deallocate_resources(PassNode* pass) SKR_NOEXCEPT
             }
         }
     });
-    pass->foreach_buffers([this, pass](BufferNode* buffer, BufferEdge* edge) {
+    pass->foreach_buffers([this, pass, &access](BufferNode* buffer, BufferEdge* edge) {
+        auto& cached = compiled_graph.accesses[executing_accesses + access++];
         if (buffer->imported) return;
-        bool is_last_user = true;
-        buffer->foreach_neighbors([&](DependencyGraphNode* neig) {
-            RenderGraphNode* rg_node = (RenderGraphNode*)neig;
-            if (rg_node->type == EObjectType::Pass)
-            {
-                PassNode* other_pass = (PassNode*)rg_node;
-                is_last_user         = is_last_user && (pass->order >= other_pass->order);
-            }
-        });
-        if (is_last_user)
+        if (!compile_cached)
+        {
+            bool is_last_user = true;
+            buffer->foreach_neighbors([&](DependencyGraphNode* neig) {
+                RenderGraphNode* rg_node = (RenderGraphNode*)neig;
+                if (rg_node->type == EObjectType::Pass)
+                {
+                    PassNode* other_pass = (PassNode*)rg_node;
+                    is_last_user         = is_last_user && (pass->order >= other_pass->order);
+                }
+            });
+            cached.last_user = is_last_user;
+        }
+        if (cached.last_user && buffer->frame_async)
+        {
+            async_releases.add({ buffer, edge->requested_state });
+        }
+        else if (cached.last_user)
         {
             SkrZoneScopedN("VirtualDeallocate::BufferFromPool");
 
@@ -529,20 +684,72 @@ void RenderGraphBackend::deallocate_resources(PassNode* pass) SKR_NOEXCEPT
     });
 }
 
-void RenderGraphBackend::execute_compute_pass(RenderGraphFrameExecutor& executor, ComputePassNode* pass) SKR_NOEXCEPT
+// resources leave the frame owned by graphics, the last segment acquires what async segments still hold.
+// async resources go back to the pools only now, no pass of this frame can be handed their memory
+void RenderGraphBackend::return_ownership() SKR_NOEXCEPT
+{
+    const auto& segments = queue_schedule.segments;
+    auto&       join     = segment_transfers[segments.size() - 1];
+    for (auto&& [resource, owner] : queue_owners)
+    {
+        const auto queue = segments[owner.segment].queue;
+        if (queue == CGPU_QUEUE_TYPE_GRAPHICS) continue;
+        if (resource->type == EObjectType::Texture)
+        {
+            CGPUTextureBarrier barrier = {};
+            barrier.texture            = static_cast<const TextureNode*>(resource)->frame_texture;
+            barrier.src_state          = owner.state;
+            barrier.dst_state          = owner.state;
+            barrier.queue_release      = 1;
+            barrier.queue_type         = CGPU_QUEUE_TYPE_GRAPHICS;
+            segment_transfers[owner.segment].tail_tex_barriers.add(barrier);
+            barrier.queue_release = 0;
+            barrier.queue_acquire = 1;
+            barrier.queue_type    = queue;
+            join.head_tex_barriers.add(barrier);
+        }
+        else if (resource->type == EObjectType::Buffer)
+        {
+            CGPUBufferBarrier barrier = {};
+            barrier.buffer            = static_cast<const BufferNode*>(resource)->frame_buffer;
+            barrier.src_state         = owner.state;
+            barrier.dst_state         = owner.state;
+            barrier.queue_release     = 1;
+            barrier.queue_type        = CGPU_QUEUE_TYPE_GRAPHICS;
+            segment_transfers[owner.segment].tail_buffer_barriers.add(barrier);
+            barrier.queue_release = 0;
+            barrier.queue_acquire = 1;
+            barrier.queue_type    = queue;
+            join.head_buffer_barriers.add(barrier);
+        }
+    }
+    for (auto [resource, state] : async_releases)
+    {
+        if (resource->type == EObjectType::Texture)
+        {
+            auto texture = static_cast<TextureNode*>(resource);
+            if (!texture->frame_aliasing)
+                texture_pool.deallocate(texture->descriptor, texture->frame_texture, state, { frame_index, texture->tags });
+        }
+        else if (resource->type == EObjectType::Buffer)
+        {
+            auto buffer = static_cast<BufferNode*>(resource);
+            buffer_pool.deallocate(buffer->descriptor, buffer->frame_buffer, state, { frame_index, buffer->tags });
+        }
+    }
+}
+
+void RenderGraphBackend::execute_compute_pass(RenderGraphFrameExecutor& executor, ComputePassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT
 {
     SkrZoneScopedC(tracy::Color::LightBlue);
     ZoneName(pass->name.c_str(), pass->name.size());
 
     ComputePassContext pass_context = {};
-    // resource de-virtualize
-    stack_vector<CGPUTextureBarrier>                        tex_barriers      = {};
-    stack_vector<std::pair<TextureHandle, CGPUTextureId>> resolved_textures = {};
-    stack_vector<CGPUBufferBarrier>                         buffer_barriers   = {};
-    stack_vector<std::pair<BufferHandle, CGPUBufferId>>   resolved_buffers  = {};
-    calculate_barriers(executor, pass,
-                       tex_barriers, resolved_textures,
-                       buffer_barriers, resolved_buffers);
+    // resources are de-virtualized by prepare_pass
+    auto& tex_barriers      = prepared.tex_barriers;
+    auto& resolved_textures = prepared.resolved_textures;
+    auto& buffer_barriers   = prepared.buffer_barriers;
+    auto& resolved_buffers  = prepared.resolved_buffers;
     // allocate & update descriptor sets
     pass_context.graph             = this;
     pass_context.pass              = pass;
@@ -581,24 +788,19 @@ void RenderGraphBackend::execute_compute_pass(RenderGraphFrameExecutor& executor
     }
     cgpu_cmd_end_compute_pass(executor.gfx_cmd_buf, pass_context.encoder);
     cgpu_cmd_end_event(executor.gfx_cmd_buf);
-    // deallocate
-    deallocate_resources(pass);
 }
 
-void RenderGraphBackend::execute_render_pass(RenderGraphFrameExecutor& executor, RenderPassNode* pass) SKR_NOEXCEPT
+void RenderGraphBackend::execute_render_pass(RenderGraphFrameExecutor& executor, RenderPassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT
 {
     SkrZoneScopedC(tracy::Color::LightPink);
     ZoneName(pass->name.c_str(), pass->name.size());
 
     RenderPassContext pass_context = {};
-    // resource de-virtualize
-    stack_vector<CGPUTextureBarrier>                        tex_barriers      = {};
-    stack_vector<std::pair<TextureHandle, CGPUTextureId>> resolved_textures = {};
-    stack_vector<CGPUBufferBarrier>                         buffer_barriers   = {};
-    stack_vector<std::pair<BufferHandle, CGPUBufferId>>   resolved_buffers  = {};
-    calculate_barriers(executor, pass,
-                       tex_barriers, resolved_textures,
-                       buffer_barriers, resolved_buffers);
+    // resources are de-virtualized by prepare_pass
+    auto& tex_barriers      = prepared.tex_barriers;
+    auto& resolved_textures = prepared.resolved_textures;
+    auto& buffer_barriers   = prepared.buffer_barriers;
+    auto& resolved_buffers  = prepared.resolved_buffers;
     // allocate & update descriptor sets
     pass_context.graph             = this;
     pass_context.pass              = pass;
@@ -772,22 +974,17 @@ void RenderGraphBackend::execute_render_pass(RenderGraphFrameExecutor& executor,
         executor.write_marker(message.u8_str());
     }
     cgpu_cmd_end_event(executor.gfx_cmd_buf);
-    // deallocate
-    deallocate_resources(pass);
 }
 
-void RenderGraphBackend::execute_copy_pass(RenderGraphFrameExecutor& executor, CopyPassNode* pass) SKR_NOEXCEPT
+void RenderGraphBackend::execute_copy_pass(RenderGraphFrameExecutor& executor, CopyPassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT
 {
     SkrZoneScopedC(tracy::Color::LightYellow);
     ZoneName(pass->name.c_str(), pass->name.size());
-    // resource de-virtualize
-    stack_vector<CGPUTextureBarrier>                        tex_barriers      = {};
-    stack_vector<std::pair<TextureHandle, CGPUTextureId>> resolved_textures = {};
-    stack_vector<CGPUBufferBarrier>                         buffer_barriers   = {};
-    stack_vector<std::pair<BufferHandle, CGPUBufferId>>   resolved_buffers  = {};
-    calculate_barriers(executor, pass,
-                       tex_barriers, resolved_textures,
-                       buffer_barriers, resolved_buffers);
+    // resources are de-virtualized by prepare_pass
+    auto& tex_barriers      = prepared.tex_barriers;
+    auto& resolved_textures = prepared.resolved_textures;
+    auto& buffer_barriers   = prepared.buffer_barriers;
+    auto& resolved_buffers  = prepared.resolved_buffers;
     // late barriers
     stack_vector<CGPUTextureBarrier> late_tex_barriers = {};
     stack_vector<CGPUBufferBarrier>  late_buf_barriers = {};
@@ -884,29 +1081,82 @@ void RenderGraphBackend::execute_copy_pass(RenderGraphFrameExecutor& executor, C
     }
     cgpu_cmd_resource_barrier(executor.gfx_cmd_buf, &late_barriers);
     cgpu_cmd_end_event(executor.gfx_cmd_buf);
-    deallocate_resources(pass);
 }
 
-void RenderGraphBackend::execute_present_pass(RenderGraphFrameExecutor& executor, PresentPassNode* pass) SKR_NOEXCEPT
+void RenderGraphBackend::execute_present_pass(RenderGraphFrameExecutor& executor, PresentPassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT
 {
-    auto               read_edges          = pass->tex_read_edges();
-    auto&&             read_edge           = read_edges[0];
-    auto               texture_target      = read_edge->get_texture_node();
-    auto               back_buffer         = pass->descriptor.swapchain->back_buffers[pass->descriptor.index];
-    CGPUTextureBarrier present_barrier     = {};
-    present_barrier.texture                = back_buffer;
-    present_barrier.src_state              = get_lastest_state(texture_target, pass);
-    present_barrier.dst_state              = CGPU_RESOURCE_STATE_PRESENT;
-    CGPUResourceBarrierDescriptor barriers = {};
+    const auto&                   present_barrier = prepared.tex_barriers[0];
+    CGPUResourceBarrierDescriptor barriers        = {};
     barriers.texture_barriers              = &present_barrier;
     barriers.texture_barriers_count        = 1;
     // 2023-9-21: 暂时修复 GUI 报错
-    if (present_barrier.src_state != present_barrier.dst_state)
+    if (present_barrier.src_state != present_barrier.dst_state || present_barrier.queue_acquire)
     {
         cgpu_cmd_resource_barrier(executor.gfx_cmd_buf, &barriers);
     }
 }
 
+void RenderGraphBackend::prepare_pass(RenderGraphFrameExecutor& executor, PassNode* pass, PreparedPass& prepared) SKR_NOEXCEPT
+{
+    prepared.tex_barriers.clear();
+    prepared.resolved_textures.clear();
+    prepared.buffer_barriers.clear();
+    prepared.resolved_buffers.clear();
+    if (pass->pass_type == EPassType::Present)
+    {
+        // the back buffer is imported, only its transition to present is needed
+        auto               present_pass    = static_cast<PresentPassNode*>(pass);
+        auto               texture_target  = present_pass->tex_read_edges()[0]->get_texture_node();
+        CGPUTextureBarrier present_barrier = {};
+        present_barrier.texture            = present_pass->descriptor.swapchain->back_buffers[present_pass->descriptor.index];
+        present_barrier.src_state          = latest_state(texture_target, pass, 0);
+        present_barrier.dst_state          = CGPU_RESOURCE_STATE_PRESENT;
+        if (queue_schedule.is_multi_queue())
+            transfer_ownership(texture_target, present_barrier);
+        prepared.tex_barriers.emplace(present_barrier);
+        return;
+    }
+    calculate_barriers(executor, pass,
+                       prepared.tex_barriers, prepared.resolved_textures,
+                       prepared.buffer_barriers, prepared.resolved_buffers);
+    deallocate_resources(pass);
+}
+
+void RenderGraphBackend::record_passes(RenderGraphFrameExecutor& executor, uint32_t first, uint32_t last, RenderGraphProfiler* profiler) SKR_NOEXCEPT
+{
+    for (uint32_t i = first; i < last; i++)
+    {
+        auto  pass     = passes[i];
+        auto& prepared = prepared_passes[i];
+        if (profiler) profiler->on_pass_begin(*this, executor, *pass);
+        if (pass->pass_type == EPassType::Render)
+            execute_render_pass(executor, static_cast<RenderPassNode*>(pass), prepared);
+        else if (pass->pass_type == EPassType::Present)
+            execute_present_pass(executor, static_cast<PresentPassNode*>(pass), prepared);
+        else if (pass->pass_type == EPassType::Compute)
+            execute_compute_pass(executor, static_cast<ComputePassNode*>(pass), prepared);
+        else if (pass->pass_type == EPassType::Copy)
+            execute_copy_pass(executor, static_cast<CopyPassNode*>(pass), prepared);
+        if (profiler) profiler->on_pass_end(*this, executor, *pass);
+    }
+}
+
+void RenderGraphBackend::record_segment(RenderGraphFrameExecutor& executor, uint32_t first, uint32_t last, const SegmentTransfers* transfers, RenderGraphProfiler* profiler) SKR_NOEXCEPT
+{
+    const auto transfer = [&executor](const stack_vector<CGPUTextureBarrier>& tex_barriers, const stack_vector<CGPUBufferBarrier>& buffer_barriers) {
+        if (tex_barriers.empty() && buffer_barriers.empty()) return;
+        CGPUResourceBarrierDescriptor barriers = {};
+        barriers.texture_barriers              = tex_barriers.data();
+        barriers.texture_barriers_count        = (uint32_t)tex_barriers.size();
+        barriers.buffer_barriers               = buffer_barriers.data();
+        barriers.buffer_barriers_count         = (uint32_t)buffer_barriers.size();
+        cgpu_cmd_resource_barrier(executor.gfx_cmd_buf, &barriers);
+    };
+    if (transfers) transfer(transfers->head_tex_barriers, transfers->head_buffer_barriers);
+    record_passes(executor, first, last, profiler);
+    if (transfers) transfer(transfers->tail_tex_barriers, transfers->tail_buffer_barriers);
+}
+
 uint64_t RenderGraphBackend::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
 {
     for (auto& phase : phases)
@@ -926,48 +1176,153 @@ uint64_t RenderGraphBackend::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
         SkrZoneScopedN("AcquireExecutor");
         cgpu_wait_fences(&executor.exec_fence, 1);
         if (profiler) profiler->on_acquire_executor(*this, executor);
+
+        // frames before safe_frame are done, the pools may free what those frames used last
+        const uint64_t safe_frame = frame_index >= RG_MAX_FRAME_IN_FLIGHT ? get_latest_finished_frame() + 1 : 0;
+        texture_pool.begin_frame(safe_frame, texture_pool_budget);
+        buffer_pool.begin_frame(safe_frame, buffer_pool_budget);
     }
     {
         SkrZoneScopedN("GraphExecutePasses");
-        executor.reset_begin(texture_view_pool);
+        executor.reset_begin(texture_view_pool, aliasing_enabled ? transient_plan : 0);
         if (profiler) profiler->on_cmd_begin(*this, executor);
+        skr::String frameLabel = skr::format(u8"Frame-{}", frame_index);
         {
             SkrZoneScopedN("GraphExecutorBeginEvent");
 
-            skr::String   frameLabel = skr::format(u8"Frame-{}", frame_index);
-            CGPUEventInfo event      = { (const char8_t*)frameLabel.c_str(), { 0.8f, 0.8f, 0.8f, 1.f } };
+            CGPUEventInfo event = { (const char8_t*)frameLabel.c_str(), { 0.8f, 0.8f, 0.8f, 1.f } };
             cgpu_cmd_begin_event(executor.gfx_cmd_buf, &event);
         }
-        for (auto& pass : passes)
+        const bool multi_queue = queue_schedule.is_multi_queue();
+        {
+            // resources are allocated & released in pass order, so barriers stay exact across segments
+            SkrZoneScopedN("GraphPreparePasses");
+            if (prepared_passes.size() < passes.size())
+                prepared_passes.add_default(passes.size() - prepared_passes.size());
+            if (multi_queue)
+            {
+                queue_owners.clear();
+                async_releases.clear();
+                segment_transfers.clear();
+                segment_transfers.add_default(queue_schedule.segments.size());
+                for (auto resource : resources)
+                {
+                    if (!resource->frame_async || resource->imported) continue;
+                    if (resource->type == EObjectType::Texture)
+                        resolve(executor, *static_cast<TextureNode*>(resource));
+                    else if (resource->type == EObjectType::Buffer)
+                        resolve(executor, *static_cast<BufferNode*>(resource));
+                }
+            }
+            for (uint32_t i = 0; i < passes.size(); i++)
+            {
+                if (!compile_cached)
+                {
+                    compiled_graph.pass_accesses.add((uint32_t)compiled_graph.accesses.size());
+                    compiled_graph.accesses.add_default(passes[i]->textures_count() + passes[i]->buffers_count());
+                }
+                executing_accesses = compiled_graph.pass_accesses[i];
+                executing_segment  = multi_queue ? pass_segments[i] : 0;
+                prepare_pass(executor, passes[i], prepared_passes[i]);
+            }
+            if (multi_queue)
+                return_ownership();
+        }
+        // a single queue is split evenly over the workers, async queues record one segment per queue segment.
+        // profilers are not required to be thread safe, a profiled frame is recorded on this thread
+        static constexpr uint32_t kMinPassesPerSegment = 16;
+        const uint32_t            pass_count           = (uint32_t)passes.size();
+        stack_vector<uint32_t>    segment_bounds;
+        stack_vector<CGPUQueueId> segment_queues;
+        if (multi_queue)
         {
-            if (pass->pass_type == EPassType::Render)
+            for (const auto& segment : queue_schedule.segments)
             {
-                if (profiler) profiler->on_pass_begin(*this, executor, *pass);
-                execute_render_pass(executor, static_cast<RenderPassNode*>(pass));
-                if (profiler) profiler->on_pass_end(*this, executor, *pass);
+                segment_bounds.add(segment.first_pass);
+                segment_queues.add(get_queue(segment.queue));
             }
-            else if (pass->pass_type == EPassType::Present)
+        }
+        else
+        {
+            uint32_t split = profiler ? 1 : recording_workers;
+            split          = cgpu_max(cgpu_min(split, pass_count / kMinPassesPerSegment), 1u);
+            for (uint32_t i = 0; i < split; i++)
             {
-                if (profiler) profiler->on_pass_begin(*this, executor, *pass);
-                execute_present_pass(executor, static_cast<PresentPassNode*>(pass));
-                if (profiler) profiler->on_pass_end(*this, executor, *pass);
+                segment_bounds.add(pass_count * i / split);
+                segment_queues.add(gfx_queue);
             }
-            else if (pass->pass_type == EPassType::Compute)
+        }
+        const uint32_t segment_count = (uint32_t)segment_bounds.size();
+        segment_bounds.add(pass_count);
+        executor.active_segments = segment_count - 1;
+        executor.wait_semaphores.clear();
+        executor.signal_semaphores.clear();
+        for (uint32_t i = 1; i < segment_count; i++)
+        {
+            if (executor.segment_executors.size() < i)
+                executor.segment_executors.add(SkrNew<RenderGraphFrameExecutor>());
+            auto segment_executor = executor.segment_executors[i - 1];
+            if (segment_executor->queue != segment_queues[i])
             {
-                if (profiler) profiler->on_pass_begin(*this, executor, *pass);
-                execute_compute_pass(executor, static_cast<ComputePassNode*>(pass));
-                if (profiler) profiler->on_pass_end(*this, executor, *pass);
+                segment_executor->finalize();
+                segment_executor->initialize(segment_queues[i], device, false);
             }
-            else if (pass->pass_type == EPassType::Copy)
+            segment_executor->wait_semaphores.clear();
+            segment_executor->signal_semaphores.clear();
+        }
+        if (multi_queue)
+        {
+            uint32_t semaphore_count = 0;
+            for (uint32_t i = 0; i < segment_count; i++)
             {
-                if (profiler) profiler->on_pass_begin(*this, executor, *pass);
-                execute_copy_pass(executor, static_cast<CopyPassNode*>(pass));
-                if (profiler) profiler->on_pass_end(*this, executor, *pass);
+                auto waiter = i ? executor.segment_executors[i - 1] : &executor;
+                for (const auto wait : queue_schedule.segments[i].waits)
+                {
+                    auto semaphore = executor.acquire_semaphore(device, semaphore_count++);
+                    auto signaler  = wait ? executor.segment_executors[wait - 1] : &executor;
+                    signaler->signal_semaphores.add(semaphore);
+                    waiter->wait_semaphores.add(semaphore);
+                }
             }
         }
+        const auto record = [&](uint32_t segment, RenderGraphProfiler* segment_profiler) {
+            const auto transfers = multi_queue ? &segment_transfers[segment] : nullptr;
+            if (segment == 0)
+            {
+                record_segment(executor, segment_bounds[0], segment_bounds[1], transfers, segment_profiler);
+                return;
+            }
+            auto& segment_executor = *executor.segment_executors[segment - 1];
+            segment_executor.reset_begin(texture_view_pool, 0);
+            CGPUEventInfo event = { (const char8_t*)frameLabel.c_str(), { 0.8f, 0.8f, 0.8f, 1.f } };
+            cgpu_cmd_begin_event(segment_executor.gfx_cmd_buf, &event);
+            record_segment(segment_executor, segment_bounds[segment], segment_bounds[segment + 1], transfers, segment_profiler);
+            cgpu_cmd_end_event(segment_executor.gfx_cmd_buf);
+            cgpu_cmd_end(segment_executor.gfx_cmd_buf);
+        };
+        if (segment_count > 1 && recording_workers > 1 && !profiler)
+        {
+            SkrZoneScopedN("GraphRecordSegments");
+            stack_vector<uint32_t> segments;
+            for (uint32_t i = 0; i < segment_count; i++)
+                segments.add(i);
+            skr::parallel_for(segments.data(), segments.data() + segment_count, 1,
+            [&](const uint32_t* begin, const uint32_t* end) {
+                for (auto it = begin; it != end; it++)
+                    record(*it, nullptr);
+            });
+        }
+        else
+        {
+            for (uint32_t i = 0; i < segment_count; i++)
+                record(i, profiler);
+        }
         {
             cgpu_cmd_end_event(executor.gfx_cmd_buf);
         }
+        // a plan invalidated while executing is recorded again by the next frame
+        if (!compile_cached)
+            compiled_graph.recorded = (compiled_graph.topology == topology_hash);
         if (profiler) profiler->on_cmd_end(*this, executor);
         cgpu_cmd_end(executor.gfx_cmd_buf);
     }
@@ -977,10 +1332,27 @@ uint64_t RenderGraphBackend::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
         if (profiler) profiler->before_commit(*this, executor);
         {
             SkrZoneScopedN("CGPUGfxQueueSubmit");
-            executor.commit(gfx_queue, frame_index);
+            executor.commit(frame_index);
         }
         if (profiler) profiler->after_commit(*this, executor);
     }
+    {
+        const auto& textures                   = texture_pool.get_statistics();
+        const auto& buffers                    = buffer_pool.get_statistics();
+        pool_statistics.texture_hits           = textures.hits;
+        pool_statistics.texture_oversized_hits = textures.oversized_hits;
+        pool_statistics.texture_misses         = textures.misses;
+        pool_statistics.buffer_hits            = buffers.hits;
+        pool_statistics.buffer_larger_hits     = buffers.larger_hits;
+        pool_statistics.buffer_misses          = buffers.misses;
+        pool_statistics.evicted_textures       = textures.evictions;
+        pool_statistics.evicted_buffers        = buffers.evictions;
+        pool_statistics.texture_bytes          = textures.bytes;
+        pool_statistics.texture_idle_bytes     = textures.idle_bytes;
+        pool_statistics.buffer_bytes           = buffers.bytes;
+        pool_statistics.buffer_idle_bytes      = buffers.idle_bytes;
+        if (profiler) profiler->on_resource_pools(*this, pool_statistics);
+    }
     {
         SkrZoneScopedN("GraphCleanup");
 
@@ -1011,70 +1383,270 @@ uint64_t RenderGraphBackend::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
     return frame_index++;
 }
 
-inline static bool aliasing_capacity(TextureNode* aliased, TextureNode* aliasing) SKR_NOEXCEPT
+inline static uint64_t align_up(uint64_t value, uint64_t alignment) SKR_NOEXCEPT
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// render targets, depth stencils & other textures may live in different memory types, keep them apart
+inline static uint32_t transient_heap_class(const CGPUTextureDescriptor& desc) SKR_NOEXCEPT
+{
+    uint32_t usage = 2;
+    if (FormatUtil_IsDepthStencilFormat(desc.format))
+        usage = 1;
+    else if (desc.descriptors & CGPU_RESOURCE_TYPE_RENDER_TARGET)
+        usage = 0;
+    return usage | ((uint32_t)desc.sample_count << 4);
+}
+
+// cgpu has no raw memory heaps, each heap is a texture of the heap class large enough to hold the plan
+inline static CGPUTextureDescriptor transient_heap_descriptor(const CGPUTextureDescriptor& largest, uint64_t heap_size) SKR_NOEXCEPT
+{
+    static constexpr uint64_t kMaxHeapExtent = 16384;
+
+    CGPUTextureDescriptor desc = largest;
+    desc.name                  = u8"RenderGraphTransientHeap";
+    desc.native_handle         = nullptr;
+    desc.flags &= ~CGPU_TCF_ALIASING_RESOURCE;
+    if ((desc.descriptors & CGPU_RESOURCE_TYPE_TEXTURE_CUBE) == CGPU_RESOURCE_TYPE_TEXTURE_CUBE)
+        desc.descriptors = (desc.descriptors & ~CGPU_RESOURCE_TYPE_TEXTURE_CUBE) | CGPU_RESOURCE_TYPE_TEXTURE;
+    desc.depth      = 1;
+    desc.mip_levels = 1;
+
+    const uint64_t texel_size = cgpu_max(FormatUtil_BitSizeOfBlock(desc.format) / 8, 1) * cgpu_max((uint64_t)desc.sample_count, 1);
+    const uint64_t width      = cgpu_max(desc.width, 1);
+    const uint64_t rows       = (heap_size + width * texel_size - 1) / (width * texel_size);
+    desc.height               = cgpu_min(rows, kMaxHeapExtent);
+    desc.array_size           = (uint32_t)((rows + kMaxHeapExtent - 1) / kMaxHeapExtent);
+    return desc;
+}
+
+void RenderGraphBackend::plan_transient_memory() SKR_NOEXCEPT
+{
+    SkrZoneScopedN("CalculateAliasing");
+    static constexpr uint64_t kTransientHeapSize   = 256ull * 1024 * 1024;
+    static constexpr uint64_t kPlacementAlignment  = 64ull * 1024;
+    static constexpr uint64_t kMSAAPlacementAlignment = 4ull * 1024 * 1024;
+
+    stack_vector<TextureNode*> planned_textures;
+    texture_planner.reset();
+    buffer_planner.reset();
+    for (auto resource : resources)
+    {
+        const auto lifespan = resource->lifespan();
+        if (resource->is_imported() || lifespan.from > lifespan.to) continue;
+        if (resource->type == EObjectType::Texture)
+        {
+            auto texture = static_cast<TextureNode*>(resource);
+            if (texture->descriptor.is_restrict_dedicated || texture->frame_async) continue;
+            texture->descriptor.flags |= CGPU_TCF_ALIASING_RESOURCE;
+
+            const auto     texture_key  = (size_t)make_zeroed<TexturePool::Key>(device, texture->descriptor);
+            const uint64_t sample_count = cgpu_max((uint64_t)texture->get_sample_count(), 1);
+            const uint64_t alignment    = (sample_count > 1) ? kMSAAPlacementAlignment : kPlacementAlignment;
+            uint64_t       size         = texture->get_size() / 8 * sample_count;
+            if (auto measured = measured_texture_sizes.find(texture_key); measured != measured_texture_sizes.end())
+                size = cgpu_max(size, measured->second);
+            texture_planner.add({ align_up(size, alignment), alignment, lifespan.from, lifespan.to, transient_heap_class(texture->descriptor) });
+            planned_textures.add(texture);
+        }
+        else if (resource->type == EObjectType::Buffer)
+        {
+            // planned for the statistics only, placed buffers need an api cgpu does not have yet
+            auto buffer = static_cast<BufferNode*>(resource);
+            buffer_planner.add({ align_up(buffer->descriptor.size, kPlacementAlignment), kPlacementAlignment,
+                lifespan.from, lifespan.to, (uint32_t)buffer->descriptor.memory_usage });
+        }
+    }
+
+    // the plan is a pure function of the requests, replan only when the graph shape changes
+    const uint64_t plan = texture_planner.shape_hash();
+    if (plan != transient_plan)
+    {
+        SkrZoneScopedN("ReplanTransientMemory");
+        texture_planner.plan(kTransientHeapSize);
+        buffer_planner.plan(kTransientHeapSize);
+        transient_plan = plan;
+        transient_heap_descs.clear();
+        for (const auto& heap : texture_planner.get_heaps())
+        {
+            const auto& largest = planned_textures[heap.largest_request]->descriptor;
+            transient_heap_descs.add(transient_heap_descriptor(largest, heap.size));
+        }
+
+        const auto& texture_stats = texture_planner.get_statistics();
+        const auto& buffer_stats  = buffer_planner.get_statistics();
+        transient_statistics.texture_requested_bytes = texture_stats.requested_bytes;
+        transient_statistics.texture_heap_bytes      = texture_stats.heap_bytes;
+        transient_statistics.buffer_requested_bytes  = buffer_stats.requested_bytes;
+        transient_statistics.buffer_heap_bytes       = buffer_stats.heap_bytes;
+        transient_statistics.heap_count              = texture_stats.heap_count;
+        transient_statistics.replan_count++;
+        SKR_LOG_DEBUG(u8"RenderGraph transient memory: %u textures in %u heaps, %.2f MB saved",
+            texture_stats.request_count, texture_stats.heap_count, (double)transient_statistics.saved_bytes() / (1024.0 * 1024.0));
+    }
+
+    const auto& placements = texture_planner.get_placements();
+    for (uint32_t i = 0; i < planned_textures.size(); i++)
+    {
+        planned_textures[i]->frame_heap        = placements[i].heap;
+        planned_textures[i]->frame_heap_offset = placements[i].offset;
+    }
+}
+
+void RenderGraphBackend::apply_compiled_placements() SKR_NOEXCEPT
+{
+    SkrZoneScopedN("ApplyCompiledPlacements");
+    for (uint32_t i = 0; i < resources.size(); i++)
+    {
+        const auto& placement = compiled_graph.placements[i];
+        if (placement.heap == TransientMemoryPlanner::kInvalidHeap) continue;
+        auto texture = static_cast<TextureNode*>(resources[i]);
+        texture->descriptor.flags |= CGPU_TCF_ALIASING_RESOURCE;
+        texture->frame_heap        = placement.heap;
+        texture->frame_heap_offset = placement.offset;
+    }
+}
+
+CGPUQueueId RenderGraphBackend::get_queue(ECGPUQueueType type) const SKR_NOEXCEPT
 {
-    return !aliased->is_imported() &&
-           !aliased->get_desc().is_restrict_dedicated &&
-           aliased->get_size() >= aliasing->get_size() &&
-           aliased->get_sample_count() == aliasing->get_sample_count();
+    switch (type)
+    {
+        case CGPU_QUEUE_TYPE_COMPUTE:
+            return cmpt_queue;
+        case CGPU_QUEUE_TYPE_TRANSFER:
+            return cpy_queue;
+        default:
+            return gfx_queue;
+    }
 }
 
+void RenderGraphBackend::schedule_queues() SKR_NOEXCEPT
+{
+    SkrZoneScopedN("ScheduleQueues");
+    auto& segments = queue_schedule.segments;
+    segments.clear();
+    pass_segments.clear();
+    home_segments.clear();
+
+    // the first segment is graphics even if empty, resources enter async segments from a graphics one
+    segments.add_default();
+    for (uint32_t i = 0; i < passes.size(); i++)
+    {
+        const auto pass     = passes[i];
+        const auto affinity = pass->get_queue_affinity();
+        auto       queue    = CGPU_QUEUE_TYPE_GRAPHICS;
+        if (pass->pass_type == EPassType::Compute && affinity == CGPU_QUEUE_TYPE_COMPUTE && cmpt_queue)
+            queue = affinity;
+        else if (pass->pass_type == EPassType::Copy && affinity != CGPU_QUEUE_TYPE_GRAPHICS && get_queue(affinity))
+            queue = affinity;
+        if (segments.last().queue != queue)
+        {
+            auto& segment      = segments.add_default().ref();
+            segment.queue      = queue;
+            segment.first_pass = i;
+        }
+        segments.last().last_pass = i + 1;
+        pass_segments.add((uint32_t)segments.size() - 1);
+    }
+    if (segments.size() == 1) return;
+
+    // the last segment joins the async queues back into graphics, its submit signals the frame fence
+    const uint32_t pass_count = (uint32_t)passes.size();
+    auto&          join       = segments.add_default().ref();
+    join.first_pass           = pass_count;
+    join.last_pass            = pass_count;
+    for (uint32_t i = 0; i < segments.size(); i++)
+        home_segments.add(segments[i].queue == CGPU_QUEUE_TYPE_GRAPHICS ? i : home_segments[i - 1]);
+
+    const auto depend = [&segments](uint32_t segment, uint32_t on) {
+        if (segments[segment].queue == segments[on].queue) return;
+        if (!segments[segment].waits.contains(on))
+            segments[segment].waits.add(on);
+    };
+    skr::FlatHashMap<const ResourceNode*, uint32_t> owners;
+    const auto access = [&](ResourceNode* resource, uint32_t segment) {
+        auto found = owners.find(resource);
+        const uint32_t owner = (found != owners.end()) ? found->second : home_segments[segment];
+        if (segments[owner].queue != segments[segment].queue)
+        {
+            resource->frame_async = true;
+            depend(segment, owner);
+        }
+        owners[resource] = segment;
+    };
+    for (uint32_t i = 0; i < pass_count; i++)
+    {
+        passes[i]->foreach_textures([&](TextureNode* texture, TextureEdge*) { access(texture, pass_segments[i]); });
+        passes[i]->foreach_buffers([&](BufferNode* buffer, BufferEdge*) { access(buffer, pass_segments[i]); });
+    }
+    const uint32_t join_index = (uint32_t)segments.size() - 1;
+    for (auto&& [resource, owner] : owners)
+        depend(join_index, owner);
+    // waiting for the last segment of every queue makes the frame fence cover all of them
+    for (uint32_t i = 0; i < join_index; i++)
+    {
+        bool last_of_queue = true;
+        for (uint32_t j = i + 1; j < join_index; j++)
+            last_of_queue = last_of_queue && (segments[j].queue != segments[i].queue);
+        if (last_of_queue) depend(join_index, i);
+    }
+}
+
+// compile cache:
+// - the frame's topology is hashed before anything else, a hash recorded by an earlier frame skips
+//   the adjacency build, culling, lifespans, transient planning & the barrier / last user searches
+// - executors & imported resources are still bound per frame, the replay only patches them in
 bool RenderGraphBackend::compile() SKR_NOEXCEPT
 {
-    RenderGraph::compile();
+    topology_hash  = calculate_topology_hash();
+    compile_cached = compile_cache_enabled && compiled_graph.recorded && (compiled_graph.topology == topology_hash);
+    if (!compile_cached)
+    {
+        compiled_graph.topology = topology_hash;
+        compiled_graph.recorded = false;
+        compiled_graph.pass_accesses.clear();
+        compiled_graph.accesses.clear();
+        compiled_graph.placements.clear();
+        // topology is final from here, pack adjacency once instead of on the first query
+        graph->build();
+    }
 
     for (auto& phase : phases)
         phase->on_compile(this);
 
     SkrZoneScopedN("RenderGraphCompile");
-    if (aliasing_enabled)
-    {
-        SkrZoneScopedN("CalculateAliasing");
-        // 2.calc aliasing
-        // - 先在aliasing chain里找一圈，如果有不重合的，直接把它加入到aliasing chain里
-        // - 如果没找到，在所有resource中找一个合适的加入到aliasing chain
-        skr::BTreeMap<TextureNode*, TextureNode::LifeSpan> alliasing_lifespans;
-        foreach_textures([&](TextureNode* texture) SKR_NOEXCEPT {
-            if (texture->imported) return;
-            for (auto&& [aliased, aliaed_span] : alliasing_lifespans)
-            {
-                if (aliasing_capacity(aliased, texture) &&
-                    aliaed_span.to < texture->lifespan().from)
-                {
-                    if (!texture->frame_aliasing_source ||
-                        texture->frame_aliasing_source->get_size() > aliased->get_size() // always choose smallest block
-                    )
-                    {
-                        texture->descriptor.flags |= CGPU_TCF_ALIASING_RESOURCE;
-                        texture->frame_aliasing_source = aliased;
-                        aliaed_span.to                 = texture->lifespan().to;
-                    }
-                }
-            }
-            if (texture->frame_aliasing_source) return;
-            foreach_textures([&](TextureNode* aliased) SKR_NOEXCEPT {
-                if (texture == aliased) return;
-
-                const auto lifespan         = texture->lifespan();
-                const auto aliased_lifespan = aliased->lifespan();
-                if (aliasing_capacity(aliased, texture) && aliased_lifespan.to < lifespan.from)
-                {
-                    if (!texture->frame_aliasing_source ||
-                        texture->frame_aliasing_source->get_size() > aliased->get_size() // always choose smallest block
-                    )
-                    {
-                        texture->descriptor.flags |= CGPU_TCF_ALIASING_RESOURCE;
-                        texture->frame_aliasing_source    = aliased;
-                        alliasing_lifespans[aliased].from = aliased->lifespan().from;
-                        alliasing_lifespans[aliased].to   = aliased->lifespan().from;
-                    }
-                }
-            });
-        });
+    schedule_queues();
+    transient_statistics.placed_textures   = 0;
+    transient_statistics.fallback_textures = 0;
+    if (aliasing_enabled && compile_cached)
+    {
+        apply_compiled_placements();
+    }
+    else if (aliasing_enabled)
+    {
+        plan_transient_memory();
+        for (auto resource : resources)
+        {
+            auto& placement = compiled_graph.placements.add_default().ref();
+            if (resource->type != EObjectType::Texture) continue;
+            placement.heap   = static_cast<TextureNode*>(resource)->frame_heap;
+            placement.offset = static_cast<TextureNode*>(resource)->frame_heap_offset;
+        }
     }
     return true;
 }
 
+const TransientMemoryStatistics* RenderGraphBackend::get_transient_memory_statistics() const SKR_NOEXCEPT
+{
+    return aliasing_enabled ? &transient_statistics : nullptr;
+}
+
+const ResourcePoolStatistics* RenderGraphBackend::get_resource_pool_statistics() const SKR_NOEXCEPT
+{
+    return &pool_statistics;
+}
+
 CGPUDeviceId RenderGraphBackend::get_backend_device() SKR_NOEXCEPT { return device; }
 
 uint32_t RenderGraphBackend::collect_garbage(uint64_t critical_frame,
@@ -1095,28 +1667,7 @@ uint32_t RenderGraphBackend::collect_texture_garbage(uint64_t critical_frame, ui
                       "\n\tcurrent: %d, latest finished: %d",
                       critical_frame, get_latest_finished_frame());
     }
-    uint32_t total_count = 0;
-    for (auto&& [key, queue] : texture_pool.textures)
-    {
-        for (auto&& pooled : queue)
-        {
-            if (pooled.mark.frame_index <= critical_frame && (pooled.mark.tags & with_tags) && !(pooled.mark.tags & without_tags))
-            {
-                texture_view_pool.erase(pooled.texture);
-                cgpu_free_texture(pooled.texture);
-                pooled.texture = nullptr;
-            }
-        }
-        uint32_t prev_count = (uint32_t)queue.size();
-        queue.erase(
-        std::remove_if(queue.begin(), queue.end(),
-                         [&](auto& element) {
-                             return element.texture == nullptr;
-                         }),
-        queue.end());
-        total_count += prev_count - (uint32_t)queue.size();
-    }
-    return total_count;
+    return texture_pool.collect_garbage(critical_frame, with_tags, without_tags);
 }
 
 uint32_t RenderGraphBackend::collect_buffer_garbage(uint64_t critical_frame, uint32_t with_tags, uint32_t without_tags) SKR_NOEXCEPT
@@ -1130,27 +1681,7 @@ uint32_t RenderGraphBackend::collect_buffer_garbage(uint64_t critical_frame, uin
                       "\n\tcurrent: %d, latest finished: %d",
                       critical_frame, get_latest_finished_frame());
     }
-    uint32_t total_count = 0;
-    for (auto&& [key, queue] : buffer_pool.buffers)
-    {
-        for (auto&& pooled : queue)
-        {
-            if (pooled.mark.frame_index <= critical_frame && (pooled.mark.tags & with_tags) && !(pooled.mark.tags & without_tags))
-            {
-                cgpu_free_buffer(pooled.buffer);
-                pooled.buffer = nullptr;
-            }
-        }
-        uint32_t prev_count = (uint32_t)queue.size();
-        queue.erase(
-        std::remove_if(queue.begin(), queue.end(),
-                         [&](auto& element) {
-                             return element.buffer == nullptr;
-                         }),
-        queue.end());
-        total_count += prev_count - (uint32_t)queue.size();
-    }
-    return total_count;
+    return buffer_pool.collect_garbage(critical_frame, with_tags, without_tags);
 }
 } // namespace render_graph
 } // namespace skr
\ No newline at end of file
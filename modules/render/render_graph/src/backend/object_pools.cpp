@@ -1,11 +1,15 @@
 #include "SkrBase/misc/debug.h"
 #include "SkrBase/misc/hash.h"
 #include "SkrBase/misc/make_zeroed.hpp"
+#include "SkrBase/misc/bit.hpp"
+#include "SkrContainers/vector.hpp"
+#include "SkrProfile/profile.h"
 
 #include "SkrRenderGraph/backend/bind_table_pool.hpp"
 #include "SkrRenderGraph/backend/buffer_pool.hpp"
 #include "SkrRenderGraph/backend/texture_pool.hpp"
 #include "SkrRenderGraph/backend/texture_view_pool.hpp"
+#include <algorithm>
 
 namespace skr
 {
@@ -172,9 +176,24 @@ TexturePool::Key::operator size_t() const
     return skr_hash(this, sizeof(*this), (size_t)device);
 }
 
-void TexturePool::initialize(CGPUDeviceId device_)
+// 4 classes per octave, rounding up to the class wastes less than a quarter
+static uint64_t size_class(uint64_t value)
 {
-    device = device_;
+    if (value <= 4) return value;
+    const uint64_t step = skr::bit_floor(value) / 4;
+    return (value + step - 1) / step * step;
+}
+
+static void to_resolution_bucket(TexturePool::Key& key)
+{
+    key.width  = size_class(key.width);
+    key.height = size_class(key.height);
+}
+
+void TexturePool::initialize(CGPUDeviceId device_, TextureViewPool* texture_views_)
+{
+    device        = device_;
+    texture_views = texture_views_;
 }
 
 void TexturePool::finalize()
@@ -189,31 +208,139 @@ void TexturePool::finalize()
     }
 }
 
-std::pair<CGPUTextureId, ECGPUResourceState> TexturePool::allocate(const CGPUTextureDescriptor& desc, AllocationMark mark)
+void TexturePool::begin_frame(uint64_t safe_frame_, uint64_t budget_)
+{
+    safe_frame                = safe_frame_;
+    budget                    = budget_;
+    statistics.hits           = 0;
+    statistics.oversized_hits = 0;
+    statistics.misses         = 0;
+    statistics.evictions      = 0;
+    if (budget && statistics.bytes > budget) evict();
+}
+
+std::pair<CGPUTextureId, ECGPUResourceState> TexturePool::allocate(const CGPUTextureDescriptor& desc, AllocationMark mark, bool oversized)
 {
-    std::pair<CGPUTextureId, ECGPUResourceState> allocated = {
-        nullptr, CGPU_RESOURCE_STATE_UNDEFINED
-    };
     auto key = make_zeroed<TexturePool::Key>(device, desc);
-    if (textures[key].empty())
+    to_resolution_bucket(key);
+    auto& queue = textures[key];
+    auto  found = queue.end();
+    bool  exact = false;
+    for (auto iter = queue.begin(); iter != queue.end(); ++iter)
     {
-        auto new_tex = cgpu_create_texture(device, &desc);
-        textures[key].emplace_back(new_tex, desc.start_state, mark);
+        const auto info = iter->texture->info;
+        if (info->width == desc.width && info->height == desc.height)
+        {
+            found = iter;
+            exact = true;
+            break;
+        }
+        if (oversized && found == queue.end() && info->width >= desc.width && info->height >= desc.height)
+            found = iter;
+    }
+    if (found != queue.end())
+    {
+        std::pair<CGPUTextureId, ECGPUResourceState> allocated = { found->texture, found->state };
+        statistics.idle_bytes -= found->texture->info->size_in_bytes;
+        statistics.hits++;
+        if (!exact) statistics.oversized_hits++;
+        queue.erase(found);
+        return allocated;
     }
-    textures[key].front().mark = mark;
-    allocated                  = { textures[key].front().texture, textures[key].front().state };
-    textures[key].pop_front();
-    return allocated;
+
+    CGPUTextureId new_tex = nullptr;
+    if (oversized)
+    {
+        auto bucket_desc   = desc;
+        bucket_desc.width  = key.width;
+        bucket_desc.height = key.height;
+        new_tex            = cgpu_create_texture(device, &bucket_desc);
+    }
+    else
+    {
+        new_tex = cgpu_create_texture(device, &desc);
+    }
+    statistics.misses++;
+    statistics.bytes += new_tex->info->size_in_bytes;
+    if (budget && statistics.bytes > budget) evict();
+    return { new_tex, desc.start_state };
 }
 
 void TexturePool::deallocate(const CGPUTextureDescriptor& desc, CGPUTextureId texture, ECGPUResourceState final_state, AllocationMark mark)
 {
     auto key = make_zeroed<TexturePool::Key>(device, desc);
-    for (auto&& iter : textures[key])
+    to_resolution_bucket(key);
+    auto& queue = textures[key];
+    for (auto&& iter : queue)
     {
         if (iter.texture == texture) return;
     }
-    textures[key].emplace_back(texture, final_state, mark);
+    queue.emplace_back(texture, final_state, mark);
+    statistics.idle_bytes += texture->info->size_in_bytes;
+}
+
+void TexturePool::free_pooled(PooledTexture& pooled)
+{
+    const auto size = pooled.texture->info->size_in_bytes;
+    statistics.bytes -= size;
+    statistics.idle_bytes -= size;
+    if (texture_views) texture_views->erase(pooled.texture);
+    cgpu_free_texture(pooled.texture);
+    pooled.texture = nullptr;
+}
+
+template <typename Queue, typename Pooled, typename Resource>
+static uint32_t erase_freed(Queue& queue, Resource Pooled::*resource)
+{
+    const uint32_t prev_count = (uint32_t)queue.size();
+    queue.erase(std::remove_if(queue.begin(), queue.end(), [resource](const Pooled& element) { return element.*resource == nullptr; }), queue.end());
+    return prev_count - (uint32_t)queue.size();
+}
+
+uint32_t TexturePool::collect_garbage(uint64_t critical_frame, uint32_t with_tags, uint32_t without_tags)
+{
+    uint32_t total_count = 0;
+    for (auto&& [key, queue] : textures)
+    {
+        for (auto&& pooled : queue)
+        {
+            if (pooled.mark.frame_index <= critical_frame && (pooled.mark.tags & with_tags) && !(pooled.mark.tags & without_tags))
+                free_pooled(pooled);
+        }
+        total_count += erase_freed(queue, &PooledTexture::texture);
+    }
+    return total_count;
+}
+
+// least recently used first, only what no frame in flight can still reference
+uint32_t TexturePool::evict()
+{
+    SkrZoneScopedN("EvictPooledTextures");
+    skr::Vector<PooledTexture*> candidates;
+    for (auto&& [key, queue] : textures)
+    {
+        for (auto&& pooled : queue)
+        {
+            if (pooled.mark.frame_index < safe_frame) candidates.add(&pooled);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const PooledTexture* a, const PooledTexture* b) {
+        return a->mark.frame_index < b->mark.frame_index;
+    });
+    uint32_t count = 0;
+    for (auto pooled : candidates)
+    {
+        if (statistics.bytes <= budget) break;
+        free_pooled(*pooled);
+        count++;
+    }
+    if (count)
+    {
+        for (auto&& [key, queue] : textures)
+            erase_freed(queue, &PooledTexture::texture);
+    }
+    statistics.evictions += count;
+    return count;
 }
 
 // Texture View Pool
@@ -276,6 +403,7 @@ void TextureViewPool::finalize()
 CGPUTextureViewId TextureViewPool::allocate(const CGPUTextureViewDescriptor& desc, uint64_t frame_index)
 {
     const auto key = make_zeroed<TextureViewPool::Key>(device, desc);
+    SMutexLock lock(mutex.mMutex);
     if (auto found = views.find(key))
     {
         // SKR_LOG_TRACE(u8"Reallocating texture view for texture %p (id %lld, old %lld)", desc.texture,
@@ -305,6 +433,7 @@ BufferPool::Key::Key(CGPUDeviceId device, const CGPUBufferDescriptor& desc)
     , first_element(desc.first_element)
     , elemet_count(desc.elemet_count)
     , element_stride(desc.element_stride)
+    , size(size_class(desc.size))
 {
 }
 
@@ -330,47 +459,115 @@ void BufferPool::finalize()
     }
 }
 
+void BufferPool::begin_frame(uint64_t safe_frame_, uint64_t budget_)
+{
+    safe_frame             = safe_frame_;
+    budget                 = budget_;
+    statistics.hits        = 0;
+    statistics.larger_hits = 0;
+    statistics.misses      = 0;
+    statistics.evictions   = 0;
+    if (budget && statistics.bytes > budget) evict();
+}
+
 std::pair<CGPUBufferId, ECGPUResourceState> BufferPool::allocate(const CGPUBufferDescriptor& desc, AllocationMark mark, uint64_t min_frame_index)
 {
-    std::pair<CGPUBufferId, ECGPUResourceState> allocated = {
-        nullptr, CGPU_RESOURCE_STATE_UNDEFINED
-    };
-    auto    key         = make_zeroed<BufferPool::Key>(device, desc);
-    int32_t found_index = -1;
-    for (uint32_t i = 0; i < buffers[key].size(); ++i)
+    auto           key        = make_zeroed<BufferPool::Key>(device, desc);
+    const uint64_t class_size = key.size;
+    for (uint32_t reach = 0; reach <= kLargerClassReach; reach++, key.size = size_class(key.size + 1))
     {
-        auto&& pooled = buffers[key][i];
-        if (pooled.mark.frame_index < min_frame_index && pooled.buffer->info->size >= desc.size)
+        auto found = buffers.find(key);
+        if (found == buffers.end()) continue;
+        auto& queue = found->second;
+        for (auto iter = queue.begin(); iter != queue.end(); ++iter)
         {
-            found_index = i;
-            break;
+            if (iter->mark.frame_index < min_frame_index && iter->buffer->info->size >= desc.size)
+            {
+                std::pair<CGPUBufferId, ECGPUResourceState> allocated = { iter->buffer, iter->state };
+                statistics.idle_bytes -= iter->buffer->info->size;
+                statistics.hits++;
+                if (reach) statistics.larger_hits++;
+                queue.erase(iter);
+                return allocated;
+            }
         }
     }
-    if (found_index > 0)
-    {
-        PooledBuffer found = buffers[key][found_index];
-        buffers[key].erase(buffers[key].begin() + found_index);
-        buffers[key].emplace_front(found.buffer, found.state, mark);
-    }
-    if (found_index < 0)
-    {
-        auto new_buffer = cgpu_create_buffer(device, &desc);
-        buffers[key].emplace_front(new_buffer, desc.start_state, mark);
-    }
-    allocated = { buffers[key].front().buffer, buffers[key].front().state };
-    buffers[key].pop_front();
-    return allocated;
+
+    auto class_desc = desc;
+    class_desc.size = class_size > desc.size ? class_size : desc.size;
+    auto new_buffer = cgpu_create_buffer(device, &class_desc);
+    statistics.misses++;
+    statistics.bytes += new_buffer->info->size;
+    if (budget && statistics.bytes > budget) evict();
+    return { new_buffer, desc.start_state };
 }
 
 void BufferPool::deallocate(const CGPUBufferDescriptor& desc, CGPUBufferId buffer, ECGPUResourceState final_state, AllocationMark mark)
 {
+    // back to the class of its own size, which may be above the class of the request
     auto key = make_zeroed<BufferPool::Key>(device, desc);
-    for (auto&& iter : buffers[key])
+    key.size = size_class(buffer->info->size);
+    auto& queue = buffers[key];
+    for (auto&& iter : queue)
     {
         if (iter.buffer == buffer)
             return;
     }
-    buffers[key].emplace_back(buffer, final_state, mark);
+    queue.emplace_back(buffer, final_state, mark);
+    statistics.idle_bytes += buffer->info->size;
+}
+
+void BufferPool::free_pooled(PooledBuffer& pooled)
+{
+    statistics.bytes -= pooled.buffer->info->size;
+    statistics.idle_bytes -= pooled.buffer->info->size;
+    cgpu_free_buffer(pooled.buffer);
+    pooled.buffer = nullptr;
+}
+
+uint32_t BufferPool::collect_garbage(uint64_t critical_frame, uint32_t with_tags, uint32_t without_tags)
+{
+    uint32_t total_count = 0;
+    for (auto&& [key, queue] : buffers)
+    {
+        for (auto&& pooled : queue)
+        {
+            if (pooled.mark.frame_index <= critical_frame && (pooled.mark.tags & with_tags) && !(pooled.mark.tags & without_tags))
+                free_pooled(pooled);
+        }
+        total_count += erase_freed(queue, &PooledBuffer::buffer);
+    }
+    return total_count;
+}
+
+uint32_t BufferPool::evict()
+{
+    SkrZoneScopedN("EvictPooledBuffers");
+    skr::Vector<PooledBuffer*> candidates;
+    for (auto&& [key, queue] : buffers)
+    {
+        for (auto&& pooled : queue)
+        {
+            if (pooled.mark.frame_index < safe_frame) candidates.add(&pooled);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const PooledBuffer* a, const PooledBuffer* b) {
+        return a->mark.frame_index < b->mark.frame_index;
+    });
+    uint32_t count = 0;
+    for (auto pooled : candidates)
+    {
+        if (statistics.bytes <= budget) break;
+        free_pooled(*pooled);
+        count++;
+    }
+    if (count)
+    {
+        for (auto&& [key, queue] : buffers)
+            erase_freed(queue, &PooledBuffer::buffer);
+    }
+    statistics.evictions += count;
+    return count;
 }
 
 } // namespace render_graph
@@ -0,0 +1,177 @@
+#include "SkrBase/misc/debug.h"
+#include "SkrBase/misc/hash.h"
+#include "SkrRenderGraph/backend/transient_memory_planner.hpp"
+
+#include "SkrProfile/profile.h"
+
+namespace skr
+{
+namespace render_graph
+{
+inline static uint64_t align_up(uint64_t value, uint64_t alignment) SKR_NOEXCEPT
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void TransientMemoryPlanner::reset() SKR_NOEXCEPT
+{
+    requests.clear();
+}
+
+uint32_t TransientMemoryPlanner::add(const Request& request) SKR_NOEXCEPT
+{
+    SKR_ASSERT(request.first_pass <= request.last_pass);
+    requests.add(request);
+    return (uint32_t)requests.size() - 1;
+}
+
+uint64_t TransientMemoryPlanner::shape_hash() const SKR_NOEXCEPT
+{
+    uint64_t hash = SKR_DEFAULT_HASH_SEED_64;
+    for (const auto& request : requests)
+    {
+        const uint64_t packed[4] = {
+            request.size,
+            request.alignment,
+            (uint64_t)request.first_pass << 32 | request.last_pass,
+            request.heap_class
+        };
+        hash = skr_hash64(packed, sizeof(packed), hash);
+    }
+    return hash;
+}
+
+void TransientMemoryPlanner::plan(uint64_t max_heap_size) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("PlanTransientMemory");
+    const uint32_t request_count = (uint32_t)requests.size();
+    uint32_t       last_pass     = 0;
+    for (const auto& request : requests)
+        last_pass = (last_pass > request.last_pass) ? last_pass : request.last_pass;
+    placements.clear();
+    placements.add_default(request_count);
+    heaps.clear();
+    for (auto& bucket : buckets)
+        bucket.clear();
+    if (buckets.size() <= last_pass / kPassesPerBucket)
+        buckets.add_default(last_pass / kPassesPerBucket + 1 - buckets.size());
+    statistics = {};
+
+    // largest first, ties broken by lifetime then submission order to keep plans stable
+    order.clear();
+    order.reserve(request_count);
+    for (uint32_t i = 0; i < request_count; i++)
+        order.add(i);
+    order.sort([this](uint32_t a, uint32_t b) {
+        const auto& ra = requests[a];
+        const auto& rb = requests[b];
+        if (ra.size != rb.size) return ra.size > rb.size;
+        if (ra.first_pass != rb.first_pass) return ra.first_pass < rb.first_pass;
+        return a < b;
+    });
+
+    for (const auto index : order)
+    {
+        const auto&    request   = requests[index];
+        const uint64_t alignment = request.alignment ? request.alignment : 1;
+
+        // placed requests of the same class alive together with this one, by heap then offset
+        overlapped.clear();
+        for (uint32_t b = request.first_pass / kPassesPerBucket; b <= request.last_pass / kPassesPerBucket; b++)
+        {
+            for (const auto other_index : buckets[b])
+            {
+                const auto& other = requests[other_index];
+                if (other.heap_class != request.heap_class) continue;
+                if (other.first_pass <= request.last_pass && request.first_pass <= other.last_pass)
+                    overlapped.add(other_index);
+            }
+        }
+        overlapped.sort([this](uint32_t a, uint32_t b) {
+            const auto& pa = placements[a];
+            const auto& pb = placements[b];
+            if (pa.heap != pb.heap) return pa.heap < pb.heap;
+            if (pa.offset != pb.offset) return pa.offset < pb.offset;
+            return a < b;
+        });
+
+        // fitting into an existing gap wins over growing a heap, smallest leftover / growth first
+        uint32_t best_heap   = kInvalidHeap;
+        uint64_t best_offset = 0;
+        uint64_t best_cost   = UINT64_MAX;
+        bool     best_grows  = true;
+        uint32_t cursor_idx  = 0;
+        for (uint32_t h = 0; h < heaps.size() && (best_grows || best_cost); h++)
+        {
+            const auto& heap = heaps[h];
+            if (heap.heap_class != request.heap_class) continue;
+
+            uint64_t cursor = 0;
+            uint32_t last   = UINT32_MAX;
+            for (; cursor_idx < overlapped.size() && placements[overlapped[cursor_idx]].heap == h; cursor_idx++)
+            {
+                // a request spanning several buckets is gathered once per bucket
+                const auto other_index = overlapped[cursor_idx];
+                if (other_index == last) continue;
+                last = other_index;
+
+                const auto&    placed = placements[other_index];
+                const uint64_t offset = align_up(cursor, alignment);
+                if (placed.offset >= offset + request.size)
+                {
+                    const uint64_t waste = placed.offset - offset - request.size;
+                    if (best_grows || waste < best_cost)
+                    {
+                        best_heap   = h;
+                        best_offset = offset;
+                        best_cost   = waste;
+                        best_grows  = false;
+                    }
+                }
+                const uint64_t end = placed.offset + requests[other_index].size;
+                cursor             = (cursor > end) ? cursor : end;
+            }
+            const uint64_t offset = align_up(cursor, alignment);
+            const uint64_t end    = offset + request.size;
+            if (end <= heap.size)
+            {
+                const uint64_t waste = heap.size - end;
+                if (best_grows || waste < best_cost)
+                {
+                    best_heap   = h;
+                    best_offset = offset;
+                    best_cost   = waste;
+                    best_grows  = false;
+                }
+            }
+            else if (end <= max_heap_size && best_grows && (end - heap.size) < best_cost)
+            {
+                best_heap   = h;
+                best_offset = offset;
+                best_cost   = end - heap.size;
+            }
+        }
+
+        if (best_heap == kInvalidHeap)
+        {
+            best_heap   = (uint32_t)heaps.size();
+            best_offset = 0;
+            heaps.add({ request.heap_class, 0, alignment, index });
+        }
+
+        auto& heap        = heaps[best_heap];
+        heap.size         = (heap.size > best_offset + request.size) ? heap.size : best_offset + request.size;
+        heap.alignment    = (heap.alignment > alignment) ? heap.alignment : alignment;
+        placements[index] = { best_heap, best_offset };
+        for (uint32_t b = request.first_pass / kPassesPerBucket; b <= request.last_pass / kPassesPerBucket; b++)
+            buckets[b].add(index);
+        statistics.requested_bytes += request.size;
+    }
+
+    for (const auto& heap : heaps)
+        statistics.heap_bytes += heap.size;
+    statistics.request_count = request_count;
+    statistics.heap_count    = (uint32_t)heaps.size();
+}
+} // namespace render_graph
+} // namespace skr
@@ -26,12 +26,37 @@ RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::enable_memory_
     return *this;
 }
 
+RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::with_recording_workers(uint32_t count) SKR_NOEXCEPT
+{
+    recording_workers = count ? count : 1;
+    return *this;
+}
+
+RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::with_resource_pool_budget(uint64_t texture_bytes, uint64_t buffer_bytes) SKR_NOEXCEPT
+{
+    texture_pool_budget = texture_bytes;
+    buffer_pool_budget = buffer_bytes;
+    return *this;
+}
+
 RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::with_gfx_queue(CGPUQueueId queue) SKR_NOEXCEPT
 {
     gfx_queue = queue;
     return *this;
 }
 
+RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::with_cmpt_queue(CGPUQueueId queue) SKR_NOEXCEPT
+{
+    cmpt_queue = queue;
+    return *this;
+}
+
+RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::with_cpy_queue(CGPUQueueId queue) SKR_NOEXCEPT
+{
+    cpy_queue = queue;
+    return *this;
+}
+
 RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::backend_api(ECGPUBackend backend) SKR_NOEXCEPT
 {
     api = backend;
@@ -210,6 +235,12 @@ RenderGraph::ComputePassBuilder& RenderGraph::ComputePassBuilder::set_root_signa
     return *this;
 }
 
+RenderGraph::ComputePassBuilder& RenderGraph::ComputePassBuilder::set_queue_affinity(ECGPUQueueType queue) SKR_NOEXCEPT
+{
+    node.queue_affinity = queue;
+    return *this;
+}
+
 PassHandle RenderGraph::add_compute_pass(const ComputePassSetupFunction& setup, const ComputePassExecuteFunction& executor) SKR_NOEXCEPT
 {
     const uint32_t passes_size = static_cast<uint32_t>(passes.size());
@@ -246,6 +277,12 @@ RenderGraph::CopyPassBuilder& RenderGraph::CopyPassBuilder::can_be_lone() SKR_NO
     return *this;
 }
 
+RenderGraph::CopyPassBuilder& RenderGraph::CopyPassBuilder::set_queue_affinity(ECGPUQueueType queue) SKR_NOEXCEPT
+{
+    node.queue_affinity = queue;
+    return *this;
+}
+
 RenderGraph::CopyPassBuilder& RenderGraph::CopyPassBuilder::buffer_to_buffer(BufferRangeHandle src, BufferRangeHandle dst, ECGPUResourceState out_state) SKR_NOEXCEPT
 {
     SkrZoneScopedN("CopyPassBuilder::buffer_to_buffer");
@@ -619,6 +656,12 @@ RenderGraph::TextureBuilder& RenderGraph::TextureBuilder::allow_lone() SKR_NOEXC
     return *this;
 }
 
+RenderGraph::TextureBuilder& RenderGraph::TextureBuilder::allow_oversized() SKR_NOEXCEPT
+{
+    node.oversized = true;
+    return *this;
+}
+
 TextureHandle RenderGraph::create_texture(const TextureSetupFunction& setup) SKR_NOEXCEPT
 {
     SkrZoneScopedN("RenderGraph::create_texture(handle)");
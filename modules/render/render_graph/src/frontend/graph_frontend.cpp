@@ -3,6 +3,7 @@
 #include "SkrRenderGraph/frontend/pass_node.hpp"
 #include "SkrRenderGraph/frontend/node_and_edge_factory.hpp"
 #include "SkrCore/memory/memory.h"
+#include "SkrBase/misc/hash.h"
 
 #include "SkrProfile/profile.h"
 
@@ -161,6 +162,9 @@ namespace render_graph {
 
 RenderGraph::RenderGraph(const RenderGraphBuilder& builder) SKR_NOEXCEPT
     : aliasing_enabled(builder.memory_aliasing)
+    , recording_workers(builder.recording_workers)
+    , texture_pool_budget(builder.texture_pool_budget)
+    , buffer_pool_budget(builder.buffer_pool_budget)
 {
 }
 
@@ -216,9 +220,55 @@ const CGPUTextureDescriptor* RenderGraph::resolve_descriptor(TextureHandle hdl)
 
 bool RenderGraph::compile() SKR_NOEXCEPT
 {
+    topology_hash = calculate_topology_hash();
+    // topology is final from here, pack adjacency once instead of on the first query
+    graph->build();
     return true;
 }
 
+// covers everything culling, aliasing & barriers are derived from: resource kinds & descriptors,
+// pass kinds and the resource, type & requested state of each access edge.
+// names, executors & imported gpu objects are bound per frame and stay out of it
+uint64_t RenderGraph::calculate_topology_hash() const SKR_NOEXCEPT
+{
+    SkrZoneScopedN("RenderGraphTopologyHash");
+    uint64_t hash = skr_hash64(&aliasing_enabled, sizeof(aliasing_enabled), SKR_DEFAULT_HASH_SEED_64);
+    for (const auto resource : resources)
+    {
+        uint64_t packed[6] = { resource->get_id(), (uint64_t)resource->type, (uint64_t)resource->imported << 1 | resource->canbe_lone, 0, 0, 0 };
+        if (resource->type == EObjectType::Texture)
+        {
+            const auto& desc = static_cast<const TextureNode*>(resource)->descriptor;
+            packed[3] = desc.width << 32 | desc.height;
+            packed[4] = desc.depth << 32 | (uint64_t)desc.array_size << 16 | desc.mip_levels;
+            packed[5] = (uint64_t)desc.format << 40 | (uint64_t)desc.sample_count << 32 | (uint64_t)desc.descriptors;
+            packed[2] |= (uint64_t)desc.flags << 32 | (uint64_t)desc.is_restrict_dedicated << 2;
+        }
+        else if (resource->type == EObjectType::Buffer)
+        {
+            const auto& desc = static_cast<const BufferNode*>(resource)->descriptor;
+            packed[3] = desc.size;
+            packed[4] = (uint64_t)desc.memory_usage << 32 | (uint64_t)desc.descriptors;
+            packed[2] |= (uint64_t)desc.flags << 32;
+        }
+        hash = skr_hash64(packed, sizeof(packed), hash);
+    }
+    for (const auto pass : passes)
+    {
+        const uint64_t header[2] = { pass->get_id(), (uint64_t)pass->queue_affinity << 40 | (uint64_t)pass->pass_type << 1 | pass->can_be_lone };
+        hash = skr_hash64(header, sizeof(header), hash);
+        pass->foreach_textures([&](TextureNode* texture, TextureEdge* edge) {
+            const uint64_t packed = (uint64_t)texture->get_id() << 40 | (uint64_t)edge->type << 32 | (uint64_t)edge->requested_state;
+            hash = skr_hash64(&packed, sizeof(packed), hash);
+        });
+        pass->foreach_buffers([&](BufferNode* buffer, BufferEdge* edge) {
+            const uint64_t packed = (uint64_t)buffer->get_id() << 40 | (uint64_t)edge->type << 32 | (uint64_t)edge->requested_state;
+            hash = skr_hash64(&packed, sizeof(packed), hash);
+        });
+    }
+    return hash;
+}
+
 uint32_t RenderGraph::foreach_textures(skr::stl_function<void(TextureNode*)> f) SKR_NOEXCEPT
 {
     uint32_t num = 0;
@@ -285,10 +335,11 @@ uint32_t RenderGraph::foreach_reader_passes(BufferHandle buffer,
     });
 }
 
-const ECGPUResourceState RenderGraph::get_lastest_state(const TextureNode* texture, const PassNode* pending_pass) const SKR_NOEXCEPT
+const ECGPUResourceState RenderGraph::get_lastest_state(const TextureNode* texture, const PassNode* pending_pass, bool* from_init) const SKR_NOEXCEPT
 {
     SkrZoneScopedN("CaclulateLatestState-Texture");
 
+    if (from_init) *from_init = true;
     if (passes[0] == pending_pass)
         return texture->init_state;
     PassNode* pass_iter = nullptr;
@@ -326,13 +377,15 @@ const ECGPUResourceState RenderGraph::get_lastest_state(const TextureNode* textu
             }
         }
     });
+    if (from_init) *from_init = !pass_iter;
     return result;
 }
 
-const ECGPUResourceState RenderGraph::get_lastest_state(const BufferNode* buffer, const PassNode* pending_pass) const SKR_NOEXCEPT
+const ECGPUResourceState RenderGraph::get_lastest_state(const BufferNode* buffer, const PassNode* pending_pass, bool* from_init) const SKR_NOEXCEPT
 {
     SkrZoneScopedN("CaclulateLatestState-Buffer");
 
+    if (from_init) *from_init = true;
     if (passes[0] == pending_pass)
         return buffer->init_state;
     PassNode* pass_iter = nullptr;
@@ -370,6 +423,7 @@ const ECGPUResourceState RenderGraph::get_lastest_state(const BufferNode* buffer
             }
         }
     });
+    if (from_init) *from_init = !pass_iter;
     return result;
 }
 
@@ -1,14 +1,80 @@
 #include "SkrRenderGraph/frontend/render_graph.hpp" // IWYU pragma: keep
 #include "SkrRenderGraph/frontend/pass_node.hpp" // IWYU pragma: keep
+#include "SkrContainers/string.hpp"
+#include <stdio.h>
 
 namespace skr
 {
 namespace render_graph
 {
 
+static const char8_t* queue_name(ECGPUQueueType queue)
+{
+    switch (queue)
+    {
+        case CGPU_QUEUE_TYPE_COMPUTE:
+            return u8"compute";
+        case CGPU_QUEUE_TYPE_TRANSFER:
+            return u8"transfer";
+        default:
+            return u8"graphics";
+    }
+}
+
 void RenderGraphViz::write_graphviz(RenderGraph& graph, const char* outf) SKR_NOEXCEPT
 {
+    // frontend-only graphs have no schedule, all of their passes run on one graphics lane
+    QueueSchedule        frontend_schedule;
+    const QueueSchedule* schedule = graph.get_queue_schedule();
+    if (!schedule || schedule->segments.empty())
+    {
+        auto& segment      = frontend_schedule.segments.add_default().ref();
+        segment.queue      = CGPU_QUEUE_TYPE_GRAPHICS;
+        segment.first_pass = 0;
+        segment.last_pass  = (uint32_t)graph.passes.size();
+        schedule           = &frontend_schedule;
+    }
+
+    skr::String dot = u8"digraph RenderGraph {\n    rankdir=LR;\n    node [shape=box];\n";
+    // each segment opens with an anchor, so empty segments (the join one) still show up as a submit
+    for (uint32_t i = 0; i < schedule->segments.size(); i++)
+    {
+        const auto& segment = schedule->segments[i];
+        dot += skr::format(u8"    subgraph cluster_{} {{\n        label=\"#{} {}\";\n", i, i, queue_name(segment.queue));
+        dot += skr::format(u8"        segment_{} [shape=point];\n", i);
+        skr::String chain = skr::format(u8"segment_{}", i);
+        for (uint32_t p = segment.first_pass; p < segment.last_pass && p < graph.passes.size(); p++)
+        {
+            const auto pass = graph.passes[p];
+            const auto name = pass->get_name_view();
+            if (name.is_empty())
+                dot += skr::format(u8"        pass_{} [label=\"pass #{}\"];\n", p, p);
+            else
+                dot += skr::format(u8"        pass_{} [label=\"{}\"];\n", p, name);
+            dot += skr::format(u8"        {} -> pass_{};\n", chain, p);
+            chain = skr::format(u8"pass_{}", p);
+        }
+        dot += u8"    }\n";
+    }
+    // a semaphore wait leaves the signaling segment after its last pass
+    for (uint32_t i = 0; i < schedule->segments.size(); i++)
+    {
+        for (const auto wait : schedule->segments[i].waits)
+        {
+            const auto& signaler = schedule->segments[wait];
+            if (signaler.last_pass > signaler.first_pass)
+                dot += skr::format(u8"    pass_{} -> segment_{} [style=dashed, color=red];\n", signaler.last_pass - 1, i);
+            else
+                dot += skr::format(u8"    segment_{} -> segment_{} [style=dashed, color=red];\n", wait, i);
+        }
+    }
+    dot += u8"}\n";
 
+    if (auto file = fopen(outf, "w"))
+    {
+        fwrite(dot.c_str(), 1, dot.size(), file);
+        fclose(file);
+    }
 }
 
 } // namespace render_graph
@@ -14,8 +14,42 @@ void CullPhase::on_compile(RenderGraph* graph) SKR_NOEXCEPT
     auto& resources = get_resources(graph);
     auto& passes = get_passes(graph);
 
+    // same topology, same lone nodes: replay without touching the adjacency
+    if (graph->is_compile_cached() && topology_hash == graph->get_topology_hash())
+    {
+        uint32_t index = 0, cursor = 0;
+        resources.remove_all_if(
+        [&](ResourceNode* resource) {
+            const bool culled = cursor < culled_resource_indices.size() && culled_resource_indices[cursor] == index;
+            index++;
+            if (culled)
+            {
+                culled_resources.add(resource);
+                cursor++;
+            }
+            return culled;
+        });
+        index = 0, cursor = 0;
+        passes.remove_all_if(
+        [&](PassNode* pass) {
+            const bool culled = cursor < culled_pass_indices.size() && culled_pass_indices[cursor] == index;
+            index++;
+            if (culled)
+            {
+                culled_passes.add(pass);
+                cursor++;
+            }
+            return culled;
+        });
+        return;
+    }
+    topology_hash = graph->get_topology_hash();
+    culled_resource_indices.clear();
+    culled_pass_indices.clear();
+
+    uint32_t index = 0;
     resources.remove_all_if(
-    [this](ResourceNode* resource) {
+    [this, &index](ResourceNode* resource) {
         SKR_UNUSED const auto name = resource->get_name_view();
         SkrZoneScopedC(tracy::Color::SteelBlue);
         ZoneName((const char*)name.raw().data(), name.size());
@@ -23,13 +57,19 @@ void CullPhase::on_compile(RenderGraph* graph) SKR_NOEXCEPT
         const bool lone = !(resource->incoming_edges() + resource->outgoing_edges());
         {
             SkrZoneScopedN("RecordDealloc");
-            if (lone) culled_resources.add(resource);
+            if (lone)
+            {
+                culled_resources.add(resource);
+                culled_resource_indices.add(index);
+            }
         }
+        index++;
         return lone;
     });
 
+    index = 0;
     passes.remove_all_if(
-    [this](PassNode* pass) {
+    [this, &index](PassNode* pass) {
         SKR_UNUSED const auto name = pass->get_name_view();
         SkrZoneScopedC(tracy::Color::SteelBlue);
         ZoneName((const char*)name.raw().data(), name.size());
@@ -39,8 +79,13 @@ void CullPhase::on_compile(RenderGraph* graph) SKR_NOEXCEPT
         const bool culled = lone && !can_be_lone;
         {
             SkrZoneScopedN("RecordDealloc");
-            if (culled) culled_passes.add(pass);
+            if (culled)
+            {
+                culled_passes.add(pass);
+                culled_pass_indices.add(index);
+            }
         }
+        index++;
         return culled;
     });
 }
@@ -0,0 +1,94 @@
+#pragma once
+#include "SkrRenderer/primitive_draw.h"
+#include "SkrContainers/vector.hpp"
+#include "SkrContainers/hashmap.hpp"
+
+namespace skr {
+namespace renderer {
+
+// persistently mapped vertex buffers, one set per frame in flight.
+// a frame fills the set it was given, the set is reused once the gpu is done with that frame
+struct SKR_RENDERER_API InstanceUploadRing
+{
+    struct Allocation
+    {
+        CGPUBufferId buffer;
+        uint32_t offset;
+        uint8_t* mapped;
+    };
+
+    void initialize(CGPUDeviceId device, uint32_t frames_in_flight, uint64_t page_size = 1024 * 1024) SKR_NOEXCEPT;
+    void finalize() SKR_NOEXCEPT;
+
+    // pages that overflowed last time around are folded into one that fits the whole frame
+    void begin_frame(uint64_t frame_index) SKR_NOEXCEPT;
+    Allocation allocate(uint64_t size, uint64_t alignment = 16) SKR_NOEXCEPT;
+
+    uint64_t get_allocated_size() const SKR_NOEXCEPT { return frame_allocated; }
+
+protected:
+    struct Page
+    {
+        CGPUBufferId buffer;
+        uint64_t size;
+        uint64_t cursor;
+    };
+    CGPUBufferId create_page(uint64_t size) SKR_NOEXCEPT;
+
+    CGPUDeviceId device = nullptr;
+    uint64_t page_size = 0;
+    uint64_t frame_allocated = 0;
+    uint32_t current = 0;
+    skr::Vector<skr::Vector<Page>> frames;
+};
+
+struct DrawInstancingStatistics
+{
+    uint32_t input_draws = 0;
+    uint32_t output_draws = 0;
+    uint32_t instances = 0;
+    uint64_t uploaded_bytes = 0;
+};
+
+// merges instanceable draws within each list of a packet. a group keeps the position, sort key & push constants
+// of its first draw, draws without instance data pass through untouched
+struct SKR_RENDERER_API DrawInstancer
+{
+    void initialize(CGPUDeviceId device, uint32_t frames_in_flight) SKR_NOEXCEPT;
+    void finalize() SKR_NOEXCEPT;
+
+    // invalidates the packets merged during the previous frame
+    void begin_frame(uint64_t frame_index) SKR_NOEXCEPT;
+    skr_primitive_draw_packet_t merge(const skr_primitive_draw_packet_t& packet) SKR_NOEXCEPT;
+
+    DrawInstancingStatistics statistics;
+
+protected:
+    struct Group
+    {
+        uint32_t head;
+        uint32_t tail;
+        uint32_t count;
+        uint32_t next_collision;
+    };
+    struct PacketStorage
+    {
+        skr::Vector<skr_primitive_draw_list_view_t> lists;
+        skr::Vector<skr_primitive_draw_t> draws;
+        skr::Vector<skr_vertex_buffer_view_t> vertex_buffers;
+        // per draw, UINT32_MAX keeps the vertex buffers of the source draw
+        skr::Vector<uint32_t> vertex_buffer_offsets;
+    };
+
+    InstanceUploadRing ring;
+    skr::Vector<PacketStorage> packets;
+    uint32_t packet_count = 0;
+    // scratch for a single list
+    skr::FlatHashMap<uint64_t, uint32_t> group_map;
+    skr::Vector<Group> groups;
+    skr::Vector<uint32_t> member_groups;
+    skr::Vector<uint32_t> member_next;
+};
+
+} // namespace renderer
+} // namespace skr
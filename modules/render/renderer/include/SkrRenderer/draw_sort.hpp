@@ -0,0 +1,66 @@
+#pragma once
+#include "SkrRenderer/primitive_draw.h"
+#include "SkrContainers/vector.hpp"
+
+namespace skr {
+namespace renderer {
+
+// flattens draw packets into one list ordered by skr_primitive_draw_t::sort_key
+struct SKR_RENDERER_API DrawListSorter
+{
+    struct Entry
+    {
+        uint64_t key;
+        const skr_primitive_draw_t* draw;
+    };
+
+    // desperated draws are dropped
+    void gather(skr::span<const skr_primitive_draw_packet_t> packets) SKR_NOEXCEPT;
+    // stable LSD radix sort on 8-bit digits, digits shared by every key are skipped.
+    // with more than one block the histograms & scatters run on the task scheduler, which must be bound
+    void sort(uint32_t max_blocks = 1) SKR_NOEXCEPT;
+
+    skr::span<const Entry> get_entries() const SKR_NOEXCEPT { return { entries.data(), entries.size() }; }
+
+protected:
+    skr::Vector<Entry> entries;
+    skr::Vector<Entry> scratch;
+    skr::Vector<uint32_t> histograms;
+};
+
+struct DrawStateStatistics
+{
+    uint32_t draws = 0;
+    uint32_t pipelines = 0;
+    uint32_t bind_tables = 0;
+    uint32_t index_buffers = 0;
+    uint32_t vertex_buffers = 0;
+};
+
+// remembers what an encoder has bound, each call returns true when the caller has to bind
+struct SKR_RENDERER_API DrawStateTracker
+{
+    void reset() SKR_NOEXCEPT;
+
+    bool set_pipeline(CGPURenderPipelineId pipeline) SKR_NOEXCEPT;
+    // bind tables are laid out by the root signature, a new one invalidates the bound table
+    bool set_bind_table(CGPURootSignatureId root_signature, CGPUXBindTableId bind_table) SKR_NOEXCEPT;
+    bool set_index_buffer(const skr_index_buffer_view_t& view) SKR_NOEXCEPT;
+    bool set_vertex_buffers(const skr_vertex_buffer_view_t* views, uint32_t count) SKR_NOEXCEPT;
+    void draw() SKR_NOEXCEPT { statistics.draws++; }
+
+    DrawStateStatistics statistics;
+
+protected:
+    static constexpr uint32_t kMaxVertexBuffers = 16;
+    CGPURenderPipelineId pipeline = nullptr;
+    CGPURootSignatureId root_signature = nullptr;
+    CGPUXBindTableId bind_table = nullptr;
+    bool has_bind_table = false;
+    skr_index_buffer_view_t index_buffer = {};
+    skr_vertex_buffer_view_t vertex_buffers[kMaxVertexBuffers] = {};
+    uint32_t vertex_buffer_count = UINT32_MAX;
+};
+
+} // namespace renderer
+} // namespace skr
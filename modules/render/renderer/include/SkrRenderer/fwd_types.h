@@ -67,8 +67,10 @@ typedef struct skr_shader_map_root_t skr_shader_map_root_t;
 
 SKR_DECLARE_TYPE_ID_FWD(skr::renderer, PSOMapKey, skr_pso_map_key);
 
-typedef struct skr_pso_map_t*     skr_pso_map_id;
-typedef struct skr_pso_map_root_t skr_pso_map_root_t;
+typedef struct skr_pso_map_t*              skr_pso_map_id;
+typedef struct skr_pso_map_root_t          skr_pso_map_root_t;
+typedef struct skr_pso_map_statistics_t    skr_pso_map_statistics_t;
+typedef struct skr_pso_map_key_resolver_t  skr_pso_map_key_resolver_t;
 
 #ifdef __cplusplus
 using skr_shader_resource_handle_t   = skr::resource::TResourceHandle<skr_multi_shader_resource_t>;
@@ -39,6 +39,14 @@ typedef struct skr_primitive_draw_t {
     uint32_t vertex_buffer_count;
     skr_index_buffer_view_t index_buffer;
     bool desperated;
+    // passes submit draws in ascending key order, draws with equal keys keep their order
+    uint64_t sort_key;
+    // per-instance payload (e.g. the model matrix) of effects with instancing enabled.
+    // the renderer merges such draws and streams the payloads as the last vertex buffer
+    const uint8_t* instance_data;
+    uint32_t instance_data_size;
+    // 0 is drawn as a single instance
+    uint32_t instance_count;
 } skr_primitive_draw_t;
 
 typedef struct skr_primitive_draw_list_view_t {
@@ -53,6 +61,11 @@ typedef struct skr_primitive_draw_packet_t {
     void* user_data;
 } skr_primitive_draw_packet_t;
 
+// packs a draw sort key, most significant first:
+// layer (8 bits) | pipeline (16 bits) | bind table (16 bits) | depth (24 bits).
+// depth is in [0, 1], pass 1 - depth to draw back to front
+SKR_RENDERER_API uint64_t skr_primitive_draw_make_sort_key(uint8_t layer, CGPURenderPipelineId pipeline, CGPUXBindTableId bind_table, float depth);
+
 #ifdef __cplusplus
 } // extern "C"
 
@@ -64,6 +77,8 @@ using IndexBufferView = skr_index_buffer_view_t;
 struct PrimitiveCommand {
     skr::span<const skr_vertex_buffer_view_t> vbvs;
     const skr_index_buffer_view_t* ibv;
+    // ibv followed by the coarser levels of detail of the primitive
+    skr::span<const skr_index_buffer_view_t> lod_ibvs;
     uint32_t primitive_index;
     uint32_t material_index;
 };
@@ -8,6 +8,7 @@ namespace render_graph
 {
 class RenderGraph;
 }
+struct CullingResult;
 } // namespace skr
 
 struct sugoi_storage_t;
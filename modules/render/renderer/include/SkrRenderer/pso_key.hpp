@@ -2,6 +2,7 @@
 #include "SkrRenderer/pso_map.h"
 #include "SkrBase/atomic/atomic.h"
 #include "SkrContainers/vector.hpp"
+#include "SkrContainers/string.hpp"
 
 namespace skr {
 namespace renderer {
@@ -13,14 +14,19 @@ struct PSOMapKey
 
     CGPURootSignatureId root_signature;
     CGPUShaderEntryDescriptor vertex_shader;
+    skr::String vertex_entry;
     skr::Vector<CGPUConstantSpecialization> vertex_specializations;
     CGPUShaderEntryDescriptor tesc_shader;
+    skr::String tesc_entry;
     skr::Vector<CGPUConstantSpecialization> tesc_specializations;
     CGPUShaderEntryDescriptor tese_shader;
+    skr::String tese_entry;
     skr::Vector<CGPUConstantSpecialization> tese_specializations;
     CGPUShaderEntryDescriptor geom_shader;
+    skr::String geom_entry;
     skr::Vector<CGPUConstantSpecialization> geom_specializations;
     CGPUShaderEntryDescriptor fragment_shader;
+    skr::String fragment_entry;
     skr::Vector<CGPUConstantSpecialization> fragment_specializations;
     CGPUVertexLayout vertex_layout;
     CGPUBlendStateDescriptor blend_state;
@@ -36,6 +42,32 @@ struct PSOMapKey
     SAtomicU32 pso_rc = 0;
     SAtomicU32 pso_status = SKR_PSO_MAP_PSO_STATUS_UNINSTALLED;
     CGPURenderPipelineId pso = nullptr;
+
+    // key database record, 0 until the key is first installed or if it can't be named
+    uint64_t record_hash = 0;
+    bool precompiled = false;
+};
+
+// portable form of a key for the key database: handles are replaced by the names given by the resolver
+SKR_RENDERER_API uint32_t pso_key_record_header_size() SKR_NOEXCEPT;
+SKR_RENDERER_API bool write_pso_key_record(const PSOMapKey& key, const skr_pso_map_key_resolver_t& resolver, skr::Vector<uint8_t>& out) SKR_NOEXCEPT;
+
+// descriptor rebuilt from a record, valid as long as the record data & this object live
+struct SKR_RENDERER_API PSOKeyRecord
+{
+    static constexpr uint32_t kStageCount = 5;
+
+    bool read(const uint8_t* data, uint64_t size, const skr_pso_map_key_resolver_t& resolver) SKR_NOEXCEPT;
+
+    CGPUShaderEntryDescriptor shaders[kStageCount];
+    skr::Vector<CGPUConstantSpecialization> specializations[kStageCount];
+    CGPUVertexLayout vertex_layout;
+    CGPUBlendStateDescriptor blend_state;
+    CGPUDepthStateDescriptor depth_state;
+    CGPURasterizerStateDescriptor rasterizer_state;
+    ECGPUFormat color_formats[CGPU_MAX_MRT_COUNT];
+
+    CGPURenderPipelineDescriptor descriptor;
 };
 
 }
@@ -52,9 +52,50 @@ void skr_pso_map_garbage_collect(skr_pso_map_id psoMap, uint64_t critical_frame)
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API 
 void skr_pso_map_free(skr_pso_map_id pso_map);
 
+// write the key database: every key installed by this run or read back by skr_pso_map_precompile.
+// query the size with data == NULL first, keys can only be written if the map has a key resolver
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+void skr_pso_map_write_key_database(skr_pso_map_id psoMap, uint64_t* size, uint8_t* data);
+
+// queue creation of the psos recorded in a key database, most installed keys first.
+// installs of these keys find them requested or installed. returns the number of queued keys
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+uint32_t skr_pso_map_precompile(skr_pso_map_id psoMap, const uint8_t* data, uint64_t size);
+
+// thread-safe.
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API
+void skr_pso_map_query_statistics(skr_pso_map_id psoMap, skr_pso_map_statistics_t* statistics);
+
+// names the runtime objects a pipeline descriptor points at, so keys can be written & rebuilt by a later run
+typedef struct skr_pso_map_key_resolver_t {
+    // a name stable across runs, 0 keeps the keys using the object out of the database
+    uint64_t (*name_shader_library)(void* usrdata, CGPUShaderLibraryId library);
+    uint64_t (*name_root_signature)(void* usrdata, CGPURootSignatureId root_signature);
+    // null drops the recorded key
+    CGPUShaderLibraryId (*resolve_shader_library)(void* usrdata, uint64_t name);
+    CGPURootSignatureId (*resolve_root_signature)(void* usrdata, uint64_t name);
+    void* usrdata;
+} skr_pso_map_key_resolver_t;
+
+typedef struct skr_pso_map_statistics_t {
+    /// installs served by a pso that was already created or requested (precompiled ones included)
+    uint32_t install_hits;
+    /// installs that had to request their pso
+    uint32_t install_misses;
+    /// keys queued by skr_pso_map_precompile
+    uint32_t precompile_requested;
+    uint32_t precompile_finished;
+    /// recorded keys that couldn't be resolved, or whose pso failed
+    uint32_t precompile_failed;
+    /// from skr_pso_map_precompile until the last queued pso is done
+    uint64_t precompile_usec;
+} skr_pso_map_statistics_t;
+
 typedef struct skr_pso_map_root_t {
     CGPUDeviceId device SKR_IF_CPP(= nullptr);
     skr_job_queue_id job_queue SKR_IF_CPP(= nullptr;)
+    // optional, required to write & precompile key databases
+    const skr_pso_map_key_resolver_t* key_resolver SKR_IF_CPP(= nullptr);
 } skr_pso_map_root_t;
 
 #ifdef __cplusplus
@@ -71,6 +112,10 @@ struct SKR_RENDERER_API skr_pso_map_t
     virtual void new_frame(uint64_t frame_index) SKR_NOEXCEPT = 0;
     virtual void garbage_collect(uint64_t critical_frame) SKR_NOEXCEPT = 0;
 
+    virtual void write_key_database(uint64_t* size, uint8_t* data) SKR_NOEXCEPT = 0;
+    virtual uint32_t precompile(const uint8_t* data, uint64_t size) SKR_NOEXCEPT = 0;
+    virtual void query_statistics(skr_pso_map_statistics_t* statistics) SKR_NOEXCEPT = 0;
+
     static skr_pso_map_id Create(const struct skr_pso_map_root_t* desc) SKR_NOEXCEPT;
     static bool Free(skr_pso_map_id pso_map) SKR_NOEXCEPT;
 };
@@ -16,6 +16,8 @@ struct SKR_RENDERER_API RendererDevice
         bool enable_gpu_based_validation = false;
         bool enable_set_name = true;
         uint32_t aux_thread_count = 0;
+        // driver pipeline cache blob, read when the device is created & written back on finalize
+        const char8_t* pipeline_cache_path = nullptr;
     };
     static RendererDevice* Create() SKR_NOEXCEPT;
     static void Free(RendererDevice* device) SKR_NOEXCEPT;
@@ -33,6 +33,10 @@ SKR_RENDERER_EXTERN_C SKR_RENDERER_API void skr_renderer_register_render_effect(
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API void skr_renderer_register_render_effect_vtbl(SRendererId renderer, skr_render_effect_name_t name, VtblRenderEffectProcessor* processor);
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API void skr_renderer_remove_render_effect(SRendererId renderer, skr_render_effect_name_t name);
 
+// draws of an effect with instancing enabled that share pipeline, bind table & buffers are merged into one instanced draw.
+// the effect fills skr_primitive_draw_t::instance_data, its pipelines read the payload from an instance rate vertex buffer
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API void skr_render_effect_set_instancing(SRendererId renderer, skr_render_effect_name_t name, bool enable);
+
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API void skr_render_effect_attach(SRendererId, sugoi_chunk_view_t* cv, skr_render_effect_name_t effect_name);
 typedef void (*SProcRenderEffectAttach)(SRendererId, sugoi_chunk_view_t* cv, skr_render_effect_name_t effect_name);
 
@@ -55,6 +59,8 @@ typedef struct skr_primitive_draw_context_t
     skr::render_graph::RenderGraph* render_graph;
     IPrimitiveRenderPass* pass;
     sugoi_storage_t* storage;
+    // visible instances of this frame, null if the renderer was given no culling result
+    const skr::CullingResult* visibility;
 } skr_primitive_draw_context_t;
 
 typedef struct skr_primitive_update_context_t 
@@ -33,6 +33,11 @@ SKR_RENDERER_EXTERN_C SKR_RENDERER_API void skr_render_mesh_initialize(skr_rende
 
 SKR_RENDERER_EXTERN_C SKR_RENDERER_API void skr_render_mesh_free(skr_render_mesh_id render_mesh);
 
+// the coarsest level of detail of a primitive command whose simplification error stays under max_pixel_error on screen,
+// pixels_per_unit is the screen size in pixels of one mesh space unit at the distance of the drawn instance, LOD 0 is drawn when it is not positive.
+// draw primitive_commands[command_index].lod_ibvs[lod] with the returned lod
+SKR_RENDERER_EXTERN_C SKR_RENDERER_API uint32_t skr_render_mesh_select_lod(skr_render_mesh_id render_mesh, uint32_t command_index, float pixels_per_unit, float max_pixel_error);
+
 // mesh render effect is a base class which captures components with render_mesh components and produce drawcalls
 typedef struct SKR_RENDERER_API IMeshRenderEffect : public IRenderEffectProcessor {
 #ifdef __cplusplus
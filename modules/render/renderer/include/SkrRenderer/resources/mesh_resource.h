@@ -6,6 +6,7 @@
 
 #include <SkrContainers/string.hpp>
 #include <SkrContainers/vector.hpp>
+#include <SkrContainers/span.hpp>
 
 #ifndef __meta__
     #include "SkrRenderer/resources/mesh_resource.generated.h" // IWYU pragma: export
@@ -50,6 +51,50 @@ skr_index_buffer_entry_t {
 };
 typedef struct skr_index_buffer_entry_t skr_index_buffer_entry_t;
 
+// a simplified index range of a primitive, it shares the index buffer (buffer, offset & stride) and vertices of the primitive
+sreflect_struct("guid" : "5e0c2b8d-94a1-4c36-8f7e-1d2a3b4c5d6e")
+sattr("serde" : "bin")
+skr_mesh_lod_t {
+    uint32_t first_index;
+    uint32_t index_count;
+    // max deviation from LOD 0 surface, in mesh space units
+    float error;
+};
+typedef struct skr_mesh_lod_t skr_mesh_lod_t;
+
+// meshlet stream of a primitive, stored from offset in its bin as
+// | skr_meshlet_t[meshlet_count] | skr_meshlet_bounds_t[meshlet_count] | uint32_t vertices[vertex_count] | uint8_t triangles[triangle_size] |
+// meshlet vertices index the vertex buffers of the primitive, meshlet triangles index the vertices of their meshlet.
+// the triangles of every meshlet start 4 bytes aligned
+sreflect_struct("guid" : "b7c1a3f0-6e2d-4f5a-9c8b-2d4e6f8a0b1c")
+sattr("serde" : "bin")
+skr_meshlet_buffer_entry_t {
+    uint32_t buffer_index;
+    uint32_t offset;
+    uint32_t meshlet_count;
+    uint32_t vertex_count;
+    uint32_t triangle_size;
+};
+typedef struct skr_meshlet_buffer_entry_t skr_meshlet_buffer_entry_t;
+
+typedef struct skr_meshlet_t {
+    uint32_t vertex_offset;
+    uint32_t triangle_offset; // in bytes, 3 per triangle
+    uint32_t vertex_count;
+    uint32_t triangle_count;
+} skr_meshlet_t;
+
+// bounding sphere & normal cone in mesh space, the meshlet is backfacing when
+// dot(normalize(cone_apex - camera_position), cone_axis) >= cone_cutoff
+typedef struct skr_meshlet_bounds_t {
+    skr_float3_t center;
+    float        radius;
+    skr_float3_t cone_apex;
+    float        cone_cutoff;
+    skr_float3_t cone_axis;
+    float        padding;
+} skr_meshlet_bounds_t;
+
 sreflect_struct("guid" : "03104e51-c998-410b-9d3c-d76535933440")
 sattr("serde" : "bin")
 skr_mesh_buffer_t {
@@ -57,6 +102,9 @@ skr_mesh_buffer_t {
     uint64_t                byte_length;
     bool                    used_with_index;
     bool                    used_with_vertex;
+    bool                    used_with_meshlet SKR_IF_CPP(= false);
+    // size of the bin file when it is meshopt encoded (see MeshBinHeader), 0 when it is stored as is
+    uint64_t                compressed_length SKR_IF_CPP(= 0);
     sattr("serde": "disable")
     struct skr::IBlob* blob SKR_IF_CPP(= nullptr);
 };
@@ -69,9 +117,13 @@ namespace skr
 namespace renderer
 {
 using EVertexAttribute  = ESkrVertexAttribute;
-using VertexBufferEntry = skr_vertex_buffer_entry_t;
-using IndexBufferEntry  = skr_index_buffer_entry_t;
-using MeshBuffer        = skr_mesh_buffer_t;
+using VertexBufferEntry  = skr_vertex_buffer_entry_t;
+using IndexBufferEntry   = skr_index_buffer_entry_t;
+using MeshletBufferEntry = skr_meshlet_buffer_entry_t;
+using MeshLOD            = skr_mesh_lod_t;
+using MeshBuffer         = skr_mesh_buffer_t;
+using Meshlet            = skr_meshlet_t;
+using MeshletBounds      = skr_meshlet_bounds_t;
 
 sreflect_struct("guid" : "cd2d43a7-1e0e-4951-bf87-7d693fd26227")
 sattr("serde" : "bin")
@@ -81,6 +133,10 @@ MeshPrimitive {
     skr::Vector<VertexBufferEntry> vertex_buffers;
     IndexBufferEntry               index_buffer;
     uint32_t                       vertex_count;
+    // optional, meshlet_count is 0 when the mesh is cooked without meshlets
+    MeshletBufferEntry             meshlets = {};
+    // coarser levels of detail after index_buffer (LOD 0), with ascending error
+    skr::Vector<MeshLOD>           lods;
 };
 
 sreflect_struct("guid" : "d3b04ea5-415d-44d5-995a-5c77c64fe1de")
@@ -103,6 +159,10 @@ MeshResource {
     skr::Vector<MeshPrimitive> primitives;
     skr::Vector<MeshBuffer>    bins;
 
+    // positions of quantized vertex layouts (snorm16) decode as position * position_scale + position_offset
+    skr_float3_t position_offset = { 0.f, 0.f, 0.f };
+    skr_float3_t position_scale  = { 1.f, 1.f, 1.f };
+
     using material_handle_t = skr::resource::TResourceHandle<skr_material_resource_t>;
     skr::Vector<material_handle_t> materials;
 
@@ -113,6 +173,78 @@ MeshResource {
     skr_render_mesh_id render_mesh SKR_IF_CPP(= nullptr);
 };
 
+// byte offsets of the arrays of a meshlet stream, relative to MeshletBufferEntry::offset
+struct MeshletStreamLayout {
+    uint64_t bounds_offset    = 0;
+    uint64_t vertices_offset  = 0;
+    uint64_t triangles_offset = 0;
+    uint64_t size             = 0;
+
+    inline static MeshletStreamLayout Get(const MeshletBufferEntry& entry)
+    {
+        MeshletStreamLayout layout;
+        layout.bounds_offset    = (uint64_t)entry.meshlet_count * sizeof(Meshlet);
+        layout.vertices_offset  = layout.bounds_offset + (uint64_t)entry.meshlet_count * sizeof(MeshletBounds);
+        layout.triangles_offset = layout.vertices_offset + (uint64_t)entry.vertex_count * sizeof(uint32_t);
+        layout.size             = layout.triangles_offset + entry.triangle_size;
+        return layout;
+    }
+};
+
+// views a meshlet stream in place
+struct MeshletView {
+    skr::span<const Meshlet>       meshlets;
+    skr::span<const MeshletBounds> bounds;
+    skr::span<const uint32_t>      vertices;
+    skr::span<const uint8_t>       triangles;
+
+    inline static MeshletView Get(const uint8_t* bin, const MeshletBufferEntry& entry)
+    {
+        const auto  layout = MeshletStreamLayout::Get(entry);
+        const auto* stream = bin + entry.offset;
+        MeshletView view;
+        view.meshlets  = { (const Meshlet*)stream, entry.meshlet_count };
+        view.bounds    = { (const MeshletBounds*)(stream + layout.bounds_offset), entry.meshlet_count };
+        view.vertices  = { (const uint32_t*)(stream + layout.vertices_offset), entry.vertex_count };
+        view.triangles = { stream + layout.triangles_offset, entry.triangle_size };
+        return view;
+    }
+};
+
+// compressed bins are a header & a chunk table followed by the chunk payloads.
+// every chunk decodes into [offset, offset + size) of the bin, bytes no chunk covers are padding and decode to zeros
+enum class EMeshBinCodec : uint32_t
+{
+    Raw,
+    Vertex, // meshopt vertex codec, stride is the vertex size
+    Index   // meshopt index codec of a triangle list, stride is the index size
+};
+
+struct MeshBinHeader {
+    static constexpr uint32_t kMagic   = 0x4E42534D; // MSBN
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t magic       = kMagic;
+    uint32_t version     = kVersion;
+    uint32_t chunk_count = 0;
+    uint32_t reserved    = 0;
+    uint64_t size        = 0; // decoded size
+};
+
+struct MeshBinChunk {
+    EMeshBinCodec codec        = EMeshBinCodec::Raw;
+    uint32_t      stride       = 0;
+    uint64_t      offset       = 0;
+    uint64_t      size         = 0;
+    uint64_t      encoded_size = 0;
+};
+
+// decodes a compressed bin into out, which holds MeshBinHeader::size bytes
+SKR_RENDERER_API bool DecodeMeshBin(skr::span<const uint8_t> encoded, skr::span<uint8_t> out) SKR_NOEXCEPT;
+
+// the meshlets of a primitive in the RAM copy of its bin, false when there are none or the mesh is not installed to RAM
+SKR_RENDERER_API bool GetMeshletView(const MeshResource* mesh, uint32_t primitive_index, MeshletView& out_view) SKR_NOEXCEPT;
+
 struct SKR_RENDERER_API SMeshFactory : public resource::SResourceFactory {
     virtual ~SMeshFactory() = default;
 
@@ -14,6 +14,8 @@ struct SKR_RENDERER_API SRenderer {
     virtual SRenderDeviceId get_render_device() const = 0;
     virtual sugoi_storage_t* get_sugoi_storage() const = 0;
     virtual SViewportManager* get_viewport_manager() const = 0;
+    // handed to effects while producing draw packets, must outlive the next render()
+    virtual void set_visibility(const skr::CullingResult* visibility) = 0;
 #endif
 };
 
@@ -0,0 +1,252 @@
+#include "SkrRenderer/draw_instancing.hpp"
+#include "SkrBase/misc/make_zeroed.hpp"
+#include "SkrProfile/profile.h"
+#include <string.h>
+
+namespace skr {
+namespace renderer {
+
+void InstanceUploadRing::initialize(CGPUDeviceId _device, uint32_t frames_in_flight, uint64_t _page_size) SKR_NOEXCEPT
+{
+    device = _device;
+    page_size = _page_size;
+    frames.resize_default(frames_in_flight ? frames_in_flight : 1);
+}
+
+void InstanceUploadRing::finalize() SKR_NOEXCEPT
+{
+    for (auto& pages : frames)
+    {
+        for (auto& page : pages)
+            cgpu_free_buffer(page.buffer);
+        pages.clear();
+    }
+    frames.clear();
+}
+
+CGPUBufferId InstanceUploadRing::create_page(uint64_t size) SKR_NOEXCEPT
+{
+    auto desc = make_zeroed<CGPUBufferDescriptor>();
+    desc.name = u8"InstanceUploadRing";
+    desc.descriptors = CGPU_RESOURCE_TYPE_VERTEX_BUFFER;
+    desc.flags = CGPU_BCF_PERSISTENT_MAP_BIT;
+    desc.memory_usage = CGPU_MEM_USAGE_CPU_TO_GPU;
+    desc.start_state = CGPU_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+    desc.size = size;
+    return cgpu_create_buffer(device, &desc);
+}
+
+void InstanceUploadRing::begin_frame(uint64_t frame_index) SKR_NOEXCEPT
+{
+    current = (uint32_t)(frame_index % frames.size());
+    auto& pages = frames[current];
+    if (pages.size() > 1)
+    {
+        uint64_t total = 0;
+        for (auto& page : pages)
+        {
+            total += page.size;
+            cgpu_free_buffer(page.buffer);
+        }
+        pages.clear();
+        pages.add({ create_page(total), total, 0 });
+    }
+    for (auto& page : pages)
+        page.cursor = 0;
+    frame_allocated = 0;
+}
+
+InstanceUploadRing::Allocation InstanceUploadRing::allocate(uint64_t size, uint64_t alignment) SKR_NOEXCEPT
+{
+    auto& pages = frames[current];
+    Page* page = pages.empty() ? nullptr : &pages.last();
+    uint64_t offset = page ? (page->cursor + alignment - 1) / alignment * alignment : 0;
+    if (!page || offset + size > page->size)
+    {
+        // the full page may still be referenced by this frame's draws, start another one
+        const uint64_t new_size = size > page_size ? size : page_size;
+        page = &pages.add({ create_page(new_size), new_size, 0 }).ref();
+        offset = 0;
+    }
+    page->cursor = offset + size;
+    frame_allocated += size;
+    return { page->buffer, (uint32_t)offset, (uint8_t*)page->buffer->info->cpu_mapped_address + offset };
+}
+
+void DrawInstancer::initialize(CGPUDeviceId device, uint32_t frames_in_flight) SKR_NOEXCEPT
+{
+    ring.initialize(device, frames_in_flight);
+}
+
+void DrawInstancer::finalize() SKR_NOEXCEPT
+{
+    ring.finalize();
+    packets.clear();
+}
+
+void DrawInstancer::begin_frame(uint64_t frame_index) SKR_NOEXCEPT
+{
+    ring.begin_frame(frame_index);
+    packet_count = 0;
+    statistics = {};
+}
+
+static uint64_t instancing_hash(const skr_primitive_draw_t& draw)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](uint64_t value) { hash = (hash ^ value) * 1099511628211ull; };
+    mix((uint64_t)(uintptr_t)draw.pipeline);
+    mix((uint64_t)(uintptr_t)draw.bind_table);
+    mix((uint64_t)(uintptr_t)draw.index_buffer.buffer);
+    mix(((uint64_t)draw.index_buffer.offset << 32) | draw.index_buffer.stride);
+    mix(((uint64_t)draw.index_buffer.index_count << 32) | draw.index_buffer.first_index);
+    mix(((uint64_t)draw.vertex_buffer_count << 32) | draw.instance_data_size);
+    for (uint32_t i = 0; i < draw.vertex_buffer_count; i++)
+    {
+        mix((uint64_t)(uintptr_t)draw.vertex_buffers[i].buffer);
+        mix(((uint64_t)draw.vertex_buffers[i].offset << 32) | draw.vertex_buffers[i].stride);
+    }
+    return hash;
+}
+
+static bool same_instancing_state(const skr_primitive_draw_t& a, const skr_primitive_draw_t& b)
+{
+    if (a.pipeline != b.pipeline || a.bind_table != b.bind_table || a.instance_data_size != b.instance_data_size) return false;
+    if (a.index_buffer.buffer != b.index_buffer.buffer || a.index_buffer.offset != b.index_buffer.offset ||
+        a.index_buffer.stride != b.index_buffer.stride || a.index_buffer.index_count != b.index_buffer.index_count ||
+        a.index_buffer.first_index != b.index_buffer.first_index)
+        return false;
+    if (a.vertex_buffer_count != b.vertex_buffer_count) return false;
+    if (a.vertex_buffers == b.vertex_buffers) return true;
+    for (uint32_t i = 0; i < a.vertex_buffer_count; i++)
+    {
+        if (a.vertex_buffers[i].buffer != b.vertex_buffers[i].buffer || a.vertex_buffers[i].offset != b.vertex_buffers[i].offset ||
+            a.vertex_buffers[i].stride != b.vertex_buffers[i].stride)
+            return false;
+    }
+    return true;
+}
+
+skr_primitive_draw_packet_t DrawInstancer::merge(const skr_primitive_draw_packet_t& packet) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("MergeInstancedDraws");
+    static constexpr uint32_t kNoGroup = UINT32_MAX;
+    if (packet_count == packets.size()) packets.add_default();
+    auto& storage = packets[packet_count++];
+    storage.lists.clear();
+    storage.draws.clear();
+    storage.vertex_buffers.clear();
+    storage.vertex_buffer_offsets.clear();
+
+    for (uint32_t l = 0; l < packet.count; l++)
+    {
+        const auto& list = packet.lists[l];
+        statistics.input_draws += list.count;
+
+        // 1. group the instanceable draws
+        group_map.clear();
+        groups.clear();
+        member_groups.resize_unsafe(list.count);
+        member_next.resize_unsafe(list.count);
+        for (uint32_t i = 0; i < list.count; i++)
+        {
+            const auto& draw = list.drawcalls[i];
+            member_groups[i] = kNoGroup;
+            member_next[i] = kNoGroup;
+            if (!draw.instance_data || !draw.instance_data_size || draw.desperated) continue;
+
+            const uint64_t hash = instancing_hash(draw);
+            uint32_t group_index = kNoGroup;
+            uint32_t last_collision = kNoGroup;
+            if (auto found = group_map.find(hash); found != group_map.end())
+            {
+                for (uint32_t g = found->second; g != kNoGroup; g = groups[g].next_collision)
+                {
+                    last_collision = g;
+                    if (same_instancing_state(list.drawcalls[groups[g].head], draw))
+                    {
+                        group_index = g;
+                        break;
+                    }
+                }
+            }
+            if (group_index == kNoGroup)
+            {
+                group_index = (uint32_t)groups.size();
+                groups.add({ i, i, 0, kNoGroup });
+                if (last_collision != kNoGroup)
+                    groups[last_collision].next_collision = group_index;
+                else
+                    group_map.emplace(hash, group_index);
+            }
+            else
+            {
+                member_next[groups[group_index].tail] = i;
+                groups[group_index].tail = i;
+            }
+            groups[group_index].count++;
+            member_groups[i] = group_index;
+        }
+
+        // 2. emit pass-through draws & one instanced draw per group, at the position of the group's first draw
+        const uint32_t first_draw = (uint32_t)storage.draws.size();
+        for (uint32_t i = 0; i < list.count; i++)
+        {
+            const auto& draw = list.drawcalls[i];
+            const uint32_t group_index = member_groups[i];
+            if (group_index == kNoGroup)
+            {
+                storage.draws.add(draw);
+                storage.vertex_buffer_offsets.add(UINT32_MAX);
+                continue;
+            }
+            const auto& group = groups[group_index];
+            if (group.head != i) continue;
+
+            const uint32_t stride = draw.instance_data_size;
+            const auto allocation = ring.allocate((uint64_t)group.count * stride);
+            uint8_t* cursor = allocation.mapped;
+            for (uint32_t member = i; member != kNoGroup; member = member_next[member])
+            {
+                memcpy(cursor, list.drawcalls[member].instance_data, stride);
+                cursor += stride;
+            }
+
+            storage.vertex_buffer_offsets.add((uint32_t)storage.vertex_buffers.size());
+            storage.vertex_buffers.append(draw.vertex_buffers, draw.vertex_buffer_count);
+            storage.vertex_buffers.add({ allocation.buffer, allocation.offset, stride });
+            auto& instanced = storage.draws.add(draw).ref();
+            instanced.vertex_buffer_count = draw.vertex_buffer_count + 1;
+            instanced.instance_data = nullptr;
+            instanced.instance_data_size = 0;
+            instanced.instance_count = group.count;
+
+            statistics.instances += group.count;
+            statistics.uploaded_bytes += (uint64_t)group.count * stride;
+        }
+        const uint32_t draw_count = (uint32_t)storage.draws.size() - first_draw;
+        storage.lists.add({ nullptr, draw_count, list.user_data });
+        statistics.output_draws += draw_count;
+    }
+
+    // the arrays stopped growing, point the lists & draws into them
+    uint32_t first_draw = 0;
+    for (auto& out_list : storage.lists)
+    {
+        out_list.drawcalls = storage.draws.data() + first_draw;
+        first_draw += out_list.count;
+    }
+    for (uint32_t i = 0; i < storage.draws.size(); i++)
+    {
+        if (storage.vertex_buffer_offsets[i] != UINT32_MAX)
+            storage.draws[i].vertex_buffers = storage.vertex_buffers.data() + storage.vertex_buffer_offsets[i];
+    }
+
+    skr_primitive_draw_packet_t result = packet;
+    result.lists = storage.lists.data();
+    result.count = (uint32_t)storage.lists.size();
+    return result;
+}
+
+} // namespace renderer
+} // namespace skr
@@ -0,0 +1,168 @@
+#include "SkrRenderer/draw_sort.hpp"
+#include "SkrTask/parallel_for.hpp"
+#include "SkrProfile/profile.h"
+#include <string.h>
+
+// handles only need to be told apart within a frame, fold their addresses into the key fields
+static uint64_t fold_handle(const void* handle, uint32_t bits)
+{
+    if (!handle) return 0;
+    const uint64_t hash = (uint64_t)(uintptr_t)handle * 0x9E3779B97F4A7C15ull;
+    return hash >> (64 - bits);
+}
+
+uint64_t skr_primitive_draw_make_sort_key(uint8_t layer, CGPURenderPipelineId pipeline, CGPUXBindTableId bind_table, float depth)
+{
+    const float clamped = depth < 0.f ? 0.f : (depth > 1.f ? 1.f : depth);
+    const uint64_t quantized = (uint64_t)(clamped * (float)0xFFFFFF);
+    return ((uint64_t)layer << 56) |
+           (fold_handle(pipeline, 16) << 40) |
+           (fold_handle(bind_table, 16) << 24) |
+           (quantized & 0xFFFFFF);
+}
+
+namespace skr {
+namespace renderer {
+
+void DrawListSorter::gather(skr::span<const skr_primitive_draw_packet_t> packets) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("GatherDrawLists");
+    entries.clear();
+    for (const auto& packet : packets)
+        for (uint32_t i = 0; i < packet.count; i++)
+        {
+            const auto& list = packet.lists[i];
+            for (uint32_t j = 0; j < list.count; j++)
+            {
+                const auto& draw = list.drawcalls[j];
+                if (draw.desperated) continue;
+                entries.add({ draw.sort_key, &draw });
+            }
+        }
+}
+
+void DrawListSorter::sort(uint32_t max_blocks) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("SortDrawLists");
+    static constexpr uint32_t kMinBlockSize = 4096;
+    const uint32_t count = (uint32_t)entries.size();
+    if (count < 2) return;
+
+    uint64_t any_set = 0, all_set = ~0ull;
+    for (const auto& entry : entries)
+    {
+        any_set |= entry.key;
+        all_set &= entry.key;
+    }
+    const uint64_t varying = any_set ^ all_set;
+    if (!varying) return;
+
+    uint32_t blocks = count / kMinBlockSize;
+    blocks = blocks < 1 ? 1 : (blocks > max_blocks ? max_blocks : blocks);
+    const uint32_t block_size = (count + blocks - 1) / blocks;
+    blocks = (count + block_size - 1) / block_size;
+    scratch.resize_unsafe(count);
+    histograms.resize_unsafe(blocks * 256);
+
+    Entry* src = entries.data();
+    Entry* dst = scratch.data();
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        if (!((varying >> shift) & 0xFF)) continue;
+
+        uint32_t* const counts = histograms.data();
+        const Entry* const base = src;
+        // a single block runs inplace
+        skr::parallel_for(src, src + count, block_size, [=](Entry* begin, Entry* end) {
+            uint32_t* histogram = counts + (begin - base) / block_size * 256;
+            memset(histogram, 0, 256 * sizeof(uint32_t));
+            for (auto it = begin; it < end; it++)
+                histogram[(it->key >> shift) & 0xFF]++;
+        }, 2u);
+
+        // offsets go digit-major then block-minor, which keeps equal digits in their block order
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < 256; digit++)
+            for (uint32_t block = 0; block < blocks; block++)
+            {
+                const uint32_t digit_count = counts[block * 256 + digit];
+                counts[block * 256 + digit] = offset;
+                offset += digit_count;
+            }
+
+        Entry* const target = dst;
+        skr::parallel_for(src, src + count, block_size, [=](Entry* begin, Entry* end) {
+            uint32_t* cursors = counts + (begin - base) / block_size * 256;
+            for (auto it = begin; it < end; it++)
+                target[cursors[(it->key >> shift) & 0xFF]++] = *it;
+        }, 2u);
+        std::swap(src, dst);
+    }
+    if (src != entries.data())
+        memcpy(entries.data(), src, count * sizeof(Entry));
+}
+
+void DrawStateTracker::reset() SKR_NOEXCEPT
+{
+    pipeline = nullptr;
+    root_signature = nullptr;
+    bind_table = nullptr;
+    has_bind_table = false;
+    index_buffer = {};
+    vertex_buffer_count = UINT32_MAX;
+}
+
+bool DrawStateTracker::set_pipeline(CGPURenderPipelineId new_pipeline) SKR_NOEXCEPT
+{
+    if (pipeline == new_pipeline) return false;
+    pipeline = new_pipeline;
+    statistics.pipelines++;
+    return true;
+}
+
+bool DrawStateTracker::set_bind_table(CGPURootSignatureId new_root_signature, CGPUXBindTableId new_bind_table) SKR_NOEXCEPT
+{
+    if (has_bind_table && root_signature == new_root_signature && bind_table == new_bind_table) return false;
+    root_signature = new_root_signature;
+    bind_table = new_bind_table;
+    has_bind_table = true;
+    statistics.bind_tables++;
+    return true;
+}
+
+bool DrawStateTracker::set_index_buffer(const skr_index_buffer_view_t& view) SKR_NOEXCEPT
+{
+    // count & first index are draw arguments, not bound state
+    if (index_buffer.buffer == view.buffer && index_buffer.offset == view.offset && index_buffer.stride == view.stride)
+        return false;
+    index_buffer = view;
+    statistics.index_buffers++;
+    return true;
+}
+
+bool DrawStateTracker::set_vertex_buffers(const skr_vertex_buffer_view_t* views, uint32_t count) SKR_NOEXCEPT
+{
+    bool same = (vertex_buffer_count == count);
+    for (uint32_t i = 0; same && i < count; i++)
+    {
+        same = vertex_buffers[i].buffer == views[i].buffer &&
+               vertex_buffers[i].offset == views[i].offset &&
+               vertex_buffers[i].stride == views[i].stride;
+    }
+    if (same) return false;
+    if (count <= kMaxVertexBuffers)
+    {
+        memcpy(vertex_buffers, views, count * sizeof(skr_vertex_buffer_view_t));
+        vertex_buffer_count = count;
+    }
+    else
+    {
+        // too many to remember, the next set always binds
+        vertex_buffer_count = UINT32_MAX;
+    }
+    statistics.vertex_buffers++;
+    return true;
+}
+
+} // namespace renderer
+} // namespace skr
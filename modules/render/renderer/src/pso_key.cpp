@@ -1,41 +1,51 @@
 #include "SkrRenderer/pso_key.hpp"
+#include "SkrBase/misc/make_zeroed.hpp"
+#include <string.h>
 
 namespace skr {
 namespace renderer {
 
+static void copy_shader_entry(const CGPUShaderEntryDescriptor& src, CGPUShaderEntryDescriptor& dst, skr::String& entry, skr::Vector<CGPUConstantSpecialization>& specializations)
+{
+    dst = src;
+    // the descriptor may outlive the caller's strings & constants
+    if (src.entry)
+    {
+        entry = skr::String(src.entry);
+        dst.entry = entry.u8_str();
+    }
+    specializations = skr::Vector<CGPUConstantSpecialization>(src.constants, src.num_constants);
+    dst.constants = specializations.data();
+}
+
 PSOMapKey::PSOMapKey(const CGPURenderPipelineDescriptor& desc, uint64_t frame) SKR_NOEXCEPT
-    : root_signature(desc.root_signature->pool_sig ? desc.root_signature->pool_sig : desc.root_signature), 
+    : root_signature(desc.root_signature->pool_sig ? desc.root_signature->pool_sig : desc.root_signature),
     frame(frame), rc(0), pso_rc(0)
 {
     descriptor.root_signature = root_signature;
     if (desc.vertex_shader)
     {
-        vertex_shader = *desc.vertex_shader;
-        vertex_specializations = skr::Vector<CGPUConstantSpecialization>(desc.vertex_shader->constants, desc.vertex_shader->num_constants);
+        copy_shader_entry(*desc.vertex_shader, vertex_shader, vertex_entry, vertex_specializations);
         descriptor.vertex_shader = &vertex_shader;
     }
     if (desc.tesc_shader)
     {
-        tesc_shader = *desc.tesc_shader;
-        tesc_specializations = skr::Vector<CGPUConstantSpecialization>(desc.tesc_shader->constants, desc.tesc_shader->num_constants);
+        copy_shader_entry(*desc.tesc_shader, tesc_shader, tesc_entry, tesc_specializations);
         descriptor.tesc_shader = &tesc_shader;
     }
     if (desc.tese_shader)
     {
-        tese_shader = *desc.tese_shader;
-        tese_specializations = skr::Vector<CGPUConstantSpecialization>(desc.tese_shader->constants, desc.tese_shader->num_constants);
+        copy_shader_entry(*desc.tese_shader, tese_shader, tese_entry, tese_specializations);
         descriptor.tese_shader = &tese_shader;
     }
     if (desc.geom_shader)
     {
-        geom_shader = *desc.geom_shader;
-        geom_specializations = skr::Vector<CGPUConstantSpecialization>(desc.geom_shader->constants, desc.geom_shader->num_constants);
+        copy_shader_entry(*desc.geom_shader, geom_shader, geom_entry, geom_specializations);
         descriptor.geom_shader = &geom_shader;
     }
     if (desc.fragment_shader)
     {
-        fragment_shader = *desc.fragment_shader;
-        fragment_specializations = skr::Vector<CGPUConstantSpecialization>(desc.fragment_shader->constants, desc.fragment_shader->num_constants);
+        copy_shader_entry(*desc.fragment_shader, fragment_shader, fragment_entry, fragment_specializations);
         descriptor.fragment_shader = &fragment_shader;
     }
     if (desc.vertex_layout) vertex_layout = *desc.vertex_layout;
@@ -73,5 +83,137 @@ PSOMapKey::~PSOMapKey() SKR_NOEXCEPT
     root_signature = nullptr;
 }
 
+// states are flat PODs (see cgpux.hpp) and go in as they are, a change of their layout changes the record size
+// and invalidates old databases. shader entries follow the header: the NUL terminated name then the constants
+struct PSOKeyRecordHeader
+{
+    uint64_t root_signature;
+    uint64_t libraries[PSOKeyRecord::kStageCount];
+    uint32_t stages[PSOKeyRecord::kStageCount];
+    uint32_t entry_sizes[PSOKeyRecord::kStageCount];
+    uint32_t constant_counts[PSOKeyRecord::kStageCount];
+    CGPUVertexLayout vertex_layout;
+    CGPUBlendStateDescriptor blend_state;
+    CGPUDepthStateDescriptor depth_state;
+    CGPURasterizerStateDescriptor rasterizer_state;
+    ECGPUFormat color_formats[CGPU_MAX_MRT_COUNT];
+    uint32_t render_target_count;
+    ECGPUSampleCount sample_count;
+    uint32_t sample_quality;
+    ECGPUSlotMask color_resolve_disable_mask;
+    ECGPUFormat depth_stencil_format;
+    ECGPUPrimitiveTopology prim_topology;
+    uint32_t enable_indirect_command;
+};
+
+bool write_pso_key_record(const PSOMapKey& key, const skr_pso_map_key_resolver_t& resolver, skr::Vector<uint8_t>& out) SKR_NOEXCEPT
+{
+    if (!resolver.name_shader_library || !resolver.name_root_signature) return false;
+
+    const CGPUShaderEntryDescriptor* const shaders[PSOKeyRecord::kStageCount] = {
+        key.descriptor.vertex_shader, key.descriptor.tesc_shader, key.descriptor.tese_shader,
+        key.descriptor.geom_shader, key.descriptor.fragment_shader
+    };
+    auto header = make_zeroed<PSOKeyRecordHeader>();
+    header.root_signature = resolver.name_root_signature(resolver.usrdata, key.root_signature);
+    if (!header.root_signature) return false;
+    for (uint32_t i = 0; i < PSOKeyRecord::kStageCount; i++)
+    {
+        if (!shaders[i]) continue;
+        header.libraries[i] = resolver.name_shader_library(resolver.usrdata, shaders[i]->library);
+        if (!header.libraries[i]) return false;
+        header.stages[i] = shaders[i]->stage;
+        header.entry_sizes[i] = shaders[i]->entry ? (uint32_t)strlen((const char*)shaders[i]->entry) + 1 : 0;
+        header.constant_counts[i] = shaders[i]->num_constants;
+    }
+    header.vertex_layout = key.vertex_layout;
+    header.blend_state = key.blend_state;
+    header.depth_state = key.depth_state;
+    header.rasterizer_state = key.rasterizer_state;
+    memcpy(header.color_formats, key.color_formats, sizeof(header.color_formats));
+    header.render_target_count = key.descriptor.render_target_count;
+    header.sample_count = key.descriptor.sample_count;
+    header.sample_quality = key.descriptor.sample_quality;
+    header.color_resolve_disable_mask = key.descriptor.color_resolve_disable_mask;
+    header.depth_stencil_format = key.descriptor.depth_stencil_format;
+    header.prim_topology = key.descriptor.prim_topology;
+    header.enable_indirect_command = key.descriptor.enable_indirect_command;
+
+    out.append((const uint8_t*)&header, sizeof(header));
+    for (uint32_t i = 0; i < PSOKeyRecord::kStageCount; i++)
+    {
+        if (!shaders[i]) continue;
+        out.append((const uint8_t*)shaders[i]->entry, header.entry_sizes[i]);
+        out.append((const uint8_t*)shaders[i]->constants, header.constant_counts[i] * sizeof(CGPUConstantSpecialization));
+    }
+    return true;
+}
+
+bool PSOKeyRecord::read(const uint8_t* data, uint64_t size, const skr_pso_map_key_resolver_t& resolver) SKR_NOEXCEPT
+{
+    if (!resolver.resolve_shader_library || !resolver.resolve_root_signature) return false;
+    if (size < sizeof(PSOKeyRecordHeader)) return false;
+
+    PSOKeyRecordHeader header;
+    memcpy(&header, data, sizeof(header));
+    descriptor = make_zeroed<CGPURenderPipelineDescriptor>();
+    descriptor.root_signature = resolver.resolve_root_signature(resolver.usrdata, header.root_signature);
+    if (!descriptor.root_signature) return false;
+
+    const CGPUShaderEntryDescriptor** const targets[kStageCount] = {
+        &descriptor.vertex_shader, &descriptor.tesc_shader, &descriptor.tese_shader,
+        &descriptor.geom_shader, &descriptor.fragment_shader
+    };
+    uint64_t cursor = sizeof(header);
+    for (uint32_t i = 0; i < kStageCount; i++)
+    {
+        if (!header.libraries[i]) continue;
+        const uint64_t constants_size = (uint64_t)header.constant_counts[i] * sizeof(CGPUConstantSpecialization);
+        if (cursor + header.entry_sizes[i] + constants_size > size) return false;
+
+        auto& shader = shaders[i];
+        shader = make_zeroed<CGPUShaderEntryDescriptor>();
+        shader.library = resolver.resolve_shader_library(resolver.usrdata, header.libraries[i]);
+        if (!shader.library) return false;
+        shader.stage = (ECGPUShaderStage)header.stages[i];
+        if (header.entry_sizes[i])
+        {
+            if (data[cursor + header.entry_sizes[i] - 1] != 0) return false;
+            shader.entry = (const char8_t*)(data + cursor);
+        }
+        cursor += header.entry_sizes[i];
+        // constants are not aligned inside the record
+        specializations[i].resize_unsafe(header.constant_counts[i]);
+        memcpy(specializations[i].data(), data + cursor, constants_size);
+        cursor += constants_size;
+        shader.constants = specializations[i].data();
+        shader.num_constants = header.constant_counts[i];
+        *targets[i] = &shader;
+    }
+    vertex_layout = header.vertex_layout;
+    blend_state = header.blend_state;
+    depth_state = header.depth_state;
+    rasterizer_state = header.rasterizer_state;
+    memcpy(color_formats, header.color_formats, sizeof(color_formats));
+    descriptor.vertex_layout = &vertex_layout;
+    descriptor.blend_state = &blend_state;
+    descriptor.depth_state = &depth_state;
+    descriptor.rasterizer_state = &rasterizer_state;
+    descriptor.color_formats = color_formats;
+    descriptor.render_target_count = header.render_target_count;
+    descriptor.sample_count = header.sample_count;
+    descriptor.sample_quality = header.sample_quality;
+    descriptor.color_resolve_disable_mask = header.color_resolve_disable_mask;
+    descriptor.depth_stencil_format = header.depth_stencil_format;
+    descriptor.prim_topology = header.prim_topology;
+    descriptor.enable_indirect_command = header.enable_indirect_command;
+    return true;
+}
+
+uint32_t pso_key_record_header_size() SKR_NOEXCEPT
+{
+    return (uint32_t)sizeof(PSOKeyRecordHeader);
+}
+
 } // namespace renderer
-} // namespace skr
\ No newline at end of file
+} // namespace skr
@@ -3,11 +3,17 @@
 #include "SkrCore/async/thread_job.hpp"
 #include "SkrContainers/sptr.hpp"
 #include "SkrContainers/hashmap.hpp"
+#include "SkrBase/misc/hash.h"
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
+#include "SkrOS/thread.h"
 
 #include "SkrRenderer/pso_key.hpp"
 #include "SkrRenderer/pso_map.h"
 
 #include "SkrProfile/profile.h"
+#include <algorithm>
+#include <string.h>
 
 namespace skr {
 namespace renderer {
@@ -38,16 +44,40 @@ struct PSOProgress : public skr::AsyncProgress<PSOFutureLauncher, int, bool>
     skr_pso_map_key_id key;
 };
 
+// key database: a header, then per record a PSOKeyDatabaseRecord followed by the record written by write_pso_key_record
+struct PSOKeyDatabaseHeader
+{
+    static constexpr uint32_t kMagic = 0x4F535053; // SPSO
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_header_size;
+    uint32_t record_count;
+};
+
+struct PSOKeyDatabaseRecord
+{
+    uint32_t size;
+    uint32_t uses;
+    uint64_t first_use;
+};
+
 struct PSOMapImpl : public skr_pso_map_t
 {
     PSOMapImpl(const skr_pso_map_root_t& root)
         : root(root)
     {
         future_launcher = SPtr<PSOFutureLauncher>::Create(root.job_queue);
+        if (root.key_resolver) resolver = *root.key_resolver;
+        skr_init_mutex(&records_mutex);
     }
 
     ~PSOMapImpl()
     {
+        // precompiled psos may still be in flight
+        mPSOProgresses.clear();
+        skr_destroy_mutex(&records_mutex);
         for (auto& it : sets)
         {
             cgpu_free_render_pipeline(it->pso);
@@ -84,10 +114,19 @@ struct PSOMapImpl : public skr_pso_map_t
         }
     };
 
+    // keys hold the pool signature, look them up the same way
+    static CGPURenderPipelineDescriptor pooled_descriptor(const CGPURenderPipelineDescriptor& desc)
+    {
+        auto pooled = desc;
+        if (desc.root_signature && desc.root_signature->pool_sig)
+            pooled.root_signature = desc.root_signature->pool_sig;
+        return pooled;
+    }
+
     virtual skr_pso_map_key_id create_key(const struct CGPURenderPipelineDescriptor* desc) SKR_NOEXCEPT override
     {
         SKR_ASSERT(desc && "NULL descriptor not allowed!");
-        auto found = sets.find(*desc);
+        auto found = sets.find(pooled_descriptor(*desc));
         if (found != sets.end())
         {
             skr_pso_map_key_id result = found->get();
@@ -140,7 +179,8 @@ struct PSOMapImpl : public skr_pso_map_t
     virtual ESkrPSOMapPSOStatus install_pso(skr_pso_map_key_id key) SKR_NOEXCEPT override
     {
         if (!key) return SKR_PSO_MAP_PSO_STATUS_FAILED;
-        
+        record_install(key);
+
         auto found = sets.find(key->descriptor);
         const auto pso_rc = skr_atomic_load_relaxed(&key->pso_rc);
         skr_atomic_fetch_add_relaxed(&key->pso_rc, 1);
@@ -155,6 +195,7 @@ struct PSOMapImpl : public skr_pso_map_t
             {
                 if (pso_rc == 0)
                 {
+                    skr_atomic_fetch_add_relaxed(&install_misses, 1);
                     return install_pso_impl(key);
                 }
                 else
@@ -170,12 +211,14 @@ struct PSOMapImpl : public skr_pso_map_t
             // 1.2 request is done or failed
             else if (pso_status == SKR_PSO_MAP_PSO_STATUS_REQUESTED)
             {
+                skr_atomic_fetch_add_relaxed(&install_hits, 1);
                 skr_atomic_store_relaxed(&pFound->frame, frame_index);
                 return SKR_PSO_MAP_PSO_STATUS_REQUESTED;
             }
             // 1.3 request is done, record frame index
             else if (pso_status == SKR_PSO_MAP_PSO_STATUS_INSTALLED)
             {
+                skr_atomic_fetch_add_relaxed(&install_hits, 1);
                 skr_atomic_store_relaxed(&pFound->frame, frame_index);
                 return SKR_PSO_MAP_PSO_STATUS_INSTALLED;
             }
@@ -184,6 +227,7 @@ struct PSOMapImpl : public skr_pso_map_t
         else
         {
             // keep PSOMapKey::frame at UINT64_MAX until pso is created
+            skr_atomic_fetch_add_relaxed(&install_misses, 1);
             return install_pso_impl(key);
         }
         return SKR_PSO_MAP_PSO_STATUS_FAILED;
@@ -262,8 +306,201 @@ struct PSOMapImpl : public skr_pso_map_t
         clearFinishedRequests();
     }
 
+    void record_install(skr_pso_map_key_id key) SKR_NOEXCEPT
+    {
+        if (!resolver.name_shader_library) return;
+
+        SMutexLock lock(records_mutex);
+        if (!key->record_hash)
+        {
+            skr::Vector<uint8_t> data;
+            if (!write_pso_key_record(*key, resolver, data)) return;
+            const uint64_t hash = skr_hash64(data.data(), data.size(), SKR_DEFAULT_HASH_SEED_64);
+            key->record_hash = hash ? hash : 1;
+            if (records.find(key->record_hash) == records.end())
+            {
+                KeyRecord record;
+                record.data = std::move(data);
+                records.emplace(key->record_hash, std::move(record));
+            }
+        }
+        auto& record = records.find(key->record_hash)->second;
+        record.uses++;
+        if (!record.installed)
+        {
+            // recorded runs only tell when the key was needed the last time it was
+            record.installed = true;
+            record.first_use = frame_index;
+        }
+    }
+
+    virtual void write_key_database(uint64_t* size, uint8_t* data) SKR_NOEXCEPT override
+    {
+        SMutexLock lock(records_mutex);
+        uint64_t total = sizeof(PSOKeyDatabaseHeader);
+        for (const auto& it : records)
+            total += sizeof(PSOKeyDatabaseRecord) + it.second.data.size();
+        if (!data)
+        {
+            *size = total;
+            return;
+        }
+        if (*size < total)
+        {
+            *size = 0;
+            return;
+        }
+
+        PSOKeyDatabaseHeader header = {};
+        header.magic = PSOKeyDatabaseHeader::kMagic;
+        header.version = PSOKeyDatabaseHeader::kVersion;
+        header.record_header_size = pso_key_record_header_size();
+        header.record_count = (uint32_t)records.size();
+        uint8_t* cursor = data;
+        memcpy(cursor, &header, sizeof(header));
+        cursor += sizeof(header);
+        for (const auto& it : records)
+        {
+            PSOKeyDatabaseRecord record = {};
+            record.size = (uint32_t)it.second.data.size();
+            record.uses = it.second.uses;
+            record.first_use = it.second.first_use;
+            memcpy(cursor, &record, sizeof(record));
+            cursor += sizeof(record);
+            memcpy(cursor, it.second.data.data(), record.size);
+            cursor += record.size;
+        }
+        *size = total;
+    }
+
+    virtual uint32_t precompile(const uint8_t* data, uint64_t size) SKR_NOEXCEPT override
+    {
+        SkrZoneScopedN("PrecompilePSOs");
+        if (!resolver.resolve_shader_library || !data || size < sizeof(PSOKeyDatabaseHeader)) return 0;
+
+        PSOKeyDatabaseHeader header;
+        memcpy(&header, data, sizeof(header));
+        if (header.magic != PSOKeyDatabaseHeader::kMagic || header.version != PSOKeyDatabaseHeader::kVersion ||
+            header.record_header_size != pso_key_record_header_size())
+        {
+            SKR_LOG_WARN(u8"pso key database is out of date, skipping precompilation");
+            return 0;
+        }
+
+        // 1. read the records, they are written back with the database of this run
+        struct Pending
+        {
+            uint64_t hash;
+            uint64_t offset;
+            uint32_t size;
+            uint32_t uses;
+            uint64_t first_use;
+        };
+        skr::Vector<Pending> pending;
+        {
+            SMutexLock lock(records_mutex);
+            uint64_t cursor = sizeof(header);
+            for (uint32_t i = 0; i < header.record_count; i++)
+            {
+                PSOKeyDatabaseRecord record;
+                if (cursor + sizeof(record) > size) break;
+                memcpy(&record, data + cursor, sizeof(record));
+                cursor += sizeof(record);
+                if (cursor + record.size > size) break;
+
+                uint64_t hash = skr_hash64(data + cursor, record.size, SKR_DEFAULT_HASH_SEED_64);
+                hash = hash ? hash : 1;
+                if (records.find(hash) == records.end())
+                {
+                    KeyRecord key_record;
+                    key_record.data.append(data + cursor, record.size);
+                    key_record.uses = record.uses;
+                    key_record.first_use = record.first_use;
+                    records.emplace(hash, std::move(key_record));
+                }
+                pending.add({ hash, cursor, record.size, record.uses, record.first_use });
+                cursor += record.size;
+            }
+        }
+
+        // 2. most installed keys first, then the ones needed earliest
+        std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+            if (a.uses != b.uses) return a.uses > b.uses;
+            return a.first_use < b.first_use;
+        });
+
+        // 3. queue them in that order, the job queue runs them as they come
+        precompile_start = skr_sys_get_usec(true);
+        uint32_t queued = 0;
+        for (const auto& record : pending)
+        {
+            PSOKeyRecord key_record;
+            if (!key_record.read(data + record.offset, record.size, resolver))
+            {
+                skr_atomic_fetch_add_relaxed(&precompile_failed, 1);
+                continue;
+            }
+            const auto descriptor = pooled_descriptor(key_record.descriptor);
+            if (sets.find(descriptor) != sets.end()) continue;
+
+            // no frame until the key is first used, garbage collection keeps it around till then
+            auto key = SPtr<PSOMapKey>::CreateZeroed(descriptor, UINT64_MAX);
+            key->record_hash = record.hash;
+            key->precompiled = true;
+            if (!sets.insert(key).second) continue;
+
+            skr_atomic_fetch_add_relaxed(&precompile_requested, 1);
+            skr_atomic_fetch_add_relaxed(&precompile_pending, 1);
+            install_pso_impl(key.get());
+            queued++;
+        }
+        return queued;
+    }
+
+    void on_precompiled(bool succeed) SKR_NOEXCEPT
+    {
+        skr_atomic_fetch_add_relaxed(succeed ? &precompile_finished : &precompile_failed, 1);
+        if (skr_atomic_fetch_add_relaxed(&precompile_pending, -1) == 1)
+            skr_atomic_store_relaxed(&precompile_end, skr_sys_get_usec(true));
+    }
+
+    virtual void query_statistics(skr_pso_map_statistics_t* statistics) SKR_NOEXCEPT override
+    {
+        statistics->install_hits = skr_atomic_load_relaxed(&install_hits);
+        statistics->install_misses = skr_atomic_load_relaxed(&install_misses);
+        statistics->precompile_requested = skr_atomic_load_relaxed(&precompile_requested);
+        statistics->precompile_finished = skr_atomic_load_relaxed(&precompile_finished);
+        statistics->precompile_failed = skr_atomic_load_relaxed(&precompile_failed);
+        if (!statistics->precompile_requested)
+            statistics->precompile_usec = 0;
+        else if (skr_atomic_load_relaxed(&precompile_pending))
+            statistics->precompile_usec = skr_sys_get_usec(true) - precompile_start;
+        else
+            statistics->precompile_usec = skr_atomic_load_relaxed(&precompile_end) - precompile_start;
+    }
+
+    struct KeyRecord
+    {
+        skr::Vector<uint8_t> data;
+        uint32_t uses = 0;
+        uint64_t first_use = UINT64_MAX;
+        // installed during this run
+        bool installed = false;
+    };
+
     SPtr<PSOFutureLauncher> future_launcher;
     skr_pso_map_root_t root;
+    skr_pso_map_key_resolver_t resolver = {};
+    SMutex records_mutex;
+    skr::FlatHashMap<uint64_t, KeyRecord> records;
+    SAtomicU32 install_hits = 0;
+    SAtomicU32 install_misses = 0;
+    SAtomicU32 precompile_requested = 0;
+    SAtomicU32 precompile_finished = 0;
+    SAtomicU32 precompile_failed = 0;
+    SAtomicU32 precompile_pending = 0;
+    uint64_t precompile_start = 0;
+    SAtomicU64 precompile_end = 0;
     skr::ParallelFlatHashSet<SPtr<PSOMapKey>, key_ptr_hasher, key_ptr_equal> sets;
     skr::ParallelFlatHashMap<skr_pso_map_key_id, SPtr<PSOProgress>> mPSOProgresses;
     SAtomicU64 keys_counter = 0;
@@ -279,14 +516,14 @@ bool PSOProgress::do_in_background()
     {
         skr_atomic_store_relaxed(&key->pso_status, SKR_PSO_MAP_PSO_STATUS_INSTALLED);
         skr_atomic_store_relaxed(&key->pso_frame, map->frame_index); // store frame index to indicate pso is created
-        return true;
     }
     else
     {
         skr_atomic_store_relaxed(&key->pso_status, SKR_PSO_MAP_PSO_STATUS_FAILED);
         skr_atomic_store_relaxed(&key->pso_frame, UINT64_MAX); // store frame index to indicate pso is failed
-        return false;
     }
+    if (key->precompiled) map->on_precompiled(key->pso != nullptr);
+    return key->pso != nullptr;
 }
 
 } // namespace renderer
@@ -343,6 +580,21 @@ void skr_pso_map_garbage_collect(skr_pso_map_id psoMap, uint64_t critical_frame)
     psoMap->garbage_collect(critical_frame);
 }
 
+void skr_pso_map_write_key_database(skr_pso_map_id psoMap, uint64_t* size, uint8_t* data)
+{
+    psoMap->write_key_database(size, data);
+}
+
+uint32_t skr_pso_map_precompile(skr_pso_map_id psoMap, const uint8_t* data, uint64_t size)
+{
+    return psoMap->precompile(data, size);
+}
+
+void skr_pso_map_query_statistics(skr_pso_map_id psoMap, skr_pso_map_statistics_t* statistics)
+{
+    psoMap->query_statistics(statistics);
+}
+
 void skr_pso_map_free(skr_pso_map_id pso_map)
 {
     skr_pso_map_t::Free(pso_map);
@@ -16,7 +16,7 @@ void skr_render_mesh_initialize(skr_render_mesh_id render_mesh, skr_mesh_resourc
         {
             auto& prim = mesh_resource->primitives[prim_idx];
             vbv_c += (uint32_t)prim.vertex_buffers.size();
-            ibv_c++;
+            ibv_c += 1 + (uint32_t)prim.lods.size();
         }
     }
     // 2. do early reserve
@@ -51,8 +51,17 @@ void skr_render_mesh_initialize(skr_render_mesh_id render_mesh, skr_mesh_resourc
             mesh_ibv.stride = prim.index_buffer.stride;
             mesh_ibv.index_count = prim.index_buffer.index_count;
             mesh_ibv.first_index = prim.index_buffer.first_index;
+            // 3.3 fill lod ibvs, they follow the ibv of LOD 0
+            for (const auto& lod : prim.lods)
+            {
+                auto& lod_ibv = render_mesh->index_buffer_views.add_default().ref();
+                lod_ibv = mesh_ibv;
+                lod_ibv.index_count = lod.index_count;
+                lod_ibv.first_index = lod.first_index;
+            }
 
             draw_cmd.ibv = &mesh_ibv;
+            draw_cmd.lod_ibvs = { &mesh_ibv, 1 + prim.lods.size() };
             draw_cmd.vbvs = { render_mesh->vertex_buffer_views.data() + vbv_start, prim.vertex_buffers.size() };
             draw_cmd.primitive_index = prim_idx;
             draw_cmd.material_index = prim.material_index;
@@ -60,6 +69,21 @@ void skr_render_mesh_initialize(skr_render_mesh_id render_mesh, skr_mesh_resourc
     }
 }
 
+uint32_t skr_render_mesh_select_lod(skr_render_mesh_id render_mesh, uint32_t command_index, float pixels_per_unit, float max_pixel_error)
+{
+    const auto& cmd = render_mesh->primitive_commands[command_index];
+    const auto& lods = render_mesh->mesh_resource_id->primitives[cmd.primitive_index].lods;
+    uint32_t selected = 0;
+    // no screen size to measure the error against (behind the camera, unset projection...), keep full detail
+    if (!(pixels_per_unit > 0.f)) return selected;
+    for (uint32_t i = 0; i < lods.size(); i++)
+    {
+        if (lods[i].error * pixels_per_unit > max_pixel_error) break;
+        selected = i + 1;
+    }
+    return selected;
+}
+
 void skr_render_mesh_free(skr_render_mesh_id render_mesh)
 {
     for (auto&& buffer : render_mesh->buffers)
@@ -6,6 +6,8 @@
 #include "SkrRenderer/render_viewport.h"
 #include "SkrRenderer/render_effect.h"
 #include "SkrRenderer/skr_renderer.h"
+#include "SkrRenderer/render_device.h"
+#include "SkrRenderer/draw_instancing.hpp"
 #include "SkrRenderGraph/frontend/render_graph.hpp"
 
 #include "SkrProfile/profile.h"
@@ -70,6 +72,7 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
 
     ~SkrRendererImpl() override
     {
+        if (instancer_initialized) instancer.finalize();
         for (auto proxy : processor_vtbl_proxies)
         {
             if (proxy) SkrDelete(proxy);
@@ -89,6 +92,17 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
 
     void render(skr::render_graph::RenderGraph* render_graph) override
     {
+        if (!instancing_processors.empty())
+        {
+            if (!instancer_initialized)
+            {
+                // one more slot than frames in flight: instances are written before the graph waits for the frame that used the slot
+                instancer.initialize(render_device->get_cgpu_device(), RG_MAX_FRAME_IN_FLIGHT + 1);
+                instancer_initialized = true;
+            }
+            instancer.begin_frame(render_graph->get_frame_index());
+        }
+
         // produce draw calls
         {
             SkrZoneScopedN("ForeachProcessors(Sync)");
@@ -117,8 +131,11 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
                         draw_context.render_graph = render_graph;
                         draw_context.pass = pass;
                         draw_context.storage = storage;
+                        draw_context.visibility = visibility;
 
                         auto packet = processor->produce_draw_packets(&draw_context);
+                        if (instancing_processors.contains(processor))
+                            packet = instancer.merge(packet);
                         draw_packets[pass->identity()].add(packet);
                     }
                 }
@@ -170,6 +187,11 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
         return viewport_manager;
     }
 
+    void set_visibility(const skr::CullingResult* result) override
+    {
+        visibility = result;
+    }
+
     SViewportManager* viewport_manager = nullptr;
 
     template<typename T>
@@ -182,11 +204,15 @@ struct SKR_RENDERER_API SkrRendererImpl : public SRenderer
     FlatStringMap<IRenderEffectProcessor*> processors_map;
 
     skr::Vector<RenderEffectProcessorVtblProxy*> processor_vtbl_proxies;
+    skr::Vector<IRenderEffectProcessor*> instancing_processors;
 protected:
     FlatStringMap<skr::Vector<skr_primitive_draw_packet_t>> draw_packets;
 
     SRenderDevice* render_device = nullptr;
     sugoi_storage_t* storage = nullptr;
+    const skr::CullingResult* visibility = nullptr;
+    skr::renderer::DrawInstancer instancer;
+    bool instancer_initialized = false;
 };
 
 SRendererId skr_create_renderer(SRenderDeviceId render_device, sugoi_storage_t* storage)
@@ -267,6 +293,7 @@ void skr_renderer_remove_render_effect(SRendererId r, skr_render_effect_name_t n
     if (auto&& _ = renderer->processors_map.find(name); _ != renderer->processors_map.end())
     {
         _->second->on_unregister(r, storage);
+        renderer->instancing_processors.remove(_->second);
         renderer->processors_map.erase(_);
         renderer->processors.remove_all_if(
             [_](auto&& p) { return p == _->second; }
@@ -274,6 +301,22 @@ void skr_renderer_remove_render_effect(SRendererId r, skr_render_effect_name_t n
     }
 }
 
+void skr_render_effect_set_instancing(SRendererId r, skr_render_effect_name_t name, bool enable)
+{
+    auto renderer = (SkrRendererImpl*)r;
+    auto&& i_processor = renderer->processors_map.find(name);
+    if (i_processor == renderer->processors_map.end())
+    {
+        SKR_ASSERT(false && "No render effect processor registered");
+        return;
+    }
+    const bool enabled = renderer->instancing_processors.contains(i_processor->second);
+    if (enable && !enabled)
+        renderer->instancing_processors.add(i_processor->second);
+    else if (!enable && enabled)
+        renderer->instancing_processors.remove(i_processor->second);
+}
+
 using render_effects_t = sugoi::ArrayComponent<skr_render_effect_t, 4>;
 
 void skr_render_effect_attach(SRendererId r, sugoi_chunk_view_t* g_cv, skr_render_effect_name_t effect_name)
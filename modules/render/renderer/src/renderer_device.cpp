@@ -2,10 +2,13 @@
 #include "SkrCore/memory/memory.h"
 #include "SkrContainers/vector.hpp"
 #include "SkrContainers/map.hpp"
+#include "SkrContainers/string.hpp"
+#include "SkrCore/log.h"
 #include "SkrGraphics/dstorage.h"
 #include "SkrGraphics/extensions/cgpu_nsight.h"
 #include "SkrRT/io/vram_io.hpp"
 #include "SkrRenderer/render_device.h"
+#include <stdio.h>
 
 namespace skr
 {
@@ -78,6 +81,8 @@ struct SKR_RENDERER_API RendererDeviceImpl : public RendererDevice {
     }
 
 protected:
+    void save_pipeline_cache();
+
     // Device objects
     uint32_t                                  backbuffer_index = 0;
     skr::Map<SWindowHandle, CGPUSurfaceId>   surfaces;
@@ -93,6 +98,7 @@ protected:
     CGPUDStorageQueueId                       memory_dstorage_queue = nullptr;
     CGPURootSignaturePoolId                   root_signature_pool   = nullptr;
     CGPUNSightTrackerId                       nsight_tracker        = nullptr;
+    skr::String                               pipeline_cache_path;
 };
 
 RendererDevice* RendererDevice::Create() SKR_NOEXCEPT
@@ -145,6 +151,7 @@ void RendererDeviceImpl::finalize()
     }
     cpy_queues.clear();
     cgpu_free_queue(gfx_queue);
+    save_pipeline_cache();
     cgpu_free_device(device);
     // free nsight tracker
     if (nsight_tracker)
@@ -152,6 +159,45 @@ void RendererDeviceImpl::finalize()
     cgpu_free_instance(instance);
 }
 
+static bool read_pipeline_cache(const char8_t* path, skr::Vector<uint8_t>& data)
+{
+    auto file = fopen((const char*)path, "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    bool succeed = size > 0;
+    if (succeed)
+    {
+        data.resize_unsafe((uint64_t)size);
+        succeed = fread(data.data(), 1, (size_t)size, file) == (size_t)size;
+    }
+    fclose(file);
+    return succeed;
+}
+
+void RendererDeviceImpl::save_pipeline_cache()
+{
+    if (pipeline_cache_path.is_empty()) return;
+
+    uint64_t size = 0;
+    cgpu_query_pipeline_cache_data(device, &size, nullptr);
+    if (!size) return;
+    skr::Vector<uint8_t> data;
+    data.resize_unsafe(size);
+    cgpu_query_pipeline_cache_data(device, &size, data.data());
+    if (!size) return;
+    if (auto file = fopen((const char*)pipeline_cache_path.u8_str(), "wb"))
+    {
+        fwrite(data.data(), 1, (size_t)size, file);
+        fclose(file);
+    }
+    else
+    {
+        SKR_LOG_WARN(u8"failed to write pipeline cache to %s", pipeline_cache_path.u8_str());
+    }
+}
+
 #define MAX_CPY_QUEUE_COUNT 2
 #define MAX_CMPT_QUEUE_COUNT 2
 void RendererDeviceImpl::create_api_objects(const Builder& builder)
@@ -198,9 +244,18 @@ void RendererDeviceImpl::create_api_objects(const Builder& builder)
         CmptDesc.queue_count = cmpt_queue_count_;
     }
 
+    skr::Vector<uint8_t> pipeline_cache;
+    if (builder.pipeline_cache_path)
+    {
+        pipeline_cache_path = builder.pipeline_cache_path;
+        read_pipeline_cache(builder.pipeline_cache_path, pipeline_cache);
+    }
+
     CGPUDeviceDescriptor device_desc = {};
     device_desc.queue_groups         = Gs.data();
     device_desc.queue_group_count    = (uint32_t)Gs.size();
+    device_desc.pipeline_cache_data  = pipeline_cache.data();
+    device_desc.pipeline_cache_size  = pipeline_cache.size();
     device                           = cgpu_create_device(adapter, &device_desc);
     gfx_queue                        = cgpu_get_queue(device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
 
@@ -49,6 +49,10 @@ void SkrRendererModule::on_load(int argc, char8_t** argv)
         {
             builder.backend = CGPU_BACKEND_D3D12;
         }
+        else if (::strcmp((const char*)argv[i], "--null") == 0)
+        {
+            builder.backend = CGPU_BACKEND_NULL;
+        }
         builder.enable_debug_layer |= (0 == ::strcmp((const char*)argv[i], "--debug_layer"));
         builder.enable_gpu_based_validation |= (0 == ::strcmp((const char*)argv[i], "--gpu_based_validation"));
         builder.enable_set_name |= (0 == ::strcmp((const char*)argv[i], "--gpu_obj_name"));
@@ -72,6 +76,8 @@ void SkrRendererModule::on_load(int argc, char8_t** argv)
         vertex_layout.attribute_count = 5;
         skr_mesh_resource_register_vertex_layout(::kGLTFVertexLayoutWithTangentId, u8"StaticMeshWithTangent", &vertex_layout);
     }
+    // no quantized layout until a vertex shader decodes snorm positions with MeshResource::position_offset & position_scale
+    // and octahedral normals & tangents, the layouts above keep their streams in floats
 }
 
 void SkrRendererModule::on_unload()
@@ -11,6 +11,9 @@
 #include "SkrRT/resource/resource_factory.h"
 #include "SkrRT/resource/resource_system.h"
 #include "SkrRenderer/render_device.h"
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
+#include "MeshOpt/meshoptimizer.h"
 
 #include "SkrContainers/sptr.hpp"
 #include "SkrContainers/string.hpp"
@@ -18,6 +21,7 @@
 #include "SkrContainers/hashmap.hpp"
 
 #include "SkrProfile/profile.h"
+#include <atomic>
 
 static struct SkrMeshResourceUtil {
     struct RegisteredVertexLayout : public CGPUVertexLayout {
@@ -166,6 +170,64 @@ MeshResource::~MeshResource() SKR_NOEXCEPT
 {
 }
 
+bool GetMeshletView(const MeshResource* mesh, uint32_t primitive_index, MeshletView& out_view) SKR_NOEXCEPT
+{
+    const auto& entry = mesh->primitives[primitive_index].meshlets;
+    if (!entry.meshlet_count)
+        return false;
+    const auto& bin = mesh->bins[entry.buffer_index];
+    if (!bin.blob || !bin.blob->get_data())
+        return false;
+    out_view = MeshletView::Get(bin.blob->get_data(), entry);
+    return true;
+}
+
+bool DecodeMeshBin(skr::span<const uint8_t> encoded, skr::span<uint8_t> out) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("DecodeMeshBin");
+    MeshBinHeader header;
+    if (encoded.size() < sizeof(header))
+        return false;
+    memcpy(&header, encoded.data(), sizeof(header));
+    if (header.magic != MeshBinHeader::kMagic || header.version != MeshBinHeader::kVersion || header.size != out.size())
+        return false;
+    const auto table_size = (uint64_t)header.chunk_count * sizeof(MeshBinChunk);
+    if (encoded.size() < sizeof(header) + table_size)
+        return false;
+    memset(out.data(), 0, out.size());
+    const auto* table   = encoded.data() + sizeof(header);
+    uint64_t    payload = sizeof(header) + table_size;
+    for (uint32_t i = 0; i < header.chunk_count; i++)
+    {
+        MeshBinChunk chunk;
+        memcpy(&chunk, table + i * sizeof(MeshBinChunk), sizeof(chunk));
+        if (chunk.offset + chunk.size > out.size() || payload + chunk.encoded_size > encoded.size())
+            return false;
+        const auto* src = encoded.data() + payload;
+        auto*       dst = out.data() + chunk.offset;
+        switch (chunk.codec)
+        {
+            case EMeshBinCodec::Raw:
+                if (chunk.encoded_size != chunk.size)
+                    return false;
+                memcpy(dst, src, chunk.size);
+                break;
+            case EMeshBinCodec::Vertex:
+                if (!chunk.stride || meshopt_decodeVertexBuffer(dst, chunk.size / chunk.stride, chunk.stride, src, chunk.encoded_size) != 0)
+                    return false;
+                break;
+            case EMeshBinCodec::Index:
+                if (!chunk.stride || meshopt_decodeIndexBuffer(dst, chunk.size / chunk.stride, chunk.stride, src, chunk.encoded_size) != 0)
+                    return false;
+                break;
+            default:
+                return false;
+        }
+        payload += chunk.encoded_size;
+    }
+    return true;
+}
+
 // 1.deserialize mesh resource
 // 2.install indices/vertices to GPU
 // 3?.update LOD information during runtime
@@ -189,6 +251,7 @@ struct SKR_RENDERER_API SMeshFactoryImpl : public SMeshFactory {
     {
         NONE,
         ZLIB,
+        MESHOPT,
         COUNT
     };
 
@@ -196,6 +259,16 @@ struct SKR_RENDERER_API SMeshFactoryImpl : public SMeshFactory {
         ECompressMethod compress_method;
     };
 
+    struct BufferRequest;
+    // a meshopt encoded bin, read to RAM & decoded on the I/O workers before it is uploaded from memory
+    struct CompressedBin {
+        SMeshFactoryImpl*    factory       = nullptr;
+        BufferRequest*       owner         = nullptr;
+        skr_mesh_resource_id mesh_resource = nullptr;
+        uint32_t             index         = 0;
+        CGPUBufferDescriptor bdesc         = {};
+    };
+
     struct BufferRequest {
         BufferRequest() SKR_NOEXCEPT  = default;
         ~BufferRequest() SKR_NOEXCEPT = default;
@@ -203,6 +276,15 @@ struct SKR_RENDERER_API SMeshFactoryImpl : public SMeshFactory {
         skr::Vector<std::string>             absPaths;
         skr::Vector<skr_io_future_t>         dFutures;
         skr::Vector<skr::io::VRAMIOBufferId> dBuffers;
+
+        skr::Vector<CompressedBin>          compressedBins;
+        skr::Vector<skr_io_future_t>        ramFutures;
+        skr::Vector<skr::io::RAMIOBufferId> ramBuffers;
+        skr::Vector<skr::BlobId>            decodedBlobs;
+        std::atomic<uint32_t>               decodedCount = 0;
+        std::atomic<bool>                   decodeFailed = false;
+        std::atomic<uint64_t>               decodeTime   = 0; // microseconds
+        uint64_t                            installStart = 0;
     };
 
     struct UploadRequest {
@@ -224,6 +306,7 @@ struct SKR_RENDERER_API SMeshFactoryImpl : public SMeshFactory {
     };
 
     ESkrInstallStatus InstallImpl(skr_resource_record_t* record);
+    void              DecodeAndUpload(CompressedBin* compressedBin);
 
     skr::String                                                 dstorage_root;
     Root                                                        root;
@@ -272,7 +355,6 @@ ESkrInstallStatus SMeshFactoryImpl::Install(skr_resource_record_t* record)
 
 ESkrInstallStatus SMeshFactoryImpl::InstallImpl(skr_resource_record_t* record)
 {
-    const auto noCompression = true;
     auto       vram_service  = root.vram_service;
     auto       mesh_resource = (skr_mesh_resource_t*)record->resource;
     auto       guid          = record->activeRequest->GetGuid();
@@ -280,56 +362,104 @@ ESkrInstallStatus SMeshFactoryImpl::InstallImpl(skr_resource_record_t* record)
     {
         [[maybe_unused]] auto dsqueue = render_device->get_file_dstorage_queue();
         auto                  batch   = vram_service->open_batch(mesh_resource->bins.size());
-        if (noCompression)
+        auto                  dRequest = SPtr<BufferRequest>::Create();
+        dRequest->installStart = skr_sys_get_usec(true);
+        dRequest->absPaths.resize_default(mesh_resource->bins.size());
+        dRequest->dFutures.resize_zeroed(mesh_resource->bins.size());
+        dRequest->dBuffers.resize_zeroed(mesh_resource->bins.size());
+        InstallType installType = { ECompressMethod::NONE };
+        for (const auto& bin : mesh_resource->bins)
         {
-            auto dRequest = SPtr<BufferRequest>::Create();
-            dRequest->absPaths.resize_default(mesh_resource->bins.size());
-            dRequest->dFutures.resize_zeroed(mesh_resource->bins.size());
-            dRequest->dBuffers.resize_zeroed(mesh_resource->bins.size());
-            InstallType installType = { ECompressMethod::NONE };
-            for (auto i = 0u; i < mesh_resource->bins.size(); i++)
+            if (bin.compressed_length)
             {
-                auto binPath = skr::format(u8"{}.buffer{}", guid, i);
-                // TODO: REFACTOR THIS WITH VFS PATH
-                // auto fullBinPath = skr::filesystem::path(root.dstorage_root) / binPath.c_str();
-                // auto&& thisPath = dRequest->absPaths[i];
-                const auto& thisBin         = mesh_resource->bins[i];
-                auto&&      thisFuture      = dRequest->dFutures[i];
-                auto&&      thisDestination = dRequest->dBuffers[i];
-
-                CGPUResourceTypes flags = CGPU_RESOURCE_TYPE_NONE;
-                flags |= thisBin.used_with_index ? CGPU_RESOURCE_TYPE_INDEX_BUFFER : 0;
-                flags |= thisBin.used_with_vertex ? CGPU_RESOURCE_TYPE_VERTEX_BUFFER : 0;
-
-                CGPUBufferDescriptor bdesc = {};
-                bdesc.descriptors          = flags;
-                bdesc.memory_usage         = CGPU_MEM_USAGE_GPU_ONLY;
-                bdesc.flags                = CGPU_BCF_NO_DESCRIPTOR_VIEW_CREATION;
-                bdesc.size                 = thisBin.byte_length;
-                bdesc.name                 = nullptr; // TODO: set name
-
-                auto request = vram_service->open_buffer_request();
-                request->set_vfs(root.vfs);
-                request->set_path(binPath.u8_str());
-                request->set_buffer(render_device->get_cgpu_device(), &bdesc);
-                request->set_transfer_queue(render_device->get_cpy_queue());
-                if (mesh_resource->install_to_ram)
-                {
-                    auto blob                   = request->pin_staging_buffer();
-                    mesh_resource->bins[i].blob = blob.get();
-                    blob->add_refcount();
-                }
-                auto result     = batch->add_request(request, &thisFuture);
-                thisDestination = skr::static_pointer_cast<skr::io::IVRAMIOBuffer>(result);
+                installType.compress_method = ECompressMethod::MESHOPT;
+                dRequest->compressedBins.add_default();
             }
-            mRequests.emplace(mesh_resource, dRequest);
-            mInstallTypes.emplace(mesh_resource, installType);
         }
-        else
+        dRequest->ramFutures.resize_zeroed(dRequest->compressedBins.size());
+        dRequest->ramBuffers.resize_zeroed(dRequest->compressedBins.size());
+        dRequest->decodedBlobs.resize_zeroed(dRequest->compressedBins.size());
+        auto                ram_service = vram_service->get_ram_service();
+        skr::io::IOBatchId  ram_batch   = nullptr;
+        uint32_t            compressed  = 0;
+        if (!dRequest->compressedBins.empty())
         {
-            SKR_UNIMPLEMENTED_FUNCTION();
+            ram_batch = ram_service->open_batch(dRequest->compressedBins.size());
+        }
+        for (auto i = 0u; i < mesh_resource->bins.size(); i++)
+        {
+            auto binPath = skr::format(u8"{}.buffer{}", guid, i);
+            // TODO: REFACTOR THIS WITH VFS PATH
+            // auto fullBinPath = skr::filesystem::path(root.dstorage_root) / binPath.c_str();
+            // auto&& thisPath = dRequest->absPaths[i];
+            const auto& thisBin         = mesh_resource->bins[i];
+            auto&&      thisFuture      = dRequest->dFutures[i];
+            auto&&      thisDestination = dRequest->dBuffers[i];
+
+            CGPUResourceTypes flags = CGPU_RESOURCE_TYPE_NONE;
+            flags |= thisBin.used_with_index ? CGPU_RESOURCE_TYPE_INDEX_BUFFER : 0;
+            flags |= thisBin.used_with_vertex ? CGPU_RESOURCE_TYPE_VERTEX_BUFFER : 0;
+            // meshlet streams are read by shaders as byte address buffers
+            flags |= thisBin.used_with_meshlet ? CGPU_RESOURCE_TYPE_BUFFER_RAW : 0;
+
+            CGPUBufferDescriptor bdesc = {};
+            bdesc.descriptors          = flags;
+            bdesc.memory_usage         = CGPU_MEM_USAGE_GPU_ONLY;
+            bdesc.flags                = thisBin.used_with_meshlet ? CGPU_BCF_NONE : CGPU_BCF_NO_DESCRIPTOR_VIEW_CREATION;
+            bdesc.size                 = thisBin.byte_length;
+            bdesc.elemet_count         = thisBin.used_with_meshlet ? thisBin.byte_length / sizeof(uint32_t) : 0;
+            bdesc.element_stride       = thisBin.used_with_meshlet ? sizeof(uint32_t) : 0;
+            bdesc.name                 = nullptr; // TODO: set name
+
+            if (thisBin.compressed_length)
+            {
+                auto& thisCompressed         = dRequest->compressedBins[compressed];
+                thisCompressed.factory       = this;
+                thisCompressed.owner         = dRequest.get();
+                thisCompressed.mesh_resource = mesh_resource;
+                thisCompressed.index         = i;
+                thisCompressed.bdesc         = bdesc;
+
+                auto ramRequest = ram_service->open_request();
+                ramRequest->set_vfs(root.vfs);
+                ramRequest->set_path(binPath.u8_str());
+                ramRequest->add_block({}); // read all
+                ramRequest->use_async_complete();
+                ramRequest->add_callback(SKR_IO_STAGE_COMPLETED, +[](skr_io_future_t* future, skr_io_request_t* request, void* data) noexcept {
+                    auto thisCompressed = (CompressedBin*)data;
+                    thisCompressed->factory->DecodeAndUpload(thisCompressed);
+                }, &thisCompressed);
+                auto result = ram_batch->add_request(ramRequest, &dRequest->ramFutures[compressed]);
+                dRequest->ramBuffers[compressed] = skr::static_pointer_cast<skr::io::IRAMIOBuffer>(result);
+                compressed++;
+                continue;
+            }
+
+            auto request = vram_service->open_buffer_request();
+            request->set_vfs(root.vfs);
+            request->set_path(binPath.u8_str());
+            request->set_buffer(render_device->get_cgpu_device(), &bdesc);
+            request->set_transfer_queue(render_device->get_cpy_queue());
+            if (mesh_resource->install_to_ram)
+            {
+                auto blob                   = request->pin_staging_buffer();
+                mesh_resource->bins[i].blob = blob.get();
+                blob->add_refcount();
+            }
+            auto result     = batch->add_request(request, &thisFuture);
+            thisDestination = skr::static_pointer_cast<skr::io::IVRAMIOBuffer>(result);
+        }
+        mRequests.emplace(mesh_resource, dRequest);
+        mInstallTypes.emplace(mesh_resource, installType);
+        // compressed bins are requested once every result is recorded, their callbacks read them
+        if (compressed)
+        {
+            ram_service->request(ram_batch);
+        }
+        if (compressed < mesh_resource->bins.size())
+        {
+            vram_service->request(batch);
         }
-        vram_service->request(batch);
     }
     else
     {
@@ -338,20 +468,96 @@ ESkrInstallStatus SMeshFactoryImpl::InstallImpl(skr_resource_record_t* record)
     return ESkrInstallStatus::SKR_INSTALL_STATUS_INPROGRESS;
 }
 
+void SMeshFactoryImpl::DecodeAndUpload(CompressedBin* compressedBin)
+{
+    SkrZoneScopedN("DecodeMeshBin");
+    auto       owner         = compressedBin->owner;
+    auto       mesh_resource = compressedBin->mesh_resource;
+    const auto slot          = (uint32_t)(compressedBin - owner->compressedBins.data());
+    const auto i             = compressedBin->index;
+    auto&      thisBin       = mesh_resource->bins[i];
+    const auto encoded       = owner->ramBuffers[slot];
+
+    const auto startTime = skr_sys_get_usec(true);
+    auto       decoded   = skr::IBlob::CreateAligned(nullptr, thisBin.byte_length, 16, false, "MeshBin");
+    const bool okay      = DecodeMeshBin({ encoded->get_data(), encoded->get_size() }, { decoded->get_data(), decoded->get_size() });
+    owner->decodeTime += skr_sys_get_usec(true) - startTime;
+    // the encoded copy is no longer needed
+    owner->ramBuffers[slot].reset();
+    if (!okay)
+    {
+        SKR_LOG_ERROR(u8"failed to decode mesh bin %u of %s!", i, mesh_resource->name.c_str());
+        owner->decodeFailed = true;
+        owner->decodedCount++;
+        return;
+    }
+    if (mesh_resource->install_to_ram)
+    {
+        thisBin.blob = decoded.get();
+        decoded->add_refcount();
+    }
+    owner->decodedBlobs[slot] = decoded;
+
+    auto render_device = root.render_device;
+    auto vram_service  = root.vram_service;
+    auto batch         = vram_service->open_batch(1);
+    auto request       = vram_service->open_buffer_request();
+    request->set_buffer(render_device->get_cgpu_device(), &compressedBin->bdesc);
+    request->set_transfer_queue(render_device->get_cpy_queue());
+    request->set_memory_src(decoded->get_data(), decoded->get_size());
+    auto result         = batch->add_request(request, &owner->dFutures[i]);
+    owner->dBuffers[i] = skr::static_pointer_cast<skr::io::IVRAMIOBuffer>(result);
+    vram_service->request(batch);
+    owner->decodedCount++;
+}
+
 ESkrInstallStatus SMeshFactoryImpl::UpdateInstall(skr_resource_record_t* record)
 {
     auto mesh_resource = (skr_mesh_resource_t*)record->resource;
     auto dRequest      = mRequests.find(mesh_resource);
     if (dRequest != mRequests.end())
     {
-        bool okay = true;
-        for (auto&& dRequest : dRequest->second->dFutures)
+        // uploads of compressed bins are requested by their decode callbacks
+        auto& request = *dRequest->second;
+        bool  okay    = request.decodedCount == request.compressedBins.size();
+        if (okay && request.decodeFailed)
+        {
+            for (auto&& future : request.dFutures)
+            {
+                const auto stage = future.get_status();
+                if (stage != SKR_IO_STAGE_NONE && stage != SKR_IO_STAGE_COMPLETED && stage != SKR_IO_STAGE_CANCELLED)
+                    return ESkrInstallStatus::SKR_INSTALL_STATUS_INPROGRESS;
+            }
+            for (auto&& buffer : request.dBuffers)
+            {
+                if (buffer && buffer->get_buffer())
+                    cgpu_free_buffer(buffer->get_buffer());
+            }
+            mRequests.erase(mesh_resource);
+            mInstallTypes.erase(mesh_resource);
+            return ESkrInstallStatus::SKR_INSTALL_STATUS_FAILED;
+        }
+        for (auto&& dRequest : request.dFutures)
         {
             okay &= dRequest.is_ready();
         }
         auto status = okay ? ESkrInstallStatus::SKR_INSTALL_STATUS_SUCCEED : ESkrInstallStatus::SKR_INSTALL_STATUS_INPROGRESS;
         if (okay)
         {
+            if (!request.compressedBins.empty())
+            {
+                uint64_t decodedBytes = 0;
+                uint64_t encodedBytes = 0;
+                for (const auto& bin : mesh_resource->bins)
+                {
+                    decodedBytes += bin.compressed_length ? bin.byte_length : 0;
+                    encodedBytes += bin.compressed_length;
+                }
+                const auto decodeTime = std::max<uint64_t>(request.decodeTime, 1);
+                SKR_LOG_DEBUG(u8"mesh %s installed in %.2fms, decoded %llu -> %llu bytes at %.2f GB/s",
+                    mesh_resource->name.c_str(), (skr_sys_get_usec(true) - request.installStart) / 1000.0,
+                    (unsigned long long)encodedBytes, (unsigned long long)decodedBytes, decodedBytes / (decodeTime * 1000.0));
+            }
             auto render_mesh = mesh_resource->render_mesh = SkrNew<skr_render_mesh_t>();
             // TODO: remove these requests
             const auto N = dRequest->second->dBuffers.size();
@@ -139,6 +139,7 @@ ECGPUShaderBytecodeType SShaderResourceFactory::GetRuntimeBytecodeType(ECGPUBack
         case CGPU_BACKEND_D3D12:
             return CGPU_SHADER_BYTECODE_TYPE_DXIL;
         case CGPU_BACKEND_VULKAN:
+        case CGPU_BACKEND_NULL: // reflects spirv when built with vulkan
             return CGPU_SHADER_BYTECODE_TYPE_SPIRV;
         case CGPU_BACKEND_METAL:
             return CGPU_SHADER_BYTECODE_TYPE_MTL;
@@ -177,6 +177,7 @@ ESkrInstallStatus STextureFactoryImpl::InstallImpl(skr_resource_record_t* record
             tdesc.height                = texture_resource->height;
             tdesc.depth                 = texture_resource->depth;
             tdesc.format                = (ECGPUFormat)texture_resource->format;
+            tdesc.mip_levels            = texture_resource->mips_count ? texture_resource->mips_count : 1;
 
             auto request = vram_service->open_texture_request();
             request->set_vfs(root.vfs);
@@ -216,12 +217,11 @@ ESkrInstallStatus STextureFactoryImpl::UpdateInstall(skr_resource_record_t* reco
         if (okay)
         {
             texture_resource->texture = dRequest->second->io_texture->get_texture();
-            // TODO: mipmap view
             CGPUTextureViewDescriptor view_desc = {};
             view_desc.texture                   = texture_resource->texture;
             view_desc.array_layer_count         = 1;
             view_desc.base_array_layer          = 0;
-            view_desc.mip_level_count           = 1;
+            view_desc.mip_level_count           = texture_resource->texture->info->mip_levels;
             view_desc.base_mip_level            = 0;
             view_desc.aspects                   = CGPU_TVA_COLOR;
             view_desc.dims                      = CGPU_TEX_DIMENSION_2D;
@@ -1,3 +1,5 @@
+add_requires("meshoptimizer >=0.1.0-skr")
+
 codegen_component("SkrRenderer", { api = "SKR_RENDERER", rootdir = "include/SkrRenderer" })
     add_files("include/**.h")
     add_files("include/**.hpp")
@@ -9,4 +11,6 @@ shared_module("SkrRenderer", "SKR_RENDERER", engine_version)
     add_includedirs("include", {public=true})
     add_rules("c++.unity_build", {batchsize = default_unity_batch})
     add_files("src/*.cpp")
-    add_files("src/resources/*.cpp", {unity_group = "resources"})
\ No newline at end of file
+    add_files("src/resources/*.cpp", {unity_group = "resources"})
+    -- meshoptimizer, decodes compressed mesh bins
+    add_packages("meshoptimizer")
\ No newline at end of file
@@ -30,6 +30,7 @@
 
 #include "SkrAnimTool/ozz/export.h"
 #include "SkrAnim/ozz/base/containers/map.h"
+#include "SkrAnim/ozz/base/span.h"
 
 namespace ozz {
 namespace animation {
@@ -70,6 +71,12 @@ class OZZ_ANIMOFFLINE_DLL AnimationOptimizer {
   bool operator()(const RawAnimation& _input, const Skeleton& _skeleton,
                   RawAnimation* _output) const;
 
+  // Batch version for clips of the same _skeleton. Joint settings are resolved
+  // once for all clips, and tracks of all clips are decimated in parallel on
+  // the task system. Returns false if any clip fails, see above.
+  bool operator()(span<const RawAnimation*> _inputs, const Skeleton& _skeleton,
+                  span<RawAnimation*> _outputs) const;
+
   // Optimization settings.
   struct Setting {
     // Default settings
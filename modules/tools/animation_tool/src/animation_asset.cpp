@@ -13,6 +13,7 @@
 #include "SkrAnim/resources/skeleton_resource.hpp"
 #include "SkrAnim/resources/animation_resource.hpp"
 #include "SkrToolCore/asset/json_utils.hpp"
+#include "SkrCore/time.h"
 
 #include "SkrProfile/profile.h"
 
@@ -44,6 +45,7 @@ bool SAnimCooker::Cook(SCookContext *ctx)
     //-----emit dependencies
     // no static dependencies
     //-----cook resource
+    const auto optimizeStart = skr_sys_get_usec(true);
     if(settings.optimize)
     {
         AnimationOptimizer optimizer;
@@ -114,12 +116,17 @@ bool SAnimCooker::Cook(SCookContext *ctx)
         *rawAnimation = std::move(rawAdditive);
     }
     
+    const auto buildStart = skr_sys_get_usec(true);
     AnimationBuilder builder;
     ozz::unique_ptr<ozz::animation::Animation> animation = builder(*rawAnimation);
     if (!animation) {
         SKR_LOG_ERROR(u8"Failed to build animation.");
         return false;
     }
+    const auto buildEnd = skr_sys_get_usec(true);
+    SKR_LOG_INFO(u8"Animation %s cooked: %d tracks, %.2fms optimizing, %.2fms building.", 
+        ctx->GetAssetRecord()->path.u8string().c_str(), rawAnimation->num_tracks(),
+        (buildStart - optimizeStart) / 1000.0, (buildEnd - buildStart) / 1000.0);
     AnimResource resource;
     resource.animation = std::move(*animation);
     //-----emit runtime dependencies
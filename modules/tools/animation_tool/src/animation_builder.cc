@@ -38,6 +38,7 @@
 #include "SkrAnim/ozz/base/containers/vector.h"
 #include "SkrAnim/ozz/base/maths/simd_math.h"
 #include "SkrAnim/ozz/base/memory/allocator.h"
+#include "SkrTask/fib_task.hpp"
 
 // Internal include file
 #define OZZ_INCLUDE_PRIVATE_HEADER  // Allows to include private headers.
@@ -310,11 +311,21 @@ unique_ptr<Animation> AnimationBuilder::operator()(
   animation->Allocate(_input.name.length(), sorting_translations.size(),
                       sorting_rotations.size(), sorting_scales.size());
 
-  // Copy sorted keys to final animation.
-  CopyToAnimation(&sorting_translations, &animation->translations_,
-                  inv_duration);
+  // Copy sorted keys to final animation. Channels are sorted & compressed
+  // concurrently, the sorting order is total so output stays deterministic.
+  skr::task::counter_t counter;
+  counter.add(2);
+  skr::task::schedule([&, counter]() mutable {
+    CopyToAnimation(&sorting_translations, &animation->translations_,
+                    inv_duration);
+    counter.decrement();
+  }, nullptr);
+  skr::task::schedule([&, counter]() mutable {
+    CopyToAnimation(&sorting_scales, &animation->scales_, inv_duration);
+    counter.decrement();
+  }, nullptr);
   CopyToAnimation(&sorting_rotations, &animation->rotations_, inv_duration);
-  CopyToAnimation(&sorting_scales, &animation->scales_, inv_duration);
+  counter.wait(false);
 
   // Copy animation's name.
   if (animation->name_) {
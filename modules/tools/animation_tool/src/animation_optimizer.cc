@@ -42,6 +42,7 @@
 #include "SkrAnim/ozz/base/containers/vector.h"
 #include "SkrAnim/ozz/base/maths/math_constant.h"
 #include "SkrAnim/ozz/base/maths/math_ex.h"
+#include "SkrTask/parallel_for.hpp"
 
 namespace ozz {
 namespace animation {
@@ -52,6 +53,9 @@ AnimationOptimizer::AnimationOptimizer() {}
 
 namespace {
 
+// Decimation cost grows with the key count, long clips keep batches small.
+constexpr size_t kJointsPerTask = 8;
+
 AnimationOptimizer::Setting GetJointSetting(
     const AnimationOptimizer& _optimizer, int _joint) {
   AnimationOptimizer::Setting setting = _optimizer.setting;
@@ -65,10 +69,10 @@ AnimationOptimizer::Setting GetJointSetting(
 
 struct HierarchyBuilder {
   HierarchyBuilder(const RawAnimation* _animation, const Skeleton* _skeleton,
-                   const AnimationOptimizer* _optimizer)
+                   const AnimationOptimizer::Setting* _joint_settings)
       : specs(_animation->tracks.size()),
         animation(_animation),
-        optimizer(_optimizer) {
+        joint_settings(_joint_settings) {
     SKR_ASSERT(_animation->num_tracks() == _skeleton->num_joints());
 
     // Computes hierarchical scale, iterating skeleton forward (root to
@@ -120,8 +124,7 @@ struct HierarchyBuilder {
 
     // Computes self setting distance and tolerance.
     // Distance is now scaled with accumulated parent scale.
-    const AnimationOptimizer::Setting setting =
-        GetJointSetting(*optimizer, _joint);
+    const AnimationOptimizer::Setting& setting = joint_settings[_joint];
     joint_spec.length = setting.distance * specs[_joint].scale;
     joint_spec.tolerance = setting.tolerance;
   }
@@ -160,8 +163,8 @@ struct HierarchyBuilder {
   // Targeted animation.
   const RawAnimation* animation;
 
-  // Usefull to access settings and compute hierarchy length.
-  const AnimationOptimizer* optimizer;
+  // Settings of each joint, resolved once per skeleton.
+  const AnimationOptimizer::Setting* joint_settings;
 };
 
 class PositionAdapter {
@@ -244,57 +247,104 @@ class ScaleAdapter {
 bool AnimationOptimizer::operator()(const RawAnimation& _input,
                                     const Skeleton& _skeleton,
                                     RawAnimation* _output) const {
-  if (!_output) {
-    return false;
-  }
-  // Reset output animation to default.
-  *_output = RawAnimation();
+  const RawAnimation* inputs[] = {&_input};
+  RawAnimation* outputs[] = {_output};
+  return (*this)(make_span(inputs), _skeleton, make_span(outputs));
+}
 
-  // Validate animation.
-  if (!_input.Validate()) {
+bool AnimationOptimizer::operator()(span<const RawAnimation*> _inputs,
+                                    const Skeleton& _skeleton,
+                                    span<RawAnimation*> _outputs) const {
+  if (_inputs.size() != _outputs.size()) {
     return false;
   }
+  for (RawAnimation* output : _outputs) {
+    if (!output) {
+      return false;
+    }
+    // Reset output animation to default.
+    *output = RawAnimation();
+  }
 
-  const int num_tracks = _input.num_tracks();
+  const int num_tracks = _skeleton.num_joints();
+  for (const RawAnimation* input : _inputs) {
+    // Validate animation.
+    if (!input->Validate()) {
+      return false;
+    }
+    // Validates the skeleton matches the animation.
+    if (input->num_tracks() != num_tracks) {
+      return false;
+    }
+  }
 
-  // Validates the skeleton matches the animation.
-  if (num_tracks != _skeleton.num_joints()) {
-    return false;
+  // Joint settings only depend on the skeleton, so they are shared by all
+  // clips.
+  ozz::vector<Setting> joint_settings(num_tracks);
+  for (int i = 0; i < num_tracks; ++i) {
+    joint_settings[i] = GetJointSetting(*this, i);
   }
 
   // First computes bone lengths, that will be used when filtering.
-  const HierarchyBuilder hierarchy(&_input, &_skeleton, this);
+  const size_t num_clips = _inputs.size();
+  ozz::vector<ozz::vector<HierarchyBuilder::Spec>> specs(num_clips);
+  skr::parallel_for(specs.begin(), specs.end(), 1, [&](auto begin, auto end) {
+    for (auto it = begin; it != end; ++it) {
+      const size_t clip = it - specs.begin();
+      HierarchyBuilder hierarchy(_inputs[clip], &_skeleton,
+                                 joint_settings.data());
+      *it = std::move(hierarchy.specs);
+    }
+  }, 2);
 
-  // Rebuilds output animation.
-  _output->name = _input.name;
-  _output->duration = _input.duration;
-  _output->tracks.resize(num_tracks);
+  // Rebuilds output animations.
+  for (size_t clip = 0; clip < num_clips; ++clip) {
+    _outputs[clip]->name = _inputs[clip]->name;
+    _outputs[clip]->duration = _inputs[clip]->duration;
+    _outputs[clip]->tracks.resize(num_tracks);
+  }
 
-  for (int i = 0; i < num_tracks; ++i) {
-    const RawAnimation::JointTrack& input = _input.tracks[i];
-    RawAnimation::JointTrack& output = _output->tracks[i];
-
-    // Gets joint specs back.
-    const float joint_length = hierarchy.specs[i].length;
-    const int parent = _skeleton.joint_parents()[i];
-    const float parent_scale =
-        (parent != Skeleton::kNoParent) ? hierarchy.specs[parent].scale : 1.f;
-    const float tolerance = hierarchy.specs[i].tolerance;
-
-    // Filters independently T, R and S tracks.
-    // This joint translation is affected by parent scale.
-    const PositionAdapter tadap(parent_scale);
-    Decimate(input.translations, tadap, tolerance, &output.translations);
-    // This joint rotation affects children translations/length.
-    const RotationAdapter radap(joint_length);
-    Decimate(input.rotations, radap, tolerance, &output.rotations);
-    // This joint scale affects children translations/length.
-    const ScaleAdapter sadap(joint_length);
-    Decimate(input.scales, sadap, tolerance, &output.scales);
+  // Tracks are decimated independently, so all joints of all clips are
+  // spread over the task system.
+  ozz::vector<int> jobs(num_clips * num_tracks);
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    jobs[i] = static_cast<int>(i);
   }
+  skr::parallel_for(jobs.begin(), jobs.end(), kJointsPerTask,
+                    [&](auto begin, auto end) {
+    for (auto it = begin; it != end; ++it) {
+      const int clip = *it / num_tracks;
+      const int i = *it % num_tracks;
+      const ozz::vector<HierarchyBuilder::Spec>& hierarchy = specs[clip];
+      const RawAnimation::JointTrack& input = _inputs[clip]->tracks[i];
+      RawAnimation::JointTrack& output = _outputs[clip]->tracks[i];
+
+      // Gets joint specs back.
+      const float joint_length = hierarchy[i].length;
+      const int parent = _skeleton.joint_parents()[i];
+      const float parent_scale =
+          (parent != Skeleton::kNoParent) ? hierarchy[parent].scale : 1.f;
+      const float tolerance = hierarchy[i].tolerance;
+
+      // Filters independently T, R and S tracks.
+      // This joint translation is affected by parent scale.
+      const PositionAdapter tadap(parent_scale);
+      Decimate(input.translations, tadap, tolerance, &output.translations);
+      // This joint rotation affects children translations/length.
+      const RotationAdapter radap(joint_length);
+      Decimate(input.rotations, radap, tolerance, &output.rotations);
+      // This joint scale affects children translations/length.
+      const ScaleAdapter sadap(joint_length);
+      Decimate(input.scales, sadap, tolerance, &output.scales);
+    }
+  }, 2);
 
-  // Output animation is always valid though.
-  return _output->Validate();
+  // Output animations are always valid though.
+  bool valid = true;
+  for (const RawAnimation* output : _outputs) {
+    valid &= output->Validate();
+  }
+  return valid;
 }
 }  // namespace offline
 }  // namespace animation
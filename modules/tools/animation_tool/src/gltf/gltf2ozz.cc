@@ -33,6 +33,7 @@
 #include <cstring>
 
 #include "gltf2ozz.h"
+#include "SkrToolCore/asset/cook_system.hpp"
 #include "SkrAnim/ozz/skeleton.h"
 #include "SkrAnim/ozz/base/containers/map.h"
 #include "SkrAnim/ozz/base/containers/set.h"
@@ -440,18 +441,17 @@ bool CreateNodeTransform(const tinygltf::Node& _node,
 
   return true;
 }
-}  // namespace
 
-GltfImporter::GltfImporter() {
+tinygltf::Model* LoadModel(const char* _filename, uint64_t& _resident_bytes) {
   // We don't care about image data but we have to provide this callback
   // because we're not loading the stb library
   auto image_loader = [](tinygltf::Image*, const int, std::string*,
                           std::string*, int, int, const unsigned char*, int,
                           void*) { return true; };
-  m_loader.SetImageLoader(image_loader, NULL);
-}
+  tinygltf::TinyGLTF loader;
+  loader.SetImageLoader(image_loader, NULL);
 
-bool GltfImporter::Load(const char* _filename) {
+  tinygltf::Model* model = SkrNew<tinygltf::Model>();
   bool success = false;
   std::string errors;
   std::string warnings;
@@ -464,7 +464,7 @@ bool GltfImporter::Load(const char* _filename) {
   // the file extension
   if (std::strcmp(ext, "glb") == 0) {
     success =
-        m_loader.LoadBinaryFromFile(&m_model, &errors, &warnings, _filename);
+        loader.LoadBinaryFromFile(model, &errors, &warnings, _filename);
   } else {
     if (std::strcmp(ext, "gltf") != 0) {
       ozz::log::Log() << "Unknown file extension '" << ext
@@ -472,7 +472,7 @@ bool GltfImporter::Load(const char* _filename) {
     }
 
     success =
-        m_loader.LoadASCIIFromFile(&m_model, &errors, &warnings, _filename);
+        loader.LoadASCIIFromFile(model, &errors, &warnings, _filename);
   }
 
   // Prints any errors or warnings emitted by the loader
@@ -488,13 +488,47 @@ bool GltfImporter::Load(const char* _filename) {
     ozz::log::Log() << "glTF parsed successfully." << std::endl;
   }
 
+  // Names are fixed up once, the model is read only afterwards as it is
+  // shared by every importer of the file
   if (success) {
-    success &= FixupNames(m_model.scenes, "Scene", "scene_");
-    success &= FixupNames(m_model.nodes, "Node", "node_");
-    success &= FixupNames(m_model.animations, "Animation", "animation_");
+    success &= FixupNames(model->scenes, "Scene", "scene_");
+    success &= FixupNames(model->nodes, "Node", "node_");
+    success &= FixupNames(model->animations, "Animation", "animation_");
+  }
+
+  if (!success) {
+    SkrDelete(model);
+    return nullptr;
+  }
+
+  _resident_bytes = 0;
+  for (const tinygltf::Buffer& buffer : model->buffers) {
+    _resident_bytes += buffer.data.size();
   }
+  return model;
+}
+}  // namespace
 
-  return success;
+GltfImporter::GltfImporter() {}
+
+GltfImporter::~GltfImporter() {
+  if (m_model) {
+    skd::asset::GetCookSystem()->GetImportCache()->Release(
+        const_cast<tinygltf::Model*>(m_model));
+  }
+}
+
+bool GltfImporter::Load(const char* _filename) {
+  SKR_ASSERT(m_model == nullptr);
+  // Skeletons & animation clips of a source share one parsed document
+  void* model = skd::asset::GetCookSystem()->GetImportCache()->Acquire(
+      u8"tinygltf", _filename,
+      [&](uint64_t& _resident_bytes) -> void* {
+        return LoadModel(_filename, _resident_bytes);
+      },
+      +[](void* _model) { SkrDelete(static_cast<tinygltf::Model*>(_model)); });
+  m_model = static_cast<const tinygltf::Model*>(model);
+  return m_model != nullptr;
 }
 
 // Find all unique root joints of skeletons used by given skins and add them
@@ -503,9 +537,9 @@ void GltfImporter::FindSkinRootJointIndices(const ozz::vector<tinygltf::Skin>& s
                               ozz::vector<int>& roots) {
   static constexpr int no_parent = -1;
   static constexpr int visited = -2;
-  ozz::vector<int> parents(m_model.nodes.size(), no_parent);
-  for (int node = 0; node < static_cast<int>(m_model.nodes.size()); node++) {
-    for (int child : m_model.nodes[node].children) {
+  ozz::vector<int> parents(m_model->nodes.size(), no_parent);
+  for (int node = 0; node < static_cast<int>(m_model->nodes.size()); node++) {
+    for (int child : m_model->nodes[node].children) {
       parents[child] = node;
     }
   }
@@ -535,7 +569,7 @@ bool GltfImporter::Import(ozz::animation::offline::RawSkeleton* _skeleton,
             const NodeType& _types) {
   (void)_types;
 
-  if (m_model.scenes.empty()) {
+  if (m_model->scenes.empty()) {
     ozz::log::Err() << "No scenes found." << std::endl;
     return false;
   }
@@ -543,12 +577,12 @@ bool GltfImporter::Import(ozz::animation::offline::RawSkeleton* _skeleton,
   // If no default scene has been set then take the first one spec does not
   // disallow gltfs without a default scene but it makes more sense to keep
   // going instead of throwing an error here
-  int defaultScene = m_model.defaultScene;
+  int defaultScene = m_model->defaultScene;
   if (defaultScene == -1) {
     defaultScene = 0;
   }
 
-  tinygltf::Scene& scene = m_model.scenes[defaultScene];
+  const tinygltf::Scene& scene = m_model->scenes[defaultScene];
   ozz::log::LogV() << "Importing from default scene #" << defaultScene
                     << " with name \"" << scene.name << "\"." << std::endl;
 
@@ -586,7 +620,7 @@ bool GltfImporter::Import(ozz::animation::offline::RawSkeleton* _skeleton,
   // Traverses the scene graph and record all joints starting from the roots.
   _skeleton->roots.resize(roots.size());
   for (size_t i = 0; i < roots.size(); ++i) {
-    const tinygltf::Node& root_node = m_model.nodes[roots[i]];
+    const tinygltf::Node& root_node = m_model->nodes[roots[i]];
     ozz::animation::offline::RawSkeleton::Joint& root_joint =
         _skeleton->roots[i];
     if (!ImportNode(root_node, &root_joint)) {
@@ -620,7 +654,7 @@ bool GltfImporter::ImportNode(const tinygltf::Node& _node,
 
   // Fills each child information.
   for (size_t i = 0; i < _node.children.size(); ++i) {
-    const tinygltf::Node& child_node = m_model.nodes[_node.children[i]];
+    const tinygltf::Node& child_node = m_model->nodes[_node.children[i]];
     ozz::animation::offline::RawSkeleton::Joint& child_joint =
         _joint->children[i];
 
@@ -635,8 +669,8 @@ bool GltfImporter::ImportNode(const tinygltf::Node& _node,
 // Returns all animations in the gltf document.
 GltfImporter::AnimationNames GltfImporter::GetAnimationNames() {
   AnimationNames animNames;
-  for (size_t i = 0; i < m_model.animations.size(); ++i) {
-    tinygltf::Animation& animation = m_model.animations[i];
+  for (size_t i = 0; i < m_model->animations.size(); ++i) {
+    const tinygltf::Animation& animation = m_model->animations[i];
     SKR_ASSERT(animation.name.length() != 0);
     animNames.push_back(animation.name.c_str());
   }
@@ -663,11 +697,11 @@ bool GltfImporter::Import(const char* _animation_name,
 
   // Find the corresponding gltf animation
   std::vector<tinygltf::Animation>::const_iterator gltf_animation =
-      std::find_if(begin(m_model.animations), end(m_model.animations),
+      std::find_if(begin(m_model->animations), end(m_model->animations),
                     [_animation_name](const tinygltf::Animation& _animation) {
                       return _animation.name == _animation_name;
                     });
-  SKR_ASSERT(gltf_animation != end(m_model.animations));
+  SKR_ASSERT(gltf_animation != end(m_model->animations));
 
   _animation->name = gltf_animation->name.c_str();
 
@@ -700,7 +734,7 @@ bool GltfImporter::Import(const char* _animation_name,
       continue;
     }
 
-    const tinygltf::Node& target_node = m_model.nodes[channel.target_node];
+    const tinygltf::Node& target_node = m_model->nodes[channel.target_node];
     channels_per_joint[target_node.name.c_str()].push_back(&channel);
   }
 
@@ -713,7 +747,7 @@ bool GltfImporter::Import(const char* _animation_name,
 
     for (auto& channel : channels) {
       auto& sampler = gltf_animation->samplers[channel->sampler];
-      if (!SampleAnimationChannel(m_model, sampler, channel->target_path,
+      if (!SampleAnimationChannel(*m_model, sampler, channel->target_path,
                                   _sampling_rate, &_animation->duration,
                                   &track)) {
         return false;
@@ -760,7 +794,7 @@ bool GltfImporter::SampleAnimationChannel(
     return false;
   }
 
-  auto& input = m_model.accessors[_sampler.input];
+  auto& input = m_model->accessors[_sampler.input];
   SKR_ASSERT(input.maxValues.size() == 1);
 
   // The max[0] property of the input accessor is the animation duration
@@ -776,7 +810,7 @@ bool GltfImporter::SampleAnimationChannel(
   }
 
   SKR_ASSERT(input.type == TINYGLTF_TYPE_SCALAR);
-  auto& _output = m_model.accessors[_sampler.output];
+  auto& _output = m_model->accessors[_sampler.output];
   SKR_ASSERT(_output.type == TINYGLTF_TYPE_VEC3 ||
           _output.type == TINYGLTF_TYPE_VEC4);
 
@@ -789,11 +823,11 @@ bool GltfImporter::SampleAnimationChannel(
   bool valid = false;
   if (_target_path == "translation") {
     valid =
-        SampleChannel(m_model, _sampler.interpolation, _output, timestamps,
+        SampleChannel(*m_model, _sampler.interpolation, _output, timestamps,
                       _sampling_rate, duration, &_track->translations);
   } else if (_target_path == "rotation") {
     valid =
-        SampleChannel(m_model, _sampler.interpolation, _output, timestamps,
+        SampleChannel(*m_model, _sampler.interpolation, _output, timestamps,
                       _sampling_rate, duration, &_track->rotations);
     if (valid) {
       // Normalize quaternions.
@@ -803,7 +837,7 @@ bool GltfImporter::SampleAnimationChannel(
     }
   } else if (_target_path == "scale") {
     valid =
-        SampleChannel(m_model, _sampler.interpolation, _output, timestamps,
+        SampleChannel(*m_model, _sampler.interpolation, _output, timestamps,
                       _sampling_rate, duration, &_track->scales);
   } else {
     SKR_ASSERT(false && "Invalid target path");
@@ -827,14 +861,14 @@ ozz::vector<tinygltf::Skin> GltfImporter::GetSkinsForScene(
     found.insert(nodeIndex);
     open.erase(nodeIndex);
 
-    auto& node = m_model.nodes[nodeIndex];
+    auto& node = m_model->nodes[nodeIndex];
     for (int childIndex : node.children) {
       open.insert(childIndex);
     }
   }
 
   ozz::vector<tinygltf::Skin> skins;
-  for (const tinygltf::Skin& skin : m_model.skins) {
+  for (const tinygltf::Skin& skin : m_model->skins) {
     if (!skin.joints.empty() && found.find(skin.joints[0]) != found.end()) {
       skins.push_back(skin);
     }
@@ -844,7 +878,7 @@ ozz::vector<tinygltf::Skin> GltfImporter::GetSkinsForScene(
 }
 
 const tinygltf::Node* GltfImporter::FindNodeByName(const std::string& _name) const {
-  for (const tinygltf::Node& node : m_model.nodes) {
+  for (const tinygltf::Node& node : m_model->nodes) {
     if (node.name == _name) {
       return &node;
     }
@@ -7,6 +7,7 @@
 class GltfImporter : public ozz::animation::offline::OzzImporter {
  public:
   GltfImporter();
+  ~GltfImporter() override;
 
  private:
   bool Load(const char* _filename) override;
@@ -62,6 +63,6 @@ class GltfImporter : public ozz::animation::offline::OzzImporter {
     return false;
   }
 
-  tinygltf::TinyGLTF m_loader;
-  tinygltf::Model m_model;
+  // shared through the cook system's import cache, released on destruction
+  const tinygltf::Model* m_model = nullptr;
 };
\ No newline at end of file
@@ -11,10 +11,14 @@ namespace skd
 {
 namespace asset 
 {
-// returned cgltf_data* needs to be freed by cgltf_free
+// returned cgltf_data* is shared by every importer of the file through the cook system's import cache,
+// it must be read only & released with ReleaseGLTFData
 GLTFTOOL_API
 cgltf_data* ImportGLTFWithData(skr::StringView assetPath, skr_io_ram_service_t* ioService, struct skr_vfs_t* vfs) SKR_NOEXCEPT;
 
+GLTFTOOL_API
+void ReleaseGLTFData(cgltf_data* data) SKR_NOEXCEPT;
+
 GLTFTOOL_API
 void GetGLTFNodeTransform(const cgltf_node* node, skr_float3_t& translation, skr_float3_t& scale, skr_float4_t& rotation);
 
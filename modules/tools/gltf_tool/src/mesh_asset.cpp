@@ -1,6 +1,7 @@
 #include "cgltf/cgltf.h"
 #include "SkrBase/misc/defer.hpp"
 #include "SkrCore/log.hpp"
+#include "SkrCore/time.h"
 #include "SkrTask/parallel_for.hpp"
 #include "SkrContainers/stl_vector.hpp"
 #include "SkrToolCore/asset/cook_system.hpp"
@@ -8,7 +9,6 @@
 #include "SkrToolCore/asset/json_utils.hpp"
 #include "SkrGLTFTool/mesh_asset.hpp"
 #include "SkrGLTFTool/mesh_processing.hpp"
-#include "MeshOpt/meshoptimizer.h"
 
 #include "SkrProfile/profile.h"
 
@@ -28,7 +28,7 @@ void* skd::asset::SGltfMeshImporter::Import(skr_io_ram_service_t* ioService, SCo
 
 void skd::asset::SGltfMeshImporter::Destroy(void* resource)
 {
-    ::cgltf_free((cgltf_data*)resource);
+    ReleaseGLTFData((cgltf_data*)resource);
 }
 
 bool skd::asset::SMeshCooker::Cook(SCookContext* ctx)
@@ -68,81 +68,121 @@ bool skd::asset::SMeshCooker::Cook(SCookContext* ctx)
     }
 
     //----- optimize mesh
+    const auto cookStartTime = skr_sys_get_usec(true);
+    skr::Vector<SMeshOptimizeStatistics> primitiveStats(mesh.primitives.size());
+    skr::Vector<skr::Vector<uint8_t>> meshletStreams(mesh.primitives.size());
+    skr::Vector<skr::Vector<SMeshPrimitiveLOD>> primitiveLODs(mesh.primitives.size());
     {
     SkrZoneScopedN("WaitOptimizeMesh");
 
-    // allow up to 1% worse ACMR to get more reordering opportunities for overdraw
-	const float kOverDrawThreshold = 1.01f; 
-    // for (auto& prim : mesh.primitives)
+    // primitives own disjoint ranges of the bins, so they are optimized concurrently
     skr::parallel_for(mesh.primitives.begin(), mesh.primitives.end(), 1, 
     [&](auto begin, auto end)
     {
-        SkrZoneScopedN("OptimizeMesh");
-
-        const auto& prim = *begin;
-        auto& indices_blob = blobs[prim.index_buffer.buffer_index];
-        const auto first_index = prim.index_buffer.first_index;
-        const auto index_stride = prim.index_buffer.stride;
-        const auto index_offset = prim.index_buffer.index_offset;
-        const auto index_count = prim.index_buffer.index_count;
-        const auto vertex_count = prim.vertex_count;
-        skr::stl_vector<uint64_t> optimized_indices;
-        optimized_indices.resize(index_count);
-        uint64_t* indices_ptr = optimized_indices.data();
-        for (size_t i = 0; i < index_count; i++)
-        {
-            if (index_stride == sizeof(uint8_t))
-                optimized_indices[i] = *(uint8_t*)(indices_blob.data() + index_offset + (first_index + i) * index_stride);
-            else if (index_stride == sizeof(uint16_t))
-                optimized_indices[i] = *(uint16_t*)(indices_blob.data() + index_offset + (first_index + i) * index_stride);
-            else if (index_stride == sizeof(uint32_t))
-                optimized_indices[i] = *(uint32_t*)(indices_blob.data() + index_offset + (first_index + i) * index_stride);
-            else if (index_stride == sizeof(uint64_t))
-                optimized_indices[i] = *(uint64_t*)(indices_blob.data() + index_offset + (first_index + i) * index_stride);
-        }
-        for (size_t i = 0; i < index_count; i++)
+        for (auto it = begin; it != end; ++it)
         {
-            SKR_ASSERT(optimized_indices[i] < vertex_count && "Invalid index");
+            const auto i = (uint32_t)(it - mesh.primitives.begin());
+            auto& prim = *it;
+            OptimizeMeshPrimitive(prim, blobs, primitiveStats[i]);
+            BuildPrimitiveLODs(prim, blobs, cfg, primitiveLODs[i], primitiveStats[i]);
+            if (cfg.meshlets)
+            {
+                BuildMeshletStream(prim, blobs, cfg, prim.meshlets, meshletStreams[i], primitiveStats[i]);
+            }
         }
+    });
+    }
 
-        // vertex cache optimization should go first as it provides starting order for overdraw
-        meshopt_optimizeVertexCache(indices_ptr, indices_ptr, index_count, vertex_count);
+    //----- append LODs behind the indices of LOD 0, they share its index & vertex buffers
+    for (uint32_t i = 0; i < mesh.primitives.size(); i++)
+    {
+        EmplacePrimitiveLODs(mesh.primitives[i], blobs, primitiveLODs[i]);
+    }
+    for (auto& bin : mesh.bins)
+    {
+        bin.byte_length = blobs[bin.index].size();
+    }
 
-        // reorder indices for overdraw, balancing overdraw and vertex cache efficiency
-        for (const auto& vb : prim.vertex_buffers)
+    //----- pack meshlets of all primitives into an extra bin
+    SMeshOptimizeStatistics stats;
+    for (const auto& primStats : primitiveStats)
+    {
+        stats.Merge(primStats);
+    }
+    if (stats.meshlets)
+    {
+        const auto meshletBinIndex = (uint32_t)blobs.size();
+        skr::Vector<uint8_t> meshletBin;
+        meshletBin.reserve(stats.meshletBytes + mesh.primitives.size() * 16);
+        for (uint32_t i = 0; i < mesh.primitives.size(); i++)
         {
-            if (vb.attribute == ESkrVertexAttribute::SKR_VERT_ATTRIB_POSITION)
-            {
-                auto& vertices_blob = blobs[vb.buffer_index];
-                const auto vertex_stride = vb.stride;(void)vertex_stride;
-                skr::stl_vector<skr_float3_t> vertices;
-                vertices.resize(vertex_count);
-                for (size_t i = 0; i < vertex_count; i++)
-                {
-                    vertices[i] = *(skr_float3_t*)(vertices_blob.data() + vb.offset);
-                }
-                meshopt_optimizeOverdraw(indices_ptr, indices_ptr, index_count, 
-                    (float*)vertices.data(), vertices.size(), 
-                    sizeof(skr_float3_t), kOverDrawThreshold);
-
-                // vertex fetch optimization should go last as it depends on the final index order
-                // TODO: meshopt_optimizeVertexFetch
-            }
+            auto& entry = mesh.primitives[i].meshlets;
+            if (!entry.meshlet_count)
+                continue;
+            // keep every stream 16 bytes aligned for raw buffer loads
+            meshletBin.resize_zeroed((meshletBin.size() + 15) & ~(uint64_t)15);
+            entry.buffer_index = meshletBinIndex;
+            entry.offset = (uint32_t)meshletBin.size();
+            meshletBin.append(meshletStreams[i].data(), meshletStreams[i].size());
         }
+        auto& meshletBuffer = mesh.bins.add_default().ref();
+        meshletBuffer.index = meshletBinIndex;
+        meshletBuffer.byte_length = meshletBin.size();
+        meshletBuffer.used_with_index = false;
+        meshletBuffer.used_with_vertex = false;
+        meshletBuffer.used_with_meshlet = true;
+        blobs.add(std::move(meshletBin));
+    }
+    SKR_LOG_INFO(u8"MeshCooker: %s cooked in %.2fms, %u primitives, %llu vertices, %llu triangles, optimize %.2fms",
+        ctx->GetAssetPath().c_str(), (skr_sys_get_usec(true) - cookStartTime) / 1000.0, stats.primitives,
+        (unsigned long long)stats.vertices, (unsigned long long)stats.triangles, stats.optimizeTime / 1000.0);
+    for (uint32_t i = 0; i < stats.lods.size(); i++)
+    {
+        const auto& lod = stats.lods[i];
+        if (!lod.primitives) continue;
+        SKR_LOG_INFO(u8"MeshCooker: %s LOD%u %u primitives (%u sloppy), %llu triangles (%.1f%% of LOD0), max error %f, %.2fms",
+            ctx->GetAssetPath().c_str(), i + 1, lod.primitives, lod.sloppy, (unsigned long long)lod.triangles,
+            stats.triangles ? 100.0 * lod.triangles / stats.triangles : 0.0, lod.maxError, lod.time / 1000.0);
+    }
+    if (stats.meshlets)
+    {
+        SKR_LOG_INFO(u8"MeshCooker: %s %llu meshlets (%.1f verts, %.1f tris avg), %llu bytes, build %.2fms",
+            ctx->GetAssetPath().c_str(), (unsigned long long)stats.meshlets,
+            (double)stats.meshletVertices / stats.meshlets, (double)stats.meshletTriangles / stats.meshlets,
+            (unsigned long long)stats.meshletBytes, stats.meshletTime / 1000.0);
+    }
 
-        // write optimized indices
-        for (size_t i = 0; i < index_count; i++)
+    //----- quantize & compress vertex/index bins
+    SMeshCompressStatistics compressStats;
+    skr::Vector<skr::Vector<uint8_t>> encodedBins(blobs.size());
+    if (importer->invariant_vertices)
+    {
+        // skinned vertices stay in floats for CPU skinning
+        QuantizeMeshVertices(mesh, blobs, compressStats);
+    }
+    if (cfg.compressBuffers)
+    {
+        for (auto& bin : mesh.bins)
         {
-            if (index_stride == sizeof(uint8_t))
-                *(uint8_t*)(indices_blob.data() + index_offset + first_index + i * index_stride) = optimized_indices[i];
-            else if (index_stride == sizeof(uint16_t))
-                *(uint16_t*)(indices_blob.data() + index_offset + first_index + i * index_stride) = optimized_indices[i];
-            else if (index_stride == sizeof(uint32_t))
-                *(uint32_t*)(indices_blob.data() + index_offset + first_index + i * index_stride) = optimized_indices[i];
-            else if (index_stride == sizeof(uint64_t))
-                *(uint64_t*)(indices_blob.data() + index_offset + first_index + i * index_stride) = optimized_indices[i];
+            if (bin.used_with_meshlet) continue;
+            EncodeMeshBin(mesh, bin.index, blobs[bin.index], encodedBins[bin.index], compressStats);
+            // keep bins the codec can not shrink as is
+            if (encodedBins[bin.index].size() < blobs[bin.index].size())
+                bin.compressed_length = encodedBins[bin.index].size();
+            else
+                encodedBins[bin.index].clear();
         }
-    });
+    }
+    if (compressStats.rawBytes)
+    {
+        uint64_t storedBytes = 0;
+        for (uint32_t i = 0; i < blobs.size(); i++)
+        {
+            storedBytes += encodedBins[i].empty() ? blobs[i].size() : encodedBins[i].size();
+        }
+        SKR_LOG_INFO(u8"MeshCooker: %s bins %llu -> %llu bytes quantized (%.2fms), %llu bytes on disk (%.2fms encode)",
+            ctx->GetAssetPath().c_str(), (unsigned long long)compressStats.rawBytes, (unsigned long long)compressStats.quantizedBytes,
+            compressStats.quantizeTime / 1000.0, (unsigned long long)storedBytes, compressStats.encodeTime / 1000.0);
     }
 
     //----- write materials
@@ -169,7 +209,9 @@ bool skd::asset::SMeshCooker::Cook(SCookContext* ctx)
                 assetRecord->guid, assetRecord->path.string());
             return false;
         }
-        fwrite(blobs[i].data(), 1, blobs[i].size(), buffer_file);
+        const auto& content = encodedBins[i].empty() ? blobs[i] : encodedBins[i];
+        fwrite(content.data(), 1, content.size(), buffer_file);
+        ctx->AddOutputFile(binOutputPath);
     }
     return true;
 }
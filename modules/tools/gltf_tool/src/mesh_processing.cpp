@@ -3,9 +3,12 @@
 #include "SkrRT/platform/vfs.h"
 #include "SkrOS/filesystem.hpp"
 #include "SkrTask/fib_task.hpp"
+#include "SkrTask/parallel_for.hpp"
+#include "SkrToolCore/asset/cook_system.hpp"
 #include "SkrRenderer/resources/mesh_resource.h"
 #include "SkrMeshCore/mesh_processing.hpp"
 #include "SkrGLTFTool/mesh_processing.hpp"
+#include "MeshOpt/meshoptimizer.h"
 
 #include "SkrProfile/profile.h"
 
@@ -66,12 +69,124 @@ inline static SRawMesh GenerateRawMeshForGLTFMesh(cgltf_mesh* mesh)
     return raw_mesh;
 }
 
-cgltf_data* ImportGLTFWithData(skr::StringView assetPath, skr_io_ram_service_t* ioService, struct skr_vfs_t* vfs) SKR_NOEXCEPT
+// external .bin files of large scenes are read concurrently, cgltf_load_buffers only handles the remaining ones
+static bool LoadGLTFBufferFiles(cgltf_data* data, const skr::filesystem::path& gltfPath)
+{
+    skr::Vector<cgltf_buffer*> files;
+    for (cgltf_size i = 0; i < data->buffers_count; ++i)
+    {
+        const auto& buffer = data->buffers[i];
+        if (!buffer.data && buffer.uri && strncmp(buffer.uri, "data:", 5) != 0 && !strstr(buffer.uri, "://"))
+            files.add(data->buffers + i);
+    }
+    std::atomic_bool succeed = true;
+    skr::parallel_for(files.begin(), files.end(), 1,
+    [&](auto begin, auto end)
+    {
+        for (auto it = begin; it != end; ++it)
+        {
+            SkrZoneScopedN("LoadGLTFBufferFile");
+            cgltf_buffer* buffer = *it;
+            skr::Vector<char> uri;
+            uri.append(buffer->uri, strlen(buffer->uri) + 1);
+            cgltf_decode_uri(uri.data());
+            const auto path = gltfPath.parent_path() / uri.data();
+            auto file = fopen(path.string().c_str(), "rb");
+            void* content = file ? malloc(buffer->size) : nullptr;
+            if (!content || fread(content, 1, buffer->size, file) != buffer->size)
+            {
+                SKR_LOG_ERROR(u8"failed to load gltf buffer %s!", path.u8string().c_str());
+                free(content);
+                succeed = false;
+            }
+            else
+            {
+                // released by cgltf_free with the default allocator
+                buffer->data = content;
+                buffer->data_free_method = cgltf_data_free_method_memory_free;
+            }
+            if (file) fclose(file);
+        }
+    }, 2);
+    return succeed;
+}
+
+// EXT_meshopt_compression views are decoded up front & in parallel, cookers read them through buffer_view->data
+static bool DecodeGLTFCompressedViews(cgltf_data* data, uint64_t& decodedBytes)
+{
+    skr::Vector<cgltf_buffer_view*> views;
+    for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
+    {
+        const auto& view = data->buffer_views[i];
+        if (view.has_meshopt_compression && !view.data)
+        {
+            views.add(data->buffer_views + i);
+            decodedBytes += view.meshopt_compression.count * view.meshopt_compression.stride;
+        }
+    }
+    std::atomic_bool succeed = true;
+    skr::parallel_for(views.begin(), views.end(), 1,
+    [&](auto begin, auto end)
+    {
+        for (auto it = begin; it != end; ++it)
+        {
+            SkrZoneScopedN("DecodeGLTFBufferView");
+            cgltf_buffer_view* view = *it;
+            const auto& mc = view->meshopt_compression;
+            if (!mc.buffer->data)
+            {
+                succeed = false;
+                continue;
+            }
+            const auto source = static_cast<const uint8_t*>(mc.buffer->data) + mc.offset;
+            void* result = malloc(mc.count * mc.stride);
+            int rc = -1;
+            switch (mc.mode)
+            {
+            case cgltf_meshopt_compression_mode_attributes:
+                rc = meshopt_decodeVertexBuffer(result, mc.count, mc.stride, source, mc.size);
+                break;
+            case cgltf_meshopt_compression_mode_triangles:
+                rc = meshopt_decodeIndexBuffer(result, mc.count, mc.stride, source, mc.size);
+                break;
+            case cgltf_meshopt_compression_mode_indices:
+                rc = meshopt_decodeIndexSequence(result, mc.count, mc.stride, source, mc.size);
+                break;
+            default:
+                break;
+            }
+            switch (mc.filter)
+            {
+            case cgltf_meshopt_compression_filter_octahedral:
+                meshopt_decodeFilterOct(result, mc.count, mc.stride);
+                break;
+            case cgltf_meshopt_compression_filter_quaternion:
+                meshopt_decodeFilterQuat(result, mc.count, mc.stride);
+                break;
+            case cgltf_meshopt_compression_filter_exponential:
+                meshopt_decodeFilterExp(result, mc.count, mc.stride);
+                break;
+            default:
+                break;
+            }
+            if (rc != 0)
+            {
+                free(result);
+                succeed = false;
+                continue;
+            }
+            // released by cgltf_free with the default allocator
+            view->data = result;
+        }
+    }, 2);
+    return succeed;
+}
+
+static cgltf_data* LoadGLTFWithData(const skr::String& u8Path, skr_io_ram_service_t* ioService, struct skr_vfs_t* vfs, uint64_t& residentBytes)
 {
     // prepare callback
     skr::task::event_t counter;
     skr::BlobId blob = nullptr;
-    skr::String u8Path = assetPath;
     struct CallbackData
     {
         skr::task::event_t* pCounter;   
@@ -105,12 +220,23 @@ cgltf_data* ImportGLTFWithData(skr::StringView assetPath, skr_io_ram_service_t*
             {
                 SkrZoneScopedN("LoadGLTFBuffer");
                 auto fullPath = skr::filesystem::path(vfs->mount_dir) / u8Path.u8_str();
+                uint64_t decodedBytes = 0;
+                bool loaded = LoadGLTFBufferFiles(gltf_data_, fullPath);
                 result = cgltf_load_buffers(&options, gltf_data_, fullPath.string().c_str());
+                loaded = loaded && (result == cgltf_result_success);
+                loaded = loaded && DecodeGLTFCompressedViews(gltf_data_, decodedBytes);
                 result = cgltf_validate(gltf_data_);
-                if (result != cgltf_result_success)
+                if (!loaded || result != cgltf_result_success)
                 {
+                    cgltf_free(gltf_data_);
                     gltf_data_ = nullptr;
                 }
+                else
+                {
+                    residentBytes = blob->get_size() + decodedBytes;
+                    for (cgltf_size i = 0; i < gltf_data_->buffers_count; ++i)
+                        residentBytes += gltf_data_->buffers[i].size;
+                }
             }
         }
         blob.reset();
@@ -118,6 +244,22 @@ cgltf_data* ImportGLTFWithData(skr::StringView assetPath, skr_io_ram_service_t*
     return gltf_data_;
 }
 
+cgltf_data* ImportGLTFWithData(skr::StringView assetPath, skr_io_ram_service_t* ioService, struct skr_vfs_t* vfs) SKR_NOEXCEPT
+{
+    skr::String u8Path = assetPath;
+    const auto fullPath = skr::filesystem::path(vfs->mount_dir) / u8Path.u8_str();
+    auto cache = GetCookSystem()->GetImportCache();
+    auto data = cache->Acquire(u8"cgltf", fullPath, 
+        [&](uint64_t& residentBytes) -> void* { return LoadGLTFWithData(u8Path, ioService, vfs, residentBytes); },
+        +[](void* document) { cgltf_free((cgltf_data*)document); });
+    return static_cast<cgltf_data*>(data);
+}
+
+void ReleaseGLTFData(cgltf_data* data) SKR_NOEXCEPT
+{
+    GetCookSystem()->GetImportCache()->Release(data);
+}
+
 void GetGLTFNodeTransform(const cgltf_node* node, skr_float3_t& translation, skr_float3_t& scale, skr_float4_t& rotation)
 {
     if (node->has_translation)
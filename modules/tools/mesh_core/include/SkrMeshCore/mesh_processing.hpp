@@ -18,6 +18,25 @@ sreflect_struct("guid" : "9A2C9CBF-517D-4197-BDE3-E40D85D88320")
 sattr("serde" : "json")
 MESH_CORE_API SMeshCookConfig {
     skr_guid_t vertexType;
+
+    // clusters for GPU driven rendering & CPU cluster culling, cooked into an extra bin
+    bool     meshlets            = false;
+    uint32_t meshletMaxVertices  = 64;  // <= 255
+    uint32_t meshletMaxTriangles = 124; // <= 512, multiple of 4
+    // 0: spatially compact meshlets, 1: tight normal cones
+    float meshletConeWeight = 0.25f;
+
+    // levels of detail after LOD 0, as index count ratios to LOD 0, e.g. [0.5, 0.25, 0.125]
+    skr::Vector<float> lodRatios;
+    // max simplification error of every LOD relative to the mesh extents, the last entry holds for the LODs past the end
+    skr::Vector<float> lodErrors;
+    // collapse regardless of topology when the simplifier stalls above the target ratio
+    bool lodSloppyFallback = true;
+    // keep open borders in place, e.g. for meshes stitched to others
+    bool lodLockBorder = false;
+
+    // meshopt encode vertex & index bins, they are decoded when the mesh is loaded
+    bool compressBuffers = false;
 };
 
 sreflect_enum_class("guid" : "d6baca1e-eded-4517-a6ad-7abaac3de27b")
@@ -109,6 +128,107 @@ MESH_CORE_API
 void EmplaceStaticRawMeshVertices(const SRawMesh* mesh, const CGPUVertexLayout* layout, skr::Vector<uint8_t>& buffer,
                                   uint32_t buffer_idx, skr::Vector<skr_mesh_primitive_t>& out_primitives);
 
+struct SMeshLODStatistics {
+    uint32_t primitives = 0;
+    uint32_t sloppy     = 0; // primitives that fell back to sloppy simplification
+    uint64_t triangles  = 0;
+    float    maxError   = 0.f; // mesh space units
+    uint64_t time       = 0;   // microseconds
+};
+
+struct SMeshOptimizeStatistics {
+    uint32_t primitives       = 0;
+    uint64_t vertices         = 0;
+    uint64_t triangles        = 0;
+    uint64_t meshlets         = 0;
+    uint64_t meshletVertices  = 0;
+    uint64_t meshletTriangles = 0;
+    uint64_t meshletBytes     = 0;
+    uint64_t optimizeTime     = 0; // microseconds
+    uint64_t meshletTime      = 0; // microseconds
+    skr::Vector<SMeshLODStatistics> lods;
+
+    inline void Merge(const SMeshOptimizeStatistics& other)
+    {
+        primitives += other.primitives;
+        vertices += other.vertices;
+        triangles += other.triangles;
+        meshlets += other.meshlets;
+        meshletVertices += other.meshletVertices;
+        meshletTriangles += other.meshletTriangles;
+        meshletBytes += other.meshletBytes;
+        optimizeTime += other.optimizeTime;
+        meshletTime += other.meshletTime;
+        if (lods.size() < other.lods.size())
+            lods.resize_default(other.lods.size());
+        for (uint32_t i = 0; i < other.lods.size(); i++)
+        {
+            lods[i].primitives += other.lods[i].primitives;
+            lods[i].sloppy += other.lods[i].sloppy;
+            lods[i].triangles += other.lods[i].triangles;
+            lods[i].maxError = std::max(lods[i].maxError, other.lods[i].maxError);
+            lods[i].time += other.lods[i].time;
+        }
+    }
+};
+
+// 32 bit indices of a cooked primitive, whatever its index stride
+MESH_CORE_API
+void ReadPrimitiveIndices(const skr_mesh_primitive_t& primitive, const skr::Vector<skr::Vector<uint8_t>>& bins, skr::Vector<uint32_t>& out_indices);
+
+MESH_CORE_API
+void WritePrimitiveIndices(const skr_mesh_primitive_t& primitive, skr::Vector<skr::Vector<uint8_t>>& bins, skr::span<const uint32_t> indices);
+
+// the float3 position stream of a cooked primitive, returns nullptr when it has none
+MESH_CORE_API
+const skr_vertex_buffer_entry_t* FindPrimitivePositions(const skr_mesh_primitive_t& primitive);
+
+// vertex cache, overdraw & vertex fetch optimization of a cooked primitive in place, vertices of every stream are reordered.
+// primitives of a mesh own disjoint ranges of the bins and may be optimized concurrently
+MESH_CORE_API
+void OptimizeMeshPrimitive(skr_mesh_primitive_t& primitive, skr::Vector<skr::Vector<uint8_t>>& bins, SMeshOptimizeStatistics& stats);
+
+// meshlets of an optimized primitive in the layout of skr_meshlet_buffer_entry_t, offset & buffer_index are left to the caller
+MESH_CORE_API
+void BuildMeshletStream(const skr_mesh_primitive_t& primitive, const skr::Vector<skr::Vector<uint8_t>>& bins, const SMeshCookConfig& cfg,
+                        skr_meshlet_buffer_entry_t& out_entry, skr::Vector<uint8_t>& out_stream, SMeshOptimizeStatistics& stats);
+
+struct SMeshPrimitiveLOD {
+    skr::Vector<uint32_t> indices;
+    float                 error = 0.f; // mesh space units
+};
+
+// simplified index lists of an optimized primitive for cfg.lodRatios, every LOD simplifies the previous one.
+// LODs reference the vertices of the primitive, the chain stops at the first LOD failing to reduce its predecessor
+MESH_CORE_API
+void BuildPrimitiveLODs(const skr_mesh_primitive_t& primitive, const skr::Vector<skr::Vector<uint8_t>>& bins, const SMeshCookConfig& cfg,
+                        skr::Vector<SMeshPrimitiveLOD>& out_lods, SMeshOptimizeStatistics& stats);
+
+// appends LODs to the index bin of the primitive with its index stride & records their ranges
+MESH_CORE_API
+void EmplacePrimitiveLODs(skr_mesh_primitive_t& primitive, skr::Vector<skr::Vector<uint8_t>>& bins, skr::span<const SMeshPrimitiveLOD> lods);
+
+struct SMeshCompressStatistics {
+    uint64_t rawBytes       = 0;
+    uint64_t quantizedBytes = 0;
+    uint64_t encodedBytes   = 0;
+    uint64_t quantizeTime   = 0; // microseconds
+    uint64_t encodeTime     = 0; // microseconds
+};
+
+// repacks the vertex & index bins of a cooked mesh: index ranges of every primitive with their LODs, then vertex streams attribute by attribute.
+// streams are quantized on the way when the vertex layout of their primitive asks for a packed format:
+//   POSITION R16G16B16A16_SNORM: relative to the mesh bounds, see MeshResource::position_offset & position_scale
+//   NORMAL   R16G16_SNORM:       octahedral
+//   TANGENT  R16G16_SNORM:       octahedral, the lowest bit of the snorm y is set for negative handedness
+//   TEXCOORD R16G16_SFLOAT:      half floats
+MESH_CORE_API
+void QuantizeMeshVertices(skr_mesh_resource_t& mesh, skr::Vector<skr::Vector<uint8_t>>& bins, SMeshCompressStatistics& stats);
+
+// meshopt encodes a vertex & index bin of a cooked mesh into the MeshBinHeader layout
+MESH_CORE_API
+void EncodeMeshBin(const skr_mesh_resource_t& mesh, uint32_t bin_index, skr::span<const uint8_t> bin, skr::Vector<uint8_t>& out_encoded, SMeshCompressStatistics& stats);
+
 // LUT for raw attributes to semantic names
 static const char* kRawAttributeTypeNameLUT[9] = {
     "NONE",
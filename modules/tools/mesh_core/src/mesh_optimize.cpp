@@ -0,0 +1,301 @@
+#include "SkrCore/time.h"
+#include "SkrMeshCore/mesh_processing.hpp"
+#include "SkrRenderer/resources/mesh_resource.h"
+#include "MeshOpt/meshoptimizer.h"
+
+#include "SkrProfile/profile.h"
+
+namespace skd
+{
+namespace asset
+{
+void ReadPrimitiveIndices(const skr_mesh_primitive_t& primitive, const skr::Vector<skr::Vector<uint8_t>>& bins, skr::Vector<uint32_t>& out_indices)
+{
+    const auto& ib     = primitive.index_buffer;
+    const auto* data   = bins[ib.buffer_index].data() + ib.index_offset;
+    const auto  stride = ib.stride;
+    out_indices.resize_unsafe(ib.index_count);
+    for (uint32_t i = 0; i < ib.index_count; i++)
+    {
+        const auto* index = data + (uint64_t)(ib.first_index + i) * stride;
+        if (stride == sizeof(uint8_t))
+            out_indices[i] = *(const uint8_t*)index;
+        else if (stride == sizeof(uint16_t))
+            out_indices[i] = *(const uint16_t*)index;
+        else if (stride == sizeof(uint32_t))
+            out_indices[i] = *(const uint32_t*)index;
+        else if (stride == sizeof(uint64_t))
+            out_indices[i] = (uint32_t)*(const uint64_t*)index;
+    }
+}
+
+void WritePrimitiveIndices(const skr_mesh_primitive_t& primitive, skr::Vector<skr::Vector<uint8_t>>& bins, skr::span<const uint32_t> indices)
+{
+    const auto& ib     = primitive.index_buffer;
+    auto*       data   = bins[ib.buffer_index].data() + ib.index_offset;
+    const auto  stride = ib.stride;
+    SKR_ASSERT(indices.size() == ib.index_count);
+    for (uint32_t i = 0; i < ib.index_count; i++)
+    {
+        auto* index = data + (uint64_t)(ib.first_index + i) * stride;
+        if (stride == sizeof(uint8_t))
+            *(uint8_t*)index = (uint8_t)indices[i];
+        else if (stride == sizeof(uint16_t))
+            *(uint16_t*)index = (uint16_t)indices[i];
+        else if (stride == sizeof(uint32_t))
+            *(uint32_t*)index = indices[i];
+        else if (stride == sizeof(uint64_t))
+            *(uint64_t*)index = indices[i];
+    }
+}
+
+const skr_vertex_buffer_entry_t* FindPrimitivePositions(const skr_mesh_primitive_t& primitive)
+{
+    for (const auto& vb : primitive.vertex_buffers)
+    {
+        if (vb.attribute == SKR_VERT_ATTRIB_POSITION && vb.attribute_index == 0 && vb.stride >= sizeof(skr_float3_t))
+            return &vb;
+    }
+    return nullptr;
+}
+
+void OptimizeMeshPrimitive(skr_mesh_primitive_t& primitive, skr::Vector<skr::Vector<uint8_t>>& bins, SMeshOptimizeStatistics& stats)
+{
+    SkrZoneScopedN("OptimizeMeshPrimitive");
+
+    // allow up to 1% worse ACMR to get more reordering opportunities for overdraw
+    const float kOverDrawThreshold = 1.01f;
+    const auto  startTime          = skr_sys_get_usec(true);
+    const auto  index_count        = primitive.index_buffer.index_count;
+    const auto  vertex_count       = primitive.vertex_count;
+
+    skr::Vector<uint32_t> indices;
+    ReadPrimitiveIndices(primitive, bins, indices);
+    for (const auto index : indices)
+    {
+        SKR_ASSERT(index < vertex_count && "Invalid index");
+        (void)index;
+    }
+
+    // vertex cache optimization should go first as it provides starting order for overdraw
+    meshopt_optimizeVertexCache(indices.data(), indices.data(), index_count, vertex_count);
+
+    // reorder indices for overdraw, balancing overdraw and vertex cache efficiency
+    if (const auto positions = FindPrimitivePositions(primitive))
+    {
+        const auto* vertices = (const float*)(bins[positions->buffer_index].data() + positions->offset);
+        meshopt_optimizeOverdraw(indices.data(), indices.data(), index_count, vertices, vertex_count, positions->stride, kOverDrawThreshold);
+    }
+
+    // vertex fetch optimization should go last as it depends on the final index order,
+    // every stream is reordered with the same remap so they keep matching each other
+    skr::Vector<uint32_t> remap;
+    remap.resize_unsafe(vertex_count);
+    const auto unique_count = (uint32_t)meshopt_optimizeVertexFetchRemap(remap.data(), indices.data(), index_count, vertex_count);
+    skr::Vector<uint8_t> stream;
+    for (const auto& vb : primitive.vertex_buffers)
+    {
+        if (!vb.stride)
+            continue;
+        auto* vertices = bins[vb.buffer_index].data() + vb.offset;
+        stream.resize_unsafe((uint64_t)vb.stride * vertex_count);
+        memcpy(stream.data(), vertices, stream.size());
+        meshopt_remapVertexBuffer(vertices, stream.data(), vertex_count, vb.stride, remap.data());
+    }
+    meshopt_remapIndexBuffer(indices.data(), indices.data(), index_count, remap.data());
+    // unreferenced vertices are dropped to the tail of every stream
+    primitive.vertex_count = unique_count;
+
+    WritePrimitiveIndices(primitive, bins, indices);
+
+    stats.primitives += 1;
+    stats.vertices += unique_count;
+    stats.triangles += index_count / 3;
+    stats.optimizeTime += skr_sys_get_usec(true) - startTime;
+}
+
+void BuildMeshletStream(const skr_mesh_primitive_t& primitive, const skr::Vector<skr::Vector<uint8_t>>& bins, const SMeshCookConfig& cfg,
+                        skr_meshlet_buffer_entry_t& out_entry, skr::Vector<uint8_t>& out_stream, SMeshOptimizeStatistics& stats)
+{
+    SkrZoneScopedN("BuildMeshletStream");
+
+    out_entry = {};
+    out_stream.clear();
+    const auto positions = FindPrimitivePositions(primitive);
+    if (!positions || primitive.index_buffer.index_count < 3)
+        return;
+
+    const auto startTime    = skr_sys_get_usec(true);
+    const auto index_count  = primitive.index_buffer.index_count;
+    const auto vertex_count = primitive.vertex_count;
+    const auto* vertices    = (const float*)(bins[positions->buffer_index].data() + positions->offset);
+    // meshlet local indices are 8 bits & mesh shaders emit at most 256 vertices / 512 primitives
+    const size_t max_vertices  = std::min<size_t>(cfg.meshletMaxVertices, 255);
+    const size_t max_triangles = std::min<size_t>(cfg.meshletMaxTriangles, 512) & ~size_t(3);
+    SKR_ASSERT(max_vertices >= 3 && max_triangles >= 4 && "Invalid meshlet limits");
+
+    skr::Vector<uint32_t> indices;
+    ReadPrimitiveIndices(primitive, bins, indices);
+
+    const auto                   max_meshlets = meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles);
+    skr::Vector<meshopt_Meshlet> meshlets;
+    skr::Vector<uint32_t>        meshlet_vertices;
+    skr::Vector<uint8_t>         meshlet_triangles;
+    meshlets.resize_unsafe(max_meshlets);
+    meshlet_vertices.resize_unsafe(max_meshlets * max_vertices);
+    meshlet_triangles.resize_unsafe(max_meshlets * max_triangles * 3);
+    const auto meshlet_count = (uint32_t)meshopt_buildMeshlets(meshlets.data(), meshlet_vertices.data(), meshlet_triangles.data(),
+                                                               indices.data(), index_count, vertices, vertex_count, positions->stride,
+                                                               max_vertices, max_triangles, cfg.meshletConeWeight);
+    if (!meshlet_count)
+        return;
+
+    // the triangles of every meshlet are padded to 4 bytes by meshopt
+    const auto& last          = meshlets[meshlet_count - 1];
+    const auto  used_vertices = last.vertex_offset + last.vertex_count;
+    const auto  used_bytes    = last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3u);
+
+    out_entry.meshlet_count = meshlet_count;
+    out_entry.vertex_count  = used_vertices;
+    out_entry.triangle_size = used_bytes;
+    const auto layout       = skr::renderer::MeshletStreamLayout::Get(out_entry);
+    out_stream.resize_zeroed(layout.size);
+
+    auto* out_meshlets = (skr_meshlet_t*)out_stream.data();
+    auto* out_bounds   = (skr_meshlet_bounds_t*)(out_stream.data() + layout.bounds_offset);
+    for (uint32_t i = 0; i < meshlet_count; i++)
+    {
+        const auto& meshlet            = meshlets[i];
+        out_meshlets[i].vertex_offset   = meshlet.vertex_offset;
+        out_meshlets[i].triangle_offset = meshlet.triangle_offset;
+        out_meshlets[i].vertex_count    = meshlet.vertex_count;
+        out_meshlets[i].triangle_count  = meshlet.triangle_count;
+
+        const auto bounds = meshopt_computeMeshletBounds(meshlet_vertices.data() + meshlet.vertex_offset,
+                                                         meshlet_triangles.data() + meshlet.triangle_offset, meshlet.triangle_count,
+                                                         vertices, vertex_count, positions->stride);
+        auto& out          = out_bounds[i];
+        out.center         = { bounds.center[0], bounds.center[1], bounds.center[2] };
+        out.radius         = bounds.radius;
+        out.cone_apex      = { bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2] };
+        out.cone_cutoff    = bounds.cone_cutoff;
+        out.cone_axis      = { bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2] };
+        out.padding        = 0.f;
+
+        stats.meshletTriangles += meshlet.triangle_count;
+    }
+    memcpy(out_stream.data() + layout.vertices_offset, meshlet_vertices.data(), used_vertices * sizeof(uint32_t));
+    memcpy(out_stream.data() + layout.triangles_offset, meshlet_triangles.data(), used_bytes);
+
+    stats.meshlets += meshlet_count;
+    stats.meshletVertices += used_vertices;
+    stats.meshletBytes += layout.size;
+    stats.meshletTime += skr_sys_get_usec(true) - startTime;
+}
+void BuildPrimitiveLODs(const skr_mesh_primitive_t& primitive, const skr::Vector<skr::Vector<uint8_t>>& bins, const SMeshCookConfig& cfg,
+                        skr::Vector<SMeshPrimitiveLOD>& out_lods, SMeshOptimizeStatistics& stats)
+{
+    SkrZoneScopedN("BuildPrimitiveLODs");
+
+    // a LOD must drop at least 5% of the indices of its predecessor to be worth its memory
+    const float kMinReduction = 0.95f;
+    // the topology preserving simplifier is considered stalled above 1.5x of the target
+    const float kStallThreshold = 1.5f;
+
+    out_lods.clear();
+    const auto positions = FindPrimitivePositions(primitive);
+    if (!positions || cfg.lodRatios.empty())
+        return;
+
+    const auto  index_count  = primitive.index_buffer.index_count;
+    const auto  vertex_count = primitive.vertex_count;
+    const auto* vertices     = (const float*)(bins[positions->buffer_index].data() + positions->offset);
+    // meshopt errors are relative to the mesh extents
+    const float error_scale = meshopt_simplifyScale(vertices, vertex_count, positions->stride);
+    const auto  options     = cfg.lodLockBorder ? (unsigned)meshopt_SimplifyLockBorder : 0u;
+
+    skr::Vector<uint32_t> source;
+    ReadPrimitiveIndices(primitive, bins, source);
+    if (stats.lods.size() < cfg.lodRatios.size())
+        stats.lods.resize_default(cfg.lodRatios.size());
+
+    float error = 0.f;
+    for (uint32_t i = 0; i < cfg.lodRatios.size(); i++)
+    {
+        const auto startTime    = skr_sys_get_usec(true);
+        const auto target_count = std::max<size_t>((size_t)(index_count * cfg.lodRatios[i]) / 3 * 3, 3);
+        const auto target_error = cfg.lodErrors.empty() ? 1e-2f : cfg.lodErrors[std::min<uint32_t>(i, (uint32_t)cfg.lodErrors.size() - 1)];
+
+        SMeshPrimitiveLOD lod;
+        lod.indices.resize_unsafe(source.size());
+        float result_error = 0.f;
+        auto  result_count = meshopt_simplify(lod.indices.data(), source.data(), source.size(), vertices, vertex_count, positions->stride,
+                                              target_count, target_error, options, &result_error);
+        bool  sloppy       = false;
+        if (cfg.lodSloppyFallback && result_count > target_count * kStallThreshold)
+        {
+            skr::Vector<uint32_t> sloppy_indices;
+            sloppy_indices.resize_unsafe(source.size());
+            float      sloppy_error = 0.f;
+            const auto sloppy_count = meshopt_simplifySloppy(sloppy_indices.data(), source.data(), source.size(), vertices, vertex_count, positions->stride,
+                                                             target_count, target_error, &sloppy_error);
+            if (sloppy_count >= 3 && sloppy_count < result_count)
+            {
+                lod.indices  = std::move(sloppy_indices);
+                result_count = sloppy_count;
+                result_error = sloppy_error;
+                sloppy       = true;
+            }
+        }
+        if (result_count < 3 || result_count > source.size() * kMinReduction)
+            break;
+        lod.indices.resize_unsafe(result_count);
+        meshopt_optimizeVertexCache(lod.indices.data(), lod.indices.data(), result_count, vertex_count);
+        // LODs simplify their predecessor, errors of the chain add up
+        error += result_error * error_scale;
+        lod.error = error;
+
+        auto& lodStats = stats.lods[i];
+        lodStats.primitives += 1;
+        lodStats.sloppy += sloppy ? 1 : 0;
+        lodStats.triangles += result_count / 3;
+        lodStats.maxError = std::max(lodStats.maxError, error);
+        lodStats.time += skr_sys_get_usec(true) - startTime;
+
+        source = lod.indices;
+        out_lods.add(std::move(lod));
+    }
+}
+
+void EmplacePrimitiveLODs(skr_mesh_primitive_t& primitive, skr::Vector<skr::Vector<uint8_t>>& bins, skr::span<const SMeshPrimitiveLOD> lods)
+{
+    const auto& ib     = primitive.index_buffer;
+    auto&       bin    = bins[ib.buffer_index];
+    const auto  stride = ib.stride;
+    primitive.lods.clear();
+    for (const auto& lod : lods)
+    {
+        // indices of a LOD are addressed in elements from the index offset of the primitive
+        const auto aligned = (uint64_t)bin.size() + (stride - (bin.size() - ib.index_offset) % stride) % stride;
+        bin.resize_zeroed(aligned + (uint64_t)lod.indices.size() * stride);
+
+        auto& out_lod       = primitive.lods.add_default().ref();
+        out_lod.first_index = (uint32_t)((aligned - ib.index_offset) / stride);
+        out_lod.index_count = (uint32_t)lod.indices.size();
+        out_lod.error       = lod.error;
+        for (uint32_t i = 0; i < out_lod.index_count; i++)
+        {
+            auto* index = bin.data() + aligned + (uint64_t)i * stride;
+            if (stride == sizeof(uint8_t))
+                *(uint8_t*)index = (uint8_t)lod.indices[i];
+            else if (stride == sizeof(uint16_t))
+                *(uint16_t*)index = (uint16_t)lod.indices[i];
+            else if (stride == sizeof(uint32_t))
+                *(uint32_t*)index = lod.indices[i];
+            else if (stride == sizeof(uint64_t))
+                *(uint64_t*)index = lod.indices[i];
+        }
+    }
+}
+} // namespace asset
+} // namespace skd
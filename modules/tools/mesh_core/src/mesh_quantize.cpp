@@ -0,0 +1,304 @@
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
+#include "SkrMeshCore/mesh_processing.hpp"
+#include "SkrRenderer/resources/mesh_resource.h"
+#include "SkrGraphics/api.h"
+#include "MeshOpt/meshoptimizer.h"
+#include <math.h>
+
+#include "SkrProfile/profile.h"
+
+namespace skd
+{
+namespace asset
+{
+enum class EVertexQuantization
+{
+    None,
+    PositionSnorm16,
+    NormalOctahedral,
+    TangentOctahedral,
+    TexcoordHalf
+};
+
+static EVertexQuantization GetVertexQuantization(const skr_vertex_buffer_entry_t& vb, ECGPUFormat format)
+{
+    switch (vb.attribute)
+    {
+        case SKR_VERT_ATTRIB_POSITION:
+            return (format == CGPU_FORMAT_R16G16B16A16_SNORM && vb.stride >= sizeof(float) * 3) ? EVertexQuantization::PositionSnorm16 : EVertexQuantization::None;
+        case SKR_VERT_ATTRIB_NORMAL:
+            return (format == CGPU_FORMAT_R16G16_SNORM && vb.stride >= sizeof(float) * 3) ? EVertexQuantization::NormalOctahedral : EVertexQuantization::None;
+        case SKR_VERT_ATTRIB_TANGENT:
+            return (format == CGPU_FORMAT_R16G16_SNORM && vb.stride >= sizeof(float) * 3) ? EVertexQuantization::TangentOctahedral : EVertexQuantization::None;
+        case SKR_VERT_ATTRIB_TEXCOORD:
+            return (format == CGPU_FORMAT_R16G16_SFLOAT && vb.stride >= sizeof(float) * 2) ? EVertexQuantization::TexcoordHalf : EVertexQuantization::None;
+        default:
+            return EVertexQuantization::None;
+    }
+}
+
+static uint32_t GetQuantizedStride(EVertexQuantization quantization, uint32_t stride)
+{
+    switch (quantization)
+    {
+        case EVertexQuantization::PositionSnorm16:
+            return sizeof(int16_t) * 4;
+        case EVertexQuantization::NormalOctahedral:
+        case EVertexQuantization::TangentOctahedral:
+            return sizeof(int16_t) * 2;
+        case EVertexQuantization::TexcoordHalf:
+            return sizeof(uint16_t) * 2;
+        default:
+            return stride;
+    }
+}
+
+static void OctahedralEncode(const float* n, float& out_u, float& out_v)
+{
+    const float l1 = fabsf(n[0]) + fabsf(n[1]) + fabsf(n[2]);
+    float       u  = l1 > 0.f ? n[0] / l1 : 0.f;
+    float       v  = l1 > 0.f ? n[1] / l1 : 0.f;
+    if (n[2] < 0.f)
+    {
+        const float fold_u = (1.f - fabsf(v)) * (u >= 0.f ? 1.f : -1.f);
+        const float fold_v = (1.f - fabsf(u)) * (v >= 0.f ? 1.f : -1.f);
+        u                  = fold_u;
+        v                  = fold_v;
+    }
+    out_u = u;
+    out_v = v;
+}
+
+static void QuantizeVertices(EVertexQuantization quantization, const uint8_t* src, uint32_t src_stride, uint8_t* dst, uint32_t vertex_count,
+                             const skr_float3_t& offset, const skr_float3_t& scale)
+{
+    const auto dst_stride = GetQuantizedStride(quantization, src_stride);
+    for (uint32_t i = 0; i < vertex_count; i++)
+    {
+        const auto* in = (const float*)(src + (uint64_t)i * src_stride);
+        auto*       out = dst + (uint64_t)i * dst_stride;
+        switch (quantization)
+        {
+            case EVertexQuantization::PositionSnorm16: {
+                auto* q = (int16_t*)out;
+                q[0]    = (int16_t)meshopt_quantizeSnorm((in[0] - offset.x) / scale.x, 16);
+                q[1]    = (int16_t)meshopt_quantizeSnorm((in[1] - offset.y) / scale.y, 16);
+                q[2]    = (int16_t)meshopt_quantizeSnorm((in[2] - offset.z) / scale.z, 16);
+                q[3]    = (int16_t)meshopt_quantizeSnorm(1.f, 16);
+                break;
+            }
+            case EVertexQuantization::NormalOctahedral:
+            case EVertexQuantization::TangentOctahedral: {
+                float u, v;
+                OctahedralEncode(in, u, v);
+                auto* q = (int16_t*)out;
+                q[0]    = (int16_t)meshopt_quantizeSnorm(u, 16);
+                q[1]    = (int16_t)meshopt_quantizeSnorm(v, 16);
+                if (quantization == EVertexQuantization::TangentOctahedral)
+                {
+                    const bool negative = src_stride >= sizeof(float) * 4 && in[3] < 0.f;
+                    q[1]                = (int16_t)((q[1] & ~1) | (negative ? 1 : 0));
+                }
+                break;
+            }
+            case EVertexQuantization::TexcoordHalf: {
+                auto* q = (uint16_t*)out;
+                q[0]    = meshopt_quantizeHalf(in[0]);
+                q[1]    = meshopt_quantizeHalf(in[1]);
+                break;
+            }
+            default:
+                memcpy(out, in, src_stride);
+                break;
+        }
+    }
+}
+
+static void AlignBin(skr::Vector<uint8_t>& bin, uint64_t alignment)
+{
+    bin.resize_zeroed((bin.size() + alignment - 1) / alignment * alignment);
+}
+
+void QuantizeMeshVertices(skr_mesh_resource_t& mesh, skr::Vector<skr::Vector<uint8_t>>& bins, SMeshCompressStatistics& stats)
+{
+    SkrZoneScopedN("QuantizeMeshVertices");
+    const auto startTime = skr_sys_get_usec(true);
+
+    // the vertex layout of every primitive decides the packed format of its streams
+    skr::Vector<skr::Vector<EVertexQuantization>> quantizations(mesh.primitives.size());
+    uint32_t                                      max_streams = 0;
+    for (uint32_t p = 0; p < mesh.primitives.size(); p++)
+    {
+        const auto&      prim   = mesh.primitives[p];
+        CGPUVertexLayout layout = {};
+        const bool       found  = !prim.vertex_layout_id.is_zero() && skr_mesh_resource_query_vertex_layout(prim.vertex_layout_id, &layout);
+        quantizations[p].resize_default(prim.vertex_buffers.size());
+        for (uint32_t j = 0; j < prim.vertex_buffers.size(); j++)
+        {
+            const auto format   = (found && j < layout.attribute_count) ? layout.attributes[j].format : CGPU_FORMAT_UNDEFINED;
+            quantizations[p][j] = GetVertexQuantization(prim.vertex_buffers[j], format);
+        }
+        max_streams = std::max(max_streams, (uint32_t)prim.vertex_buffers.size());
+    }
+
+    // snorm positions span the bounds of the whole mesh
+    skr_float3_t bounds_min = { FLT_MAX, FLT_MAX, FLT_MAX };
+    skr_float3_t bounds_max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (uint32_t p = 0; p < mesh.primitives.size(); p++)
+    {
+        const auto& prim = mesh.primitives[p];
+        for (uint32_t j = 0; j < prim.vertex_buffers.size(); j++)
+        {
+            const auto& vb = prim.vertex_buffers[j];
+            if (quantizations[p][j] != EVertexQuantization::PositionSnorm16)
+                continue;
+            const auto* vertices = bins[vb.buffer_index].data() + vb.offset;
+            for (uint32_t i = 0; i < prim.vertex_count; i++)
+            {
+                const auto* position = (const float*)(vertices + (uint64_t)i * vb.stride);
+                bounds_min           = { std::min(bounds_min.x, position[0]), std::min(bounds_min.y, position[1]), std::min(bounds_min.z, position[2]) };
+                bounds_max           = { std::max(bounds_max.x, position[0]), std::max(bounds_max.y, position[1]), std::max(bounds_max.z, position[2]) };
+            }
+        }
+    }
+    if (bounds_min.x <= bounds_max.x)
+    {
+        mesh.position_offset = { (bounds_min.x + bounds_max.x) * 0.5f, (bounds_min.y + bounds_max.y) * 0.5f, (bounds_min.z + bounds_max.z) * 0.5f };
+        mesh.position_scale  = { std::max((bounds_max.x - bounds_min.x) * 0.5f, FLT_EPSILON),
+                                 std::max((bounds_max.y - bounds_min.y) * 0.5f, FLT_EPSILON),
+                                 std::max((bounds_max.z - bounds_min.z) * 0.5f, FLT_EPSILON) };
+    }
+
+    for (auto& bin : mesh.bins)
+    {
+        if (bin.used_with_meshlet || !(bin.used_with_index || bin.used_with_vertex))
+            continue;
+        const auto&          source = bins[bin.index];
+        skr::Vector<uint8_t> packed;
+        packed.reserve(source.size());
+        // index ranges, the LODs of a primitive follow its LOD 0
+        for (auto& prim : mesh.primitives)
+        {
+            auto& ib = prim.index_buffer;
+            if (ib.buffer_index != bin.index || !ib.stride)
+                continue;
+            AlignBin(packed, std::max<uint32_t>(ib.stride, 4));
+            const auto new_offset = (uint32_t)packed.size();
+            packed.append(source.data() + ib.index_offset + (uint64_t)ib.first_index * ib.stride, (uint64_t)ib.index_count * ib.stride);
+            for (auto& lod : prim.lods)
+            {
+                const auto first_index = (uint32_t)((packed.size() - new_offset) / ib.stride);
+                packed.append(source.data() + ib.index_offset + (uint64_t)lod.first_index * ib.stride, (uint64_t)lod.index_count * ib.stride);
+                lod.first_index = first_index;
+            }
+            ib.index_offset = new_offset;
+            ib.first_index  = 0;
+        }
+        // vertex streams, grouped by attribute for cache friendly fetches of passes reading few attributes
+        for (uint32_t j = 0; j < max_streams; j++)
+        {
+            for (uint32_t p = 0; p < mesh.primitives.size(); p++)
+            {
+                auto& prim = mesh.primitives[p];
+                if (j >= prim.vertex_buffers.size())
+                    continue;
+                auto& vb = prim.vertex_buffers[j];
+                if (vb.buffer_index != bin.index || !vb.stride)
+                    continue;
+                const auto quantization = quantizations[p][j];
+                const auto stride       = GetQuantizedStride(quantization, vb.stride);
+                AlignBin(packed, 16);
+                const auto new_offset = (uint32_t)packed.size();
+                packed.resize_zeroed(packed.size() + (uint64_t)stride * prim.vertex_count);
+                QuantizeVertices(quantization, source.data() + vb.offset, vb.stride, packed.data() + new_offset, prim.vertex_count,
+                                 mesh.position_offset, mesh.position_scale);
+                vb.offset = new_offset;
+                vb.stride = stride;
+            }
+        }
+        stats.rawBytes += source.size();
+        stats.quantizedBytes += packed.size();
+        bins[bin.index]  = std::move(packed);
+        bin.byte_length = bins[bin.index].size();
+    }
+    stats.quantizeTime += skr_sys_get_usec(true) - startTime;
+}
+
+void EncodeMeshBin(const skr_mesh_resource_t& mesh, uint32_t bin_index, skr::span<const uint8_t> bin, skr::Vector<uint8_t>& out_encoded, SMeshCompressStatistics& stats)
+{
+    using namespace skr::renderer;
+    SkrZoneScopedN("EncodeMeshBin");
+    const auto startTime = skr_sys_get_usec(true);
+
+    skr::Vector<MeshBinChunk> chunks;
+    skr::Vector<uint8_t>      payload;
+    skr::Vector<uint32_t>     indices;
+    const auto add_chunk = [&](EMeshBinCodec codec, uint32_t stride, uint64_t offset, uint64_t size) -> MeshBinChunk& {
+        auto& chunk  = chunks.add_default().ref();
+        chunk.codec  = codec;
+        chunk.stride = stride;
+        chunk.offset = offset;
+        chunk.size   = size;
+        return chunk;
+    };
+    const auto add_raw = [&](uint64_t offset, uint64_t size) {
+        if (!size)
+            return;
+        add_chunk(EMeshBinCodec::Raw, 0, offset, size).encoded_size = size;
+        payload.append(bin.data() + offset, size);
+    };
+    const auto add_indices = [&](uint32_t stride, uint64_t offset, uint32_t count, uint32_t vertex_count) {
+        // the index codec takes triangle lists of 16 or 32 bit indices
+        if ((stride != sizeof(uint16_t) && stride != sizeof(uint32_t)) || count % 3)
+            return add_raw(offset, (uint64_t)count * stride);
+        indices.resize_unsafe(count);
+        for (uint32_t i = 0; i < count; i++)
+            indices[i] = stride == sizeof(uint16_t) ? ((const uint16_t*)(bin.data() + offset))[i] : ((const uint32_t*)(bin.data() + offset))[i];
+        const auto cursor = payload.size();
+        payload.resize_unsafe(cursor + meshopt_encodeIndexBufferBound(count, vertex_count));
+        const auto encoded_size = meshopt_encodeIndexBuffer(payload.data() + cursor, payload.size() - cursor, indices.data(), count);
+        payload.resize_unsafe(cursor + encoded_size);
+        add_chunk(EMeshBinCodec::Index, stride, offset, (uint64_t)count * stride).encoded_size = encoded_size;
+    };
+    const auto add_vertices = [&](uint32_t stride, uint64_t offset, uint32_t count) {
+        // the vertex codec takes vertices of 4 byte multiples up to 256 bytes
+        if (stride % 4 || stride > 256)
+            return add_raw(offset, (uint64_t)count * stride);
+        const auto cursor = payload.size();
+        payload.resize_unsafe(cursor + meshopt_encodeVertexBufferBound(count, stride));
+        const auto encoded_size = meshopt_encodeVertexBuffer(payload.data() + cursor, payload.size() - cursor, bin.data() + offset, count, stride);
+        payload.resize_unsafe(cursor + encoded_size);
+        add_chunk(EMeshBinCodec::Vertex, stride, offset, (uint64_t)count * stride).encoded_size = encoded_size;
+    };
+
+    for (const auto& prim : mesh.primitives)
+    {
+        const auto& ib = prim.index_buffer;
+        if (ib.buffer_index == bin_index && ib.stride && ib.index_count)
+        {
+            add_indices(ib.stride, ib.index_offset + (uint64_t)ib.first_index * ib.stride, ib.index_count, prim.vertex_count);
+            for (const auto& lod : prim.lods)
+                add_indices(ib.stride, ib.index_offset + (uint64_t)lod.first_index * ib.stride, lod.index_count, prim.vertex_count);
+        }
+        for (const auto& vb : prim.vertex_buffers)
+        {
+            if (vb.buffer_index == bin_index && vb.stride && prim.vertex_count)
+                add_vertices(vb.stride, vb.offset, prim.vertex_count);
+        }
+    }
+
+    // payloads follow the chunk table in chunk order
+    MeshBinHeader header;
+    header.chunk_count = (uint32_t)chunks.size();
+    header.size        = bin.size();
+    out_encoded.clear();
+    out_encoded.append((const uint8_t*)&header, sizeof(header));
+    out_encoded.append((const uint8_t*)chunks.data(), chunks.size() * sizeof(MeshBinChunk));
+    out_encoded.append(payload.data(), payload.size());
+
+    stats.encodedBytes += out_encoded.size();
+    stats.encodeTime += skr_sys_get_usec(true) - startTime;
+}
+} // namespace asset
+} // namespace skd
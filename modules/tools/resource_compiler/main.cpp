@@ -3,6 +3,9 @@
 #include "SkrBase/misc/defer.hpp"
 #include "SkrRT/misc/cmd_parser.hpp"
 #include "SkrCore/log.hpp"
+#include "SkrCore/time.h"
+#include "SkrCore/process.h"
+#include "SkrOS/thread.h"
 #include "SkrTask/parallel_for.hpp"
 #include "SkrContainers/string.hpp"
 #include "SkrContainers/stl_vector.hpp"
@@ -17,6 +20,7 @@
 #include "SkrAnim/resources/skeleton_resource.hpp"
 #include "SkrToolCore/project/project.hpp"
 #include "SkrToolCore/asset/cook_system.hpp"
+#include "SkrToolCore/asset/cook_dependency_db.hpp"
 
 #include "SkrProfile/profile.h"
 
@@ -75,43 +79,99 @@ void DestroyResourceSystem(skd::SProject& proj)
     SkrDelete(registry);
 }
 
-skr::Vector<skd::SProject*> open_projects(int argc, char** argv)
+struct CompileOptions {
+    skr::String           executable;
+    skr::filesystem::path workspace;
+    skr::String           project;
+    skr::String           cache;
+    // cook worker processes, 0 cooks in-process
+    uint32_t jobs = 0;
+    // set when started by a parent resource compiler as one of its workers
+    bool                  worker      = false;
+    uint32_t              workerIndex = 0;
+    skr::filesystem::path board;
+    // source files separated by ';', the assets depending on them are listed instead of cooked
+    skr::String changed;
+};
+
+bool parse_options(int argc, char** argv, CompileOptions& options)
 {
     skr::cmd::parser parser(argc, argv);
     parser.add(u8"project", u8"project path", u8"-p", false);
     parser.add(u8"workspace", u8"workspace path", u8"-w", true);
+    parser.add(u8"cache", u8"cook cache path, shared between projects & builders", u8"-c", false);
+    parser.add(u8"jobs", u8"cook worker processes, 0 cooks in-process", u8"-j", false);
+    parser.add(u8"worker", u8"internal, index of this cook worker", u8"--worker", false);
+    parser.add(u8"board", u8"internal, job board of the cook workers", u8"--board", false);
+    parser.add(u8"changed", u8"list the assets to recook when these files (separated by ';') change", u8"--changed", false);
     if(!parser.parse())
     {
         SKR_LOG_ERROR(u8"Failed to parse command line arguments.");
-        return {};
+        return false;
     }
-    auto projectPath = parser.get_optional<skr::String>(u8"project");
     std::error_code ec = {};
-    skr::filesystem::path workspace{parser.get<skr::String>(u8"workspace").u8_str()};
-    skd::SProject::SetWorkspace(workspace);
-    skr::filesystem::recursive_directory_iterator iter(workspace, ec);
-    skr::stl_vector<skr::filesystem::path> projectFiles;
-    while (iter != end(iter))
+    options.executable = skr::String(skr::filesystem::absolute(argv[0], ec).u8string().c_str());
+    options.workspace = skr::filesystem::path{parser.get<skr::String>(u8"workspace").u8_str()};
+    if (parser.parsed(u8"project"))
+        options.project = parser.get<skr::String>(u8"project");
+    if (parser.parsed(u8"cache"))
+        options.cache = parser.get<skr::String>(u8"cache");
+    if (parser.parsed(u8"jobs"))
+        options.jobs = parser.get<uint32_t>(u8"jobs");
+    if (parser.parsed(u8"changed"))
+        options.changed = parser.get<skr::String>(u8"changed");
+    if (parser.parsed(u8"worker"))
     {
-        if(iter->is_regular_file(ec) && iter->path().extension() == ".sproject")
+        options.worker = true;
+        options.workerIndex = parser.get<uint32_t>(u8"worker");
+        options.board = skr::filesystem::path{parser.get<skr::String>(u8"board").u8_str()};
+        if (options.project.is_empty() || options.board.empty())
         {
-            projectFiles.push_back(iter->path());
+            SKR_LOG_ERROR(u8"Cook workers need a project & a board.");
+            return false;
+        }
+    }
+    return true;
+}
+
+skr::Vector<skd::SProject*> open_projects(const CompileOptions& options, skr::Vector<skr::filesystem::path>& projectFiles)
+{
+    std::error_code ec = {};
+    skd::SProject::SetWorkspace(options.workspace);
+    if (!options.cache.is_empty())
+        skd::SProject::SetCacheDirectory(skr::filesystem::path{options.cache.u8_str()});
+    skr::Vector<skr::filesystem::path> candidates;
+    if (!options.project.is_empty())
+    {
+        candidates.add(skr::filesystem::path{options.project.u8_str()});
+    }
+    else
+    {
+        skr::filesystem::recursive_directory_iterator iter(options.workspace, ec);
+        while (iter != end(iter))
+        {
+            if(iter->is_regular_file(ec) && iter->path().extension() == ".sproject")
+            {
+                candidates.add(iter->path());
+            }
+            iter.increment(ec);
         }
-        iter.increment(ec);
     }
     skr::Vector<skd::SProject*> result;
-    for (auto& projectFile : projectFiles)
+    for (auto& projectFile : candidates)
     {
         if(auto proj = skd::SProject::OpenProject(projectFile))
+        {
             result.add(proj);
+            projectFiles.add(skr::filesystem::absolute(projectFile, ec));
+        }
     }
     return result;
 }
 
-int compile_project(skd::SProject* project)
+uint64_t load_project_assets(skd::SProject* project)
 {
     auto& system = *skd::asset::GetCookSystem();
-    InitializeResourceSystem(*project);
     std::error_code ec = {};
     skr::filesystem::recursive_directory_iterator iter(project->GetAssetPath(), ec);
     //----- scan project directory
@@ -142,6 +202,35 @@ int compile_project(skd::SProject* project)
     SKR_LOG_INFO(u8"Project asset import finished.");
     skr::filesystem::create_directories(project->GetOutputPath(), ec);
     skr::filesystem::create_directories(project->GetDependencyPath(), ec);
+    return paths.size();
+}
+
+uint64_t compile_project(skd::SProject* project, const skr::filesystem::path& projectFile, const CompileOptions& options, skr::task::scheduler_t& scheduler)
+{
+    auto& system = *skd::asset::GetCookSystem();
+    InitializeResourceSystem(*project);
+    const auto assetCount = load_project_assets(project);
+    //----- start cook workers
+    skd::asset::SCookWorkerPool* pool = nullptr;
+    if (options.jobs)
+    {
+        skd::asset::SCookWorkerPoolDesc poolDesc;
+        poolDesc.scheduler = &scheduler;
+        poolDesc.executable = options.executable;
+        poolDesc.arguments.add(u8"-w");
+        poolDesc.arguments.add(skr::String(options.workspace.u8string().c_str()));
+        poolDesc.arguments.add(u8"-p");
+        poolDesc.arguments.add(skr::String(projectFile.u8string().c_str()));
+        if (!options.cache.is_empty())
+        {
+            poolDesc.arguments.add(u8"-c");
+            poolDesc.arguments.add(options.cache);
+        }
+        poolDesc.boardPath = skr::filesystem::temp_directory_path() / skr::format(u8"SkrCookWorkers-{}", skr_get_current_process_id()).c_str();
+        poolDesc.workerCount = options.jobs;
+        pool = skd::asset::SCookWorkerPool::Create(poolDesc);
+        system.SetWorkerPool(pool);
+    }
     //----- schedule cook tasks (checking dependencies)
     {
         system.ParallelForEachAsset(1,
@@ -166,6 +255,93 @@ int compile_project(skd::SProject* project)
     {
         resource_system->Update();
     }
+    //----- report & stop cook workers
+    if (pool)
+    {
+        system.SetWorkerPool(nullptr);
+        const auto stats = pool->GetStatistics();
+        SKR_LOG_INFO(u8"Cook workers: %llu jobs, %llu succeeded, %llu failed, %llu spawns, %llu crashes, %llu retries, %llu dependency requests, %.3fs spent in cookers.",
+            (unsigned long long)stats.jobs, (unsigned long long)stats.succeeded, (unsigned long long)stats.failed,
+            (unsigned long long)stats.spawns, (unsigned long long)stats.crashes, (unsigned long long)stats.retries,
+            (unsigned long long)stats.dependencyRequests, stats.cookTime / 1000000.0);
+        skd::asset::SCookWorkerPool::Destroy(pool);
+    }
+    DestroyResourceSystem(*project);
+    return assetCount;
+}
+
+uint64_t list_recooks(skd::SProject* project, const CompileOptions& options)
+{
+    auto& system = *skd::asset::GetCookSystem();
+    load_project_assets(project);
+    skr::Vector<skr::filesystem::path> changedFiles;
+    {
+        const auto raw = options.changed.raw();
+        uint64_t start = 0;
+        for (uint64_t i = 0; i <= raw.size(); ++i)
+        {
+            if (i != raw.size() && raw.data()[i] != u8';')
+                continue;
+            if (i != start)
+            {
+                std::error_code ec = {};
+                const skr::String file = skr::StringView((const char8_t*)raw.data() + start, i - start);
+                changedFiles.add(skr::filesystem::absolute(file.c_str(), ec));
+            }
+            start = i + 1;
+        }
+    }
+    const auto queryStart = skr_sys_get_usec(true);
+    skr::Vector<skr_guid_t> recooks;
+    project->GetDependencyDB()->CollectRecooks(changedFiles, {}, recooks);
+    SKR_LOG_INFO(u8"%llu assets to recook, found in %.3fms.", (unsigned long long)recooks.size(), (skr_sys_get_usec(true) - queryStart) / 1000.0);
+    for (const auto& guid : recooks)
+    {
+        if (auto asset = system.GetAssetRecord(guid))
+            SKR_LOG_INFO(u8"    %s", asset->path.u8string().c_str());
+    }
+    return recooks.size();
+}
+
+int serve_cook_worker(skd::SProject* project, const CompileOptions& options)
+{
+    auto& system = *skd::asset::GetCookSystem();
+    InitializeResourceSystem(*project);
+    load_project_assets(project);
+    auto client = skd::asset::SCookWorkerClient::Create(options.board, options.workerIndex);
+    if (!client)
+    {
+        DestroyResourceSystem(*project);
+        return 1;
+    }
+    system.SetWorkerClient(client);
+    //----- cook the jobs of the parent one by one, the resource system serves their static dependencies
+    auto resource_system = skr::resource::GetResourceSystem();
+    skr::task::event_t job_event{ nullptr };
+    skr_guid_t job = {};
+    int64_t job_start = 0;
+    bool quit = false;
+    while (!quit || job_event)
+    {
+        if (job_event && job_event.test())
+        {
+            client->ReportFinished(!system.HasCookFailed(job), (uint64_t)(skr_sys_get_usec(true) - job_start));
+            job_event = nullptr;
+        }
+        skr_guid_t next_job;
+        if (client->Update(next_job, quit) && !job_event)
+        {
+            job = next_job;
+            job_start = skr_sys_get_usec(true);
+            job_event = system.AddCookTask(job);
+        }
+        resource_system->Update();
+        skr_thread_sleep(1);
+    }
+    system.WaitForAll();
+    system.SetWorkerClient(nullptr);
+    skd::asset::SCookWorkerClient::Destroy(client);
+    resource_system->Quit();
     DestroyResourceSystem(*project);
     return 0;
 }
@@ -180,13 +356,54 @@ int compile_all(int argc, char** argv)
     auto& system = *skd::asset::GetCookSystem();
     system.Initialize();
     //----- register project
-    auto projects = open_projects(argc, argv);
+    CompileOptions options;
+    if (!parse_options(argc, argv, options))
+    {
+        scheduler.unbind();
+        system.Shutdown();
+        return 1;
+    }
+    skr::Vector<skr::filesystem::path> projectFiles;
+    auto projects = open_projects(options, projectFiles);
     SKR_DEFER({ 
         for(auto& project : projects)
             SkrDelete(project); 
     });
-    for(auto& project : projects)
-        compile_project(project);
+    if (options.worker)
+    {
+        const int result = projects.size() ? serve_cook_worker(projects[0], options) : 1;
+        scheduler.unbind();
+        system.Shutdown();
+        return result;
+    }
+    if (!options.changed.is_empty())
+    {
+        for (auto project : projects)
+            list_recooks(project, options);
+        scheduler.unbind();
+        system.Shutdown();
+        return 0;
+    }
+    const auto cookStart = skr_sys_get_usec(true);
+    uint64_t assetCount = 0;
+    for(uint32_t i = 0; i < projects.size(); ++i)
+        assetCount += compile_project(projects[i], projectFiles[i], options, scheduler);
+    //----- report cook cache
+    {
+        const auto stats = system.GetCacheStatistics();
+        const auto elapsed = skr_sys_get_usec(true) - cookStart;
+        SKR_LOG_INFO(u8"Cook finished in %.3fs, %llu assets (%.1f assets/s) with %u workers.",
+            elapsed / 1000000.0, (unsigned long long)assetCount, elapsed ? assetCount * 1000000.0 / elapsed : 0.0, options.jobs);
+        SKR_LOG_INFO(u8"Cook cache: %llu hits, %llu misses (%.1f%% hit rate), %llu stores, %.2f MB restored.",
+            (unsigned long long)stats.hits, (unsigned long long)stats.misses, stats.HitRate() * 100.0,
+            (unsigned long long)stats.stores, stats.restoredBytes / (1024.0 * 1024.0));
+        SKR_LOG_INFO(u8"Cook cache saved %.3fs of cooking, %.3fs spent in cookers.",
+            stats.savedTime / 1000000.0, stats.cookTime / 1000000.0);
+        const auto importStats = system.GetImportCache()->GetStatistics();
+        SKR_LOG_INFO(u8"Import cache: %llu hits, %llu parses (%.1f%% hit rate), %.3fs parsing, %.2f MB peak resident.",
+            (unsigned long long)importStats.hits, (unsigned long long)importStats.misses, importStats.HitRate() * 100.0,
+            importStats.loadTime / 1000000.0, importStats.peakBytes / (1024.0 * 1024.0));
+    }
     
     scheduler.unbind();
     system.Shutdown();
@@ -69,11 +69,13 @@ public:
     void SetShaderOptions(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, const skr_stable_shader_hash_t& hash) SKR_NOEXCEPT override;
 
     ICompiledShader* Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT override;
+    uint64_t         GetCompileKey(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT override;
     void             FreeCompileResult(ICompiledShader* compiled) SKR_NOEXCEPT override;
 
     void SetIncludeHandler(IDxcIncludeHandler* includeHandler) SKR_NOEXCEPT;
 
 protected:
+    ECGPUShaderStage createCompileArgs(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer, skr::Vector<skr::stl_wstring>& args) SKR_NOEXCEPT;
     void createDefArgsFromOptions(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, skr::Vector<skr::stl_wstring>& def_args) SKR_NOEXCEPT;
 
     IDxcUtils*          utils          = nullptr;
@@ -92,6 +94,7 @@ protected:
 sreflect_struct("guid" : "ae28a9e5-39cf-4eab-aa27-6103f42cbf2d", "rttr": { "reflect_bases": false })
 SKR_SHADER_COMPILER_API SDXCLibrary : public skr::ModuleSubsystem {
     friend struct DxcCreateInstanceT;
+    friend struct SDXCCompiler;
 
 public:
     static SDXCLibrary* Get() SKR_NOEXCEPT;
@@ -106,6 +109,8 @@ protected:
     skr::SharedLibrary dxc_library;
     skr::SharedLibrary dxil_library;
     void*              pDxcCreateInstance = nullptr;
+    // hash of the version & commit of the loaded dxcompiler
+    uint64_t compiler_version = 0;
 };
 } // namespace asset
 } // namespace skd
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "SkrGraphics/flags.h"
+#include "SkrBase/config.h"
+#include "SkrOS/filesystem.hpp"
+#include "SkrContainers/span.hpp"
+#include "SkrContainers/string.hpp"
+
+namespace skd
+{
+namespace asset
+{
+// compile key of a shader: compiler version, bytecode format, then every argument & the preprocessed source
+struct SKR_SHADER_COMPILER_API ShaderCompileKey {
+    ShaderCompileKey(uint64_t compiler_version, ECGPUShaderBytecodeType format) SKR_NOEXCEPT;
+
+    ShaderCompileKey& Append(const void* data, uint64_t size) SKR_NOEXCEPT;
+
+    // 0 is kept for "no key", it never comes out
+    uint64_t Get() const SKR_NOEXCEPT;
+
+protected:
+    uint64_t key;
+};
+
+struct ShaderCompileCacheEntry {
+    ECGPUShaderStage stage     = CGPU_SHADER_STAGE_NONE;
+    uint32_t         flags     = 0;
+    uint32_t         digits[4] = { 0, 0, 0, 0 };
+    bool             has_pdb   = false;
+};
+
+// compile results of every shader cook, kept in {project cache}/shaders across recooks:
+// keys/{key}.rec           stage & bytecode hash a compile key produced
+// {format}/{hash}.bytes    bytecode (& .pdb), stored once for every key compiling to the same bytes
+struct SKR_SHADER_COMPILER_API ShaderCompileCache {
+    explicit ShaderCompileCache(const skr::filesystem::path& root) SKR_NOEXCEPT;
+
+    bool Load(uint64_t key, ShaderCompileCacheEntry& entry) const SKR_NOEXCEPT;
+    void Store(uint64_t key, ECGPUShaderBytecodeType format, const ShaderCompileCacheEntry& entry,
+               skr::span<const uint8_t> bytecode, skr::span<const uint8_t> pdb) const SKR_NOEXCEPT;
+
+    skr::filesystem::path GetBlobPath(ECGPUShaderBytecodeType format, const ShaderCompileCacheEntry& entry, const char8_t* extension) const SKR_NOEXCEPT;
+
+    // the output files of a compile are named after its bytecode hash
+    static skr::String GetBlobName(const ShaderCompileCacheEntry& entry) SKR_NOEXCEPT;
+
+protected:
+    skr::filesystem::path root;
+};
+} // namespace asset
+} // namespace skd
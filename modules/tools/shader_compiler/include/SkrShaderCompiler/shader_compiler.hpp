@@ -60,12 +60,18 @@ SKR_SHADER_COMPILER_API IShaderCompiler {
     virtual void              SetShaderSwitches(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, const skr_stable_shader_hash_t& hash) SKR_NOEXCEPT = 0;
     virtual void              SetShaderOptions(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, const skr_stable_shader_hash_t& hash) SKR_NOEXCEPT  = 0;
     virtual ICompiledShader*  Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT                                                   = 0;
+    // hash of the preprocessed source, the compile arguments & the compiler build, 0 when the source does not preprocess
+    virtual uint64_t          GetCompileKey(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT                                             = 0;
     virtual void              FreeCompileResult(ICompiledShader* compiled) SKR_NOEXCEPT                                                                                                               = 0;
 };
 
-IShaderCompiler*  SkrShaderCompiler_CreateByType(EShaderSourceType type) SKR_NOEXCEPT;
-void              SkrShaderCompiler_Destroy(IShaderCompiler* compiler) SKR_NOEXCEPT;
-void              Util_ShaderCompilerRegister(EShaderSourceType type, IShaderCompiler* (*ctor)(), void (*dtor)(IShaderCompiler*)) SKR_NOEXCEPT;
-EShaderSourceType Util_GetShaderSourceTypeWithExtensionString(const char8_t* ext) SKR_NOEXCEPT;
+SKR_SHADER_COMPILER_API IShaderCompiler*  SkrShaderCompiler_CreateByType(EShaderSourceType type) SKR_NOEXCEPT;
+SKR_SHADER_COMPILER_API void              SkrShaderCompiler_Destroy(IShaderCompiler* compiler) SKR_NOEXCEPT;
+// pooled compilers, reused by the compile tasks of every cook. a compiler serves one task at a time
+SKR_SHADER_COMPILER_API IShaderCompiler*  SkrShaderCompiler_Acquire(EShaderSourceType type) SKR_NOEXCEPT;
+SKR_SHADER_COMPILER_API void              SkrShaderCompiler_Release(IShaderCompiler* compiler) SKR_NOEXCEPT;
+SKR_SHADER_COMPILER_API void              SkrShaderCompiler_ClearPool(EShaderSourceType type) SKR_NOEXCEPT;
+SKR_SHADER_COMPILER_API void              Util_ShaderCompilerRegister(EShaderSourceType type, IShaderCompiler* (*ctor)(), void (*dtor)(IShaderCompiler*)) SKR_NOEXCEPT;
+SKR_SHADER_COMPILER_API EShaderSourceType Util_GetShaderSourceTypeWithExtensionString(const char8_t* ext) SKR_NOEXCEPT;
 } // namespace asset
 } // namespace skd
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "SkrProfile/profile.h"
 #include "SkrCore/log.h"
+#include "SkrBase/misc/hash.h"
+#include "SkrBase/misc/defer.hpp"
 #include "SkrContainers/stl_string.hpp" //sv::starts_with
 #include "SkrShaderCompiler/dxc_compiler.hpp"
+#include "SkrShaderCompiler/shader_compile_cache.hpp"
 #include "SkrShaderCompiler/assets/shader_asset.hpp"
 
 #ifdef _WIN32
@@ -12,6 +15,7 @@
     #include <unknwn.h> // IWYU pragma: export
     #include <winbase.h> // IWYU pragma: export
     #include <winioctl.h> // IWYU pragma: export
+    #include <objbase.h> // IWYU pragma: export
 #endif
 #include "./../dxc/dxcapi.h" 
 
@@ -383,25 +387,12 @@ void SDXCCompiler::createDefArgsFromOptions(skr::span<skr_shader_option_template
     }
 }
 
-ICompiledShader* SDXCCompiler::Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT
+ECGPUShaderStage SDXCCompiler::createCompileArgs(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer, skr::Vector<skr::stl_wstring>& allArgs) SKR_NOEXCEPT
 {
-    IDxcBlobEncoding* pSourceBlob = nullptr;
-    IDxcResult* pDxcResult = nullptr;
-    if (auto hr = utils->CreateBlobFromPinned(source.blob->get_data(), (uint32_t)source.blob->get_size(), DXC_CP_ACP, &pSourceBlob);!SUCCEEDED(hr))
-    {
-        SKR_LOG_ERROR(u8"DXC Compiler: Failed to create blob from pinned memory, HRESULT: %u!", hr);
-    }
-    DxcBuffer SourceBuffer;
-    SourceBuffer.Ptr = pSourceBlob->GetBufferPointer();
-    SourceBuffer.Size = pSourceBlob->GetBufferSize();
-    SourceBuffer.Encoding = DXC_CP_ACP; // Assume BOM says UTF8 or UTF16 or this is ANSI text.
-    
     // calculate compile arguments
     const auto wTargetString = utf8_to_utf16(importer.target);
     const auto wEntryString = utf8_to_utf16(importer.entry);
     const auto wNameString = utf8_to_utf16(source.source_name);
-    const auto shader_stage = getShaderStageFromTargetString(importer.target.c_str());
-    skr::Vector<skr::stl_wstring> allArgs;
     allArgs.add(wNameString.c_str());
     if (format == CGPU_SHADER_BYTECODE_TYPE_DXIL)
     {
@@ -430,6 +421,64 @@ ICompiledShader* SDXCCompiler::Compile(ECGPUShaderBytecodeType format, const Sha
 
     createDefArgsFromOptions(switch_defs, switches, allArgs);
     createDefArgsFromOptions(option_defs, options, allArgs);
+    return getShaderStageFromTargetString(importer.target.c_str());
+}
+
+uint64_t SDXCCompiler::GetCompileKey(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT
+{
+    IDxcBlobEncoding* pSourceBlob = nullptr;
+    IDxcResult* pDxcResult = nullptr;
+    IDxcBlobUtf8* pPreprocessed = nullptr;
+    SKR_DEFER({ SAFE_RELEASE(pPreprocessed); SAFE_RELEASE(pDxcResult); SAFE_RELEASE(pSourceBlob); });
+    if (auto hr = utils->CreateBlobFromPinned(source.blob->get_data(), (uint32_t)source.blob->get_size(), DXC_CP_ACP, &pSourceBlob);!SUCCEEDED(hr))
+        return 0;
+    DxcBuffer SourceBuffer;
+    SourceBuffer.Ptr = pSourceBlob->GetBufferPointer();
+    SourceBuffer.Size = pSourceBlob->GetBufferSize();
+    SourceBuffer.Encoding = DXC_CP_ACP;
+
+    // preprocess with the real arguments, the output then covers includes & option defines
+    skr::Vector<skr::stl_wstring> allArgs;
+    createCompileArgs(format, source, importer, allArgs);
+    skr::Vector<LPCWSTR> pszArgs;
+    pszArgs.reserve(allArgs.size() + 1);
+    for (auto& arg : allArgs)
+    {
+        pszArgs.add(arg.c_str());
+    }
+    pszArgs.add(L"-P");
+    HRESULT status = E_FAIL;
+    if (!SUCCEEDED(compiler->Compile(&SourceBuffer, pszArgs.data(), (UINT32)pszArgs.size(), includeHandler, IID_PPV_ARGS(&pDxcResult))))
+        return 0;
+    if (!SUCCEEDED(pDxcResult->GetStatus(&status)) || !SUCCEEDED(status))
+        return 0;
+    if (!SUCCEEDED(pDxcResult->GetOutput(DXC_OUT_HLSL, IID_PPV_ARGS(&pPreprocessed), nullptr)) || !pPreprocessed)
+        return 0;
+
+    ShaderCompileKey key(SDXCLibrary::Get()->compiler_version, format);
+    for (auto& arg : allArgs)
+    {
+        key.Append(arg.data(), arg.size() * sizeof(wchar_t));
+    }
+    key.Append(pPreprocessed->GetStringPointer(), pPreprocessed->GetStringLength());
+    return key.Get();
+}
+
+ICompiledShader* SDXCCompiler::Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT
+{
+    IDxcBlobEncoding* pSourceBlob = nullptr;
+    IDxcResult* pDxcResult = nullptr;
+    if (auto hr = utils->CreateBlobFromPinned(source.blob->get_data(), (uint32_t)source.blob->get_size(), DXC_CP_ACP, &pSourceBlob);!SUCCEEDED(hr))
+    {
+        SKR_LOG_ERROR(u8"DXC Compiler: Failed to create blob from pinned memory, HRESULT: %u!", hr);
+    }
+    DxcBuffer SourceBuffer;
+    SourceBuffer.Ptr = pSourceBlob->GetBufferPointer();
+    SourceBuffer.Size = pSourceBlob->GetBufferSize();
+    SourceBuffer.Encoding = DXC_CP_ACP; // Assume BOM says UTF8 or UTF16 or this is ANSI text.
+    
+    skr::Vector<skr::stl_wstring> allArgs;
+    const auto shader_stage = createCompileArgs(format, source, importer, allArgs);
 
 #ifdef SKR_PROFILE_ENABLE
     skr::stl_wstring wArgsString;
@@ -514,6 +563,24 @@ void SDXCLibrary::LoadDXCLibrary() SKR_NOEXCEPT
     pTestUtils->CreateDefaultIncludeHandler(&pIncludeHandler);
     SKR_ASSERT(pTestUtils && "Fatal: Failed to create default include handler for dxc!");
 
+    // the compiler build goes into the keys of the shader compile cache
+    dxcInstance->compiler_version = 0;
+    IDxcVersionInfo2* pVersionInfo = nullptr;
+    if (SUCCEEDED(pTestCompiler->QueryInterface(IID_PPV_ARGS(&pVersionInfo))))
+    {
+        UINT32 version[4] = { 0, 0, 0, 0 };
+        char* commitHash = nullptr;
+        pVersionInfo->GetVersion(&version[0], &version[1]);
+        pVersionInfo->GetFlags(&version[2]);
+        if (SUCCEEDED(pVersionInfo->GetCommitInfo(&version[3], &commitHash)) && commitHash)
+        {
+            dxcInstance->compiler_version = skr_hash64(commitHash, strlen(commitHash), 0);
+            CoTaskMemFree(commitHash);
+        }
+        dxcInstance->compiler_version = skr_hash64(version, sizeof(version), dxcInstance->compiler_version);
+        pVersionInfo->Release();
+    }
+
     pIncludeHandler->Release();
     pTestUtils->Release();
     pTestCompiler->Release();
@@ -553,6 +620,7 @@ void SDXCLibrary::Initialize()
 
 void SDXCLibrary::Finalize()
 {
+    SkrShaderCompiler_ClearPool(EShaderSourceType::HLSL);
     SDXCLibrary::UnloadLibraries();
 }
 }
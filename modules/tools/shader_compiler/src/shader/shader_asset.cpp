@@ -6,11 +6,14 @@
 #include "SkrRenderer/resources/shader_resource.hpp"
 #include "SkrShaderCompiler/assets/shader_asset.hpp"
 #include "SkrShaderCompiler/shader_compiler.hpp"
+#include "SkrToolCore/project/project.hpp"
 #include "SkrSerde/json_serde.hpp"
+#include "SkrShaderCompiler/shader_compile_cache.hpp"
 
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <atomic>
 
 #include "SkrProfile/profile.h"
 
@@ -144,6 +147,11 @@ bool SShaderCooker::Cook(SCookContext* ctx)
     // begin compile
     // auto system = skd::asset::GetCookSystem();
     skr::Vector<skr_multi_shader_resource_t> allOutResources(static_variants.size());
+    // compile results outlive the cook in the project cache, identical bytecode is written once
+    const ShaderCompileCache                                      compileCache(assetRecord->project->GetCachePath() / "shaders");
+    skr::ParallelFlatHashSet<skr::String, skr::Hash<skr::String>> emitted;
+    std::atomic_uint32_t                                          compileCount = 0, cacheHits = 0, deduplicated = 0;
+    std::atomic_bool                                              failed       = false;
     // foreach variants
     {
         SkrZoneScopedN("Permutations::Compile");
@@ -176,75 +184,135 @@ bool SShaderCooker::Cook(SCookContext* ctx)
                                                                           const ECGPUShaderBytecodeType format   = *pFormat;
                                                                           const uint64_t                fmtIndex = pFormat - byteCodeFormats.begin();
 
-                                                                          auto compiler = SkrShaderCompiler_CreateByType(source_code->source_type);
+                                                                          auto compiler = SkrShaderCompiler_Acquire(source_code->source_type);
+                                                                          SKR_DEFER({ SkrShaderCompiler_Release(compiler); });
                                                                           if (compiler->IsSupportedTargetFormat(format))
                                                                           {
                                                                               auto& identifier = outResource.option_variants[dyn_hash][fmtIndex];
-                                                                              auto& stage      = identifier.shader_stage;
-                                                                              // compile & write bytecode to disk
                                                                               const auto* shaderImporter = static_cast<SShaderImporter*>(ctx->GetImporter());
                                                                               compiler->SetShaderSwitches(flat_static_options, static_variants[static_varidx], static_stable_hashes[static_varidx]);
                                                                               compiler->SetShaderOptions(flat_dynamic_options, dynamic_variants[dynamic_varidx], dynamic_stable_hashes[dynamic_varidx]);
-                                                                              auto compiled = compiler->Compile(format, *source_code, *shaderImporter);
-                                                                              stage         = compiled->GetShaderStage();
-                                                                              auto bytes    = compiled->GetBytecode();
-                                                                              auto hashed   = compiled->GetHashCode(&identifier.hash.flags, identifier.hash.encoded_digits);
-                                                                              if (hashed && !bytes.empty())
+                                                                              // create dir
+                                                                              const auto subdir   = CGPUShaderBytecodeTypeNames[format];
+                                                                              auto       basePath = outputPath.parent_path() / subdir;
+                                                                              std::error_code ec = {};
+                                                                              skr::filesystem::create_directories(basePath, ec);
+
+                                                                              ShaderCompileCacheEntry entry;
+                                                                              const uint64_t key = compiler->GetCompileKey(format, *source_code, *shaderImporter);
+                                                                              bool restored = false;
+                                                                              if (key && compileCache.Load(key, entry))
                                                                               {
-                                                                                  // wirte bytecode to disk
-                                                                                  const auto subdir   = CGPUShaderBytecodeTypeNames[format];
-                                                                                  auto       basePath = outputPath.parent_path() / subdir;
-                                                                                  const auto fname    = skr::format(u8"{}#{}-{}-{}-{}",
-                                                                                                                    identifier.hash.flags, identifier.hash.encoded_digits[0],
-                                                                                                                    identifier.hash.encoded_digits[1], identifier.hash.encoded_digits[2], identifier.hash.encoded_digits[3]);
-                                                                                  // create dir
-                                                                                  std::error_code ec = {};
-                                                                                  skr::filesystem::create_directories(basePath, ec);
-                                                                                  // write bytes to file
+                                                                                  // copy the shared blobs, variants with identical bytecode are emitted once
+                                                                                  restored = true;
+                                                                                  const char8_t* extensions[] = { u8"bytes", u8"pdb" };
+                                                                                  for (uint32_t e = 0; e < (entry.has_pdb ? 2u : 1u); e++)
                                                                                   {
-                                                                                      auto bytesPath = basePath / skr::format(u8"{}.bytes", fname).c_str();
+                                                                                      const auto extension = extensions[e];
+                                                                                      const auto name = skr::format(u8"{}.{}", ShaderCompileCache::GetBlobName(entry), extension);
+                                                                                      const auto path = basePath / name.c_str();
+                                                                                      if (!emitted.emplace(name).second)
                                                                                       {
-                                                                                          auto file = fopen(bytesPath.string().c_str(), "wb");
-                                                                                          SKR_DEFER({ fclose(file); });
-                                                                                          if (!file)
-                                                                                          {
-                                                                                              int err_num = errno;
-                                                                                              SKR_LOG_FATAL(u8"Open Shader Output File errno = %d, reason = %s!", err_num, ::strerror(err_num));
-                                                                                              SKR_UNREACHABLE_CODE();
-                                                                                          }
-                                                                                          fwrite(bytes.data(), bytes.size(), 1, file);
+                                                                                          deduplicated++;
+                                                                                          continue;
                                                                                       }
+                                                                                      if (!skr::filesystem::copy_file(compileCache.GetBlobPath(format, entry, extension), path, skr::filesystem::copy_options::overwrite_existing, ec))
+                                                                                      {
+                                                                                          emitted.erase(name);
+                                                                                          restored = false;
+                                                                                          break;
+                                                                                      }
+                                                                                      ctx->AddOutputFile(path);
                                                                                   }
-                                                                                  // write pdb to file
-                                                                                  if (auto pdb = compiled->GetPDB(); !pdb.empty())
+                                                                              }
+                                                                              if (restored)
+                                                                              {
+                                                                                  cacheHits++;
+                                                                              }
+                                                                              else
+                                                                              {
+                                                                                  auto compiled = compiler->Compile(format, *source_code, *shaderImporter);
+                                                                                  if (!compiled)
                                                                                   {
-                                                                                      auto pdbPath = basePath / skr::format(u8"{}.pdb", fname).c_str();
+                                                                                      SKR_LOG_FMT_ERROR(u8"[SShaderCooker::Cook] failed to compile shader {}!", assetRecord->path.string());
+                                                                                      failed = true;
+                                                                                      return;
+                                                                                  }
+                                                                                  SKR_DEFER({ compiler->FreeCompileResult(compiled); });
+                                                                                  compileCount++;
+                                                                                  entry.stage = compiled->GetShaderStage();
+                                                                                  auto bytes  = compiled->GetBytecode();
+                                                                                  auto pdb    = compiled->GetPDB();
+                                                                                  auto hashed = compiled->GetHashCode(&entry.flags, entry.digits);
+                                                                                  entry.has_pdb = !pdb.empty();
+                                                                                  if (hashed && !bytes.empty())
+                                                                                  {
+                                                                                      const auto fname = ShaderCompileCache::GetBlobName(entry);
+                                                                                      // write bytes to file
+                                                                                      if (emitted.emplace(skr::format(u8"{}.bytes", fname)).second)
                                                                                       {
-                                                                                          auto pdb_file = fopen(pdbPath.string().c_str(), "wb");
-                                                                                          SKR_DEFER({ fclose(pdb_file); });
-                                                                                          if (!pdb_file)
+                                                                                          auto bytesPath = basePath / skr::format(u8"{}.bytes", fname).c_str();
                                                                                           {
-                                                                                              int err_num = errno;
-                                                                                              SKR_LOG_FATAL(u8"Open PDB File errno = %d, reason = %s!", err_num, ::strerror(err_num));
-                                                                                              SKR_UNREACHABLE_CODE();
+                                                                                              auto file = fopen(bytesPath.string().c_str(), "wb");
+                                                                                              SKR_DEFER({ fclose(file); });
+                                                                                              if (!file)
+                                                                                              {
+                                                                                                  int err_num = errno;
+                                                                                                  SKR_LOG_FATAL(u8"Open Shader Output File errno = %d, reason = %s!", err_num, ::strerror(err_num));
+                                                                                                  SKR_UNREACHABLE_CODE();
+                                                                                              }
+                                                                                              fwrite(bytes.data(), bytes.size(), 1, file);
                                                                                           }
-                                                                                          fwrite(pdb.data(), pdb.size(), 1, pdb_file);
+                                                                                          ctx->AddOutputFile(bytesPath);
                                                                                       }
+                                                                                      else
+                                                                                      {
+                                                                                          deduplicated++;
+                                                                                      }
+                                                                                      // write pdb to file
+                                                                                      if (entry.has_pdb && emitted.emplace(skr::format(u8"{}.pdb", fname)).second)
+                                                                                      {
+                                                                                          auto pdbPath = basePath / skr::format(u8"{}.pdb", fname).c_str();
+                                                                                          {
+                                                                                              auto pdb_file = fopen(pdbPath.string().c_str(), "wb");
+                                                                                              SKR_DEFER({ fclose(pdb_file); });
+                                                                                              if (!pdb_file)
+                                                                                              {
+                                                                                                  int err_num = errno;
+                                                                                                  SKR_LOG_FATAL(u8"Open PDB File errno = %d, reason = %s!", err_num, ::strerror(err_num));
+                                                                                                  SKR_UNREACHABLE_CODE();
+                                                                                              }
+                                                                                              fwrite(pdb.data(), pdb.size(), 1, pdb_file);
+                                                                                          }
+                                                                                          ctx->AddOutputFile(pdbPath);
+                                                                                      }
+                                                                                      if (key)
+                                                                                      {
+                                                                                          compileCache.Store(key, format, entry, bytes, pdb);
+                                                                                      }
+                                                                                  }
+                                                                                  else
+                                                                                  {
+                                                                                      SKR_UNREACHABLE_CODE();
                                                                                   }
                                                                               }
-                                                                              else
+                                                                              // fill platform identifier
+                                                                              identifier.shader_stage  = entry.stage;
+                                                                              identifier.hash.flags    = entry.flags;
+                                                                              for (uint32_t i = 0; i < 4; i++)
                                                                               {
-                                                                                  SKR_UNREACHABLE_CODE();
+                                                                                  identifier.hash.encoded_digits[i] = entry.digits[i];
                                                                               }
-                                                                              compiler->FreeCompileResult(compiled);
-                                                                              // fill platform identifier
                                                                               identifier.bytecode_type = format;
                                                                           }
-                                                                          SkrShaderCompiler_Destroy(compiler);
                                                                       }); // end foreach target profile
                                                 });                       // end foreach dynamic variant
                           });                                             // end foreach variant
     }
+    SKR_LOG_INFO(u8"[SShaderCooker::Cook] %s: %u compiled, %u from compile cache, %u duplicated blobs skipped.",
+                 assetRecord->path.u8string().c_str(), compileCount.load(), cacheHits.load(), deduplicated.load());
+    if (failed)
+        return false;
 
     // resolve output stage
     for (auto&& staticVariant : allOutResources)
@@ -336,6 +404,7 @@ bool SShaderCooker::Cook(SCookContext* ctx)
         SKR_DEFER({ fclose(file); });
         auto jString = writer.Write();
         fwrite(jString.raw().data(), jString.raw().size(), 1, file);
+        ctx->AddOutputFile(jPath);
     }
     return true;
 }
@@ -0,0 +1,137 @@
+#include "SkrBase/misc/defer.hpp"
+#include "SkrBase/misc/hash.h"
+#include "SkrCore/process.h"
+#include "SkrOS/thread.h"
+#include "SkrGraphics/api.h"
+#include "SkrShaderCompiler/shader_compile_cache.hpp"
+#include <stdio.h>
+
+namespace skd
+{
+namespace asset
+{
+static constexpr uint32_t kShaderCompileCacheMagic   = 0x43534B53; // SKSC
+static constexpr uint32_t kShaderCompileCacheVersion = 1;
+
+struct ShaderCompileCacheRecord {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t stage;
+    uint32_t flags;
+    uint32_t digits[4];
+    uint32_t has_pdb;
+};
+
+// entries are shared by concurrent cooks & worker processes, they appear with a rename once complete
+static bool ShaderCompileCacheWrite(const skr::filesystem::path& path, skr::span<const uint8_t> content)
+{
+    const auto tmpPath = path.u8string() + skr::format(u8".{}-{}.tmp", skr_get_current_process_id(), skr_current_thread_id()).u8_str();
+    {
+        auto file = fopen((const char*)tmpPath.c_str(), "wb");
+        if (!file)
+            return false;
+        SKR_DEFER({ fclose(file); });
+        if (fwrite(content.data(), 1, content.size(), file) != content.size())
+            return false;
+    }
+    std::error_code ec = {};
+    skr::filesystem::rename(skr::filesystem::path(tmpPath), path, ec);
+    if (ec)
+    {
+        skr::filesystem::remove(skr::filesystem::path(tmpPath), ec);
+        return false;
+    }
+    return true;
+}
+
+static skr::filesystem::path ShaderCompileCacheRecordPath(const skr::filesystem::path& root, uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.rec", (unsigned long long)key);
+    return root / "keys" / name;
+}
+
+ShaderCompileKey::ShaderCompileKey(uint64_t compiler_version, ECGPUShaderBytecodeType format) SKR_NOEXCEPT
+    : key(skr_hash64(&compiler_version, sizeof(compiler_version), 0))
+{
+    key = skr_hash64(&format, sizeof(format), key);
+}
+
+ShaderCompileKey& ShaderCompileKey::Append(const void* data, uint64_t size) SKR_NOEXCEPT
+{
+    key = skr_hash64(data, size, key);
+    return *this;
+}
+
+uint64_t ShaderCompileKey::Get() const SKR_NOEXCEPT
+{
+    return key ? key : 1;
+}
+
+ShaderCompileCache::ShaderCompileCache(const skr::filesystem::path& root) SKR_NOEXCEPT
+    : root(root)
+{
+}
+
+skr::String ShaderCompileCache::GetBlobName(const ShaderCompileCacheEntry& entry) SKR_NOEXCEPT
+{
+    return skr::format(u8"{}#{}-{}-{}-{}", entry.flags, entry.digits[0], entry.digits[1], entry.digits[2], entry.digits[3]);
+}
+
+skr::filesystem::path ShaderCompileCache::GetBlobPath(ECGPUShaderBytecodeType format, const ShaderCompileCacheEntry& entry, const char8_t* extension) const SKR_NOEXCEPT
+{
+    return root / CGPUShaderBytecodeTypeNames[format] / skr::format(u8"{}.{}", GetBlobName(entry), extension).c_str();
+}
+
+bool ShaderCompileCache::Load(uint64_t key, ShaderCompileCacheEntry& entry) const SKR_NOEXCEPT
+{
+    const auto recordPath = ShaderCompileCacheRecordPath(root, key);
+    auto       file       = fopen(recordPath.string().c_str(), "rb");
+    if (!file)
+        return false;
+    SKR_DEFER({ fclose(file); });
+    ShaderCompileCacheRecord record;
+    if (fread(&record, sizeof(record), 1, file) != 1)
+        return false;
+    if (record.magic != kShaderCompileCacheMagic || record.version != kShaderCompileCacheVersion)
+        return false;
+    entry.stage   = (ECGPUShaderStage)record.stage;
+    entry.flags   = record.flags;
+    entry.has_pdb = record.has_pdb != 0;
+    for (uint32_t i = 0; i < 4; i++)
+        entry.digits[i] = record.digits[i];
+    return true;
+}
+
+void ShaderCompileCache::Store(uint64_t key, ECGPUShaderBytecodeType format, const ShaderCompileCacheEntry& entry,
+                               skr::span<const uint8_t> bytecode, skr::span<const uint8_t> pdb) const SKR_NOEXCEPT
+{
+    std::error_code ec = {};
+    // bytecode first, a record never points to a missing blob
+    const auto bytesPath = GetBlobPath(format, entry, u8"bytes");
+    if (!skr::filesystem::exists(bytesPath, ec))
+    {
+        skr::filesystem::create_directories(bytesPath.parent_path(), ec);
+        if (!ShaderCompileCacheWrite(bytesPath, bytecode))
+            return;
+    }
+    if (entry.has_pdb)
+    {
+        const auto pdbPath = GetBlobPath(format, entry, u8"pdb");
+        if (!skr::filesystem::exists(pdbPath, ec) && !ShaderCompileCacheWrite(pdbPath, pdb))
+            return;
+    }
+    ShaderCompileCacheRecord record;
+    record.magic   = kShaderCompileCacheMagic;
+    record.version = kShaderCompileCacheVersion;
+    record.stage   = (uint32_t)entry.stage;
+    record.flags   = entry.flags;
+    record.has_pdb = entry.has_pdb ? 1 : 0;
+    for (uint32_t i = 0; i < 4; i++)
+        record.digits[i] = entry.digits[i];
+    const auto recordPath = ShaderCompileCacheRecordPath(root, key);
+    skr::filesystem::create_directories(recordPath.parent_path(), ec);
+    ShaderCompileCacheWrite(recordPath, { (const uint8_t*)&record, sizeof(record) });
+}
+} // namespace asset
+} // namespace skd
@@ -3,6 +3,7 @@
 #include "SkrContainers/hashmap.hpp"
 #include "SkrContainers/stl_function.hpp"
 #include "SkrBase/config.h"
+#include "SkrOS/thread.h"
 #include "SkrShaderCompiler/shader_compiler.hpp"
 
 namespace skd
@@ -27,12 +28,17 @@ struct SKR_SHADER_COMPILER_API SShaderCompilerModule : public skr::IDynamicModul
             // SKR_LOG_DEBUG(u8"ShaderCompilerModule unload event %s invoked", name.c_str());
             unload_event();
         }
+        // backends clear their pooled compilers when they unload, see SkrShaderCompiler_ClearPool
     }
     
     static skr::FlatHashMap<skd::asset::EShaderSourceType, skr::stl_function<IShaderCompiler*()>> ctors;
     static skr::FlatHashMap<skd::asset::EShaderSourceType, skr::stl_function<void(IShaderCompiler*)>> dtors;
     static skr::Vector<std::pair<skr::String, skr::stl_function<void()>>> on_load_events;
     static skr::Vector<std::pair<skr::String, skr::stl_function<void()>>> on_unload_events;
+
+    // lives with the pool rather than the module, compilers registered without a load can be pooled too
+    static SMutexObject pool_mutex;
+    static skr::FlatHashMap<skd::asset::EShaderSourceType, skr::Vector<IShaderCompiler*>> pool;
 };
 
 IMPLEMENT_DYNAMIC_MODULE(SShaderCompilerModule, SkrShaderCompiler);
@@ -40,6 +46,8 @@ skr::FlatHashMap<skd::asset::EShaderSourceType, skr::stl_function<IShaderCompile
 skr::FlatHashMap<skd::asset::EShaderSourceType, skr::stl_function<void(IShaderCompiler*)>> SShaderCompilerModule::dtors = {};
 skr::Vector<std::pair<skr::String, skr::stl_function<void()>>> SShaderCompilerModule::on_load_events = {};
 skr::Vector<std::pair<skr::String, skr::stl_function<void()>>> SShaderCompilerModule::on_unload_events = {};
+SMutexObject SShaderCompilerModule::pool_mutex;
+skr::FlatHashMap<skd::asset::EShaderSourceType, skr::Vector<IShaderCompiler*>> SShaderCompilerModule::pool = {};
 
 IShaderCompiler* SkrShaderCompiler_CreateByType(asset::EShaderSourceType type) SKR_NOEXCEPT
 {
@@ -61,6 +69,44 @@ void SkrShaderCompiler_Destroy(IShaderCompiler* compiler) SKR_NOEXCEPT
     }
 }
 
+IShaderCompiler* SkrShaderCompiler_Acquire(asset::EShaderSourceType type) SKR_NOEXCEPT
+{
+    {
+        SMutexLock lock(SShaderCompilerModule::pool_mutex.mMutex);
+        auto iter = SShaderCompilerModule::pool.find(type);
+        if (iter != SShaderCompilerModule::pool.end() && !iter->second.empty())
+        {
+            auto compiler = iter->second.last();
+            iter->second.pop_back();
+            return compiler;
+        }
+    }
+    return SkrShaderCompiler_CreateByType(type);
+}
+
+void SkrShaderCompiler_Release(IShaderCompiler* compiler) SKR_NOEXCEPT
+{
+    if (!compiler) return;
+    SMutexLock lock(SShaderCompilerModule::pool_mutex.mMutex);
+    SShaderCompilerModule::pool[compiler->GetSourceType()].add(compiler);
+}
+
+void SkrShaderCompiler_ClearPool(asset::EShaderSourceType type) SKR_NOEXCEPT
+{
+    skr::Vector<IShaderCompiler*> compilers;
+    {
+        SMutexLock lock(SShaderCompilerModule::pool_mutex.mMutex);
+        auto iter = SShaderCompilerModule::pool.find(type);
+        if (iter == SShaderCompilerModule::pool.end()) return;
+        compilers = std::move(iter->second);
+        iter->second.clear();
+    }
+    for (auto compiler : compilers)
+    {
+        SkrShaderCompiler_Destroy(compiler);
+    }
+}
+
 void Util_ShaderCompilerRegister(asset::EShaderSourceType type, IShaderCompiler*(*ctor)(), void(*dtor)(IShaderCompiler*)) SKR_NOEXCEPT
 {
     SShaderCompilerModule::ctors.emplace(type, ctor);
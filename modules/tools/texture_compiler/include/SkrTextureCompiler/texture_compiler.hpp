@@ -11,10 +11,28 @@ namespace skd
 {
 namespace asset
 {
+// selects the block compression of a texture
+sreflect_enum_class("guid" : "6f0d6d5e-2b37-4c1e-9a35-0d8f4b1c7e21")
+sattr("serde" : "json")
+ETextureUsage : uint32_t
+{
+    auto_detect, // gray: mask, translucent: color_alpha, otherwise: color
+    color,       // BC1, opaque color
+    color_alpha, // BC7, high quality RGBA
+    normal,      // BC5, tangent space normals, blue is reconstructed in shaders
+    mask,        // BC4, single channel
+    hdr          // BC6H, 16 bit sources are linear
+};
+
 sreflect_struct("guid" : "a26c2436-9e5f-43c4-b4d7-e5373d353bae")
 sattr("serde" : "json")
 SKR_TEXTURE_COMPILER_API STextureImporter final : public SImporter {
-    skr::String assetPath;
+    skr::String   assetPath;
+    ETextureUsage usage = ETextureUsage::auto_detect;
+    // color channels are sRGB encoded, filtered in linear space & sampled through sRGB formats
+    bool srgb = true;
+    // generates the full mip chain down to 1x1
+    bool mips = true;
 
     void* Import(skr_io_ram_service_t*, SCookContext* context) override;
     void  Destroy(void* resource) override;
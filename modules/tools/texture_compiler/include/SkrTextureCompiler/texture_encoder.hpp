@@ -0,0 +1,46 @@
+#pragma once
+#include "SkrTextureCompiler/texture_compiler.hpp"
+#include "SkrImageCoder/skr_image_coder.h"
+#include "SkrGraphics/flags.h"
+#include "SkrBase/math/rtm/vector4f.h"
+#include "SkrContainers/vector.hpp"
+
+namespace skd
+{
+namespace asset
+{
+struct TextureCompressStatistics {
+    uint64_t texels     = 0;
+    uint64_t filterTime = 0; // microseconds
+    uint64_t encodeTime = 0; // microseconds
+};
+
+struct TextureCompressResult {
+    ECGPUFormat format     = CGPU_FORMAT_UNDEFINED;
+    uint32_t    width      = 0;
+    uint32_t    height     = 0;
+    uint32_t    mips_count = 0;
+    // every mip block compressed & tightly packed, mip 0 first
+    skr::Vector<uint8_t>      data;
+    TextureCompressStatistics statistics;
+};
+
+// texels of one mip in linear space, normals in [-1, 1]
+struct TextureMip {
+    uint32_t                  width  = 0;
+    uint32_t                  height = 0;
+    skr::Vector<rtm::float4f> texels;
+};
+
+// decodes the image, filters the mip chain in linear space & block compresses it in tiles on the task system
+bool Util_CompressTexture(skr::ImageDecoderId decoder, const STextureImporter& importer, TextureCompressResult& result);
+
+// appends the mips after mips[0] down to 1x1, each texel box filters its footprint in the previous mip
+SKR_TEXTURE_COMPILER_API
+void Util_BuildTextureMips(skr::Vector<TextureMip>& mips, bool normals);
+
+// block compresses the mips to format, fills everything but result.statistics.filterTime
+SKR_TEXTURE_COMPILER_API
+void Util_EncodeTextureMips(const skr::Vector<TextureMip>& mips, ECGPUFormat format, bool srgb, TextureCompressResult& result);
+} // namespace asset
+} // namespace skd
@@ -1,6 +1,7 @@
 #include "SkrToolCore/asset/cook_system.hpp"
 #include "SkrToolCore/project/project.hpp"
 #include "dxt_utils.hpp"
+#include "SkrTextureCompiler/texture_encoder.hpp"
 #include "SkrRT/io/ram_io.hpp"
 #include "SkrCore/log.hpp"
 
@@ -70,35 +71,33 @@ bool STextureCooker::Cook(SCookContext *ctx)
     auto uncompressed = ctx->Import<skr_uncompressed_render_texture_t>();
     SKR_DEFER({ ctx->Destroy(uncompressed); });
     
-    // try decode texture & calculate compressed format
-    const auto decoder = uncompressed->decoder;
-    const auto format = decoder->get_color_format();
-    ECGPUFormat compressed_format = CGPU_FORMAT_UNDEFINED;
-    switch (format) // TODO: format shuffle
-    {
-        case IMAGE_CODER_COLOR_FORMAT_Gray: 
-        case IMAGE_CODER_COLOR_FORMAT_GrayF:
-            compressed_format = CGPU_FORMAT_DXBC4_UNORM; 
-            break;
-        case IMAGE_CODER_COLOR_FORMAT_RGBA:
-        default:
-            compressed_format = CGPU_FORMAT_DXBC3_UNORM; 
-            break;
-    }
-    // DXT
-    skr::Vector<uint8_t> compressed_data;
+    // mips & block compression
+    const auto            importer = static_cast<STextureImporter*>(ctx->GetImporter());
+    const auto            decoder  = uncompressed->decoder;
+    TextureCompressResult compressed;
     {
         SkrZoneScopedN("DXTCompress");
-        compressed_data = Util_DXTCompressWithImageCoder(decoder, compressed_format);
+        if (!Util_CompressTexture(decoder, *importer, compressed))
+        {
+            SKR_LOG_ERROR(u8"[STextureCooker::Cook] failed to decode texture %s!", importer->assetPath.c_str());
+            return false;
+        }
     }
+    const auto& stats = compressed.statistics;
+    SKR_LOG_INFO(u8"[STextureCooker::Cook] %s: %ux%u %s, %u mips, filter %.2f MPix/s, encode %.2f MPix/s",
+                 importer->assetPath.c_str(), compressed.width, compressed.height, Util_CompressedTypeString(compressed.format).c_str(),
+                 compressed.mips_count, stats.filterTime ? stats.texels / (double)stats.filterTime : 0.0,
+                 stats.encodeTime ? stats.texels / (double)stats.encodeTime : 0.0);
+    const auto  compressed_format = compressed.format;
+    const auto& compressed_data   = compressed.data;
     // TODO: ASTC
     // write texture resource
     skr_texture_resource_t resource;
     resource.format = compressed_format;
-    resource.mips_count = 1;
+    resource.mips_count = compressed.mips_count;
     resource.data_size = compressed_data.size();
-    resource.height = decoder->get_height();
-    resource.width = decoder->get_width();
+    resource.height = compressed.height;
+    resource.width = compressed.width;
     resource.depth = 1;
     {
         SkrZoneScopedN("SaveToCtx");
@@ -116,6 +115,7 @@ bool STextureCooker::Cook(SCookContext *ctx)
         auto compressed_file = fopen(compressed_pathstr.c_str(), "wb");
         SKR_DEFER({ fclose(compressed_file); });
         fwrite(compressed_data.data(), compressed_data.size(), 1, compressed_file);
+        ctx->AddOutputFile(compressed_path);
     }
     return true;
 }
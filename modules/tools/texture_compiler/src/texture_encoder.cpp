@@ -0,0 +1,408 @@
+#include "SkrBase/math/rtm/vector4f.h"
+#include "SkrCore/time.h"
+#include "SkrCore/log.hpp"
+#include "SkrTask/parallel_for.hpp"
+#include "dxt_utils.hpp"
+#include "SkrTextureCompiler/texture_encoder.hpp"
+#include <math.h>
+#include <string.h>
+
+#include "SkrProfile/profile.h"
+
+namespace skd
+{
+namespace asset
+{
+namespace
+{
+// texels filtered by one task, rounded to whole rows
+static constexpr uint32_t kTextureFilterBatch = 64 * 1024;
+// blocks encoded by one task, rounded to whole block rows
+static constexpr uint32_t kTextureEncodeBatch = 4096;
+
+// source texels & weights of one destination texel along an axis
+struct TextureFilterTaps {
+    uint32_t first = 0;
+    uint32_t count = 0;
+    float    weights[4];
+};
+
+struct TextureTile {
+    uint32_t mip;
+    uint32_t block_row_begin;
+    uint32_t block_row_end;
+};
+
+inline float TextureSRGBToLinear(float c)
+{
+    return (c <= 0.04045f) ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+}
+
+inline float TextureLinearToSRGB(float c)
+{
+    return (c <= 0.0031308f) ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+}
+
+inline uint8_t TextureUNormToByte(float c)
+{
+    c = (c < 0.f) ? 0.f : ((c > 1.f) ? 1.f : c);
+    return (uint8_t)(c * 255.f + 0.5f);
+}
+
+// round to nearest, denormals flush to zero & overflows clamp to the largest finite half
+inline uint16_t TextureFloatToHalf(float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    const uint32_t sign     = (bits >> 16) & 0x8000;
+    const uint32_t biased   = (bits >> 23) & 0xff;
+    const uint32_t mantissa = bits & 0x7fffff;
+    if (biased == 0xff)
+        return (uint16_t)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+    const int32_t exponent = (int32_t)biased - 127 + 15;
+    if (exponent <= 0)
+        return (uint16_t)sign;
+    if (exponent >= 31)
+        return (uint16_t)(sign | 0x7bff);
+    uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000)
+        half++;
+    if ((half & 0x7fff) > 0x7bff)
+        half = sign | 0x7bff;
+    return (uint16_t)half;
+}
+
+inline ECGPUFormat TextureSelectFormat(ETextureUsage usage, bool srgb)
+{
+    switch (usage)
+    {
+        case ETextureUsage::color:
+            return srgb ? CGPU_FORMAT_DXBC1_RGB_SRGB : CGPU_FORMAT_DXBC1_RGB_UNORM;
+        case ETextureUsage::color_alpha:
+            return srgb ? CGPU_FORMAT_DXBC7_SRGB : CGPU_FORMAT_DXBC7_UNORM;
+        case ETextureUsage::normal:
+            return CGPU_FORMAT_DXBC5_UNORM;
+        case ETextureUsage::mask:
+            return CGPU_FORMAT_DXBC4_UNORM;
+        case ETextureUsage::hdr:
+            return CGPU_FORMAT_DXBC6H_UFLOAT;
+        default:
+            SKR_UNREACHABLE_CODE()
+            return CGPU_FORMAT_UNDEFINED;
+    }
+}
+
+// bytes per texel of the ISPC kernel inputs
+inline uint32_t TextureEncoderTexelSize(ECGPUFormat format)
+{
+    switch (format)
+    {
+        case CGPU_FORMAT_DXBC4_UNORM:
+            return 1;
+        case CGPU_FORMAT_DXBC5_UNORM:
+            return 2;
+        case CGPU_FORMAT_DXBC6H_UFLOAT:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
+// texel rows handled by one task when it covers about batch items of rowSize each
+inline size_t TextureBatchRows(uint32_t rowSize, uint32_t batch)
+{
+    return (rowSize >= batch) ? 1 : (batch / rowSize);
+}
+
+// box footprint of every destination texel, in units of 1/dst texels to stay exact:
+// even sizes weight 2 texels evenly, odd sizes spread 2n + 1 texels over n so the last row & column are kept
+void TextureBoxTaps(uint32_t srcSize, uint32_t dstSize, skr::Vector<TextureFilterTaps>& taps)
+{
+    taps.resize_default(dstSize);
+    for (uint32_t x = 0; x < dstSize; x++)
+    {
+        const uint64_t begin = (uint64_t)x * srcSize;
+        const uint64_t end   = begin + srcSize;
+        auto&          tap   = taps[x];
+        tap.first            = (uint32_t)(begin / dstSize);
+        tap.count            = (uint32_t)((end + dstSize - 1) / dstSize - tap.first);
+        SKR_ASSERT(tap.count <= 4);
+        for (uint32_t i = 0; i < tap.count; i++)
+        {
+            const uint64_t texelBegin = (uint64_t)(tap.first + i) * dstSize;
+            const uint64_t overlap    = std::min(end, texelBegin + dstSize) - std::max(begin, texelBegin);
+            tap.weights[i]            = (float)overlap / (float)srcSize;
+        }
+    }
+}
+
+void TextureDownsample(const TextureMip& src, TextureMip& dst, bool normals)
+{
+    dst.width  = (src.width > 1) ? (src.width >> 1) : 1;
+    dst.height = (src.height > 1) ? (src.height >> 1) : 1;
+    dst.texels = skr::Vector<rtm::float4f>((uint64_t)dst.width * dst.height);
+    skr::Vector<TextureFilterTaps> tapsX, tapsY;
+    TextureBoxTaps(src.width, dst.width, tapsX);
+    TextureBoxTaps(src.height, dst.height, tapsY);
+    const auto fallback = rtm::vector_set(0.f, 0.f, 1.f, 1.f);
+    const auto rowBatch = TextureBatchRows(dst.width, kTextureFilterBatch) * dst.width;
+    skr::parallel_for(dst.texels.begin(), dst.texels.end(), rowBatch,
+                      [&](rtm::float4f* begin, rtm::float4f* end) {
+                          const uint64_t first = begin - dst.texels.begin();
+                          for (uint64_t i = first; i < first + (end - begin); i += dst.width)
+                          {
+                              const auto& ty     = tapsY[(uint32_t)(i / dst.width)];
+                              auto*       dstRow = dst.texels.data() + i;
+                              for (uint32_t x = 0; x < dst.width; x++)
+                              {
+                                  const auto&   tx  = tapsX[x];
+                                  rtm::vector4f sum = rtm::vector_zero();
+                                  for (uint32_t r = 0; r < ty.count; r++)
+                                  {
+                                      const auto*   row    = src.texels.data() + (uint64_t)(ty.first + r) * src.width + tx.first;
+                                      rtm::vector4f rowSum = rtm::vector_zero();
+                                      for (uint32_t c = 0; c < tx.count; c++)
+                                          rowSum = rtm::vector_mul_add(rtm::vector_load(row + c), tx.weights[c], rowSum);
+                                      sum = rtm::vector_mul_add(rowSum, ty.weights[r], sum);
+                                  }
+                                  if (normals)
+                                      sum = rtm::vector_normalize3(sum, fallback);
+                                  rtm::vector_store(sum, dstRow + x);
+                              }
+                          }
+                      });
+}
+
+void TextureEncodeTile(const TextureTile& tile, const TextureMip& mip, ECGPUFormat format, bool srgb, uint8_t* dst)
+{
+    const uint32_t texelSize = TextureEncoderTexelSize(format);
+    const uint32_t blocksW   = (mip.width + 3) / 4;
+    const uint32_t width     = blocksW * 4;
+    const uint32_t rows      = (tile.block_row_end - tile.block_row_begin) * 4;
+    const uint32_t stride    = width * texelSize;
+    skr::Vector<uint8_t> scratch;
+    scratch.resize_unsafe((uint64_t)stride * rows);
+    // convert to the kernel input, replicating the edges up to whole blocks
+    for (uint32_t ty = 0; ty < rows; ty++)
+    {
+        const uint32_t sy  = std::min(tile.block_row_begin * 4 + ty, mip.height - 1);
+        const auto*    src = mip.texels.data() + (uint64_t)sy * mip.width;
+        uint8_t*       out = scratch.data() + (uint64_t)ty * stride;
+        for (uint32_t tx = 0; tx < width; tx++)
+        {
+            const auto& t = src[std::min(tx, mip.width - 1)];
+            switch (format)
+            {
+                case CGPU_FORMAT_DXBC4_UNORM:
+                    out[tx] = TextureUNormToByte(t.x);
+                    break;
+                case CGPU_FORMAT_DXBC5_UNORM:
+                    out[tx * 2 + 0] = TextureUNormToByte(t.x * 0.5f + 0.5f);
+                    out[tx * 2 + 1] = TextureUNormToByte(t.y * 0.5f + 0.5f);
+                    break;
+                case CGPU_FORMAT_DXBC6H_UFLOAT: {
+                    const uint16_t half[4] = {
+                        TextureFloatToHalf(std::max(t.x, 0.f)),
+                        TextureFloatToHalf(std::max(t.y, 0.f)),
+                        TextureFloatToHalf(std::max(t.z, 0.f)),
+                        TextureFloatToHalf(1.f)
+                    };
+                    memcpy(out + tx * 8, half, sizeof(half));
+                }
+                break;
+                default:
+                    out[tx * 4 + 0] = TextureUNormToByte(srgb ? TextureLinearToSRGB(t.x) : t.x);
+                    out[tx * 4 + 1] = TextureUNormToByte(srgb ? TextureLinearToSRGB(t.y) : t.y);
+                    out[tx * 4 + 2] = TextureUNormToByte(srgb ? TextureLinearToSRGB(t.z) : t.z);
+                    out[tx * 4 + 3] = TextureUNormToByte(t.w);
+                    break;
+            }
+        }
+    }
+    rgba_surface surface = {};
+    surface.ptr          = scratch.data();
+    surface.width        = (int32_t)width;
+    surface.height       = (int32_t)rows;
+    surface.stride       = (int32_t)stride;
+    switch (format)
+    {
+        case CGPU_FORMAT_DXBC1_RGB_UNORM:
+        case CGPU_FORMAT_DXBC1_RGB_SRGB:
+            CompressBlocksBC1(&surface, dst);
+            break;
+        case CGPU_FORMAT_DXBC4_UNORM:
+            CompressBlocksBC4(&surface, dst);
+            break;
+        case CGPU_FORMAT_DXBC5_UNORM:
+            CompressBlocksBC5(&surface, dst);
+            break;
+        case CGPU_FORMAT_DXBC6H_UFLOAT: {
+            bc6h_enc_settings settings = {};
+            GetProfile_bc6h_basic(&settings);
+            CompressBlocksBC6H(&surface, dst, &settings);
+        }
+        break;
+        case CGPU_FORMAT_DXBC7_UNORM:
+        case CGPU_FORMAT_DXBC7_SRGB: {
+            bc7_enc_settings settings = {};
+            GetProfile_alpha_basic(&settings);
+            CompressBlocksBC7(&surface, dst, &settings);
+        }
+        break;
+        default:
+            SKR_UNREACHABLE_CODE()
+            break;
+    }
+}
+} // namespace
+
+bool Util_CompressTexture(skr::ImageDecoderId decoder, const STextureImporter& importer, TextureCompressResult& result)
+{
+    // decode to 8 or 16 bit gray / RGBA
+    const auto encoded_format = decoder->get_color_format();
+    const bool gray           = (encoded_format == IMAGE_CODER_COLOR_FORMAT_Gray) || (encoded_format == IMAGE_CODER_COLOR_FORMAT_GrayF);
+    const auto raw_format     = gray ? IMAGE_CODER_COLOR_FORMAT_Gray : IMAGE_CODER_COLOR_FORMAT_RGBA;
+    const auto bit_depth      = (decoder->get_bit_depth() > 8) ? 16u : 8u;
+    {
+        SkrZoneScopedN("Decode");
+        if (!decoder->decode(raw_format, bit_depth))
+            return false;
+    }
+    const uint32_t channels = gray ? 1 : 4;
+    const float    scale    = 1.f / ((bit_depth == 16) ? 65535.f : 255.f);
+    const auto     texel    = [&](const uint8_t* data, uint64_t index, uint32_t channel) {
+        if (bit_depth == 16)
+            return ((const uint16_t*)data)[index * channels + channel] * scale;
+        return data[index * channels + channel] * scale;
+    };
+
+    // resolve usage & format
+    auto usage = importer.usage;
+    if (usage == ETextureUsage::auto_detect)
+    {
+        usage = gray ? ETextureUsage::mask : ETextureUsage::color;
+        if (!gray)
+        {
+            const auto     data   = decoder->get_data();
+            const uint64_t texels = (uint64_t)decoder->get_width() * decoder->get_height();
+            for (uint64_t i = 0; i < texels; i++)
+            {
+                if (texel(data, i, 3) < 1.f)
+                {
+                    usage = ETextureUsage::color_alpha;
+                    break;
+                }
+            }
+        }
+    }
+    const bool colors    = (usage == ETextureUsage::color) || (usage == ETextureUsage::color_alpha);
+    const bool normals   = (usage == ETextureUsage::normal);
+    const bool linearize = importer.srgb && (colors || (usage == ETextureUsage::hdr && bit_depth == 8));
+    result.format        = TextureSelectFormat(usage, importer.srgb && colors);
+    result.width         = decoder->get_width();
+    result.height        = decoder->get_height();
+
+    // mip 0 in linear space, normals in [-1, 1]
+    skr::Vector<TextureMip> mips;
+    const auto              filterStart = skr_sys_get_usec(true);
+    {
+        SkrZoneScopedN("FilterMips");
+        float srgbTable[256];
+        for (uint32_t i = 0; i < 256; i++)
+            srgbTable[i] = TextureSRGBToLinear(i / 255.f);
+        auto& mip0  = mips.add_default().ref();
+        mip0.width  = result.width;
+        mip0.height = result.height;
+        mip0.texels = skr::Vector<rtm::float4f>((uint64_t)mip0.width * mip0.height);
+        const auto data = decoder->get_data();
+        skr::parallel_for(mip0.texels.begin(), mip0.texels.end(), TextureBatchRows(mip0.width, kTextureFilterBatch) * mip0.width,
+                          [&](rtm::float4f* begin, rtm::float4f* end) {
+                              for (auto* t = begin; t != end; t++)
+                              {
+                                  const uint64_t i = t - mip0.texels.begin();
+                                  float          c[4];
+                                  for (uint32_t ch = 0; ch < 4; ch++)
+                                      c[ch] = (ch == 3) ? (gray ? 1.f : texel(data, i, 3)) : texel(data, i, gray ? 0 : ch);
+                                  if (linearize)
+                                  {
+                                      for (uint32_t ch = 0; ch < 3; ch++)
+                                      {
+                                          c[ch] = (bit_depth == 8) ? srgbTable[gray ? data[i] : data[i * 4 + ch]] : TextureSRGBToLinear(c[ch]);
+                                      }
+                                  }
+                                  auto v = rtm::vector_set(c[0], c[1], c[2], c[3]);
+                                  if (normals)
+                                  {
+                                      v = rtm::vector_sub(rtm::vector_mul(v, 2.f), rtm::vector_set(1.f));
+                                      v = rtm::vector_normalize3(v, rtm::vector_set(0.f, 0.f, 1.f, 1.f));
+                                  }
+                                  rtm::vector_store(v, t);
+                              }
+                          });
+        if (importer.mips)
+            Util_BuildTextureMips(mips, normals);
+    }
+    const auto filterTime = (uint64_t)(skr_sys_get_usec(true) - filterStart);
+
+    Util_EncodeTextureMips(mips, result.format, importer.srgb && colors, result);
+    result.statistics.filterTime = filterTime;
+    return true;
+}
+
+void Util_BuildTextureMips(skr::Vector<TextureMip>& mips, bool normals)
+{
+    SKR_ASSERT(!mips.is_empty());
+    while (mips.last().width > 1 || mips.last().height > 1)
+    {
+        TextureMip next;
+        TextureDownsample(mips.last(), next, normals);
+        mips.add(std::move(next));
+    }
+}
+
+void Util_EncodeTextureMips(const skr::Vector<TextureMip>& mips, ECGPUFormat format, bool srgb, TextureCompressResult& result)
+{
+    SKR_ASSERT(!mips.is_empty());
+    result.format     = format;
+    result.width      = mips[0].width;
+    result.height     = mips[0].height;
+    result.mips_count = (uint32_t)mips.size();
+    result.statistics = {};
+
+    // layout the mips & split them into tiles of block rows
+    skr::Vector<uint64_t>    offsets;
+    skr::Vector<TextureTile> tiles;
+    uint64_t                 size = 0;
+    for (uint32_t m = 0; m < mips.size(); m++)
+    {
+        const auto&    mip     = mips[m];
+        const uint32_t blocksW = (mip.width + 3) / 4;
+        const uint32_t blocksH = (mip.height + 3) / 4;
+        const uint32_t rows    = (uint32_t)TextureBatchRows(blocksW, kTextureEncodeBatch);
+        for (uint32_t r = 0; r < blocksH; r += rows)
+            tiles.add({ m, r, std::min(r + rows, blocksH) });
+        offsets.add(size);
+        size += Util_DXBCCompressedSize(mip.width, mip.height, format);
+        result.statistics.texels += (uint64_t)mip.width * mip.height;
+    }
+    result.data = skr::Vector<uint8_t>(size);
+
+    const auto encodeStart = skr_sys_get_usec(true);
+    {
+        SkrZoneScopedN("EncodeTiles");
+        const uint32_t blockSize = FormatUtil_BitSizeOfBlock(format) / 8;
+        skr::parallel_for(tiles.begin(), tiles.end(), 1,
+                          [&](const TextureTile* begin, const TextureTile* end) {
+                              for (auto* tile = begin; tile != end; tile++)
+                              {
+                                  const auto&    mip     = mips[tile->mip];
+                                  const uint32_t blocksW = (mip.width + 3) / 4;
+                                  auto*          dst     = result.data.data() + offsets[tile->mip] + (uint64_t)tile->block_row_begin * blocksW * blockSize;
+                                  TextureEncodeTile(*tile, mip, format, srgb, dst);
+                              }
+                          });
+    }
+    result.statistics.encodeTime = (uint64_t)(skr_sys_get_usec(true) - encodeStart);
+}
+} // namespace asset
+} // namespace skd
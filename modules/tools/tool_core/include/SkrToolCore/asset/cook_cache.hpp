@@ -0,0 +1,40 @@
+#pragma once
+#include "SkrToolCore/fwd_types.hpp"
+#include <atomic>
+
+namespace skd::asset
+{
+struct SCookCacheStatistics {
+    uint64_t hits          = 0;
+    uint64_t misses        = 0;
+    uint64_t stores        = 0;
+    uint64_t restoredBytes = 0;
+    // cook time recorded by the restored entries, in microseconds
+    uint64_t savedTime = 0;
+    // time spent in cookers during this session, in microseconds
+    uint64_t cookTime = 0;
+
+    double HitRate() const { return (hits + misses) ? (double)hits / (double)(hits + misses) : 0.0; }
+};
+
+// content addressed store of cook outputs, lives in SProject::GetCachePath() and can be copied between builders.
+// recipes/{recipe}.d   dependency file of the last cook, addressed by the meta text & importer/cooker versions
+// objects/{content}/   cook outputs, addressed by the recipe & the contents of the sources & static dependencies it lists
+// assets cooked by development versions (UINT32_MAX) never go through the cache
+struct TOOL_CORE_API SCookCache {
+    // copies the outputs & dependency file of a previous cook with the same inputs into the project
+    bool Restore(SAssetRecord* record, SCooker* cooker);
+    // must be called after the resource header & dependency file were written
+    void Store(SCookContext* ctx, uint64_t cookTime);
+
+    SCookCacheStatistics GetStatistics() const;
+
+protected:
+    std::atomic_uint64_t hits          = 0;
+    std::atomic_uint64_t misses        = 0;
+    std::atomic_uint64_t stores        = 0;
+    std::atomic_uint64_t restoredBytes = 0;
+    std::atomic_uint64_t savedTime     = 0;
+    std::atomic_uint64_t cookTime      = 0;
+};
+} // namespace skd::asset
@@ -0,0 +1,61 @@
+#pragma once
+#include "SkrToolCore/fwd_types.hpp"
+#include "SkrOS/filesystem.hpp"
+#include "SkrOS/thread.h"
+#include "SkrLightningStorage/mdb.h"
+#include "SkrContainers/span.hpp"
+#include "SkrContainers/string.hpp"
+#include "SkrContainers/vector.hpp"
+#include "SkrContainers/hashmap.hpp"
+
+namespace skd::asset
+{
+struct SCookDependencyRecord {
+    uint64_t importerVersion = 0;
+    uint64_t cookerVersion   = 0;
+    // absolute & lexically normal
+    skr::Vector<skr::String> files;
+    skr::Vector<skr_guid_t>  staticDependencies;
+    skr::Vector<skr_guid_t>  runtimeDependencies;
+};
+
+// persistent index of the {guid}.d dependency files of a project, lives in {deps}/db (LMDB).
+// assets/{guid}                      forward record, tagged with the timestamp of the .d file it was read from
+// file_users/{hash(path)}{guid}      reverse edge, the asset read the source file
+// static_users/{resource}{guid}      reverse edge, the asset loaded the resource while cooking
+// runtime_users/{resource}{guid}     reverse edge, the asset references the resource at runtime
+// .d files stay the source of truth: a record older than its .d file (cache restores, other builders) is re-read.
+// updates are batched in memory & written in one transaction by Flush, queries flush first.
+struct TOOL_CORE_API SCookDependencyDB {
+    static SCookDependencyDB* Open(const skr::filesystem::path& path);
+    // flushes pending updates
+    static void Close(SCookDependencyDB* db);
+
+    // false if the .d file is missing or broken
+    bool Load(const SAssetRecord* asset, const skr::filesystem::path& dependencyFile, SCookDependencyRecord& record);
+    // must be called once the .d file is written
+    void Update(skr_guid_t asset, const skr::filesystem::path& dependencyFile, const SCookDependencyRecord& record);
+    // writes the pending records & replaces the reverse edges of their assets
+    void Flush();
+
+    // assets to recook when changedFiles & changedAssets are modified: users of the files & assets,
+    // and all assets statically depending on those, transitively. changed assets are included
+    void CollectRecooks(skr::span<const skr::filesystem::path> changedFiles, skr::span<const skr_guid_t> changedAssets, skr::Vector<skr_guid_t>& recooks);
+    // runtime references only, they do not need a recook
+    void CollectRuntimeUsers(skr_guid_t resource, skr::Vector<skr_guid_t>& users);
+
+protected:
+    struct PendingRecord {
+        int64_t               stamp = 0;
+        SCookDependencyRecord record;
+    };
+    SMutex                                                             pendingMutex;
+    skr::FlatHashMap<skr_guid_t, PendingRecord, skr::Hash<skr_guid_t>> pending;
+
+    SLightningEnvironmentId env          = nullptr;
+    SLightningStorageId     assets       = nullptr;
+    SLightningStorageId     fileUsers    = nullptr;
+    SLightningStorageId     staticUsers  = nullptr;
+    SLightningStorageId     runtimeUsers = nullptr;
+};
+} // namespace skd::asset
@@ -7,6 +7,9 @@
 #include "SkrCore/blob.hpp"
 #include "SkrRT/resource/resource_header.hpp"
 #include "SkrToolCore/asset/cooker.hpp"
+#include "SkrToolCore/asset/cook_cache.hpp"
+#include "SkrToolCore/asset/import_cache.hpp"
+#include "SkrToolCore/asset/cook_worker.hpp"
 
 SKR_DECLARE_TYPE_ID_FWD(skr::io, IRAMService, skr_io_ram_service);
 namespace skr::task
@@ -44,6 +47,10 @@ public:
     virtual skr::filesystem::path                  AddSourceFileAndLoad(skr_io_ram_service_t* ioService, const skr::filesystem::path& path, skr::BlobId& destination) = 0;
     virtual skr::span<const skr::filesystem::path> GetSourceFiles() const                                                                                             = 0;
 
+    // files written next to the output besides the resource & its header (buffers, bytecode...), thread safe
+    virtual void                               AddOutputFile(const skr::filesystem::path& path) = 0;
+    virtual skr::Vector<skr::filesystem::path> GetOutputFiles() const                           = 0;
+
     virtual void     AddRuntimeDependency(skr_guid_t resource)              = 0;
     virtual void     AddSoftRuntimeDependency(skr_guid_t resource)          = 0;
     virtual uint32_t AddStaticDependency(skr_guid_t resource, bool install) = 0;
@@ -142,6 +149,18 @@ public:
 
     virtual void ParallelForEachAsset(uint32_t batch, skr::FunctionRef<void(skr::span<SAssetRecord*>)> f) = 0;
 
+    virtual SCookCacheStatistics GetCacheStatistics() const = 0;
+    // parsed sources shared by the importers, flushed by WaitForAll
+    virtual SImportCache*        GetImportCache()           = 0;
+
+    // false unless the last cook of the resource in this session failed
+    virtual bool HasCookFailed(skr_guid_t resource) const = 0;
+
+    // parent process: cook tasks hand their asset to the pool's workers
+    virtual void SetWorkerPool(SCookWorkerPool* pool) = 0;
+    // worker process: only the client's job is cooked here, other assets are requested from the parent
+    virtual void SetWorkerClient(SCookWorkerClient* client) = 0;
+
     virtual skr_io_ram_service_t* getIOService() = 0;
 
     static constexpr uint32_t ioServicesMaxCount = 1;
@@ -0,0 +1,82 @@
+#pragma once
+#include "SkrToolCore/fwd_types.hpp"
+#include "SkrOS/filesystem.hpp"
+#include "SkrContainers/string.hpp"
+#include "SkrContainers/vector.hpp"
+
+namespace skr::task
+{
+struct scheduler_t;
+} // namespace skr::task
+
+namespace skd::asset
+{
+// cook workers are resource compiler processes started by the parent with --worker,
+// both sides talk through a lightning storage (LMDB) board in boardPath:
+// job/{i}     parent -> worker i, the asset to cook or a quit request
+// result/{i}  worker i -> parent, started / finished state of the job, streamed as progress
+// need/{i}    worker i -> parent, a dependency the job waits for
+// ready/{i}   parent -> worker i, the dependency is cooked
+struct SCookWorkerPoolDesc {
+    // serves the dependency requests of the workers, must outlive the pool
+    skr::task::scheduler_t* scheduler = nullptr;
+    // the resource compiler & the arguments selecting the workspace, project & cache, --worker & --board are appended
+    skr::String              executable;
+    skr::Vector<skr::String> arguments;
+    skr::filesystem::path    boardPath;
+    uint32_t                 workerCount = 1;
+    // workers blocked on dependencies do not count, extra workers are spawned up to this limit (0: twice workerCount)
+    uint32_t maxWorkerCount = 0;
+    // times a job is requeued after its worker died before it is failed
+    uint32_t maxRetries = 2;
+};
+
+struct SCookWorkerStatistics {
+    uint64_t jobs               = 0;
+    uint64_t succeeded          = 0;
+    uint64_t failed             = 0;
+    uint64_t retries            = 0;
+    uint64_t crashes            = 0;
+    uint64_t spawns             = 0;
+    uint64_t dependencyRequests = 0;
+    // time the workers spent in cookers, in microseconds
+    uint64_t cookTime = 0;
+};
+
+enum class ECookWorkerResult : uint32_t
+{
+    Succeeded,
+    Failed,
+    // every worker is blocked on a dependency & no more can be spawned, the caller cooks in-process
+    CookLocally
+};
+
+// parent side, cook tasks hand their asset over & wait for a worker to finish it
+struct TOOL_CORE_API SCookWorkerPool {
+    static SCookWorkerPool* Create(const SCookWorkerPoolDesc& desc);
+    // quits the workers & waits for them to exit
+    static void Destroy(SCookWorkerPool* pool);
+
+    virtual ~SCookWorkerPool() = default;
+
+    // blocks the calling task until a worker cooked the asset
+    virtual ECookWorkerResult     Cook(SAssetRecord* record) = 0;
+    virtual SCookWorkerStatistics GetStatistics() const      = 0;
+};
+
+// worker side, all calls but RequestDependency are made from the worker's main loop
+struct TOOL_CORE_API SCookWorkerClient {
+    static SCookWorkerClient* Create(const skr::filesystem::path& boardPath, uint32_t workerIndex);
+    static void               Destroy(SCookWorkerClient* client);
+
+    virtual ~SCookWorkerClient() = default;
+
+    // pumps the board, returns true when a new job was picked up. quit is set once the parent is done with this worker
+    virtual bool Update(skr_guid_t& job, bool& quit)                = 0;
+    virtual void ReportFinished(bool succeeded, uint64_t cookTime) = 0;
+    // the job is cooked here, every other asset goes through the parent
+    virtual bool IsJob(skr_guid_t guid) const = 0;
+    // blocks the calling task until the parent made sure the dependency is cooked
+    virtual bool RequestDependency(skr_guid_t guid) = 0;
+};
+} // namespace skd::asset
@@ -0,0 +1,55 @@
+#pragma once
+#include "SkrToolCore/fwd_types.hpp"
+#include "SkrOS/filesystem.hpp"
+#include "SkrOS/thread.h"
+#include "SkrContainers/function_ref.hpp"
+#include "SkrContainers/string.hpp"
+#include "SkrContainers/hashmap.hpp"
+
+namespace skd::asset
+{
+struct SImportCacheStatistics {
+    uint64_t hits   = 0;
+    uint64_t misses = 0;
+    // bytes of the documents alive right now & at most during the session
+    uint64_t residentBytes = 0;
+    uint64_t peakBytes     = 0;
+    // time spent parsing & loading sources, in microseconds
+    uint64_t loadTime = 0;
+
+    double HitRate() const { return (hits + misses) ? (double)hits / (double)(hits + misses) : 0.0; }
+};
+
+// parsed source documents shared by every importer of the same file during a cook session.
+// documents are addressed by parser kind, full path & a fingerprint of the file, a modified file is parsed again.
+// released documents stay resident until idleBudget is exceeded, so assets cooked one after another share them too.
+struct TOOL_CORE_API SImportCache {
+    // returns the parsed document & its resident size, nullptr on failure (failures are not cached)
+    using LoadFunc = skr::FunctionRef<void*(uint64_t& residentBytes)>;
+    using FreeFunc = void (*)(void* document);
+
+    SImportCache() SKR_NOEXCEPT;
+    ~SImportCache() SKR_NOEXCEPT;
+
+    // concurrent importers of a file wait for the first one to load it, every non-null result must be released
+    void* Acquire(const char8_t* kind, const skr::filesystem::path& fullPath, LoadFunc load, FreeFunc free);
+    void  Release(void* document);
+    // frees every document that is not in use
+    void Flush();
+
+    SImportCacheStatistics GetStatistics() const;
+
+    uint64_t idleBudget = 1024ull * 1024 * 1024;
+
+protected:
+    struct Entry;
+    void Destroy(Entry* entry);
+    void Evict();
+
+    mutable SMutex                                                 mutex;
+    skr::FlatHashMap<skr::String, Entry*, skr::Hash<skr::String>> entries;
+    skr::FlatHashMap<void*, Entry*>                                documents;
+    uint64_t                                                       clock = 0;
+    SImportCacheStatistics                                         statistics;
+};
+} // namespace skd::asset
@@ -18,5 +18,6 @@ struct SAssetRecord;
 struct SCookSystem;
 struct SCooker;
 struct SCookContext;
+struct SCookDependencyDB;
 } // namespace asset
 } // namespace skd
\ No newline at end of file
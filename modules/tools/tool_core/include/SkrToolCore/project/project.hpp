@@ -23,17 +23,24 @@ private:
     skr::filesystem::path outputPath;
     skr::filesystem::path artifactsPath;
     skr::filesystem::path dependencyPath;
+    skr::filesystem::path cachePath;
     skr::String           name;
+    asset::SCookDependencyDB* dependencyDB = nullptr;
 
 public:
     skr::filesystem::path GetAssetPath() const noexcept { return assetPath; }
     skr::filesystem::path GetOutputPath() const noexcept { return outputPath; }
     skr::filesystem::path GetDependencyPath() const noexcept { return dependencyPath; }
+    skr::filesystem::path GetCachePath() const noexcept { return cachePath; }
+    // index of the .d files under the dependency path
+    asset::SCookDependencyDB* GetDependencyDB() const noexcept { return dependencyDB; }
     bool                  LoadAssetData(skr::StringView uri, skr::Vector<uint8_t>& content) noexcept;
     bool                  LoadAssetText(skr::StringView uri, skr::String& content) noexcept;
 
     static SProject* OpenProject(const skr::filesystem::path& path) noexcept;
     static void      SetWorkspace(const skr::filesystem::path& path) noexcept;
+    // cook cache shared by every project opened afterwards, defaults to {artifacts}/cache of each project
+    static void      SetCacheDirectory(const skr::filesystem::path& path) noexcept;
 
     skr_vfs_t*            asset_vfs    = nullptr;
     skr_vfs_t*            resource_vfs = nullptr;
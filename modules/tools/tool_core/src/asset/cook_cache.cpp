@@ -0,0 +1,345 @@
+#include "SkrBase/misc/hash.h"
+#include "SkrCore/process.h"
+#include "SkrProfile/profile.h"
+#include "SkrSerde/json_serde.hpp"
+#include "SkrTask/fib_task.hpp"
+#include "SkrToolCore/asset/cook_cache.hpp"
+#include "SkrToolCore/asset/cook_system.hpp"
+#include "SkrToolCore/asset/importer.hpp"
+#include "SkrToolCore/project/project.hpp"
+#include <stdio.h>
+
+namespace skd::asset
+{
+static bool CookCacheReadFile(const skr::filesystem::path& path, skr::Vector<uint8_t>& content)
+{
+    auto file = fopen(path.string().c_str(), "rb");
+    if (!file)
+        return false;
+    SKR_DEFER({ fclose(file); });
+    fseek(file, 0, SEEK_END);
+    const auto fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize < 0)
+        return false;
+    content.resize_unsafe(fileSize);
+    return fread(content.data(), 1, fileSize, file) == (size_t)fileSize;
+}
+
+static bool CookCacheHashFile(const skr::filesystem::path& path, uint64_t& key)
+{
+    skr::Vector<uint8_t> content;
+    if (!CookCacheReadFile(path, content))
+        return false;
+    const uint64_t size = content.size();
+    key                 = skr_hash64(&size, sizeof(size), key);
+    key                 = skr_hash64(content.data(), content.size(), key);
+    return true;
+}
+
+static skr::filesystem::path CookCacheKeyName(uint64_t key)
+{
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+    return name;
+}
+
+static uint32_t CookCacheImporterVersion(const SAssetRecord* record)
+{
+    skr::archive::JsonReader metaReader(record->meta.view());
+    metaReader.StartObject();
+    SKR_DEFER({ metaReader.EndObject(); });
+    skr_guid_t importerTypeGuid;
+    if (!metaReader.Key(u8"importer").has_value())
+        return UINT32_MAX;
+    metaReader.StartObject();
+    SKR_DEFER({ metaReader.EndObject(); });
+    metaReader.Key(u8"importerType");
+    if (!skr::json_read(&metaReader, importerTypeGuid))
+        return UINT32_MAX;
+    return GetImporterRegistry()->GetImporterVersion(importerTypeGuid);
+}
+
+static uint64_t CookCacheRecipeKey(const SAssetRecord* record, uint32_t importerVersion, uint32_t cookerVersion)
+{
+    const uint32_t versions[] = { importerVersion, cookerVersion };
+    uint64_t       key        = skr_hash64(versions, sizeof(versions), SKR_DEFAULT_HASH_SEED_64);
+    return skr_hash64(record->meta.raw().data(), record->meta.raw().size(), key);
+}
+
+// static dependencies go in by their cooked outputs, so a dependency that recooks to the same bytes keeps the key
+static bool CookCacheContentKey(uint64_t recipe, const SAssetRecord* record, skr::span<const skr::filesystem::path> files, skr::span<const skr_guid_t> dependencies, uint64_t& key)
+{
+    key                  = recipe;
+    const auto sourceDir = record->project->GetAssetPath() / record->path.parent_path();
+    for (const auto& file : files)
+    {
+        const auto name = file.generic_string();
+        key             = skr_hash64(name.data(), name.size(), key);
+        if (!CookCacheHashFile(sourceDir / file, key))
+            return false;
+    }
+    auto system = GetCookSystem();
+    for (const auto& dependency : dependencies)
+    {
+        key            = skr_hash64(&dependency, sizeof(dependency), key);
+        auto depRecord = system->GetAssetRecord(dependency);
+        if (!depRecord)
+            return false;
+        if (depRecord->type == skr_guid_t{})
+        {
+            if (!CookCacheHashFile(depRecord->project->GetAssetPath() / depRecord->path, key))
+                return false;
+            continue;
+        }
+        if (auto counter = system->EnsureCooked(dependency))
+            counter.wait(false);
+        const auto resourcePath = depRecord->project->GetOutputPath() / skr::format(u8"{}.bin", dependency).u8_str();
+        auto       headerPath   = resourcePath;
+        headerPath.replace_extension("rh");
+        if (!CookCacheHashFile(resourcePath, key) || !CookCacheHashFile(headerPath, key))
+            return false;
+    }
+    return true;
+}
+
+static bool CookCacheReadDependencies(const skr::Vector<uint8_t>& content, skr::Vector<skr::filesystem::path>& files, skr::Vector<skr_guid_t>& dependencies)
+{
+    // a recipe cut short by a crashed builder does not parse
+    skr::archive::JsonReader depReader(skr::StringView{ (const char8_t*)content.data(), content.size() });
+    if (!depReader.StartObject().has_value())
+        return false;
+    SKR_DEFER({ depReader.EndObject(); });
+    {
+        size_t filesSize = 0;
+        depReader.Key(u8"files");
+        if (!depReader.StartArray(filesSize).has_value())
+            return false;
+        for (size_t i = 0; i < filesSize; i++)
+        {
+            skr::String pathStr;
+            if (!skr::json_read(&depReader, pathStr))
+                return false;
+            files.add(skr::filesystem::path(pathStr.c_str()));
+        }
+        depReader.EndArray();
+    }
+    {
+        size_t depsSize = 0;
+        depReader.Key(u8"dependencies");
+        if (!depReader.StartArray(depsSize).has_value())
+            return false;
+        for (size_t i = 0; i < depsSize; i++)
+        {
+            skr_guid_t depGuid;
+            if (!skr::json_read(&depReader, depGuid))
+                return false;
+            dependencies.add(depGuid);
+        }
+        depReader.EndArray();
+    }
+    return true;
+}
+
+static bool CookCacheCopyFile(const skr::filesystem::path& from, const skr::filesystem::path& to)
+{
+    std::error_code ec = {};
+    skr::filesystem::create_directories(to.parent_path(), ec);
+    if (!skr::filesystem::copy_file(from, to, skr::filesystem::copy_options::overwrite_existing, ec))
+        return false;
+    // staleness checks compare against the output timestamps, a restored copy is as fresh as a cook
+    skr::filesystem::last_write_time(to, skr::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+bool SCookCache::Restore(SAssetRecord* record, SCooker* cooker)
+{
+    SkrZoneScopedN("CookCache::Restore");
+    const auto importerVersion = CookCacheImporterVersion(record);
+    const auto cookerVersion   = cooker->Version();
+    if (importerVersion == UINT32_MAX || cookerVersion == UINT32_MAX)
+        return false;
+
+    const auto           project    = record->project;
+    const auto           cacheDir   = project->GetCachePath();
+    const uint64_t       recipe     = CookCacheRecipeKey(record, importerVersion, cookerVersion);
+    auto                 recipePath = cacheDir / "recipes" / CookCacheKeyName(recipe);
+    skr::Vector<uint8_t> recipeContent;
+    recipePath.replace_extension("d");
+    skr::Vector<skr::filesystem::path> files;
+    skr::Vector<skr_guid_t>            dependencies;
+    uint64_t                           content = 0;
+    if (!CookCacheReadFile(recipePath, recipeContent) ||
+        !CookCacheReadDependencies(recipeContent, files, dependencies) ||
+        !CookCacheContentKey(recipe, record, { files.data(), files.size() }, { dependencies.data(), dependencies.size() }, content))
+    {
+        misses++;
+        return false;
+    }
+
+    const auto           objectDir = cacheDir / "objects" / CookCacheKeyName(content);
+    skr::Vector<uint8_t> manifestContent;
+    if (!CookCacheReadFile(objectDir / "manifest.json", manifestContent))
+    {
+        misses++;
+        return false;
+    }
+    uint64_t                 entryCookTime = 0;
+    skr::Vector<skr::String> outputs;
+    {
+        skr::archive::JsonReader reader(skr::StringView{ (const char8_t*)manifestContent.data(), manifestContent.size() });
+        if (!reader.StartObject().has_value())
+        {
+            misses++;
+            return false;
+        }
+        SKR_DEFER({ reader.EndObject(); });
+        reader.Key(u8"cookTime");
+        reader.UInt64(entryCookTime);
+        size_t outputsSize = 0;
+        reader.Key(u8"files");
+        if (reader.StartArray(outputsSize).has_value())
+        {
+            for (size_t i = 0; i < outputsSize; i++)
+                skr::json_read(&reader, outputs.add_default().ref());
+            reader.EndArray();
+        }
+    }
+
+    const auto outputDir = project->GetOutputPath();
+    uint64_t   bytes     = 0;
+    for (const auto& output : outputs)
+    {
+        const auto      from = objectDir / output.c_str();
+        std::error_code ec   = {};
+        bytes += skr::filesystem::file_size(from, ec);
+        if (ec || !CookCacheCopyFile(from, outputDir / output.c_str()))
+        {
+            SKR_LOG_WARN(u8"[CookCache] broken cache entry %s! asset path: %s", objectDir.u8string().c_str(), record->path.u8string().c_str());
+            misses++;
+            return false;
+        }
+    }
+    // the recipe is the dependency file written by the cook that produced the entry
+    const auto dependencyPath = project->GetDependencyPath() / skr::format(u8"{}.d", record->guid).u8_str();
+    if (!CookCacheCopyFile(recipePath, dependencyPath))
+    {
+        misses++;
+        return false;
+    }
+    hits++;
+    restoredBytes += bytes;
+    savedTime += entryCookTime;
+    SKR_LOG_INFO(u8"[CookCache] resource %s restored from cache!", record->path.u8string().c_str());
+    return true;
+}
+
+void SCookCache::Store(SCookContext* ctx, uint64_t time)
+{
+    SkrZoneScopedN("CookCache::Store");
+    cookTime += time;
+    if (ctx->GetImporterVersion() == UINT32_MAX || ctx->GetCookerVersion() == UINT32_MAX)
+        return;
+
+    const auto record   = ctx->GetAssetRecord();
+    const auto project  = record->project;
+    const auto cacheDir = project->GetCachePath();
+    const auto recipe   = CookCacheRecipeKey(record, ctx->GetImporterVersion(), ctx->GetCookerVersion());
+
+    skr::Vector<skr_guid_t> dependencies;
+    for (const auto& dependency : ctx->GetStaticDependencies())
+        dependencies.add(dependency.get_serialized());
+    uint64_t content = 0;
+    if (!CookCacheContentKey(recipe, record, ctx->GetSourceFiles(), { dependencies.data(), dependencies.size() }, content))
+    {
+        SKR_LOG_WARN(u8"[CookCache] failed to hash cook inputs! asset path: %s", record->path.u8string().c_str());
+        return;
+    }
+
+    std::error_code ec        = {};
+    const auto      objectDir = cacheDir / "objects" / CookCacheKeyName(content);
+    if (!skr::filesystem::is_regular_file(objectDir / "manifest.json", ec))
+    {
+        // builders sharing the cache may store the same entry at once, entries are staged then renamed into place
+        const auto guidName   = skr::format(u8"{}", record->guid);
+        const auto stagingDir = cacheDir / "staging" / (CookCacheKeyName(content).string() + "-" + guidName.c_str());
+        skr::filesystem::remove_all(stagingDir, ec);
+        SKR_DEFER({ std::error_code cleanup = {}; skr::filesystem::remove_all(stagingDir, cleanup); });
+
+        const auto outputDir  = project->GetOutputPath();
+        auto       headerPath = ctx->GetOutputPath();
+        headerPath.replace_extension("rh");
+        skr::Vector<skr::filesystem::path> outputs;
+        outputs.add(ctx->GetOutputPath());
+        outputs.add(headerPath);
+        for (const auto& output : ctx->GetOutputFiles())
+            outputs.add(output);
+
+        skr::archive::JsonWriter writer(2);
+        writer.StartObject();
+        writer.Key(u8"cookTime");
+        writer.UInt64(time);
+        writer.Key(u8"files");
+        writer.StartArray();
+        for (const auto& output : outputs)
+        {
+            const auto relative = output.lexically_relative(outputDir).generic_string();
+            if (relative.empty() || relative.rfind("..", 0) == 0)
+            {
+                SKR_LOG_WARN(u8"[CookCache] output %s is outside of the resource directory! asset path: %s", output.u8string().c_str(), record->path.u8string().c_str());
+                return;
+            }
+            if (!CookCacheCopyFile(output, stagingDir / relative))
+            {
+                SKR_LOG_WARN(u8"[CookCache] failed to stage output %s! asset path: %s", output.u8string().c_str(), record->path.u8string().c_str());
+                return;
+            }
+            skr::json_write<skr::StringView>(&writer, { (const char8_t*)relative.data(), relative.size() });
+        }
+        writer.EndArray();
+        writer.EndObject();
+        {
+            const auto manifestPath = (stagingDir / "manifest.json").string();
+            auto       file         = fopen(manifestPath.c_str(), "wb");
+            if (!file)
+                return;
+            SKR_DEFER({ fclose(file); });
+            auto jString = writer.Write();
+            fwrite(jString.raw().data(), 1, jString.raw().size(), file);
+        }
+        skr::filesystem::create_directories(objectDir.parent_path(), ec);
+        // losing the race to another builder leaves its identical entry in place
+        skr::filesystem::rename(stagingDir, objectDir, ec);
+    }
+
+    // restores read the recipe while other builders may rewrite it, it is staged then renamed into place as well
+    auto recipePath = cacheDir / "recipes" / CookCacheKeyName(recipe);
+    recipePath.replace_extension("d");
+    const auto stagingName    = skr::format(u8"-{}-{}.d", record->guid, skr_get_current_process_id());
+    const auto stagingPath    = cacheDir / "staging" / (CookCacheKeyName(recipe).string() + stagingName.c_str());
+    const auto dependencyPath = project->GetDependencyPath() / skr::format(u8"{}.d", record->guid).u8_str();
+    if (!CookCacheCopyFile(dependencyPath, stagingPath))
+        return;
+    skr::filesystem::create_directories(recipePath.parent_path(), ec);
+    skr::filesystem::rename(stagingPath, recipePath, ec);
+    if (ec)
+    {
+        SKR_LOG_WARN(u8"[CookCache] failed to store recipe %s! asset path: %s", recipePath.u8string().c_str(), record->path.u8string().c_str());
+        skr::filesystem::remove(stagingPath, ec);
+        return;
+    }
+    stores++;
+}
+
+SCookCacheStatistics SCookCache::GetStatistics() const
+{
+    SCookCacheStatistics result;
+    result.hits          = hits;
+    result.misses        = misses;
+    result.stores        = stores;
+    result.restoredBytes = restoredBytes;
+    result.savedTime     = savedTime;
+    result.cookTime      = cookTime;
+    return result;
+}
+} // namespace skd::asset
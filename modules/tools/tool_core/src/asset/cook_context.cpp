@@ -22,6 +22,8 @@ struct SCookContextImpl : public SCookContext
     skr::filesystem::path AddSourceFile(const skr::filesystem::path& path) override;
     skr::filesystem::path AddSourceFileAndLoad(skr_io_ram_service_t* ioService, const skr::filesystem::path& path, skr::BlobId& destination) override;
     skr::span<const skr::filesystem::path> GetSourceFiles() const override;
+    void AddOutputFile(const skr::filesystem::path& path) override;
+    skr::Vector<skr::filesystem::path> GetOutputFiles() const override;
 
     void AddRuntimeDependency(skr_guid_t resource) override;
     void AddSoftRuntimeDependency(skr_guid_t resource) override;
@@ -67,11 +69,18 @@ struct SCookContextImpl : public SCookContext
     skr::Vector<skr_resource_handle_t> staticDependencies;
     skr::Vector<skr_guid_t> runtimeDependencies;
     skr::Vector<skr::filesystem::path> fileDependencies;
+    mutable SMutex outputFilesMutex;
+    skr::Vector<skr::filesystem::path> outputFiles;
 
     SCookContextImpl(skr_io_ram_service_t* ioService)
         : ioService(ioService)
     {
+        skr_init_mutex(&outputFilesMutex);
+    }
 
+    ~SCookContextImpl()
+    {
+        skr_destroy_mutex(&outputFilesMutex);
     }
 };
 
@@ -101,7 +110,7 @@ void* SCookContextImpl::_Import()
 {
     SkrZoneScoped;
     //-----load importer
-    skr::archive::JsonReader reader(record->meta.view());
+    skr::archive::JsonReader reader(record->meta.view(), true);
     reader.StartObject();
     SKR_DEFER({ reader.EndObject(); });
     if (auto jread_result = reader.Key(u8"importer"); jread_result.has_value())
@@ -208,6 +217,18 @@ skr::span<const skr::filesystem::path> SCookContextImpl::GetSourceFiles() const
     return fileDependencies;
 }
 
+void SCookContextImpl::AddOutputFile(const skr::filesystem::path& path)
+{
+    SMutexLock lock(outputFilesMutex);
+    outputFiles.add(path);
+}
+
+skr::Vector<skr::filesystem::path> SCookContextImpl::GetOutputFiles() const
+{
+    SMutexLock lock(outputFilesMutex);
+    return outputFiles;
+}
+
 void SCookContextImpl::AddRuntimeDependency(skr_guid_t resource)
 {
     auto iter = std::find_if(runtimeDependencies.begin(), runtimeDependencies.end(), [&](const auto &dep) { return dep == resource; });
@@ -0,0 +1,393 @@
+#include "SkrBase/misc/defer.hpp"
+#include "SkrBase/misc/hash.h"
+#include "SkrCore/log.hpp"
+#include "SkrProfile/profile.h"
+#include "SkrSerde/json_serde.hpp"
+#include "SkrToolCore/asset/cook_dependency_db.hpp"
+#include "SkrToolCore/asset/cook_system.hpp"
+#include <string.h>
+
+namespace skd::asset
+{
+static constexpr uint32_t kCookDependencyDBMagic   = 0x44434B53; // SKCD
+static constexpr uint32_t kCookDependencyDBVersion = 1;
+// a record takes a few hundred bytes & edges, room for a few 100k assets
+static constexpr uint64_t kCookDependencyDBMapSize = 256ull * 1024 * 1024;
+
+// records are raw structs followed by the guids & the length prefixed file paths
+struct CookDependencyRecordHeader {
+    uint32_t magic;
+    uint32_t version;
+    int64_t  stamp;
+    uint64_t importerVersion;
+    uint64_t cookerVersion;
+    uint32_t fileCount;
+    uint32_t staticCount;
+    uint32_t runtimeCount;
+    uint32_t padding;
+};
+
+// reverse edges are {dependency key}{user guid} -> empty, users of a dependency are found with a prefix scan
+struct CookDependencyEdgeKey {
+    uint8_t data[sizeof(skr_guid_t) * 2];
+    uint8_t size = 0;
+
+    CookDependencyEdgeKey(const void* prefix, uint8_t prefixSize, const skr_guid_t* user)
+    {
+        memcpy(data, prefix, prefixSize);
+        size = prefixSize;
+        if (user)
+        {
+            memcpy(data + size, user, sizeof(skr_guid_t));
+            size += sizeof(skr_guid_t);
+        }
+    }
+    SLightningStorageValue Value() const { return { size, data }; }
+};
+
+// paths may exceed the LMDB key limit, a collision only recooks a few more assets
+static uint64_t CookDependencyFileKey(const skr::String& path)
+{
+    return skr_hash64(path.raw().data(), path.raw().size(), 0);
+}
+
+static int64_t CookDependencyFileStamp(const skr::filesystem::path& path)
+{
+    std::error_code ec    = {};
+    const auto      stamp = skr::filesystem::last_write_time(path, ec);
+    return ec ? 0 : (int64_t)stamp.time_since_epoch().count();
+}
+
+static void WriteCookDependencyRecord(skr::Vector<uint8_t>& buffer, int64_t stamp, const SCookDependencyRecord& record)
+{
+    CookDependencyRecordHeader header;
+    header.magic           = kCookDependencyDBMagic;
+    header.version         = kCookDependencyDBVersion;
+    header.stamp           = stamp;
+    header.importerVersion = record.importerVersion;
+    header.cookerVersion   = record.cookerVersion;
+    header.fileCount       = (uint32_t)record.files.size();
+    header.staticCount     = (uint32_t)record.staticDependencies.size();
+    header.runtimeCount    = (uint32_t)record.runtimeDependencies.size();
+    header.padding         = 0;
+    buffer.append((const uint8_t*)&header, sizeof(header));
+    buffer.append((const uint8_t*)record.staticDependencies.data(), record.staticDependencies.size() * sizeof(skr_guid_t));
+    buffer.append((const uint8_t*)record.runtimeDependencies.data(), record.runtimeDependencies.size() * sizeof(skr_guid_t));
+    for (const auto& file : record.files)
+    {
+        const uint32_t length = (uint32_t)file.raw().size();
+        buffer.append((const uint8_t*)&length, sizeof(length));
+        buffer.append((const uint8_t*)file.raw().data(), length);
+    }
+}
+
+static bool ReadCookDependencyRecord(SLightningStorageValue value, int64_t& stamp, SCookDependencyRecord& record)
+{
+    auto       cursor = (const uint8_t*)value.data;
+    const auto end    = cursor + value.size;
+    if (value.size < sizeof(CookDependencyRecordHeader))
+        return false;
+    CookDependencyRecordHeader header;
+    memcpy(&header, cursor, sizeof(header));
+    cursor += sizeof(header);
+    if (header.magic != kCookDependencyDBMagic || header.version != kCookDependencyDBVersion)
+        return false;
+    const uint64_t guidsSize = ((uint64_t)header.staticCount + header.runtimeCount) * sizeof(skr_guid_t);
+    if ((uint64_t)(end - cursor) < guidsSize)
+        return false;
+    stamp                  = header.stamp;
+    record.importerVersion = header.importerVersion;
+    record.cookerVersion   = header.cookerVersion;
+    record.staticDependencies.resize_unsafe(header.staticCount);
+    memcpy(record.staticDependencies.data(), cursor, header.staticCount * sizeof(skr_guid_t));
+    cursor += header.staticCount * sizeof(skr_guid_t);
+    record.runtimeDependencies.resize_unsafe(header.runtimeCount);
+    memcpy(record.runtimeDependencies.data(), cursor, header.runtimeCount * sizeof(skr_guid_t));
+    cursor += header.runtimeCount * sizeof(skr_guid_t);
+    record.files.clear();
+    record.files.reserve(header.fileCount);
+    for (uint32_t i = 0; i < header.fileCount; ++i)
+    {
+        uint32_t length = 0;
+        if ((uint64_t)(end - cursor) < sizeof(length))
+            return false;
+        memcpy(&length, cursor, sizeof(length));
+        cursor += sizeof(length);
+        if ((uint64_t)(end - cursor) < length)
+            return false;
+        record.files.add(skr::String(skr::StringView((const char8_t*)cursor, length)));
+        cursor += length;
+    }
+    return true;
+}
+
+static bool ParseCookDependencyFile(const SAssetRecord* asset, const skr::filesystem::path& dependencyFile, SCookDependencyRecord& record)
+{
+    skr::String content;
+    {
+        auto file = fopen(dependencyFile.string().c_str(), "rb");
+        if (!file)
+            return false;
+        SKR_DEFER({ fclose(file); });
+        fseek(file, 0, SEEK_END);
+        const auto fileSize = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (fileSize <= 0)
+            return false;
+        content.append(u8'0', fileSize);
+        if (fread(content.raw().data(), 1, fileSize, file) != (size_t)fileSize)
+            return false;
+    }
+    skr::archive::JsonReader reader(content.view());
+    if (!reader.StartObject().has_value())
+        return false;
+    SKR_DEFER({ reader.EndObject(); });
+    if (!reader.Key(u8"importerVersion").has_value() || !reader.UInt64(record.importerVersion).has_value())
+        return false;
+    if (!reader.Key(u8"cookerVersion").has_value() || !reader.UInt64(record.cookerVersion).has_value())
+        return false;
+    // source files are written relative to the meta file
+    {
+        size_t count = 0;
+        if (!reader.Key(u8"files").has_value() || !reader.StartArray(count).has_value())
+            return false;
+        record.files.clear();
+        record.files.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            skr::String pathStr;
+            if (!skr::json_read(&reader, pathStr))
+                return false;
+            const auto path = (asset->path.parent_path() / pathStr.c_str()).lexically_normal();
+            record.files.add(skr::String(path.u8string().c_str()));
+        }
+        reader.EndArray();
+    }
+    auto readGuids = [&](const char8_t* key, skr::Vector<skr_guid_t>& guids, bool optional) {
+        size_t count = 0;
+        guids.clear();
+        if (!reader.Key(key).has_value())
+            return optional;
+        if (!reader.StartArray(count).has_value())
+            return false;
+        guids.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!skr::json_read(&reader, guids.add_default().ref()))
+                return false;
+        }
+        reader.EndArray();
+        return true;
+    };
+    // runtime dependencies were not recorded by older cooks
+    return readGuids(u8"dependencies", record.staticDependencies, false) && readGuids(u8"runtimeDependencies", record.runtimeDependencies, true);
+}
+
+SCookDependencyDB* SCookDependencyDB::Open(const skr::filesystem::path& path)
+{
+    SkrZoneScopedN("CookDependencyDB::Open");
+    auto db        = SkrNew<SCookDependencyDB>();
+    const auto u8Path = path.u8string();
+    db->env        = skr_lightning_environment_create(u8Path.c_str());
+    skr_lightning_environment_set_map_size(db->env, kCookDependencyDBMapSize);
+    skr_init_mutex(&db->pendingMutex);
+
+    SLightningStorageOpenDescriptor desc = {};
+    desc.flags                           = LIGHTNING_STORAGE_OPEN_CREATE;
+    desc.name                            = u8"assets";
+    db->assets                           = skr_lightning_storage_open(db->env, &desc);
+    desc.name                            = u8"file_users";
+    db->fileUsers                        = skr_lightning_storage_open(db->env, &desc);
+    desc.name                            = u8"static_users";
+    db->staticUsers                      = skr_lightning_storage_open(db->env, &desc);
+    desc.name                            = u8"runtime_users";
+    db->runtimeUsers                     = skr_lightning_storage_open(db->env, &desc);
+    return db;
+}
+
+void SCookDependencyDB::Close(SCookDependencyDB* db)
+{
+    if (!db)
+        return;
+    db->Flush();
+    skr_lightning_storage_close(db->assets);
+    skr_lightning_storage_close(db->fileUsers);
+    skr_lightning_storage_close(db->staticUsers);
+    skr_lightning_storage_close(db->runtimeUsers);
+    skr_lightning_environment_free(db->env);
+    skr_destroy_mutex(&db->pendingMutex);
+    SkrDelete(db);
+}
+
+bool SCookDependencyDB::Load(const SAssetRecord* asset, const skr::filesystem::path& dependencyFile, SCookDependencyRecord& record)
+{
+    const int64_t stamp = CookDependencyFileStamp(dependencyFile);
+    if (stamp == 0)
+        return false;
+    {
+        SMutexLock lock(pendingMutex);
+        auto       it = pending.find(asset->guid);
+        if (it != pending.end() && it->second.stamp == stamp)
+        {
+            record = it->second.record;
+            return true;
+        }
+    }
+    if (auto txn = skr_lightning_transaction_open(env, nullptr, LIGHTNING_TRANSACATION_OPEN_READ_ONLY))
+    {
+        SKR_DEFER({ skr_lightning_transaction_abort(txn); });
+        const SLightningStorageValue key       = { sizeof(skr_guid_t), &asset->guid };
+        SLightningStorageValue       value     = { 0, nullptr };
+        int64_t                      lastStamp = 0;
+        if (skr_lightning_storage_read(txn, assets, &key, &value) && ReadCookDependencyRecord(value, lastStamp, record) && lastStamp == stamp)
+            return true;
+    }
+    if (!ParseCookDependencyFile(asset, dependencyFile, record))
+        return false;
+    Update(asset->guid, dependencyFile, record);
+    return true;
+}
+
+void SCookDependencyDB::Update(skr_guid_t asset, const skr::filesystem::path& dependencyFile, const SCookDependencyRecord& record)
+{
+    SMutexLock lock(pendingMutex);
+    auto&      entry = pending[asset];
+    entry.stamp      = CookDependencyFileStamp(dependencyFile);
+    entry.record     = record;
+}
+
+void SCookDependencyDB::Flush()
+{
+    SkrZoneScopedN("CookDependencyDB::Flush");
+    SMutexLock lock(pendingMutex);
+    if (pending.empty())
+        return;
+    auto txn = skr_lightning_transaction_open(env, nullptr, LIGHTNING_TRANSACATION_OPEN_READ_WRITE);
+    if (!txn)
+        return;
+    static constexpr uint8_t     kEmpty    = 0;
+    const SLightningStorageValue edgeValue = { 0, &kEmpty };
+    auto                         editEdges = [&](SLightningStorageId storage, const skr::Vector<skr_guid_t>& from, const skr::Vector<skr_guid_t>& to, const skr_guid_t& user) {
+        for (const auto& dep : from)
+        {
+            if (!to.contains(dep))
+            {
+                const CookDependencyEdgeKey key(&dep, sizeof(dep), &user);
+                const auto                  k = key.Value();
+                skr_lightning_storage_del(txn, storage, &k);
+            }
+        }
+        for (const auto& dep : to)
+        {
+            if (!from.contains(dep))
+            {
+                const CookDependencyEdgeKey key(&dep, sizeof(dep), &user);
+                const auto                  k = key.Value();
+                skr_lightning_storage_write(txn, storage, &k, &edgeValue);
+            }
+        }
+    };
+    auto fileKeys = [](const skr::Vector<skr::String>& files) {
+        skr::Vector<skr_guid_t> keys;
+        keys.reserve(files.size());
+        for (const auto& file : files)
+        {
+            // the hash goes in the first half of a zeroed guid so both edge kinds share the code
+            skr_guid_t     guid = {};
+            const uint64_t hash = CookDependencyFileKey(file);
+            memcpy(&guid, &hash, sizeof(hash));
+            keys.add(guid);
+        }
+        return keys;
+    };
+    bool                 succeed = true;
+    skr::Vector<uint8_t> buffer;
+    for (auto& [guid, entry] : pending)
+    {
+        const SLightningStorageValue key      = { sizeof(skr_guid_t), &guid };
+        SLightningStorageValue       value    = { 0, nullptr };
+        SCookDependencyRecord        previous = {};
+        int64_t                      lastStamp = 0;
+        if (skr_lightning_storage_read(txn, assets, &key, &value))
+            ReadCookDependencyRecord(value, lastStamp, previous);
+        editEdges(fileUsers, fileKeys(previous.files), fileKeys(entry.record.files), guid);
+        editEdges(staticUsers, previous.staticDependencies, entry.record.staticDependencies, guid);
+        editEdges(runtimeUsers, previous.runtimeDependencies, entry.record.runtimeDependencies, guid);
+        buffer.clear();
+        WriteCookDependencyRecord(buffer, entry.stamp, entry.record);
+        const SLightningStorageValue recordValue = { buffer.size(), buffer.data() };
+        succeed &= skr_lightning_storage_write(txn, assets, &key, &recordValue);
+    }
+    if (!succeed)
+    {
+        SKR_LOG_WARN(u8"[SCookDependencyDB] failed to write %llu dependency records, they are read from .d files next time.", (unsigned long long)pending.size());
+        skr_lightning_transaction_abort(txn);
+    }
+    else
+    {
+        skr_lightning_transaction_commit(txn);
+    }
+    pending.clear();
+}
+
+struct CookDependencyScan {
+    skr::Vector<skr_guid_t>* users;
+    uint64_t                 prefixSize;
+
+    static bool Visit(void* userdata, const SLightningStorageValue* key, const SLightningStorageValue*)
+    {
+        auto scan = (CookDependencyScan*)userdata;
+        if (key->size == scan->prefixSize + sizeof(skr_guid_t))
+            memcpy(&scan->users->add_default().ref(), (const uint8_t*)key->data + scan->prefixSize, sizeof(skr_guid_t));
+        return true;
+    }
+};
+
+static void ScanCookDependencyUsers(SLightningTXNId txn, SLightningStorageId storage, const void* prefix, uint8_t prefixSize, skr::Vector<skr_guid_t>& users)
+{
+    const CookDependencyEdgeKey  key(prefix, prefixSize, nullptr);
+    const SLightningStorageValue k    = key.Value();
+    CookDependencyScan           scan = { &users, prefixSize };
+    skr_lightning_storage_scan(txn, storage, &k, &CookDependencyScan::Visit, &scan);
+}
+
+void SCookDependencyDB::CollectRecooks(skr::span<const skr::filesystem::path> changedFiles, skr::span<const skr_guid_t> changedAssets, skr::Vector<skr_guid_t>& recooks)
+{
+    SkrZoneScopedN("CookDependencyDB::CollectRecooks");
+    Flush();
+    auto txn = skr_lightning_transaction_open(env, nullptr, LIGHTNING_TRANSACATION_OPEN_READ_ONLY);
+    if (!txn)
+        return;
+    SKR_DEFER({ skr_lightning_transaction_abort(txn); });
+    skr::FlatHashSet<skr_guid_t, skr::Hash<skr_guid_t>> visited;
+    skr::Vector<skr_guid_t>                             queue;
+    for (const auto& file : changedFiles)
+    {
+        const skr::String path = file.lexically_normal().u8string().c_str();
+        const uint64_t    hash = CookDependencyFileKey(path);
+        skr_guid_t        guid = {};
+        memcpy(&guid, &hash, sizeof(hash));
+        ScanCookDependencyUsers(txn, fileUsers, &guid, sizeof(guid), queue);
+    }
+    queue.append(changedAssets.data(), changedAssets.size());
+    // static dependents of a recooked asset load its new output, they recook too
+    for (uint64_t i = 0; i < queue.size(); ++i)
+    {
+        const skr_guid_t guid = queue[i];
+        if (!visited.insert(guid).second)
+            continue;
+        recooks.add(guid);
+        ScanCookDependencyUsers(txn, staticUsers, &guid, sizeof(guid), queue);
+    }
+}
+
+void SCookDependencyDB::CollectRuntimeUsers(skr_guid_t resource, skr::Vector<skr_guid_t>& users)
+{
+    Flush();
+    auto txn = skr_lightning_transaction_open(env, nullptr, LIGHTNING_TRANSACATION_OPEN_READ_ONLY);
+    if (!txn)
+        return;
+    SKR_DEFER({ skr_lightning_transaction_abort(txn); });
+    ScanCookDependencyUsers(txn, runtimeUsers, &resource, sizeof(resource), users);
+}
+} // namespace skd::asset
@@ -5,11 +5,13 @@
 #include "SkrTask/parallel_for.hpp"
 #include "SkrContainers/string.hpp"
 #include "SkrCore/module/module.hpp"
+#include "SkrCore/time.h"
 #include "SkrCore/async/thread_job.hpp"
 #include "SkrSerde/bin_serde.hpp"
 #include "SkrSerde/json_serde.hpp"
 #include "SkrRT/io/ram_io.hpp"
 #include "SkrToolCore/asset/cook_system.hpp"
+#include "SkrToolCore/asset/cook_dependency_db.hpp"
 #include "SkrToolCore/asset/importer.hpp"
 #include "SkrToolCore/project/project.hpp"
 
@@ -19,6 +21,7 @@ struct SCookSystemImpl : public skd::asset::SCookSystem {
     friend struct ::SkrToolCoreModule;
     using AssetMap   = skr::ParallelFlatHashMap<skr_guid_t, SAssetRecord*, skr::Hash<skr_guid_t>>;
     using CookingMap = skr::ParallelFlatHashMap<skr_guid_t, SCookContext*, skr::Hash<skr_guid_t>>;
+    using ResultMap  = skr::ParallelFlatHashMap<skr_guid_t, bool, skr::Hash<skr_guid_t>>;
 
     skr::task::event_t AddCookTask(skr_guid_t resource) override;
     skr::task::event_t EnsureCooked(skr_guid_t resource) override;
@@ -47,6 +50,16 @@ struct SCookSystemImpl : public skd::asset::SCookSystem {
     }
 
     SAssetRecord*         LoadAssetMeta(SProject* project, const skr::String& uri) override;
+    SCookCacheStatistics  GetCacheStatistics() const override { return cache.GetStatistics(); }
+    SImportCache*         GetImportCache() override { return &importCache; }
+    bool                  HasCookFailed(skr_guid_t guid) const override
+    {
+        bool failed = false;
+        results.if_contains(guid, [&](const auto& result_kv) { failed = !result_kv.second; });
+        return failed;
+    }
+    void SetWorkerPool(SCookWorkerPool* pool) override { workerPool = pool; }
+    void SetWorkerClient(SCookWorkerClient* client) override { workerClient = client; }
     skr_io_ram_service_t* getIOService() override;
 
     template <class F, class Iter>
@@ -69,9 +82,15 @@ struct SCookSystemImpl : public skd::asset::SCookSystem {
     }
 
 protected:
-    AssetMap   assets;
-    CookingMap cooking;
-    SMutex     ioMutex;
+    AssetMap     assets;
+    CookingMap   cooking;
+    ResultMap    results;
+    SMutex       ioMutex;
+    SCookCache   cache;
+    SImportCache importCache;
+
+    SCookWorkerPool*   workerPool   = nullptr;
+    SCookWorkerClient* workerClient = nullptr;
 
     skr::task::counter_t mainCounter;
 
@@ -97,6 +116,7 @@ void RegisterCookerToSystem(SCookSystem* system, bool isDefault, skr_guid_t cook
 void SCookSystemImpl::WaitForAll()
 {
     mainCounter.wait(true);
+    importCache.Flush();
 }
 
 bool SCookSystemImpl::AllCompleted() const
@@ -162,9 +182,39 @@ skr::task::event_t SCookSystemImpl::AddCookTask(skr_guid_t guid)
         cookContext->SetOutputPath(outputPath / skr::format(u8"{}.bin", metaAsset->guid).c_str());
         cookContext->SetCookerVersion(cooker->Version());
         // SKR_ASSERT(iter != system->cookers.end()); // TODO: error handling
+        bool cooked = false;
+        SKR_DEFER({ system->results.insert_or_assign(metaAsset->guid, cooked); });
+        if (auto client = system->workerClient)
+        {
+            // the parent already looked into the cache for the job, everything else is its business
+            if (!client->IsJob(metaAsset->guid))
+            {
+                cooked = client->RequestDependency(metaAsset->guid);
+                return;
+            }
+        }
+        else
+        {
+            if (system->cache.Restore(metaAsset, cooker))
+            {
+                cooked = true;
+                return;
+            }
+            if (auto pool = system->workerPool)
+            {
+                const auto result = pool->Cook(metaAsset);
+                if (result != ECookWorkerResult::CookLocally)
+                {
+                    cooked = result == ECookWorkerResult::Succeeded;
+                    return;
+                }
+            }
+        }
         SKR_LOG_INFO(u8"[CookTask] resource %s cook started!", metaAsset->path.u8string().c_str());
+        const auto cookStart = skr_sys_get_usec(true);
         if (cooker->Cook(cookContext))
         {
+            const auto cookTime = (uint64_t)(skr_sys_get_usec(true) - cookStart);
             // write resource header
             {
                 SKR_LOG_INFO(u8"[CookTask] resource %s cook finished! updating resource metas.", metaAsset->path.u8string().c_str());
@@ -207,6 +257,11 @@ skr::task::event_t SCookSystemImpl::AddCookTask(skr_guid_t guid)
                 for (auto& dep : cookContext->GetStaticDependencies())
                     skr::json_write<skr_resource_handle_t>(&writer, dep);
                 writer.EndArray();
+                writer.Key(u8"runtimeDependencies");
+                writer.StartArray();
+                for (auto& dep : cookContext->GetRuntimeDependencies())
+                    skr::json_write<skr_guid_t>(&writer, dep);
+                writer.EndArray();
                 writer.EndObject();
                 auto file = fopen(dependencyPath.string().c_str(), "w");
                 if (!file)
@@ -214,10 +269,28 @@ skr::task::event_t SCookSystemImpl::AddCookTask(skr_guid_t guid)
                     SKR_LOG_ERROR(u8"[CookTask] failed to write dependency file for resource %s!", metaAsset->path.u8string().c_str());
                     return;
                 }
-                SKR_DEFER({ fclose(file); });
+                SKR_DEFER({ if (file) fclose(file); });
                 auto jString = writer.Write();
                 fwrite(jString.raw().data(), 1, jString.raw().size(), file);
+                fclose(file);
+                file = nullptr;
+                // index the new edges, stamped with the .d file just written
+                SCookDependencyRecord record;
+                record.importerVersion = cookContext->GetImporterVersion();
+                record.cookerVersion   = cookContext->GetCookerVersion();
+                for (auto& source_path : cookContext->GetSourceFiles())
+                {
+                    const auto path = (metaAsset->path.parent_path() / source_path).lexically_normal();
+                    record.files.add(skr::String(path.u8string().c_str()));
+                }
+                for (auto& dep : cookContext->GetStaticDependencies())
+                    record.staticDependencies.add(dep.get_serialized());
+                for (auto& dep : cookContext->GetRuntimeDependencies())
+                    record.runtimeDependencies.add(dep);
+                metaAsset->project->GetDependencyDB()->Update(metaAsset->guid, dependencyPath, record);
             }
+            system->cache.Store(cookContext, cookTime);
+            cooked = true;
         }
     },
                         &counter, guidName.c_str());
@@ -266,6 +339,9 @@ skr::task::event_t SCookSystemImpl::EnsureCooked(skr_guid_t guid)
         SKR_LOG_ERROR(u8"[SCookSystemImpl::EnsureCooked] resource not exist! asset path: %s", metaAsset->path.u8string().c_str());
         return nullptr;
     }
+    // outputs of other assets may be half written by another worker, only the parent can tell
+    if (workerClient && !workerClient->IsJob(guid))
+        return AddCookTask(guid);
     auto resourcePath   = metaAsset->project->GetOutputPath() / skr::format(u8"{}.bin", metaAsset->guid).u8_str();
     auto dependencyPath = metaAsset->project->GetDependencyPath() / skr::format(u8"{}.d", metaAsset->guid).u8_str();
     auto checkUpToDate  = [&]() -> bool {
@@ -292,27 +368,15 @@ skr::task::event_t SCookSystemImpl::EnsureCooked(skr_guid_t guid)
             SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] meta file modified! resource path: %s", metaAsset->path.u8string().c_str());
             return false;
         }
-        // TODO: refactor this
-        skr::String depFileContent;
+        SCookDependencyRecord dependencies;
+        if (!metaAsset->project->GetDependencyDB()->Load(metaAsset, dependencyPath, dependencies))
         {
-            auto dependencyFile = fopen(dependencyPath.string().c_str(), "rb");
-            if (!dependencyFile)
-            {
-                SKR_LOG_ERROR(u8"Failed to open dependency file: %s", dependencyPath.string().c_str());
-                return false;
-            }
-            fseek(dependencyFile, 0, SEEK_END);
-            auto fileSize = ftell(dependencyFile);
-            fseek(dependencyFile, 0, SEEK_SET);
-            depFileContent.append(u8'0', fileSize);
-            fread(depFileContent.raw().data(), 1, fileSize, dependencyFile);
-            fclose(dependencyFile);
+            SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] dependency file parse failed! asset path: %s", dependencyPath.string().c_str());
+            return false;
         }
-        skr::archive::JsonReader depReader(depFileContent.view());
         skr::archive::JsonReader metaReader(metaAsset->meta.view());
-        depReader.StartObject();
         metaReader.StartObject();
-        SKR_DEFER({ depReader.EndObject(); metaReader.EndObject(); });
+        SKR_DEFER({ metaReader.EndObject(); });
         skr_guid_t importerTypeGuid;
         {
             metaReader.Key(u8"importer");
@@ -325,13 +389,8 @@ skr::task::event_t SCookSystemImpl::EnsureCooked(skr_guid_t guid)
             }
             metaReader.EndObject();
         }
-        uint64_t importerVersion;
-        {
-            depReader.Key(u8"importerVersion");
-            depReader.UInt64(importerVersion);
-        }
         auto currentImporterVersion = GetImporterRegistry()->GetImporterVersion(importerTypeGuid);
-        if (importerVersion != currentImporterVersion)
+        if (dependencies.importerVersion != currentImporterVersion)
         {
             SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] importer version changed! asset path: %s", metaAsset->path.u8string().c_str());
             return false;
@@ -341,82 +400,51 @@ skr::task::event_t SCookSystemImpl::EnsureCooked(skr_guid_t guid)
             SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] dev importer version (UINT32_MAX)! asset path: %s", metaAsset->path.u8string().c_str());
             return false;
         }
+        // the .d file records the cooker version, the resource header does not need to be opened
+        if (cooker->Version() == UINT32_MAX)
         {
-            if (cooker->Version() == UINT32_MAX)
-            {
-                SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] dev cooker version (UINT32_MAX)! asset path: %s", metaAsset->path.u8string().c_str());
-                return false;
-            }
-            auto resourceFile = fopen(resourcePath.string().c_str(), "rb");
-            SKR_DEFER({ fclose(resourceFile); });
-            uint8_t buffer[sizeof(skr_resource_header_t)];
-            fread(buffer, 0, sizeof(skr_resource_header_t), resourceFile);
-            skr::archive::BinSpanReader reader = { buffer };
-            SBinaryReader               archive{ reader };
-            skr_resource_header_t       header;
-            if (header.ReadWithoutDeps(&archive) != 0)
+            SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] dev cooker version (UINT32_MAX)! asset path: %s", metaAsset->path.u8string().c_str());
+            return false;
+        }
+        if (dependencies.cookerVersion != cooker->Version())
+        {
+            SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] cooker version changed! asset path: %s", metaAsset->path.u8string().c_str());
+            return false;
+        }
+        // analyze dep files
+        for (const auto& file : dependencies.files)
+        {
+            skr::filesystem::path path(file.c_str());
+            if (!skr::filesystem::exists(path, ec))
             {
-                SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] resource header read failed! asset path: %s", metaAsset->path.u8string().c_str());
+                SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] file not exist! asset path: %s", metaAsset->path.u8string().c_str());
                 return false;
             }
-            if (header.version != cooker->Version())
+            if (skr::filesystem::last_write_time(path, ec) > timestamp)
             {
-                SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] cooker version changed! asset path: %s", metaAsset->path.u8string().c_str());
+                SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] file modified! asset path: %s", metaAsset->path.u8string().c_str());
                 return false;
             }
         }
-        // analyze dep files
+        // analyze dependencies
+        for (const auto& depGuid : dependencies.staticDependencies)
         {
-            size_t filesSize = 0;
-            depReader.Key(u8"files");
-            depReader.StartArray(filesSize);
-            for (size_t i = 0; i < filesSize; i++)
+            auto record = GetAssetRecord(depGuid);
+            if (!record)
             {
-                skr::String pathStr;
-                skr::json_read(&depReader, pathStr);
-                skr::filesystem::path path(pathStr.c_str());
-                path               = metaAsset->path.parent_path() / (path);
-                std::error_code ec = {};
-                if (!skr::filesystem::exists(path, ec))
-                {
-                    SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] file not exist! asset path: %s", metaAsset->path.u8string().c_str());
-                    return false;
-                }
-                if (skr::filesystem::last_write_time(path, ec) > timestamp)
-                {
-                    SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] file modified! asset path: %s", metaAsset->path.u8string().c_str());
-                    return false;
-                }
+                SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] dependency file not exist! asset path: %s", metaAsset->path.u8string().c_str());
+                return false;
             }
-            depReader.EndArray();
-        }
-        // analyze dependencies
-        {
-            size_t depsSize = 0;
-            depReader.Key(u8"dependencies");
-            depReader.StartArray(depsSize);
-            for (size_t i = 0; i < depsSize; i++)
+            if (record->type == skr_guid_t{})
             {
-                skr_guid_t depGuid;
-                skr::json_read(&depReader, depGuid);
-                auto record = GetAssetRecord(depGuid);
-                if (!record)
+                if (skr::filesystem::last_write_time(record->path, ec) > timestamp)
                 {
-                    SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] dependency file not exist! asset path: %s", metaAsset->path.u8string().c_str());
+                    SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] dependency file %s modified! asset path: %s", record->path.u8string().c_str(), metaAsset->path.u8string().c_str());
                     return false;
                 }
-                if (record->type == skr_guid_t{})
-                {
-                    if (skr::filesystem::last_write_time(record->path, ec) > timestamp)
-                    {
-                        SKR_LOG_INFO(u8"[SCookSystemImpl::EnsureCooked] dependency file %s modified! asset path: %s", record->path.u8string().c_str(), metaAsset->path.u8string().c_str());
-                        return false;
-                    }
-                }
-                else if (EnsureCooked(depGuid))
-                    return false;
             }
-            depReader.EndArray();
+            else if (EnsureCooked(depGuid))
+                return false;
         }
 
         return true;
@@ -0,0 +1,572 @@
+#include "SkrBase/misc/defer.hpp"
+#include "SkrCore/log.hpp"
+#include "SkrCore/process.h"
+#include "SkrCore/time.h"
+#include "SkrOS/thread.h"
+#include "SkrLightningStorage/mdb.h"
+#include "SkrTask/fib_task.hpp"
+#include "SkrToolCore/asset/cook_system.hpp"
+#include "SkrToolCore/asset/cook_worker.hpp"
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+
+namespace skd::asset
+{
+// records are raw structs, the board is only shared by processes of the same build
+struct CookWorkerMessage {
+    uint64_t   seq     = 0;
+    skr_guid_t guid    = {};
+    uint32_t   status  = 0;
+    uint32_t   padding = 0;
+    uint64_t   time    = 0;
+};
+
+enum ECookWorkerJob : uint32_t
+{
+    COOK_WORKER_JOB_IDLE = 0,
+    COOK_WORKER_JOB_COOK = 1,
+    COOK_WORKER_JOB_QUIT = 2
+};
+
+enum ECookWorkerStatus : uint32_t
+{
+    COOK_WORKER_STATUS_STARTED   = 1,
+    COOK_WORKER_STATUS_SUCCEEDED = 2,
+    COOK_WORKER_STATUS_FAILED    = 3
+};
+
+struct CookWorkerBoard {
+    void Open(const skr::filesystem::path& path, bool create)
+    {
+        const auto pathString = path.u8string();
+        env                   = skr_lightning_environment_create(pathString.c_str());
+
+        SLightningStorageOpenDescriptor desc = {};
+        desc.name                            = u8"cook_workers";
+        desc.flags                           = create ? (LIGHTNING_STORAGE_OPEN_CREATE | LIGHTNING_STORAGE_OPEN_TRUNCATE) : LIGHTNING_STORAGE_OPEN_READ_WRITE;
+        storage                              = skr_lightning_storage_open(env, &desc);
+    }
+
+    void Close()
+    {
+        if (storage) skr_lightning_storage_close(storage);
+        if (env) skr_lightning_environment_free(env);
+        storage = nullptr;
+        env     = nullptr;
+    }
+
+    bool Write(const char* slot, uint32_t worker, const CookWorkerMessage& message)
+    {
+        char       key[32];
+        const auto keySize = snprintf(key, sizeof(key), "%s/%u", slot, worker);
+        auto       txn     = skr_lightning_transaction_open(env, nullptr, LIGHTNING_TRANSACATION_OPEN_READ_WRITE);
+        if (!txn)
+            return false;
+        const SLightningStorageValue k = { (uint64_t)keySize, key };
+        const SLightningStorageValue v = { sizeof(message), &message };
+        if (!skr_lightning_storage_write(txn, storage, &k, &v))
+        {
+            skr_lightning_transaction_abort(txn);
+            return false;
+        }
+        return skr_lightning_transaction_commit(txn);
+    }
+
+    bool Read(const char* slot, uint32_t worker, CookWorkerMessage& message)
+    {
+        char       key[32];
+        const auto keySize = snprintf(key, sizeof(key), "%s/%u", slot, worker);
+        auto       txn     = skr_lightning_transaction_open(env, nullptr, LIGHTNING_TRANSACATION_OPEN_READ_ONLY);
+        if (!txn)
+            return false;
+        SKR_DEFER({ skr_lightning_transaction_abort(txn); });
+        const SLightningStorageValue k = { (uint64_t)keySize, key };
+        SLightningStorageValue       v = { 0, nullptr };
+        if (!skr_lightning_storage_read(txn, storage, &k, &v) || v.size != sizeof(message))
+            return false;
+        memcpy(&message, v.data, sizeof(message));
+        return true;
+    }
+
+    SLightningEnvironmentId env     = nullptr;
+    SLightningStorageId     storage = nullptr;
+};
+
+//-------------------------------------------------------------------------------------------------
+// parent
+//-------------------------------------------------------------------------------------------------
+struct CookWorkerJob {
+    SAssetRecord*      record   = nullptr;
+    uint32_t           attempts = 0;
+    ECookWorkerResult  result   = ECookWorkerResult::Failed;
+    skr::task::event_t event;
+};
+
+struct CookWorkerSlot {
+    SProcessHandle process = nullptr;
+    CookWorkerJob* job     = nullptr;
+    uint64_t       jobSeq  = 0;
+    uint64_t       needSeq = 0;
+    bool           started = false;
+    // the job waits for a dependency, the worker does not count as busy
+    bool waiting = false;
+};
+
+struct CookWorkerReply {
+    uint32_t worker;
+    uint64_t seq;
+    bool     succeeded;
+};
+
+struct SCookWorkerPoolImpl : public SCookWorkerPool {
+    ECookWorkerResult Cook(SAssetRecord* record) override
+    {
+        CookWorkerJob job;
+        job.record = record;
+        {
+            SMutexLock lock(submitMutex);
+            submitted.add(&job);
+        }
+        job.event.wait(false);
+        return job.result;
+    }
+
+    SCookWorkerStatistics GetStatistics() const override
+    {
+        SCookWorkerStatistics stats;
+        stats.jobs               = jobs;
+        stats.succeeded          = succeeded;
+        stats.failed             = failed;
+        stats.retries            = retries;
+        stats.crashes            = crashes;
+        stats.spawns             = spawns;
+        stats.dependencyRequests = dependencyRequests;
+        stats.cookTime           = cookTime;
+        return stats;
+    }
+
+    void Start()
+    {
+        skr_init_mutex(&submitMutex);
+        skr_init_mutex(&replyMutex);
+        std::error_code ec = {};
+        skr::filesystem::remove_all(desc.boardPath, ec);
+        skr::filesystem::create_directories(desc.boardPath, ec);
+        board.Open(desc.boardPath, true);
+        slots.resize_default(desc.maxWorkerCount);
+
+        running = true;
+        SThreadDesc threadDesc;
+        threadDesc.pData = this;
+        threadDesc.pFunc = +[](void* pData) {
+            auto pool = static_cast<SCookWorkerPoolImpl*>(pData);
+            while (pool->running)
+            {
+                pool->Update();
+                skr_thread_sleep(1);
+            }
+        };
+        skr_init_thread(&threadDesc, &thread);
+    }
+
+    void Stop()
+    {
+        running = false;
+        skr_join_thread(thread);
+        skr_destroy_thread(thread);
+        while (pendingDependencies)
+            skr_thread_sleep(1);
+        for (uint32_t i = 0; i < slots.size(); ++i)
+        {
+            auto& slot = slots[i];
+            if (!slot.process)
+                continue;
+            CookWorkerMessage message;
+            message.seq    = ++slot.jobSeq;
+            message.status = COOK_WORKER_JOB_QUIT;
+            board.Write("job", i, message);
+            skr_wait_process(slot.process);
+            slot.process = nullptr;
+        }
+        {
+            SMutexLock lock(submitMutex);
+            queue.append(submitted);
+            submitted.clear();
+        }
+        for (auto job : queue)
+            Complete(job, ECookWorkerResult::Failed);
+        queue.clear();
+        board.Close();
+        skr_destroy_mutex(&submitMutex);
+        skr_destroy_mutex(&replyMutex);
+    }
+
+    void Complete(CookWorkerJob* job, ECookWorkerResult result)
+    {
+        if (result == ECookWorkerResult::Succeeded) succeeded++;
+        if (result == ECookWorkerResult::Failed) failed++;
+        job->result = result;
+        job->event.signal();
+    }
+
+    bool Spawn(uint32_t index)
+    {
+        auto&       slot      = slots[index];
+        const auto  logPath   = (desc.boardPath / skr::format(u8"worker{}.log", index).c_str()).u8string();
+        const auto  boardPath = desc.boardPath.u8string();
+        const auto  worker    = skr::format(u8"{}", index);
+        skr::Vector<const char8_t*> args;
+        for (auto& argument : desc.arguments)
+            args.add(argument.u8_str());
+        args.add(u8"--worker");
+        args.add(worker.u8_str());
+        args.add(u8"--board");
+        args.add(boardPath.c_str());
+        slot.process = skr_run_process(desc.executable.u8_str(), args.data(), (uint32_t)args.size(), logPath.c_str());
+        if (!slot.process)
+        {
+            SKR_LOG_ERROR(u8"[CookWorker] failed to start worker %u: %s", index, desc.executable.c_str());
+            return false;
+        }
+        slot.waiting = false;
+        spawns++;
+        return true;
+    }
+
+    void Assign(uint32_t index, CookWorkerJob* job)
+    {
+        auto& slot = slots[index];
+        job->attempts++;
+        slot.job     = job;
+        slot.started = false;
+        slot.waiting = false;
+        CookWorkerMessage message;
+        message.seq    = ++slot.jobSeq;
+        message.guid   = job->record->guid;
+        message.status = COOK_WORKER_JOB_COOK;
+        board.Write("job", index, message);
+        jobs++;
+    }
+
+    void OnWorkerExit(uint32_t index, int exitCode)
+    {
+        auto& slot = slots[index];
+        skr_wait_process(slot.process);
+        slot.process = nullptr;
+        slot.waiting = false;
+        crashes++;
+        // the next process in this slot must not pick the lost job up again
+        CookWorkerMessage message;
+        message.seq    = ++slot.jobSeq;
+        message.status = COOK_WORKER_JOB_IDLE;
+        board.Write("job", index, message);
+        if (auto job = slot.job)
+        {
+            slot.job = nullptr;
+            if (job->attempts <= desc.maxRetries)
+            {
+                SKR_LOG_FMT_WARN(u8"[CookWorker] worker {} exited with code {} while cooking {}, retrying.", index, exitCode, job->record->path.u8string().c_str());
+                retries++;
+                queue.add(job);
+            }
+            else
+            {
+                SKR_LOG_FMT_ERROR(u8"[CookWorker] worker {} exited with code {} while cooking {}, giving up after {} attempts.", index, exitCode, job->record->path.u8string().c_str(), job->attempts);
+                Complete(job, ECookWorkerResult::Failed);
+            }
+        }
+        else
+        {
+            SKR_LOG_FMT_WARN(u8"[CookWorker] worker {} exited with code {}.", index, exitCode);
+        }
+    }
+
+    void RequestDependency(uint32_t index, const CookWorkerMessage& message)
+    {
+        dependencyRequests++;
+        pendingDependencies++;
+        desc.scheduler->schedule([this, index, message]() {
+            auto system = GetCookSystem();
+            if (auto counter = system->EnsureCooked(message.guid))
+                counter.wait(false);
+            {
+                SMutexLock lock(replyMutex);
+                replies.add({ index, message.seq, !system->HasCookFailed(message.guid) });
+            }
+            pendingDependencies--;
+        },
+                                 nullptr);
+    }
+
+    void Update()
+    {
+        {
+            SMutexLock lock(submitMutex);
+            queue.append(submitted);
+            submitted.clear();
+        }
+        // send back the dependencies the parent finished
+        {
+            SMutexLock lock(replyMutex);
+            for (auto& reply : replies)
+            {
+                auto& slot = slots[reply.worker];
+                if (!slot.process || reply.seq != slot.needSeq)
+                    continue;
+                CookWorkerMessage message;
+                message.seq    = reply.seq;
+                message.status = reply.succeeded ? COOK_WORKER_STATUS_SUCCEEDED : COOK_WORKER_STATUS_FAILED;
+                board.Write("ready", reply.worker, message);
+                slot.waiting = false;
+            }
+            replies.clear();
+        }
+        // watch the workers
+        for (uint32_t i = 0; i < slots.size(); ++i)
+        {
+            auto& slot = slots[i];
+            if (!slot.process)
+                continue;
+            int exitCode = 0;
+            if (skr_try_wait_process(slot.process, &exitCode))
+            {
+                OnWorkerExit(i, exitCode);
+                continue;
+            }
+            if (!slot.job)
+                continue;
+            CookWorkerMessage message;
+            if (board.Read("need", i, message) && message.seq > slot.needSeq)
+            {
+                slot.needSeq = message.seq;
+                slot.waiting = true;
+                RequestDependency(i, message);
+            }
+            if (board.Read("result", i, message) && message.seq == slot.jobSeq)
+            {
+                const auto path = slot.job->record->path.u8string();
+                if (message.status == COOK_WORKER_STATUS_STARTED && !slot.started)
+                {
+                    slot.started = true;
+                    SKR_LOG_INFO(u8"[CookWorker] worker %u started %s", i, path.c_str());
+                }
+                else if (message.status == COOK_WORKER_STATUS_SUCCEEDED || message.status == COOK_WORKER_STATUS_FAILED)
+                {
+                    const bool ok = message.status == COOK_WORKER_STATUS_SUCCEEDED;
+                    SKR_LOG_INFO(u8"[CookWorker] worker %u %s %s in %.3fs", i, ok ? "finished" : "failed", path.c_str(), message.time / 1000000.0);
+                    cookTime += message.time;
+                    auto job     = slot.job;
+                    slot.job     = nullptr;
+                    slot.waiting = false;
+                    Complete(job, ok ? ECookWorkerResult::Succeeded : ECookWorkerResult::Failed);
+                }
+            }
+        }
+        // hand the queue out, workers waiting on dependencies are replaced up to maxWorkerCount
+        while (!queue.empty())
+        {
+            uint32_t live = 0, blocked = 0, idle = UINT32_MAX, free = UINT32_MAX;
+            for (uint32_t i = 0; i < slots.size(); ++i)
+            {
+                auto& slot = slots[i];
+                if (!slot.process)
+                {
+                    if (free == UINT32_MAX) free = i;
+                    continue;
+                }
+                live++;
+                if (slot.waiting) blocked++;
+                if (!slot.job && idle == UINT32_MAX) idle = i;
+            }
+            auto job = queue[0];
+            if (idle == UINT32_MAX && free != UINT32_MAX && live - blocked < desc.workerCount)
+            {
+                if (!Spawn(free))
+                {
+                    queue.remove_at(0);
+                    Complete(job, ECookWorkerResult::CookLocally);
+                    continue;
+                }
+                idle = free;
+            }
+            if (idle != UINT32_MAX)
+            {
+                queue.remove_at(0);
+                Assign(idle, job);
+                continue;
+            }
+            // every worker waits on the parent, cooking in-process is the only way forward
+            if (free == UINT32_MAX && blocked == live)
+            {
+                queue.remove_at(0);
+                Complete(job, ECookWorkerResult::CookLocally);
+                continue;
+            }
+            break;
+        }
+    }
+
+    SCookWorkerPoolDesc         desc;
+    CookWorkerBoard             board;
+    skr::Vector<CookWorkerSlot> slots;
+    // owned by the dispatcher thread
+    skr::Vector<CookWorkerJob*> queue;
+
+    SMutex                       submitMutex;
+    skr::Vector<CookWorkerJob*>  submitted;
+    SMutex                       replyMutex;
+    skr::Vector<CookWorkerReply> replies;
+
+    SThreadHandle        thread;
+    std::atomic_bool     running             = false;
+    std::atomic_uint32_t pendingDependencies = 0;
+
+    std::atomic_uint64_t jobs               = 0;
+    std::atomic_uint64_t succeeded          = 0;
+    std::atomic_uint64_t failed             = 0;
+    std::atomic_uint64_t retries            = 0;
+    std::atomic_uint64_t crashes            = 0;
+    std::atomic_uint64_t spawns             = 0;
+    std::atomic_uint64_t dependencyRequests = 0;
+    std::atomic_uint64_t cookTime           = 0;
+};
+
+SCookWorkerPool* SCookWorkerPool::Create(const SCookWorkerPoolDesc& desc)
+{
+    SKR_ASSERT(desc.scheduler && desc.workerCount);
+    auto pool                 = SkrNew<SCookWorkerPoolImpl>();
+    pool->desc                = desc;
+    pool->desc.maxWorkerCount = desc.maxWorkerCount > desc.workerCount ? desc.maxWorkerCount : desc.workerCount * 2;
+    pool->Start();
+    return pool;
+}
+
+void SCookWorkerPool::Destroy(SCookWorkerPool* pool)
+{
+    auto impl = static_cast<SCookWorkerPoolImpl*>(pool);
+    impl->Stop();
+    SkrDelete(impl);
+}
+
+//-------------------------------------------------------------------------------------------------
+// worker
+//-------------------------------------------------------------------------------------------------
+struct CookWorkerDependency {
+    skr_guid_t         guid;
+    bool               succeeded = false;
+    skr::task::event_t event;
+};
+
+struct SCookWorkerClientImpl : public SCookWorkerClient {
+    bool Update(skr_guid_t& job, bool& quit) override
+    {
+        // dependencies go to the parent one at a time
+        CookWorkerMessage message;
+        if (inflight && board.Read("ready", index, message) && message.seq == needSeq)
+        {
+            inflight->succeeded = message.status == COOK_WORKER_STATUS_SUCCEEDED;
+            inflight->event.signal();
+            inflight = nullptr;
+        }
+        if (!inflight)
+        {
+            SMutexLock lock(requestsMutex);
+            if (!requests.empty())
+            {
+                inflight = requests[0];
+                requests.remove_at(0);
+                message      = {};
+                message.seq  = ++needSeq;
+                message.guid = inflight->guid;
+                board.Write("need", index, message);
+            }
+        }
+
+        if (!board.Read("job", index, message) || message.seq == jobSeq)
+            return false;
+        jobSeq = message.seq;
+        if (message.status == COOK_WORKER_JOB_QUIT)
+            quit = true;
+        if (message.status != COOK_WORKER_JOB_COOK)
+            return false;
+        currentJob = message.guid;
+        hasJob     = true;
+        job        = message.guid;
+
+        CookWorkerMessage started;
+        started.seq    = jobSeq;
+        started.guid   = currentJob;
+        started.status = COOK_WORKER_STATUS_STARTED;
+        board.Write("result", index, started);
+        return true;
+    }
+
+    void ReportFinished(bool succeeded, uint64_t cookTime) override
+    {
+        CookWorkerMessage message;
+        message.seq    = jobSeq;
+        message.guid   = currentJob;
+        message.status = succeeded ? COOK_WORKER_STATUS_SUCCEEDED : COOK_WORKER_STATUS_FAILED;
+        message.time   = cookTime;
+        board.Write("result", index, message);
+        hasJob = false;
+    }
+
+    bool IsJob(skr_guid_t guid) const override
+    {
+        return hasJob && guid == currentJob;
+    }
+
+    bool RequestDependency(skr_guid_t guid) override
+    {
+        CookWorkerDependency dependency;
+        dependency.guid = guid;
+        {
+            SMutexLock lock(requestsMutex);
+            requests.add(&dependency);
+        }
+        dependency.event.wait(false);
+        return dependency.succeeded;
+    }
+
+    CookWorkerBoard board;
+    uint32_t        index   = 0;
+    uint64_t        jobSeq  = 0;
+    uint64_t        needSeq = 0;
+    // set before the job's cook task is scheduled, read by the task & its dependencies
+    skr_guid_t currentJob = {};
+    bool       hasJob     = false;
+
+    SMutex                             requestsMutex;
+    skr::Vector<CookWorkerDependency*> requests;
+    CookWorkerDependency*              inflight = nullptr;
+};
+
+SCookWorkerClient* SCookWorkerClient::Create(const skr::filesystem::path& boardPath, uint32_t workerIndex)
+{
+    std::error_code ec = {};
+    if (!skr::filesystem::is_directory(boardPath, ec))
+    {
+        SKR_LOG_ERROR(u8"[CookWorker] board %s not found!", boardPath.u8string().c_str());
+        return nullptr;
+    }
+    auto client   = SkrNew<SCookWorkerClientImpl>();
+    client->index = workerIndex;
+    skr_init_mutex(&client->requestsMutex);
+    client->board.Open(boardPath, false);
+    // a previous worker in this slot may have died, keep counting after its last request
+    CookWorkerMessage message;
+    if (client->board.Read("need", workerIndex, message))
+        client->needSeq = message.seq;
+    return client;
+}
+
+void SCookWorkerClient::Destroy(SCookWorkerClient* client)
+{
+    auto impl = static_cast<SCookWorkerClientImpl*>(client);
+    impl->board.Close();
+    skr_destroy_mutex(&impl->requestsMutex);
+    SkrDelete(impl);
+}
+} // namespace skd::asset
@@ -0,0 +1,193 @@
+#include "SkrBase/misc/hash.h"
+#include "SkrCore/log.hpp"
+#include "SkrCore/time.h"
+#include "SkrProfile/profile.h"
+#include "SkrTask/fib_task.hpp"
+#include "SkrContainers/vector.hpp"
+#include "SkrToolCore/asset/import_cache.hpp"
+
+namespace skd::asset
+{
+struct SImportCache::Entry {
+    skr::String key;
+    uint64_t    fingerprint = 0;
+    void*       document    = nullptr;
+    FreeFunc    free        = nullptr;
+    uint64_t    bytes       = 0;
+    uint32_t    refs        = 0;
+    uint64_t    lastUse     = 0;
+    // no longer addressable, freed with its last reference
+    bool detached = false;
+    // signaled once the first importer finished loading
+    skr::task::event_t ready;
+};
+
+// cheap stand-in for a content hash: hashing the sources would cost as much as parsing them
+static uint64_t ImportCacheFingerprint(const skr::filesystem::path& path)
+{
+    std::error_code ec        = {};
+    const uint64_t  size      = skr::filesystem::file_size(path, ec);
+    const auto      timestamp = skr::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    return skr_hash64(&timestamp, sizeof(timestamp), skr_hash64(&size, sizeof(size), 0));
+}
+
+SImportCache::SImportCache() SKR_NOEXCEPT
+{
+    skr_init_mutex(&mutex);
+}
+
+SImportCache::~SImportCache() SKR_NOEXCEPT
+{
+    Flush();
+    skr_destroy_mutex(&mutex);
+}
+
+void* SImportCache::Acquire(const char8_t* kind, const skr::filesystem::path& fullPath, LoadFunc load, FreeFunc free)
+{
+    SkrZoneScopedN("ImportCache::Acquire");
+    std::error_code ec          = {};
+    const auto      canonical   = skr::filesystem::weakly_canonical(fullPath, ec);
+    const auto      key         = skr::format(u8"{}:{}", kind, (ec ? fullPath : canonical).u8string().c_str());
+    const auto      fingerprint = ImportCacheFingerprint(fullPath);
+    Entry*          entry       = nullptr;
+    bool            owner       = false;
+    {
+        SMutexLock lock(mutex);
+        auto       it = entries.find(key);
+        if (it != entries.end() && it->second->fingerprint != fingerprint)
+        {
+            // the source changed on disk, readers of the old document keep it until they release
+            it->second->detached = true;
+            if (it->second->refs == 0)
+                Destroy(it->second);
+            entries.erase(key);
+            it = entries.end();
+        }
+        if (it != entries.end())
+        {
+            entry = it->second;
+            statistics.hits++;
+        }
+        else
+        {
+            entry              = SkrNew<Entry>();
+            entry->key         = key;
+            entry->fingerprint = fingerprint;
+            entry->free        = free;
+            entries.emplace(key, entry);
+            statistics.misses++;
+            owner = true;
+        }
+        entry->refs++;
+    }
+    if (owner)
+    {
+        const auto loadStart = skr_sys_get_usec(true);
+        uint64_t   bytes     = 0;
+        void*      document  = load(bytes);
+        {
+            SMutexLock lock(mutex);
+            statistics.loadTime += skr_sys_get_usec(true) - loadStart;
+            entry->document = document;
+            if (document)
+            {
+                entry->bytes = bytes;
+                documents.emplace(document, entry);
+                statistics.residentBytes += bytes;
+                statistics.peakBytes = std::max(statistics.peakBytes, statistics.residentBytes);
+            }
+            else if (!entry->detached)
+            {
+                entry->detached = true;
+                entries.erase(entry->key);
+            }
+        }
+        entry->ready.signal();
+    }
+    else
+    {
+        entry->ready.wait(false);
+    }
+    if (!entry->document)
+    {
+        SMutexLock lock(mutex);
+        if (--entry->refs == 0)
+            SkrDelete(entry);
+        return nullptr;
+    }
+    return entry->document;
+}
+
+void SImportCache::Release(void* document)
+{
+    if (!document)
+        return;
+    SMutexLock lock(mutex);
+    auto       it = documents.find(document);
+    if (it == documents.end())
+    {
+        SKR_LOG_ERROR(u8"[SImportCache] releasing a document that was not acquired from the cache!");
+        return;
+    }
+    auto entry = it->second;
+    if (--entry->refs != 0)
+        return;
+    if (entry->detached)
+    {
+        Destroy(entry);
+        return;
+    }
+    entry->lastUse = ++clock;
+    Evict();
+}
+
+void SImportCache::Flush()
+{
+    SMutexLock          lock(mutex);
+    skr::Vector<Entry*> idle;
+    for (auto& [key, entry] : entries)
+    {
+        if (entry->refs == 0)
+            idle.add(entry);
+    }
+    for (auto entry : idle)
+        Destroy(entry);
+}
+
+SImportCacheStatistics SImportCache::GetStatistics() const
+{
+    SMutexLock lock(mutex);
+    return statistics;
+}
+
+void SImportCache::Destroy(Entry* entry)
+{
+    if (!entry->detached)
+        entries.erase(entry->key);
+    documents.erase(entry->document);
+    statistics.residentBytes -= entry->bytes;
+    entry->free(entry->document);
+    SkrDelete(entry);
+}
+
+void SImportCache::Evict()
+{
+    // drops the least recently released documents until the idle ones fit in the budget
+    for (;;)
+    {
+        uint64_t idleBytes = 0;
+        Entry*   oldest    = nullptr;
+        for (auto& [key, entry] : entries)
+        {
+            if (entry->refs != 0 || !entry->document)
+                continue;
+            idleBytes += entry->bytes;
+            if (!oldest || entry->lastUse < oldest->lastUse)
+                oldest = entry;
+        }
+        if (!oldest || idleBytes <= idleBudget)
+            return;
+        Destroy(oldest);
+    }
+}
+} // namespace skd::asset
@@ -3,16 +3,23 @@
 #include "SkrRT/platform/vfs.h"
 #include "SkrRT/io/ram_io.hpp"
 #include "SkrToolCore/project/project.hpp"
+#include "SkrToolCore/asset/cook_dependency_db.hpp"
 #include "SkrSerde/json_serde.hpp"
 
 namespace skd
 {
 static skr::filesystem::path Workspace;
+static skr::filesystem::path CacheDirectory;
 void                         SProject::SetWorkspace(const skr::filesystem::path& path) noexcept
 {
     Workspace = path;
 }
 
+void SProject::SetCacheDirectory(const skr::filesystem::path& path) noexcept
+{
+    CacheDirectory = path;
+}
+
 SProject* SProject::OpenProject(const skr::filesystem::path& projectFilePath) noexcept
 {
     std::error_code ec          = {};
@@ -81,7 +88,7 @@ SProject* SProject::OpenProject(const skr::filesystem::path& projectFilePath) no
         fread(projectFileContent.raw().data(), 1, fileSize, projectFile);
         fclose(projectFile);
 
-        skr::archive::JsonReader reader(projectFileContent.view());
+        skr::archive::JsonReader reader(projectFileContent.view(), true);
         if (!skr::json_read(&reader, cfg))
         {
             SKR_LOG_ERROR(u8"Failed to parse project file: %s", projectPath.c_str());
@@ -96,6 +103,7 @@ SProject* SProject::OpenProject(const skr::filesystem::path& projectFilePath) no
     project->outputPath     = toAbsolutePath(cfg.resourceDirectory);
     project->artifactsPath  = toAbsolutePath(cfg.artifactsDirectory);
     project->dependencyPath = project->artifactsPath / "deps";
+    project->cachePath      = CacheDirectory.empty() ? project->artifactsPath / "cache" : CacheDirectory;
 
     // create resource VFS
     skr_vfs_desc_t resource_vfs_desc     = {};
@@ -122,6 +130,8 @@ SProject* SProject::OpenProject(const skr::filesystem::path& projectFilePath) no
     // Create output dir
     skr::filesystem::create_directories(project->GetOutputPath(), ec);
 
+    project->dependencyDB = asset::SCookDependencyDB::Open(project->dependencyPath / "db");
+
     return project;
 }
 
@@ -149,6 +159,7 @@ bool SProject::LoadAssetText(skr::StringView uri, skr::String& content) noexcept
 
 SProject::~SProject() noexcept
 {
+    if (dependencyDB) asset::SCookDependencyDB::Close(dependencyDB);
     if (ram_service) skr_io_ram_service_t::destroy(ram_service);
     if (resource_vfs) skr_free_vfs(resource_vfs);
     if (asset_vfs) skr_free_vfs(asset_vfs);
@@ -7,6 +7,7 @@ shared_module("SkrToolCore", "TOOL_CORE", engine_version)
     add_rules("c++.unity_build", {batchsize = default_unity_batch})
     add_files("src/**.cpp")
     public_dependency("SkrRT", engine_version)
+    public_dependency("SkrLightningStorage", engine_version)
     add_includedirs("include", {public = true})
     on_config(function (target, opt)
         target:add("defines", "SKR_RESOURCE_PLATFORM=u8\""..target:plat().."\"")
@@ -237,6 +237,10 @@ void RenderPassForward::execute(const skr_primitive_pass_context_t* context, skr
     }
     if (!root_signature) return; // no drawcalls
 
+    // 5.order the draws so that neighbours share as much state as possible
+    draw_sorter.gather(drawcalls);
+    draw_sorter.sort(kSortBlocks);
+
     renderGraph->add_render_pass(
     [=, this](skr::render_graph::RenderGraph& g, skr::render_graph::RenderPassBuilder& builder) {
         const auto out_color    = renderGraph->get_texture(SKR_UTF8("backbuffer"));
@@ -263,61 +267,67 @@ void RenderPassForward::execute(const skr_primitive_pass_context_t* context, skr
                                         0, 0,
                                         viewport->viewport_width, viewport->viewport_height);
 
+        cgpu_render_encoder_set_shading_rate(pass_context.encoder, shading_rate, CGPU_SHADING_RATE_COMBINER_PASSTHROUGH, CGPU_SHADING_RATE_COMBINER_PASSTHROUGH);
+
         {
             SkrZoneScopedN("DrawCalls");
-            CGPURenderPipelineId                            old_pipeline = nullptr;
             skr::Map<CGPURootSignatureId, CGPUXBindTableId> bind_tables;
-            for (uint32_t i = 0; i < drawcalls.size(); i++)
-                for (uint32_t j = 0; j < drawcalls[i].count; j++)
-                    for (uint32_t k = 0; k < drawcalls[i].lists[j].count; k++)
-                    {
-                        auto&& dc = drawcalls[i].lists[j].drawcalls[k];
-                        if (dc.desperated || (dc.index_buffer.buffer == nullptr) || (dc.vertex_buffer_count == 0)) continue;
+            state_tracker.reset();
+            for (const auto& entry : draw_sorter.get_entries())
+            {
+                auto&& dc = *entry.draw;
+                if ((dc.index_buffer.buffer == nullptr) || (dc.vertex_buffer_count == 0)) continue;
 
-                        if (old_pipeline != dc.pipeline)
-                        {
-                            cgpu_render_encoder_bind_pipeline(pass_context.encoder, dc.pipeline);
-                            old_pipeline = dc.pipeline;
-                        }
+                if (state_tracker.set_pipeline(dc.pipeline))
+                {
+                    cgpu_render_encoder_bind_pipeline(pass_context.encoder, dc.pipeline);
+                }
 
-                        CGPURootSignatureId dcRS = dc.pipeline->root_signature;
-                        if (!bind_tables.contains(dcRS))
-                        {
-                            bind_tables.add(dcRS, pass_context.create_and_update_bind_table(dc.pipeline->root_signature));
-                        }
-                        CGPUXBindTableId pass_table = bind_tables.find(dcRS).value();
-                        if (dc.bind_table)
-                        {
-                            CGPUXBindTableId tables[2] = { dc.bind_table, pass_table };
-                            pass_context.merge_and_bind_tables(tables, 2);
-                        }
-                        else
-                        {
-                            cgpux_render_encoder_bind_bind_table(pass_context.encoder, pass_table);
-                        }
+                CGPURootSignatureId dcRS = dc.pipeline->root_signature;
+                if (state_tracker.set_bind_table(dcRS, dc.bind_table))
+                {
+                    if (!bind_tables.contains(dcRS))
+                    {
+                        bind_tables.add(dcRS, pass_context.create_and_update_bind_table(dc.pipeline->root_signature));
+                    }
+                    CGPUXBindTableId pass_table = bind_tables.find(dcRS).value();
+                    if (dc.bind_table)
+                    {
+                        CGPUXBindTableId tables[2] = { dc.bind_table, pass_table };
+                        pass_context.merge_and_bind_tables(tables, 2);
+                    }
+                    else
+                    {
+                        cgpux_render_encoder_bind_bind_table(pass_context.encoder, pass_table);
+                    }
+                }
 
-                        {
-                            cgpu_render_encoder_bind_index_buffer(pass_context.encoder,
-                                                                  dc.index_buffer.buffer, dc.index_buffer.stride, dc.index_buffer.offset);
-                            CGPUBufferId vertex_buffers[16] = { 0 };
-                            uint32_t     strides[16]        = { 0 };
-                            uint32_t     offsets[16]        = { 0 };
-                            for (size_t i = 0; i < dc.vertex_buffer_count; i++)
-                            {
-                                vertex_buffers[i] = dc.vertex_buffers[i].buffer;
-                                strides[i]        = dc.vertex_buffers[i].stride;
-                                offsets[i]        = dc.vertex_buffers[i].offset;
-                            }
-                            for (size_t i = 0; i < dc.vertex_buffer_count; i++)
-                            {
-                                if (strides[i] == 0) offsets[i] = 0;
-                            }
-                            cgpu_render_encoder_bind_vertex_buffers(pass_context.encoder, dc.vertex_buffer_count, vertex_buffers, strides, offsets);
-                        }
-                        cgpu_render_encoder_push_constants(pass_context.encoder, dc.pipeline->root_signature, dc.push_const_name, dc.push_const);
-                        cgpu_render_encoder_set_shading_rate(pass_context.encoder, shading_rate, CGPU_SHADING_RATE_COMBINER_PASSTHROUGH, CGPU_SHADING_RATE_COMBINER_PASSTHROUGH);
-                        cgpu_render_encoder_draw_indexed_instanced(pass_context.encoder, dc.index_buffer.index_count, dc.index_buffer.first_index, 1, 0, 0);
+                if (state_tracker.set_index_buffer(dc.index_buffer))
+                {
+                    cgpu_render_encoder_bind_index_buffer(pass_context.encoder,
+                                                          dc.index_buffer.buffer, dc.index_buffer.stride, dc.index_buffer.offset);
+                }
+                if (state_tracker.set_vertex_buffers(dc.vertex_buffers, dc.vertex_buffer_count))
+                {
+                    CGPUBufferId vertex_buffers[16] = { 0 };
+                    uint32_t     strides[16]        = { 0 };
+                    uint32_t     offsets[16]        = { 0 };
+                    for (size_t i = 0; i < dc.vertex_buffer_count; i++)
+                    {
+                        vertex_buffers[i] = dc.vertex_buffers[i].buffer;
+                        strides[i]        = dc.vertex_buffers[i].stride;
+                        offsets[i]        = dc.vertex_buffers[i].offset;
                     }
+                    for (size_t i = 0; i < dc.vertex_buffer_count; i++)
+                    {
+                        if (strides[i] == 0) offsets[i] = 0;
+                    }
+                    cgpu_render_encoder_bind_vertex_buffers(pass_context.encoder, dc.vertex_buffer_count, vertex_buffers, strides, offsets);
+                }
+                cgpu_render_encoder_push_constants(pass_context.encoder, dc.pipeline->root_signature, dc.push_const_name, dc.push_const);
+                cgpu_render_encoder_draw_indexed_instanced(pass_context.encoder, dc.index_buffer.index_count, dc.index_buffer.first_index, dc.instance_count ? dc.instance_count : 1, 0, 0);
+                state_tracker.draw();
+            }
         }
     });
 }
\ No newline at end of file
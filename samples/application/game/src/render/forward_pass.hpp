@@ -1,5 +1,6 @@
 #pragma once
 #include "SkrRenderer/render_effect.h"
+#include "SkrRenderer/draw_sort.hpp"
 
 namespace game {
 
@@ -21,6 +22,10 @@ struct RenderPassForward : public IPrimitiveRenderPass
     bool need_clear = true;
     
     ECGPUShadingRate shading_rate = CGPU_SHADING_RATE_FULL;
+
+    static constexpr uint32_t kSortBlocks = 8;
+    skr::renderer::DrawListSorter draw_sorter;
+    skr::renderer::DrawStateTracker state_tracker;
 };
 
 } // namespace game
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "SkrRenderer/resources/texture_resource.h"
 #include "SkrRenderer/render_mesh.h"
 #include "SkrRenderer/render_group.h"
+#include "SkrRenderer/render_viewport.h"
 #include "SkrAnim/components/skin_component.hpp"
 #include "SkrAnim/components/skeleton_component.hpp"
 
@@ -127,6 +128,34 @@ void RenderEffectForward::initialize_data(SRendererId renderer, sugoi_storage_t*
     }
 }
 
+// clip space depth of the model origin, 0 when it is behind the eye
+static float model_view_depth(const skr_float4x4_t& model, const skr_float4x4_t& view_projection)
+{
+    float z = view_projection.M[3][2];
+    float w = view_projection.M[3][3];
+    for (uint32_t k = 0; k < 3; k++)
+    {
+        z += model.M[3][k] * view_projection.M[k][2];
+        w += model.M[3][k] * view_projection.M[k][3];
+    }
+    return w > 0.f ? z / w : 0.f;
+}
+
+// screen pixels covered by one model space unit at the model origin, 0 when it is behind the eye
+static float model_pixels_per_unit(const skr_float4x4_t& model, const skr_float4x4_t& view_projection, uint32_t viewport_height)
+{
+    float w = view_projection.M[3][3];
+    float y_scale = 0.f;
+    float model_scale = 0.f;
+    for (uint32_t k = 0; k < 3; k++)
+    {
+        w += model.M[3][k] * view_projection.M[k][3];
+        y_scale += view_projection.M[k][1] * view_projection.M[k][1];
+        model_scale = std::max(model_scale, model.M[k][0] * model.M[k][0] + model.M[k][1] * model.M[k][1] + model.M[k][2] * model.M[k][2]);
+    }
+    return w > 0.f ? sqrtf(y_scale * model_scale) * 0.5f * viewport_height / w : 0.f;
+}
+
 skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_primitive_draw_context_t* context)
 {
     auto pass = context->pass;
@@ -162,6 +191,13 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
     };
     sugoiQ_get_views(mesh_query, SUGOI_LAMBDA(counterF));
 
+    // draws are sorted front to back in the main viewport
+    const auto viewport = context->renderer->get_viewport_manager()->find_viewport(0u);
+    const auto view_projection = viewport ? viewport->view_projection : skr_float4x4_t{};
+    const auto viewport_height = viewport ? viewport->viewport_height : 0u;
+    // mesh LODs are switched once their error covers a pixel
+    const float kMaxLODPixelError = 1.f;
+
     // 2. resize data buffers
     model_matrices.clear();
     push_constants.clear();
@@ -241,6 +277,8 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
             for (uint32_t g_idx = 0; g_idx < g_cv->count; g_idx++, r_idx++)
             {
                 const auto& model_matrix = model_matrices[g_idx];
+                const float depth = model_view_depth(model_matrix, view_projection);
+                const float pixels_per_unit = model_pixels_per_unit(model_matrix, view_projection, viewport_height);
                 // drawcall
                 auto status = meshes[r_idx].mesh_resource.get_status();
                 if (status == SKR_LOADING_STATUS_INSTALLED)
@@ -290,16 +328,18 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
                             drawcall.bind_table = proper_bind_table;
                             drawcall.push_const_name = push_constants_name;
                             drawcall.push_const = (const uint8_t*)(&push_const);
-                            drawcall.index_buffer = *cmd.ibv;
+                            drawcall.index_buffer = cmd.lod_ibvs[skr_render_mesh_select_lod(renderMesh, (uint32_t)i, pixels_per_unit, kMaxLODPixelError)];
                             drawcall.vertex_buffers = anims[r_idx].primitives[i].views.data();
                             drawcall.vertex_buffer_count = (uint32_t)anims[r_idx].primitives[i].views.size();
+                            drawcall.sort_key = skr_primitive_draw_make_sort_key(0, proper_pipeline, proper_bind_table, depth);
                             dc_idx++;
                         }
                     }
                     else 
                     {
-                        for (auto&& cmd : cmds)
+                        for (uint32_t i = 0; i < cmds.size(); ++i)
                         {
+                            auto& cmd = cmds[i];
                             CGPURenderPipelineId proper_pipeline = pipeline;
                             CGPUXBindTableId proper_bind_table = nullptr;
                             if (materials.size())
@@ -318,9 +358,10 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
                             drawcall.bind_table = proper_bind_table;
                             drawcall.push_const_name = push_constants_name;
                             drawcall.push_const = (const uint8_t*)(&push_const);
-                            drawcall.index_buffer = *cmd.ibv;
+                            drawcall.index_buffer = cmd.lod_ibvs[skr_render_mesh_select_lod(renderMesh, i, pixels_per_unit, kMaxLODPixelError)];
                             drawcall.vertex_buffers = cmd.vbvs.data();
                             drawcall.vertex_buffer_count = (uint32_t)cmd.vbvs.size();
+                            drawcall.sort_key = skr_primitive_draw_make_sort_key(0, proper_pipeline, proper_bind_table, depth);
                             dc_idx++;
                         }
                     }
@@ -336,6 +377,7 @@ skr_primitive_draw_packet_t RenderEffectForward::produce_draw_packets(const skr_
                     drawcall.index_buffer = ibv;
                     drawcall.vertex_buffers = vbvs;
                     drawcall.vertex_buffer_count = 5;
+                    drawcall.sort_key = skr_primitive_draw_make_sort_key(0, pipeline, nullptr, depth);
                     dc_idx++;
                 }
             }
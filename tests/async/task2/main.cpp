@@ -20,7 +20,12 @@ static struct ProcInitializer
 
 #if __cpp_impl_coroutine
 #include "SkrTask/co_task.hpp"
+#include "SkrTask/fib_task.hpp"
+#include "SkrCore/time.h"
 #include "SkrOS/filesystem.hpp"
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
 
 class Task2
 {
@@ -246,6 +251,175 @@ TEST_CASE_METHOD(Task2, "MassiveCoroutine")
     EXPECT_EQ(a, 1010000);
 }
 
+TEST_CASE("SharedWorkerPool")
+{
+    SkrZoneScopedN("SharedWorkerPool");
+    using namespace skr::task2;
+    skr::task::scheduler_t fiberScheduler;
+    fiberScheduler.initialize({});
+    fiberScheduler.bind();
+    scheduler_t scheduler;
+    scheudler_config_t config;
+    config.fiberScheduler = &fiberScheduler;
+    scheduler.initialize(config);
+    scheduler.bind();
+    {
+        std::atomic<int> a = 0;
+        event_t produced;
+        counter_t consumed;
+        consumed.add(2);
+        // a fiber job parks on the same event the coroutine awaits
+        skr::task::schedule([&a, produced, consumed]() mutable
+        {
+            wait(produced);
+            a += 10;
+            consumed.decrease();
+        }, nullptr);
+        schedule([](std::atomic<int>& a, event_t produced, counter_t consumed) -> skr_task_t
+        {
+            counter_t counter;
+            counter.add(10);
+            for(int i = 0; i < 10; ++i)
+            {
+                schedule([=, &a]() mutable
+                {
+                    a += 1;
+                    counter.decrease();
+                });
+            }
+            co_await co_wait(counter);
+            produced.notify();
+            co_await co_wait(produced);
+            consumed.decrease();
+        }(a, produced, consumed));
+        sync(consumed);
+        EXPECT_EQ(a, 20);
+    }
+    scheduler.unbind();
+    scheduler.shutdown();
+    fiberScheduler.unbind();
+}
+
+TEST_CASE("SharedWorkerPoolShutdown")
+{
+    SkrZoneScopedN("SharedWorkerPoolShutdown");
+    using namespace skr::task2;
+    skr::task::scheduler_t fiberScheduler;
+    fiberScheduler.initialize({});
+    fiberScheduler.bind();
+    std::atomic<int> a = 0;
+    {
+        scheduler_t scheduler;
+        scheudler_config_t config;
+        config.fiberScheduler = &fiberScheduler;
+        scheduler.initialize(config);
+        scheduler.bind();
+        // nothing syncs on these, shutdown has to wait for them
+        for(int i = 0; i < 100; ++i)
+        {
+            schedule([&a]()
+            {
+                std::this_thread::yield();
+                a += 1;
+            });
+        }
+        scheduler.unbind();
+        scheduler.shutdown();
+        EXPECT_EQ(scheduler.sharedTasks.load(), 0u);
+    }
+    EXPECT_EQ(a, 100);
+    fiberScheduler.unbind();
+}
+
+static uint64_t os_context_switches()
+{
+#if !defined(_WIN32)
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t)(usage.ru_nvcsw + usage.ru_nivcsw);
+#else
+    return 0;
+#endif
+}
+
+// fiber jobs and coroutines side by side, once with two pools and once with task2 on the fiber pool
+// timing only, skipped by default: run with --no-skip -tc=MixedWorkloadBench
+TEST_CASE("MixedWorkloadBench" * doctest::skip())
+{
+    using namespace skr::task2;
+    constexpr uint32_t kFrames = 50;
+    constexpr uint32_t kFiberJobs = 512;
+    constexpr uint32_t kCoroutines = 64;
+    constexpr uint32_t kChildren = 16;
+    constexpr uint64_t kItemsPerFrame = kFiberJobs + kCoroutines * (kChildren + 1);
+    for(uint32_t shared = 0; shared < 2; ++shared)
+    {
+        SkrZoneScopedN("MixedWorkload");
+        skr::task::scheduler_t fiberScheduler;
+        fiberScheduler.initialize({});
+        fiberScheduler.bind();
+        scheduler_t scheduler;
+        scheudler_config_t config;
+        if(shared)
+            config.fiberScheduler = &fiberScheduler;
+        scheduler.initialize(config);
+        scheduler.bind();
+
+        std::atomic<uint64_t> items = 0;
+        const uint64_t switchesBefore = os_context_switches();
+        const auto start = skr_sys_get_usec(true);
+        for(uint32_t frame = 0; frame < kFrames; ++frame)
+        {
+            skr::task::counter_t fiberJobs;
+            fiberJobs.add(kFiberJobs);
+            for(uint32_t i = 0; i < kFiberJobs; ++i)
+            {
+                skr::task::schedule([&items, fiberJobs]() mutable
+                {
+                    items += 1;
+                    fiberJobs.decrement();
+                }, nullptr);
+            }
+            counter_t coroutines;
+            coroutines.add(kCoroutines);
+            for(uint32_t i = 0; i < kCoroutines; ++i)
+            {
+                schedule([](std::atomic<uint64_t>& items, counter_t coroutines) -> skr_task_t
+                {
+                    counter_t children;
+                    children.add(kChildren);
+                    for(uint32_t j = 0; j < kChildren; ++j)
+                    {
+                        schedule([=, &items]() mutable
+                        {
+                            items += 1;
+                            children.decrease();
+                        });
+                    }
+                    co_await co_wait(children);
+                    items += 1;
+                    coroutines.decrease();
+                }(items, coroutines));
+            }
+            fiberJobs.wait(false);
+            sync(coroutines);
+        }
+        const auto elapsed = skr_sys_get_usec(true) - start;
+        const uint64_t switches = os_context_switches() - switchesBefore;
+        EXPECT_EQ(items, kItemsPerFrame * kFrames);
+        SKR_LOG_INFO(u8"%s: %.2f ms, %.2f M items/s, %llu os context switches, %llu coroutine suspends",
+            shared ? "shared pool" : "separate pools",
+            elapsed / 1000.0,
+            elapsed ? (double)(kItemsPerFrame * kFrames) / (double)elapsed : 0.0,
+            (unsigned long long)switches,
+            (unsigned long long)scheduler.suspendCount.load());
+
+        scheduler.unbind();
+        scheduler.shutdown();
+        fiberScheduler.unbind();
+    }
+}
+
 #else
 struct Task2
 {
@@ -18,6 +18,8 @@ protected:
                 return "Vulkan";
             case ECGPUBackend::CGPU_BACKEND_AGC:
                 return "AGC";
+            case ECGPUBackend::CGPU_BACKEND_NULL:
+                return "Null";
             default:
                 return "UNKNOWN";
         }
@@ -47,6 +49,10 @@ CGPUInstanceId init_instance(ECGPUBackend backend, bool enable_debug_layer, bool
     {
         EXPECT_TRUE(instance_features.specialization_constant);
     }
+    else if (backend == ECGPUBackend::CGPU_BACKEND_NULL)
+    {
+        EXPECT_TRUE(instance_features.specialization_constant);
+    }
     return instance;
 }
 
@@ -213,4 +219,11 @@ TEST_CASE_METHOD(DeviceInitializeTest<CGPU_BACKEND_VULKAN>, "DeviceInitializeTes
 {
     test_all();
 }
+#endif
+
+#ifdef CGPU_USE_NULL
+TEST_CASE_METHOD(DeviceInitializeTest<CGPU_BACKEND_NULL>, "DeviceInitializeTest-null")
+{
+    test_all();
+}
 #endif
\ No newline at end of file
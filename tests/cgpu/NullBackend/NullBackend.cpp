@@ -0,0 +1,225 @@
+#include "SkrGraphics/api.h"
+#include "SkrGraphics/backend/null/cgpu_null.h"
+#include "SkrTestFramework/framework.hpp"
+
+class NullBackend
+{
+protected:
+    NullBackend()
+    {
+        SKR_DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        desc.enable_debug_layer = true;
+        desc.enable_gpu_based_validation = false;
+        instance = cgpu_create_instance(&desc);
+        EXPECT_NE(instance, CGPU_NULLPTR);
+
+        uint32_t adapters_count = 0;
+        cgpu_enum_adapters(instance, nullptr, &adapters_count);
+        REQUIRE(adapters_count == 1);
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+
+        CGPUQueueGroupDescriptor queue_group = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        SKR_DECLARE_ZERO(CGPUDeviceDescriptor, descriptor)
+        descriptor.queue_groups = &queue_group;
+        descriptor.queue_group_count = 1;
+        device = cgpu_create_device(adapter, &descriptor);
+        EXPECT_NE(device, CGPU_NULLPTR);
+
+        queue = cgpu_get_queue(device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
+        pool = cgpu_create_command_pool(queue, nullptr);
+        SKR_DECLARE_ZERO(CGPUCommandBufferDescriptor, cmd_desc);
+        cmd = cgpu_create_command_buffer(pool, &cmd_desc);
+    }
+
+    ~NullBackend()
+    {
+        cgpu_free_command_buffer(cmd);
+        cgpu_free_command_pool(pool);
+        cgpu_free_queue(queue);
+        cgpu_free_device(device);
+        cgpu_free_instance(instance);
+    }
+
+    CGPUNullDeviceStatistics statistics()
+    {
+        CGPUNullDeviceStatistics stats = {};
+        cgpu_null_query_device_statistics(device, &stats);
+        return stats;
+    }
+
+    void submit(CGPUFenceId fence = nullptr)
+    {
+        CGPUQueueSubmitDescriptor submit_desc = {};
+        submit_desc.cmds = &cmd;
+        submit_desc.cmds_count = 1;
+        submit_desc.signal_fence = fence;
+        cgpu_submit_queue(queue, &submit_desc);
+    }
+
+    CGPUTextureId create_render_target(ECGPUResourceState start_state)
+    {
+        SKR_DECLARE_ZERO(CGPUTextureDescriptor, desc)
+        desc.name = u8"NullRenderTarget";
+        desc.width = 256;
+        desc.height = 256;
+        desc.format = CGPU_FORMAT_R8G8B8A8_UNORM;
+        desc.descriptors = CGPU_RESOURCE_TYPE_TEXTURE | CGPU_RESOURCE_TYPE_RENDER_TARGET;
+        desc.start_state = start_state;
+        return cgpu_create_texture(device, &desc);
+    }
+
+    CGPUInstanceId instance = nullptr;
+    CGPUAdapterId adapter = nullptr;
+    CGPUDeviceId device = nullptr;
+    CGPUQueueId queue = nullptr;
+    CGPUCommandPoolId pool = nullptr;
+    CGPUCommandBufferId cmd = nullptr;
+};
+
+TEST_CASE_METHOD(NullBackend, "NullBackend")
+{
+    SUBCASE("AdapterDetail")
+    {
+        const CGPUAdapterDetail* detail = cgpu_query_adapter_detail(adapter);
+        EXPECT_TRUE(detail->is_cpu);
+        EXPECT_TRUE(detail->is_virtual);
+        EXPECT_EQ(cgpu_query_queue_count(adapter, CGPU_QUEUE_TYPE_TILE_MAPPING), 0u);
+        EXPECT_TRUE(detail->format_supports[CGPU_FORMAT_R8G8B8A8_UNORM].render_target_write);
+        EXPECT_FALSE(detail->format_supports[CGPU_FORMAT_DXBC1_RGBA_UNORM].render_target_write);
+    }
+
+    SUBCASE("ResourceBookkeeping")
+    {
+        SKR_DECLARE_ZERO(CGPUBufferDescriptor, desc)
+        desc.descriptors = CGPU_RESOURCE_TYPE_UNIFORM_BUFFER;
+        desc.memory_usage = CGPU_MEM_USAGE_GPU_ONLY;
+        desc.size = 100;
+        auto buffer = cgpu_create_buffer(device, &desc);
+        auto texture = create_render_target(CGPU_RESOURCE_STATE_RENDER_TARGET);
+        EXPECT_EQ(texture->info->size_in_bytes % (64 * 1024), 0u);
+        EXPECT_TRUE(texture->info->size_in_bytes >= 256u * 256u * 4u);
+
+        auto stats = statistics();
+        EXPECT_EQ(stats.buffer_count, 1u);
+        EXPECT_EQ(stats.texture_count, 1u);
+        EXPECT_EQ(stats.buffer_bytes, 256u);
+        EXPECT_EQ(stats.texture_bytes, texture->info->size_in_bytes);
+        EXPECT_EQ(stats.host_backed_bytes, 0u);
+
+        uint64_t total = 0, used = 0;
+        cgpu_query_video_memory_info(device, &total, &used);
+        EXPECT_EQ(used, stats.buffer_bytes + stats.texture_bytes);
+
+        cgpu_free_texture(texture);
+        cgpu_free_buffer(buffer);
+        stats = statistics();
+        EXPECT_EQ(stats.buffer_count, 0u);
+        EXPECT_EQ(stats.texture_count, 0u);
+        EXPECT_EQ(stats.buffer_bytes, 0u);
+        EXPECT_EQ(stats.texture_bytes, 0u);
+    }
+
+    SUBCASE("CommandStream")
+    {
+        auto texture = create_render_target(CGPU_RESOURCE_STATE_SHADER_RESOURCE);
+        cgpu_cmd_begin(cmd);
+        CGPUEventInfo event = { u8"NullEvent", { 1.f, 1.f, 1.f, 1.f } };
+        cgpu_cmd_begin_event(cmd, &event);
+        CGPUTextureBarrier barrier = {};
+        barrier.texture = texture;
+        barrier.src_state = CGPU_RESOURCE_STATE_SHADER_RESOURCE;
+        barrier.dst_state = CGPU_RESOURCE_STATE_RENDER_TARGET;
+        CGPUResourceBarrierDescriptor barrier_desc = {};
+        barrier_desc.texture_barriers = &barrier;
+        barrier_desc.texture_barriers_count = 1;
+        cgpu_cmd_resource_barrier(cmd, &barrier_desc);
+        cgpu_cmd_end_event(cmd);
+        cgpu_cmd_end(cmd);
+
+        uint64_t size = 0;
+        const uint8_t* stream = cgpu_null_query_command_stream(cmd, &size);
+        REQUIRE(stream != nullptr);
+        const uint32_t expected_ops[] = { CGPU_NULL_CMD_BEGIN_EVENT, CGPU_NULL_CMD_RESOURCE_BARRIER, CGPU_NULL_CMD_END_EVENT };
+        uint32_t count = 0;
+        for (uint64_t offset = 0; offset < size; count++)
+        {
+            const auto header = (const CGPUNullCommandHeader*)(stream + offset);
+            REQUIRE(count < 3);
+            EXPECT_EQ(header->op, expected_ops[count]);
+            EXPECT_EQ(header->size % 8, 0u);
+            offset += header->size;
+        }
+        EXPECT_EQ(count, 3u);
+
+        auto fence = cgpu_create_fence(device);
+        EXPECT_EQ(cgpu_query_fence_status(fence), CGPU_FENCE_STATUS_NOTSUBMITTED);
+        submit(fence);
+        EXPECT_EQ(cgpu_query_fence_status(fence), CGPU_FENCE_STATUS_COMPLETE);
+        auto stats = statistics();
+        EXPECT_EQ(stats.recorded_commands, 3u);
+        EXPECT_EQ(stats.recorded_bytes, size);
+        EXPECT_EQ(stats.submitted_command_buffers, 1u);
+        EXPECT_EQ(stats.validation_errors, 0u);
+        cgpu_wait_fences(&fence, 1);
+        EXPECT_EQ(cgpu_query_fence_status(fence), CGPU_FENCE_STATUS_NOTSUBMITTED);
+        cgpu_free_fence(fence);
+        cgpu_free_texture(texture);
+    }
+
+    SUBCASE("BarrierStateMismatch")
+    {
+        auto texture = create_render_target(CGPU_RESOURCE_STATE_SHADER_RESOURCE);
+        cgpu_cmd_begin(cmd);
+        CGPUTextureBarrier barrier = {};
+        barrier.texture = texture;
+        barrier.src_state = CGPU_RESOURCE_STATE_COPY_DEST;
+        barrier.dst_state = CGPU_RESOURCE_STATE_RENDER_TARGET;
+        CGPUResourceBarrierDescriptor barrier_desc = {};
+        barrier_desc.texture_barriers = &barrier;
+        barrier_desc.texture_barriers_count = 1;
+        cgpu_cmd_resource_barrier(cmd, &barrier_desc);
+        cgpu_cmd_end(cmd);
+        submit();
+        EXPECT_EQ(statistics().validation_errors, 1u);
+        cgpu_free_texture(texture);
+    }
+
+    SUBCASE("DrawOutsideRenderPass")
+    {
+        cgpu_cmd_begin(cmd);
+        cgpu_render_encoder_draw((CGPURenderPassEncoderId)cmd, 3, 0);
+        cgpu_cmd_end(cmd);
+        EXPECT_EQ(statistics().validation_errors, 0u);
+        submit();
+        EXPECT_EQ(statistics().validation_errors, 1u);
+    }
+
+    SUBCASE("ExperimentalProcs")
+    {
+        EXPECT_EQ(cgpu_query_dstorage_availability(device), SKR_DSTORAGE_AVAILABILITY_NONE);
+
+        auto state_buffer = cgpu_create_state_buffer(cmd, nullptr);
+        auto binder = cgpu_create_binder(cmd);
+        cgpu_cmd_begin(cmd);
+        auto raster = cgpu_open_raster_state_encoder(state_buffer, (CGPURenderPassEncoderId)cmd);
+        cgpu_raster_state_encoder_set_viewport(raster, 0.f, 0.f, 64.f, 64.f, 0.f, 1.f);
+        cgpu_raster_state_encoder_set_cull_mode(raster, CGPU_CULL_MODE_BACK);
+        cgpu_close_raster_state_encoder(raster);
+        CGPUVertexLayout layout = {};
+        cgpu_binder_bind_vertex_layout(binder, &layout);
+        cgpu_cmd_end(cmd);
+        uint64_t size = 0;
+        cgpu_null_query_command_stream(cmd, &size);
+        EXPECT_NE(size, 0u);
+        EXPECT_EQ(statistics().validation_errors, 0u);
+        cgpu_free_binder(binder);
+        cgpu_free_state_buffer(state_buffer);
+    }
+
+    SUBCASE("RecordOutsideBegin")
+    {
+        cgpu_cmd_end(cmd);
+        EXPECT_EQ(statistics().validation_errors, 1u);
+    }
+}
@@ -216,4 +216,11 @@ TEST_CASE_METHOD(QueueOperations<CGPU_BACKEND_VULKAN>, "QueueOperations-vulkan")
 {
     test_all();
 }
+#endif
+
+#ifdef CGPU_USE_NULL
+TEST_CASE_METHOD(QueueOperations<CGPU_BACKEND_NULL>, "QueueOperations-null")
+{
+    test_all();
+}
 #endif
\ No newline at end of file
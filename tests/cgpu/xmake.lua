@@ -19,5 +19,7 @@ test_target("CGPUTests")
         -- ResourceCreation
         "ResourceCreation/ResourceCreation.cpp",
         -- SwapChainCreation
-        "SwapChainCreation/SwapChainCreation.cpp"
+        "SwapChainCreation/SwapChainCreation.cpp",
+        -- NullBackend
+        "NullBackend/NullBackend.cpp"
     , {unity_group = "CPUTests"})
\ No newline at end of file
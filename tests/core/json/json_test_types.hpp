@@ -0,0 +1,29 @@
+#pragma once
+#include "SkrBase/config.h"
+#include "SkrContainers/string.hpp"
+#ifndef __meta__
+    #include "JsonTest/json_test_types.generated.h"
+#endif
+
+namespace json_test
+{
+sreflect_struct(
+    "guid" : "3167e905-91fe-4f74-a2d1-7f964048df0d",
+    "serde" : ["json"]
+)
+StreamBase {
+    uint32_t version = 0;
+};
+
+// read back through the generated read_field / read_fields_streaming
+sreflect_struct(
+    "guid" : "7b1a802c-3384-41fe-82bc-375b4ed173fc",
+    "serde" : ["json"]
+)
+StreamRecord : public StreamBase {
+    int32_t     count = 0;
+    float       scale = 1.f;
+    skr::String name;
+    int32_t     values[3] = { 0, 0, 0 };
+};
+} // namespace json_test
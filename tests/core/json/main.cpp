@@ -1,7 +1,9 @@
 #include "SkrCore/crash.h"
 #include "SkrCore/log.h"
 #include "SkrCore/log.hpp"
+#include "SkrCore/time.h"
 #include "SkrTestFramework/framework.hpp"
+#include "json_test_types.hpp"
 
 static struct ProcInitializer {
     ProcInitializer()
@@ -406,4 +408,229 @@ TEST_CASE_METHOD(JSONTests, "WriteErrors")
         EXPECT_OK(obj_writer.Key(u8"key"));
         EXPECT_ERROR(obj_writer.Key(u8"key"), JsonErrorCode::PresetKeyNotConsumedYet);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(JSONTests, "StreamFields")
+{
+    using namespace skr::archive;
+    auto reader = JsonReader(u8"{ \"a\": 1, \"b\": { \"c\": [ 2, 3 ] }, \"d\": \"str\" }", true);
+    EXPECT_TRUE(reader.IsStreamFields());
+    EXPECT_OK(reader.StartObject());
+
+    skr::StringView key;
+    int32_t         i32 = 0;
+    EXPECT_TRUE(reader.NextField(key));
+    EXPECT_EQ(key, skr::StringView(u8"a"));
+    EXPECT_OK(reader.Int32(i32));
+    EXPECT_EQ(i32, 1);
+
+    // skip "b" without consuming it
+    EXPECT_TRUE(reader.NextField(key));
+    EXPECT_EQ(key, skr::StringView(u8"b"));
+
+    skr::String str;
+    EXPECT_TRUE(reader.NextField(key));
+    EXPECT_EQ(key, skr::StringView(u8"d"));
+    EXPECT_OK(reader.String(str));
+    EXPECT_EQ(str, skr::String(u8"str"));
+    // value is consumed, keyless read fails again
+    EXPECT_ERROR(reader.String(str), JsonErrorCode::EmptyObjectFieldKey);
+
+    EXPECT_FALSE(reader.NextField(key));
+    // keyed reads still work in streaming mode
+    EXPECT_OK(reader.Key(u8"b"));
+    EXPECT_OK(reader.StartObject());
+    size_t count = 0;
+    EXPECT_OK(reader.Key(u8"c"));
+    EXPECT_OK(reader.StartArray(count));
+    EXPECT_EQ(count, 2);
+    EXPECT_OK(reader.Int32(i32));
+    EXPECT_EQ(i32, 2);
+    EXPECT_OK(reader.Int32(i32));
+    EXPECT_EQ(i32, 3);
+    EXPECT_OK(reader.EndArray());
+    EXPECT_OK(reader.EndObject());
+    EXPECT_OK(reader.EndObject());
+}
+
+TEST_CASE_METHOD(JSONTests, "StreamFieldsRecord")
+{
+    using namespace skr::archive;
+    using json_test::StreamRecord;
+    SUBCASE("Reordered")
+    {
+        // members out of declaration order, base field last
+        auto reader = JsonReader(u8"{ \"values\": [ 4, 5, 6 ], \"name\": \"mesh\", \"scale\": 2.5, \"count\": 7, \"version\": 3 }", true);
+        StreamRecord record;
+        EXPECT_TRUE(skr::json_read(&reader, record));
+        EXPECT_EQ(record.version, 3u);
+        EXPECT_EQ(record.count, 7);
+        EXPECT_NEAR(record.scale, 2.5f, 0.0001f);
+        EXPECT_EQ(record.name, skr::String(u8"mesh"));
+        EXPECT_EQ(record.values[0], 4);
+        EXPECT_EQ(record.values[1], 5);
+        EXPECT_EQ(record.values[2], 6);
+    }
+    SUBCASE("UnknownAndMissing")
+    {
+        // unknown members are skipped whatever their shape, missing ones keep their defaults
+        auto reader = JsonReader(u8"{ \"extra\": { \"nested\": [ 1, 2 ] }, \"count\": 9, \"other\": \"str\" }", true);
+        StreamRecord record;
+        EXPECT_TRUE(skr::json_read(&reader, record));
+        EXPECT_EQ(record.count, 9);
+        EXPECT_EQ(record.version, 0u);
+        EXPECT_NEAR(record.scale, 1.f, 0.0001f);
+        EXPECT_TRUE(record.name.is_empty());
+        EXPECT_EQ(record.values[0], 0);
+    }
+    SUBCASE("MatchesKeyed")
+    {
+        const char8_t* json = u8"{ \"name\": \"a\", \"count\": -1, \"version\": 2, \"unknown\": 0, \"scale\": 0.5, \"values\": [ 1, 2, 3 ] }";
+        StreamRecord keyed, streaming;
+        auto keyed_reader     = JsonReader(json);
+        auto streaming_reader = JsonReader(json, true);
+        EXPECT_TRUE(skr::json_read(&keyed_reader, keyed));
+        EXPECT_TRUE(skr::json_read(&streaming_reader, streaming));
+        EXPECT_EQ(keyed.version, streaming.version);
+        EXPECT_EQ(keyed.count, streaming.count);
+        EXPECT_EQ(keyed.scale, streaming.scale);
+        EXPECT_EQ(keyed.name, streaming.name);
+        for (uint32_t i = 0; i < 3; i++)
+            EXPECT_EQ(keyed.values[i], streaming.values[i]);
+    }
+    SUBCASE("ReadField")
+    {
+        auto reader = JsonReader(u8"{ \"count\": 1, \"unknown\": 2, \"version\": 3, \"scale\": \"bad\" }", true);
+        StreamRecord    record;
+        skr::StringView key;
+        EXPECT_OK(reader.StartObject());
+        EXPECT_TRUE(reader.NextField(key));
+        EXPECT_TRUE(skr::JsonSerde<StreamRecord>::read_field(&reader, record, key) == JsonFieldDispatch::Success);
+        EXPECT_TRUE(reader.NextField(key));
+        EXPECT_TRUE(skr::JsonSerde<StreamRecord>::read_field(&reader, record, key) == JsonFieldDispatch::NotFound);
+        // base fields are reached through the base dispatch
+        EXPECT_TRUE(reader.NextField(key));
+        EXPECT_TRUE(skr::JsonSerde<StreamRecord>::read_field(&reader, record, key) == JsonFieldDispatch::Success);
+        EXPECT_TRUE(reader.NextField(key));
+        EXPECT_TRUE(skr::JsonSerde<StreamRecord>::read_field(&reader, record, key) == JsonFieldDispatch::Failed);
+        EXPECT_FALSE(reader.NextField(key));
+        EXPECT_OK(reader.EndObject());
+        EXPECT_EQ(record.count, 1);
+        EXPECT_EQ(record.version, 3u);
+    }
+    SUBCASE("Failed")
+    {
+        auto reader = JsonReader(u8"{ \"count\": \"seven\" }", true);
+        StreamRecord record;
+        EXPECT_FALSE(skr::json_read(&reader, record));
+    }
+}
+
+// timing only, skipped by default: run with --no-skip -tc=StreamFieldsBench
+TEST_CASE_METHOD(JSONTests, "StreamFieldsBench" * doctest::skip())
+{
+    using namespace skr::archive;
+    // asset-meta like corpus: many objects with a few hundred fields each
+    constexpr uint32_t kAssetCount = 1000;
+    constexpr uint32_t kFieldCount = 256;
+    skr::Vector<skr::String> names;
+    for (uint32_t i = 0; i < kFieldCount; i++)
+        names.add(skr::format(u8"field_name_of_asset_meta_{}", i));
+
+    _JsonWriter writer(3);
+    EXPECT_OK(writer.StartObject(u8""));
+    EXPECT_OK(writer.StartArray(u8"assets"));
+    for (uint32_t a = 0; a < kAssetCount; a++)
+    {
+        EXPECT_OK(writer.StartObject(u8""));
+        for (uint32_t i = 0; i < kFieldCount; i++)
+            EXPECT_OK(writer.WriteValue(names[i].view(), (int32_t)(a + i)));
+        EXPECT_OK(writer.EndObject());
+    }
+    EXPECT_OK(writer.EndArray());
+    EXPECT_OK(writer.EndObject());
+    const auto json = writer.Write();
+
+    // perfect hash table like the generated serde: slot -> field index
+    uint32_t              seed = 0, mask = 1;
+    skr::Vector<uint32_t> slots;
+    auto                  try_seed = [&](uint32_t s) {
+        slots.clear();
+        slots.resize(mask + 1, UINT32_MAX);
+        for (uint32_t i = 0; i < kFieldCount; i++)
+        {
+            auto& slot = slots[json_field_hash(names[i].view(), s) & mask];
+            if (slot != UINT32_MAX)
+                return false;
+            slot = i;
+        }
+        return true;
+    };
+    while (mask + 1 < kFieldCount)
+        mask = (mask << 1) | 1;
+    while (true)
+    {
+        for (seed = 0; seed < 4096 && !try_seed(seed); seed++) {}
+        if (seed < 4096)
+            break;
+        mask = (mask << 1) | 1;
+    }
+
+    skr::Vector<int32_t> values;
+    values.resize_zeroed(kFieldCount);
+    int64_t sum_keyed = 0, sum_streaming = 0;
+
+    const int64_t keyed_start = skr_sys_get_usec(true);
+    {
+        JsonReader reader(json.view());
+        size_t     count = 0;
+        EXPECT_OK(reader.StartObject());
+        EXPECT_OK(reader.Key(u8"assets"));
+        EXPECT_OK(reader.StartArray(count));
+        for (size_t a = 0; a < count; a++)
+        {
+            EXPECT_OK(reader.StartObject());
+            for (uint32_t i = 0; i < kFieldCount; i++)
+            {
+                EXPECT_OK(reader.Key(names[i].view()));
+                EXPECT_OK(reader.Int32(values[i]));
+                sum_keyed += values[i];
+            }
+            EXPECT_OK(reader.EndObject());
+        }
+        EXPECT_OK(reader.EndArray());
+        EXPECT_OK(reader.EndObject());
+    }
+    const int64_t keyed_end = skr_sys_get_usec(true);
+
+    const int64_t streaming_start = skr_sys_get_usec(true);
+    {
+        JsonReader reader(json.view(), true);
+        size_t     count = 0;
+        EXPECT_OK(reader.StartObject());
+        EXPECT_OK(reader.Key(u8"assets"));
+        EXPECT_OK(reader.StartArray(count));
+        for (size_t a = 0; a < count; a++)
+        {
+            EXPECT_OK(reader.StartObject());
+            skr::StringView key;
+            while (reader.NextField(key))
+            {
+                const uint32_t i = slots[json_field_hash(key, seed) & mask];
+                if (i != UINT32_MAX && key == names[i].view())
+                {
+                    EXPECT_OK(reader.Int32(values[i]));
+                    sum_streaming += values[i];
+                }
+            }
+            EXPECT_OK(reader.EndObject());
+        }
+        EXPECT_OK(reader.EndArray());
+        EXPECT_OK(reader.EndObject());
+    }
+    const int64_t streaming_end = skr_sys_get_usec(true);
+
+    EXPECT_EQ(sum_keyed, sum_streaming);
+    SKR_LOG_INFO(u8"JSON READ %u assets x %u fields: keyed %lldus, streaming %lldus",
+        kAssetCount, kFieldCount, keyed_end - keyed_start, streaming_end - streaming_start);
+}
@@ -0,0 +1,71 @@
+#include "SkrCore/process.h"
+#include "SkrCore/time.h"
+#include "SkrOS/thread.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "SkrTestFramework/framework.hpp"
+
+#if defined(_WIN32)
+static const char8_t* kShell = u8"cmd.exe";
+static const char8_t* kExitArgs[] = { u8"/c", u8"exit 3" };
+static const char8_t* kEchoArgs[] = { u8"/c", u8"echo hello" };
+static const char8_t* kSleepArgs[] = { u8"/c", u8"ping -n 2 127.0.0.1 > nul & exit 5" };
+#else
+static const char8_t* kShell = u8"/bin/sh";
+static const char8_t* kExitArgs[] = { u8"-c", u8"exit 3" };
+static const char8_t* kEchoArgs[] = { u8"-c", u8"echo hello" };
+static const char8_t* kSleepArgs[] = { u8"-c", u8"sleep 1; exit 5" };
+#endif
+
+struct ProcessTests
+{
+};
+
+TEST_CASE_METHOD(ProcessTests, "Wait")
+{
+    // the arguments follow the program, the exit code comes back from the wait
+    auto process = skr_run_process(kShell, kExitArgs, 2, nullptr);
+    REQUIRE(process != nullptr);
+    EXPECT_NE(skr_get_process_id(process), 0u);
+    EXPECT_EQ(skr_wait_process(process), 3);
+}
+
+TEST_CASE_METHOD(ProcessTests, "TryWait")
+{
+    auto process = skr_run_process(kShell, kSleepArgs, 2, nullptr);
+    REQUIRE(process != nullptr);
+    int exit_code = -1;
+    EXPECT_FALSE(skr_try_wait_process(process, &exit_code));
+
+    const auto start = skr_sys_get_usec(false);
+    while (!skr_try_wait_process(process, &exit_code))
+    {
+        REQUIRE(skr_sys_get_usec(false) - start < 30 * 1000 * 1000);
+        skr_thread_sleep(10);
+    }
+    EXPECT_EQ(exit_code, 5);
+
+    // the handle stays valid after the process exited
+    exit_code = -1;
+    EXPECT_TRUE(skr_try_wait_process(process, &exit_code));
+    EXPECT_EQ(exit_code, 5);
+    EXPECT_EQ(skr_wait_process(process), 5);
+}
+
+TEST_CASE_METHOD(ProcessTests, "StdoutFile")
+{
+    const char8_t* path = u8"./test_process_stdout.txt";
+    remove((const char*)path);
+    auto process = skr_run_process(kShell, kEchoArgs, 2, path);
+    REQUIRE(process != nullptr);
+    EXPECT_EQ(skr_wait_process(process), 0);
+
+    char content[64] = { 0 };
+    auto file = fopen((const char*)path, "rb");
+    REQUIRE(file != nullptr);
+    fread(content, 1, sizeof(content) - 1, file);
+    fclose(file);
+    EXPECT_EQ(strncmp(content, "hello", 5), 0);
+    remove((const char*)path);
+}
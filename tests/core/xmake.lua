@@ -1,6 +1,11 @@
-test_target("JsonTest")
+codegen_component("JsonTest", { api = "JSON_TEST", rootdir = "json" })
+    add_files("json/**.hpp")
+
+executable_module("JsonTest", "JSON_TEST", engine_version)
     set_group("05.tests/core")
+    set_kind("binary")
     public_dependency("SkrCore", engine_version)
+    add_deps("SkrTestFramework", {public = false})
     add_rules("c++.unity_build", {batchsize = default_unity_batch})
     add_files("json/main.cpp")
 
@@ -8,4 +13,9 @@ test_target("SerdeTest")
     set_group("05.tests/core")
     public_dependency("SkrCore", engine_version)
     add_rules("c++.unity_build", {batchsize = default_unity_batch})
-    add_files("serde/main.cpp")
\ No newline at end of file
+    add_files("serde/main.cpp")
+
+test_target("ProcessTest")
+    set_group("05.tests/core")
+    public_dependency("SkrCore", engine_version)
+    add_files("process/main.cpp")
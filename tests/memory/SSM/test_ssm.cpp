@@ -51,4 +51,47 @@ TEST_CASE_METHOD(MMapTests, "sysmem_pool")
         sakura_sysmem_pool_free(sysmem_pool, p);
         sakura_sysmem_pool_destroy(sysmem_pool);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(MMapTests, "sysmem_pool_pages")
+{
+    {
+        SSysMemoryPoolDesc pool_desc = {};
+        pool_desc.pool_name = "sysmem_pool_huge";
+        pool_desc.size = 8 * 1024 * 1024;
+        pool_desc.use_huge_page = true;
+        pool_desc.thread_safe = true;
+
+        // huge pages are rarely available, but the pool must always fall back to something usable
+        auto sysmem_pool = sakura_sysmem_pool_create(&pool_desc);
+        EXPECT_NE(sysmem_pool, nullptr);
+        SSysMemoryPoolInfo info = {};
+        sakura_sysmem_pool_get_info(sysmem_pool, &info);
+        EXPECT_GE(info.size, pool_desc.size);
+        EXPECT_EQ(info.numa_node, -1);
+        auto p = (uint8_t*)sakura_sysmem_pool_malloc(sysmem_pool, 64 * 1024);
+        EXPECT_NE(p, nullptr);
+        EXPECT_TRUE(sakura_sysmem_pool_contains(sysmem_pool, p));
+        p[64 * 1024 - 1] = 2;
+        EXPECT_EQ(p[64 * 1024 - 1], 2);
+        sakura_sysmem_pool_free(sysmem_pool, p);
+        sakura_sysmem_pool_destroy(sysmem_pool);
+    }
+    {
+        SSysMemoryPoolDesc pool_desc = {};
+        pool_desc.pool_name = "sysmem_pool_numa";
+        pool_desc.size = 2 * 1024 * 1024;
+
+        auto pools = sakura_sysmem_numa_pools_create(&pool_desc);
+        EXPECT_EQ(sakura_sysmem_numa_pools_count(pools), sakura_sysmem_numa_node_count());
+        auto local = sakura_sysmem_numa_pools_local(pools);
+        EXPECT_NE(local, nullptr);
+        SSysMemoryPoolInfo info = {};
+        sakura_sysmem_pool_get_info(local, &info);
+        EXPECT_EQ(info.numa_node, (int32_t)sakura_sysmem_current_numa_node());
+        auto p = (uint8_t*)sakura_sysmem_pool_malloc(local, 64);
+        EXPECT_NE(p, nullptr);
+        sakura_sysmem_pool_free(local, p);
+        sakura_sysmem_numa_pools_destroy(pools);
+    }
+}
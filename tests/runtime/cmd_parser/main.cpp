@@ -0,0 +1,40 @@
+#include "SkrRT/misc/cmd_parser.hpp"
+
+#include "SkrTestFramework/framework.hpp"
+
+struct CmdParserTests
+{
+};
+
+TEST_CASE_METHOD(CmdParserTests, "Values")
+{
+    const char* args[] = { "app", "-j", "8", "-s", "1.5", "-n", "name", "--flag" };
+    skr::cmd::parser parser(8, (char**)args);
+    parser.add(u8"jobs", u8"an integer", u8"-j", true);
+    parser.add(u8"scale", u8"a float", u8"-s", false);
+    parser.add(u8"name", u8"a string", u8"-n", false);
+    parser.add(u8"flag", u8"a boolean", u8"--flag", false, true);
+    parser.add(u8"missing", u8"never passed", u8"-m", false);
+    REQUIRE(parser.parse());
+    EXPECT_EQ(parser.get<uint32_t>(u8"jobs"), 8u);
+    EXPECT_EQ(parser.get<float>(u8"scale"), 1.5f);
+    EXPECT_EQ(parser.get<skr::String>(u8"name"), u8"name");
+    EXPECT_TRUE(parser.parsed(u8"flag"));
+    EXPECT_FALSE(parser.parsed(u8"missing"));
+}
+
+TEST_CASE_METHOD(CmdParserTests, "Errors")
+{
+    // a required option is missing
+    const char* missing[] = { "app", "-s", "1.5" };
+    skr::cmd::parser parser(3, (char**)missing);
+    parser.add(u8"jobs", u8"an integer", u8"-j", true);
+    parser.add(u8"scale", u8"a float", u8"-s", false);
+    EXPECT_FALSE(parser.parse());
+
+    // unknown shorthands are refused
+    const char* unknown[] = { "app", "-x", "1" };
+    skr::cmd::parser unknown_parser(3, (char**)unknown);
+    unknown_parser.add(u8"jobs", u8"an integer", u8"-j", false);
+    EXPECT_FALSE(unknown_parser.parse());
+}
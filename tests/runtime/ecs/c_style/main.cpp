@@ -1,6 +1,7 @@
 #include "SkrBase/misc/make_zeroed.hpp"
 #include "SkrBase/atomic/atomic.h"
 #include "SkrCore/log.h"
+#include "SkrCore/time.h"
 #include "SkrTask/parallel_for.hpp"
 #include "SkrRT/ecs/sugoi.h"
 #include "SkrRT/ecs/array.hpp"
@@ -498,6 +499,92 @@ TEST_CASE_METHOD(ECSTest, "query_overload")
     }
 }
 
+static double bench_chunk_iteration(uint32_t entity_count, uint32_t iterations)
+{
+    auto storage = sugoiS_create();
+    {
+        sugoi_entity_type_t entityType;
+        sugoi_type_index_t  type[2] = { type_test, type_test2 };
+        std::sort(type, type + 2);
+        entityType.type = { type, 2 };
+        entityType.meta = { nullptr, 0 };
+        auto callback   = [&](sugoi_chunk_view_t* inView) {
+            auto comps = (TestComp*)sugoiV_get_owned_rw(inView, type_test);
+            for (uint32_t i = 0; i < inView->count; i++)
+                comps[i] = (TestComp)i;
+        };
+        sugoiS_allocate_type(storage, &entityType, entity_count, SUGOI_LAMBDA(callback));
+    }
+    auto    query = sugoiQ_from_literal(storage, u8"[inout]test, [in]test2");
+    int64_t sum   = 0;
+    auto    callback = [&](sugoi_chunk_view_t* inView) {
+        auto comps = (TestComp*)sugoiV_get_owned_rw(inView, type_test);
+        for (uint32_t i = 0; i < inView->count; i++)
+        {
+            comps[i] += 1;
+            sum += comps[i];
+        }
+    };
+    const int64_t start = skr_sys_get_usec(true);
+    for (uint32_t i = 0; i < iterations; i++)
+        sugoiQ_get_views(query, SUGOI_LAMBDA(callback));
+    const int64_t end = skr_sys_get_usec(true);
+    EXPECT_NE(sum, 0);
+    sugoiQ_release(query);
+    sugoiS_release(storage);
+    return (double)(end - start) / 1000.0;
+}
+
+TEST_CASE("chunk_memory_pool")
+{
+    SSysMemoryPoolDesc pool_desc = {};
+    pool_desc.pool_name   = "sugoi_chunks";
+    pool_desc.size        = 64ull * 1024ull * 1024ull;
+    pool_desc.thread_safe = true;
+    auto pool             = sakura_sysmem_pool_create(&pool_desc);
+    EXPECT_NE(pool, nullptr);
+
+    EXPECT_TRUE(sugoi_set_chunk_memory_pool(pool));
+    auto storage = sugoiS_create();
+    sugoi_entity_type_t entityType;
+    entityType.type = { &type_test, 1 };
+    entityType.meta = { nullptr, 0 };
+    sugoiS_allocate_type(storage, &entityType, 1024, nullptr, nullptr);
+    // chunks of the pool are alive, it can't be swapped out
+    EXPECT_FALSE(sugoi_set_chunk_memory_pool(nullptr));
+    sugoiS_release(storage);
+    bench_chunk_iteration(64 * 1024, 1);
+    EXPECT_TRUE(sugoi_set_chunk_memory_pool(nullptr));
+    sakura_sysmem_pool_destroy(pool);
+}
+
+// timing only, skipped by default: run with --no-skip -tc=chunk_iteration_bench
+TEST_CASE("chunk_iteration_bench" * doctest::skip())
+{
+    constexpr uint32_t kEntityCount = 4 * 1024 * 1024;
+    constexpr uint32_t kIterations  = 16;
+
+    const double default_ms = bench_chunk_iteration(kEntityCount, kIterations);
+
+    SSysMemoryPoolDesc pool_desc = {};
+    pool_desc.pool_name     = "sugoi_chunks";
+    pool_desc.size          = 256ull * 1024ull * 1024ull;
+    pool_desc.use_huge_page = true;
+    pool_desc.thread_safe   = true;
+    auto pool               = sakura_sysmem_pool_create(&pool_desc);
+    EXPECT_NE(pool, nullptr);
+    SSysMemoryPoolInfo pool_info = {};
+    sakura_sysmem_pool_get_info(pool, &pool_info);
+
+    EXPECT_TRUE(sugoi_set_chunk_memory_pool(pool));
+    const double pooled_ms = bench_chunk_iteration(kEntityCount, kIterations);
+    EXPECT_TRUE(sugoi_set_chunk_memory_pool(nullptr));
+    sakura_sysmem_pool_destroy(pool);
+
+    SKR_LOG_INFO(u8"chunk iteration (%u entities x %u): default pages %.3fms, pool pages(kind %d) %.3fms",
+        kEntityCount, kIterations, default_ms, (int)pool_info.page_kind, pooled_ms);
+}
+
 void register_test_component()
 {
     using namespace skr::literals;
@@ -89,4 +89,816 @@ TEST_CASE_METHOD(GraphTest, "RenderGraphFrontEnd")
     render_graph::RenderPassExecuteFunction());
     render_graph::RenderGraphViz::write_graphviz(*graph, "render_graph.gv");
     render_graph::RenderGraph::destroy(graph);
-}
\ No newline at end of file
+}
+TEST_CASE_METHOD(GraphTest, "DependencyGraphTraversal")
+{
+    using Node = skr::DependencyGraphNode;
+    using Edge = skr::DependencyGraphEdge;
+    // 0 -> 1 -> 3
+    // 0 -> 2 -> 3 -> 4, 5 alone
+    TestRDGNode n0(u8"n0"), n1(u8"n1"), n2(u8"n2"), n3(u8"n3"), n4(u8"n4"), n5(u8"n5");
+    Edge edges[5];
+    auto rdg = skr::DependencyGraph::Create();
+    for (auto node : { &n0, &n1, &n2, &n3, &n4, &n5 })
+        rdg->insert(node);
+    rdg->link(&n0, &n1, &edges[0]);
+    rdg->link(&n0, &n2, &edges[1]);
+    rdg->link(&n1, &n3, &edges[2]);
+    rdg->link(&n2, &n3, &edges[3]);
+    rdg->link(&n3, &n4, &edges[4]);
+
+    // neighbors are the sources of links pointing to the node
+    EXPECT_EQ(rdg->outgoing_edges(&n3), 2);
+    EXPECT_EQ(rdg->incoming_edges(&n3), 1);
+    skr::String sources;
+    n3.foreach_neighbors([&](Node* n) { sources += ((TestRDGNode*)n)->name; });
+    EXPECT_EQ(sources, u8"n1n2");
+    uint32_t targets = n0.foreach_inv_neighbors([](const Node*) {});
+    EXPECT_EQ(targets, 2);
+    rdg->foreach_incoming_edges(&n3, [&](Node* from, Node* to, Edge* e) {
+        EXPECT_EQ(from, &n3);
+        EXPECT_EQ(to, &n4);
+        EXPECT_EQ(e, &edges[4]);
+    });
+
+    skr::stl_vector<skr::dag_id_t> order;
+    EXPECT_TRUE(rdg->topological_sort(order));
+    EXPECT_EQ(order.size(), 6);
+    skr::stl_vector<uint32_t> rank(order.size());
+    for (uint32_t i = 0; i < order.size(); i++)
+        rank[order[i]] = i;
+    rdg->foreach_edges([&](Node* from, Node* to, Edge*) {
+        EXPECT_TRUE(rank[from->get_id()] < rank[to->get_id()]);
+    });
+    // ties go to the lower id, n5 is ready from the start but comes last
+    for (uint32_t i = 0; i < order.size(); i++)
+        EXPECT_EQ(order[i], i);
+
+    EXPECT_TRUE(rdg->reachable(n0.get_id(), n4.get_id()));
+    EXPECT_FALSE(rdg->reachable(n4.get_id(), n0.get_id()));
+    EXPECT_FALSE(rdg->reachable(n0.get_id(), n5.get_id()));
+    EXPECT_EQ(rdg->foreach_reachable(n0.get_id(), [](Node*) {}), 4);
+    EXPECT_EQ(rdg->foreach_inv_reachable(n3.get_id(), [](Node*) {}), 3);
+
+    // removing a node drops its links
+    rdg->remove(&n3);
+    EXPECT_EQ(rdg->incoming_edges(&n1), 0);
+    EXPECT_EQ(rdg->outgoing_edges(&n4), 0);
+    EXPECT_FALSE(rdg->reachable(n0.get_id(), n4.get_id()));
+
+    // cycles are reported
+    rdg->link(&n4, &n0);
+    rdg->link(&n0, &n4);
+    EXPECT_FALSE(rdg->topological_sort(order));
+    EXPECT_EQ(order.size(), 1); // only n5 is outside of the cycle
+
+    skr::DependencyGraph::Destroy(rdg);
+}
+
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
+
+// timing only, skipped by default: run with --no-skip -tc=DependencyGraphBench
+TEST_CASE_METHOD(GraphTest, "DependencyGraphBench" * doctest::skip())
+{
+    using Node = skr::DependencyGraphNode;
+    using Edge = skr::DependencyGraphEdge;
+    // synthetic render graph: every pass writes 2 fresh textures and reads 4 earlier ones
+    constexpr uint32_t kPassCount = 2000;
+    constexpr uint32_t kWritesPerPass = 2;
+    constexpr uint32_t kReadsPerPass = 4;
+    constexpr uint32_t kFrameCount = 100;
+    struct BenchNode : public Node {
+        bool is_pass = false;
+    };
+    skr::stl_vector<BenchNode> passes(kPassCount);
+    skr::stl_vector<BenchNode> textures(kPassCount * kWritesPerPass);
+    skr::stl_vector<Edge> edges(kPassCount * (kWritesPerPass + kReadsPerPass));
+    for (auto& pass : passes)
+        pass.is_pass = true;
+
+    auto rdg = skr::DependencyGraph::Create();
+    skr::stl_vector<skr::dag_id_t> order;
+    uint64_t build_us = 0, query_us = 0, sort_us = 0;
+    uint64_t checksum = 0;
+    for (uint32_t frame = 0; frame < kFrameCount; frame++)
+    {
+        uint32_t seed = 0x9E3779B9u;
+        auto rand = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+        auto start = skr_sys_get_usec(true);
+        rdg->clear();
+        uint32_t edge_idx = 0;
+        for (uint32_t p = 0; p < kPassCount; p++)
+        {
+            rdg->insert(&passes[p]);
+            for (uint32_t r = 0; p && r < kReadsPerPass; r++)
+            {
+                auto& tex = textures[rand() % (p * kWritesPerPass)];
+                rdg->link(&tex, &passes[p], &edges[edge_idx++]);
+            }
+            for (uint32_t w = 0; w < kWritesPerPass; w++)
+            {
+                auto& tex = textures[p * kWritesPerPass + w];
+                rdg->insert(&tex);
+                rdg->link(&passes[p], &tex, &edges[edge_idx++]);
+            }
+        }
+        rdg->build();
+        auto built = skr_sys_get_usec(true);
+
+        // cull + lifespan style queries
+        for (auto& tex : textures)
+        {
+            const bool lone = !(tex.incoming_edges() + tex.outgoing_edges());
+            uint32_t from = UINT32_MAX, to = 0;
+            auto visit = [&](const Node* n) {
+                const auto id = (uint32_t)n->get_id();
+                from = (from <= id) ? from : id;
+                to = (to >= id) ? to : id;
+            };
+            tex.foreach_neighbors(visit);
+            tex.foreach_inv_neighbors(visit);
+            checksum += lone + from + to;
+        }
+        auto queried = skr_sys_get_usec(true);
+
+        EXPECT_TRUE(rdg->topological_sort(order));
+        checksum += order.back();
+        auto sorted = skr_sys_get_usec(true);
+
+        build_us += built - start;
+        query_us += queried - built;
+        sort_us += sorted - queried;
+    }
+    EXPECT_EQ(order.size(), kPassCount * (1 + kWritesPerPass));
+    SKR_LOG_INFO(u8"DependencyGraph %u passes x %u frames: build %.1fus, queries %.1fus, toposort %.1fus per frame (checksum %llu)",
+        kPassCount, kFrameCount,
+        (double)build_us / kFrameCount, (double)query_us / kFrameCount, (double)sort_us / kFrameCount,
+        (unsigned long long)checksum);
+    skr::DependencyGraph::Destroy(rdg);
+}
+
+#include "SkrRenderGraph/backend/transient_memory_planner.hpp"
+
+using TransientMemoryPlanner = skr::render_graph::TransientMemoryPlanner;
+
+static bool transient_plan_valid(const TransientMemoryPlanner& planner)
+{
+    const auto& requests = planner.get_requests();
+    const auto& placements = planner.get_placements();
+    const auto& heaps = planner.get_heaps();
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        const auto& a = requests[i];
+        const auto& pa = placements[i];
+        if (pa.heap >= heaps.size()) return false;
+        if (heaps[pa.heap].heap_class != a.heap_class) return false;
+        if (pa.offset % a.alignment) return false;
+        if (pa.offset + a.size > heaps[pa.heap].size) return false;
+        for (uint32_t j = i + 1; j < requests.size(); j++)
+        {
+            const auto& b = requests[j];
+            const auto& pb = placements[j];
+            if (pa.heap != pb.heap) continue;
+            const bool alive_together = a.first_pass <= b.last_pass && b.first_pass <= a.last_pass;
+            const bool share_memory = pa.offset < pb.offset + b.size && pb.offset < pa.offset + a.size;
+            if (alive_together && share_memory) return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE_METHOD(GraphTest, "TransientMemoryPlanner")
+{
+    constexpr uint64_t kMB = 1024 * 1024;
+    TransientMemoryPlanner planner;
+
+    SUBCASE("DisjointLifetimesAlias")
+    {
+        planner.add({ 8 * kMB, 64 * 1024, 0, 1, 0 });
+        planner.add({ 4 * kMB, 64 * 1024, 2, 3, 0 });
+        planner.add({ 8 * kMB, 64 * 1024, 4, 5, 0 });
+        planner.plan(256 * kMB);
+        EXPECT_TRUE(transient_plan_valid(planner));
+        EXPECT_EQ(planner.get_heaps().size(), 1);
+        EXPECT_EQ(planner.get_heaps()[0].size, 8 * kMB);
+        EXPECT_EQ(planner.get_statistics().requested_bytes, 20 * kMB);
+        EXPECT_EQ(planner.get_statistics().saved_bytes(), 12 * kMB);
+    }
+
+    SUBCASE("OverlappingLifetimesPacked")
+    {
+        planner.add({ 8 * kMB, 64 * 1024, 0, 4, 0 });
+        planner.add({ 3 * kMB, 4 * kMB, 1, 2, 0 });
+        planner.add({ 3 * kMB, 64 * 1024, 2, 3, 0 });
+        planner.add({ 6 * kMB, 64 * 1024, 5, 6, 0 });
+        planner.plan(256 * kMB);
+        EXPECT_TRUE(transient_plan_valid(planner));
+        EXPECT_EQ(planner.get_heaps().size(), 1);
+        EXPECT_EQ(planner.get_placements()[1].offset % (4 * kMB), 0);
+        // the last one reuses the memory of the first
+        EXPECT_EQ(planner.get_placements()[3].offset, 0);
+    }
+
+    SUBCASE("HeapClassesAndLimits")
+    {
+        planner.add({ 8 * kMB, 64 * 1024, 0, 1, 0 });
+        planner.add({ 8 * kMB, 64 * 1024, 2, 3, 1 });
+        planner.add({ 8 * kMB, 64 * 1024, 0, 3, 0 });
+        planner.add({ 32 * kMB, 64 * 1024, 0, 3, 2 });
+        planner.plan(16 * kMB);
+        EXPECT_TRUE(transient_plan_valid(planner));
+        // class 0 fits in one 16MB heap, class 1 & the oversized class 2 get their own
+        EXPECT_EQ(planner.get_heaps().size(), 3);
+        planner.plan(8 * kMB);
+        EXPECT_TRUE(transient_plan_valid(planner));
+        EXPECT_EQ(planner.get_heaps().size(), 4);
+    }
+
+    SUBCASE("ShapeHash")
+    {
+        planner.add({ 8 * kMB, 64 * 1024, 0, 1, 0 });
+        planner.add({ 4 * kMB, 64 * 1024, 1, 2, 0 });
+        const auto hash = planner.shape_hash();
+        planner.plan(256 * kMB);
+        const auto placement = planner.get_placements()[1];
+
+        planner.reset();
+        EXPECT_EQ(planner.get_placements().size(), 2);
+        planner.add({ 8 * kMB, 64 * 1024, 0, 1, 0 });
+        planner.add({ 4 * kMB, 64 * 1024, 1, 2, 0 });
+        EXPECT_EQ(planner.shape_hash(), hash);
+        planner.plan(256 * kMB);
+        EXPECT_EQ(planner.get_placements()[1].heap, placement.heap);
+        EXPECT_EQ(planner.get_placements()[1].offset, placement.offset);
+
+        planner.reset();
+        planner.add({ 8 * kMB, 64 * 1024, 0, 1, 0 });
+        planner.add({ 4 * kMB, 64 * 1024, 0, 2, 0 });
+        EXPECT_NE(planner.shape_hash(), hash);
+    }
+}
+
+// timing only, skipped by default: run with --no-skip -tc=TransientMemoryPlannerBench
+TEST_CASE_METHOD(GraphTest, "TransientMemoryPlannerBench" * doctest::skip())
+{
+    // synthetic frame: resources of 64KB..64MB living for a few passes, spread over 3 heap classes
+    constexpr uint32_t kPassCounts[] = { 256, 2048, 8192 };
+    constexpr uint32_t kResourcesPerPass = 2;
+    constexpr uint32_t kFrameCount = 20;
+    for (const auto pass_count : kPassCounts)
+    {
+        uint32_t seed = 0x9E3779B9u;
+        auto rand = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+        TransientMemoryPlanner planner;
+        uint64_t build_us = 0, hash_us = 0, plan_us = 0;
+        for (uint32_t frame = 0; frame < kFrameCount; frame++)
+        {
+            seed = 0x9E3779B9u;
+            auto start = skr_sys_get_usec(true);
+            planner.reset();
+            for (uint32_t p = 0; p < pass_count; p++)
+            {
+                for (uint32_t r = 0; r < kResourcesPerPass; r++)
+                {
+                    const uint64_t size = (64ull * 1024) << (rand() % 11);
+                    const uint32_t last = p + 1 + rand() % 16;
+                    const uint64_t alignment = (rand() % 8) ? 64 * 1024 : 4 * 1024 * 1024;
+                    planner.add({ size, alignment, p, last < pass_count ? last : pass_count - 1, rand() % 3 });
+                }
+            }
+            auto built = skr_sys_get_usec(true);
+            const auto hash = planner.shape_hash();
+            auto hashed = skr_sys_get_usec(true);
+            planner.plan(256ull * 1024 * 1024);
+            auto planned = skr_sys_get_usec(true);
+            (void)hash;
+
+            build_us += built - start;
+            hash_us += hashed - built;
+            plan_us += planned - hashed;
+        }
+        if (pass_count <= 2048)
+        {
+            EXPECT_TRUE(transient_plan_valid(planner));
+        }
+        const auto& stats = planner.get_statistics();
+        EXPECT_EQ(stats.request_count, pass_count * kResourcesPerPass);
+        EXPECT_TRUE(stats.heap_bytes <= stats.requested_bytes);
+        SKR_LOG_INFO(u8"TransientMemoryPlanner %u resources x %u frames: build %.1fus, hash %.1fus, plan %.1fus per frame, "
+               "%.1fMB requested in %u heaps of %.1fMB (%.1f%% saved)",
+            stats.request_count, kFrameCount,
+            (double)build_us / kFrameCount, (double)hash_us / kFrameCount, (double)plan_us / kFrameCount,
+            (double)stats.requested_bytes / (1024.0 * 1024.0), stats.heap_count, (double)stats.heap_bytes / (1024.0 * 1024.0),
+            100.0 * (double)stats.saved_bytes() / (double)stats.requested_bytes);
+    }
+}
+
+#include "SkrGraphics/api.h"
+#include "SkrGraphics/backend/null/cgpu_null.h"
+
+// the render graph backend running headless on the null cgpu backend
+struct RenderGraphNullDevice
+{
+    RenderGraphNullDevice()
+    {
+        SKR_DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        desc.enable_debug_layer = true;
+        instance = cgpu_create_instance(&desc);
+        uint32_t adapters_count = 1;
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+        CGPUQueueGroupDescriptor queue_groups[] = {
+            { CGPU_QUEUE_TYPE_GRAPHICS, 1 },
+            { CGPU_QUEUE_TYPE_COMPUTE, 1 },
+            { CGPU_QUEUE_TYPE_TRANSFER, 1 }
+        };
+        SKR_DECLARE_ZERO(CGPUDeviceDescriptor, device_desc)
+        device_desc.queue_groups = queue_groups;
+        device_desc.queue_group_count = 3;
+        device = cgpu_create_device(adapter, &device_desc);
+        queue = cgpu_get_queue(device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
+        cmpt_queue = cgpu_get_queue(device, CGPU_QUEUE_TYPE_COMPUTE, 0);
+        cpy_queue = cgpu_get_queue(device, CGPU_QUEUE_TYPE_TRANSFER, 0);
+    }
+
+    ~RenderGraphNullDevice()
+    {
+        cgpu_free_queue(cpy_queue);
+        cgpu_free_queue(cmpt_queue);
+        cgpu_free_queue(queue);
+        cgpu_free_device(device);
+        cgpu_free_instance(instance);
+    }
+
+    skr::render_graph::RenderGraph* create_graph(uint32_t recording_workers = 1, bool async_queues = false)
+    {
+        return skr::render_graph::RenderGraph::create(
+        [this, recording_workers, async_queues](skr::render_graph::RenderGraphBuilder& builder) {
+            builder.with_device(device)
+            .with_gfx_queue(queue)
+            .enable_memory_aliasing()
+            .with_recording_workers(recording_workers);
+            if (async_queues)
+                builder.with_cmpt_queue(cmpt_queue).with_cpy_queue(cpy_queue);
+        });
+    }
+
+    CGPUNullDeviceStatistics statistics()
+    {
+        CGPUNullDeviceStatistics stats = {};
+        cgpu_null_query_device_statistics(device, &stats);
+        return stats;
+    }
+
+    CGPUInstanceId instance = nullptr;
+    CGPUAdapterId adapter = nullptr;
+    CGPUDeviceId device = nullptr;
+    CGPUQueueId queue = nullptr;
+    CGPUQueueId cmpt_queue = nullptr;
+    CGPUQueueId cpy_queue = nullptr;
+};
+
+// a chain of copies through transient textures, plus a lone texture & a lone pass for the cull phase.
+// with a transfer stride, the second half of every stride of copies prefers the transfer queue
+static void declare_copy_chain(skr::render_graph::RenderGraph* graph, uint32_t pass_count, uint32_t transfer_stride = 0)
+{
+    namespace render_graph = skr::render_graph;
+    auto texture = [graph](uint32_t size) {
+        return graph->create_texture(
+        [size](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.extent(size, size)
+            .format(CGPU_FORMAT_R8G8B8A8_UNORM)
+            .allow_render_target();
+        });
+    };
+    texture(64);
+    graph->add_copy_pass(
+    [](render_graph::RenderGraph&, render_graph::CopyPassBuilder&) {},
+    [](render_graph::RenderGraph&, render_graph::CopyPassContext&) {});
+    auto previous = texture(256);
+    for (uint32_t i = 0; i < pass_count; i++)
+    {
+        auto next = texture(128u << (i % 3));
+        const bool transfer = transfer_stride && (i % transfer_stride) >= transfer_stride / 2;
+        graph->add_copy_pass(
+        [previous, next, transfer](render_graph::RenderGraph&, render_graph::CopyPassBuilder& builder) {
+            builder.texture_to_texture(previous, next);
+            if (transfer)
+                builder.set_queue_affinity(CGPU_QUEUE_TYPE_TRANSFER);
+        },
+        [](render_graph::RenderGraph&, render_graph::CopyPassContext&) {});
+        previous = next;
+    }
+}
+
+TEST_CASE_METHOD(RenderGraphNullDevice, "RenderGraphCompileCache")
+{
+    SUBCASE("ReplayRecordsTheSameCommands")
+    {
+        // the same frames once compiled from scratch & once replayed from the cache
+        constexpr uint32_t kFrameCount = 6;
+        uint64_t recorded_bytes[2][kFrameCount] = {};
+        uint64_t validation_errors[2][kFrameCount] = {};
+        for (uint32_t cached = 0; cached < 2; cached++)
+        {
+            auto graph = create_graph();
+            graph->enable_compile_cache(cached);
+            for (uint32_t frame = 0; frame < kFrameCount; frame++)
+            {
+                const auto before = statistics();
+                declare_copy_chain(graph, 32);
+                graph->compile();
+                EXPECT_EQ(graph->is_compile_cached(), cached && frame > 0);
+                graph->execute();
+                const auto after = statistics();
+                recorded_bytes[cached][frame] = after.recorded_bytes - before.recorded_bytes;
+                validation_errors[cached][frame] = after.validation_errors - before.validation_errors;
+            }
+            skr::render_graph::RenderGraph::destroy(graph);
+        }
+        for (uint32_t frame = 0; frame < kFrameCount; frame++)
+        {
+            EXPECT_EQ(recorded_bytes[0][frame], recorded_bytes[1][frame]);
+            EXPECT_EQ(validation_errors[0][frame], validation_errors[1][frame]);
+        }
+    }
+
+    SUBCASE("TopologyChangeRecompiles")
+    {
+        auto graph = create_graph();
+        const uint32_t pass_counts[] = { 8, 8, 9, 9, 8 };
+        const bool expected_cached[] = { false, true, false, true, false };
+        uint64_t hashes[5] = {};
+        for (uint32_t frame = 0; frame < 5; frame++)
+        {
+            declare_copy_chain(graph, pass_counts[frame]);
+            graph->compile();
+            EXPECT_EQ(graph->is_compile_cached(), expected_cached[frame]);
+            hashes[frame] = graph->get_topology_hash();
+            graph->execute();
+        }
+        EXPECT_EQ(hashes[0], hashes[1]);
+        EXPECT_NE(hashes[1], hashes[2]);
+        EXPECT_EQ(hashes[0], hashes[4]);
+        skr::render_graph::RenderGraph::destroy(graph);
+    }
+}
+
+// timing only, skipped by default: run with --no-skip -tc=RenderGraphCompileCacheBench
+TEST_CASE_METHOD(RenderGraphNullDevice, "RenderGraphCompileCacheBench" * doctest::skip())
+{
+    constexpr uint32_t kPassCounts[] = { 64, 512, 2048 };
+    constexpr uint32_t kFrameCount = 20;
+    for (const auto pass_count : kPassCounts)
+    {
+        uint64_t declare_us[2] = {}, compile_us[2] = {}, execute_us[2] = {};
+        for (uint32_t cached = 0; cached < 2; cached++)
+        {
+            auto graph = create_graph();
+            graph->enable_compile_cache(cached);
+            // warm up the pools & the cache
+            declare_copy_chain(graph, pass_count);
+            graph->compile();
+            graph->execute();
+            for (uint32_t frame = 0; frame < kFrameCount; frame++)
+            {
+                auto start = skr_sys_get_usec(true);
+                declare_copy_chain(graph, pass_count);
+                auto declared = skr_sys_get_usec(true);
+                graph->compile();
+                auto compiled = skr_sys_get_usec(true);
+                graph->execute();
+                auto executed = skr_sys_get_usec(true);
+
+                declare_us[cached] += declared - start;
+                compile_us[cached] += compiled - declared;
+                execute_us[cached] += executed - compiled;
+            }
+            EXPECT_EQ(graph->is_compile_cached(), (bool)cached);
+            skr::render_graph::RenderGraph::destroy(graph);
+        }
+        SKR_LOG_INFO(u8"RenderGraph %u copy passes x %u frames: declare %.1fus, compile+execute %.1fus (compile %.1fus) uncached, "
+               "%.1fus (compile %.1fus) cached per frame",
+            pass_count, kFrameCount, (double)declare_us[1] / kFrameCount,
+            (double)(compile_us[0] + execute_us[0]) / kFrameCount, (double)compile_us[0] / kFrameCount,
+            (double)(compile_us[1] + execute_us[1]) / kFrameCount, (double)compile_us[1] / kFrameCount);
+    }
+}
+
+TEST_CASE_METHOD(RenderGraphNullDevice, "RenderGraphAsyncQueues")
+{
+    using skr::render_graph::QueueSchedule;
+    SUBCASE("WithoutAsyncQueuesStaysOnGraphics")
+    {
+        auto graph = create_graph();
+        declare_copy_chain(graph, 16, 8);
+        graph->compile();
+        auto schedule = graph->get_queue_schedule();
+        REQUIRE(schedule);
+        EXPECT_FALSE(schedule->is_multi_queue());
+        graph->execute();
+        skr::render_graph::RenderGraph::destroy(graph);
+    }
+
+    SUBCASE("CopiesAlternateWithTheTransferQueue")
+    {
+        constexpr uint32_t kFrameCount = 4;
+        constexpr ECGPUQueueType kQueues[] = {
+            CGPU_QUEUE_TYPE_GRAPHICS, CGPU_QUEUE_TYPE_TRANSFER,
+            CGPU_QUEUE_TYPE_GRAPHICS, CGPU_QUEUE_TYPE_TRANSFER,
+            CGPU_QUEUE_TYPE_GRAPHICS
+        };
+        auto graph = create_graph(1, true);
+        const auto before = statistics();
+        for (uint32_t frame = 0; frame < kFrameCount; frame++)
+        {
+            declare_copy_chain(graph, 16, 8);
+            graph->compile();
+            auto schedule = graph->get_queue_schedule();
+            REQUIRE(schedule);
+            // graphics, transfer, graphics, transfer & the graphics join
+            REQUIRE(schedule->segments.size() == 5);
+            for (uint32_t i = 0; i < 5; i++)
+                EXPECT_EQ(schedule->segments[i].queue, kQueues[i]);
+            EXPECT_TRUE(schedule->segments[0].waits.empty());
+            for (uint32_t i = 1; i < 5; i++)
+                EXPECT_TRUE(schedule->segments[i].waits.contains(i - 1));
+            EXPECT_EQ(schedule->segments[4].first_pass, schedule->segments[4].last_pass);
+            if (frame == 0)
+            {
+                skr::render_graph::RenderGraphViz::write_graphviz(*graph, "render_graph_queues.dot");
+                std::ifstream file("render_graph_queues.dot");
+                std::string dot((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                EXPECT_NE(dot.find("cluster_4"), std::string::npos);
+                EXPECT_NE(dot.find("style=dashed"), std::string::npos);
+            }
+            graph->execute();
+        }
+        const auto after = statistics();
+        // ownership transfers & semaphores replay cleanly on the validating backend
+        EXPECT_EQ(after.validation_errors - before.validation_errors, 0u);
+        skr::render_graph::RenderGraph::destroy(graph);
+    }
+}
+
+// a copy between two textures & one between two buffers, sized like a dynamic resolution target
+static void declare_dynamic_copies(skr::render_graph::RenderGraph* graph, uint32_t width, uint32_t height, uint64_t buffer_size, bool oversized)
+{
+    namespace render_graph = skr::render_graph;
+    auto texture = [=]() {
+        return graph->create_texture(
+        [=](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.extent(width, height)
+            .format(CGPU_FORMAT_R8G8B8A8_UNORM)
+            .allow_render_target();
+            if (oversized)
+                builder.allow_oversized();
+        });
+    };
+    auto buffer = [=]() {
+        return graph->create_buffer(
+        [=](render_graph::RenderGraph&, render_graph::BufferBuilder& builder) {
+            builder.size(buffer_size)
+            .allow_shader_readwrite();
+        });
+    };
+    auto src_texture = texture(), dst_texture = texture();
+    auto src_buffer = buffer(), dst_buffer = buffer();
+    graph->add_copy_pass(
+    [=](render_graph::RenderGraph&, render_graph::CopyPassBuilder& builder) {
+        builder.texture_to_texture(src_texture, dst_texture)
+        .buffer_to_buffer(src_buffer.range(0, buffer_size), dst_buffer.range(0, buffer_size));
+    },
+    [](render_graph::RenderGraph&, render_graph::CopyPassContext&) {});
+}
+
+struct PoolStatisticsProfiler : public skr::render_graph::RenderGraphProfiler {
+    void on_resource_pools(skr::render_graph::RenderGraph&, const skr::render_graph::ResourcePoolStatistics& stats) override
+    {
+        reports++;
+        last = stats;
+    }
+    uint32_t reports = 0;
+    skr::render_graph::ResourcePoolStatistics last;
+};
+
+TEST_CASE_METHOD(RenderGraphNullDevice, "RenderGraphResourcePools")
+{
+    // pools only, no aliasing
+    auto create_pooled_graph = [this](uint64_t texture_budget) {
+        return skr::render_graph::RenderGraph::create(
+        [this, texture_budget](skr::render_graph::RenderGraphBuilder& builder) {
+            builder.with_device(device)
+            .with_gfx_queue(queue)
+            .with_resource_pool_budget(texture_budget, 0);
+        });
+    };
+
+    SUBCASE("DynamicResolutionStaysInItsBucket")
+    {
+        // 900..999 x 540..599 all round up to the 1024 x 640 bucket, 60000..63999 bytes to the 64KB class
+        constexpr uint32_t kFrameCount = 24;
+        uint32_t texture_misses[2] = {};
+        for (uint32_t oversized = 0; oversized < 2; oversized++)
+        {
+            auto graph = create_pooled_graph(0);
+            PoolStatisticsProfiler profiler;
+            for (uint32_t frame = 0; frame < kFrameCount; frame++)
+            {
+                const uint32_t width = 900 + (frame * 37) % 100;
+                const uint32_t height = 540 + (frame * 23) % 60;
+                declare_dynamic_copies(graph, width, height, 60000 + (frame * 997) % 4000, oversized);
+                graph->compile();
+                graph->execute(&profiler);
+                const auto stats = graph->get_resource_pool_statistics();
+                REQUIRE(stats);
+                texture_misses[oversized] += stats->texture_misses;
+                EXPECT_EQ(stats->buffer_misses, frame ? 0u : 2u);
+                if (oversized)
+                {
+                    EXPECT_EQ(stats->texture_misses, frame ? 0u : 2u);
+                    EXPECT_EQ(statistics().texture_count, 2u);
+                }
+            }
+            EXPECT_EQ(profiler.reports, kFrameCount);
+            if (oversized)
+                EXPECT_EQ(profiler.last.texture_oversized_hits, 2u);
+            EXPECT_EQ(profiler.last.texture_bytes, profiler.last.texture_idle_bytes);
+            skr::render_graph::RenderGraph::destroy(graph);
+        }
+        // every new extent is a new pair of textures without oversized reuse
+        EXPECT_EQ(texture_misses[0], 2 * kFrameCount);
+        EXPECT_EQ(texture_misses[1], 2u);
+    }
+
+    SUBCASE("BudgetEvictsLeastRecentlyUsed")
+    {
+        // even frames use the 256 bucket, odd frames cycle through 3 others. the budget holds the 256 pair
+        // & one other pair, so the 256 pair stays while the odd buckets push each other out
+        constexpr uint64_t kBudget = 2400 * 1024;
+        constexpr uint32_t kOddSizes[] = { 320, 384, 448 };
+        constexpr uint32_t kFrameCount = 24;
+        auto graph = create_pooled_graph(kBudget);
+        uint32_t evicted = 0;
+        for (uint32_t frame = 0; frame < kFrameCount; frame++)
+        {
+            const uint32_t size = (frame % 2) ? kOddSizes[(frame / 2) % 3] : 256;
+            declare_dynamic_copies(graph, size, size, 4096, false);
+            graph->compile();
+            graph->execute();
+            const auto stats = graph->get_resource_pool_statistics();
+            evicted += stats->evicted_textures;
+            if (frame < 6) continue;
+            EXPECT_EQ(stats->texture_misses, (frame % 2) ? 2u : 0u);
+            EXPECT_TRUE(stats->texture_bytes <= kBudget);
+        }
+        EXPECT_TRUE(evicted > 0);
+        const auto stats = statistics();
+        EXPECT_EQ(stats.texture_count, 4u);
+        skr::render_graph::RenderGraph::destroy(graph);
+    }
+
+    SUBCASE("GarbageCollectionKeepsAccounting")
+    {
+        auto graph = create_pooled_graph(0);
+        for (uint32_t frame = 0; frame < 4; frame++)
+        {
+            declare_dynamic_copies(graph, 128u << frame, 128u << frame, 1024u << frame, false);
+            graph->compile();
+            graph->execute();
+        }
+        EXPECT_EQ(statistics().texture_count, 8u);
+        EXPECT_EQ(graph->collect_garbage(1), 8u);
+        EXPECT_EQ(statistics().texture_count, 4u);
+        declare_dynamic_copies(graph, 64, 64, 512, false);
+        graph->compile();
+        graph->execute();
+        const auto stats = graph->get_resource_pool_statistics();
+        EXPECT_EQ(stats->texture_bytes, stats->texture_idle_bytes);
+        EXPECT_EQ(stats->texture_bytes, statistics().texture_bytes);
+        skr::render_graph::RenderGraph::destroy(graph);
+    }
+}
+
+// timing only, skipped by default: run with --no-skip -tc=RenderGraphResourcePoolsBench
+TEST_CASE_METHOD(RenderGraphNullDevice, "RenderGraphResourcePoolsBench" * doctest::skip())
+{
+    // a dynamic resolution controller nudging the target every frame
+    constexpr uint32_t kFrameCount = 240;
+    for (uint32_t oversized = 0; oversized < 2; oversized++)
+    {
+        auto graph = skr::render_graph::RenderGraph::create(
+        [this](skr::render_graph::RenderGraphBuilder& builder) {
+            builder.with_device(device).with_gfx_queue(queue);
+        });
+        uint32_t misses = 0, hits = 0;
+        uint64_t peak_bytes = 0, execute_us = 0;
+        for (uint32_t frame = 0; frame < kFrameCount; frame++)
+        {
+            const float scale = 0.75f + 0.25f * (float)((frame * 7) % 32) / 31.f;
+            declare_dynamic_copies(graph, (uint32_t)(1920 * scale), (uint32_t)(1080 * scale), (uint64_t)(4 * 1024 * 1024 * scale), oversized);
+            graph->compile();
+            auto start = skr_sys_get_usec(true);
+            graph->execute();
+            execute_us += skr_sys_get_usec(true) - start;
+            const auto stats = graph->get_resource_pool_statistics();
+            misses += stats->texture_misses + stats->buffer_misses;
+            hits += stats->texture_hits + stats->buffer_hits;
+            peak_bytes = std::max(peak_bytes, stats->texture_bytes + stats->buffer_bytes);
+            // what a frame loop would do without a budget
+            if (frame >= RG_MAX_FRAME_IN_FLIGHT)
+                graph->collect_garbage(frame - RG_MAX_FRAME_IN_FLIGHT);
+        }
+        skr::render_graph::RenderGraph::destroy(graph);
+        SKR_LOG_INFO(u8"RenderGraph pools, dynamic resolution over %u frames (%s): %u hits, %u misses, peak %.1fMB, execute %.1fus per frame",
+            kFrameCount, oversized ? "oversized reuse" : "exact extents", hits, misses,
+            (double)peak_bytes / (1024.0 * 1024.0), (double)execute_us / kFrameCount);
+    }
+}
+
+#include "SkrTask/fib_task.hpp"
+
+// passes recorded on task workers need a bound scheduler
+struct RenderGraphRecordingWorkers : public RenderGraphNullDevice
+{
+    RenderGraphRecordingWorkers()
+    {
+        skr::task::scheudler_config_t config;
+        config.numThreads = 8;
+        scheduler.initialize(config);
+        scheduler.bind();
+    }
+
+    ~RenderGraphRecordingWorkers()
+    {
+        scheduler.unbind();
+    }
+
+    skr::task::scheduler_t scheduler;
+};
+
+TEST_CASE_METHOD(RenderGraphRecordingWorkers, "RenderGraphRecordingWorkers")
+{
+    // segments are recorded apart but submitted in order, the device must see the same stream
+    constexpr uint32_t kWorkerCounts[] = { 1, 4 };
+    constexpr uint32_t kFrameCount = 4;
+    uint64_t recorded_bytes[2] = {};
+    uint64_t recorded_commands[2] = {};
+    uint64_t validation_errors[2] = {};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        auto graph = create_graph(kWorkerCounts[i]);
+        const auto before = statistics();
+        for (uint32_t frame = 0; frame < kFrameCount; frame++)
+        {
+            declare_copy_chain(graph, 128);
+            graph->compile();
+            graph->execute();
+        }
+        const auto after = statistics();
+        recorded_bytes[i] = after.recorded_bytes - before.recorded_bytes;
+        recorded_commands[i] = after.recorded_commands - before.recorded_commands;
+        validation_errors[i] = after.validation_errors - before.validation_errors;
+        skr::render_graph::RenderGraph::destroy(graph);
+    }
+    EXPECT_EQ(validation_errors[0], 0u);
+    EXPECT_EQ(validation_errors[1], 0u);
+    // each extra segment opens & closes its own frame event
+    const uint64_t segment_events = 2 * 3 * kFrameCount;
+    EXPECT_EQ(recorded_commands[0] + segment_events, recorded_commands[1]);
+    EXPECT_TRUE(recorded_bytes[0] < recorded_bytes[1]);
+}
+
+// timing only, skipped by default: run with --no-skip -tc=RenderGraphRecordingWorkersBench
+TEST_CASE_METHOD(RenderGraphRecordingWorkers, "RenderGraphRecordingWorkersBench" * doctest::skip())
+{
+    constexpr uint32_t kPassCounts[] = { 512, 4096 };
+    constexpr uint32_t kWorkerCounts[] = { 1, 2, 4, 8 };
+    constexpr uint32_t kFrameCount = 10;
+    for (const auto pass_count : kPassCounts)
+    {
+        for (const auto workers : kWorkerCounts)
+        {
+            auto graph = create_graph(workers);
+            // warm up the pools, the compile cache & the segment executors
+            declare_copy_chain(graph, pass_count);
+            graph->compile();
+            graph->execute();
+            uint64_t execute_us = 0;
+            for (uint32_t frame = 0; frame < kFrameCount; frame++)
+            {
+                declare_copy_chain(graph, pass_count);
+                graph->compile();
+                auto start = skr_sys_get_usec(true);
+                graph->execute();
+                execute_us += skr_sys_get_usec(true) - start;
+            }
+            skr::render_graph::RenderGraph::destroy(graph);
+            SKR_LOG_INFO(u8"RenderGraph %u copy passes on %u recording workers: execute %.1fus per frame",
+                pass_count, workers, (double)execute_us / kFrameCount);
+        }
+    }
+}
@@ -8,6 +8,8 @@
 #include "SkrCore/async/thread_job.hpp"
 #include "SkrCore/async/wait_timeout.hpp"
 #include "SkrRT/io/ram_io.hpp"
+#include "SkrRT/io/io_task.hpp"
+#include "SkrTask/fib_task.hpp"
 
 #include <string>
 
@@ -234,6 +236,132 @@ for (uint32_t i = 0; i < 1; i++)
         skr_io_ram_service_t::destroy(ioService);
     }
 
+    SUBCASE("trace")
+    {
+        SkrZoneScopedN("trace");
+
+        SKR_TEST_INFO(u8"dstorage enabled: {}", dstorage);
+
+        skr_ram_io_service_desc_t ioServiceDesc = {};
+        ioServiceDesc.name = u8"Test";
+        ioServiceDesc.use_dstorage = dstorage;
+        ioServiceDesc.trace.enable = true;
+        auto ioService = skr_io_ram_service_t::create(&ioServiceDesc);
+        ioService->run();
+
+        constexpr uint32_t kRequestCount = 64;
+        skr_io_future_t futures[kRequestCount] = {};
+        skr::BlobId blobs[kRequestCount] = {};
+        for (uint32_t i = 0; i < kRequestCount; i++)
+        {
+            auto rq = ioService->open_request();
+            rq->set_vfs(abs_fs);
+            rq->set_path(u8"testfile2");
+            rq->add_block({}); // read all
+            const auto priority = (i % 2) ? SKR_ASYNC_SERVICE_PRIORITY_URGENT : SKR_ASYNC_SERVICE_PRIORITY_LOW;
+            blobs[i] = ioService->request(rq, &futures[i], priority);
+        }
+        wait_timeout([&futures]()->bool
+        {
+            for (auto& future : futures)
+            {
+                if (!future.is_ready())
+                    return false;
+            }
+            return true;
+        });
+        ioService->drain();
+
+        skr_io_latency_stats_t total = {};
+        EXPECT_TRUE(ioService->query_latency(SKR_IO_STAGE_COUNT, SKR_ASYNC_SERVICE_PRIORITY_COUNT, &total));
+        EXPECT_EQ(total.count, kRequestCount);
+        EXPECT_EQ(total.dropped, 0);
+        EXPECT_TRUE(total.min_us <= total.p50_us);
+        EXPECT_TRUE(total.p50_us <= total.p99_us);
+        EXPECT_TRUE(total.p99_us <= total.max_us);
+
+        skr_io_latency_stats_t urgent = {}, low = {};
+        EXPECT_TRUE(ioService->query_latency(SKR_IO_STAGE_COUNT, SKR_ASYNC_SERVICE_PRIORITY_URGENT, &urgent));
+        EXPECT_TRUE(ioService->query_latency(SKR_IO_STAGE_COUNT, SKR_ASYNC_SERVICE_PRIORITY_LOW, &low));
+        EXPECT_EQ(urgent.count, kRequestCount / 2);
+        EXPECT_EQ(low.count, kRequestCount / 2);
+
+        // every request passes enqueued -> resolving -> loading -> loaded -> completed
+        for (auto stage : { SKR_IO_STAGE_ENQUEUED, SKR_IO_STAGE_RESOLVING, SKR_IO_STAGE_LOADING, SKR_IO_STAGE_LOADED })
+        {
+            skr_io_latency_stats_t stats = {};
+            EXPECT_TRUE(ioService->query_latency(stage, SKR_ASYNC_SERVICE_PRIORITY_COUNT, &stats));
+            EXPECT_EQ(stats.count, kRequestCount);
+            EXPECT_TRUE(stats.max_us <= total.max_us);
+        }
+        ioService->dump_latency();
+
+        for (auto& blob : blobs)
+            EXPECT_EQ(std::string((const char*)blob->get_data()), std::string("Hello, World2!"));
+        skr_io_ram_service_t::destroy(ioService);
+    }
+
+#if __cpp_impl_coroutine
+    SUBCASE("coroutine")
+    {
+        SkrZoneScopedN("coroutine");
+
+        SKR_TEST_INFO(u8"dstorage enabled: {}", dstorage);
+
+        skr::task::scheduler_t fiberScheduler;
+        fiberScheduler.initialize({});
+        fiberScheduler.bind();
+        skr::task2::scheduler_t scheduler;
+        skr::task2::scheudler_config_t schedulerConfig;
+        schedulerConfig.fiberScheduler = &fiberScheduler;
+        scheduler.initialize(schedulerConfig);
+        scheduler.bind();
+
+        skr_ram_io_service_desc_t ioServiceDesc = {};
+        ioServiceDesc.name = u8"Test";
+        ioServiceDesc.use_dstorage = dstorage;
+        auto ioService = skr_io_ram_service_t::create(&ioServiceDesc);
+        ioService->run();
+
+        // the io thread resumes the coroutines, no worker waits on the futures
+        constexpr uint32_t kRequestCount = 16;
+        std::atomic<uint32_t> loaded = 0;
+        std::atomic<uint32_t> completed = 0;
+        skr::task2::counter_t finished;
+        finished.add(kRequestCount);
+        for (uint32_t i = 0; i < kRequestCount; i++)
+        {
+            skr::task2::schedule([](skr_io_ram_service_t* ioService, skr_vfs_t* abs_fs, std::atomic<uint32_t>& loaded, std::atomic<uint32_t>& completed, skr::task2::counter_t finished) -> skr::task2::skr_task_t
+            {
+                skr_io_future_t future = {};
+                auto rq = ioService->open_request();
+                rq->set_vfs(abs_fs);
+                rq->set_path(u8"testfile2");
+                rq->add_block({}); // read all
+                // callbacks added before the event still run
+                rq->add_callback(SKR_IO_STAGE_COMPLETED, +[](skr_io_future_t* future, skr_io_request_t* request, void* data) {
+                    ((std::atomic<uint32_t>*)data)->fetch_add(1);
+                }, &completed);
+                auto event = skr::io::finish_event(rq.get());
+                auto blob = ioService->request(rq, &future);
+                co_await skr::task2::co_wait(event);
+                if (future.is_ready() && std::string((const char*)blob->get_data()) == "Hello, World2!")
+                    loaded += 1;
+                finished.decrease();
+            }(ioService, abs_fs, loaded, completed, finished));
+        }
+        skr::task2::sync(finished);
+        EXPECT_EQ(loaded, kRequestCount);
+        EXPECT_EQ(completed, kRequestCount);
+
+        ioService->drain();
+        skr_io_ram_service_t::destroy(ioService);
+        scheduler.unbind();
+        scheduler.shutdown();
+        fiberScheduler.unbind();
+    }
+#endif
+
     #define TEST_CYCLES_COUNT 100
 
     SUBCASE("cancel")
@@ -1,5 +1,7 @@
 #include "SkrCore/log.h"
 #include "SkrLightningStorage/mdb.h"
+#include "SkrOS/filesystem.hpp"
+#include "SkrContainers/vector.hpp"
 
 #include "SkrTestFramework/framework.hpp"
 
@@ -100,3 +102,142 @@ TEST_CASE_METHOD(MDBTests, "TXN2")
     env->close_storage(storage);
     SLightningEnvironment::Free(env);
 }
+
+TEST_CASE_METHOD(MDBTests, "Reopen")
+{
+    skr::String key_string = u8"kept";
+    skr::String value_string = u8"value";
+    SLightningStorageValue key = { key_string.size() + 1, key_string.c_str() };
+    SLightningStorageValue value = { value_string.size() + 1, value_string.c_str() };
+    SLightningStorageOpenDescriptor desc = {};
+    desc.name = u8"reopen_storage";
+    {
+        auto env = skr_lightning_environment_create(u8"./test_mdb");
+        desc.flags = LIGHTNING_STORAGE_OPEN_CREATE | LIGHTNING_STORAGE_OPEN_TRUNCATE;
+        auto storage = skr_lightning_storage_open(env, &desc);
+        auto txn = skr_lightning_transaction_open(env, nullptr, 0);
+        EXPECT_TRUE(skr_lightning_storage_write(txn, storage, &key, &value));
+        EXPECT_TRUE(skr_lightning_transaction_commit(txn));
+        skr_lightning_storage_close(storage);
+        skr_lightning_environment_free(env);
+    }
+
+    // opening again without truncate keeps the data, with create or without
+    for (auto flags : { LIGHTNING_STORAGE_OPEN_CREATE, LIGHTNING_STORAGE_OPEN_READ_WRITE })
+    {
+        auto env = skr_lightning_environment_create(u8"./test_mdb");
+        desc.flags = flags;
+        auto storage = skr_lightning_storage_open(env, &desc);
+        auto txn = skr_lightning_transaction_open(env, nullptr, LIGHTNING_TRANSACATION_OPEN_READ_ONLY);
+        SLightningStorageValue readed_value = {};
+        EXPECT_TRUE(skr_lightning_storage_read(txn, storage, &key, &readed_value));
+        EXPECT_EQ(skr::String((const char8_t*)readed_value.data), value_string);
+        skr_lightning_transaction_abort(txn);
+        skr_lightning_storage_close(storage);
+        skr_lightning_environment_free(env);
+    }
+
+    // truncate drops it
+    {
+        auto env = skr_lightning_environment_create(u8"./test_mdb");
+        desc.flags = LIGHTNING_STORAGE_OPEN_CREATE | LIGHTNING_STORAGE_OPEN_TRUNCATE;
+        auto storage = skr_lightning_storage_open(env, &desc);
+        auto txn = skr_lightning_transaction_open(env, nullptr, LIGHTNING_TRANSACATION_OPEN_READ_ONLY);
+        SLightningStorageValue readed_value = {};
+        EXPECT_FALSE(skr_lightning_storage_read(txn, storage, &key, &readed_value));
+        skr_lightning_transaction_abort(txn);
+        skr_lightning_storage_close(storage);
+        skr_lightning_environment_free(env);
+    }
+}
+
+struct MDBScan
+{
+    static bool Visit(void* userdata, const SLightningStorageValue* key, const SLightningStorageValue*)
+    {
+        auto& keys = *(skr::Vector<skr::String>*)userdata;
+        keys.add(skr::String(skr::StringView((const char8_t*)key->data, key->size)));
+        return true;
+    }
+};
+
+TEST_CASE_METHOD(MDBTests, "Scan")
+{
+    auto env = skr_lightning_environment_create(u8"./test_mdb");
+    SLightningStorageOpenDescriptor desc = {};
+    desc.flags = LIGHTNING_STORAGE_OPEN_CREATE | LIGHTNING_STORAGE_OPEN_TRUNCATE;
+    desc.name = u8"scan_storage";
+    auto storage = skr_lightning_storage_open(env, &desc);
+    auto txn = skr_lightning_transaction_open(env, nullptr, 0);
+    const char8_t* keys[] = { u8"a", u8"ab", u8"abc", u8"abd", u8"b" };
+    for (auto key_string : keys)
+    {
+        const skr::String view = key_string;
+        SLightningStorageValue key = { view.size(), view.c_str() };
+        SLightningStorageValue value = { view.size(), view.c_str() };
+        EXPECT_TRUE(skr_lightning_storage_write(txn, storage, &key, &value));
+    }
+    const auto scan = [&](const char8_t* prefix_string) {
+        const skr::String view = prefix_string;
+        SLightningStorageValue prefix = { view.size(), view.c_str() };
+        skr::Vector<skr::String> found;
+        EXPECT_TRUE(skr_lightning_storage_scan(txn, storage, &prefix, &MDBScan::Visit, &found));
+        return found;
+    };
+
+    // an empty prefix visits everything in key order
+    auto found = scan(u8"");
+    REQUIRE(found.size() == 5);
+    for (uint32_t i = 0; i < 5; i++)
+        EXPECT_EQ(found[i], skr::String(keys[i]));
+    // no match
+    EXPECT_EQ(scan(u8"c").size(), 0);
+    EXPECT_EQ(scan(u8"abe").size(), 0);
+    // a prefix that is also a key comes first, followed by the longer keys
+    found = scan(u8"ab");
+    REQUIRE(found.size() == 3);
+    EXPECT_EQ(found[0], skr::String(u8"ab"));
+    EXPECT_EQ(found[1], skr::String(u8"abc"));
+    EXPECT_EQ(found[2], skr::String(u8"abd"));
+    EXPECT_EQ(scan(u8"abc").size(), 1);
+
+    skr_lightning_transaction_abort(txn);
+    skr_lightning_storage_close(storage);
+    skr_lightning_environment_free(env);
+}
+
+TEST_CASE_METHOD(MDBTests, "MapSize")
+{
+    std::error_code ec = {};
+    skr::filesystem::remove_all("./test_mdb_map_size", ec);
+    auto env = skr_lightning_environment_create(u8"./test_mdb_map_size");
+    SLightningStorageOpenDescriptor desc = {};
+    desc.flags = LIGHTNING_STORAGE_OPEN_CREATE;
+    desc.name = u8"map_size_storage";
+    auto storage = skr_lightning_storage_open(env, &desc);
+
+    // 24MB does not fit in the default 16MB map
+    skr::Vector<uint8_t> blob;
+    blob.resize_zeroed(1024 * 1024);
+    const auto write_all = [&]() {
+        auto txn = skr_lightning_transaction_open(env, nullptr, 0);
+        bool succeed = true;
+        for (uint32_t i = 0; i < 24 && succeed; i++)
+        {
+            SLightningStorageValue key = { sizeof(i), &i };
+            SLightningStorageValue value = { blob.size(), blob.data() };
+            succeed = skr_lightning_storage_write(txn, storage, &key, &value);
+        }
+        if (succeed)
+            return skr_lightning_transaction_commit(txn);
+        skr_lightning_transaction_abort(txn);
+        return false;
+    };
+    EXPECT_FALSE(write_all());
+    EXPECT_TRUE(skr_lightning_environment_set_map_size(env, 64ull * 1024 * 1024));
+    EXPECT_TRUE(write_all());
+
+    skr_lightning_storage_close(storage);
+    skr_lightning_environment_free(env);
+    skr::filesystem::remove_all("./test_mdb_map_size", ec);
+}
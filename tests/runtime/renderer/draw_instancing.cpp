@@ -0,0 +1,313 @@
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
+#include "SkrGraphics/api.h"
+#include "SkrGraphics/backend/null/cgpu_null.h"
+#include "SkrRenderer/draw_instancing.hpp"
+#include "SkrRenderer/draw_sort.hpp"
+
+#include "SkrTestFramework/framework.hpp"
+
+// draws are recorded into a null command buffer, buffers & bind tables are fake handles it never dereferences
+struct DrawInstancingTests {
+    // a tree species is two primitives: bark & leaves, each with its own pipeline & material
+    struct Species
+    {
+        skr_vertex_buffer_view_t vertex_buffers[2][2];
+        skr_index_buffer_view_t index_buffers[2];
+        CGPUXBindTableId bind_tables[2];
+    };
+
+    DrawInstancingTests()
+    {
+        SKR_DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        desc.enable_debug_layer = true;
+        instance = cgpu_create_instance(&desc);
+        uint32_t adapters_count = 1;
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+        CGPUQueueGroupDescriptor queue_group = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        SKR_DECLARE_ZERO(CGPUDeviceDescriptor, device_desc)
+        device_desc.queue_groups = &queue_group;
+        device_desc.queue_group_count = 1;
+        device = cgpu_create_device(adapter, &device_desc);
+        queue = cgpu_get_queue(device, CGPU_QUEUE_TYPE_GRAPHICS, 0);
+        pool = cgpu_create_command_pool(queue, nullptr);
+        SKR_DECLARE_ZERO(CGPUCommandBufferDescriptor, cmd_desc);
+        cmd = cgpu_create_command_buffer(pool, &cmd_desc);
+
+        // the non-instanced path pushes the model matrix with every draw
+        push_constant.name = u8"model";
+        push_constant.size = sizeof(skr_float4x4_t);
+        root_signature.device = device;
+        root_signature.push_constants = &push_constant;
+        root_signature.push_constant_count = 1;
+        for (auto& pipeline : pipelines)
+        {
+            pipeline.device = device;
+            pipeline.root_signature = &root_signature;
+        }
+
+        for (uint32_t s = 0; s < kSpeciesCount; s++)
+        {
+            for (uint32_t p = 0; p < 2; p++)
+            {
+                const uint32_t mesh = s * 2 + p;
+                species[s].vertex_buffers[p][0] = { fake_buffer(mesh * 3), 0, 12 };
+                species[s].vertex_buffers[p][1] = { fake_buffer(mesh * 3 + 1), 0, 20 };
+                species[s].index_buffers[p] = { fake_buffer(mesh * 3 + 2), 0, sizeof(uint16_t), 3u * (p ? 400u : 120u), 0 };
+                species[s].bind_tables[p] = (CGPUXBindTableId)(uintptr_t)(0x20000 + mesh * 0x100);
+            }
+        }
+        instancer.initialize(device, 2);
+    }
+
+    ~DrawInstancingTests() SKR_NOEXCEPT
+    {
+        instancer.finalize();
+        cgpu_free_command_buffer(cmd);
+        cgpu_free_command_pool(pool);
+        cgpu_free_queue(queue);
+        cgpu_free_device(device);
+        cgpu_free_instance(instance);
+    }
+
+    static CGPUBufferId fake_buffer(uint32_t index)
+    {
+        return (CGPUBufferId)(uintptr_t)(0x10000 + index * 0x100);
+    }
+
+    // trees in scene order, every tree is a random species on a grid
+    void plant_forest(uint32_t tree_count)
+    {
+        transforms.clear();
+        draws.clear();
+        transforms.reserve(tree_count);
+        draws.reserve(tree_count * 2);
+        uint32_t seed = 12345;
+        for (uint32_t t = 0; t < tree_count; t++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const uint32_t s = (seed >> 8) % kSpeciesCount;
+            auto& transform = transforms.add_default().ref();
+            transform.M[0][0] = transform.M[1][1] = transform.M[2][2] = transform.M[3][3] = 1.f;
+            transform.M[3][0] = (float)(t % 256) * 4.f;
+            transform.M[3][1] = (float)(t / 256) * 4.f;
+            for (uint32_t p = 0; p < 2; p++)
+            {
+                auto& draw = draws.add_default().ref();
+                draw.pipeline = &pipelines[p];
+                draw.bind_table = species[s].bind_tables[p];
+                draw.push_const_name = push_constant.name;
+                draw.push_const = (const uint8_t*)&transform;
+                draw.vertex_buffers = species[s].vertex_buffers[p];
+                draw.vertex_buffer_count = 2;
+                draw.index_buffer = species[s].index_buffers[p];
+                draw.instance_data = (const uint8_t*)&transform;
+                draw.instance_data_size = sizeof(skr_float4x4_t);
+            }
+        }
+        list = { draws.data(), (uint32_t)draws.size(), nullptr };
+        packet = { &list, 1, nullptr };
+    }
+
+    // records a forward pass the way the sample does, returns the draw calls issued
+    uint32_t record(const skr_primitive_draw_packet_t& frame_packet)
+    {
+        skr::renderer::DrawStateTracker tracker;
+        cgpu_cmd_begin(cmd);
+        CGPURenderPassDescriptor pass_desc = {};
+        pass_desc.sample_count = CGPU_SAMPLE_COUNT_1;
+        auto encoder = cgpu_cmd_begin_render_pass(cmd, &pass_desc);
+        for (uint32_t l = 0; l < frame_packet.count; l++)
+        {
+            for (uint32_t i = 0; i < frame_packet.lists[l].count; i++)
+            {
+                const auto& dc = frame_packet.lists[l].drawcalls[i];
+                if (dc.desperated) continue;
+                if (tracker.set_pipeline(dc.pipeline))
+                    cgpu_render_encoder_bind_pipeline(encoder, dc.pipeline);
+                if (tracker.set_index_buffer(dc.index_buffer))
+                    cgpu_render_encoder_bind_index_buffer(encoder, dc.index_buffer.buffer, dc.index_buffer.stride, dc.index_buffer.offset);
+                if (tracker.set_vertex_buffers(dc.vertex_buffers, dc.vertex_buffer_count))
+                {
+                    CGPUBufferId buffers[16];
+                    uint32_t strides[16];
+                    uint32_t offsets[16];
+                    for (uint32_t v = 0; v < dc.vertex_buffer_count; v++)
+                    {
+                        buffers[v] = dc.vertex_buffers[v].buffer;
+                        strides[v] = dc.vertex_buffers[v].stride;
+                        offsets[v] = dc.vertex_buffers[v].offset;
+                    }
+                    cgpu_render_encoder_bind_vertex_buffers(encoder, dc.vertex_buffer_count, buffers, strides, offsets);
+                }
+                if (!dc.instance_count)
+                    cgpu_render_encoder_push_constants(encoder, dc.pipeline->root_signature, dc.push_const_name, dc.push_const);
+                cgpu_render_encoder_draw_indexed_instanced(encoder, dc.index_buffer.index_count, dc.index_buffer.first_index, dc.instance_count ? dc.instance_count : 1, 0, 0);
+                tracker.draw();
+            }
+        }
+        cgpu_cmd_end_render_pass(cmd, encoder);
+        cgpu_cmd_end(cmd);
+        return tracker.statistics.draws;
+    }
+
+    static constexpr uint32_t kSpeciesCount = 4;
+    CGPUInstanceId instance = nullptr;
+    CGPUAdapterId adapter = nullptr;
+    CGPUDeviceId device = nullptr;
+    CGPUQueueId queue = nullptr;
+    CGPUCommandPoolId pool = nullptr;
+    CGPUCommandBufferId cmd = nullptr;
+
+    CGPUShaderResource push_constant = {};
+    CGPURootSignature root_signature = {};
+    CGPURenderPipeline pipelines[2] = {};
+    Species species[kSpeciesCount] = {};
+
+    skr::renderer::DrawInstancer instancer;
+    skr::Vector<skr_float4x4_t> transforms;
+    skr::Vector<skr_primitive_draw_t> draws;
+    skr_primitive_draw_list_view_t list;
+    skr_primitive_draw_packet_t packet;
+};
+
+TEST_CASE_METHOD(DrawInstancingTests, "Merge")
+{
+    plant_forest(16);
+    // a draw that did not opt in stays where it was
+    draws[3].instance_data = nullptr;
+    draws[3].sort_key = 42;
+    draws[5].desperated = true;
+
+    instancer.begin_frame(0);
+    const auto merged = instancer.merge(packet);
+    REQUIRE(merged.count == 1);
+    const auto& merged_list = merged.lists[0];
+
+    // one draw per species & primitive in use, plus the two untouched ones
+    skr::Vector<CGPUXBindTableId> materials;
+    for (const auto& draw : draws)
+    {
+        if (draw.instance_data && !draw.desperated && !materials.contains(draw.bind_table))
+            materials.add(draw.bind_table);
+    }
+    EXPECT_EQ(merged_list.count, (uint32_t)materials.size() + 2);
+    EXPECT_EQ(instancer.statistics.input_draws, 32u);
+    EXPECT_EQ(instancer.statistics.output_draws, merged_list.count);
+    EXPECT_EQ(instancer.statistics.instances, 30u);
+    EXPECT_EQ(instancer.statistics.uploaded_bytes, 30u * sizeof(skr_float4x4_t));
+
+    // groups follow the order of their first draw
+    EXPECT_EQ(merged_list.drawcalls[0].bind_table, draws[0].bind_table);
+    EXPECT_EQ(merged_list.drawcalls[1].bind_table, draws[1].bind_table);
+    uint32_t instances = 0;
+    bool found_plain = false, found_desperated = false;
+    for (uint32_t i = 0; i < merged_list.count; i++)
+    {
+        const auto& draw = merged_list.drawcalls[i];
+        if (draw.sort_key == 42)
+        {
+            found_plain = true;
+            EXPECT_EQ(draw.instance_count, 0u);
+            EXPECT_EQ(draw.vertex_buffers, draws[3].vertex_buffers);
+            continue;
+        }
+        if (draw.desperated)
+        {
+            found_desperated = true;
+            continue;
+        }
+        REQUIRE(draw.vertex_buffer_count == 3);
+        EXPECT_EQ(draw.instance_data, nullptr);
+        const auto& instance_stream = draw.vertex_buffers[2];
+        EXPECT_EQ(instance_stream.stride, (uint32_t)sizeof(skr_float4x4_t));
+
+        // the instance stream holds the members' transforms in draw order
+        const auto mapped = (const uint8_t*)instance_stream.buffer->info->cpu_mapped_address + instance_stream.offset;
+        uint32_t member = 0;
+        for (uint32_t d = 0; d < draws.size(); d++)
+        {
+            const auto& source = draws[d];
+            if (!source.instance_data || source.desperated) continue;
+            if (source.bind_table != draw.bind_table) continue;
+            EXPECT_EQ(memcmp(mapped + member * sizeof(skr_float4x4_t), source.instance_data, sizeof(skr_float4x4_t)), 0);
+            member++;
+        }
+        EXPECT_EQ(member, draw.instance_count);
+        instances += draw.instance_count;
+    }
+    EXPECT_TRUE(found_plain);
+    EXPECT_TRUE(found_desperated);
+    EXPECT_EQ(instances, 30u);
+}
+
+TEST_CASE_METHOD(DrawInstancingTests, "UploadRing")
+{
+    skr::renderer::InstanceUploadRing ring;
+    ring.initialize(device, 2, 256);
+    ring.begin_frame(0);
+    const auto first = ring.allocate(200);
+    // does not fit behind the first allocation, a second page is opened
+    const auto second = ring.allocate(100);
+    EXPECT_NE(first.buffer, second.buffer);
+    EXPECT_EQ(second.offset, 0u);
+    EXPECT_EQ(ring.get_allocated_size(), 300u);
+
+    // the other slot is untouched
+    ring.begin_frame(1);
+    const auto other = ring.allocate(16);
+    EXPECT_NE(other.buffer, first.buffer);
+    EXPECT_NE(other.buffer, second.buffer);
+
+    // back in slot 0 the two pages became one that fits the whole frame
+    ring.begin_frame(2);
+    const auto a = ring.allocate(200);
+    const auto b = ring.allocate(100);
+    EXPECT_EQ(a.buffer, b.buffer);
+    EXPECT_EQ(b.offset, 208u);
+    ring.finalize();
+}
+
+TEST_CASE_METHOD(DrawInstancingTests, "Forest")
+{
+    constexpr uint32_t kTreeCount = 1000;
+    plant_forest(kTreeCount);
+    EXPECT_EQ(record(packet), kTreeCount * 2);
+    instancer.begin_frame(0);
+    const auto merged = instancer.merge(packet);
+    EXPECT_EQ(record(merged), kSpeciesCount * 2);
+    EXPECT_EQ(instancer.statistics.instances, kTreeCount * 2);
+}
+
+// timing only, skipped by default: run with --no-skip -tc=InstancingBench
+TEST_CASE_METHOD(DrawInstancingTests, "InstancingBench" * doctest::skip())
+{
+    constexpr uint32_t kTreeCount = 20000;
+    constexpr uint32_t kFrameCount = 10;
+    plant_forest(kTreeCount);
+
+    uint32_t plain_draws = 0;
+    auto start = skr_sys_get_usec(true);
+    for (uint32_t frame = 0; frame < kFrameCount; frame++)
+        plain_draws = record(packet);
+    const double plain_ms = (double)(skr_sys_get_usec(true) - start) / 1000.0 / kFrameCount;
+
+    uint32_t instanced_draws = 0;
+    double merge_ms = 0.0;
+    start = skr_sys_get_usec(true);
+    for (uint32_t frame = 0; frame < kFrameCount; frame++)
+    {
+        const auto merge_start = skr_sys_get_usec(true);
+        instancer.begin_frame(frame);
+        const auto merged = instancer.merge(packet);
+        merge_ms += (double)(skr_sys_get_usec(true) - merge_start) / 1000.0;
+        instanced_draws = record(merged);
+    }
+    const double instanced_ms = (double)(skr_sys_get_usec(true) - start) / 1000.0 / kFrameCount;
+    merge_ms /= kFrameCount;
+
+    SKR_LOG_INFO(u8"Forest of %u trees without instancing: %u draws, %.3fms submit per frame", kTreeCount, plain_draws, plain_ms);
+    SKR_LOG_INFO(u8"Forest of %u trees with instancing: %u draws, %.3fms submit per frame (%.3fms merging, %.1fKB uploaded)",
+        kTreeCount, instanced_draws, instanced_ms, merge_ms, (double)instancer.statistics.uploaded_bytes / 1024.0);
+}
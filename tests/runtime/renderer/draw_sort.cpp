@@ -0,0 +1,208 @@
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
+#include "SkrTask/fib_task.hpp"
+#include "SkrRenderer/draw_sort.hpp"
+#include <algorithm>
+
+#include "SkrTestFramework/framework.hpp"
+
+// handles are never dereferenced by the sorter or the tracker, fake ones are enough
+template <typename T>
+static T fake_handle(uint32_t index)
+{
+    return (T)(uintptr_t)(0x10000 + (uintptr_t)index * 0x140);
+}
+
+struct DrawSortTests {
+    DrawSortTests()
+    {
+        skr::task::scheudler_config_t config;
+        config.numThreads = kWorkerThreads;
+        scheduler.initialize(config);
+        scheduler.bind();
+    }
+
+    ~DrawSortTests() SKR_NOEXCEPT
+    {
+        scheduler.unbind();
+    }
+
+    // a forest of meshes sharing a few pipelines & materials, produced in scene order
+    void make_scene(uint32_t draw_count, uint32_t pipeline_count, uint32_t material_count, uint32_t mesh_count)
+    {
+        vertex_buffers.clear();
+        for (uint32_t i = 0; i < mesh_count; i++)
+            vertex_buffers.add({ fake_handle<CGPUBufferId>(i), 0, 32 });
+
+        draws.clear();
+        uint32_t seed = 12345;
+        const auto random = [&seed](uint32_t range) {
+            seed = seed * 1664525u + 1013904223u;
+            return (seed >> 8) % range;
+        };
+        for (uint32_t i = 0; i < draw_count; i++)
+        {
+            const uint32_t material = random(material_count);
+            const uint32_t mesh = random(mesh_count);
+            auto& draw = draws.add_default().ref();
+            draw.pipeline = fake_handle<CGPURenderPipelineId>(material % pipeline_count);
+            draw.bind_table = fake_handle<CGPUXBindTableId>(material);
+            draw.vertex_buffers = &vertex_buffers[mesh];
+            draw.vertex_buffer_count = 1;
+            draw.index_buffer = { fake_handle<CGPUBufferId>(mesh_count + mesh), 0, sizeof(uint16_t), 36, 0 };
+            draw.sort_key = skr_primitive_draw_make_sort_key(0, draw.pipeline, draw.bind_table, (float)random(1000) / 1000.f);
+        }
+        list = { draws.data(), (uint32_t)draws.size(), nullptr };
+        packet = { &list, 1, nullptr };
+    }
+
+    static skr::renderer::DrawStateStatistics submit(skr::span<const skr::renderer::DrawListSorter::Entry> entries)
+    {
+        skr::renderer::DrawStateTracker tracker;
+        for (const auto& entry : entries)
+        {
+            const auto& draw = *entry.draw;
+            tracker.set_pipeline(draw.pipeline);
+            tracker.set_bind_table(nullptr, draw.bind_table);
+            tracker.set_index_buffer(draw.index_buffer);
+            tracker.set_vertex_buffers(draw.vertex_buffers, draw.vertex_buffer_count);
+            tracker.draw();
+        }
+        return tracker.statistics;
+    }
+
+    static constexpr uint32_t kWorkerThreads = 4;
+    skr::task::scheduler_t scheduler;
+    skr::Vector<skr_vertex_buffer_view_t> vertex_buffers;
+    skr::Vector<skr_primitive_draw_t> draws;
+    skr_primitive_draw_list_view_t list;
+    skr_primitive_draw_packet_t packet;
+};
+
+TEST_CASE_METHOD(DrawSortTests, "SortKey")
+{
+    const auto pipeline = fake_handle<CGPURenderPipelineId>(1);
+    const auto bind_table = fake_handle<CGPUXBindTableId>(2);
+    const auto near_key = skr_primitive_draw_make_sort_key(0, pipeline, bind_table, 0.1f);
+    const auto far_key = skr_primitive_draw_make_sort_key(0, pipeline, bind_table, 0.9f);
+    EXPECT_TRUE(near_key < far_key);
+    EXPECT_EQ(near_key >> 24, far_key >> 24);
+    // the layer beats every other field
+    EXPECT_TRUE(far_key < skr_primitive_draw_make_sort_key(1, nullptr, nullptr, 0.f));
+    // out of range depths are clamped
+    EXPECT_EQ(skr_primitive_draw_make_sort_key(0, nullptr, nullptr, -1.f), 0u);
+    EXPECT_EQ(skr_primitive_draw_make_sort_key(0, nullptr, nullptr, 2.f), 0xFFFFFFu);
+}
+
+TEST_CASE_METHOD(DrawSortTests, "RadixSort")
+{
+    make_scene(50000, 8, 64, 128);
+    draws[7].desperated = true;
+    // equal keys have to keep the order they were produced in
+    for (uint32_t i = 0; i < 100; i++)
+        draws[i + 100].sort_key = draws[100].sort_key;
+
+    skr::Vector<skr::renderer::DrawListSorter::Entry> expected;
+    for (const auto& draw : draws)
+    {
+        if (!draw.desperated)
+            expected.add({ draw.sort_key, &draw });
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+
+    const uint32_t block_counts[] = { 1, kWorkerThreads, 64 };
+    for (const auto blocks : block_counts)
+    {
+        skr::renderer::DrawListSorter sorter;
+        sorter.gather({ &packet, 1 });
+        sorter.sort(blocks);
+        const auto entries = sorter.get_entries();
+        REQUIRE(entries.size() == expected.size());
+        for (uint32_t i = 0; i < entries.size(); i++)
+        {
+            EXPECT_EQ(entries[i].key, expected[i].key);
+            EXPECT_EQ(entries[i].draw, expected[i].draw);
+        }
+    }
+}
+
+TEST_CASE_METHOD(DrawSortTests, "StateTracker")
+{
+    skr::renderer::DrawStateTracker tracker;
+    const auto pipeline = fake_handle<CGPURenderPipelineId>(1);
+    EXPECT_TRUE(tracker.set_pipeline(pipeline));
+    EXPECT_FALSE(tracker.set_pipeline(pipeline));
+
+    // a null table still has to be bound once
+    const auto root_signature = fake_handle<CGPURootSignatureId>(3);
+    EXPECT_TRUE(tracker.set_bind_table(root_signature, nullptr));
+    EXPECT_FALSE(tracker.set_bind_table(root_signature, nullptr));
+    EXPECT_TRUE(tracker.set_bind_table(fake_handle<CGPURootSignatureId>(4), nullptr));
+
+    skr_index_buffer_view_t ibv = { fake_handle<CGPUBufferId>(5), 0, 2, 36, 0 };
+    EXPECT_TRUE(tracker.set_index_buffer(ibv));
+    ibv.first_index = 12;
+    EXPECT_FALSE(tracker.set_index_buffer(ibv));
+    ibv.offset = 256;
+    EXPECT_TRUE(tracker.set_index_buffer(ibv));
+
+    const skr_vertex_buffer_view_t vbvs[2] = { { fake_handle<CGPUBufferId>(6), 0, 12 }, { fake_handle<CGPUBufferId>(7), 0, 8 } };
+    EXPECT_TRUE(tracker.set_vertex_buffers(vbvs, 2));
+    EXPECT_FALSE(tracker.set_vertex_buffers(vbvs, 2));
+    EXPECT_TRUE(tracker.set_vertex_buffers(vbvs, 1));
+
+    EXPECT_EQ(tracker.statistics.pipelines, 1u);
+    EXPECT_EQ(tracker.statistics.bind_tables, 2u);
+    EXPECT_EQ(tracker.statistics.index_buffers, 2u);
+    EXPECT_EQ(tracker.statistics.vertex_buffers, 2u);
+
+    tracker.reset();
+    EXPECT_TRUE(tracker.set_pipeline(pipeline));
+}
+
+TEST_CASE_METHOD(DrawSortTests, "StateChanges")
+{
+    make_scene(20000, 16, 256, 512);
+
+    skr::renderer::DrawListSorter sorter;
+    sorter.gather({ &packet, 1 });
+    const auto unsorted = submit(sorter.get_entries());
+    sorter.sort(kWorkerThreads);
+    const auto sorted = submit(sorter.get_entries());
+    EXPECT_EQ(sorted.draws, unsorted.draws);
+    EXPECT_TRUE(sorted.pipelines < unsorted.pipelines);
+    EXPECT_TRUE(sorted.bind_tables < unsorted.bind_tables);
+}
+
+// timing only, skipped by default: run with --no-skip -tc=DrawSortBench
+TEST_CASE_METHOD(DrawSortTests, "DrawSortBench" * doctest::skip())
+{
+    constexpr uint32_t kDrawCount = 200000;
+    constexpr uint32_t kFrameCount = 10;
+    make_scene(kDrawCount, 16, 256, 512);
+
+    skr::renderer::DrawListSorter sorter;
+    sorter.gather({ &packet, 1 });
+    const auto unsorted = submit(sorter.get_entries());
+    sorter.sort(kWorkerThreads);
+    const auto sorted = submit(sorter.get_entries());
+    const auto print_statistics = [](const char* name, const skr::renderer::DrawStateStatistics& statistics) {
+        SKR_LOG_INFO(u8"%s: %u draws, %u pipelines, %u bind tables, %u index buffers, %u vertex buffers per frame",
+            name, statistics.draws, statistics.pipelines, statistics.bind_tables, statistics.index_buffers, statistics.vertex_buffers);
+    };
+    print_statistics("Unsorted", unsorted);
+    print_statistics("Sorted", sorted);
+
+    const uint32_t block_counts[] = { 1, kWorkerThreads };
+    for (const auto blocks : block_counts)
+    {
+        const auto start = skr_sys_get_usec(true);
+        for (uint32_t frame = 0; frame < kFrameCount; frame++)
+        {
+            sorter.gather({ &packet, 1 });
+            sorter.sort(blocks);
+        }
+        const double ms = (double)(skr_sys_get_usec(true) - start) / 1000.0;
+        SKR_LOG_INFO(u8"Gather & sort %u draws in %u blocks: %.3fms per frame", kDrawCount, blocks, ms / kFrameCount);
+    }
+}
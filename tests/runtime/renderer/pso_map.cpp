@@ -0,0 +1,331 @@
+#include "SkrBase/misc/make_zeroed.hpp"
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
+#include "SkrCore/memory/memory.h"
+#include "SkrCore/async/thread_job.hpp"
+#include "SkrContainers/span.hpp"
+#include "SkrOS/thread.h"
+#include "SkrGraphics/api.h"
+#include "SkrRenderer/pso_map.h"
+#include <string.h>
+
+#include "SkrTestFramework/framework.hpp"
+
+// pipelines are created on a null device, shader libraries are fake handles it never dereferences
+struct PSOMapTests {
+    struct Material
+    {
+        uint32_t vertex_library;
+        uint32_t fragment_library;
+        uint32_t root_signature;
+        ECGPUCullMode cull_mode;
+        bool alpha_blend;
+    };
+
+    PSOMapTests()
+    {
+        SKR_DECLARE_ZERO(CGPUInstanceDescriptor, desc)
+        desc.backend = CGPU_BACKEND_NULL;
+        desc.enable_debug_layer = true;
+        instance = cgpu_create_instance(&desc);
+        uint32_t adapters_count = 1;
+        cgpu_enum_adapters(instance, &adapter, &adapters_count);
+        device = create_device(nullptr, 0);
+
+        for (auto& root_signature : root_signatures)
+            root_signature.device = device;
+        resolver.name_shader_library = +[](void* usrdata, CGPUShaderLibraryId library) -> uint64_t {
+            const auto index = (uintptr_t)library - kLibraryBase;
+            return index / kLibraryStride + 1;
+        };
+        resolver.name_root_signature = +[](void* usrdata, CGPURootSignatureId root_signature) -> uint64_t {
+            auto tests = (PSOMapTests*)usrdata;
+            return (uint64_t)(root_signature - tests->root_signatures) + 1;
+        };
+        resolver.resolve_shader_library = +[](void* usrdata, uint64_t name) -> CGPUShaderLibraryId {
+            auto tests = (PSOMapTests*)usrdata;
+            if (name == tests->missing_library) return nullptr;
+            tests->resolved_libraries.add(name);
+            return fake_library((uint32_t)name - 1);
+        };
+        resolver.resolve_root_signature = +[](void* usrdata, uint64_t name) -> CGPURootSignatureId {
+            auto tests = (PSOMapTests*)usrdata;
+            return name && name <= kRootSignatureCount ? &tests->root_signatures[name - 1] : nullptr;
+        };
+        resolver.usrdata = this;
+
+        auto jq_desc = make_zeroed<skr::JobQueueDesc>();
+        jq_desc.thread_count = 4;
+        jq_desc.name = u8"PSOMapTestJobQueue";
+        job_queue = SkrNew<skr::JobQueue>(jq_desc);
+    }
+
+    ~PSOMapTests() SKR_NOEXCEPT
+    {
+        SkrDelete(job_queue);
+        cgpu_free_device(device);
+        cgpu_free_instance(instance);
+    }
+
+    CGPUDeviceId create_device(const void* pipeline_cache, uint64_t pipeline_cache_size)
+    {
+        CGPUQueueGroupDescriptor queue_group = { CGPU_QUEUE_TYPE_GRAPHICS, 1 };
+        SKR_DECLARE_ZERO(CGPUDeviceDescriptor, device_desc)
+        device_desc.queue_groups = &queue_group;
+        device_desc.queue_group_count = 1;
+        device_desc.pipeline_cache_data = pipeline_cache;
+        device_desc.pipeline_cache_size = pipeline_cache_size;
+        return cgpu_create_device(adapter, &device_desc);
+    }
+
+    static CGPUShaderLibraryId fake_library(uint32_t index)
+    {
+        return (CGPUShaderLibraryId)(kLibraryBase + (uintptr_t)index * kLibraryStride);
+    }
+
+    void make_materials(uint32_t count)
+    {
+        materials.clear();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            materials.add({ i, count + i % 16, i % kRootSignatureCount,
+                (i % 3) ? CGPU_CULL_MODE_BACK : CGPU_CULL_MODE_NONE, (i % 4) == 0 });
+        }
+    }
+
+    skr_pso_map_key_id create_key(skr_pso_map_id map, const Material& material)
+    {
+        auto vertex_shader = make_zeroed<CGPUShaderEntryDescriptor>();
+        vertex_shader.library = fake_library(material.vertex_library);
+        vertex_shader.entry = u8"vert";
+        vertex_shader.stage = CGPU_SHADER_STAGE_VERT;
+        auto fragment_shader = make_zeroed<CGPUShaderEntryDescriptor>();
+        fragment_shader.library = fake_library(material.fragment_library);
+        fragment_shader.entry = u8"frag";
+        fragment_shader.stage = CGPU_SHADER_STAGE_FRAG;
+        const CGPUConstantSpecialization constant = { 0, { material.alpha_blend ? 1ull : 0ull } };
+        fragment_shader.constants = &constant;
+        fragment_shader.num_constants = 1;
+
+        auto vertex_layout = make_zeroed<CGPUVertexLayout>();
+        vertex_layout.attribute_count = 1;
+        strcpy((char*)vertex_layout.attributes[0].semantic_name, "POSITION");
+        vertex_layout.attributes[0].array_size = 1;
+        vertex_layout.attributes[0].format = CGPU_FORMAT_R32G32B32_SFLOAT;
+        vertex_layout.attributes[0].elem_stride = 12;
+        auto blend_state = make_zeroed<CGPUBlendStateDescriptor>();
+        blend_state.src_factors[0] = material.alpha_blend ? CGPU_BLEND_CONST_SRC_ALPHA : CGPU_BLEND_CONST_ONE;
+        blend_state.dst_factors[0] = material.alpha_blend ? CGPU_BLEND_CONST_ONE_MINUS_SRC_ALPHA : CGPU_BLEND_CONST_ZERO;
+        blend_state.masks[0] = CGPU_COLOR_MASK_ALL;
+        auto depth_state = make_zeroed<CGPUDepthStateDescriptor>();
+        depth_state.depth_test = true;
+        depth_state.depth_write = !material.alpha_blend;
+        depth_state.depth_func = CGPU_CMP_GEQUAL;
+        auto rasterizer_state = make_zeroed<CGPURasterizerStateDescriptor>();
+        rasterizer_state.cull_mode = material.cull_mode;
+        const ECGPUFormat color_format = CGPU_FORMAT_B8G8R8A8_UNORM;
+
+        auto desc = make_zeroed<CGPURenderPipelineDescriptor>();
+        desc.root_signature = &root_signatures[material.root_signature];
+        desc.vertex_shader = &vertex_shader;
+        desc.fragment_shader = &fragment_shader;
+        desc.vertex_layout = &vertex_layout;
+        desc.blend_state = &blend_state;
+        desc.depth_state = &depth_state;
+        desc.rasterizer_state = &rasterizer_state;
+        desc.color_formats = &color_format;
+        desc.render_target_count = 1;
+        desc.depth_stencil_format = CGPU_FORMAT_D32_SFLOAT_S8_UINT;
+        desc.prim_topology = CGPU_PRIM_TOPO_TRI_LIST;
+        return skr_pso_map_create_key(map, &desc);
+    }
+
+    skr_pso_map_id create_map(bool async)
+    {
+        skr_pso_map_root_t root;
+        root.device = device;
+        root.job_queue = async ? job_queue : nullptr;
+        root.key_resolver = &resolver;
+        return skr_pso_map_create(&root);
+    }
+
+    // materials become visible in order, each waits for its pso like the material factory does
+    void install_materials(skr_pso_map_id map, skr::span<const uint32_t> order)
+    {
+        skr::Vector<skr_pso_map_key_id> keys;
+        for (const auto index : order)
+        {
+            auto key = create_key(map, materials[index]);
+            skr_pso_map_install_pso(map, key);
+            keys.add(key);
+        }
+        for (auto key : keys)
+        {
+            while (!skr_pso_map_find_pso(map, key))
+                skr_thread_sleep(0);
+            skr_pso_map_uninstall_pso(map, key);
+            skr_pso_map_free_key(map, key);
+        }
+    }
+
+    static void wait_precompile(skr_pso_map_id map)
+    {
+        skr_pso_map_statistics_t statistics = {};
+        do
+        {
+            skr_thread_sleep(0);
+            skr_pso_map_query_statistics(map, &statistics);
+        } while (statistics.precompile_finished + statistics.precompile_failed < statistics.precompile_requested);
+    }
+
+    static skr::Vector<uint8_t> write_database(skr_pso_map_id map)
+    {
+        uint64_t size = 0;
+        skr_pso_map_write_key_database(map, &size, nullptr);
+        skr::Vector<uint8_t> database;
+        database.resize_unsafe(size);
+        skr_pso_map_write_key_database(map, &size, database.data());
+        return database;
+    }
+
+    static constexpr uintptr_t kLibraryBase = 0x100000;
+    static constexpr uintptr_t kLibraryStride = 0x100;
+    static constexpr uint32_t kRootSignatureCount = 4;
+    CGPUInstanceId instance = nullptr;
+    CGPUAdapterId adapter = nullptr;
+    CGPUDeviceId device = nullptr;
+    skr::JobQueue* job_queue = nullptr;
+    CGPURootSignature root_signatures[kRootSignatureCount] = {};
+    skr_pso_map_key_resolver_t resolver = {};
+    skr::Vector<Material> materials;
+    skr::Vector<uint64_t> resolved_libraries;
+    uint64_t missing_library = 0;
+};
+
+TEST_CASE_METHOD(PSOMapTests, "KeyDatabase")
+{
+    make_materials(64);
+    skr::Vector<uint32_t> order;
+    for (uint32_t i = 0; i < materials.size(); i++)
+    {
+        // later materials show up more often
+        for (uint32_t use = 0; use <= i / 16; use++)
+            order.add(i);
+    }
+
+    // 1. first run: every pso is created on first sight
+    auto map = create_map(false);
+    install_materials(map, order);
+    skr_pso_map_statistics_t statistics = {};
+    skr_pso_map_query_statistics(map, &statistics);
+    EXPECT_EQ(statistics.install_misses, (uint32_t)materials.size());
+    EXPECT_EQ(statistics.install_hits, (uint32_t)(order.size() - materials.size()));
+    const auto database = write_database(map);
+    skr_pso_map_free(map);
+    REQUIRE(database.size() > 0);
+
+    // 2. next run: everything is precompiled, most installed first
+    missing_library = 3;
+    map = create_map(false);
+    resolved_libraries.clear();
+    const uint32_t queued = skr_pso_map_precompile(map, database.data(), database.size());
+    wait_precompile(map);
+    EXPECT_EQ(queued, (uint32_t)materials.size() - 1);
+    // every material has its own vertex library, they show up in precompilation order
+    skr::Vector<uint32_t> precompiled;
+    for (const auto name : resolved_libraries)
+    {
+        if (name <= materials.size()) precompiled.add((uint32_t)name - 1);
+    }
+    EXPECT_EQ(precompiled.size(), materials.size() - 1);
+    for (uint32_t i = 1; i < precompiled.size(); i++)
+        EXPECT_TRUE(precompiled[i] / 16 <= precompiled[i - 1] / 16);
+
+    skr::Vector<uint32_t> reachable;
+    for (uint32_t i = 0; i < materials.size(); i++)
+    {
+        if (materials[i].vertex_library != missing_library - 1) reachable.add(i);
+    }
+    install_materials(map, reachable);
+    skr_pso_map_query_statistics(map, &statistics);
+    EXPECT_EQ(statistics.precompile_requested, (uint32_t)materials.size() - 1);
+    EXPECT_EQ(statistics.precompile_finished, (uint32_t)materials.size() - 1);
+    EXPECT_EQ(statistics.precompile_failed, 1u);
+    EXPECT_EQ(statistics.install_hits, (uint32_t)reachable.size());
+    EXPECT_EQ(statistics.install_misses, 0u);
+
+    // 3. the database keeps the key that couldn't be resolved this time
+    const auto next_database = write_database(map);
+    EXPECT_EQ(next_database.size(), database.size());
+    skr_pso_map_free(map);
+
+    // 4. out of date databases are ignored
+    auto stale = database;
+    stale[4] ^= 0xFF;
+    map = create_map(false);
+    EXPECT_EQ(skr_pso_map_precompile(map, stale.data(), stale.size()), 0u);
+    skr_pso_map_free(map);
+}
+
+TEST_CASE_METHOD(PSOMapTests, "PipelineCacheBlob")
+{
+    uint64_t size = 0;
+    cgpu_query_pipeline_cache_data(device, &size, nullptr);
+    EXPECT_EQ(size, 0u);
+
+    const uint8_t blob[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    auto cached_device = create_device(blob, sizeof(blob));
+    cgpu_query_pipeline_cache_data(cached_device, &size, nullptr);
+    REQUIRE(size == sizeof(blob));
+    uint8_t read_back[sizeof(blob)] = {};
+    cgpu_query_pipeline_cache_data(cached_device, &size, read_back);
+    EXPECT_EQ(memcmp(blob, read_back, sizeof(blob)), 0);
+    // too small to hold the blob
+    size = 4;
+    cgpu_query_pipeline_cache_data(cached_device, &size, read_back);
+    EXPECT_EQ(size, 0u);
+    cgpu_free_device(cached_device);
+}
+
+// timing only, skipped by default: run with --no-skip -tc=PSOWarmupBench
+TEST_CASE_METHOD(PSOMapTests, "PSOWarmupBench" * doctest::skip())
+{
+    constexpr uint32_t kMaterialCount = 4000;
+    make_materials(kMaterialCount);
+    skr::Vector<uint32_t> order;
+    for (uint32_t i = 0; i < kMaterialCount; i++)
+        order.add(i);
+
+    // cold: psos are requested as materials become visible
+    auto map = create_map(true);
+    auto start = skr_sys_get_usec(true);
+    install_materials(map, order);
+    const double cold_ms = (double)(skr_sys_get_usec(true) - start) / 1000.0;
+    skr_pso_map_statistics_t cold = {};
+    skr_pso_map_query_statistics(map, &cold);
+    const auto database = write_database(map);
+    skr_pso_map_free(map);
+
+    // warm: the recorded keys are precompiled at startup
+    map = create_map(true);
+    start = skr_sys_get_usec(true);
+    skr_pso_map_precompile(map, database.data(), database.size());
+    wait_precompile(map);
+    const double warmup_ms = (double)(skr_sys_get_usec(true) - start) / 1000.0;
+    start = skr_sys_get_usec(true);
+    install_materials(map, order);
+    const double warm_ms = (double)(skr_sys_get_usec(true) - start) / 1000.0;
+    skr_pso_map_statistics_t warm = {};
+    skr_pso_map_query_statistics(map, &warm);
+    skr_pso_map_free(map);
+    EXPECT_EQ(warm.install_misses, 0u);
+
+    const auto hit_rate = [](const skr_pso_map_statistics_t& statistics) {
+        const uint32_t installs = statistics.install_hits + statistics.install_misses;
+        return installs ? 100.0 * statistics.install_hits / installs : 0.0;
+    };
+    SKR_LOG_INFO(u8"PSO key database: %u keys, %llu bytes", kMaterialCount, (unsigned long long)database.size());
+    SKR_LOG_INFO(u8"Cold start: installs %.3fms, hit rate %.1f%%", cold_ms, hit_rate(cold));
+    SKR_LOG_INFO(u8"Warm start: warm-up %.3fms (%.3fms measured by the map), installs %.3fms, hit rate %.1f%%",
+        warmup_ms, (double)warm.precompile_usec / 1000.0, warm_ms, hit_rate(warm));
+}
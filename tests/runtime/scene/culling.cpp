@@ -0,0 +1,233 @@
+#include "SkrBase/math/rtm/rtmx.h"
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
+#include "SkrTask/fib_task.hpp"
+#include "SkrRT/ecs/type_builder.hpp"
+#include "SkrRT/ecs/storage.hpp"
+#include "SkrRT/ecs/job.hpp"
+#include "SkrScene/scene.h"
+#include "SkrScene/culling.h"
+
+#include "SkrTestFramework/framework.hpp"
+
+// eye at the origin looking down +y with +z up, 90 degrees fov, depth from 1 to 1000
+static skr_float4x4_t make_culling_view_projection()
+{
+    const auto view = rtm::look_at_matrix(
+        rtm::vector_set(0.f, 0.f, 0.f),
+        rtm::vector_set(0.f, 1.f, 0.f),
+        rtm::vector_set(0.f, 0.f, 1.f)
+    );
+    const auto proj = rtm::perspective_fov(3.1415926f / 2.f, 1.f, 1.f, 1000.f);
+    const auto view_projection = rtm::matrix_mul(view, proj);
+    return *(const skr_float4x4_t*)&view_projection;
+}
+
+struct CullingTests {
+    struct Instance {
+        skr_float3_t translation;
+        skr_float3_t scale;
+        skr_float3_t box_extents;
+        float        sphere_radius;
+    };
+
+    CullingTests()
+    {
+        storage = sugoiS_create();
+        culling_system = skr::CullingSystem::Create(storage);
+
+        skr::task::scheudler_config_t config;
+        config.numThreads = kWorkerThreads;
+        scheduler.initialize(config);
+        scheduler.bind();
+        sugoiJ_bind_storage(storage);
+    }
+
+    ~CullingTests() SKR_NOEXCEPT
+    {
+        sugoiJ_unbind_storage(storage);
+        skr::CullingSystem::Destroy(culling_system);
+        ::sugoiS_release(storage);
+        scheduler.unbind();
+    }
+
+    void spawn(const Instance* instances, uint32_t count)
+    {
+        sugoi::EntitySpawner<skr::TransformComponent, skr::BoundingSphereComponent, skr::BoundingBoxComponent> spawner;
+        uint32_t next = 0;
+        spawner(storage, count,
+            [&](auto& view) {
+                auto transforms = sugoi::get_owned<skr::TransformComponent>(view.view);
+                auto spheres = sugoi::get_owned<skr::BoundingSphereComponent>(view.view);
+                auto boxes = sugoi::get_owned<skr::BoundingBoxComponent>(view.view);
+                for (uint32_t i = 0; i < view.count(); ++i, ++next)
+                {
+                    const auto& instance = instances[next];
+                    transforms[i].value = skr_transform_t{};
+                    transforms[i].value.translation = instance.translation;
+                    transforms[i].value.scale = instance.scale;
+                    spheres[i].center = { 0.f, 0.f, 0.f };
+                    spheres[i].radius = instance.sphere_radius;
+                    boxes[i].center = { 0.f, 0.f, 0.f };
+                    boxes[i].extents = instance.box_extents;
+                    entities.add(sugoiV_get_entities(view.view)[i]);
+                }
+            });
+    }
+
+    static constexpr uint32_t kWorkerThreads = 4;
+    skr::CullingSystem* culling_system = nullptr;
+    sugoi_storage_t* storage = nullptr;
+    skr::task::scheduler_t scheduler;
+    skr::Vector<sugoi_entity_t> entities;
+};
+
+TEST_CASE_METHOD(CullingTests, "Frustum")
+{
+    const Instance instances[] = {
+        { { 0.f, 10.f, 0.f }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f },     // in front
+        { { 0.f, -10.f, 0.f }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f },    // behind
+        { { 0.f, 2000.f, 0.f }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f },   // past the far plane
+        { { -100.f, 10.f, 0.f }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f },  // left
+        { { -10.5f, 10.f, 0.f }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f },  // straddles the left plane
+        // the sphere reaches into the frustum, the thin box beside it does not
+        { { -12.f, 10.f, 0.f }, { 1.f, 1.f, 1.f }, { 0.5f, 0.5f, 50.f }, 50.f },
+        // scaled up into the frustum
+        { { 0.f, 10.f, 14.f }, { 4.f, 4.f, 4.f }, { 1.f, 1.f, 1.f }, 1.8f },
+    };
+    spawn(instances, 7);
+
+    skr::CullingView view = {};
+    view.view_projection = make_culling_view_projection();
+    skr::CullingResult result;
+    culling_system->cull(view, result);
+
+    EXPECT_EQ(result.tested_count, 7u);
+    EXPECT_EQ(result.frustum_culled, 4u);
+    EXPECT_EQ(result.occlusion_culled, 0u);
+    REQUIRE(result.entities.size() == 3);
+    EXPECT_EQ(result.entities[0], entities[0]);
+    EXPECT_EQ(result.entities[1], entities[4]);
+    EXPECT_EQ(result.entities[2], entities[6]);
+
+    uint32_t chunk_instances = 0;
+    for (const auto& chunk : result.chunks)
+    {
+        const auto chunk_entities = sugoiV_get_entities(&chunk.view);
+        for (uint32_t i = 0; i < chunk.count; i++)
+        {
+            const auto slot = result.indices[chunk.first + i];
+            EXPECT_EQ(chunk_entities[slot - chunk.view.start], result.entities[chunk.first + i]);
+        }
+        chunk_instances += chunk.count;
+    }
+    EXPECT_EQ(chunk_instances, 3u);
+}
+
+TEST_CASE_METHOD(CullingTests, "Occlusion")
+{
+    // an occluder at depth 0.5, about 2 units in front of the eye
+    skr::Vector<float> depth;
+    depth.resize_unsafe(64 * 48);
+    for (auto& texel : depth)
+        texel = 0.5f;
+    skr::DepthPyramid pyramid;
+    pyramid.build(depth.data(), 64, 48);
+    EXPECT_EQ(pyramid.levels.size(), 7u);
+    EXPECT_EQ(pyramid.levels.last().width, 1u);
+    EXPECT_EQ(pyramid.levels.last().height, 1u);
+
+    const Instance instances[] = {
+        { { 0.f, 10.f, 0.f }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f },     // behind the occluder
+        { { 0.f, 1.5f, 0.f }, { 1.f, 1.f, 1.f }, { 0.1f, 0.1f, 0.1f }, 0.2f },  // in front of it
+        { { 0.f, 1.2f, 0.f }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f },     // crosses the near plane
+    };
+    spawn(instances, 3);
+
+    skr::CullingView view = {};
+    view.view_projection = make_culling_view_projection();
+    view.occlusion = &pyramid;
+    skr::CullingResult result;
+    culling_system->cull(view, result);
+
+    EXPECT_EQ(result.occlusion_culled, 1u);
+    REQUIRE(result.entities.size() == 2);
+    EXPECT_EQ(result.entities[0], entities[1]);
+    EXPECT_EQ(result.entities[1], entities[2]);
+
+    // a hole in the occluder lets the far instance through
+    for (uint32_t y = 20; y < 28; y++)
+        for (uint32_t x = 28; x < 36; x++)
+            depth[y * 64 + x] = 1.f;
+    pyramid.build(depth.data(), 64, 48);
+    culling_system->cull(view, result);
+    EXPECT_EQ(result.occlusion_culled, 0u);
+    EXPECT_EQ(result.entities.size(), 3u);
+}
+
+TEST_CASE_METHOD(CullingTests, "Batches")
+{
+    constexpr uint32_t kInstanceCount = 20000;
+    skr::Vector<Instance> instances;
+    instances.reserve(kInstanceCount);
+    uint32_t seed = 12345;
+    const auto random = [&seed](float range) {
+        seed = seed * 1664525u + 1013904223u;
+        return ((float)(seed >> 8) / (float)(1u << 24) * 2.f - 1.f) * range;
+    };
+    for (uint32_t i = 0; i < kInstanceCount; i++)
+        instances.add({ { random(500.f), random(500.f), random(500.f) }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f });
+    spawn(instances.data(), kInstanceCount);
+
+    skr::CullingView view = {};
+    view.view_projection = make_culling_view_projection();
+    skr::CullingResult single_batch;
+    culling_system->set_batch_size(0);
+    culling_system->cull(view, single_batch);
+    EXPECT_NE(single_batch.entities.size(), 0u);
+    // batches finish in any order, the compacted result does not
+    const uint32_t batch_sizes[] = { 256, 1024 };
+    for (const auto batch_size : batch_sizes)
+    {
+        skr::CullingResult result;
+        culling_system->set_batch_size(batch_size);
+        culling_system->cull(view, result);
+        REQUIRE(result.entities.size() == single_batch.entities.size());
+        for (uint32_t i = 0; i < result.entities.size(); i++)
+            EXPECT_EQ(result.entities[i], single_batch.entities[i]);
+    }
+}
+
+// timing only, skipped by default: run with --no-skip -tc=CullingBench
+TEST_CASE_METHOD(CullingTests, "CullingBench" * doctest::skip())
+{
+    constexpr uint32_t kInstanceCount = 200000;
+    constexpr uint32_t kFrameCount = 10;
+    skr::Vector<Instance> instances;
+    instances.reserve(kInstanceCount);
+    uint32_t seed = 12345;
+    const auto random = [&seed](float range) {
+        seed = seed * 1664525u + 1013904223u;
+        return ((float)(seed >> 8) / (float)(1u << 24) * 2.f - 1.f) * range;
+    };
+    for (uint32_t i = 0; i < kInstanceCount; i++)
+        instances.add({ { random(500.f), random(500.f), random(500.f) }, { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f }, 1.8f });
+    spawn(instances.data(), kInstanceCount);
+
+    skr::CullingView view = {};
+    view.view_projection = make_culling_view_projection();
+    skr::CullingResult result;
+    const uint32_t batch_sizes[] = { 0, 256, 1024, 4096 };
+    for (const auto batch_size : batch_sizes)
+    {
+        culling_system->set_batch_size(batch_size);
+        const auto start = skr_sys_get_usec(true);
+        for (uint32_t frame = 0; frame < kFrameCount; frame++)
+            culling_system->cull(view, result);
+        const double ms = (double)(skr_sys_get_usec(true) - start) / 1000.0;
+        const uint32_t cores = batch_size ? kWorkerThreads : 1;
+        SKR_LOG_INFO(u8"Culling %u instances (%u visible), batch %u: %.3fms per frame, %.0f instances/ms/core",
+            kInstanceCount, (uint32_t)result.entities.size(), batch_size, ms / kFrameCount,
+            (double)kInstanceCount * kFrameCount / ms / cores);
+    }
+}
@@ -17,4 +17,5 @@ static struct ProcInitializer {
 } init;
 
 #include "serde.cpp"
-#include "transform.cpp"
\ No newline at end of file
+#include "transform.cpp"
+#include "culling.cpp"
\ No newline at end of file
@@ -30,6 +30,11 @@ test_target("SceneTest")
     add_rules("c++.unity_build", {batchsize = default_unity_batch})
     add_files("scene/main.cpp")
 
+test_target("RendererTest")
+    set_group("05.tests/runtime")
+    public_dependency("SkrRenderer", engine_version)
+    add_files("renderer/*.cpp")
+
 test_target("ECSTest_CStyle")
     set_group("05.tests/runtime")
     public_dependency("SkrRT", engine_version)
@@ -44,6 +49,11 @@ executable_module("ECSTest_CPPStyle", "ECS_TEST", engine_version)
     add_deps("SkrTestFramework", {public = false})
     add_files("ecs/cpp_style/*.cpp")
 
+test_target("CmdParserTest")
+    set_group("05.tests/runtime")
+    public_dependency("SkrRT", engine_version)
+    add_files("cmd_parser/main.cpp")
+
 test_target("MDBTest")
     set_group("05.tests/runtime")
     public_dependency("SkrRT", engine_version)
@@ -0,0 +1,180 @@
+#include "SkrTask/fib_task.hpp"
+#include "SkrAnim/ozz/animation.h"
+#include "SkrAnim/ozz/skeleton.h"
+#include "SkrAnim/ozz/base/maths/quaternion.h"
+#include "SkrAnimTool/ozz/animation_builder.h"
+#include "SkrAnimTool/ozz/animation_optimizer.h"
+#include "SkrAnimTool/ozz/raw_animation.h"
+#include "SkrAnimTool/ozz/raw_skeleton.h"
+#include "SkrAnimTool/ozz/skeleton_builder.h"
+#include <math.h>
+#include <string.h>
+
+// keys of built animations are compared as they are stored
+#define OZZ_INCLUDE_PRIVATE_HEADER
+#include "SkrAnim/ozz/animation/runtime/animation_keyframe.h"
+
+#include "SkrTestFramework/framework.hpp"
+
+using namespace ozz::animation;
+using namespace ozz::animation::offline;
+
+struct AnimationToolTests {
+    static constexpr int      kChains      = 3;
+    static constexpr int      kChainLength = 9;
+    static constexpr int      kClips       = 5;
+    static constexpr uint32_t kKeys        = 61;
+
+    AnimationToolTests()
+    {
+        // chains hanging from one root, more joints than a decimation task takes
+        RawSkeleton raw_skeleton;
+        raw_skeleton.roots.resize(1);
+        auto& root     = raw_skeleton.roots[0];
+        root.name      = "root";
+        root.transform = ozz::math::Transform::identity();
+        for (int c = 0; c < kChains; c++)
+        {
+            auto* parent = &root;
+            for (int j = 0; j < kChainLength; j++)
+            {
+                parent->children.resize(parent == &root ? kChains : 1);
+                auto& joint                 = parent->children[parent == &root ? c : 0];
+                joint.name                  = "joint";
+                joint.transform             = ozz::math::Transform::identity();
+                joint.transform.translation = ozz::math::Float3(0.f, 0.2f, 0.f);
+                parent                      = &joint;
+            }
+        }
+        skeleton = SkeletonBuilder()(raw_skeleton);
+        REQUIRE(skeleton);
+
+        // keys every 1/30s, smooth motion with runs of exactly interpolable keys & some noise to keep
+        uint32_t   seed  = 12345;
+        const auto noise = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return (float)(seed >> 8) / (float)(1u << 24) - 0.5f;
+        };
+        for (int clip = 0; clip < kClips; clip++)
+        {
+            auto& raw    = clips[clip];
+            raw.duration = 2.f;
+            raw.name     = "clip";
+            raw.tracks.resize(skeleton->num_joints());
+            for (int j = 0; j < skeleton->num_joints(); j++)
+            {
+                auto& track = raw.tracks[j];
+                for (uint32_t k = 0; k < kKeys; k++)
+                {
+                    const float time   = raw.duration * (float)k / (float)(kKeys - 1);
+                    const float linear = (k / 10) % 2 ? 0.f : 1e-3f * noise();
+                    const float phase  = (float)(clip + 1) * time + 0.3f * (float)j;
+                    track.translations.push_back({ time, ozz::math::Float3(0.f, 0.2f + 0.05f * sinf(phase) + linear, 0.1f * time) });
+                    track.rotations.push_back({ time, ozz::math::Quaternion::FromAxisAngle(ozz::math::Float3(0.f, 0.f, 1.f), 0.5f * sinf(2.f * phase) + linear) });
+                    track.scales.push_back({ time, ozz::math::Float3(1.f + 0.1f * (float)(k / 20) + linear) });
+                }
+            }
+            REQUIRE(raw.Validate());
+        }
+        optimizer.setting                    = AnimationOptimizer::Setting(1e-3f, 0.1f);
+        optimizer.joints_setting_override[4] = AnimationOptimizer::Setting(1e-4f, 0.5f);
+    }
+
+    // the optimizer & builder run on the task system bound to this thread
+    template <class F>
+    static void with_workers(uint32_t threads, F&& f)
+    {
+        skr::task::scheduler_t        scheduler;
+        skr::task::scheudler_config_t config;
+        config.numThreads = threads;
+        scheduler.initialize(config);
+        scheduler.bind();
+        f();
+        scheduler.unbind();
+    }
+
+    template <class T>
+    static bool same_keys(const T& a, const T& b)
+    {
+        return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(a[0])) == 0);
+    }
+
+    static void expect_same(const RawAnimation& a, const RawAnimation& b)
+    {
+        REQUIRE(a.num_tracks() == b.num_tracks());
+        EXPECT_EQ(a.duration, b.duration);
+        for (int j = 0; j < a.num_tracks(); j++)
+        {
+            EXPECT_TRUE(same_keys(a.tracks[j].translations, b.tracks[j].translations));
+            EXPECT_TRUE(same_keys(a.tracks[j].rotations, b.tracks[j].rotations));
+            EXPECT_TRUE(same_keys(a.tracks[j].scales, b.tracks[j].scales));
+        }
+    }
+
+    static void expect_same(const Animation& a, const Animation& b)
+    {
+        EXPECT_EQ(a.duration(), b.duration());
+        EXPECT_EQ(a.num_tracks(), b.num_tracks());
+        EXPECT_TRUE(same_keys(a.translations(), b.translations()));
+        EXPECT_TRUE(same_keys(a.rotations(), b.rotations()));
+        EXPECT_TRUE(same_keys(a.scales(), b.scales()));
+    }
+
+    ozz::unique_ptr<Skeleton> skeleton;
+    RawAnimation              clips[kClips];
+    AnimationOptimizer        optimizer;
+};
+
+TEST_CASE_METHOD(AnimationToolTests, "ParallelMatchesSerial")
+{
+    // reference: one clip at a time on a single worker
+    RawAnimation               serial[kClips];
+    ozz::unique_ptr<Animation> serial_built[kClips];
+    with_workers(1, [&] {
+        for (int clip = 0; clip < kClips; clip++)
+        {
+            REQUIRE(optimizer(clips[clip], *skeleton, &serial[clip]));
+            serial_built[clip] = AnimationBuilder()(serial[clip]);
+            REQUIRE(serial_built[clip]);
+        }
+    });
+    // the optimizer did decimate, else the comparison proves little
+    size_t input_keys = 0, output_keys = 0;
+    for (int clip = 0; clip < kClips; clip++)
+    {
+        for (int j = 0; j < clips[clip].num_tracks(); j++)
+        {
+            input_keys += clips[clip].tracks[j].rotations.size();
+            output_keys += serial[clip].tracks[j].rotations.size();
+        }
+    }
+    EXPECT_TRUE(output_keys < input_keys);
+
+    with_workers(8, [&] {
+        // single clips & the batch overload, twice to catch scheduling dependent output
+        for (int run = 0; run < 2; run++)
+        {
+            for (int clip = 0; clip < kClips; clip++)
+            {
+                RawAnimation parallel;
+                REQUIRE(optimizer(clips[clip], *skeleton, &parallel));
+                expect_same(serial[clip], parallel);
+                auto built = AnimationBuilder()(parallel);
+                REQUIRE(built);
+                expect_same(*serial_built[clip], *built);
+            }
+
+            RawAnimation        batch[kClips];
+            const RawAnimation* inputs[kClips];
+            RawAnimation*       outputs[kClips];
+            for (int clip = 0; clip < kClips; clip++)
+            {
+                inputs[clip]  = &clips[clip];
+                outputs[clip] = &batch[clip];
+            }
+            REQUIRE(optimizer(ozz::make_span(inputs), *skeleton, ozz::make_span(outputs)));
+            for (int clip = 0; clip < kClips; clip++)
+                expect_same(serial[clip], batch[clip]);
+        }
+    });
+}
@@ -0,0 +1,285 @@
+#include "SkrTask/fib_task.hpp"
+#include "SkrToolCore/asset/cook_system.hpp"
+#include "SkrToolCore/asset/importer.hpp"
+#include "SkrToolCore/project/project.hpp"
+#include <stdio.h>
+#include <string.h>
+
+#include "SkrTestFramework/framework.hpp"
+
+using namespace skd::asset;
+
+struct CookCacheTests {
+    static constexpr uint32_t kImporterVersion = 3;
+    static constexpr uint32_t kCookerVersion   = 5;
+
+    struct TestCooker : public SCooker {
+        uint32_t Version() override { return kCookerVersion; }
+        bool     Cook(SCookContext* ctx) override { return true; }
+    };
+
+    // what the cook system hands to Store: the record, the versions, the sources & the outputs of a finished cook
+    struct TestCookContext : public SCookContext {
+        skr::filesystem::path GetOutputPath() const override { return outputPath; }
+
+        SImporter*          GetImporter() const override { return nullptr; }
+        skr_guid_t          GetImporterType() const override { return {}; }
+        uint32_t            GetImporterVersion() const override { return kImporterVersion; }
+        uint32_t            GetCookerVersion() const override { return kCookerVersion; }
+        const SAssetRecord* GetAssetRecord() const override { return record; }
+        skr::String         GetAssetPath() const override { return record->path.u8string().c_str(); }
+
+        skr::filesystem::path AddSourceFile(const skr::filesystem::path& path) override
+        {
+            sourceFiles.add(path);
+            return record->path.parent_path() / path;
+        }
+        skr::filesystem::path                  AddSourceFileAndLoad(skr_io_ram_service_t* ioService, const skr::filesystem::path& path, skr::BlobId& destination) override { return AddSourceFile(path); }
+        skr::span<const skr::filesystem::path> GetSourceFiles() const override { return { sourceFiles.data(), sourceFiles.size() }; }
+
+        void                               AddOutputFile(const skr::filesystem::path& path) override { outputFiles.add(path); }
+        skr::Vector<skr::filesystem::path> GetOutputFiles() const override { return outputFiles; }
+
+        void                                   AddRuntimeDependency(skr_guid_t resource) override {}
+        void                                   AddSoftRuntimeDependency(skr_guid_t resource) override {}
+        uint32_t                               AddStaticDependency(skr_guid_t resource, bool install) override { return 0; }
+        skr::span<const skr_guid_t>            GetRuntimeDependencies() const override { return {}; }
+        skr::span<const skr_resource_handle_t> GetStaticDependencies() const override { return {}; }
+        const skr_resource_handle_t&           GetStaticDependency(uint32_t index) const override { return staticDependencies[index]; }
+
+        const skr::task::event_t& GetCounter() override { return counter; }
+        void                      SetCounter(skr::task::event_t& ct) override { counter = ct; }
+        void                      SetCookerVersion(uint32_t version) override {}
+        void                      SetOutputPath(const skr::filesystem::path& path) override { outputPath = path; }
+
+        void* _Import() override { return nullptr; }
+        void  _Destroy(void*) override {}
+
+        void SetRecord(SAssetRecord* inRecord) { record = inRecord; }
+
+        skr::task::event_t                 counter = nullptr;
+        skr::filesystem::path              outputPath;
+        skr::Vector<skr::filesystem::path> sourceFiles;
+        skr::Vector<skr::filesystem::path> outputFiles;
+        skr::Vector<skr_resource_handle_t> staticDependencies;
+    };
+
+    CookCacheTests()
+    {
+        using namespace skr::literals;
+        std::error_code ec = {};
+        root = skr::filesystem::absolute("./test_cook_cache", ec);
+        skr::filesystem::remove_all(root, ec);
+        skr::filesystem::create_directories(root / "assets", ec);
+        write_text(root / "project.json", R"({ "assetDirectory": "assets", "resourceDirectory": "resources", "artifactsDirectory": "artifacts" })");
+        project = skd::SProject::OpenProject(root / "project.json");
+        REQUIRE(project != nullptr);
+        skr::filesystem::create_directories(project->GetDependencyPath(), ec);
+
+        const auto importerType = u8"5e9b1f3c-2a47-4d81-9c6e-7f0a3b8d2e14"_guid;
+        GetImporterRegistry()->RegisterImporter(importerType, { +[](const SAssetRecord*, skr::archive::JsonReader*) -> SImporter* { return nullptr; }, +[]() { return kImporterVersion; } });
+
+        record.project = project;
+        record.guid    = u8"a4c2e8f1-6b3d-4f97-8e15-2d9c0b7a5f63"_guid;
+        record.type    = u8"c81f4e2a-93b7-4d05-b6e8-1a5f7c3d9e20"_guid;
+        record.cooker  = {};
+        record.path    = "mesh.asset";
+        record.meta    = u8"{ \"importer\": { \"importerType\": \"";
+        record.meta.append(skr::format(u8"{}", importerType));
+        record.meta.append(u8"\" } }");
+
+        write_text(project->GetAssetPath() / "source.txt", "source of the mesh");
+        context.SetRecord(&record);
+        context.AddSourceFile("source.txt");
+        context.SetOutputPath(output(u8"bin"));
+        context.AddOutputFile(output(u8"buffer0"));
+    }
+
+    ~CookCacheTests() SKR_NOEXCEPT
+    {
+        SkrDelete(project);
+        std::error_code ec = {};
+        skr::filesystem::remove_all(root, ec);
+    }
+
+    skr::filesystem::path output(const char8_t* extension) const
+    {
+        return project->GetOutputPath() / skr::format(u8"{}.{}", record.guid, extension).u8_str();
+    }
+
+    skr::filesystem::path dependency_file() const
+    {
+        return project->GetDependencyPath() / skr::format(u8"{}.d", record.guid).u8_str();
+    }
+
+    // the only entry under dir
+    static skr::filesystem::path single_entry(const skr::filesystem::path& dir)
+    {
+        skr::filesystem::path result;
+        uint32_t              count = 0;
+        std::error_code       ec    = {};
+        for (const auto& entry : skr::filesystem::directory_iterator(dir, ec))
+        {
+            result = entry.path();
+            count++;
+        }
+        REQUIRE(count == 1);
+        return result;
+    }
+
+    static void write_data(const skr::filesystem::path& path, const void* data, uint64_t size)
+    {
+        auto file = fopen(path.string().c_str(), "wb");
+        REQUIRE(file != nullptr);
+        fwrite(data, 1, size, file);
+        fclose(file);
+    }
+
+    static void write_text(const skr::filesystem::path& path, const char* text)
+    {
+        write_data(path, text, strlen(text));
+    }
+
+    static skr::String read_text(const skr::filesystem::path& path)
+    {
+        skr::String content;
+        if (auto file = fopen(path.string().c_str(), "rb"))
+        {
+            char buffer[256];
+            while (auto read = fread(buffer, 1, sizeof(buffer), file))
+                content.append(skr::StringView{ (const char8_t*)buffer, (uint64_t)read });
+            fclose(file);
+        }
+        return content;
+    }
+
+    // a finished cook: the resource, its header, a side output & the dependency file, then stored
+    void cook(const char* content)
+    {
+        write_text(output(u8"bin"), content);
+        write_text(output(u8"rh"), "header");
+        write_text(output(u8"buffer0"), "side output");
+        write_text(dependency_file(), R"({ "importerVersion": 3, "cookerVersion": 5, "files": ["source.txt"], "dependencies": [], "runtimeDependencies": [] })");
+        cache.Store(&context, 100);
+    }
+
+    // the project as on a fresh builder
+    void clear_outputs()
+    {
+        std::error_code ec = {};
+        for (const auto extension : { u8"bin", u8"rh", u8"buffer0" })
+            skr::filesystem::remove(output(extension), ec);
+        skr::filesystem::remove(dependency_file(), ec);
+    }
+
+    skr::filesystem::path root;
+    skd::SProject*        project = nullptr;
+    SAssetRecord          record;
+    TestCooker            cooker;
+    TestCookContext       context;
+    SCookCache            cache;
+};
+
+TEST_CASE_METHOD(CookCacheTests, "Hit")
+{
+    cook("cooked mesh");
+    EXPECT_EQ(cache.GetStatistics().stores, 1u);
+    clear_outputs();
+
+    REQUIRE(cache.Restore(&record, &cooker));
+    EXPECT_EQ(read_text(output(u8"bin")), u8"cooked mesh");
+    EXPECT_EQ(read_text(output(u8"rh")), u8"header");
+    EXPECT_EQ(read_text(output(u8"buffer0")), u8"side output");
+    EXPECT_EQ(read_text(dependency_file()), read_text(single_entry(project->GetCachePath() / "recipes")));
+    const auto statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.hits, 1u);
+    EXPECT_EQ(statistics.misses, 0u);
+    EXPECT_EQ(statistics.restoredBytes, strlen("cooked mesh") + strlen("header") + strlen("side output"));
+    EXPECT_EQ(statistics.savedTime, 100u);
+}
+
+TEST_CASE_METHOD(CookCacheTests, "Miss")
+{
+    SUBCASE("Empty")
+    {
+        EXPECT_FALSE(cache.Restore(&record, &cooker));
+    }
+
+    SUBCASE("ChangedSource")
+    {
+        cook("cooked mesh");
+        write_text(project->GetAssetPath() / "source.txt", "edited source of the mesh");
+        EXPECT_FALSE(cache.Restore(&record, &cooker));
+    }
+
+    SUBCASE("MissingObject")
+    {
+        cook("cooked mesh");
+        clear_outputs();
+        std::error_code ec = {};
+        skr::filesystem::remove_all(project->GetCachePath() / "objects", ec);
+        EXPECT_FALSE(cache.Restore(&record, &cooker));
+        EXPECT_FALSE(skr::filesystem::exists(output(u8"bin"), ec));
+    }
+
+    SUBCASE("MissingOutput")
+    {
+        cook("cooked mesh");
+        clear_outputs();
+        const auto object = single_entry(project->GetCachePath() / "objects");
+        std::error_code ec = {};
+        skr::filesystem::remove(object / skr::format(u8"{}.buffer0", record.guid).u8_str(), ec);
+        EXPECT_FALSE(cache.Restore(&record, &cooker));
+        EXPECT_FALSE(skr::filesystem::exists(dependency_file(), ec));
+    }
+
+    SUBCASE("PartialRecipe")
+    {
+        cook("cooked mesh");
+        clear_outputs();
+        const auto recipe  = single_entry(project->GetCachePath() / "recipes");
+        const auto content = read_text(recipe);
+        write_data(recipe, content.raw().data(), content.raw().size() / 2);
+        EXPECT_FALSE(cache.Restore(&record, &cooker));
+
+        // a recipe without its dependency list is as bad
+        write_text(recipe, R"({ "files": ["source.txt"] })");
+        EXPECT_FALSE(cache.Restore(&record, &cooker));
+    }
+
+    SUBCASE("PartialManifest")
+    {
+        cook("cooked mesh");
+        clear_outputs();
+        const auto manifest = single_entry(project->GetCachePath() / "objects") / "manifest.json";
+        write_text(manifest, R"({ "cookTime": 100, "files": [)");
+        EXPECT_FALSE(cache.Restore(&record, &cooker));
+    }
+
+    EXPECT_EQ(cache.GetStatistics().hits, 0u);
+}
+
+TEST_CASE_METHOD(CookCacheTests, "LeftoverStaging")
+{
+    // a builder that died before its renames leaves the staged entry & recipe behind
+    cook("cooked mesh");
+    clear_outputs();
+    std::error_code ec       = {};
+    const auto      cacheDir = project->GetCachePath();
+    const auto      object   = single_entry(cacheDir / "objects");
+    const auto      recipe   = single_entry(cacheDir / "recipes");
+    const auto      guid     = skr::format(u8"{}", record.guid);
+    const auto      staging  = cacheDir / "staging";
+    skr::filesystem::create_directories(staging, ec);
+    skr::filesystem::rename(object, staging / (object.filename().string() + "-" + guid.c_str()), ec);
+    REQUIRE(!ec);
+    skr::filesystem::rename(recipe, staging / (recipe.stem().string() + "-" + guid.c_str() + "-1.d"), ec);
+    REQUIRE(!ec);
+    EXPECT_FALSE(cache.Restore(&record, &cooker));
+
+    // the next store replaces the leftovers, restores then see its outputs only
+    cook("recooked mesh");
+    clear_outputs();
+    REQUIRE(cache.Restore(&record, &cooker));
+    EXPECT_EQ(read_text(output(u8"bin")), u8"recooked mesh");
+}
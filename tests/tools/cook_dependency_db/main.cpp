@@ -0,0 +1,114 @@
+#include "SkrToolCore/asset/cook_dependency_db.hpp"
+#include <stdio.h>
+
+#include "SkrTestFramework/framework.hpp"
+
+struct CookDependencyDBTests {
+    CookDependencyDBTests()
+    {
+        std::error_code ec = {};
+        root = skr::filesystem::absolute("./test_cook_dependency_db", ec);
+        skr::filesystem::remove_all(root, ec);
+        skr::filesystem::create_directories(root, ec);
+        // only the timestamp of the .d file is read by Update
+        dependencyFile = root / "asset.d";
+        if (auto file = fopen(dependencyFile.string().c_str(), "wb"))
+            fclose(file);
+        db = skd::asset::SCookDependencyDB::Open(root / "db");
+    }
+
+    ~CookDependencyDBTests() SKR_NOEXCEPT
+    {
+        skd::asset::SCookDependencyDB::Close(db);
+        std::error_code ec = {};
+        skr::filesystem::remove_all(root, ec);
+    }
+
+    static skr_guid_t guid(uint32_t index)
+    {
+        skr_guid_t result = {};
+        memcpy(&result, &index, sizeof(index));
+        return result;
+    }
+
+    void add(uint32_t asset, std::initializer_list<uint32_t> statics, std::initializer_list<uint32_t> runtimes = {}, const char* file = nullptr)
+    {
+        skd::asset::SCookDependencyRecord record;
+        for (auto dependency : statics)
+            record.staticDependencies.add(guid(dependency));
+        for (auto dependency : runtimes)
+            record.runtimeDependencies.add(guid(dependency));
+        if (file)
+            record.files.add(skr::String((root / file).lexically_normal().u8string().c_str()));
+        db->Update(guid(asset), dependencyFile, record);
+    }
+
+    skr::Vector<skr_guid_t> recooks(std::initializer_list<uint32_t> assets, const char* file = nullptr)
+    {
+        skr::Vector<skr_guid_t> changed;
+        for (auto asset : assets)
+            changed.add(guid(asset));
+        skr::Vector<skr::filesystem::path> files;
+        if (file)
+            files.add(root / file);
+        skr::Vector<skr_guid_t> result;
+        db->CollectRecooks({ files.data(), files.size() }, { changed.data(), changed.size() }, result);
+        return result;
+    }
+
+    skr::filesystem::path          root;
+    skr::filesystem::path          dependencyFile;
+    skd::asset::SCookDependencyDB* db = nullptr;
+};
+
+TEST_CASE_METHOD(CookDependencyDBTests, "CollectRecooks")
+{
+    // 1 -> 2 -> 3 statically, 4 references 3 at runtime, 3 reads source.gltf
+    add(1, { 2 });
+    add(2, { 3 });
+    add(3, {}, {}, "source.gltf");
+    add(4, {}, { 3 });
+
+    // static edges are followed transitively, the runtime one is not
+    auto result = recooks({ 3 });
+    EXPECT_EQ(result.size(), 3);
+    for (uint32_t asset : { 1u, 2u, 3u })
+        EXPECT_TRUE(result.contains(guid(asset)));
+    EXPECT_FALSE(result.contains(guid(4)));
+
+    // a changed source file starts from the assets reading it
+    result = recooks({}, "source.gltf");
+    EXPECT_EQ(result.size(), 3);
+    EXPECT_TRUE(result.contains(guid(1)));
+    EXPECT_EQ(recooks({}, "other.gltf").size(), 0);
+
+    // leaves have no users
+    result = recooks({ 1 });
+    EXPECT_EQ(result.size(), 1);
+
+    skr::Vector<skr_guid_t> users;
+    db->CollectRuntimeUsers(guid(3), users);
+    EXPECT_EQ(users.size(), 1);
+    EXPECT_EQ(users[0], guid(4));
+}
+
+TEST_CASE_METHOD(CookDependencyDBTests, "CollectRecooksCycle")
+{
+    // 5 <-> 6 depend on each other, 7 depends on 6
+    add(5, { 6 });
+    add(6, { 5 });
+    add(7, { 6 });
+    const auto result = recooks({ 5 });
+    EXPECT_EQ(result.size(), 3);
+    for (uint32_t asset : { 5u, 6u, 7u })
+        EXPECT_TRUE(result.contains(guid(asset)));
+}
+
+TEST_CASE_METHOD(CookDependencyDBTests, "ReplaceEdges")
+{
+    // updating a record drops the edges it no longer has
+    add(1, { 2 });
+    EXPECT_EQ(recooks({ 2 }).size(), 2);
+    add(1, {});
+    EXPECT_EQ(recooks({ 2 }).size(), 1);
+}
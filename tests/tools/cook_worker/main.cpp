@@ -0,0 +1,93 @@
+#include "SkrCore/process.h"
+#include "SkrTask/fib_task.hpp"
+#include "SkrToolCore/asset/cook_system.hpp"
+#include "SkrToolCore/asset/cook_worker.hpp"
+
+#include "SkrTestFramework/framework.hpp"
+
+// the workers are CookWorkerTestWorker processes, built next to this test & found from the working directory
+struct CookWorkerTests {
+    CookWorkerTests()
+    {
+        scheduler.initialize({});
+        scheduler.bind();
+
+        std::error_code ec = {};
+        const auto      id = skr_get_current_process_id();
+        boardPath          = skr::filesystem::temp_directory_path(ec) / skr::format(u8"SkrCookWorkerTest-{}", id).c_str();
+        markerPath         = skr::filesystem::temp_directory_path(ec) / skr::format(u8"SkrCookWorkerTest-{}.marker", id).c_str();
+        skr::filesystem::remove(markerPath, ec);
+#if defined(_WIN32)
+        const auto worker = skr::filesystem::absolute("CookWorkerTestWorker.exe", ec);
+#else
+        const auto worker = skr::filesystem::absolute("CookWorkerTestWorker", ec);
+#endif
+        desc.scheduler   = &scheduler;
+        desc.executable  = skr::String(worker.u8string().c_str());
+        desc.boardPath   = boardPath;
+        desc.workerCount = 1;
+
+        using namespace skr::literals;
+        record.guid = u8"{6C3E2F1A-8B4D-4E2A-9F61-3D2B7A5C1E08}"_guid;
+        record.path = "test.asset";
+    }
+
+    ~CookWorkerTests() SKR_NOEXCEPT
+    {
+        std::error_code ec = {};
+        skr::filesystem::remove_all(boardPath, ec);
+        skr::filesystem::remove(markerPath, ec);
+        scheduler.unbind();
+    }
+
+    skr::task::scheduler_t          scheduler;
+    skr::filesystem::path           boardPath;
+    skr::filesystem::path           markerPath;
+    skd::asset::SCookWorkerPoolDesc desc;
+    skd::asset::SAssetRecord        record = {};
+};
+
+TEST_CASE_METHOD(CookWorkerTests, "Succeeds")
+{
+    auto pool = skd::asset::SCookWorkerPool::Create(desc);
+    EXPECT_EQ(pool->Cook(&record), skd::asset::ECookWorkerResult::Succeeded);
+    EXPECT_EQ(pool->Cook(&record), skd::asset::ECookWorkerResult::Succeeded);
+    const auto stats = pool->GetStatistics();
+    EXPECT_EQ(stats.jobs, 2u);
+    EXPECT_EQ(stats.succeeded, 2u);
+    EXPECT_EQ(stats.spawns, 1u);
+    EXPECT_EQ(stats.crashes, 0u);
+    skd::asset::SCookWorkerPool::Destroy(pool);
+}
+
+TEST_CASE_METHOD(CookWorkerTests, "RetryAfterCrash")
+{
+    // the first worker dies with the job, its respawn cooks it
+    const auto marker = markerPath.u8string();
+    desc.arguments.add(u8"--crash-once");
+    desc.arguments.add(marker.c_str());
+    auto pool = skd::asset::SCookWorkerPool::Create(desc);
+    EXPECT_EQ(pool->Cook(&record), skd::asset::ECookWorkerResult::Succeeded);
+    const auto stats = pool->GetStatistics();
+    EXPECT_EQ(stats.jobs, 2u);
+    EXPECT_EQ(stats.succeeded, 1u);
+    EXPECT_EQ(stats.failed, 0u);
+    EXPECT_EQ(stats.crashes, 1u);
+    EXPECT_EQ(stats.retries, 1u);
+    EXPECT_EQ(stats.spawns, 2u);
+    skd::asset::SCookWorkerPool::Destroy(pool);
+}
+
+TEST_CASE_METHOD(CookWorkerTests, "GiveUpAfterRetries")
+{
+    desc.arguments.add(u8"--crash-always");
+    desc.maxRetries = 1;
+    auto pool       = skd::asset::SCookWorkerPool::Create(desc);
+    EXPECT_EQ(pool->Cook(&record), skd::asset::ECookWorkerResult::Failed);
+    const auto stats = pool->GetStatistics();
+    EXPECT_EQ(stats.jobs, 2u);
+    EXPECT_EQ(stats.failed, 1u);
+    EXPECT_EQ(stats.crashes, 2u);
+    EXPECT_EQ(stats.retries, 1u);
+    skd::asset::SCookWorkerPool::Destroy(pool);
+}
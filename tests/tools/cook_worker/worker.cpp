@@ -0,0 +1,55 @@
+#include "SkrOS/filesystem.hpp"
+#include "SkrOS/thread.h"
+#include "SkrToolCore/asset/cook_worker.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+// stands in for the resource compiler in the cook worker tests, every job succeeds unless told to crash:
+// CookWorkerTestWorker [--crash-once <marker> | --crash-always] --worker <index> --board <path>
+int main(int argc, char** argv)
+{
+    const char* crashOnce   = nullptr;
+    bool        crashAlways = false;
+    const char* board       = nullptr;
+    uint32_t    index       = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--crash-once") && i + 1 < argc)
+            crashOnce = argv[++i];
+        else if (!strcmp(argv[i], "--crash-always"))
+            crashAlways = true;
+        else if (!strcmp(argv[i], "--worker") && i + 1 < argc)
+            index = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--board") && i + 1 < argc)
+            board = argv[++i];
+    }
+    if (!board)
+        return 1;
+
+    auto client = skd::asset::SCookWorkerClient::Create(skr::filesystem::path(board), index);
+    if (!client)
+        return 1;
+    bool quit = false;
+    while (!quit)
+    {
+        skr_guid_t job;
+        if (client->Update(job, quit))
+        {
+            // dies with the job in hands, the board is left as a crash would leave it
+            std::error_code ec = {};
+            if (crashAlways)
+                return 3;
+            if (crashOnce && !skr::filesystem::exists(crashOnce, ec))
+            {
+                if (auto marker = fopen(crashOnce, "wb"))
+                    fclose(marker);
+                return 3;
+            }
+            client->ReportFinished(true, 0);
+        }
+        skr_thread_sleep(1);
+    }
+    skd::asset::SCookWorkerClient::Destroy(client);
+    return 0;
+}
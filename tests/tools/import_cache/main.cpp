@@ -0,0 +1,143 @@
+#include "SkrToolCore/asset/import_cache.hpp"
+#include "SkrCore/memory/memory.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "SkrTestFramework/framework.hpp"
+
+struct ImportCacheTests {
+    ImportCacheTests()
+    {
+        std::error_code ec = {};
+        root = skr::filesystem::absolute("./test_import_cache", ec);
+        skr::filesystem::remove_all(root, ec);
+        skr::filesystem::create_directories(root, ec);
+        write(root / "a.gltf", "first source");
+        write(root / "b.gltf", "second source");
+        freed = 0;
+    }
+
+    ~ImportCacheTests() SKR_NOEXCEPT
+    {
+        std::error_code ec = {};
+        skr::filesystem::remove_all(root, ec);
+    }
+
+    static void write(const skr::filesystem::path& path, const char* text)
+    {
+        auto file = fopen(path.string().c_str(), "wb");
+        REQUIRE(file != nullptr);
+        fwrite(text, 1, strlen(text), file);
+        fclose(file);
+    }
+
+    // documents are the loaded file names, 100 resident bytes each
+    void* acquire(const char* name)
+    {
+        const auto path = root / name;
+        const auto load = [&](uint64_t& bytes) -> void* {
+            loads++;
+            bytes = 100;
+            return SkrNew<skr::String>(path.u8string().c_str());
+        };
+        return cache.Acquire(u8"test", path, load, &free_document);
+    }
+
+    static void free_document(void* document)
+    {
+        freed++;
+        SkrDelete((skr::String*)document);
+    }
+
+    static uint32_t          freed;
+    uint32_t                 loads = 0;
+    skr::filesystem::path    root;
+    skd::asset::SImportCache cache;
+};
+uint32_t ImportCacheTests::freed = 0;
+
+TEST_CASE_METHOD(ImportCacheTests, "ReleasedAtZero")
+{
+    // without an idle budget the document goes with its last reference
+    cache.idleBudget = 0;
+    auto first       = acquire("a.gltf");
+    auto second      = acquire("a.gltf");
+    REQUIRE(first != nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(loads, 1u);
+    EXPECT_EQ(cache.GetStatistics().residentBytes, 100u);
+
+    cache.Release(first);
+    EXPECT_EQ(freed, 0u);
+    cache.Release(second);
+    EXPECT_EQ(freed, 1u);
+    EXPECT_EQ(cache.GetStatistics().residentBytes, 0u);
+    EXPECT_EQ(cache.GetStatistics().peakBytes, 100u);
+
+    // the next importer parses again
+    auto third = acquire("a.gltf");
+    EXPECT_EQ(loads, 2u);
+    cache.Release(third);
+    EXPECT_EQ(freed, 2u);
+    const auto statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.hits, 1u);
+    EXPECT_EQ(statistics.misses, 2u);
+}
+
+TEST_CASE_METHOD(ImportCacheTests, "IdleBudget")
+{
+    // one idle document fits, the least recently released one is evicted for the second
+    cache.idleBudget = 150;
+    auto a           = acquire("a.gltf");
+    auto b           = acquire("b.gltf");
+    cache.Release(a);
+    EXPECT_EQ(freed, 0u);
+    EXPECT_EQ(acquire("a.gltf"), a);
+    EXPECT_EQ(loads, 2u);
+    cache.Release(a);
+    cache.Release(b);
+    EXPECT_EQ(freed, 1u);
+    EXPECT_EQ(cache.GetStatistics().residentBytes, 100u);
+
+    // documents in use survive a flush
+    auto kept = acquire("b.gltf");
+    EXPECT_EQ(loads, 2u);
+    cache.Flush();
+    EXPECT_EQ(freed, 1u);
+    cache.Release(kept);
+    cache.Flush();
+    EXPECT_EQ(freed, 2u);
+    EXPECT_EQ(cache.GetStatistics().residentBytes, 0u);
+}
+
+TEST_CASE_METHOD(ImportCacheTests, "ModifiedSource")
+{
+    // readers of the old document keep it until they release, then it is freed right away
+    auto old = acquire("a.gltf");
+    write(root / "a.gltf", "first source, edited");
+    auto fresh = acquire("a.gltf");
+    REQUIRE(fresh != nullptr);
+    EXPECT_NE(fresh, old);
+    EXPECT_EQ(loads, 2u);
+    EXPECT_EQ(cache.GetStatistics().residentBytes, 200u);
+    cache.Release(old);
+    EXPECT_EQ(freed, 1u);
+    cache.Release(fresh);
+    EXPECT_EQ(freed, 1u);
+    EXPECT_EQ(cache.GetStatistics().residentBytes, 100u);
+}
+
+TEST_CASE_METHOD(ImportCacheTests, "FailedLoad")
+{
+    const auto path = root / "a.gltf";
+    const auto fail = [&](uint64_t&) -> void* { loads++; return nullptr; };
+    EXPECT_EQ(cache.Acquire(u8"test", path, fail, &free_document), nullptr);
+    EXPECT_EQ(cache.Acquire(u8"test", path, fail, &free_document), nullptr);
+    // failures are not cached, the next importer loads again
+    EXPECT_EQ(loads, 2u);
+    auto document = acquire("a.gltf");
+    EXPECT_NE(document, nullptr);
+    EXPECT_EQ(loads, 3u);
+    cache.Release(document);
+    EXPECT_EQ(freed, 0u);
+}
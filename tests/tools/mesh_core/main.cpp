@@ -0,0 +1,362 @@
+#include "SkrMeshCore/mesh_processing.hpp"
+#include "SkrGraphics/api.h"
+#include <algorithm>
+#include <array>
+#include <math.h>
+#include <string.h>
+
+#include "SkrTestFramework/framework.hpp"
+
+struct MeshCoreTests {
+    // single bin mesh, streams in float: POSITION float3, TEXCOORD float2, NORMAL float3, TANGENT float4, then 32 bit indices
+    void build(uint32_t vertex_count)
+    {
+        bins.resize_default(1);
+        auto& bin = bins[0];
+        mesh.bins.add({ 0, 0, true, true });
+        auto& prim            = mesh.primitives.add_default().ref();
+        prim.vertex_layout_id = {};
+        prim.material_index   = 0;
+        prim.index_buffer     = {};
+        prim.vertex_count     = vertex_count;
+        const auto add_stream = [&](ESkrVertexAttribute attribute, uint32_t stride) {
+            auto& vb     = prim.vertex_buffers.add_default().ref();
+            vb           = {};
+            vb.attribute = attribute;
+            vb.stride    = stride;
+            vb.offset    = (uint32_t)bin.size();
+            bin.resize_zeroed(bin.size() + (uint64_t)stride * vertex_count);
+            return vb.offset;
+        };
+        const auto positions = add_stream(SKR_VERT_ATTRIB_POSITION, sizeof(float) * 3);
+        const auto texcoords = add_stream(SKR_VERT_ATTRIB_TEXCOORD, sizeof(float) * 2);
+        const auto normals   = add_stream(SKR_VERT_ATTRIB_NORMAL, sizeof(float) * 3);
+        const auto tangents  = add_stream(SKR_VERT_ATTRIB_TANGENT, sizeof(float) * 4);
+        for (uint32_t i = 0; i < vertex_count; i++)
+        {
+            // points spread over a stretched, shifted sphere
+            const float theta = 0.37f * (float)i, phi = 0.11f * (float)i;
+            const float n[3]  = { sinf(phi) * cosf(theta), sinf(phi) * sinf(theta), cosf(phi) };
+            const float p[3]  = { 10.f + 4.f * n[0], -3.f + 0.5f * n[1], 250.f * n[2] };
+            const float t[4]  = { -sinf(theta), cosf(theta), 0.f, (i % 2) ? -1.f : 1.f };
+            const float uv[2] = { (float)i / (float)vertex_count, 2.f - (float)i / (float)vertex_count };
+            memcpy(bin.data() + positions + i * sizeof(float) * 3, p, sizeof(p));
+            memcpy(bin.data() + texcoords + i * sizeof(float) * 2, uv, sizeof(uv));
+            memcpy(bin.data() + normals + i * sizeof(float) * 3, n, sizeof(n));
+            memcpy(bin.data() + tangents + i * sizeof(float) * 4, t, sizeof(t));
+        }
+        prim.index_buffer.index_offset = (uint32_t)bin.size();
+        prim.index_buffer.stride       = sizeof(uint32_t);
+        for (uint32_t i = 0; i + 2 < vertex_count; i++)
+        {
+            const uint32_t triangle[3] = { i, i + 1, i + 2 };
+            bin.append((const uint8_t*)triangle, sizeof(triangle));
+            prim.index_buffer.index_count += 3;
+        }
+        mesh.bins[0].byte_length = bin.size();
+        source                   = bins;
+    }
+
+    // 16x16 vertex height field with positions only, 450 triangles in indices of index_stride bytes, then a byte of padding
+    void build_grid(uint32_t index_stride)
+    {
+        constexpr uint32_t kSide = 16;
+        bins.resize_default(1);
+        auto& bin = bins[0];
+        mesh.bins.add({ 0, 0, true, true });
+        auto& prim            = mesh.primitives.add_default().ref();
+        prim.vertex_layout_id = {};
+        prim.material_index   = 0;
+        prim.index_buffer     = {};
+        prim.vertex_count     = kSide * kSide;
+        auto& vb              = prim.vertex_buffers.add_default().ref();
+        vb                    = {};
+        vb.attribute          = SKR_VERT_ATTRIB_POSITION;
+        vb.stride             = sizeof(float) * 3;
+        for (uint32_t y = 0; y < kSide; y++)
+        {
+            for (uint32_t x = 0; x < kSide; x++)
+            {
+                const float p[3] = { (float)x, (float)y, 0.4f * sinf(0.7f * (float)x) * cosf(0.5f * (float)y) };
+                bin.append((const uint8_t*)p, sizeof(p));
+            }
+        }
+        prim.index_buffer.index_offset = (uint32_t)bin.size();
+        prim.index_buffer.stride       = index_stride;
+        for (uint32_t y = 0; y + 1 < kSide; y++)
+        {
+            for (uint32_t x = 0; x + 1 < kSide; x++)
+            {
+                const uint32_t v       = y * kSide + x;
+                const uint32_t quad[6] = { v, v + 1, v + kSide, v + 1, v + kSide + 1, v + kSide };
+                for (const auto index : quad)
+                {
+                    bin.resize_zeroed(bin.size() + index_stride);
+                    memcpy(bin.data() + bin.size() - index_stride, &index, index_stride);
+                }
+                prim.index_buffer.index_count += 6;
+            }
+        }
+        // LODs are appended after whatever follows the indices & must be aligned to the stride again
+        bin.add(0);
+        mesh.bins[0].byte_length = bin.size();
+    }
+
+    template <typename T>
+    const T* stream(const skr::Vector<skr::Vector<uint8_t>>& from, const skr_vertex_buffer_entry_t& vb, uint32_t vertex)
+    {
+        return (const T*)(from[vb.buffer_index].data() + vb.offset + (uint64_t)vb.stride * vertex);
+    }
+
+    static float half_to_float(uint16_t h)
+    {
+        const uint32_t exponent = (h >> 10) & 0x1f, mantissa = h & 0x3ff;
+        const float    value    = exponent ? ldexpf((float)(mantissa | 0x400), (int)exponent - 25) : ldexpf((float)mantissa, -24);
+        return (h & 0x8000) ? -value : value;
+    }
+
+    static void octahedral_decode(const int16_t* q, float* n)
+    {
+        float u = (float)q[0] / 32767.f, v = (float)q[1] / 32767.f;
+        const float z = 1.f - fabsf(u) - fabsf(v);
+        if (z < 0.f)
+        {
+            const float fold_u = (1.f - fabsf(v)) * (u >= 0.f ? 1.f : -1.f);
+            const float fold_v = (1.f - fabsf(u)) * (v >= 0.f ? 1.f : -1.f);
+            u                  = fold_u;
+            v                  = fold_v;
+        }
+        const float l = sqrtf(u * u + v * v + z * z);
+        n[0]          = u / l;
+        n[1]          = v / l;
+        n[2]          = z / l;
+    }
+
+    // triangles with their smallest index first, sorted: equal for the same triangles in any order
+    static skr::Vector<std::array<uint32_t, 3>> canonical_triangles(const uint32_t* indices, uint64_t index_count)
+    {
+        skr::Vector<std::array<uint32_t, 3>> triangles;
+        for (uint64_t i = 0; i + 2 < index_count; i += 3)
+        {
+            std::array<uint32_t, 3> triangle = { indices[i], indices[i + 1], indices[i + 2] };
+            while (triangle[0] > triangle[1] || triangle[0] > triangle[2])
+                triangle = { triangle[1], triangle[2], triangle[0] };
+            triangles.add(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    skr_mesh_resource_t                 mesh;
+    skr::Vector<skr::Vector<uint8_t>>   bins;
+    skr::Vector<skr::Vector<uint8_t>>   source;
+    skd::asset::SMeshCompressStatistics stats;
+};
+
+TEST_CASE_METHOD(MeshCoreTests, "QuantizeRoundTrip")
+{
+    using namespace skr::literals;
+    // the streams of the layout in the order of the primitive's vertex buffers
+    const auto       layout_id = u8"0d8f7a52-61c4-4e3b-9a0e-5b2c7d4f1e93"_guid;
+    CGPUVertexLayout layout    = {};
+    layout.attributes[0]       = { u8"POSITION", 1, CGPU_FORMAT_R16G16B16A16_SNORM, 0, 0, sizeof(int16_t) * 4, CGPU_INPUT_RATE_VERTEX };
+    layout.attributes[1]       = { u8"TEXCOORD", 1, CGPU_FORMAT_R16G16_SFLOAT, 1, 0, sizeof(uint16_t) * 2, CGPU_INPUT_RATE_VERTEX };
+    layout.attributes[2]       = { u8"NORMAL", 1, CGPU_FORMAT_R16G16_SNORM, 2, 0, sizeof(int16_t) * 2, CGPU_INPUT_RATE_VERTEX };
+    layout.attributes[3]       = { u8"TANGENT", 1, CGPU_FORMAT_R16G16_SNORM, 3, 0, sizeof(int16_t) * 2, CGPU_INPUT_RATE_VERTEX };
+    layout.attribute_count     = 4;
+    skr_mesh_resource_register_vertex_layout(layout_id, u8"MeshCoreTestQuantized", &layout);
+
+    constexpr uint32_t kVertexCount = 512;
+    build(kVertexCount);
+    mesh.primitives[0].vertex_layout_id = layout_id;
+    const auto source_streams           = mesh.primitives[0].vertex_buffers;
+    const auto source_indices           = mesh.primitives[0].index_buffer;
+    skd::asset::QuantizeMeshVertices(mesh, bins, stats);
+
+    const auto& prim = mesh.primitives[0];
+    REQUIRE(prim.vertex_buffers.size() == 4);
+    EXPECT_EQ(prim.vertex_buffers[0].stride, sizeof(int16_t) * 4);
+    EXPECT_EQ(prim.vertex_buffers[1].stride, sizeof(uint16_t) * 2);
+    EXPECT_EQ(prim.vertex_buffers[2].stride, sizeof(int16_t) * 2);
+    EXPECT_EQ(prim.vertex_buffers[3].stride, sizeof(int16_t) * 2);
+    EXPECT_TRUE(stats.quantizedBytes < stats.rawBytes);
+    EXPECT_EQ(mesh.bins[0].byte_length, bins[0].size());
+
+    // one snorm16 step of the bounds on every axis
+    const float position_error[3] = { mesh.position_scale.x / 32767.f, mesh.position_scale.y / 32767.f, mesh.position_scale.z / 32767.f };
+    for (uint32_t i = 0; i < kVertexCount; i++)
+    {
+        const auto* p = stream<float>(source, source_streams[0], i);
+        const auto* q = stream<int16_t>(bins, prim.vertex_buffers[0], i);
+        EXPECT_NEAR((float)q[0] / 32767.f * mesh.position_scale.x + mesh.position_offset.x, p[0], position_error[0]);
+        EXPECT_NEAR((float)q[1] / 32767.f * mesh.position_scale.y + mesh.position_offset.y, p[1], position_error[1]);
+        EXPECT_NEAR((float)q[2] / 32767.f * mesh.position_scale.z + mesh.position_offset.z, p[2], position_error[2]);
+
+        const auto* uv  = stream<float>(source, source_streams[1], i);
+        const auto* quv = stream<uint16_t>(bins, prim.vertex_buffers[1], i);
+        EXPECT_NEAR(half_to_float(quv[0]), uv[0], fabsf(uv[0]) / 1024.f + 1e-7f);
+        EXPECT_NEAR(half_to_float(quv[1]), uv[1], fabsf(uv[1]) / 1024.f + 1e-7f);
+
+        float decoded[3];
+        const auto* n = stream<float>(source, source_streams[2], i);
+        octahedral_decode(stream<int16_t>(bins, prim.vertex_buffers[2], i), decoded);
+        EXPECT_TRUE(decoded[0] * n[0] + decoded[1] * n[1] + decoded[2] * n[2] >= 0.9999f);
+
+        // handedness rides in the lowest bit of y, it costs one more snorm step
+        const auto* t  = stream<float>(source, source_streams[3], i);
+        const auto* qt = stream<int16_t>(bins, prim.vertex_buffers[3], i);
+        octahedral_decode(qt, decoded);
+        EXPECT_TRUE(decoded[0] * t[0] + decoded[1] * t[1] + decoded[2] * t[2] >= 0.9999f);
+        EXPECT_EQ((qt[1] & 1) != 0, t[3] < 0.f);
+    }
+
+    // indices are copied as they are
+    REQUIRE(prim.index_buffer.index_count == source_indices.index_count);
+    EXPECT_EQ(memcmp(bins[0].data() + prim.index_buffer.index_offset,
+                     source[0].data() + source_indices.index_offset,
+                     (uint64_t)source_indices.index_count * source_indices.stride),
+              0);
+}
+
+TEST_CASE_METHOD(MeshCoreTests, "FloatLayoutKeepsStreams")
+{
+    // without a quantized layout the streams are only repacked
+    build(64);
+    const auto source_streams = mesh.primitives[0].vertex_buffers;
+    skd::asset::QuantizeMeshVertices(mesh, bins, stats);
+    const auto& prim = mesh.primitives[0];
+    for (uint32_t j = 0; j < prim.vertex_buffers.size(); j++)
+    {
+        const auto& vb = prim.vertex_buffers[j];
+        REQUIRE(vb.stride == source_streams[j].stride);
+        EXPECT_EQ(memcmp(bins[0].data() + vb.offset, source[0].data() + source_streams[j].offset, (uint64_t)vb.stride * prim.vertex_count), 0);
+    }
+}
+
+TEST_CASE_METHOD(MeshCoreTests, "MeshletLimits")
+{
+    constexpr uint32_t kVertexCount = 1024;
+    build(kVertexCount);
+    const auto&           prim = mesh.primitives[0];
+    skr::Vector<uint32_t> indices;
+    skd::asset::ReadPrimitiveIndices(prim, bins, indices);
+    const auto expected = canonical_triangles(indices.data(), indices.size());
+
+    // the last limits are past what mesh shaders take, they are clamped to 255 vertices & 512 triangles
+    const uint32_t limits[][2] = { { 64, 124 }, { 32, 64 }, { 3, 4 }, { 128, 126 }, { 300, 600 } };
+    for (const auto& limit : limits)
+    {
+        skd::asset::SMeshCookConfig cfg;
+        cfg.meshlets            = true;
+        cfg.meshletMaxVertices  = limit[0];
+        cfg.meshletMaxTriangles = limit[1];
+        const uint32_t max_vertices  = std::min(limit[0], 255u);
+        const uint32_t max_triangles = std::min(limit[1], 512u) & ~3u;
+
+        skr_meshlet_buffer_entry_t          entry;
+        skr::Vector<uint8_t>                meshlet_bin;
+        skd::asset::SMeshOptimizeStatistics optimize;
+        skd::asset::BuildMeshletStream(prim, bins, cfg, entry, meshlet_bin, optimize);
+        REQUIRE(entry.meshlet_count > 0);
+        EXPECT_EQ(meshlet_bin.size(), skr::renderer::MeshletStreamLayout::Get(entry).size);
+        EXPECT_EQ(optimize.meshlets, entry.meshlet_count);
+        EXPECT_EQ(optimize.meshletVertices, entry.vertex_count);
+        EXPECT_EQ(optimize.meshletBytes, meshlet_bin.size());
+
+        const auto view = skr::renderer::MeshletView::Get(meshlet_bin.data(), entry);
+        skr::Vector<uint32_t> rebuilt;
+        for (uint32_t m = 0; m < entry.meshlet_count; m++)
+        {
+            const auto& meshlet = view.meshlets[m];
+            const auto& bounds  = view.bounds[m];
+            EXPECT_TRUE(meshlet.vertex_count <= max_vertices);
+            EXPECT_TRUE(meshlet.triangle_count <= max_triangles);
+            REQUIRE(meshlet.vertex_offset + meshlet.vertex_count <= entry.vertex_count);
+            REQUIRE(meshlet.triangle_offset + meshlet.triangle_count * 3 <= entry.triangle_size);
+            EXPECT_EQ(meshlet.triangle_offset % 4, 0u);
+            for (uint32_t t = 0; t < meshlet.triangle_count * 3; t++)
+            {
+                const auto local = view.triangles[meshlet.triangle_offset + t];
+                REQUIRE(local < meshlet.vertex_count);
+                rebuilt.add(view.vertices[meshlet.vertex_offset + local]);
+            }
+            // every vertex of the meshlet is in its bounding sphere
+            for (uint32_t v = 0; v < meshlet.vertex_count; v++)
+            {
+                const auto* p  = stream<float>(bins, *skd::asset::FindPrimitivePositions(prim), view.vertices[meshlet.vertex_offset + v]);
+                const float dx = p[0] - bounds.center.x, dy = p[1] - bounds.center.y, dz = p[2] - bounds.center.z;
+                EXPECT_TRUE(sqrtf(dx * dx + dy * dy + dz * dz) <= bounds.radius * 1.001f + 1e-4f);
+            }
+        }
+        // the meshlets hold every triangle of the primitive once
+        EXPECT_EQ(optimize.meshletTriangles, (uint64_t)prim.index_buffer.index_count / 3);
+        const auto actual = canonical_triangles(rebuilt.data(), rebuilt.size());
+        REQUIRE(actual.size() == expected.size());
+        EXPECT_TRUE(actual == expected);
+    }
+}
+
+TEST_CASE_METHOD(MeshCoreTests, "PrimitiveLODs")
+{
+    skd::asset::SMeshCookConfig cfg;
+    cfg.lodRatios = { 0.5f, 0.25f, 0.125f };
+    cfg.lodErrors = { 1.f };
+    const auto check = [&](uint32_t stride) {
+        build_grid(stride);
+        auto&                 prim = mesh.primitives[0];
+        skr::Vector<uint32_t> source;
+        skd::asset::ReadPrimitiveIndices(prim, bins, source);
+
+        skr::Vector<skd::asset::SMeshPrimitiveLOD> lods;
+        skd::asset::SMeshOptimizeStatistics        optimize;
+        skd::asset::BuildPrimitiveLODs(prim, bins, cfg, lods, optimize);
+        REQUIRE(lods.size() >= 2);
+        REQUIRE(optimize.lods.size() == cfg.lodRatios.size());
+
+        // every LOD drops indices of its predecessor & errors only add up along the chain
+        uint64_t previous_count = source.size();
+        float    previous_error = 0.f;
+        for (uint32_t i = 0; i < lods.size(); i++)
+        {
+            const auto& lod = lods[i];
+            EXPECT_EQ(lod.indices.size() % 3, 0u);
+            EXPECT_TRUE(lod.indices.size() >= 3);
+            EXPECT_TRUE(lod.indices.size() < previous_count);
+            EXPECT_TRUE(lod.error >= previous_error);
+            for (const auto index : lod.indices)
+                EXPECT_TRUE(index < prim.vertex_count);
+            EXPECT_EQ(optimize.lods[i].primitives, 1u);
+            EXPECT_EQ(optimize.lods[i].triangles, lod.indices.size() / 3);
+            previous_count = lod.indices.size();
+            previous_error = lod.error;
+        }
+
+        // emplaced LODs read back through the index buffer of the primitive, LOD 0 is untouched
+        skd::asset::EmplacePrimitiveLODs(prim, bins, { lods.data(), lods.size() });
+        REQUIRE(prim.lods.size() == lods.size());
+        skr::Vector<uint32_t> indices;
+        skd::asset::ReadPrimitiveIndices(prim, bins, indices);
+        EXPECT_TRUE(indices == source);
+        uint32_t previous_end = prim.index_buffer.index_count + 1;
+        for (uint32_t i = 0; i < lods.size(); i++)
+        {
+            const auto& range = prim.lods[i];
+            EXPECT_EQ(range.index_count, lods[i].indices.size());
+            EXPECT_EQ(range.error, lods[i].error);
+            // the padding after LOD 0 & the previous LODs stay in place
+            EXPECT_TRUE(range.first_index >= previous_end);
+            previous_end = range.first_index + range.index_count;
+            REQUIRE(prim.index_buffer.index_offset + (uint64_t)(range.first_index + range.index_count) * stride <= bins[0].size());
+
+            auto lod_prim                     = prim;
+            lod_prim.index_buffer.first_index = range.first_index;
+            lod_prim.index_buffer.index_count = range.index_count;
+            skd::asset::ReadPrimitiveIndices(lod_prim, bins, indices);
+            EXPECT_TRUE(indices == lods[i].indices);
+        }
+    };
+    // 8, 16 & 32 bit indices
+    SUBCASE("Stride8") { check(1); }
+    SUBCASE("Stride16") { check(2); }
+    SUBCASE("Stride32") { check(4); }
+}
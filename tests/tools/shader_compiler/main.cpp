@@ -0,0 +1,216 @@
+#include "SkrShaderCompiler/shader_compiler.hpp"
+#include "SkrShaderCompiler/shader_compile_cache.hpp"
+#include "SkrCore/memory/memory.h"
+#include <stdio.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "SkrTestFramework/framework.hpp"
+
+using namespace skd::asset;
+
+struct ShaderCompilerTests {
+    ShaderCompilerTests()
+    {
+        std::error_code ec = {};
+        root = skr::filesystem::absolute("./test_shader_compile_cache", ec);
+        skr::filesystem::remove_all(root, ec);
+        skr::filesystem::create_directories(root, ec);
+    }
+
+    ~ShaderCompilerTests() SKR_NOEXCEPT
+    {
+        std::error_code ec = {};
+        skr::filesystem::remove_all(root, ec);
+    }
+
+    // the key of a compile as the dxc backend builds it
+    static uint64_t key_of(uint64_t compiler_version, std::initializer_list<const wchar_t*> args, const char* preprocessed,
+                           ECGPUShaderBytecodeType format = CGPU_SHADER_BYTECODE_TYPE_DXIL)
+    {
+        ShaderCompileKey key(compiler_version, format);
+        for (auto arg : args)
+            key.Append(arg, wcslen(arg) * sizeof(wchar_t));
+        key.Append(preprocessed, strlen(preprocessed));
+        return key.Get();
+    }
+
+    skr::filesystem::path record_path(uint64_t key) const
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.rec", (unsigned long long)key);
+        return root / "keys" / name;
+    }
+
+    skr::Vector<uint8_t> read_file(const skr::filesystem::path& path) const
+    {
+        skr::Vector<uint8_t> content;
+        if (auto file = fopen(path.string().c_str(), "rb"))
+        {
+            uint8_t buffer[256];
+            while (auto read = fread(buffer, 1, sizeof(buffer), file))
+                content.append(buffer, read);
+            fclose(file);
+        }
+        return content;
+    }
+
+    void write_file(const skr::filesystem::path& path, const uint8_t* data, uint64_t size) const
+    {
+        auto file = fopen(path.string().c_str(), "wb");
+        REQUIRE(file != nullptr);
+        fwrite(data, 1, size, file);
+        fclose(file);
+    }
+
+    // stores a compile of 64 bytes of bytecode & a pdb under key
+    void store(const ShaderCompileCache& cache, uint64_t key, ShaderCompileCacheEntry& entry) const
+    {
+        uint8_t bytecode[64], pdb[16];
+        for (uint32_t i = 0; i < sizeof(bytecode); i++)
+            bytecode[i] = (uint8_t)(i * 7 + 3);
+        memset(pdb, 0xAB, sizeof(pdb));
+        entry.stage     = CGPU_SHADER_STAGE_FRAG;
+        entry.flags     = 2;
+        entry.digits[0] = 11;
+        entry.digits[1] = 22;
+        entry.digits[2] = 33;
+        entry.digits[3] = 44;
+        entry.has_pdb   = true;
+        cache.Store(key, CGPU_SHADER_BYTECODE_TYPE_DXIL, entry, { bytecode, sizeof(bytecode) }, { pdb, sizeof(pdb) });
+    }
+
+    skr::filesystem::path root;
+};
+
+TEST_CASE_METHOD(ShaderCompilerTests, "CompileKey")
+{
+    const auto base = key_of(1, { L"-T", L"ps_6_0", L"-DSHADOWS=1" }, "float4 main() : SV_Target { return 1; }");
+    // identical input, identical key
+    EXPECT_EQ(base, key_of(1, { L"-T", L"ps_6_0", L"-DSHADOWS=1" }, "float4 main() : SV_Target { return 1; }"));
+    // a changed define, compiler build, target format or source is another compile
+    EXPECT_NE(base, key_of(1, { L"-T", L"ps_6_0", L"-DSHADOWS=0" }, "float4 main() : SV_Target { return 1; }"));
+    EXPECT_NE(base, key_of(1, { L"-T", L"ps_6_0" }, "float4 main() : SV_Target { return 1; }"));
+    EXPECT_NE(base, key_of(2, { L"-T", L"ps_6_0", L"-DSHADOWS=1" }, "float4 main() : SV_Target { return 1; }"));
+    EXPECT_NE(base, key_of(1, { L"-T", L"ps_6_0", L"-DSHADOWS=1" }, "float4 main() : SV_Target { return 1; }", CGPU_SHADER_BYTECODE_TYPE_SPIRV));
+    EXPECT_NE(base, key_of(1, { L"-T", L"ps_6_0", L"-DSHADOWS=1" }, "float4 main() : SV_Target { return 0; }"));
+    EXPECT_NE(base, 0u);
+}
+
+TEST_CASE_METHOD(ShaderCompilerTests, "CacheHitAndMiss")
+{
+    const ShaderCompileCache cache(root);
+    const auto               key = key_of(1, { L"-DSHADOWS=1" }, "source");
+    ShaderCompileCacheEntry  stored, loaded;
+    EXPECT_FALSE(cache.Load(key, loaded));
+    store(cache, key, stored);
+
+    SUBCASE("Hit")
+    {
+        REQUIRE(cache.Load(key, loaded));
+        EXPECT_EQ(loaded.stage, stored.stage);
+        EXPECT_EQ(loaded.flags, stored.flags);
+        EXPECT_EQ(loaded.has_pdb, stored.has_pdb);
+        for (uint32_t i = 0; i < 4; i++)
+            EXPECT_EQ(loaded.digits[i], stored.digits[i]);
+        const auto bytecode = read_file(cache.GetBlobPath(CGPU_SHADER_BYTECODE_TYPE_DXIL, loaded, u8"bytes"));
+        REQUIRE(bytecode.size() == 64);
+        for (uint32_t i = 0; i < bytecode.size(); i++)
+            EXPECT_EQ(bytecode[i], (uint8_t)(i * 7 + 3));
+        EXPECT_EQ(read_file(cache.GetBlobPath(CGPU_SHADER_BYTECODE_TYPE_DXIL, loaded, u8"pdb")).size(), 16u);
+    }
+
+    SUBCASE("Miss")
+    {
+        EXPECT_FALSE(cache.Load(key_of(1, { L"-DSHADOWS=0" }, "source"), loaded));
+        EXPECT_FALSE(cache.Load(key_of(2, { L"-DSHADOWS=1" }, "source"), loaded));
+    }
+
+    SUBCASE("Truncated")
+    {
+        const auto record = read_file(record_path(key));
+        REQUIRE(record.size() > 4);
+        write_file(record_path(key), record.data(), record.size() - 4);
+        EXPECT_FALSE(cache.Load(key, loaded));
+        write_file(record_path(key), record.data(), 0);
+        EXPECT_FALSE(cache.Load(key, loaded));
+    }
+
+    SUBCASE("Corrupt")
+    {
+        auto record = read_file(record_path(key));
+        REQUIRE(record.size() > 8);
+        // magic
+        record[0] ^= 0xFF;
+        write_file(record_path(key), record.data(), record.size());
+        EXPECT_FALSE(cache.Load(key, loaded));
+        // version
+        record[0] ^= 0xFF;
+        record[4] += 1;
+        write_file(record_path(key), record.data(), record.size());
+        EXPECT_FALSE(cache.Load(key, loaded));
+        // restored, hits again
+        record[4] -= 1;
+        write_file(record_path(key), record.data(), record.size());
+        EXPECT_TRUE(cache.Load(key, loaded));
+    }
+
+    SUBCASE("LeftoverStaging")
+    {
+        // a writer that died before its rename leaves a complete .tmp next to where the record would be
+        const auto other  = key_of(1, { L"-DSHADOWS=2" }, "source");
+        const auto record = read_file(record_path(key));
+        const auto tmp    = record_path(other).u8string() + u8".1234-1.tmp";
+        write_file(skr::filesystem::path(tmp), record.data(), record.size());
+        EXPECT_FALSE(cache.Load(other, loaded));
+    }
+}
+
+struct FakeShaderCompiler : public IShaderCompiler {
+    static IShaderCompiler* Create() { return SkrNew<FakeShaderCompiler>(); }
+    static void             Free(IShaderCompiler* compiler)
+    {
+        freed++;
+        SkrDelete(compiler);
+    }
+
+    EShaderSourceType GetSourceType() const SKR_NOEXCEPT override { return EShaderSourceType::SKSL; }
+    bool              IsSupportedTargetFormat(ECGPUShaderBytecodeType format) const SKR_NOEXCEPT override { return true; }
+    void              SetShaderSwitches(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, const skr_stable_shader_hash_t& hash) SKR_NOEXCEPT override {}
+    void              SetShaderOptions(skr::span<skr_shader_option_template_t> opt_defs, skr::span<skr_shader_option_instance_t> options, const skr_stable_shader_hash_t& hash) SKR_NOEXCEPT override {}
+    ICompiledShader*  Compile(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT override { return nullptr; }
+    uint64_t          GetCompileKey(ECGPUShaderBytecodeType format, const ShaderSourceCode& source, const SShaderImporter& importer) SKR_NOEXCEPT override { return 0; }
+    void              FreeCompileResult(ICompiledShader* compiled) SKR_NOEXCEPT override {}
+
+    static uint32_t freed;
+};
+uint32_t FakeShaderCompiler::freed = 0;
+
+TEST_CASE_METHOD(ShaderCompilerTests, "CompilerPool")
+{
+    Util_ShaderCompilerRegister(EShaderSourceType::SKSL, &FakeShaderCompiler::Create, &FakeShaderCompiler::Free);
+    FakeShaderCompiler::freed = 0;
+
+    // an empty pool creates, a released compiler is handed out again
+    auto first  = SkrShaderCompiler_Acquire(EShaderSourceType::SKSL);
+    auto second = SkrShaderCompiler_Acquire(EShaderSourceType::SKSL);
+    REQUIRE(first != nullptr);
+    REQUIRE(second != nullptr);
+    EXPECT_NE(first, second);
+    SkrShaderCompiler_Release(first);
+    EXPECT_EQ(SkrShaderCompiler_Acquire(EShaderSourceType::SKSL), first);
+    SkrShaderCompiler_Release(first);
+    SkrShaderCompiler_Release(second);
+
+    // other source types have their own pool
+    SkrShaderCompiler_ClearPool(EShaderSourceType::HLSL);
+    EXPECT_EQ(FakeShaderCompiler::freed, 0u);
+
+    SkrShaderCompiler_ClearPool(EShaderSourceType::SKSL);
+    EXPECT_EQ(FakeShaderCompiler::freed, 2u);
+    auto fresh = SkrShaderCompiler_Acquire(EShaderSourceType::SKSL);
+    REQUIRE(fresh != nullptr);
+    SkrShaderCompiler_Release(fresh);
+    SkrShaderCompiler_ClearPool(EShaderSourceType::SKSL);
+    EXPECT_EQ(FakeShaderCompiler::freed, 3u);
+}
@@ -0,0 +1,174 @@
+#include "SkrTask/fib_task.hpp"
+#include "SkrTextureCompiler/texture_encoder.hpp"
+#include <math.h>
+
+#include "SkrTestFramework/framework.hpp"
+
+struct TextureCompilerTests {
+    TextureCompilerTests()
+    {
+        skr::task::scheudler_config_t config;
+        config.numThreads = 4;
+        scheduler.initialize(config);
+        scheduler.bind();
+    }
+
+    ~TextureCompilerTests() SKR_NOEXCEPT
+    {
+        scheduler.unbind();
+    }
+
+    // mip 0 of width x height, red is a diagonal gradient, green is 1 on the last column & row only
+    static skr::Vector<skd::asset::TextureMip> make_mips(uint32_t width, uint32_t height)
+    {
+        skr::Vector<skd::asset::TextureMip> mips;
+        auto&                               mip = mips.add_default().ref();
+        mip.width                               = width;
+        mip.height                              = height;
+        mip.texels                              = skr::Vector<rtm::float4f>((uint64_t)width * height);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                const float edge                    = (x + 1 == width || y + 1 == height) ? 1.f : 0.f;
+                mip.texels[(uint64_t)y * width + x] = { (float)(x + y) / (float)(width + height), edge, 0.5f, 1.f };
+            }
+        }
+        return mips;
+    }
+
+    static rtm::float4f mean(const skd::asset::TextureMip& mip)
+    {
+        rtm::vector4f sum = rtm::vector_zero();
+        for (const auto& texel : mip.texels)
+            sum = rtm::vector_add(sum, rtm::vector_load(&texel));
+        rtm::float4f result;
+        rtm::vector_store(rtm::vector_div(sum, rtm::vector_set((float)mip.texels.size())), &result);
+        return result;
+    }
+
+    static uint64_t bc_size(uint32_t width, uint32_t height, ECGPUFormat format)
+    {
+        const uint64_t blocks = (uint64_t)((width + 3) / 4) * ((height + 3) / 4);
+        switch (format)
+        {
+            case CGPU_FORMAT_DXBC1_RGB_UNORM:
+            case CGPU_FORMAT_DXBC1_RGB_SRGB:
+            case CGPU_FORMAT_DXBC4_UNORM:
+                return blocks * 8;
+            default:
+                return blocks * 16;
+        }
+    }
+
+    skr::task::scheduler_t scheduler;
+};
+
+TEST_CASE_METHOD(TextureCompilerTests, "MipChainSizes")
+{
+    const uint32_t sizes[][2] = { { 1, 1 }, { 2, 1 }, { 3, 3 }, { 5, 3 }, { 7, 1 }, { 1, 9 }, { 13, 17 }, { 256, 64 } };
+    for (const auto& size : sizes)
+    {
+        auto mips = make_mips(size[0], size[1]);
+        skd::asset::Util_BuildTextureMips(mips, false);
+        const uint32_t largest = std::max(size[0], size[1]);
+        EXPECT_EQ(mips.size(), (uint64_t)floorf(log2f((float)largest)) + 1);
+        for (uint32_t m = 1; m < mips.size(); m++)
+        {
+            EXPECT_EQ(mips[m].width, std::max(mips[m - 1].width >> 1, 1u));
+            EXPECT_EQ(mips[m].height, std::max(mips[m - 1].height >> 1, 1u));
+            EXPECT_EQ(mips[m].texels.size(), (uint64_t)mips[m].width * mips[m].height);
+        }
+        EXPECT_EQ(mips.last().width, 1u);
+        EXPECT_EQ(mips.last().height, 1u);
+    }
+}
+
+TEST_CASE_METHOD(TextureCompilerTests, "MipChainContents")
+{
+    // every texel of a mip covers the same source area, so each mip keeps the mean of mip 0.
+    // dropping the last column or row of odd sizes would lose the green edge
+    const uint32_t sizes[][2] = { { 3, 1 }, { 5, 5 }, { 7, 4 }, { 13, 17 }, { 64, 33 } };
+    for (const auto& size : sizes)
+    {
+        auto mips = make_mips(size[0], size[1]);
+        skd::asset::Util_BuildTextureMips(mips, false);
+        const auto expected = mean(mips[0]);
+        for (uint32_t m = 1; m < mips.size(); m++)
+        {
+            const auto actual = mean(mips[m]);
+            EXPECT_NEAR(actual.x, expected.x, 1e-4f);
+            EXPECT_NEAR(actual.y, expected.y, 1e-4f);
+            EXPECT_NEAR(actual.z, 0.5f, 1e-4f);
+            EXPECT_NEAR(actual.w, 1.f, 1e-4f);
+        }
+    }
+
+    // 3x3 folds into one texel, each source texel weighs a ninth: 5 of them are on the green edge
+    auto square = make_mips(3, 3);
+    skd::asset::Util_BuildTextureMips(square, false);
+    REQUIRE(square.size() == 2);
+    EXPECT_NEAR(square[1].texels[0].y, 5.f / 9.f, 1e-5f);
+
+    // even sizes stay a 2x2 box
+    auto even = make_mips(4, 2);
+    skd::asset::Util_BuildTextureMips(even, false);
+    const auto& texels = even[0].texels;
+    EXPECT_NEAR(even[1].texels[0].x, (texels[0].x + texels[1].x + texels[4].x + texels[5].x) / 4.f, 1e-6f);
+}
+
+TEST_CASE_METHOD(TextureCompilerTests, "NormalMips")
+{
+    auto mips = make_mips(9, 7);
+    for (auto& texel : mips[0].texels)
+    {
+        const auto v = rtm::vector_sub(rtm::vector_mul(rtm::vector_load(&texel), 2.f), rtm::vector_set(1.f));
+        rtm::vector_store(rtm::vector_normalize3(v, rtm::vector_set(0.f, 0.f, 1.f, 1.f)), &texel);
+    }
+    skd::asset::Util_BuildTextureMips(mips, true);
+    for (uint32_t m = 1; m < mips.size(); m++)
+    {
+        for (const auto& texel : mips[m].texels)
+            EXPECT_NEAR(rtm::vector_length3(rtm::vector_load(&texel)), 1.f, 1e-4f);
+    }
+}
+
+TEST_CASE_METHOD(TextureCompilerTests, "EncodeSizes")
+{
+    const ECGPUFormat formats[] = {
+        CGPU_FORMAT_DXBC1_RGB_UNORM,
+        CGPU_FORMAT_DXBC1_RGB_SRGB,
+        CGPU_FORMAT_DXBC4_UNORM,
+        CGPU_FORMAT_DXBC5_UNORM,
+        CGPU_FORMAT_DXBC6H_UFLOAT,
+        CGPU_FORMAT_DXBC7_UNORM,
+    };
+    const uint32_t sizes[][2] = { { 1, 1 }, { 5, 3 }, { 64, 32 }, { 33, 7 } };
+    for (const auto format : formats)
+    {
+        for (const auto& size : sizes)
+        {
+            for (const bool with_mips : { false, true })
+            {
+                auto mips = make_mips(size[0], size[1]);
+                if (with_mips)
+                    skd::asset::Util_BuildTextureMips(mips, false);
+                skd::asset::TextureCompressResult result;
+                skd::asset::Util_EncodeTextureMips(mips, format, format == CGPU_FORMAT_DXBC1_RGB_SRGB, result);
+
+                uint64_t expected = 0, texels = 0;
+                for (const auto& mip : mips)
+                {
+                    expected += bc_size(mip.width, mip.height, format);
+                    texels += mip.texels.size();
+                }
+                EXPECT_EQ(result.format, format);
+                EXPECT_EQ(result.width, size[0]);
+                EXPECT_EQ(result.height, size[1]);
+                EXPECT_EQ(result.mips_count, (uint32_t)mips.size());
+                EXPECT_EQ(result.data.size(), expected);
+                EXPECT_EQ(result.statistics.texels, texels);
+            }
+        }
+    }
+}
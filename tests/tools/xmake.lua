@@ -0,0 +1,47 @@
+target("CookWorkerTestWorker")
+    set_kind("binary")
+    set_group("05.tests/tools")
+    set_exceptions("no-cxx")
+    public_dependency("SkrToolCore", engine_version)
+    add_files("cook_worker/worker.cpp")
+
+test_target("CookWorkerTest")
+    set_group("05.tests/tools")
+    public_dependency("SkrToolCore", engine_version)
+    add_deps("CookWorkerTestWorker")
+    add_files("cook_worker/main.cpp")
+
+test_target("CookDependencyDBTest")
+    set_group("05.tests/tools")
+    public_dependency("SkrToolCore", engine_version)
+    add_files("cook_dependency_db/main.cpp")
+
+test_target("MeshCoreTest")
+    set_group("05.tests/tools")
+    public_dependency("SkrMeshCore", engine_version)
+    add_files("mesh_core/main.cpp")
+
+test_target("TextureCompilerTest")
+    set_group("05.tests/tools")
+    public_dependency("SkrTextureCompiler", engine_version)
+    add_files("texture_compiler/main.cpp")
+
+test_target("ShaderCompilerTest")
+    set_group("05.tests/tools")
+    public_dependency("SkrShaderCompiler", engine_version)
+    add_files("shader_compiler/main.cpp")
+
+test_target("CookCacheTest")
+    set_group("05.tests/tools")
+    public_dependency("SkrToolCore", engine_version)
+    add_files("cook_cache/main.cpp")
+
+test_target("ImportCacheTest")
+    set_group("05.tests/tools")
+    public_dependency("SkrToolCore", engine_version)
+    add_files("import_cache/main.cpp")
+
+test_target("AnimationToolTest")
+    set_group("05.tests/tools")
+    public_dependency("SkrAnimTool", engine_version)
+    add_files("animation_tool/main.cpp")
@@ -27,4 +27,8 @@ includes("meta_system/xmake.lua")
 
 includes("cgpu/xmake.lua")
 includes("runtime/xmake.lua")
-includes("async/xmake.lua")
\ No newline at end of file
+includes("async/xmake.lua")
+
+if(not has_config("shipping_one_archive")) then
+    includes("tools/xmake.lua")
+end
\ No newline at end of file